@@ -43,6 +43,7 @@
 #include "igraph_vector_ptr.h"
 #include "igraph_sparsemat.h"
 #include "igraph_qsort.h"
+#include "igraph_workspace.h"
 
 #include "igraph_constants.h"
 #include "igraph_datatype.h"
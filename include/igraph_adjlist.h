@@ -106,6 +106,72 @@ IGRAPH_EXPORT igraph_error_t igraph_inclist_fprint(const igraph_inclist_t *il, F
  */
 #define igraph_inclist_get(il,no) (&(il)->incs[(igraph_integer_t)(no)])
 
+typedef struct igraph_csr_t {
+    igraph_integer_t length;
+    igraph_vector_int_t offsets;
+    igraph_vector_int_t neis;
+    igraph_vector_int_t eids;
+} igraph_csr_t;
+
+IGRAPH_EXPORT igraph_error_t igraph_csr_init(const igraph_t *graph, igraph_csr_t *csr,
+                                             igraph_neimode_t mode, igraph_loops_t loops,
+                                             igraph_multiple_t multiple, igraph_bool_t edge_ids);
+IGRAPH_EXPORT void igraph_csr_destroy(igraph_csr_t *csr);
+IGRAPH_EXPORT IGRAPH_FUNCATTR_PURE igraph_integer_t igraph_csr_size(const igraph_csr_t *csr);
+
+/**
+ * \define igraph_csr_degree
+ * \brief The number of neighbors of a vertex in a CSR structure.
+ *
+ * \experimental
+ *
+ * \param csr Pointer to the compressed sparse row structure.
+ * \param no The vertex ID.
+ * \return The number of neighbors stored for the vertex.
+ *
+ * Time complexity: O(1).
+ */
+#define igraph_csr_degree(csr,no) \
+    (VECTOR((csr)->offsets)[(igraph_integer_t)(no) + 1] - VECTOR((csr)->offsets)[(igraph_integer_t)(no)])
+
+/**
+ * \define igraph_csr_neighbors
+ * \brief The neighbors of a vertex in a CSR structure.
+ *
+ * \experimental
+ *
+ * Returns a pointer to the first neighbor of a vertex. The neighbors are
+ * stored contiguously, their number is given by \ref igraph_csr_degree().
+ * The pointed-to data must not be modified.
+ *
+ * \param csr Pointer to the compressed sparse row structure.
+ * \param no The vertex ID.
+ * \return Pointer to an <type>igraph_integer_t</type> array.
+ *
+ * Time complexity: O(1).
+ */
+#define igraph_csr_neighbors(csr,no) \
+    ((const igraph_integer_t *) VECTOR((csr)->neis) + VECTOR((csr)->offsets)[(igraph_integer_t)(no)])
+
+/**
+ * \define igraph_csr_edges
+ * \brief The incident edges of a vertex in a CSR structure.
+ *
+ * \experimental
+ *
+ * Returns a pointer to the edge IDs corresponding to the neighbors returned
+ * by \ref igraph_csr_neighbors(). It may only be used if the structure was
+ * created with edge IDs.
+ *
+ * \param csr Pointer to the compressed sparse row structure.
+ * \param no The vertex ID.
+ * \return Pointer to an <type>igraph_integer_t</type> array.
+ *
+ * Time complexity: O(1).
+ */
+#define igraph_csr_edges(csr,no) \
+    ((const igraph_integer_t *) VECTOR((csr)->eids) + VECTOR((csr)->offsets)[(igraph_integer_t)(no)])
+
 typedef struct igraph_lazy_adjlist_t {
     const igraph_t *graph;
     igraph_integer_t length;
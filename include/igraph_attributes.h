@@ -300,6 +300,10 @@ IGRAPH_EXPORT igraph_error_t igraph_attribute_combination_query(const igraph_att
  *    edges included in \p es.
  * \member get_bool_edge_attr Query a boolean edge attribute, for the
  *    edges included in \p es.
+ * \member get_memory_size Query the number of bytes of memory used by the
+ *    attributes of a graph, for \ref igraph_graph_memory_size(). This member
+ *    is optional and may be \c NULL, in which case the memory used by
+ *    attributes is not reported.
  *
  * Note that the <function>get_*_*_attr</function> are allowed to
  * convert the attributes to numeric or string. E.g. if a vertex attribute
@@ -362,6 +366,7 @@ typedef struct igraph_attribute_table_t {
     igraph_error_t (*get_bool_edge_attr)(const igraph_t *graph, const char *name,
                                          igraph_es_t es,
                                          igraph_vector_bool_t *value);
+    size_t         (*get_memory_size)(const igraph_t *graph);
 } igraph_attribute_table_t;
 
 IGRAPH_EXPORT IGRAPH_DEPRECATED igraph_attribute_table_t * igraph_i_set_attribute_table(const igraph_attribute_table_t * table);
@@ -79,6 +79,11 @@ IGRAPH_EXPORT igraph_error_t igraph_edge_betweenness_subset(const igraph_t *grap
                                             const igraph_es_t eids, igraph_bool_t directed,
                                             const igraph_vs_t sources, const igraph_vs_t targets,
                                             const igraph_vector_t *weights);
+IGRAPH_EXPORT igraph_error_t igraph_betweenness_approx(const igraph_t *graph, igraph_vector_t *res,
+                                            const igraph_vs_t vids, igraph_bool_t directed,
+                                            const igraph_vector_t *weights,
+                                            igraph_real_t epsilon, igraph_real_t delta,
+                                            igraph_real_t *error_bound, igraph_integer_t *samples);
 
 /**
  * \typedef igraph_pagerank_algo_t
@@ -90,11 +95,16 @@ IGRAPH_EXPORT igraph_error_t igraph_edge_betweenness_subset(const igraph_t *grap
  *   version 0.7.
  * \enumval IGRAPH_PAGERANK_ALGO_PRPACK Use the PRPACK
  *   library. Currently this implementation is recommended.
+ * \enumval IGRAPH_PAGERANK_ALGO_POWER_PARALLEL Use power iteration with a
+ *   sparse matrix-vector product that runs in parallel when igraph is
+ *   compiled with OpenMP support. This needs less memory than PRPACK and
+ *   scales to very large graphs (experimental).
  */
 
 typedef enum {
     IGRAPH_PAGERANK_ALGO_ARPACK = 1,
-    IGRAPH_PAGERANK_ALGO_PRPACK = 2
+    IGRAPH_PAGERANK_ALGO_PRPACK = 2,
+    IGRAPH_PAGERANK_ALGO_POWER_PARALLEL = 3
 } igraph_pagerank_algo_t;
 
 IGRAPH_EXPORT igraph_error_t igraph_pagerank(const igraph_t *graph, igraph_pagerank_algo_t algo,
@@ -115,6 +125,40 @@ IGRAPH_EXPORT igraph_error_t igraph_personalized_pagerank_vs(const igraph_t *gra
                                                   igraph_bool_t directed, igraph_real_t damping,
                                                   igraph_vs_t reset_vids,
                                                   const igraph_vector_t *weights, igraph_arpack_options_t *options);
+IGRAPH_EXPORT igraph_error_t igraph_personalized_pagerank_batch(const igraph_t *graph,
+                                                  igraph_matrix_t *res,
+                                                  igraph_bool_t directed, igraph_real_t damping,
+                                                  const igraph_matrix_t *reset,
+                                                  const igraph_vector_t *weights,
+                                                  igraph_arpack_options_t *options);
+IGRAPH_EXPORT igraph_error_t igraph_personalized_pagerank_update(const igraph_t *graph,
+                                                  igraph_vector_t *vector,
+                                                  igraph_bool_t directed, igraph_real_t damping,
+                                                  const igraph_vector_t *reset,
+                                                  const igraph_vector_t *weights,
+                                                  igraph_real_t epsilon);
+
+/**
+ * \typedef igraph_pagerank_plan_t
+ * \brief A preprocessed graph for repeated PageRank calculations.
+ *
+ * \experimental
+ *
+ * Holds the graph in the format of the PRPACK library, together with the
+ * results of preprocessing it. Its members are private and should not be
+ * accessed directly. See \ref igraph_pagerank_plan_init().
+ */
+typedef struct igraph_pagerank_plan_t {
+    void *graph;
+    void *solver;
+    igraph_integer_t no_of_nodes;
+} igraph_pagerank_plan_t;
+
+IGRAPH_EXPORT igraph_error_t igraph_pagerank_plan_init(igraph_pagerank_plan_t *plan, const igraph_t *graph,
+                                                       igraph_bool_t directed, const igraph_vector_t *weights);
+IGRAPH_EXPORT void igraph_pagerank_plan_destroy(igraph_pagerank_plan_t *plan);
+IGRAPH_EXPORT igraph_error_t igraph_pagerank_plan_solve(igraph_pagerank_plan_t *plan, igraph_vector_t *vector,
+                                                        igraph_real_t damping, const igraph_vector_t *reset);
 
 IGRAPH_EXPORT igraph_error_t igraph_eigenvector_centrality(const igraph_t *graph, igraph_vector_t *vector,
                                                 igraph_real_t *value,
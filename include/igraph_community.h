@@ -241,6 +241,14 @@ IGRAPH_EXPORT igraph_error_t igraph_community_leiden(const igraph_t *graph,
                                           igraph_vector_int_t *membership,
                                           igraph_integer_t *nb_clusters,
                                           igraph_real_t *quality);
+IGRAPH_EXPORT igraph_error_t igraph_community_leiden_update(const igraph_t *graph,
+                                          const igraph_vector_t *edge_weights,
+                                          const igraph_vector_t *node_weights,
+                                          igraph_real_t resolution_parameter,
+                                          const igraph_vector_int_t *changed_edges,
+                                          igraph_vector_int_t *membership,
+                                          igraph_integer_t *nb_clusters,
+                                          igraph_real_t *quality);
 /* -------------------------------------------------- */
 /* Community Structure Comparison                     */
 /* -------------------------------------------------- */
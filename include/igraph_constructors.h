@@ -32,6 +32,7 @@
 #include "igraph_datatype.h"
 #include "igraph_graphicality.h"
 #include "igraph_sparsemat.h"
+#include "igraph_vector_ptr.h"
 
 __BEGIN_DECLS
 
@@ -109,6 +110,32 @@ IGRAPH_EXPORT igraph_error_t igraph_hexagonal_lattice(igraph_t *graph, const igr
 IGRAPH_EXPORT igraph_error_t igraph_realize_bipartite_degree_sequence(igraph_t *graph, const igraph_vector_int_t *deg1, const igraph_vector_int_t *deg2, const igraph_edge_type_sw_t allowed_edge_types, const igraph_realize_degseq_t method);
 IGRAPH_EXPORT igraph_error_t igraph_mycielski_graph(igraph_t *graph, igraph_integer_t k);
 
+/* -------------------------------------------------- */
+/* Incremental graph builder                          */
+/* -------------------------------------------------- */
+
+typedef struct igraph_graph_builder_t {
+    igraph_bool_t directed;
+    igraph_integer_t vcount;
+    igraph_integer_t ecount;
+    igraph_integer_t max_vid;
+    igraph_vector_ptr_t chunks;
+    igraph_vector_ptr_t vertex_attr;
+    igraph_vector_ptr_t edge_attr;
+} igraph_graph_builder_t;
+
+IGRAPH_EXPORT igraph_error_t igraph_graph_builder_init(igraph_graph_builder_t *builder, igraph_bool_t directed);
+IGRAPH_EXPORT void igraph_graph_builder_destroy(igraph_graph_builder_t *builder);
+IGRAPH_EXPORT igraph_error_t igraph_graph_builder_add_vertices(igraph_graph_builder_t *builder, igraph_integer_t nv,
+                                                               const igraph_vector_ptr_t *attr);
+IGRAPH_EXPORT igraph_error_t igraph_graph_builder_add_edge(igraph_graph_builder_t *builder,
+                                                           igraph_integer_t from, igraph_integer_t to);
+IGRAPH_EXPORT igraph_error_t igraph_graph_builder_add_edges(igraph_graph_builder_t *builder, const igraph_vector_int_t *edges,
+                                                            const igraph_vector_ptr_t *attr);
+IGRAPH_EXPORT igraph_integer_t igraph_graph_builder_vcount(const igraph_graph_builder_t *builder);
+IGRAPH_EXPORT igraph_integer_t igraph_graph_builder_ecount(const igraph_graph_builder_t *builder);
+IGRAPH_EXPORT igraph_error_t igraph_graph_builder_finalize(igraph_graph_builder_t *builder, igraph_t *graph);
+
 __END_DECLS
 
 #endif
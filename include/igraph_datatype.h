@@ -94,6 +94,9 @@ typedef enum {
  *   queries.
  * - <b>is</b> This is basically the same as <b>os</b>, but this time
  *   for the incoming edges.
+ * - <b>view</b> Whether the six vectors above are views into arrays owned
+ *   by someone else, see \ref igraph_create_view(). Such graphs must not
+ *   be modified, and their vectors are not freed by \ref igraph_destroy().
  *
  * For undirected graphs, the same edge list is stored, i.e. an
  * undirected edge is stored only once. Currently, undirected edges
@@ -116,6 +119,7 @@ typedef struct igraph_s {
     igraph_vector_int_t ii;
     igraph_vector_int_t os;
     igraph_vector_int_t is;
+    igraph_bool_t view;
     void *attr;
     igraph_i_property_cache_t *cache;
 } igraph_t;
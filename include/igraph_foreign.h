@@ -69,6 +69,9 @@ IGRAPH_EXPORT igraph_error_t igraph_read_graph_graphdb(igraph_t *graph, FILE *in
 IGRAPH_EXPORT igraph_error_t igraph_read_graph_gml(igraph_t *graph, FILE *instream);
 IGRAPH_EXPORT igraph_error_t igraph_read_graph_dl(igraph_t *graph, FILE *instream,
                                        igraph_bool_t directed);
+IGRAPH_EXPORT igraph_error_t igraph_read_graph_binary(igraph_t *graph, FILE *instream);
+IGRAPH_EXPORT igraph_error_t igraph_read_graph_binary_view(igraph_t *graph, const void *data, size_t size,
+                                                igraph_bool_t validate);
 
 typedef unsigned int igraph_write_gml_sw_t;
 
@@ -98,6 +101,7 @@ IGRAPH_EXPORT igraph_error_t igraph_write_graph_gml(const igraph_t *graph, FILE
 IGRAPH_EXPORT igraph_error_t igraph_write_graph_dot(const igraph_t *graph, FILE *outstream);
 IGRAPH_EXPORT igraph_error_t igraph_write_graph_leda(const igraph_t *graph, FILE *outstream,
                                           const char* vertex_attr_name, const char* edge_attr_name);
+IGRAPH_EXPORT igraph_error_t igraph_write_graph_binary(const igraph_t *graph, FILE *outstream);
 
 /* -------------------------------------------------- */
 /* Convenience functions for temporary locale setting */
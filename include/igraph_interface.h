@@ -40,6 +40,12 @@ IGRAPH_EXPORT igraph_error_t igraph_empty(igraph_t *graph, igraph_integer_t n, i
 IGRAPH_EXPORT igraph_error_t igraph_empty_attrs(igraph_t *graph, igraph_integer_t n, igraph_bool_t directed, void *attr);
 IGRAPH_EXPORT void igraph_destroy(igraph_t *graph);
 IGRAPH_EXPORT igraph_error_t igraph_copy(igraph_t *to, const igraph_t *from);
+IGRAPH_EXPORT igraph_error_t igraph_create_view(
+        igraph_t *graph, igraph_integer_t n, igraph_integer_t m, igraph_bool_t directed,
+        const igraph_integer_t *from, const igraph_integer_t *to,
+        const igraph_integer_t *oi, const igraph_integer_t *ii,
+        const igraph_integer_t *os, const igraph_integer_t *is,
+        igraph_bool_t validate);
 IGRAPH_EXPORT igraph_error_t igraph_add_edges(igraph_t *graph, const igraph_vector_int_t *edges,
                                    void *attr);
 IGRAPH_EXPORT igraph_error_t igraph_add_vertices(igraph_t *graph, igraph_integer_t nv,
@@ -51,6 +57,7 @@ IGRAPH_EXPORT igraph_error_t igraph_delete_vertices_idx(igraph_t *graph, const i
                                              igraph_vector_int_t *invidx);
 IGRAPH_EXPORT IGRAPH_FUNCATTR_PURE igraph_integer_t igraph_vcount(const igraph_t *graph);
 IGRAPH_EXPORT IGRAPH_FUNCATTR_PURE igraph_integer_t igraph_ecount(const igraph_t *graph);
+IGRAPH_EXPORT size_t igraph_graph_memory_size(const igraph_t *graph);
 IGRAPH_EXPORT igraph_error_t igraph_neighbors(const igraph_t *graph, igraph_vector_int_t *neis, igraph_integer_t vid,
                                    igraph_neimode_t mode);
 IGRAPH_EXPORT IGRAPH_FUNCATTR_PURE igraph_bool_t igraph_is_directed(const igraph_t *graph);
@@ -25,20 +25,125 @@
 #define IGRAPH_MEMORY_H
 
 #include "igraph_decls.h"
+#include "igraph_types.h"
 
 #include <stdint.h>
 #include <stdlib.h>
 
 __BEGIN_DECLS
 
+/**
+ * \typedef igraph_allocator_t
+ * \brief Memory allocator functions used by igraph.
+ *
+ * \experimental
+ *
+ * A table of functions that igraph uses for all of its dynamic memory
+ * allocations, see \ref igraph_set_allocator(). Each function receives the
+ * \c data pointer of the table as its last argument, which can be used to
+ * pass a user-defined context, e.g. an arena or an accounting structure.
+ *
+ * </para><para>
+ * The functions must follow the semantics of the standard C library
+ * functions: \c calloc_func must zero the allocated memory,
+ * \c realloc_func must behave like \c malloc_func when its pointer argument
+ * is \c NULL, and \c free_func must accept a \c NULL pointer. Allocation
+ * functions return \c NULL on failure. igraph never requests zero bytes.
+ *
+ * \member malloc_func Allocates memory, like \c malloc().
+ * \member calloc_func Allocates zeroed memory for an array, like \c calloc().
+ * \member realloc_func Resizes a previous allocation, like \c realloc().
+ * \member free_func Releases memory, like \c free().
+ * \member data User data passed to all of the above functions.
+ */
+typedef struct igraph_allocator_t {
+    void *(*malloc_func)(size_t size, void *data);
+    void *(*calloc_func)(size_t count, size_t size, void *data);
+    void *(*realloc_func)(void *ptr, size_t size, void *data);
+    void (*free_func)(void *ptr, void *data);
+    void *data;
+} igraph_allocator_t;
+
+IGRAPH_EXPORT void *igraph_calloc(size_t count, size_t size);
+IGRAPH_EXPORT void *igraph_malloc(size_t size);
+IGRAPH_EXPORT void *igraph_realloc(void* ptr, size_t size);
+IGRAPH_EXPORT void igraph_free(void *ptr);
+
+IGRAPH_EXPORT const igraph_allocator_t *igraph_set_allocator(const igraph_allocator_t *allocator);
+
+/**
+ * \typedef igraph_memory_category_t
+ * \brief Categories of memory in the memory usage statistics.
+ *
+ * \experimental
+ *
+ * \enumval IGRAPH_MEMORY_OTHER Memory that does not belong to any of the
+ *    categories below, e.g. temporary arrays of algorithms, strings and
+ *    the contents of other containers.
+ * \enumval IGRAPH_MEMORY_VECTOR The storage of vectors of all types.
+ * \enumval IGRAPH_MEMORY_MATRIX The storage of matrices of all types.
+ * \enumval IGRAPH_MEMORY_ADJLIST Adjacency and incidence lists, including
+ *    their lazy and compressed variants.
+ * \enumval IGRAPH_MEMORY_SPARSEMAT Sparse matrices, and the temporary data
+ *    of sparse matrix operations.
+ * \enumval IGRAPH_MEMORY_GRAPH The edge list, the indices and the property
+ *    cache of graphs.
+ * \enumval IGRAPH_MEMORY_ATTRIBUTES Memory allocated by the attribute
+ *    handler while igraph creates, copies or modifies graphs.
+ */
+typedef enum {
+    IGRAPH_MEMORY_OTHER = 0,
+    IGRAPH_MEMORY_VECTOR,
+    IGRAPH_MEMORY_MATRIX,
+    IGRAPH_MEMORY_ADJLIST,
+    IGRAPH_MEMORY_SPARSEMAT,
+    IGRAPH_MEMORY_GRAPH,
+    IGRAPH_MEMORY_ATTRIBUTES,
+
+    /* Dummy value used to count enum values */
+    IGRAPH_MEMORY_CATEGORY_COUNT
+} igraph_memory_category_t;
+
+/**
+ * \typedef igraph_memory_stats_t
+ * \brief Memory usage statistics.
+ *
+ * \experimental
+ *
+ * All sizes are in bytes and include only the memory requested by igraph,
+ * not the bookkeeping overhead of memory tracking or of the allocator.
+ *
+ * \member current The amount of memory currently allocated.
+ * \member peak The largest amount of memory that was allocated at the
+ *    same time since memory tracking was enabled, or since the last call
+ *    to \ref igraph_memory_stats_reset_peak().
+ * \member blocks The number of memory blocks currently allocated.
+ * \member current_by_category The amount of memory currently allocated,
+ *    for each \ref igraph_memory_category_t category.
+ * \member peak_by_category The peak amount of memory for each category.
+ *    The peaks of different categories may have been reached at different
+ *    times, therefore their sum may exceed \c peak.
+ */
+typedef struct igraph_memory_stats_t {
+    size_t current;
+    size_t peak;
+    size_t blocks;
+    size_t current_by_category[IGRAPH_MEMORY_CATEGORY_COUNT];
+    size_t peak_by_category[IGRAPH_MEMORY_CATEGORY_COUNT];
+} igraph_memory_stats_t;
+
+IGRAPH_EXPORT igraph_bool_t igraph_set_memory_tracking(igraph_bool_t enabled);
+IGRAPH_EXPORT void igraph_memory_stats(igraph_memory_stats_t *stats);
+IGRAPH_EXPORT void igraph_memory_stats_reset_peak(void);
+
 /* Helper macro to check if n*sizeof(t) overflows in IGRAPH_CALLOC and IGRAPH_REALLOC */
 #define IGRAPH_I_ALLOC_CHECK_OVERFLOW(n,t,expr) \
     (t*) ((0 <= (n) && ((size_t)(n)) <= SIZE_MAX / sizeof(t)) ? (expr) : NULL)
 
-#define IGRAPH_CALLOC(n,t)    IGRAPH_I_ALLOC_CHECK_OVERFLOW(n, t, calloc(sizeof(t) * ((n) > 0 ? (n) : 1), 1))
-#define IGRAPH_MALLOC(n)      malloc( (size_t) ((n) > 0 ? (n) : 1) )
-#define IGRAPH_REALLOC(p,n,t) IGRAPH_I_ALLOC_CHECK_OVERFLOW(n, t, realloc((void*)(p), sizeof(t) * ((n) > 0 ? (n) : 1)))
-#define IGRAPH_FREE(p)        (free( (void *)(p) ), (p) = NULL)
+#define IGRAPH_CALLOC(n,t)    IGRAPH_I_ALLOC_CHECK_OVERFLOW(n, t, igraph_calloc(sizeof(t) * ((n) > 0 ? (n) : 1), 1))
+#define IGRAPH_MALLOC(n)      igraph_malloc( (size_t) ((n) > 0 ? (n) : 1) )
+#define IGRAPH_REALLOC(p,n,t) IGRAPH_I_ALLOC_CHECK_OVERFLOW(n, t, igraph_realloc((void*)(p), sizeof(t) * ((n) > 0 ? (n) : 1)))
+#define IGRAPH_FREE(p)        (igraph_free( (void *)(p) ), (p) = NULL)
 
 /* These are deprecated and scheduled for removal in 0.11 */
 #define igraph_Calloc IGRAPH_CALLOC
@@ -46,11 +151,6 @@ __BEGIN_DECLS
 #define igraph_Free IGRAPH_FREE
 /* Deprecated section ends here */
 
-IGRAPH_EXPORT void *igraph_calloc(size_t count, size_t size);
-IGRAPH_EXPORT void *igraph_malloc(size_t size);
-IGRAPH_EXPORT void *igraph_realloc(void* ptr, size_t size);
-IGRAPH_EXPORT void igraph_free(void *ptr);
-
 __END_DECLS
 
 #endif
@@ -31,6 +31,7 @@
 #include "igraph_types.h"
 #include "igraph_vector.h"
 #include "igraph_vector_list.h"
+#include "igraph_workspace.h"
 
 __BEGIN_DECLS
 
@@ -104,6 +105,14 @@ IGRAPH_EXPORT igraph_error_t igraph_distances_dijkstra_cutoff(const igraph_t *gr
                                                               const igraph_vector_t *weights,
                                                               igraph_neimode_t mode,
                                                               igraph_real_t cutoff);
+IGRAPH_EXPORT igraph_error_t igraph_distances_dijkstra_cutoff_ws(const igraph_t *graph,
+                                                                 igraph_matrix_t *res,
+                                                                 const igraph_vs_t from,
+                                                                 const igraph_vs_t to,
+                                                                 const igraph_vector_t *weights,
+                                                                 igraph_neimode_t mode,
+                                                                 igraph_real_t cutoff,
+                                                                 igraph_workspace_t *ws);
 IGRAPH_EXPORT igraph_error_t igraph_distances_dijkstra(const igraph_t *graph,
                                                        igraph_matrix_t *res,
                                                        const igraph_vs_t from,
@@ -199,6 +208,68 @@ IGRAPH_EXPORT igraph_error_t igraph_get_shortest_path_astar(const igraph_t *grap
                                       igraph_neimode_t mode,
                                       igraph_astar_heuristic_func_t *heuristic,
                                       void *extra);
+IGRAPH_EXPORT igraph_error_t igraph_get_shortest_path_bidirectional(const igraph_t *graph,
+                                      igraph_vector_int_t *vertices,
+                                      igraph_vector_int_t *edges,
+                                      igraph_integer_t from,
+                                      igraph_integer_t to,
+                                      const igraph_vector_t *weights,
+                                      igraph_neimode_t mode);
+
+/**
+ * \typedef igraph_landmark_index_t
+ * \brief Precomputed landmark distances for A* searches.
+ *
+ * \experimental
+ *
+ * Holds the distances between a few selected landmark vertices and all
+ * other vertices of a graph. These give lower bounds on the distance of
+ * any two vertices through the triangle inequality, which
+ * \ref igraph_landmark_heuristic() provides to
+ * \ref igraph_get_shortest_path_astar(). Its members are private and
+ * should not be accessed directly. See \ref igraph_landmark_index_init().
+ */
+typedef struct igraph_landmark_index_t {
+    igraph_vector_int_t landmarks;
+    igraph_matrix_t from_landmarks;
+    igraph_matrix_t to_landmarks;
+    igraph_bool_t symmetric;
+} igraph_landmark_index_t;
+
+IGRAPH_EXPORT igraph_error_t igraph_landmark_index_init(igraph_landmark_index_t *index, const igraph_t *graph,
+                                                        const igraph_vector_t *weights, igraph_neimode_t mode,
+                                                        igraph_integer_t no_of_landmarks);
+IGRAPH_EXPORT void igraph_landmark_index_destroy(igraph_landmark_index_t *index);
+IGRAPH_EXPORT igraph_error_t igraph_landmark_index_landmarks(const igraph_landmark_index_t *index,
+                                                             igraph_vector_int_t *landmarks);
+IGRAPH_EXPORT igraph_error_t igraph_landmark_heuristic(igraph_real_t *result,
+                                                       igraph_integer_t from, igraph_integer_t to,
+                                                       void *extra);
+
+/**
+ * \typedef igraph_ch_index_t
+ * \brief A contraction hierarchy for fast shortest path queries.
+ *
+ * \experimental
+ *
+ * Holds the vertex order, the shortcuts and the search state of a
+ * contraction hierarchy. Its members are private and should not be
+ * accessed directly. See \ref igraph_ch_index_build().
+ */
+typedef struct igraph_ch_index_t {
+    igraph_integer_t no_of_nodes;
+    void *hierarchy;
+} igraph_ch_index_t;
+
+IGRAPH_EXPORT igraph_error_t igraph_ch_index_build(igraph_ch_index_t *index, const igraph_t *graph,
+                                                   const igraph_vector_t *weights, igraph_neimode_t mode);
+IGRAPH_EXPORT void igraph_ch_index_destroy(igraph_ch_index_t *index);
+IGRAPH_EXPORT igraph_error_t igraph_ch_index_distance(igraph_ch_index_t *index, igraph_real_t *res,
+                                                      igraph_integer_t from, igraph_integer_t to);
+IGRAPH_EXPORT igraph_error_t igraph_ch_index_get_path(igraph_ch_index_t *index,
+                                                      igraph_vector_int_t *vertices,
+                                                      igraph_vector_int_t *edges,
+                                                      igraph_integer_t from, igraph_integer_t to);
 
 IGRAPH_EXPORT igraph_error_t igraph_get_all_shortest_paths(const igraph_t *graph,
                                                 igraph_vector_int_list_t *vertices,
@@ -29,6 +29,7 @@
 #include "igraph_constants.h"
 #include "igraph_error.h"
 #include "igraph_iterators.h"
+#include "igraph_workspace.h"
 
 __BEGIN_DECLS
 
@@ -39,6 +40,11 @@ IGRAPH_EXPORT igraph_error_t igraph_transitivity_local_undirected(const igraph_t
                                                        igraph_vector_t *res,
                                                        const igraph_vs_t vids,
                                                        igraph_transitivity_mode_t mode);
+IGRAPH_EXPORT igraph_error_t igraph_transitivity_local_undirected_ws(const igraph_t *graph,
+                                                       igraph_vector_t *res,
+                                                       const igraph_vs_t vids,
+                                                       igraph_transitivity_mode_t mode,
+                                                       igraph_workspace_t *ws);
 IGRAPH_EXPORT igraph_error_t igraph_transitivity_avglocal_undirected(const igraph_t *graph,
                                                           igraph_real_t *res,
                                                           igraph_transitivity_mode_t mode);
@@ -0,0 +1,64 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IGRAPH_WORKSPACE_H
+#define IGRAPH_WORKSPACE_H
+
+#include "igraph_decls.h"
+#include "igraph_error.h"
+#include "igraph_types.h"
+#include "igraph_vector_ptr.h"
+
+__BEGIN_DECLS
+
+/**
+ * \typedef igraph_workspace_t
+ * \brief Reusable scratch memory for repeated function calls.
+ *
+ * \experimental
+ *
+ * A workspace keeps the temporary buffers of the functions that accept
+ * it, so that these buffers can be reused by subsequent calls instead of
+ * being allocated and freed each time. The buffers grow to the largest
+ * size needed so far and are only released when the workspace is
+ * destroyed.
+ *
+ * </para><para>
+ * The members of this structure are internal and should not be accessed
+ * directly. A workspace must not be used by more than one function call at
+ * the same time; in multi-threaded programs, each thread needs its own
+ * workspace.
+ */
+typedef struct igraph_workspace_t {
+    igraph_vector_ptr_t vectors;
+    igraph_vector_ptr_t int_vectors;
+    igraph_vector_ptr_t bitsets;
+    igraph_vector_ptr_t heaps;
+    igraph_integer_t vectors_used;
+    igraph_integer_t int_vectors_used;
+    igraph_integer_t bitsets_used;
+    igraph_integer_t heaps_used;
+} igraph_workspace_t;
+
+IGRAPH_EXPORT igraph_error_t igraph_workspace_init(igraph_workspace_t *ws);
+IGRAPH_EXPORT void igraph_workspace_destroy(igraph_workspace_t *ws);
+IGRAPH_EXPORT void igraph_workspace_clear(igraph_workspace_t *ws);
+
+__END_DECLS
+
+#endif
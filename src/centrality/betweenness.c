@@ -19,15 +19,25 @@
 #include "igraph_centrality.h"
 
 #include "igraph_adjlist.h"
+#include "igraph_bitset.h"
+#include "igraph_components.h"
 #include "igraph_dqueue.h"
 #include "igraph_interface.h"
+#include "igraph_matrix.h"
 #include "igraph_memory.h"
 #include "igraph_nongraph.h"
 #include "igraph_progress.h"
+#include "igraph_random.h"
 #include "igraph_stack.h"
+#include "igraph_threading.h"
 
 #include "core/indheap.h"
 #include "core/interruption.h"
+#include "core/workspace.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 /*
  * We provide separate implementations of single-source shortest path searches,
@@ -58,6 +68,7 @@
  *                 of the vertices that lead to a given node during the traversal
  * \param  adjlist the adjacency list of the graph
  * \param  cutoff  cutoff length of shortest paths
+ * \param  ws      workspace providing the queue used by the traversal
  */
 static igraph_error_t igraph_i_sspf(
         igraph_integer_t source,
@@ -66,21 +77,27 @@ static igraph_error_t igraph_i_sspf(
         igraph_stack_int_t *stack,
         igraph_adjlist_t *parents,
         const igraph_adjlist_t *adjlist,
-        igraph_real_t cutoff) {
+        igraph_real_t cutoff,
+        igraph_workspace_t *ws) {
 
-    igraph_dqueue_int_t queue;
+    igraph_i_workspace_mark_t mark;
+    igraph_vector_int_t *queue;
+    igraph_integer_t head = 0;
     const igraph_vector_int_t *neis;
     igraph_vector_int_t *v;
     igraph_integer_t nlen;
 
-    IGRAPH_DQUEUE_INT_INIT_FINALLY(&queue, 100);
+    /* Each vertex enters the queue at most once, so a vector with a moving
+     * head is enough. */
+    igraph_i_workspace_mark(ws, &mark);
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, 0, &queue));
 
-    IGRAPH_CHECK(igraph_dqueue_int_push(&queue, source));
+    IGRAPH_CHECK(igraph_vector_int_push_back(queue, source));
     VECTOR(*dist)[source] = 1.0;
     nrgeo[source] = 1;
 
-    while (!igraph_dqueue_int_empty(&queue)) {
-        igraph_integer_t actnode = igraph_dqueue_int_pop(&queue);
+    while (head < igraph_vector_int_size(queue)) {
+        igraph_integer_t actnode = VECTOR(*queue)[head++];
 
         /* Ignore vertices that are more distant than the cutoff */
         if (cutoff >= 0 && VECTOR(*dist)[actnode] > cutoff + 1) {
@@ -103,7 +120,7 @@ static igraph_error_t igraph_i_sspf(
             if (VECTOR(*dist)[neighbor] == 0) {
                 /* We have found 'neighbor' for the first time */
                 VECTOR(*dist)[neighbor] = VECTOR(*dist)[actnode] + 1;
-                IGRAPH_CHECK(igraph_dqueue_int_push(&queue, neighbor));
+                IGRAPH_CHECK(igraph_vector_int_push_back(queue, neighbor));
             }
 
             if (VECTOR(*dist)[neighbor] == VECTOR(*dist)[actnode] + 1 &&
@@ -116,8 +133,7 @@ static igraph_error_t igraph_i_sspf(
         }
     }
 
-    igraph_dqueue_int_destroy(&queue);
-    IGRAPH_FINALLY_CLEAN(1);
+    igraph_i_workspace_release(ws, &mark);
 
     return IGRAPH_SUCCESS;
 }
@@ -138,6 +154,7 @@ static igraph_error_t igraph_i_sspf(
  *                 of the edges that lead to a given node during the traversal
  * \param  inclist the incidence list of the graph
  * \param  cutoff  cutoff length of shortest paths
+ * \param  ws      workspace providing the queue used by the traversal
  */
 static igraph_error_t igraph_i_sspf_edge(
         const igraph_t *graph,
@@ -147,21 +164,27 @@ static igraph_error_t igraph_i_sspf_edge(
         igraph_stack_int_t *stack,
         igraph_inclist_t *parents,
         const igraph_inclist_t *inclist,
-        igraph_real_t cutoff) {
+        igraph_real_t cutoff,
+        igraph_workspace_t *ws) {
 
-    igraph_dqueue_int_t queue;
+    igraph_i_workspace_mark_t mark;
+    igraph_vector_int_t *queue;
+    igraph_integer_t head = 0;
     const igraph_vector_int_t *neis;
     igraph_vector_int_t *v;
     igraph_integer_t nlen;
 
-    IGRAPH_DQUEUE_INT_INIT_FINALLY(&queue, 100);
+    /* Each vertex enters the queue at most once, so a vector with a moving
+     * head is enough. */
+    igraph_i_workspace_mark(ws, &mark);
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, 0, &queue));
 
-    IGRAPH_CHECK(igraph_dqueue_int_push(&queue, source));
+    IGRAPH_CHECK(igraph_vector_int_push_back(queue, source));
     VECTOR(*dist)[source] = 1.0;
     nrgeo[source] = 1;
 
-    while (!igraph_dqueue_int_empty(&queue)) {
-        igraph_integer_t actnode = igraph_dqueue_int_pop(&queue);
+    while (head < igraph_vector_int_size(queue)) {
+        igraph_integer_t actnode = VECTOR(*queue)[head++];
 
         /* Ignore vertices that are more distant than the cutoff */
         if (cutoff >= 0 && VECTOR(*dist)[actnode] > cutoff + 1) {
@@ -185,7 +208,7 @@ static igraph_error_t igraph_i_sspf_edge(
             if (VECTOR(*dist)[neighbor] == 0) {
                 /* We have found 'neighbor' for the first time */
                 VECTOR(*dist)[neighbor] = VECTOR(*dist)[actnode] + 1;
-                IGRAPH_CHECK(igraph_dqueue_int_push(&queue, neighbor));
+                IGRAPH_CHECK(igraph_vector_int_push_back(queue, neighbor));
             }
 
             if (VECTOR(*dist)[neighbor] == VECTOR(*dist)[actnode] + 1 &&
@@ -198,8 +221,7 @@ static igraph_error_t igraph_i_sspf_edge(
         }
     }
 
-    igraph_dqueue_int_destroy(&queue);
-    IGRAPH_FINALLY_CLEAN(1);
+    igraph_i_workspace_release(ws, &mark);
 
     return IGRAPH_SUCCESS;
 }
@@ -221,6 +243,7 @@ static igraph_error_t igraph_i_sspf_edge(
  *                 of the vertices that lead to a given node during the traversal
  * \param  inclist the incidence list of the graph
  * \param  cutoff  cutoff length of shortest paths
+ * \param  ws      workspace providing the queue used by the traversal
  */
 static igraph_error_t igraph_i_sspf_weighted(
         const igraph_t *graph,
@@ -231,28 +254,28 @@ static igraph_error_t igraph_i_sspf_weighted(
         igraph_stack_int_t *stack,
         igraph_adjlist_t *parents,
         const igraph_inclist_t *inclist,
-        igraph_real_t cutoff) {
+        igraph_real_t cutoff,
+        igraph_workspace_t *ws) {
 
     const igraph_real_t eps = IGRAPH_SHORTEST_PATH_EPSILON;
 
     int cmp_result;
-    igraph_2wheap_t queue;
+    igraph_i_workspace_mark_t mark;
+    igraph_2wheap_t *queue;
     const igraph_vector_int_t *neis;
     igraph_vector_int_t *v;
     igraph_integer_t nlen;
 
-    /* TODO: this is an O|V| step here. We could save some time by pre-allocating
-     * the two-way heap in the caller and re-using it here */
-    IGRAPH_CHECK(igraph_2wheap_init(&queue, igraph_vcount(graph)));
-    IGRAPH_FINALLY(igraph_2wheap_destroy, &queue);
+    igraph_i_workspace_mark(ws, &mark);
+    IGRAPH_CHECK(igraph_i_workspace_2wheap(ws, igraph_vcount(graph), &queue));
 
-    igraph_2wheap_push_with_index(&queue, source, -1.0);
+    igraph_2wheap_push_with_index(queue, source, -1.0);
     VECTOR(*dist)[source] = 1.0;
     nrgeo[source] = 1;
 
-    while (!igraph_2wheap_empty(&queue)) {
-        igraph_integer_t minnei = igraph_2wheap_max_index(&queue);
-        igraph_real_t mindist = -igraph_2wheap_delete_max(&queue);
+    while (!igraph_2wheap_empty(queue)) {
+        igraph_integer_t minnei = igraph_2wheap_max_index(queue);
+        igraph_real_t mindist = -igraph_2wheap_delete_max(queue);
 
         /* Ignore vertices that are more distant than the cutoff */
         if (cutoff >= 0 && mindist > cutoff + 1.0) {
@@ -289,7 +312,7 @@ static igraph_error_t igraph_i_sspf_weighted(
                 VECTOR(*v)[0] = minnei;
                 nrgeo[to] = nrgeo[minnei];
                 VECTOR(*dist)[to] = altdist;
-                IGRAPH_CHECK(igraph_2wheap_push_with_index(&queue, to, -altdist));
+                IGRAPH_CHECK(igraph_2wheap_push_with_index(queue, to, -altdist));
             } else if (cmp_result < 0) {
                 /* This is a shorter path */
                 v = igraph_adjlist_get(parents, to);
@@ -297,7 +320,7 @@ static igraph_error_t igraph_i_sspf_weighted(
                 VECTOR(*v)[0] = minnei;
                 nrgeo[to] = nrgeo[minnei];
                 VECTOR(*dist)[to] = altdist;
-                igraph_2wheap_modify(&queue, to, -altdist);
+                igraph_2wheap_modify(queue, to, -altdist);
             } else if (cmp_result == 0 && (altdist <= cutoff + 1.0 || cutoff < 0)) {
                 /* Only add if the node is not more distant than the cutoff */
                 v = igraph_adjlist_get(parents, to);
@@ -307,8 +330,7 @@ static igraph_error_t igraph_i_sspf_weighted(
         }
     }
 
-    igraph_2wheap_destroy(&queue);
-    IGRAPH_FINALLY_CLEAN(1);
+    igraph_i_workspace_release(ws, &mark);
 
     return IGRAPH_SUCCESS;
 }
@@ -330,6 +352,7 @@ static igraph_error_t igraph_i_sspf_weighted(
  *                 of the edges that lead to a given node during the traversal
  * \param  inclist the incidence list of the graph
  * \param  cutoff  cutoff length of shortest paths
+ * \param  ws      workspace providing the queue used by the traversal
  */
 static igraph_error_t igraph_i_sspf_weighted_edge(
         const igraph_t *graph,
@@ -340,28 +363,28 @@ static igraph_error_t igraph_i_sspf_weighted_edge(
         igraph_stack_int_t *stack,
         igraph_inclist_t *parents,
         const igraph_inclist_t *inclist,
-        igraph_real_t cutoff) {
+        igraph_real_t cutoff,
+        igraph_workspace_t *ws) {
 
     const igraph_real_t eps = IGRAPH_SHORTEST_PATH_EPSILON;
 
     int cmp_result;
-    igraph_2wheap_t queue;
+    igraph_i_workspace_mark_t mark;
+    igraph_2wheap_t *queue;
     const igraph_vector_int_t *neis;
     igraph_vector_int_t *v;
     igraph_integer_t nlen;
 
-    /* TODO: this is an O|V| step here. We could save some time by pre-allocating
-     * the two-way heap in the caller and re-using it here */
-    IGRAPH_CHECK(igraph_2wheap_init(&queue, igraph_vcount(graph)));
-    IGRAPH_FINALLY(igraph_2wheap_destroy, &queue);
+    igraph_i_workspace_mark(ws, &mark);
+    IGRAPH_CHECK(igraph_i_workspace_2wheap(ws, igraph_vcount(graph), &queue));
 
-    igraph_2wheap_push_with_index(&queue, source, -1.0);
+    igraph_2wheap_push_with_index(queue, source, -1.0);
     VECTOR(*dist)[source] = 1.0;
     nrgeo[source] = 1;
 
-    while (!igraph_2wheap_empty(&queue)) {
-        igraph_integer_t minnei = igraph_2wheap_max_index(&queue);
-        igraph_real_t mindist = -igraph_2wheap_delete_max(&queue);
+    while (!igraph_2wheap_empty(queue)) {
+        igraph_integer_t minnei = igraph_2wheap_max_index(queue);
+        igraph_real_t mindist = -igraph_2wheap_delete_max(queue);
 
         /* Ignore vertices that are more distant than the cutoff */
         if (cutoff >= 0 && mindist > cutoff + 1.0) {
@@ -398,7 +421,7 @@ static igraph_error_t igraph_i_sspf_weighted_edge(
                 VECTOR(*v)[0] = edge;
                 nrgeo[to] = nrgeo[minnei];
                 VECTOR(*dist)[to] = altdist;
-                IGRAPH_CHECK(igraph_2wheap_push_with_index(&queue, to, -altdist));
+                IGRAPH_CHECK(igraph_2wheap_push_with_index(queue, to, -altdist));
             } else if (cmp_result < 0) {
                 /* This is a shorter path */
                 v = igraph_inclist_get(parents, to);
@@ -406,7 +429,7 @@ static igraph_error_t igraph_i_sspf_weighted_edge(
                 VECTOR(*v)[0] = edge;
                 nrgeo[to] = nrgeo[minnei];
                 VECTOR(*dist)[to] = altdist;
-                igraph_2wheap_modify(&queue, to, -altdist);
+                igraph_2wheap_modify(queue, to, -altdist);
             } else if (cmp_result == 0 && (altdist <= cutoff + 1.0 || cutoff < 0)) {
                 /* Only add if the node is not more distant than the cutoff */
                 v = igraph_inclist_get(parents, to);
@@ -416,8 +439,7 @@ static igraph_error_t igraph_i_sspf_weighted_edge(
         }
     }
 
-    igraph_2wheap_destroy(&queue);
-    IGRAPH_FINALLY_CLEAN(1);
+    igraph_i_workspace_release(ws, &mark);
 
     return IGRAPH_SUCCESS;
 }
@@ -449,8 +471,231 @@ static igraph_error_t igraph_i_betweenness_check_weights(
     return IGRAPH_SUCCESS;
 }
 
+/* Data shared by all threads of a betweenness calculation. */
+typedef struct {
+    const igraph_t *graph;
+    const igraph_vector_t *weights;
+    const igraph_adjlist_t *adjlist;    /* unweighted vertex betweenness only */
+    const igraph_inclist_t *inclist;    /* all other cases */
+    igraph_real_t cutoff;
+} igraph_i_betweenness_data_t;
+
+/* Processes the sources first, first + step, first + 2*step, ... and adds
+ * their contributions to 'score'. 'stop' is set by other threads when they
+ * encounter an error; it is NULL when there are no other threads. */
+typedef igraph_error_t igraph_i_betweenness_func_t(
+        const igraph_i_betweenness_data_t *data,
+        igraph_integer_t first, igraph_integer_t step,
+        igraph_real_t *score, igraph_bool_t *stop);
+
+static igraph_bool_t igraph_i_betweenness_stopped(igraph_bool_t *stop) {
+    igraph_bool_t result = false;
+    if (stop) {
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+        result = *stop;
+    }
+    return result;
+}
+
+/**
+ * Runs a betweenness worker function for all sources and stores the raw
+ * scores in \p score, which must be initialized to zeros.
+ *
+ * </para><para>
+ * When igraph is compiled with OpenMP and in thread-safe mode, so that the
+ * error handler and the finally stack are thread-local, sources are
+ * distributed cyclically among the threads, and each thread accumulates
+ * into its own column of a partial score matrix. The columns are summed in
+ * a fixed order, therefore the result depends only on the number of
+ * threads, and not on scheduling.
+ * With a single thread, the computation is identical to the serial one.
+ */
+static igraph_error_t igraph_i_betweenness_run(
+        igraph_i_betweenness_func_t *func,
+        const igraph_i_betweenness_data_t *data,
+        igraph_vector_t *score) {
+
+    igraph_integer_t no_of_nodes = igraph_vcount(data->graph);
+    igraph_integer_t no_of_threads = 1;
+
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+    no_of_threads = omp_get_max_threads();
+    if (no_of_threads > no_of_nodes) {
+        no_of_threads = no_of_nodes;
+    }
+    if (igraph_vector_size(score) == 0) {
+        no_of_threads = 1;
+    }
+#endif
+
+    if (no_of_threads <= 1) {
+        IGRAPH_CHECK(func(data, 0, 1, VECTOR(*score), NULL));
+        return IGRAPH_SUCCESS;
+    }
+
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+    {
+        igraph_matrix_t partial;
+        igraph_vector_int_t errors;
+        igraph_bool_t stop = false;
+        igraph_integer_t i;
+
+        IGRAPH_MATRIX_INIT_FINALLY(&partial, igraph_vector_size(score), no_of_threads);
+        IGRAPH_VECTOR_INT_INIT_FINALLY(&errors, no_of_threads);
+
+#pragma omp parallel num_threads(no_of_threads)
+        {
+            /* The error handler and the finally stack are thread-local.
+             * Errors are recorded, and re-raised by the calling thread. */
+            igraph_error_handler_t *handler = igraph_set_error_handler(igraph_error_handler_ignore);
+            igraph_integer_t team_size = omp_get_num_threads();
+
+            /* The team may be smaller than requested; in that case some
+             * threads take care of more than one slot. */
+            for (igraph_integer_t t = omp_get_thread_num(); t < no_of_threads; t += team_size) {
+                igraph_error_t err;
+                IGRAPH_FINALLY_ENTER();
+                err = func(data, t, no_of_threads, &MATRIX(partial, 0, t), &stop);
+                if (err != IGRAPH_SUCCESS) {
+                    IGRAPH_FINALLY_FREE();
+#pragma omp atomic write
+                    stop = true;
+                }
+                IGRAPH_FINALLY_EXIT();
+                VECTOR(errors)[t] = err;
+            }
+
+            igraph_set_error_handler(handler);
+        }
+
+        for (i = 0; i < no_of_threads; i++) {
+            if (VECTOR(errors)[i] != IGRAPH_SUCCESS) {
+                IGRAPH_ERROR("Parallel betweenness calculation failed.", VECTOR(errors)[i]);
+            }
+        }
+
+        IGRAPH_CHECK(igraph_matrix_rowsum(&partial, score));
+
+        igraph_vector_int_destroy(&errors);
+        igraph_matrix_destroy(&partial);
+        IGRAPH_FINALLY_CLEAN(2);
+    }
+#endif
+
+    return IGRAPH_SUCCESS;
+}
+
 /***** Vertex betweenness *****/
 
+static igraph_error_t igraph_i_betweenness_sources(
+        const igraph_i_betweenness_data_t *data,
+        igraph_integer_t first, igraph_integer_t step,
+        igraph_real_t *score, igraph_bool_t *stop) {
+
+    igraph_integer_t no_of_nodes = igraph_vcount(data->graph);
+    igraph_adjlist_t parents;
+    igraph_integer_t source, j, neighbor;
+    igraph_stack_int_t S;
+    igraph_workspace_t ws;
+    igraph_vector_t dist;
+    /* Note: nrgeo holds the number of shortest paths, which may be very large in some cases,
+     * e.g. in a grid graph. If using an integer type, this results in overflow.
+     * With a 'long long int', overflow already affects the result for a grid as small as 36*36.
+     * Therefore, we use a 'igraph_real_t' instead. While a 'igraph_real_t' holds fewer digits than a
+     * 'long long int', i.e. its precision is lower, it is effectively immune to overflow.
+     * The impact on the precision of the final result is negligible. The max betweenness
+     * is correct to 14 decimal digits, i.e. the precision limit of 'igraph_real_t', even
+     * for a 101*101 grid graph. */
+    igraph_real_t *nrgeo = 0;
+    igraph_real_t *tmpscore;
+
+    IGRAPH_CHECK(igraph_adjlist_init_empty(&parents, no_of_nodes));
+    IGRAPH_FINALLY(igraph_adjlist_destroy, &parents);
+
+    IGRAPH_CHECK(igraph_stack_int_init(&S, no_of_nodes));
+    IGRAPH_FINALLY(igraph_stack_int_destroy, &S);
+
+    IGRAPH_CHECK(igraph_workspace_init(&ws));
+    IGRAPH_FINALLY(igraph_workspace_destroy, &ws);
+
+    IGRAPH_VECTOR_INIT_FINALLY(&dist, no_of_nodes);
+
+    nrgeo = IGRAPH_CALLOC(no_of_nodes, igraph_real_t);
+    IGRAPH_CHECK_OOM(nrgeo, "Insufficient memory for betweenness calculation.");
+    IGRAPH_FINALLY(igraph_free, nrgeo);
+
+    tmpscore = IGRAPH_CALLOC(no_of_nodes, igraph_real_t);
+    IGRAPH_CHECK_OOM(tmpscore, "Insufficient memory for betweenness calculation.");
+    IGRAPH_FINALLY(igraph_free, tmpscore);
+
+    for (source = first; source < no_of_nodes; source += step) {
+
+        /* Loop invariant that is valid at this point:
+         *
+         * - the stack S is empty
+         * - the 'dist' vector contains zeros only
+         * - the 'nrgeo' array contains zeros only
+         * - the 'tmpscore' array contains zeros only
+         * - the 'parents' adjacency list contains empty vectors only
+         */
+
+        if (first == 0) {
+            IGRAPH_PROGRESS("Betweenness centrality: ", 100.0 * source / no_of_nodes, 0);
+            IGRAPH_ALLOW_INTERRUPTION();
+        }
+        if (igraph_i_betweenness_stopped(stop)) {
+            break;
+        }
+
+        /* Conduct a single-source shortest path search from the source node */
+        if (data->weights) {
+            IGRAPH_CHECK(igraph_i_sspf_weighted(data->graph, source, &dist, nrgeo, data->weights,
+                                                &S, &parents, data->inclist, data->cutoff, &ws));
+        } else {
+            IGRAPH_CHECK(igraph_i_sspf(source, &dist, nrgeo, &S, &parents, data->adjlist, data->cutoff, &ws));
+        }
+
+        /* Aggregate betweenness scores for the nodes we have reached in this
+         * traversal */
+        while (!igraph_stack_int_empty(&S)) {
+            igraph_integer_t actnode = igraph_stack_int_pop(&S);
+            igraph_vector_int_t *neis = igraph_adjlist_get(&parents, actnode);
+            igraph_integer_t nneis = igraph_vector_int_size(neis);
+            igraph_real_t coeff = (1 + tmpscore[actnode]) / nrgeo[actnode];
+
+            for (j = 0; j < nneis; j++) {
+                neighbor = VECTOR(*neis)[j];
+                tmpscore[neighbor] += nrgeo[neighbor] * coeff;
+            }
+
+            if (actnode != source) {
+                score[actnode] += tmpscore[actnode];
+            }
+
+            /* Reset variables to ensure that the 'for' loop invariant will
+             * still be valid in the next iteration */
+
+            VECTOR(dist)[actnode] = 0;
+            nrgeo[actnode] = 0;
+            tmpscore[actnode] = 0;
+            igraph_vector_int_clear(neis);
+        }
+
+    } /* for source < no_of_nodes */
+
+    IGRAPH_FREE(nrgeo);
+    IGRAPH_FREE(tmpscore);
+    igraph_vector_destroy(&dist);
+    igraph_workspace_destroy(&ws);
+    igraph_stack_int_destroy(&S);
+    igraph_adjlist_destroy(&parents);
+    IGRAPH_FINALLY_CLEAN(6);
+
+    return IGRAPH_SUCCESS;
+}
+
 /**
  * \ingroup structural
  * \function igraph_betweenness
@@ -512,6 +757,18 @@ igraph_error_t igraph_betweenness(const igraph_t *graph, igraph_vector_t *res,
  * by considering only those shortest paths whose length is no greater
  * then the given cutoff value.
  *
+ * </para><para>
+ * If igraph is compiled with OpenMP support and in thread-safe mode (see
+ * \ref IGRAPH_THREAD_SAFE), the shortest path searches from different source
+ * vertices are run in parallel OpenMP threads. Each
+ * thread keeps its own copy of the scores, thus the additional memory use
+ * is O(T|V|) for T threads. Partial scores are combined in a fixed order,
+ * so the result does not depend on thread scheduling, but it may differ
+ * by a few units in the last place for different numbers of threads. If
+ * you need results that are reproducible across machines, force the number
+ * of OpenMP threads to 1, either by calling <code>omp_set_num_threads(1)</code>
+ * or by setting the value of the \c OMP_NUM_THREADS environment variable to 1.
+ *
  * \param graph The graph object.
  * \param res The result of the computation, a vector containing the
  *        range-limited betweenness scores for the specified vertices.
@@ -548,51 +805,32 @@ igraph_error_t igraph_betweenness_cutoff(const igraph_t *graph, igraph_vector_t
 
     igraph_integer_t no_of_nodes = igraph_vcount(graph);
     igraph_integer_t no_of_edges = igraph_ecount(graph);
-    igraph_adjlist_t adjlist, parents;
+    igraph_adjlist_t adjlist;
     igraph_inclist_t inclist;
-    igraph_integer_t source, j, neighbor;
-    igraph_stack_int_t S;
+    igraph_integer_t j;
     igraph_neimode_t mode = directed ? IGRAPH_OUT : IGRAPH_ALL;
-    igraph_vector_t dist;
-    /* Note: nrgeo holds the number of shortest paths, which may be very large in some cases,
-     * e.g. in a grid graph. If using an integer type, this results in overflow.
-     * With a 'long long int', overflow already affects the result for a grid as small as 36*36.
-     * Therefore, we use a 'igraph_real_t' instead. While a 'igraph_real_t' holds fewer digits than a
-     * 'long long int', i.e. its precision is lower, it is effectively immune to overflow.
-     * The impact on the precision of the final result is negligible. The max betweenness
-     * is correct to 14 decimal digits, i.e. the precision limit of 'igraph_real_t', even
-     * for a 101*101 grid graph. */
-    igraph_real_t *nrgeo = 0;
-    igraph_real_t *tmpscore;
     igraph_vector_t v_tmpres, *tmpres = &v_tmpres;
     igraph_vit_t vit;
+    igraph_i_betweenness_data_t data;
 
     IGRAPH_CHECK(igraph_i_betweenness_check_weights(weights, no_of_edges));
 
+    data.graph = graph;
+    data.weights = weights;
+    data.adjlist = NULL;
+    data.inclist = NULL;
+    data.cutoff = cutoff;
+
     if (weights) {
         IGRAPH_CHECK(igraph_inclist_init(graph, &inclist, mode, IGRAPH_NO_LOOPS));
         IGRAPH_FINALLY(igraph_inclist_destroy, &inclist);
+        data.inclist = &inclist;
     } else {
         IGRAPH_CHECK(igraph_adjlist_init(graph, &adjlist, mode, IGRAPH_NO_LOOPS, IGRAPH_MULTIPLE));
         IGRAPH_FINALLY(igraph_adjlist_destroy, &adjlist);
+        data.adjlist = &adjlist;
     }
 
-    IGRAPH_CHECK(igraph_adjlist_init_empty(&parents, no_of_nodes));
-    IGRAPH_FINALLY(igraph_adjlist_destroy, &parents);
-
-    IGRAPH_CHECK(igraph_stack_int_init(&S, no_of_nodes));
-    IGRAPH_FINALLY(igraph_stack_int_destroy, &S);
-
-    IGRAPH_VECTOR_INIT_FINALLY(&dist, no_of_nodes);
-
-    nrgeo = IGRAPH_CALLOC(no_of_nodes, igraph_real_t);
-    IGRAPH_CHECK_OOM(nrgeo, "Insufficient memory for betweenness calculation.");
-    IGRAPH_FINALLY(igraph_free, nrgeo);
-
-    tmpscore = IGRAPH_CALLOC(no_of_nodes, igraph_real_t);
-    IGRAPH_CHECK_OOM(tmpscore, "Insufficient memory for betweenness calculation.");
-    IGRAPH_FINALLY(igraph_free, tmpscore);
-
     if (igraph_vs_is_all(&vids)) {
         /* result covers all vertices */
         IGRAPH_CHECK(igraph_vector_resize(res, no_of_nodes));
@@ -603,54 +841,7 @@ igraph_error_t igraph_betweenness_cutoff(const igraph_t *graph, igraph_vector_t
         IGRAPH_VECTOR_INIT_FINALLY(tmpres, no_of_nodes);
     }
 
-    for (source = 0; source < no_of_nodes; source++) {
-
-        /* Loop invariant that is valid at this point:
-         *
-         * - the stack S is empty
-         * - the 'dist' vector contains zeros only
-         * - the 'nrgeo' array contains zeros only
-         * - the 'tmpscore' array contains zeros only
-         * - the 'parents' adjacency list contains empty vectors only
-         */
-
-        IGRAPH_PROGRESS("Betweenness centrality: ", 100.0 * source / no_of_nodes, 0);
-        IGRAPH_ALLOW_INTERRUPTION();
-
-        /* Conduct a single-source shortest path search from the source node */
-        if (weights) {
-            IGRAPH_CHECK(igraph_i_sspf_weighted(graph, source, &dist, nrgeo, weights, &S, &parents, &inclist, cutoff));
-        } else {
-            IGRAPH_CHECK(igraph_i_sspf(source, &dist, nrgeo, &S, &parents, &adjlist, cutoff));
-        }
-
-        /* Aggregate betweenness scores for the nodes we have reached in this
-         * traversal */
-        while (!igraph_stack_int_empty(&S)) {
-            igraph_integer_t actnode = igraph_stack_int_pop(&S);
-            igraph_vector_int_t *neis = igraph_adjlist_get(&parents, actnode);
-            igraph_integer_t nneis = igraph_vector_int_size(neis);
-            igraph_real_t coeff = (1 + tmpscore[actnode]) / nrgeo[actnode];
-
-            for (j = 0; j < nneis; j++) {
-                neighbor = VECTOR(*neis)[j];
-                tmpscore[neighbor] += nrgeo[neighbor] * coeff;
-            }
-
-            if (actnode != source) {
-                VECTOR(*tmpres)[actnode] += tmpscore[actnode];
-            }
-
-            /* Reset variables to ensure that the 'for' loop invariant will
-             * still be valid in the next iteration */
-
-            VECTOR(dist)[actnode] = 0;
-            nrgeo[actnode] = 0;
-            tmpscore[actnode] = 0;
-            igraph_vector_int_clear(neis);
-        }
-
-    } /* for source < no_of_nodes */
+    IGRAPH_CHECK(igraph_i_betweenness_run(igraph_i_betweenness_sources, &data, tmpres));
 
     /* Keep only the requested vertices */
     if (!igraph_vs_is_all(&vids)) {
@@ -675,120 +866,32 @@ igraph_error_t igraph_betweenness_cutoff(const igraph_t *graph, igraph_vector_t
 
     IGRAPH_PROGRESS("Betweenness centrality: ", 100.0, 0);
 
-    IGRAPH_FREE(nrgeo);
-    IGRAPH_FREE(tmpscore);
-    igraph_vector_destroy(&dist);
-    igraph_stack_int_destroy(&S);
-    igraph_adjlist_destroy(&parents);
     if (weights) {
         igraph_inclist_destroy(&inclist);
     } else {
         igraph_adjlist_destroy(&adjlist);
     }
-    IGRAPH_FINALLY_CLEAN(6);
+    IGRAPH_FINALLY_CLEAN(1);
 
     return IGRAPH_SUCCESS;
 }
 
 /***** Edge betweenness *****/
 
+static igraph_error_t igraph_i_edge_betweenness_sources(
+        const igraph_i_betweenness_data_t *data,
+        igraph_integer_t first, igraph_integer_t step,
+        igraph_real_t *score, igraph_bool_t *stop) {
 
-/**
- * \ingroup structural
- * \function igraph_edge_betweenness
- * \brief Betweenness centrality of the edges.
- *
- * The betweenness centrality of an edge is the number of geodesics
- * going through it. If there are more than one geodesics between two
- * vertices, the value of these geodesics are weighted by one over the
- * number of geodesics.
- *
- * </para><para>
- * Reference:
- *
- * </para><para>
- * Ulrik Brandes: A faster algorithm for betweenness centrality.
- * The Journal of Mathematical Sociology, 25(2), 163–177 (2001).
- * https://doi.org/10.1080/0022250X.2001.9990249
- *
- * \param graph The graph object.
- * \param result The result of the computation, vector containing the
- *        betweenness scores for the edges.
- * \param directed If true directed paths will be considered
- *        for directed graphs. It is ignored for undirected graphs.
- * \param weights An optional weight vector for weighted edge
- *        betweenness. No edge weight may be NaN. Supply a null
- *        pointer here for the unweighted version.
- * \return Error code:
- *        \c IGRAPH_ENOMEM, not enough memory for
- *        temporary data.
- *
- * Time complexity: O(|V||E|),
- * |V| and
- * |E| are the number of vertices and
- * edges in the graph.
- *
- * \sa Other centrality types: \ref igraph_degree(), \ref igraph_closeness().
- *     See \ref igraph_edge_betweenness() for calculating the betweenness score
- *     of the edges in a graph. See \ref igraph_edge_betweenness_cutoff() to
- *     compute the range-limited betweenness score of the edges in a graph.
- */
-igraph_error_t igraph_edge_betweenness(const igraph_t *graph, igraph_vector_t *result,
-                            igraph_bool_t directed,
-                            const igraph_vector_t *weights) {
-    return igraph_edge_betweenness_cutoff(graph, result, directed,
-                                          weights, -1);
-}
-
-/**
- * \ingroup structural
- * \function igraph_edge_betweenness_cutoff
- * \brief Range-limited betweenness centrality of the edges.
- *
- * This function computes a range-limited version of edge betweenness centrality
- * by considering only those shortest paths whose length is no greater
- * then the given cutoff value.
- *
- * \param graph The graph object.
- * \param result The result of the computation, vector containing the
- *        betweenness scores for the edges.
- * \param directed If true directed paths will be considered
- *        for directed graphs. It is ignored for undirected graphs.
- * \param weights An optional weight vector for weighted
- *        betweenness. No edge weight may be NaN. Supply a null
- *        pointer here for unweighted betweenness.
- * \param cutoff The maximal length of paths that will be considered.
- *        If negative, the exact betweenness will be calculated (no
- *        upper limit on path lengths).
- * \return Error code:
- *        \c IGRAPH_ENOMEM, not enough memory for
- *        temporary data.
- *
- * Time complexity: O(|V||E|),
- * |V| and
- * |E| are the number of vertices and
- * edges in the graph.
- *
- * \sa \ref igraph_edge_betweenness() to compute the exact edge betweenness and
- * \ref igraph_betweenness_cutoff() to compute the range-limited vertex betweenness.
- */
-igraph_error_t igraph_edge_betweenness_cutoff(const igraph_t *graph, igraph_vector_t *result,
-                                   igraph_bool_t directed,
-                                   const igraph_vector_t *weights, igraph_real_t cutoff) {
-    igraph_integer_t no_of_nodes = igraph_vcount(graph);
-    igraph_integer_t no_of_edges = igraph_ecount(graph);
-    igraph_inclist_t inclist, parents;
-    igraph_neimode_t mode = directed ? IGRAPH_OUT : IGRAPH_ALL;
-    igraph_vector_t dist;
-    igraph_real_t *nrgeo;
-    igraph_real_t *tmpscore;
-    igraph_integer_t source, j;
-    igraph_stack_int_t S;
-
-    IGRAPH_CHECK(igraph_i_betweenness_check_weights(weights, no_of_edges));
-
-    IGRAPH_CHECK(igraph_inclist_init(graph, &inclist, mode, IGRAPH_NO_LOOPS));
-    IGRAPH_FINALLY(igraph_inclist_destroy, &inclist);
+    const igraph_t *graph = data->graph;
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_inclist_t parents;
+    igraph_vector_t dist;
+    igraph_real_t *nrgeo;
+    igraph_real_t *tmpscore;
+    igraph_integer_t source, j;
+    igraph_stack_int_t S;
+    igraph_workspace_t ws;
 
     IGRAPH_CHECK(igraph_inclist_init_empty(&parents, no_of_nodes));
     IGRAPH_FINALLY(igraph_inclist_destroy, &parents);
@@ -808,10 +911,10 @@ igraph_error_t igraph_edge_betweenness_cutoff(const igraph_t *graph, igraph_vect
     IGRAPH_CHECK(igraph_stack_int_init(&S, no_of_nodes));
     IGRAPH_FINALLY(igraph_stack_int_destroy, &S);
 
-    IGRAPH_CHECK(igraph_vector_resize(result, no_of_edges));
-    igraph_vector_null(result);
+    IGRAPH_CHECK(igraph_workspace_init(&ws));
+    IGRAPH_FINALLY(igraph_workspace_destroy, &ws);
 
-    for (source = 0; source < no_of_nodes; source++) {
+    for (source = first; source < no_of_nodes; source += step) {
 
         /* Loop invariant that is valid at this point:
          *
@@ -822,14 +925,21 @@ igraph_error_t igraph_edge_betweenness_cutoff(const igraph_t *graph, igraph_vect
          * - the 'parents' incidence list contains empty vectors only
          */
 
-        IGRAPH_PROGRESS("Edge betweenness centrality: ", 100.0 * source / no_of_nodes, 0);
-        IGRAPH_ALLOW_INTERRUPTION();
+        if (first == 0) {
+            IGRAPH_PROGRESS("Edge betweenness centrality: ", 100.0 * source / no_of_nodes, 0);
+            IGRAPH_ALLOW_INTERRUPTION();
+        }
+        if (igraph_i_betweenness_stopped(stop)) {
+            break;
+        }
 
         /* Conduct a single-source shortest path search from the source node */
-        if (weights) {
-            IGRAPH_CHECK(igraph_i_sspf_weighted_edge(graph, source, &dist, nrgeo, weights, &S, &parents, &inclist, cutoff));
+        if (data->weights) {
+            IGRAPH_CHECK(igraph_i_sspf_weighted_edge(graph, source, &dist, nrgeo, data->weights,
+                                                     &S, &parents, data->inclist, data->cutoff, &ws));
         } else {
-            IGRAPH_CHECK(igraph_i_sspf_edge(graph, source, &dist, nrgeo, &S, &parents, &inclist, cutoff));
+            IGRAPH_CHECK(igraph_i_sspf_edge(graph, source, &dist, nrgeo, &S, &parents,
+                                            data->inclist, data->cutoff, &ws));
         }
 
         /* Aggregate betweenness scores for the edges we have reached in this
@@ -844,7 +954,7 @@ igraph_error_t igraph_edge_betweenness_cutoff(const igraph_t *graph, igraph_vect
                 igraph_integer_t fedge = VECTOR(*fatv)[j];
                 igraph_integer_t neighbor = IGRAPH_OTHER(graph, fedge, actnode);
                 tmpscore[neighbor] += nrgeo[neighbor] * coeff;
-                VECTOR(*result)[fedge] += nrgeo[neighbor] * coeff;
+                score[fedge] += nrgeo[neighbor] * coeff;
             }
 
             /* Reset variables to ensure that the 'for' loop invariant will
@@ -857,19 +967,134 @@ igraph_error_t igraph_edge_betweenness_cutoff(const igraph_t *graph, igraph_vect
         }
     } /* source < no_of_nodes */
 
+    igraph_workspace_destroy(&ws);
+    igraph_stack_int_destroy(&S);
+    igraph_inclist_destroy(&parents);
+    igraph_vector_destroy(&dist);
+    IGRAPH_FREE(tmpscore);
+    IGRAPH_FREE(nrgeo);
+    IGRAPH_FINALLY_CLEAN(6);
+
+    return IGRAPH_SUCCESS;
+}
+
+
+/**
+ * \ingroup structural
+ * \function igraph_edge_betweenness
+ * \brief Betweenness centrality of the edges.
+ *
+ * The betweenness centrality of an edge is the number of geodesics
+ * going through it. If there are more than one geodesics between two
+ * vertices, the value of these geodesics are weighted by one over the
+ * number of geodesics.
+ *
+ * </para><para>
+ * Reference:
+ *
+ * </para><para>
+ * Ulrik Brandes: A faster algorithm for betweenness centrality.
+ * The Journal of Mathematical Sociology, 25(2), 163–177 (2001).
+ * https://doi.org/10.1080/0022250X.2001.9990249
+ *
+ * \param graph The graph object.
+ * \param result The result of the computation, vector containing the
+ *        betweenness scores for the edges.
+ * \param directed If true directed paths will be considered
+ *        for directed graphs. It is ignored for undirected graphs.
+ * \param weights An optional weight vector for weighted edge
+ *        betweenness. No edge weight may be NaN. Supply a null
+ *        pointer here for the unweighted version.
+ * \return Error code:
+ *        \c IGRAPH_ENOMEM, not enough memory for
+ *        temporary data.
+ *
+ * Time complexity: O(|V||E|),
+ * |V| and
+ * |E| are the number of vertices and
+ * edges in the graph.
+ *
+ * \sa Other centrality types: \ref igraph_degree(), \ref igraph_closeness().
+ *     See \ref igraph_edge_betweenness() for calculating the betweenness score
+ *     of the edges in a graph. See \ref igraph_edge_betweenness_cutoff() to
+ *     compute the range-limited betweenness score of the edges in a graph.
+ */
+igraph_error_t igraph_edge_betweenness(const igraph_t *graph, igraph_vector_t *result,
+                            igraph_bool_t directed,
+                            const igraph_vector_t *weights) {
+    return igraph_edge_betweenness_cutoff(graph, result, directed,
+                                          weights, -1);
+}
+
+/**
+ * \ingroup structural
+ * \function igraph_edge_betweenness_cutoff
+ * \brief Range-limited betweenness centrality of the edges.
+ *
+ * This function computes a range-limited version of edge betweenness centrality
+ * by considering only those shortest paths whose length is no greater
+ * then the given cutoff value.
+ *
+ * </para><para>
+ * With OpenMP support, the computation is parallelized in the same way as
+ * in \ref igraph_betweenness_cutoff(). The additional memory use is O(T|E|)
+ * for T threads.
+ *
+ * \param graph The graph object.
+ * \param result The result of the computation, vector containing the
+ *        betweenness scores for the edges.
+ * \param directed If true directed paths will be considered
+ *        for directed graphs. It is ignored for undirected graphs.
+ * \param weights An optional weight vector for weighted
+ *        betweenness. No edge weight may be NaN. Supply a null
+ *        pointer here for unweighted betweenness.
+ * \param cutoff The maximal length of paths that will be considered.
+ *        If negative, the exact betweenness will be calculated (no
+ *        upper limit on path lengths).
+ * \return Error code:
+ *        \c IGRAPH_ENOMEM, not enough memory for
+ *        temporary data.
+ *
+ * Time complexity: O(|V||E|),
+ * |V| and
+ * |E| are the number of vertices and
+ * edges in the graph.
+ *
+ * \sa \ref igraph_edge_betweenness() to compute the exact edge betweenness and
+ * \ref igraph_betweenness_cutoff() to compute the range-limited vertex betweenness.
+ */
+igraph_error_t igraph_edge_betweenness_cutoff(const igraph_t *graph, igraph_vector_t *result,
+                                   igraph_bool_t directed,
+                                   const igraph_vector_t *weights, igraph_real_t cutoff) {
+    igraph_integer_t no_of_edges = igraph_ecount(graph);
+    igraph_inclist_t inclist;
+    igraph_neimode_t mode = directed ? IGRAPH_OUT : IGRAPH_ALL;
+    igraph_i_betweenness_data_t data;
+
+    IGRAPH_CHECK(igraph_i_betweenness_check_weights(weights, no_of_edges));
+
+    IGRAPH_CHECK(igraph_inclist_init(graph, &inclist, mode, IGRAPH_NO_LOOPS));
+    IGRAPH_FINALLY(igraph_inclist_destroy, &inclist);
+
+    data.graph = graph;
+    data.weights = weights;
+    data.adjlist = NULL;
+    data.inclist = &inclist;
+    data.cutoff = cutoff;
+
+    IGRAPH_CHECK(igraph_vector_resize(result, no_of_edges));
+    igraph_vector_null(result);
+
+    IGRAPH_CHECK(igraph_i_betweenness_run(igraph_i_edge_betweenness_sources, &data, result));
+
     if (!directed || !igraph_is_directed(graph)) {
         igraph_vector_scale(result, 0.5);
     }
 
     IGRAPH_PROGRESS("Edge betweenness centrality: ", 100.0, 0);
 
-    igraph_stack_int_destroy(&S);
     igraph_inclist_destroy(&inclist);
-    igraph_inclist_destroy(&parents);
-    igraph_vector_destroy(&dist);
-    IGRAPH_FREE(tmpscore);
-    IGRAPH_FREE(nrgeo);
-    IGRAPH_FINALLY_CLEAN(6);
+    IGRAPH_FINALLY_CLEAN(1);
 
     return IGRAPH_SUCCESS;
 }
@@ -923,6 +1148,7 @@ igraph_error_t igraph_betweenness_subset(const igraph_t *graph, igraph_vector_t
     igraph_inclist_t inclist;
     igraph_integer_t source, j;
     igraph_stack_int_t S;
+    igraph_workspace_t ws;
     igraph_vector_t v_tmpres, *tmpres = &v_tmpres;
     igraph_neimode_t mode = directed ? IGRAPH_OUT : IGRAPH_ALL;
     igraph_integer_t father;
@@ -950,6 +1176,9 @@ igraph_error_t igraph_betweenness_subset(const igraph_t *graph, igraph_vector_t
     IGRAPH_CHECK(igraph_stack_int_init(&S, no_of_nodes));
     IGRAPH_FINALLY(igraph_stack_int_destroy, &S);
 
+    IGRAPH_CHECK(igraph_workspace_init(&ws));
+    IGRAPH_FINALLY(igraph_workspace_destroy, &ws);
+
     IGRAPH_VECTOR_INIT_FINALLY(&dist, no_of_nodes);
 
     nrgeo = IGRAPH_CALLOC(no_of_nodes, igraph_real_t);
@@ -1016,9 +1245,9 @@ igraph_error_t igraph_betweenness_subset(const igraph_t *graph, igraph_vector_t
 
         /* Conduct a single-source shortest path search from the source node */
         if (weights) {
-            IGRAPH_CHECK(igraph_i_sspf_weighted(graph, source, &dist, nrgeo, weights, &S, &parents, &inclist, -1));
+            IGRAPH_CHECK(igraph_i_sspf_weighted(graph, source, &dist, nrgeo, weights, &S, &parents, &inclist, -1, &ws));
         } else {
-            IGRAPH_CHECK(igraph_i_sspf(source, &dist, nrgeo, &S, &parents, &adjlist, -1));
+            IGRAPH_CHECK(igraph_i_sspf(source, &dist, nrgeo, &S, &parents, &adjlist, -1, &ws));
         }
 
         /* Aggregate betweenness scores for the nodes we have reached in this
@@ -1082,6 +1311,7 @@ igraph_error_t igraph_betweenness_subset(const igraph_t *graph, igraph_vector_t
     IGRAPH_FREE(tmpscore);
     IGRAPH_FREE(nrgeo);
     igraph_vector_destroy(&dist);
+    igraph_workspace_destroy(&ws);
     igraph_stack_int_destroy(&S);
     igraph_adjlist_destroy(&parents);
     if (weights) {
@@ -1089,7 +1319,7 @@ igraph_error_t igraph_betweenness_subset(const igraph_t *graph, igraph_vector_t
     } else {
         igraph_adjlist_destroy(&adjlist);
     }
-    IGRAPH_FINALLY_CLEAN(7);
+    IGRAPH_FINALLY_CLEAN(8);
 
     return IGRAPH_SUCCESS;
 }
@@ -1147,6 +1377,7 @@ igraph_error_t igraph_edge_betweenness_subset(const igraph_t *graph, igraph_vect
     igraph_integer_t source, j;
     bool *is_target;
     igraph_stack_int_t S;
+    igraph_workspace_t ws;
 
     IGRAPH_CHECK(igraph_i_betweenness_check_weights(weights, no_of_edges));
 
@@ -1182,6 +1413,9 @@ igraph_error_t igraph_edge_betweenness_subset(const igraph_t *graph, igraph_vect
     IGRAPH_CHECK(igraph_stack_int_init(&S, no_of_nodes));
     IGRAPH_FINALLY(igraph_stack_int_destroy, &S);
 
+    IGRAPH_CHECK(igraph_workspace_init(&ws));
+    IGRAPH_FINALLY(igraph_workspace_destroy, &ws);
+
     if (!igraph_es_is_all(&eids)) {
         /* result needed only for a subset of the vertices */
         IGRAPH_VECTOR_INIT_FINALLY(tmpres, no_of_edges);
@@ -1226,9 +1460,9 @@ igraph_error_t igraph_edge_betweenness_subset(const igraph_t *graph, igraph_vect
 
         /* Conduct a single-source shortest path search from the source node */
         if (weights) {
-            IGRAPH_CHECK(igraph_i_sspf_weighted_edge(graph, source, &dist, nrgeo, weights, &S, &parents, &inclist, -1));
+            IGRAPH_CHECK(igraph_i_sspf_weighted_edge(graph, source, &dist, nrgeo, weights, &S, &parents, &inclist, -1, &ws));
         } else {
-            IGRAPH_CHECK(igraph_i_sspf_edge(graph, source, &dist, nrgeo, &S, &parents, &inclist, -1));
+            IGRAPH_CHECK(igraph_i_sspf_edge(graph, source, &dist, nrgeo, &S, &parents, &inclist, -1, &ws));
         }
 
         /* Aggregate betweenness scores for the nodes we have reached in this
@@ -1288,6 +1522,7 @@ igraph_error_t igraph_edge_betweenness_subset(const igraph_t *graph, igraph_vect
         igraph_vector_scale(res, 0.5);
     }
 
+    igraph_workspace_destroy(&ws);
     igraph_stack_int_destroy(&S);
     IGRAPH_FREE(tmpscore);
     IGRAPH_FREE(nrgeo);
@@ -1295,7 +1530,372 @@ igraph_error_t igraph_edge_betweenness_subset(const igraph_t *graph, igraph_vect
     igraph_inclist_destroy(&parents);
     igraph_inclist_destroy(&inclist);
     IGRAPH_FREE(is_target);
-    IGRAPH_FINALLY_CLEAN(7);
+    IGRAPH_FINALLY_CLEAN(8);
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * Upper bound on the vertex diameter, i.e. on the number of vertices in
+ * any shortest path, which determines the sample size needed by
+ * igraph_betweenness_approx().
+ *
+ * </para><para>
+ * For unweighted undirected graphs, a breadth-first search is started from
+ * one vertex \c s of each connected component. No shortest path in the
+ * component can have more than <code>2 ecc(s)</code> edges. In all other
+ * cases, the size of the largest weakly connected component is used.
+ */
+static igraph_error_t igraph_i_betweenness_vertex_diameter_bound(
+        const igraph_t *graph, igraph_bool_t undirected,
+        const igraph_vector_t *weights, const igraph_adjlist_t *adjlist,
+        igraph_integer_t *bound) {
+
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t i;
+
+    *bound = 0;
+
+    if (weights || !undirected) {
+        igraph_vector_int_t csize;
+        IGRAPH_VECTOR_INT_INIT_FINALLY(&csize, 0);
+        IGRAPH_CHECK(igraph_connected_components(graph, NULL, &csize, NULL, IGRAPH_WEAK));
+        if (igraph_vector_int_size(&csize) > 0) {
+            *bound = igraph_vector_int_max(&csize);
+        }
+        igraph_vector_int_destroy(&csize);
+        IGRAPH_FINALLY_CLEAN(1);
+    } else {
+        igraph_adjlist_t parents;
+        igraph_stack_int_t S;
+        igraph_workspace_t ws;
+        igraph_vector_t dist;
+        igraph_real_t *nrgeo;
+        igraph_bitset_t seen;
+
+        IGRAPH_CHECK(igraph_adjlist_init_empty(&parents, no_of_nodes));
+        IGRAPH_FINALLY(igraph_adjlist_destroy, &parents);
+        IGRAPH_CHECK(igraph_stack_int_init(&S, no_of_nodes));
+        IGRAPH_FINALLY(igraph_stack_int_destroy, &S);
+
+        IGRAPH_CHECK(igraph_workspace_init(&ws));
+        IGRAPH_FINALLY(igraph_workspace_destroy, &ws);
+        IGRAPH_VECTOR_INIT_FINALLY(&dist, no_of_nodes);
+        nrgeo = IGRAPH_CALLOC(no_of_nodes, igraph_real_t);
+        IGRAPH_CHECK_OOM(nrgeo, "Insufficient memory for betweenness calculation.");
+        IGRAPH_FINALLY(igraph_free, nrgeo);
+        IGRAPH_BITSET_INIT_FINALLY(&seen, no_of_nodes);
+
+        for (i = 0; i < no_of_nodes; i++) {
+            igraph_integer_t ecc = 0;
+
+            if (IGRAPH_BIT_TEST(seen, i)) {
+                continue;
+            }
+
+            IGRAPH_ALLOW_INTERRUPTION();
+
+            IGRAPH_CHECK(igraph_i_sspf(i, &dist, nrgeo, &S, &parents, adjlist, -1, &ws));
+            while (!igraph_stack_int_empty(&S)) {
+                igraph_integer_t actnode = igraph_stack_int_pop(&S);
+                igraph_integer_t d = VECTOR(dist)[actnode] - 1;
+                if (d > ecc) {
+                    ecc = d;
+                }
+                IGRAPH_BIT_SET(seen, actnode);
+                VECTOR(dist)[actnode] = 0;
+                nrgeo[actnode] = 0;
+                igraph_vector_int_clear(igraph_adjlist_get(&parents, actnode));
+            }
+
+            if (2 * ecc + 1 > *bound) {
+                *bound = 2 * ecc + 1;
+            }
+        }
+
+        igraph_bitset_destroy(&seen);
+        IGRAPH_FREE(nrgeo);
+        igraph_vector_destroy(&dist);
+        igraph_workspace_destroy(&ws);
+        igraph_stack_int_destroy(&S);
+        igraph_adjlist_destroy(&parents);
+        IGRAPH_FINALLY_CLEAN(6);
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup structural
+ * \function igraph_betweenness_approx
+ * \brief Approximate betweenness centrality with a guaranteed error bound.
+ *
+ * \experimental
+ *
+ * This function estimates the betweenness centrality of all vertices by
+ * sampling shortest paths, following the method of Riondato and Kornaropoulos.
+ * In each sample, a pair of distinct vertices <code>(u, v)</code> is chosen
+ * uniformly at random, and one of the shortest paths from \c u to \c v is
+ * chosen uniformly at random. The score of every inner vertex of that path
+ * is increased.
+ *
+ * </para><para>
+ * The number of samples is chosen so that, with probability at least
+ * <code>1 - delta</code>, the estimates of \em all vertices are within
+ * <code>epsilon * P</code> of their exact betweenness, where \c P is the
+ * number of vertex pairs: <code>n (n-1)</code> when directed paths are
+ * considered and <code>n (n-1) / 2</code> otherwise. The sample size is
+ * <code>c / epsilon^2 (floor(log2(VD - 2)) + 1 + ln(1/delta))</code> with
+ * <code>c = 0.5</code>, where \c VD is an upper bound on the number of
+ * vertices in a shortest path. For undirected unweighted graphs, this bound
+ * is computed with a breadth-first search from one vertex of each connected
+ * component; otherwise the size of the largest weakly connected component is
+ * used. The bound achieved by the actual sample size is returned in
+ * \p error_bound.
+ *
+ * </para><para>
+ * Each sample costs a single-source shortest path search. When at least
+ * as many samples would be needed as there are vertices, the exact
+ * betweenness is computed instead with \ref igraph_betweenness(), which is
+ * then cheaper, and the error bound is zero.
+ *
+ * </para><para>
+ * This function uses igraph's random number generator, so the results
+ * depend on its state.
+ *
+ * </para><para>
+ * Reference:
+ *
+ * </para><para>
+ * Matteo Riondato and Evgenios M. Kornaropoulos:
+ * Fast approximation of betweenness centrality through sampling.
+ * Data Mining and Knowledge Discovery, 30, 438–475 (2016).
+ * https://doi.org/10.1007/s10618-015-0423-0
+ *
+ * \param graph The graph object.
+ * \param res The result of the computation, a vector containing the
+ *        estimated betweenness scores for the specified vertices, on the
+ *        same scale as the result of \ref igraph_betweenness().
+ * \param vids The vertices for which the betweenness scores will be returned.
+ * \param directed If true directed paths will be considered
+ *        for directed graphs. It is ignored for undirected graphs.
+ * \param weights An optional vector containing edge weights for
+ *        calculating weighted betweenness. No edge weight may be NaN.
+ *        Supply a null pointer here for unweighted betweenness.
+ * \param epsilon The requested relative error, relative to the number
+ *        of vertex pairs. Must be between 0 and 1.
+ * \param delta The allowed probability of exceeding the error bound.
+ *        Must be between 0 and 1.
+ * \param error_bound If not \c NULL, the achieved absolute error bound of
+ *        all returned scores is stored here. It is not larger than
+ *        <code>epsilon * P</code>, and it is zero when the exact betweenness
+ *        was computed.
+ * \param samples If not \c NULL, the number of sampled paths is stored
+ *        here. It is zero when the exact betweenness was computed.
+ * \return Error code:
+ *        \c IGRAPH_ENOMEM, not enough memory for temporary data.
+ *        \c IGRAPH_EINVVID, invalid vertex ID passed in \p vids.
+ *        \c IGRAPH_EINVAL, invalid \p epsilon, \p delta or weights.
+ *
+ * Time complexity: O(r |E|) for r samples in unweighted graphs and
+ * O(r |E| log |V|) in weighted ones, where r is at most |V|.
+ *
+ * \sa \ref igraph_betweenness() for the exact computation,
+ * \ref igraph_betweenness_subset() to consider only paths between a subset of
+ * the vertices.
+ */
+igraph_error_t igraph_betweenness_approx(const igraph_t *graph, igraph_vector_t *res,
+                              const igraph_vs_t vids, igraph_bool_t directed,
+                              const igraph_vector_t *weights,
+                              igraph_real_t epsilon, igraph_real_t delta,
+                              igraph_real_t *error_bound, igraph_integer_t *samples) {
+
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t no_of_edges = igraph_ecount(graph);
+    igraph_bool_t undirected = !directed || !igraph_is_directed(graph);
+    igraph_neimode_t mode = undirected ? IGRAPH_ALL : IGRAPH_OUT;
+    igraph_real_t no_of_pairs = (igraph_real_t) no_of_nodes * (no_of_nodes - 1);
+    igraph_adjlist_t adjlist, parents;
+    igraph_inclist_t inclist;
+    igraph_stack_int_t S;
+    igraph_workspace_t ws;
+    igraph_vector_t dist;
+    igraph_real_t *nrgeo;
+    igraph_vector_t v_tmpres, *tmpres = &v_tmpres;
+    igraph_vit_t vit;
+    igraph_integer_t vd, no_of_samples, i, j;
+    igraph_real_t log_term, needed;
+
+    if (! (epsilon > 0 && epsilon < 1)) {
+        IGRAPH_ERRORF("Epsilon must be between 0 and 1, got %g.", IGRAPH_EINVAL, epsilon);
+    }
+    if (! (delta > 0 && delta < 1)) {
+        IGRAPH_ERRORF("Delta must be between 0 and 1, got %g.", IGRAPH_EINVAL, delta);
+    }
+
+    IGRAPH_CHECK(igraph_i_betweenness_check_weights(weights, no_of_edges));
+
+    if (weights) {
+        IGRAPH_CHECK(igraph_inclist_init(graph, &inclist, mode, IGRAPH_NO_LOOPS));
+        IGRAPH_FINALLY(igraph_inclist_destroy, &inclist);
+    } else {
+        IGRAPH_CHECK(igraph_adjlist_init(graph, &adjlist, mode, IGRAPH_NO_LOOPS, IGRAPH_MULTIPLE));
+        IGRAPH_FINALLY(igraph_adjlist_destroy, &adjlist);
+    }
+
+    IGRAPH_CHECK(igraph_i_betweenness_vertex_diameter_bound(graph, undirected, weights, &adjlist, &vd));
+
+    /* With fewer than three vertices in all shortest paths, no vertex
+     * lies between two others, and all scores are exactly zero. */
+    if (vd < 3) {
+        log_term = 0;
+        needed = 0;
+    } else {
+        log_term = floor(log2(vd - 2)) + 1 + log(1 / delta);
+        needed = ceil(0.5 / (epsilon * epsilon) * log_term);
+    }
+
+    if (vd < 3 || needed >= no_of_nodes) {
+        if (weights) {
+            igraph_inclist_destroy(&inclist);
+        } else {
+            igraph_adjlist_destroy(&adjlist);
+        }
+        IGRAPH_FINALLY_CLEAN(1);
+
+        IGRAPH_CHECK(igraph_betweenness(graph, res, vids, directed, weights));
+        if (error_bound) {
+            *error_bound = 0;
+        }
+        if (samples) {
+            *samples = 0;
+        }
+        return IGRAPH_SUCCESS;
+    }
+
+    no_of_samples = needed;
+
+    IGRAPH_CHECK(igraph_adjlist_init_empty(&parents, no_of_nodes));
+    IGRAPH_FINALLY(igraph_adjlist_destroy, &parents);
+
+    IGRAPH_CHECK(igraph_stack_int_init(&S, no_of_nodes));
+    IGRAPH_FINALLY(igraph_stack_int_destroy, &S);
+
+    IGRAPH_CHECK(igraph_workspace_init(&ws));
+    IGRAPH_FINALLY(igraph_workspace_destroy, &ws);
+
+    IGRAPH_VECTOR_INIT_FINALLY(&dist, no_of_nodes);
+
+    nrgeo = IGRAPH_CALLOC(no_of_nodes, igraph_real_t);
+    IGRAPH_CHECK_OOM(nrgeo, "Insufficient memory for betweenness calculation.");
+    IGRAPH_FINALLY(igraph_free, nrgeo);
+
+    if (igraph_vs_is_all(&vids)) {
+        IGRAPH_CHECK(igraph_vector_resize(res, no_of_nodes));
+        igraph_vector_null(res);
+        tmpres = res;
+    } else {
+        IGRAPH_VECTOR_INIT_FINALLY(tmpres, no_of_nodes);
+    }
+
+    RNG_BEGIN();
+
+    for (i = 0; i < no_of_samples; i++) {
+        igraph_integer_t source, target;
+
+        IGRAPH_PROGRESS("Approximate betweenness centrality: ", 100.0 * i / no_of_samples, 0);
+        IGRAPH_ALLOW_INTERRUPTION();
+
+        source = RNG_INTEGER(0, no_of_nodes - 1);
+        target = RNG_INTEGER(0, no_of_nodes - 2);
+        if (target >= source) {
+            target++;
+        }
+
+        if (weights) {
+            IGRAPH_CHECK(igraph_i_sspf_weighted(graph, source, &dist, nrgeo, weights, &S, &parents, &inclist, -1, &ws));
+        } else {
+            IGRAPH_CHECK(igraph_i_sspf(source, &dist, nrgeo, &S, &parents, &adjlist, -1, &ws));
+        }
+
+        /* Walk back from the target along a uniformly chosen shortest path.
+         * The number of shortest paths to a vertex is the sum of those to
+         * its parents, each parent appearing once per connecting edge. */
+        if (VECTOR(dist)[target] > 0) {
+            igraph_integer_t actnode = target;
+            while (actnode != source) {
+                const igraph_vector_int_t *neis = igraph_adjlist_get(&parents, actnode);
+                igraph_integer_t nneis = igraph_vector_int_size(neis);
+                igraph_real_t x = RNG_UNIF(0, nrgeo[actnode]);
+                igraph_integer_t parent = VECTOR(*neis)[nneis - 1];
+
+                for (j = 0; j < nneis - 1; j++) {
+                    x -= nrgeo[VECTOR(*neis)[j]];
+                    if (x < 0) {
+                        parent = VECTOR(*neis)[j];
+                        break;
+                    }
+                }
+
+                if (parent != source) {
+                    VECTOR(*tmpres)[parent] += 1;
+                }
+                actnode = parent;
+            }
+        }
+
+        while (!igraph_stack_int_empty(&S)) {
+            igraph_integer_t actnode = igraph_stack_int_pop(&S);
+            VECTOR(dist)[actnode] = 0;
+            nrgeo[actnode] = 0;
+            igraph_vector_int_clear(igraph_adjlist_get(&parents, actnode));
+        }
+    }
+
+    RNG_END();
+
+    /* Scale the sample counts to the number of vertex pairs. */
+    if (undirected) {
+        no_of_pairs /= 2;
+    }
+    igraph_vector_scale(tmpres, no_of_pairs / no_of_samples);
+
+    if (!igraph_vs_is_all(&vids)) {
+        IGRAPH_CHECK(igraph_vit_create(graph, vids, &vit));
+        IGRAPH_FINALLY(igraph_vit_destroy, &vit);
+        IGRAPH_CHECK(igraph_vector_resize(res, IGRAPH_VIT_SIZE(vit)));
+
+        for (j = 0, IGRAPH_VIT_RESET(vit); !IGRAPH_VIT_END(vit);
+             IGRAPH_VIT_NEXT(vit), j++) {
+            igraph_integer_t node = IGRAPH_VIT_GET(vit);
+            VECTOR(*res)[j] = VECTOR(*tmpres)[node];
+        }
+
+        igraph_vit_destroy(&vit);
+        igraph_vector_destroy(tmpres);
+        IGRAPH_FINALLY_CLEAN(2);
+    }
+
+    if (error_bound) {
+        *error_bound = sqrt(0.5 * log_term / no_of_samples) * no_of_pairs;
+    }
+    if (samples) {
+        *samples = no_of_samples;
+    }
+
+    IGRAPH_PROGRESS("Approximate betweenness centrality: ", 100.0, 0);
+
+    IGRAPH_FREE(nrgeo);
+    igraph_vector_destroy(&dist);
+    igraph_workspace_destroy(&ws);
+    igraph_stack_int_destroy(&S);
+    igraph_adjlist_destroy(&parents);
+    if (weights) {
+        igraph_inclist_destroy(&inclist);
+    } else {
+        igraph_adjlist_destroy(&adjlist);
+    }
+    IGRAPH_FINALLY_CLEAN(6);
 
     return IGRAPH_SUCCESS;
 }
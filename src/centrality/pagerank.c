@@ -21,11 +21,15 @@
 #include "igraph_centrality.h"
 
 #include "igraph_adjlist.h"
+#include "igraph_bitset.h"
+#include "igraph_dqueue.h"
 #include "igraph_interface.h"
 #include "igraph_random.h"
 #include "igraph_structural.h"
 
 #include "centrality/prpack_internal.h"
+#include "core/interruption.h"
+#include "math/safe_intop.h"
 
 #include <limits.h>
 
@@ -36,6 +40,13 @@ static igraph_error_t igraph_i_personalized_pagerank_arpack(const igraph_t *grap
                                                  const igraph_vector_t *reset,
                                                  const igraph_vector_t *weights,
                                                  igraph_arpack_options_t *options);
+static igraph_error_t igraph_i_personalized_pagerank_power(const igraph_t *graph,
+                                                 igraph_vector_t *vector,
+                                                 igraph_real_t *value, const igraph_vs_t vids,
+                                                 igraph_bool_t directed, igraph_real_t damping,
+                                                 const igraph_vector_t *reset,
+                                                 const igraph_vector_t *weights,
+                                                 igraph_arpack_options_t *options);
 
 typedef struct {
     const igraph_t *graph;
@@ -218,7 +229,10 @@ static igraph_error_t pagerank_operator_weighted(igraph_real_t *to, const igraph
  * implementation is \c IGRAPH_PAGERANK_ALGO_PRPACK. This is using the
  * PRPACK package, see https://github.com/dgleich/prpack. PRPACK uses an
  * algebraic method, i.e. solves a linear system to obtain the PageRank
- * scores.
+ * scores. The third implementation, \c IGRAPH_PAGERANK_ALGO_POWER_PARALLEL,
+ * uses power iteration, and runs in parallel when igraph is compiled with
+ * OpenMP support. Its memory use is linear in the size of the graph, with
+ * small constants, and its results do not depend on the number of threads.
  *
  * </para><para>
  * Note that the PageRank of a given vertex depends on the PageRank
@@ -238,14 +252,16 @@ static igraph_error_t pagerank_operator_weighted(igraph_real_t *to, const igraph
  *
  * \param graph The graph object.
  * \param algo The PageRank implementation to use. Possible values:
- *    \c IGRAPH_PAGERANK_ALGO_ARPACK, \c IGRAPH_PAGERANK_ALGO_PRPACK.
+ *    \c IGRAPH_PAGERANK_ALGO_ARPACK, \c IGRAPH_PAGERANK_ALGO_PRPACK,
+ *    \c IGRAPH_PAGERANK_ALGO_POWER_PARALLEL.
  * \param vector Pointer to an initialized vector, the result is
  *    stored here. It is resized as needed.
  * \param value Pointer to a real variable. When using \c IGRAPH_PAGERANK_ALGO_ARPACK,
  *    the eigenvalue corresponding to the PageRank vector is stored here. It is
  *    expected to be exactly one. Checking this value can be used to diagnose cases
  *    when ARPACK failed to converge to the leading eigenvector.
- *    When using \c IGRAPH_PAGERANK_ALGO_PRPACK, this is always set to 1.0.
+ *    When using \c IGRAPH_PAGERANK_ALGO_PRPACK or
+ *    \c IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, this is always set to 1.0.
  * \param vids The vertex IDs for which the PageRank is returned. This parameter
  *    is only for convenience. Computing PageRank for fewer than all vertices will
  *    not speed up the calculation.
@@ -261,7 +277,16 @@ static igraph_error_t pagerank_operator_weighted(igraph_real_t *to, const igraph
  *    overwrites the <code>n</code> (number of vertices), <code>nev</code> (1),
  *    <code>ncv</code> (3) and <code>which</code> (LM) parameters and it always
  *    starts the calculation from a non-random vector calculated based on the
- *    degree of the vertices.
+ *    degree of the vertices. \c IGRAPH_PAGERANK_ALGO_POWER_PARALLEL uses only
+ *    the \c tol and \c mxiter fields, as the threshold for the L1 norm of the
+ *    change of the scores in one iteration (zero means 1e-10) and as the
+ *    maximum number of iterations. It sets \c noiter and \c numop to the
+ *    number of iterations taken, and \c nconv and \c info to 1 and 0 if the
+ *    iteration converged, or 0 and 1 if it did not. If \c start is 1, the
+ *    iteration starts from the scores in \p vector, which must then not be
+ *    \c NULL and contain a score for each vertex. This speeds up the
+ *    calculation when \p vector holds the result of an earlier calculation
+ *    on a similar graph.
  * \return Error code:
  *         \c IGRAPH_ENOMEM, not enough memory for temporary data.
  *         \c IGRAPH_EINVVID, invalid vertex ID in \p vids.
@@ -314,14 +339,16 @@ igraph_error_t igraph_pagerank(const igraph_t *graph, igraph_pagerank_algo_t alg
  *
  * \param graph The graph object.
  * \param algo The PageRank implementation to use. Possible values:
- *    \c IGRAPH_PAGERANK_ALGO_ARPACK, \c IGRAPH_PAGERANK_ALGO_PRPACK.
+ *    \c IGRAPH_PAGERANK_ALGO_ARPACK, \c IGRAPH_PAGERANK_ALGO_PRPACK,
+ *    \c IGRAPH_PAGERANK_ALGO_POWER_PARALLEL.
  * \param vector Pointer to an initialized vector, the result is
  *    stored here. It is resized as needed.
  * \param value Pointer to a real variable. When using \c IGRAPH_PAGERANK_ALGO_ARPACK,
  *    the eigenvalue corresponding to the PageRank vector is stored here. It is
  *    expected to be exactly one. Checking this value can be used to diagnose cases
  *    when ARPACK failed to converge to the leading eigenvector.
- *    When using \c IGRAPH_PAGERANK_ALGO_PRPACK, this is always set to 1.0.
+ *    When using \c IGRAPH_PAGERANK_ALGO_PRPACK or
+ *    \c IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, this is always set to 1.0.
  * \param vids The vertex IDs for which the PageRank is returned. This parameter
  *    is only for convenience. Computing PageRank for fewer than all vertices will
  *    not speed up the calculation.
@@ -340,7 +367,16 @@ igraph_error_t igraph_pagerank(const igraph_t *graph, igraph_pagerank_algo_t alg
  *    overwrites the <code>n</code> (number of vertices), <code>nev</code> (1),
  *    <code>ncv</code> (3) and <code>which</code> (LM) parameters and it always
  *    starts the calculation from a non-random vector calculated based on the
- *    degree of the vertices.
+ *    degree of the vertices. \c IGRAPH_PAGERANK_ALGO_POWER_PARALLEL uses only
+ *    the \c tol and \c mxiter fields, as the threshold for the L1 norm of the
+ *    change of the scores in one iteration (zero means 1e-10) and as the
+ *    maximum number of iterations. It sets \c noiter and \c numop to the
+ *    number of iterations taken, and \c nconv and \c info to 1 and 0 if the
+ *    iteration converged, or 0 and 1 if it did not. If \c start is 1, the
+ *    iteration starts from the scores in \p vector, which must then not be
+ *    \c NULL and contain a score for each vertex. This speeds up the
+ *    calculation when \p vector holds the result of an earlier calculation
+ *    on a similar graph.
  * \return Error code:
  *         \c IGRAPH_ENOMEM, not enough memory for
  *         temporary data.
@@ -409,14 +445,16 @@ igraph_error_t igraph_personalized_pagerank_vs(const igraph_t *graph,
  *
  * \param graph The graph object.
  * \param algo The PageRank implementation to use. Possible values:
- *    \c IGRAPH_PAGERANK_ALGO_ARPACK, \c IGRAPH_PAGERANK_ALGO_PRPACK.
+ *    \c IGRAPH_PAGERANK_ALGO_ARPACK, \c IGRAPH_PAGERANK_ALGO_PRPACK,
+ *    \c IGRAPH_PAGERANK_ALGO_POWER_PARALLEL.
  * \param vector Pointer to an initialized vector, the result is
  *    stored here. It is resized as needed.
  * \param value Pointer to a real variable. When using \c IGRAPH_PAGERANK_ALGO_ARPACK,
  *    the eigenvalue corresponding to the PageRank vector is stored here. It is
  *    expected to be exactly one. Checking this value can be used to diagnose cases
  *    when ARPACK failed to converge to the leading eigenvector.
- *    When using \c IGRAPH_PAGERANK_ALGO_PRPACK, this is always set to 1.0.
+ *    When using \c IGRAPH_PAGERANK_ALGO_PRPACK or
+ *    \c IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, this is always set to 1.0.
  * \param vids The vertex IDs for which the PageRank is returned. This parameter
  *    is only for convenience. Computing PageRank for fewer than all vertices will
  *    not speed up the calculation.
@@ -436,7 +474,16 @@ igraph_error_t igraph_personalized_pagerank_vs(const igraph_t *graph,
  *    overwrites the <code>n</code> (number of vertices), <code>nev</code> (1),
  *    <code>ncv</code> (3) and <code>which</code> (LM) parameters and it always
  *    starts the calculation from a non-random vector calculated based on the
- *    degree of the vertices.
+ *    degree of the vertices. \c IGRAPH_PAGERANK_ALGO_POWER_PARALLEL uses only
+ *    the \c tol and \c mxiter fields, as the threshold for the L1 norm of the
+ *    change of the scores in one iteration (zero means 1e-10) and as the
+ *    maximum number of iterations. It sets \c noiter and \c numop to the
+ *    number of iterations taken, and \c nconv and \c info to 1 and 0 if the
+ *    iteration converged, or 0 and 1 if it did not. If \c start is 1, the
+ *    iteration starts from the scores in \p vector, which must then not be
+ *    \c NULL and contain a score for each vertex. This speeds up the
+ *    calculation when \p vector holds the result of an earlier calculation
+ *    on a similar graph.
  * \return Error code:
  *         \c IGRAPH_ENOMEM, not enough memory for
  *         temporary data.
@@ -463,14 +510,26 @@ igraph_error_t igraph_personalized_pagerank(const igraph_t *graph,
     }
 
     if (algo == IGRAPH_PAGERANK_ALGO_ARPACK) {
-        return igraph_i_personalized_pagerank_arpack(graph, vector, value, vids,
+        igraph_arpack_options_t *arpack_options = options ? options : igraph_arpack_options_get_default();
+        int start = arpack_options->start;
+        igraph_error_t err = igraph_i_personalized_pagerank_arpack(graph, vector, value, vids,
                 directed, damping, reset,
-                weights, options ? options : igraph_arpack_options_get_default()
+                weights, arpack_options
         );
+        /* The ARPACK implementation sets 'start' to pass its own starting
+         * vector to the solver. Restore it, since for the power iteration it
+         * selects a warm start from the scores in 'vector'. */
+        arpack_options->start = start;
+        return err;
     } else if (algo == IGRAPH_PAGERANK_ALGO_PRPACK) {
         return igraph_i_personalized_pagerank_prpack(graph, vector, value, vids,
                 directed, damping, reset,
                 weights);
+    } else if (algo == IGRAPH_PAGERANK_ALGO_POWER_PARALLEL) {
+        return igraph_i_personalized_pagerank_power(graph, vector, value, vids,
+                directed, damping, reset,
+                weights, options ? options : igraph_arpack_options_get_default()
+        );
     }
 
     IGRAPH_ERROR("Unknown PageRank algorithm", IGRAPH_EINVAL);
@@ -717,3 +776,755 @@ static igraph_error_t igraph_i_personalized_pagerank_arpack(const igraph_t *grap
 
     return IGRAPH_SUCCESS;
 }
+
+/* Rows of the transition matrix are processed in blocks with about this many
+ * entries (edges plus vertices) by the power iteration. */
+#define IGRAPH_I_PAGERANK_BLOCK_SIZE 32768
+
+/* Convergence threshold for the L1 change of the power iteration, used when
+ * no tolerance is given. */
+#define IGRAPH_I_PAGERANK_POWER_TOL 1e-10
+
+/* Checks the reset vector and weights passed to the power iteration and the
+ * incremental update, and returns the sum of the reset vector in reset_sum. */
+static igraph_error_t igraph_i_pagerank_check_input(const igraph_t *graph,
+                                                    const igraph_vector_t *reset,
+                                                    const igraph_vector_t *weights,
+                                                    igraph_real_t *reset_sum) {
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t no_of_edges = igraph_ecount(graph);
+
+    if (weights && igraph_vector_size(weights) != no_of_edges) {
+        IGRAPH_ERROR("Invalid length of weights vector when calculating PageRank scores.", IGRAPH_EINVAL);
+    }
+
+    if (reset && igraph_vector_size(reset) != no_of_nodes) {
+        IGRAPH_ERROR("Invalid length of reset vector when calculating personalized PageRank scores.", IGRAPH_EINVAL);
+    }
+
+    if (reset) {
+        *reset_sum = igraph_vector_sum(reset);
+        if (no_of_nodes > 0 && *reset_sum == 0) {
+            IGRAPH_ERROR("The sum of the elements in the reset vector must not be zero.", IGRAPH_EINVAL);
+        }
+        if (no_of_nodes > 0 && igraph_vector_min(reset) < 0) {
+            IGRAPH_ERROR("The reset vector must not contain negative elements.", IGRAPH_EINVAL);
+        }
+        if (!isfinite(*reset_sum)) {
+            IGRAPH_ERROR("The reset vector must not contain infinite or NaN values.", IGRAPH_EINVAL);
+        }
+    }
+
+    if (weights && no_of_edges > 0) {
+        igraph_real_t min = igraph_vector_min(weights);
+        if (min < 0) {
+            IGRAPH_ERROR("Edge weights must not be negative.", IGRAPH_EINVAL);
+        }
+        if (isnan(min)) {
+            IGRAPH_ERROR("Weight vector must not contain NaN values.", IGRAPH_EINVAL);
+        }
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/* The transition matrix used by the power iteration, transposed and in
+ * compressed sparse row form, i.e. the in-neighbors of each vertex, and its
+ * split into blocks of rows with similar work. */
+typedef struct {
+    igraph_csr_t csr;
+    igraph_vector_t weights;    /* edge weights in the order of csr.neis, or empty */
+    igraph_vector_t invdeg;     /* inverse out-strengths, zero for dangling vertices */
+    igraph_vector_int_t blocks; /* block i contains rows blocks[i] to blocks[i + 1] - 1 */
+} igraph_i_pagerank_matrix_t;
+
+static void igraph_i_pagerank_matrix_destroy(igraph_i_pagerank_matrix_t *matrix) {
+    igraph_vector_int_destroy(&matrix->blocks);
+    igraph_vector_destroy(&matrix->invdeg);
+    igraph_vector_destroy(&matrix->weights);
+    igraph_csr_destroy(&matrix->csr);
+}
+
+/* Weights must have been checked with igraph_i_pagerank_check_input(). */
+static igraph_error_t igraph_i_pagerank_matrix_init(igraph_i_pagerank_matrix_t *matrix,
+                                                    const igraph_t *graph, igraph_bool_t directed,
+                                                    const igraph_vector_t *weights) {
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t work = 0;
+
+    directed = directed && igraph_is_directed(graph);
+
+    IGRAPH_CHECK(igraph_csr_init(graph, &matrix->csr, directed ? IGRAPH_IN : IGRAPH_ALL,
+                                 IGRAPH_LOOPS_TWICE, IGRAPH_MULTIPLE, weights != NULL));
+    IGRAPH_FINALLY(igraph_csr_destroy, &matrix->csr);
+
+    /* Edge weights are stored in the order of the neighbors, so that the
+     * product reads them sequentially. */
+    IGRAPH_VECTOR_INIT_FINALLY(&matrix->weights, weights ? igraph_vector_int_size(&matrix->csr.neis) : 0);
+    if (weights) {
+        igraph_integer_t size = igraph_vector_int_size(&matrix->csr.neis);
+        for (igraph_integer_t k = 0; k < size; k++) {
+            VECTOR(matrix->weights)[k] = VECTOR(*weights)[VECTOR(matrix->csr.eids)[k]];
+        }
+    }
+
+    IGRAPH_VECTOR_INIT_FINALLY(&matrix->invdeg, no_of_nodes);
+    IGRAPH_CHECK(igraph_strength(graph, &matrix->invdeg, igraph_vss_all(),
+                                 directed ? IGRAPH_OUT : IGRAPH_ALL, IGRAPH_LOOPS, weights));
+    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+        /* Vertices without outgoing edges, or with zero total weight, are
+         * dangling; the walker always teleports from these. */
+        VECTOR(matrix->invdeg)[i] = VECTOR(matrix->invdeg)[i] > 0 ? 1.0 / VECTOR(matrix->invdeg)[i] : 0.0;
+    }
+
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&matrix->blocks, 1);
+    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+        work += igraph_csr_degree(&matrix->csr, i) + 1;
+        if (work >= IGRAPH_I_PAGERANK_BLOCK_SIZE || i == no_of_nodes - 1) {
+            IGRAPH_CHECK(igraph_vector_int_push_back(&matrix->blocks, i + 1));
+            work = 0;
+        }
+    }
+
+    IGRAPH_FINALLY_CLEAN(4);
+    return IGRAPH_SUCCESS;
+}
+
+/*
+ * Power iteration based implementation of \c igraph_personalized_pagerank.
+ *
+ * Each iteration computes x' = damping * P^T x + s * reset, where P is the
+ * transition matrix and s is the probability of teleporting, including the
+ * probability of the walker being at a dangling vertex. The product is
+ * computed by pulling the scaled scores x[j] / outdegree(j) along the
+ * in-edges of each vertex, stored in compressed sparse row form. Vertices
+ * are split into blocks of similar work, which are processed in parallel
+ * when igraph is compiled with OpenMP. Sums are accumulated per block and
+ * added in block order, so results do not depend on the number of threads.
+ *
+ * See \c igraph_personalized_pagerank for the documentation of the parameters.
+ */
+static igraph_error_t igraph_i_personalized_pagerank_power(const igraph_t *graph, igraph_vector_t *vector,
+                                                 igraph_real_t *value, const igraph_vs_t vids,
+                                                 igraph_bool_t directed, igraph_real_t damping,
+                                                 const igraph_vector_t *reset,
+                                                 const igraph_vector_t *weights,
+                                                 igraph_arpack_options_t *options) {
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_real_t tol = options->tol > 0 ? options->tol : IGRAPH_I_PAGERANK_POWER_TOL;
+    igraph_real_t reset_sum = 0;
+    igraph_i_pagerank_matrix_t matrix;
+    igraph_vector_t scaled, x, xnew, normalized_reset, partial;
+    igraph_integer_t no_of_blocks, iter;
+    igraph_bool_t converged = false;
+
+    IGRAPH_CHECK(igraph_i_pagerank_check_input(graph, reset, weights, &reset_sum));
+
+    if (options->start) {
+        if (!vector) {
+            IGRAPH_ERROR("A starting vector is required when the start option is set.", IGRAPH_EINVAL);
+        }
+        if (igraph_vector_size(vector) != no_of_nodes) {
+            IGRAPH_ERROR("The starting vector must contain a score for each vertex.", IGRAPH_EINVAL);
+        }
+    }
+
+    IGRAPH_CHECK(igraph_i_pagerank_matrix_init(&matrix, graph, directed, weights));
+    IGRAPH_FINALLY(igraph_i_pagerank_matrix_destroy, &matrix);
+    no_of_blocks = igraph_vector_int_size(&matrix.blocks) - 1;
+
+    IGRAPH_VECTOR_INIT_FINALLY(&partial, no_of_blocks);
+    IGRAPH_VECTOR_INIT_FINALLY(&scaled, no_of_nodes);
+    IGRAPH_VECTOR_INIT_FINALLY(&xnew, no_of_nodes);
+
+    if (reset) {
+        IGRAPH_CHECK(igraph_vector_init_copy(&normalized_reset, reset));
+        IGRAPH_FINALLY(igraph_vector_destroy, &normalized_reset);
+        igraph_vector_scale(&normalized_reset, 1.0 / reset_sum);
+    }
+
+    if (options->start) {
+        igraph_real_t sum;
+        IGRAPH_CHECK(igraph_vector_init_copy(&x, vector));
+        IGRAPH_FINALLY(igraph_vector_destroy, &x);
+        sum = igraph_vector_sum(&x);
+        if (no_of_nodes > 0 && (!isfinite(sum) || sum <= 0 || igraph_vector_min(&x) < 0)) {
+            IGRAPH_ERROR("The starting vector must be non-negative, finite and not all zero.", IGRAPH_EINVAL);
+        }
+        igraph_vector_scale(&x, 1.0 / sum);
+    } else if (reset) {
+        IGRAPH_CHECK(igraph_vector_init_copy(&x, &normalized_reset));
+        IGRAPH_FINALLY(igraph_vector_destroy, &x);
+    } else {
+        IGRAPH_VECTOR_INIT_FINALLY(&x, no_of_nodes);
+        igraph_vector_fill(&x, 1.0 / no_of_nodes);
+    }
+
+    for (iter = 0; iter < options->mxiter && !converged; iter++) {
+        const igraph_real_t fact = 1 - damping;
+        const igraph_real_t *R = reset ? VECTOR(normalized_reset) : NULL;
+        igraph_real_t sumfrom = 0, change = 0;
+
+        /* Scale the scores by the inverse out-degrees, and compute the
+         * probability of teleporting. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (igraph_integer_t b = 0; b < no_of_blocks; b++) {
+            igraph_real_t sum = 0;
+            for (igraph_integer_t i = VECTOR(matrix.blocks)[b]; i < VECTOR(matrix.blocks)[b + 1]; i++) {
+                igraph_real_t p = VECTOR(x)[i];
+                VECTOR(scaled)[i] = p * VECTOR(matrix.invdeg)[i];
+                sum += VECTOR(matrix.invdeg)[i] != 0 ? p * fact : p;
+            }
+            VECTOR(partial)[b] = sum;
+        }
+        for (igraph_integer_t b = 0; b < no_of_blocks; b++) {
+            sumfrom += VECTOR(partial)[b];
+        }
+        if (!reset) {
+            sumfrom /= no_of_nodes;
+        }
+
+        /* Move along the edges, and add the teleportation. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (igraph_integer_t b = 0; b < no_of_blocks; b++) {
+            igraph_real_t diff = 0;
+            for (igraph_integer_t i = VECTOR(matrix.blocks)[b]; i < VECTOR(matrix.blocks)[b + 1]; i++) {
+                igraph_integer_t begin = VECTOR(matrix.csr.offsets)[i], end = VECTOR(matrix.csr.offsets)[i + 1];
+                igraph_real_t sum = 0, p;
+                if (weights) {
+                    for (igraph_integer_t k = begin; k < end; k++) {
+                        sum += VECTOR(matrix.weights)[k] * VECTOR(scaled)[VECTOR(matrix.csr.neis)[k]];
+                    }
+                } else {
+                    for (igraph_integer_t k = begin; k < end; k++) {
+                        sum += VECTOR(scaled)[VECTOR(matrix.csr.neis)[k]];
+                    }
+                }
+                p = damping * sum + (R ? sumfrom * R[i] : sumfrom);
+                diff += fabs(p - VECTOR(x)[i]);
+                VECTOR(xnew)[i] = p;
+            }
+            VECTOR(partial)[b] = diff;
+        }
+        for (igraph_integer_t b = 0; b < no_of_blocks; b++) {
+            change += VECTOR(partial)[b];
+        }
+
+        igraph_vector_swap(&x, &xnew);
+        converged = change < tol;
+
+        IGRAPH_ALLOW_INTERRUPTION();
+    }
+
+    options->noiter = (int) iter;
+    options->numop = (int) iter;
+    options->nconv = converged ? 1 : 0;
+    options->info = converged ? 0 : 1;
+    if (!converged) {
+        IGRAPH_WARNINGF("PageRank power iteration did not converge in %d iterations.", options->mxiter);
+    }
+
+    if (value) {
+        *value = 1.0;
+    }
+
+    if (vector) {
+        igraph_vit_t vit;
+        igraph_real_t sum = igraph_vector_sum(&x);
+
+        IGRAPH_CHECK(igraph_vit_create(graph, vids, &vit));
+        IGRAPH_FINALLY(igraph_vit_destroy, &vit);
+
+        IGRAPH_CHECK(igraph_vector_resize(vector, IGRAPH_VIT_SIZE(vit)));
+        for (igraph_integer_t i = 0; !IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit), i++) {
+            VECTOR(*vector)[i] = VECTOR(x)[IGRAPH_VIT_GET(vit)] / sum;
+        }
+
+        igraph_vit_destroy(&vit);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
+
+    igraph_vector_destroy(&x);
+    IGRAPH_FINALLY_CLEAN(1);
+    if (reset) {
+        igraph_vector_destroy(&normalized_reset);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
+    igraph_vector_destroy(&xnew);
+    igraph_vector_destroy(&scaled);
+    igraph_vector_destroy(&partial);
+    igraph_i_pagerank_matrix_destroy(&matrix);
+    IGRAPH_FINALLY_CLEAN(4);
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Reset distributions are processed by the batch power iteration in chunks
+ * of at most this many columns, which bounds its working memory. */
+#define IGRAPH_I_PAGERANK_BATCH_MAX_COLS 32
+
+/* Runs the power iteration of igraph_personalized_pagerank_batch() for the
+ * k columns of 'reset' starting at 'first_col', and stores the normalized
+ * scores in the same columns of 'res'. Reset distributions and scores are
+ * stored row by row, so that the values belonging to one vertex are next
+ * to each other. The columns of 'reset' must have been checked already. */
+static igraph_error_t igraph_i_personalized_pagerank_batch_chunk(
+        const igraph_i_pagerank_matrix_t *matrix, igraph_bool_t weighted,
+        igraph_real_t damping, const igraph_matrix_t *reset,
+        igraph_integer_t first_col, igraph_integer_t k,
+        igraph_real_t tol, igraph_integer_t mxiter, igraph_matrix_t *res,
+        igraph_integer_t *iterations, igraph_bool_t *converged) {
+    const igraph_integer_t no_of_nodes = igraph_matrix_nrow(reset);
+    const igraph_integer_t no_of_blocks = igraph_vector_int_size(&matrix->blocks) - 1;
+    igraph_vector_t R, x, xnew, scaled, partial, sumfrom, change;
+    igraph_integer_t size, iter;
+
+    *converged = false;
+
+    IGRAPH_SAFE_MULT(no_of_nodes, k, &size);
+    IGRAPH_VECTOR_INIT_FINALLY(&R, size);
+    for (igraph_integer_t c = 0; c < k; c++) {
+        igraph_vector_t column;
+        igraph_real_t sum;
+        igraph_vector_view(&column, &MATRIX(*reset, 0, first_col + c), no_of_nodes);
+        sum = igraph_vector_sum(&column);
+        for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+            VECTOR(R)[i * k + c] = VECTOR(column)[i] / sum;
+        }
+    }
+
+    IGRAPH_VECTOR_INIT_FINALLY(&partial, no_of_blocks * k);
+    IGRAPH_VECTOR_INIT_FINALLY(&sumfrom, k);
+    IGRAPH_VECTOR_INIT_FINALLY(&change, k);
+    IGRAPH_VECTOR_INIT_FINALLY(&scaled, size);
+    IGRAPH_VECTOR_INIT_FINALLY(&xnew, size);
+    IGRAPH_CHECK(igraph_vector_init_copy(&x, &R));
+    IGRAPH_FINALLY(igraph_vector_destroy, &x);
+
+    for (iter = 0; iter < mxiter && !*converged; iter++) {
+        const igraph_real_t fact = 1 - damping;
+
+        /* Scale the scores by the inverse out-degrees, and compute the
+         * probability of teleporting for each column. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (igraph_integer_t b = 0; b < no_of_blocks; b++) {
+            igraph_real_t *sum = VECTOR(partial) + b * k;
+            for (igraph_integer_t c = 0; c < k; c++) {
+                sum[c] = 0;
+            }
+            for (igraph_integer_t i = VECTOR(matrix->blocks)[b]; i < VECTOR(matrix->blocks)[b + 1]; i++) {
+                igraph_real_t d = VECTOR(matrix->invdeg)[i], f = d != 0 ? fact : 1;
+                for (igraph_integer_t c = 0; c < k; c++) {
+                    igraph_real_t p = VECTOR(x)[i * k + c];
+                    VECTOR(scaled)[i * k + c] = p * d;
+                    sum[c] += p * f;
+                }
+            }
+        }
+        igraph_vector_null(&sumfrom);
+        for (igraph_integer_t b = 0; b < no_of_blocks; b++) {
+            for (igraph_integer_t c = 0; c < k; c++) {
+                VECTOR(sumfrom)[c] += VECTOR(partial)[b * k + c];
+            }
+        }
+
+        /* Move along the edges, and add the teleportation. */
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 1)
+#endif
+        for (igraph_integer_t b = 0; b < no_of_blocks; b++) {
+            igraph_real_t *diff = VECTOR(partial) + b * k;
+            for (igraph_integer_t c = 0; c < k; c++) {
+                diff[c] = 0;
+            }
+            for (igraph_integer_t i = VECTOR(matrix->blocks)[b]; i < VECTOR(matrix->blocks)[b + 1]; i++) {
+                igraph_integer_t begin = VECTOR(matrix->csr.offsets)[i], end = VECTOR(matrix->csr.offsets)[i + 1];
+                igraph_real_t *p = VECTOR(xnew) + i * k;
+                for (igraph_integer_t c = 0; c < k; c++) {
+                    p[c] = 0;
+                }
+                for (igraph_integer_t e = begin; e < end; e++) {
+                    const igraph_real_t *from = VECTOR(scaled) + VECTOR(matrix->csr.neis)[e] * k;
+                    igraph_real_t w = weighted ? VECTOR(matrix->weights)[e] : 1.0;
+                    for (igraph_integer_t c = 0; c < k; c++) {
+                        p[c] += w * from[c];
+                    }
+                }
+                for (igraph_integer_t c = 0; c < k; c++) {
+                    p[c] = damping * p[c] + VECTOR(sumfrom)[c] * VECTOR(R)[i * k + c];
+                    diff[c] += fabs(p[c] - VECTOR(x)[i * k + c]);
+                }
+            }
+        }
+        igraph_vector_null(&change);
+        for (igraph_integer_t b = 0; b < no_of_blocks; b++) {
+            for (igraph_integer_t c = 0; c < k; c++) {
+                VECTOR(change)[c] += VECTOR(partial)[b * k + c];
+            }
+        }
+
+        igraph_vector_swap(&x, &xnew);
+        *converged = igraph_vector_max(&change) < tol;
+
+        IGRAPH_ALLOW_INTERRUPTION();
+    }
+    *iterations = iter;
+
+    igraph_vector_null(&sumfrom);
+    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+        for (igraph_integer_t c = 0; c < k; c++) {
+            VECTOR(sumfrom)[c] += VECTOR(x)[i * k + c];
+        }
+    }
+    for (igraph_integer_t c = 0; c < k; c++) {
+        for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+            MATRIX(*res, i, first_col + c) = VECTOR(x)[i * k + c] / VECTOR(sumfrom)[c];
+        }
+    }
+
+    igraph_vector_destroy(&x);
+    igraph_vector_destroy(&xnew);
+    igraph_vector_destroy(&scaled);
+    igraph_vector_destroy(&change);
+    igraph_vector_destroy(&sumfrom);
+    igraph_vector_destroy(&partial);
+    igraph_vector_destroy(&R);
+    IGRAPH_FINALLY_CLEAN(7);
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_personalized_pagerank_batch
+ * \brief Calculates personalized PageRank for several reset distributions at once.
+ *
+ * \experimental
+ *
+ * This function computes the personalized PageRank vectors belonging to
+ * several reset distributions, given as the columns of a matrix, in a single
+ * run of power iteration. Each iteration multiplies the transition matrix
+ * with the block of all score vectors at once, so the graph is traversed
+ * only once per iteration for all distributions, and the scores that belong
+ * to the same vertex are read from contiguous memory. This is considerably
+ * faster than calling \ref igraph_personalized_pagerank() separately for
+ * each distribution, as the preprocessing of the graph is also done only
+ * once. The product runs in parallel when igraph is compiled with OpenMP
+ * support.
+ *
+ * </para><para>
+ * The distributions are processed in chunks of at most 32 columns. Besides
+ * the result matrix of n rows and k columns, where n is the number of
+ * vertices and k is the number of distributions, the iteration uses four
+ * matrices of n rows and at most 32 columns. The memory use is therefore
+ * O(n k) for the result, and O(n min(k, 32)) for the calculation. For many
+ * distributions on a large graph, consider calling this function for
+ * subsets of the columns of \p reset.
+ *
+ * </para><para>
+ * The scores are the same as those calculated by
+ * \ref igraph_personalized_pagerank(), see there for details.
+ *
+ * \param graph The graph object.
+ * \param res Pointer to an initialized matrix, the result is stored here.
+ *    It will have one row for each vertex and one column for each reset
+ *    distribution; the columns sum to one.
+ * \param directed Boolean, whether to consider the directedness of
+ *    the edges. This is ignored for undirected graphs.
+ * \param damping The damping factor. Must be in the range [0, 1].
+ * \param reset A matrix with one row for each vertex. Each column is a
+ *    reset distribution, i.e. a non-negative vector that is not all zero.
+ *    Columns are normalized to sum to one.
+ * \param weights Optional edge weights. May be a \c NULL pointer,
+ *    meaning unweighted edges, or a vector of non-negative values
+ *    of the same length as the number of edges.
+ * \param options Options for the iteration, see the description of
+ *    \c IGRAPH_PAGERANK_ALGO_POWER_PARALLEL at \ref igraph_personalized_pagerank().
+ *    The iteration stops when the change of each column is below the
+ *    tolerance. The number of iterations is the largest one among the
+ *    chunks of columns. Supply \c NULL here to use the defaults.
+ * \return Error code:
+ *         \c IGRAPH_ENOMEM, not enough memory for temporary data.
+ *         \c IGRAPH_EINVAL, invalid reset matrix or weights.
+ *         \c IGRAPH_EOVERFLOW, the result is too large to be stored.
+ *
+ * Time complexity: O(k (|V| + |E|)) per iteration, where k is the number
+ * of reset distributions.
+ *
+ * \sa \ref igraph_personalized_pagerank() for a single reset distribution.
+ */
+igraph_error_t igraph_personalized_pagerank_batch(const igraph_t *graph, igraph_matrix_t *res,
+                                                  igraph_bool_t directed, igraph_real_t damping,
+                                                  const igraph_matrix_t *reset,
+                                                  const igraph_vector_t *weights,
+                                                  igraph_arpack_options_t *options) {
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t no_of_cols = igraph_matrix_ncol(reset);
+    igraph_real_t tol, dummy;
+    igraph_i_pagerank_matrix_t matrix;
+    igraph_integer_t iterations = 0;
+    igraph_bool_t converged = true;
+
+    if (!options) {
+        options = igraph_arpack_options_get_default();
+    }
+    tol = options->tol > 0 ? options->tol : IGRAPH_I_PAGERANK_POWER_TOL;
+
+    if (damping < 0.0 || damping > 1.0) {
+        IGRAPH_ERROR("The PageRank damping factor must be in the range [0,1].", IGRAPH_EINVAL);
+    }
+
+    if (igraph_matrix_nrow(reset) != no_of_nodes) {
+        IGRAPH_ERRORF("The reset matrix must have one row for each vertex, "
+                      "found %" IGRAPH_PRId " rows for %" IGRAPH_PRId " vertices.", IGRAPH_EINVAL,
+                      igraph_matrix_nrow(reset), no_of_nodes);
+    }
+
+    IGRAPH_CHECK(igraph_i_pagerank_check_input(graph, NULL, weights, &dummy));
+    for (igraph_integer_t c = 0; c < no_of_cols; c++) {
+        igraph_vector_t column;
+        igraph_vector_view(&column, &MATRIX(*reset, 0, c), no_of_nodes);
+        IGRAPH_CHECK(igraph_i_pagerank_check_input(graph, &column, NULL, &dummy));
+    }
+
+    IGRAPH_CHECK(igraph_matrix_resize(res, no_of_nodes, no_of_cols));
+
+    IGRAPH_CHECK(igraph_i_pagerank_matrix_init(&matrix, graph, directed, weights));
+    IGRAPH_FINALLY(igraph_i_pagerank_matrix_destroy, &matrix);
+
+    for (igraph_integer_t first = 0; first < no_of_cols; first += IGRAPH_I_PAGERANK_BATCH_MAX_COLS) {
+        igraph_integer_t k = no_of_cols - first < IGRAPH_I_PAGERANK_BATCH_MAX_COLS ?
+                             no_of_cols - first : IGRAPH_I_PAGERANK_BATCH_MAX_COLS;
+        igraph_integer_t chunk_iterations;
+        igraph_bool_t chunk_converged;
+
+        IGRAPH_CHECK(igraph_i_personalized_pagerank_batch_chunk(
+                         &matrix, weights != NULL, damping, reset, first, k,
+                         tol, options->mxiter, res, &chunk_iterations, &chunk_converged));
+        if (chunk_iterations > iterations) {
+            iterations = chunk_iterations;
+        }
+        converged = converged && chunk_converged;
+    }
+
+    igraph_i_pagerank_matrix_destroy(&matrix);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    options->noiter = (int) iterations;
+    options->numop = (int) iterations;
+    options->nconv = converged ? 1 : 0;
+    options->info = converged ? 0 : 1;
+    if (!converged) {
+        IGRAPH_WARNINGF("PageRank power iteration did not converge in %d iterations.", options->mxiter);
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_personalized_pagerank_update
+ * \brief Updates personalized PageRank scores after the graph has changed.
+ *
+ * \experimental
+ *
+ * When a graph changes only slightly, e.g. by inserting or deleting a small
+ * fraction of its edges, its PageRank scores also change only slightly,
+ * and mostly in the neighborhood of the modified edges. This function takes
+ * the scores calculated before the change, and corrects them for the
+ * current graph with a push-based method (Gauss-Southwell iteration),
+ * instead of recalculating them from scratch.
+ *
+ * </para><para>
+ * The function first computes the residual of the previous scores, i.e.
+ * the amount by which they fail to satisfy the PageRank equations of the
+ * current graph, with one pass over the edges. Then it repeatedly selects a
+ * vertex whose residual is larger than \p epsilon in absolute value, adds
+ * the residual to the score of the vertex, and distributes it among the
+ * residuals of its out-neighbors. The residual is only propagated from
+ * vertices where it exceeds the threshold, which are typically close to the
+ * changed edges. Computing the residuals costs about as much as one
+ * iteration of the power method, and for small changes, the pushes that
+ * follow take much less time than a full recalculation. Finally, the
+ * scores are normalized to sum to one.
+ *
+ * </para><para>
+ * The parameters \p directed, \p damping, \p reset and \p weights must be
+ * the same as in the calculation of the previous scores. The vertex set of
+ * the graph must not change. The scores may come from any of the PageRank
+ * implementations, or from an earlier call to this function.
+ *
+ * </para><para>
+ * Reference:
+ *
+ * </para><para>
+ * Reid Andersen, Fan Chung and Kevin Lang: Local graph partitioning using
+ * PageRank vectors. 47th Annual IEEE Symposium on Foundations of Computer
+ * Science (FOCS'06), 475-486 (2006).
+ * https://doi.org/10.1109/FOCS.2006.44
+ *
+ * \param graph The graph object, after the change.
+ * \param vector Pointer to a vector containing the PageRank scores of all
+ *    vertices before the change. It is updated in place.
+ * \param directed Boolean, whether to consider the directedness of
+ *    the edges. This is ignored for undirected graphs.
+ * \param damping The damping factor. It must be in the range [0, 1).
+ * \param reset The probability distribution over the vertices used when
+ *    resetting the random walk, or a \c NULL pointer for a uniform
+ *    distribution, see \ref igraph_personalized_pagerank().
+ * \param weights Optional edge weights, or a \c NULL pointer for unweighted
+ *    edges.
+ * \param epsilon The residual threshold. Residuals smaller than this in
+ *    absolute value are not propagated further. The L1 error of the result
+ *    is at most about <code>n * epsilon / (1 - damping)</code>, where
+ *    <code>n</code> is the number of vertices, but it is usually much
+ *    smaller. Must be positive.
+ * \return Error code:
+ *         \c IGRAPH_ENOMEM, not enough memory for temporary data.
+ *         \c IGRAPH_EINVAL, invalid parameters or score vector.
+ *
+ * Time complexity: O(|V| + |E|) for computing the residuals, plus the
+ * number of residual pushes times the average out-degree of the pushed
+ * vertices.
+ *
+ * \sa \ref igraph_personalized_pagerank() to calculate the scores from
+ * scratch.
+ */
+igraph_error_t igraph_personalized_pagerank_update(const igraph_t *graph, igraph_vector_t *vector,
+                                                   igraph_bool_t directed, igraph_real_t damping,
+                                                   const igraph_vector_t *reset,
+                                                   const igraph_vector_t *weights,
+                                                   igraph_real_t epsilon) {
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_real_t reset_sum = 0, sum, dangling = 0, teleport;
+    igraph_csr_t csr;
+    igraph_vector_t invdeg, residual;
+    igraph_dqueue_int_t queue;
+    igraph_bitset_t queued;
+    igraph_integer_t pushes = 0;
+
+    if (damping < 0.0 || damping >= 1.0) {
+        IGRAPH_ERROR("The PageRank damping factor must be in the range [0,1) for incremental updates.", IGRAPH_EINVAL);
+    }
+
+    if (!(epsilon > 0)) {
+        IGRAPH_ERRORF("The residual threshold must be positive, got %g.", IGRAPH_EINVAL, epsilon);
+    }
+
+    if (igraph_vector_size(vector) != no_of_nodes) {
+        IGRAPH_ERROR("The score vector must contain a score for each vertex.", IGRAPH_EINVAL);
+    }
+
+    IGRAPH_CHECK(igraph_i_pagerank_check_input(graph, reset, weights, &reset_sum));
+
+    if (no_of_nodes == 0) {
+        return IGRAPH_SUCCESS;
+    }
+
+    sum = igraph_vector_sum(vector);
+    if (!isfinite(sum) || sum <= 0 || igraph_vector_min(vector) < 0) {
+        IGRAPH_ERROR("The score vector must be non-negative, finite and not all zero.", IGRAPH_EINVAL);
+    }
+    igraph_vector_scale(vector, 1.0 / sum);
+
+    directed = directed && igraph_is_directed(graph);
+
+    IGRAPH_CHECK(igraph_csr_init(graph, &csr, directed ? IGRAPH_OUT : IGRAPH_ALL,
+                                 IGRAPH_LOOPS_TWICE, IGRAPH_MULTIPLE, weights != NULL));
+    IGRAPH_FINALLY(igraph_csr_destroy, &csr);
+
+    IGRAPH_VECTOR_INIT_FINALLY(&invdeg, no_of_nodes);
+    IGRAPH_CHECK(igraph_strength(graph, &invdeg, igraph_vss_all(),
+                                 directed ? IGRAPH_OUT : IGRAPH_ALL, IGRAPH_LOOPS, weights));
+    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+        if (VECTOR(invdeg)[i] > 0) {
+            VECTOR(invdeg)[i] = 1.0 / VECTOR(invdeg)[i];
+        } else {
+            VECTOR(invdeg)[i] = 0.0;
+            dangling += VECTOR(*vector)[i];
+        }
+    }
+
+    /* The scores x satisfy x = damping * P^T x + teleport * reset, where P is
+     * the transition matrix with zero rows for dangling vertices, and the
+     * teleportation probability includes the probability of being at a
+     * dangling vertex. The teleportation term is fixed here, using the
+     * previous scores. Since it is proportional to the reset vector, this
+     * only affects the scaling of the solution, which is removed by the
+     * final normalization. */
+    teleport = 1 - damping + damping * dangling;
+
+    IGRAPH_VECTOR_INIT_FINALLY(&residual, no_of_nodes);
+    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+        VECTOR(residual)[i] = teleport * (reset ? VECTOR(*reset)[i] / reset_sum : 1.0 / no_of_nodes)
+                              - VECTOR(*vector)[i];
+    }
+    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+        igraph_integer_t begin = VECTOR(csr.offsets)[i], end = VECTOR(csr.offsets)[i + 1];
+        igraph_real_t out = damping * VECTOR(*vector)[i] * VECTOR(invdeg)[i];
+        for (igraph_integer_t k = begin; k < end; k++) {
+            igraph_real_t w = weights ? VECTOR(*weights)[VECTOR(csr.eids)[k]] : 1.0;
+            VECTOR(residual)[VECTOR(csr.neis)[k]] += out * w;
+        }
+    }
+
+    IGRAPH_CHECK(igraph_dqueue_int_init(&queue, 100));
+    IGRAPH_FINALLY(igraph_dqueue_int_destroy, &queue);
+    IGRAPH_BITSET_INIT_FINALLY(&queued, no_of_nodes);
+
+    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+        if (fabs(VECTOR(residual)[i]) > epsilon) {
+            IGRAPH_CHECK(igraph_dqueue_int_push(&queue, i));
+            IGRAPH_BIT_SET(queued, i);
+        }
+    }
+
+    /* Each push decreases the L1 norm of the residual vector by at least
+     * (1 - damping) * epsilon, so this terminates. */
+    while (!igraph_dqueue_int_empty(&queue)) {
+        igraph_integer_t u = igraph_dqueue_int_pop(&queue);
+        igraph_integer_t begin = VECTOR(csr.offsets)[u], end = VECTOR(csr.offsets)[u + 1];
+        igraph_real_t r = VECTOR(residual)[u], out;
+
+        IGRAPH_BIT_CLEAR(queued, u);
+        if (fabs(r) <= epsilon) {
+            continue;
+        }
+
+        VECTOR(*vector)[u] += r;
+        VECTOR(residual)[u] = 0;
+
+        out = damping * r * VECTOR(invdeg)[u];
+        if (out != 0) {
+            for (igraph_integer_t k = begin; k < end; k++) {
+                igraph_integer_t v = VECTOR(csr.neis)[k];
+                igraph_real_t w = weights ? VECTOR(*weights)[VECTOR(csr.eids)[k]] : 1.0;
+                VECTOR(residual)[v] += out * w;
+                if (!IGRAPH_BIT_TEST(queued, v) && fabs(VECTOR(residual)[v]) > epsilon) {
+                    IGRAPH_CHECK(igraph_dqueue_int_push(&queue, v));
+                    IGRAPH_BIT_SET(queued, v);
+                }
+            }
+        }
+
+        if (++pushes % (1 << 16) == 0) {
+            IGRAPH_ALLOW_INTERRUPTION();
+        }
+    }
+
+    sum = igraph_vector_sum(vector);
+    igraph_vector_scale(vector, 1.0 / sum);
+
+    igraph_bitset_destroy(&queued);
+    igraph_dqueue_int_destroy(&queue);
+    igraph_vector_destroy(&residual);
+    igraph_vector_destroy(&invdeg);
+    igraph_csr_destroy(&csr);
+    IGRAPH_FINALLY_CLEAN(5);
+
+    return IGRAPH_SUCCESS;
+}
@@ -17,6 +17,7 @@
    along with this program.  If not, see <https://www.gnu.org/licenses/>.
 */
 
+#include "igraph_centrality.h"
 #include "igraph_error.h"
 
 #include "centrality/prpack_internal.h"
@@ -30,19 +31,12 @@ using namespace prpack;
 using namespace std;
 
 /*
- * PRPACK-based implementation of \c igraph_personalized_pagerank.
- *
- * See \c igraph_personalized_pagerank for the documentation of the parameters.
+ * Solves the PageRank problem with a PRPACK solver. The solver keeps the
+ * preprocessed graph between calls.
  */
-igraph_error_t igraph_i_personalized_pagerank_prpack(const igraph_t *graph, igraph_vector_t *vector,
-                                          igraph_real_t *value, const igraph_vs_t vids,
-                                          igraph_bool_t directed, igraph_real_t damping,
-                                          const igraph_vector_t *reset,
-                                          const igraph_vector_t *weights) {
-    IGRAPH_HANDLE_EXCEPTIONS_BEGIN;
-
-    igraph_integer_t i, no_of_nodes = igraph_vcount(graph);
-
+static igraph_error_t igraph_i_prpack_solve(prpack_solver &solver, igraph_integer_t no_of_nodes,
+                                            igraph_real_t damping, const igraph_vector_t *reset,
+                                            std::unique_ptr<const prpack_result> &res) {
     double *u = nullptr;
     std::unique_ptr<double[]> v;
 
@@ -68,7 +62,7 @@ igraph_error_t igraph_i_personalized_pagerank_prpack(const igraph_t *graph, igra
 
         // Construct the personalization vector
         v.reset(new double[no_of_nodes]);
-        for (i = 0; i < no_of_nodes; i++) {
+        for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
             v[i] = VECTOR(*reset)[i] / reset_sum;
         }
 
@@ -88,14 +82,7 @@ igraph_error_t igraph_i_personalized_pagerank_prpack(const igraph_t *graph, igra
                 damping);
     }
 
-    // Construct and run the solver
-    prpack_igraph_graph prpack_graph;
-    IGRAPH_CHECK(prpack_graph.convert_from_igraph(graph, weights, directed));
-    prpack_solver solver(&prpack_graph, false);
-    std::unique_ptr<const prpack_result> res( solver.solve(damping, 1e-10, u, v.get(), "") );
-
-    // Delete the personalization vector
-    v.reset();
+    res.reset( solver.solve(damping, 1e-10, u, v.get(), "") );
 
     // Check whether the solver converged
     // TODO: this is commented out because some of the solvers do not implement it yet
@@ -105,6 +92,30 @@ igraph_error_t igraph_i_personalized_pagerank_prpack(const igraph_t *graph, igra
     }
     */
 
+    return IGRAPH_SUCCESS;
+}
+
+/*
+ * PRPACK-based implementation of \c igraph_personalized_pagerank.
+ *
+ * See \c igraph_personalized_pagerank for the documentation of the parameters.
+ */
+igraph_error_t igraph_i_personalized_pagerank_prpack(const igraph_t *graph, igraph_vector_t *vector,
+                                          igraph_real_t *value, const igraph_vs_t vids,
+                                          igraph_bool_t directed, igraph_real_t damping,
+                                          const igraph_vector_t *reset,
+                                          const igraph_vector_t *weights) {
+    IGRAPH_HANDLE_EXCEPTIONS_BEGIN;
+
+    igraph_integer_t i, no_of_nodes = igraph_vcount(graph);
+
+    // Construct and run the solver
+    prpack_igraph_graph prpack_graph;
+    IGRAPH_CHECK(prpack_graph.convert_from_igraph(graph, weights, directed));
+    prpack_solver solver(&prpack_graph, false);
+    std::unique_ptr<const prpack_result> res;
+    IGRAPH_CHECK(igraph_i_prpack_solve(solver, no_of_nodes, damping, reset, res));
+
     // Fill the result vector
     {
         // Use of igraph "finally" stack is safe in this block
@@ -133,3 +144,123 @@ igraph_error_t igraph_i_personalized_pagerank_prpack(const igraph_t *graph, igra
 
     IGRAPH_HANDLE_EXCEPTIONS_END;
 }
+
+/**
+ * \function igraph_pagerank_plan_init
+ * \brief Preprocesses a graph for repeated PageRank calculations.
+ *
+ * \experimental
+ *
+ * The PRPACK implementation of PageRank converts the graph to its own
+ * format, and preprocesses it, e.g. by ordering the vertices according to
+ * the strongly connected components of the graph. This takes a considerable
+ * fraction of the time of a PageRank calculation. A PageRank plan holds
+ * the preprocessed graph, so that it can be reused when PageRank is
+ * calculated for the same graph and weights several times, with different
+ * damping factors or reset vectors, using \ref igraph_pagerank_plan_solve().
+ *
+ * </para><para>
+ * The plan does not refer to the graph or the weight vector after this
+ * call, these can be modified or destroyed independently of the plan.
+ *
+ * \param plan Pointer to an uninitialized plan object.
+ * \param graph The graph object.
+ * \param directed Boolean, whether to consider the directedness of
+ *    the edges. This is ignored for undirected graphs.
+ * \param weights Optional edge weights. May be a \c NULL pointer,
+ *    meaning unweighted edges, or a vector of non-negative values
+ *    of the same length as the number of edges.
+ * \return Error code:
+ *         \c IGRAPH_ENOMEM, not enough memory.
+ *         \c IGRAPH_EINVAL, invalid weights.
+ *
+ * Time complexity: O(|V| + |E|).
+ *
+ * \sa \ref igraph_personalized_pagerank() for calculating PageRank once.
+ */
+igraph_error_t igraph_pagerank_plan_init(igraph_pagerank_plan_t *plan, const igraph_t *graph,
+                                         igraph_bool_t directed, const igraph_vector_t *weights) {
+    IGRAPH_HANDLE_EXCEPTIONS_BEGIN;
+
+    std::unique_ptr<prpack_igraph_graph> prpack_graph(new prpack_igraph_graph);
+    IGRAPH_CHECK(prpack_graph->convert_from_igraph(graph, weights, directed));
+    std::unique_ptr<prpack_solver> solver(new prpack_solver(prpack_graph.get(), false));
+
+    plan->no_of_nodes = igraph_vcount(graph);
+    plan->graph = prpack_graph.release();
+    plan->solver = solver.release();
+
+    return IGRAPH_SUCCESS;
+
+    IGRAPH_HANDLE_EXCEPTIONS_END;
+}
+
+/**
+ * \function igraph_pagerank_plan_destroy
+ * \brief Destroys a PageRank plan.
+ *
+ * \experimental
+ *
+ * \param plan The plan to destroy.
+ *
+ * Time complexity: O(1), plus the time needed to release the memory.
+ */
+void igraph_pagerank_plan_destroy(igraph_pagerank_plan_t *plan) {
+    delete static_cast<prpack_solver *>(plan->solver);
+    delete static_cast<prpack_igraph_graph *>(plan->graph);
+    plan->solver = nullptr;
+    plan->graph = nullptr;
+}
+
+/**
+ * \function igraph_pagerank_plan_solve
+ * \brief Calculates PageRank using a preprocessed graph.
+ *
+ * \experimental
+ *
+ * Calculates the (personalized) PageRank scores of all vertices of the
+ * graph that the plan was created for, using the PRPACK implementation.
+ * The results are the same as those of \ref igraph_personalized_pagerank()
+ * with \c IGRAPH_PAGERANK_ALGO_PRPACK. The graph is preprocessed only in
+ * the first call, and the following calls reuse it.
+ *
+ * </para><para>
+ * Since this function updates the plan, it must not be called for the
+ * same plan from multiple threads at the same time.
+ *
+ * \param plan The plan, created with \ref igraph_pagerank_plan_init().
+ * \param vector Pointer to an initialized vector, the scores of the
+ *    vertices are stored here. It is resized as needed.
+ * \param damping The damping factor. Must be in the range [0, 1].
+ * \param reset The probability distribution over the vertices used when
+ *    resetting the random walk. It is either a \c NULL pointer, for
+ *    ordinary PageRank, or a vector with one non-negative element per
+ *    vertex, which is not all zero.
+ * \return Error code:
+ *         \c IGRAPH_ENOMEM, not enough memory.
+ *         \c IGRAPH_EINVAL, invalid damping factor or reset vector.
+ *
+ * Time complexity: depends on the input graph, usually it is O(|E|),
+ * the number of edges.
+ */
+igraph_error_t igraph_pagerank_plan_solve(igraph_pagerank_plan_t *plan, igraph_vector_t *vector,
+                                          igraph_real_t damping, const igraph_vector_t *reset) {
+    IGRAPH_HANDLE_EXCEPTIONS_BEGIN;
+
+    if (damping < 0.0 || damping > 1.0) {
+        IGRAPH_ERROR("The PageRank damping factor must be in the range [0,1].", IGRAPH_EINVAL);
+    }
+
+    std::unique_ptr<const prpack_result> res;
+    IGRAPH_CHECK(igraph_i_prpack_solve(*static_cast<prpack_solver *>(plan->solver),
+                                       plan->no_of_nodes, damping, reset, res));
+
+    IGRAPH_CHECK(igraph_vector_resize(vector, plan->no_of_nodes));
+    for (igraph_integer_t i = 0; i < plan->no_of_nodes; i++) {
+        VECTOR(*vector)[i] = res->x[i];
+    }
+
+    return IGRAPH_SUCCESS;
+
+    IGRAPH_HANDLE_EXCEPTIONS_END;
+}
@@ -29,9 +29,15 @@
 #include "igraph_interface.h"
 #include "igraph_memory.h"
 #include "igraph_progress.h"
+#include "igraph_threading.h"
 
+#include "cliques/maximal_cliques.h"
 #include "core/interruption.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #define CONCAT2x(a,b) a ## b
 #define CONCAT2(a,b) CONCAT2x(a,b)
 #define FUNCTION(name,sfx) CONCAT2(name,sfx)
@@ -72,6 +78,26 @@ static igraph_error_t igraph_i_maximal_cliques_up(
         igraph_vector_int_t *R,
         igraph_vector_int_t *H);
 
+/* Buffers for the search from one vertex of the degeneracy order. 'adjlist'
+ * holds the neighbors of the vertices in P and X within P and X only, and its
+ * entries are rebuilt for each vertex, so it can start out empty. */
+typedef struct {
+    igraph_vector_int_t PX, R, H, pos, nextv;
+    igraph_adjlist_t adjlist;
+} igraph_i_maximal_cliques_ws_t;
+
+static igraph_error_t igraph_i_maximal_cliques_ws_init(
+        igraph_i_maximal_cliques_ws_t *ws, igraph_integer_t no_of_nodes);
+
+static void igraph_i_maximal_cliques_ws_destroy(igraph_i_maximal_cliques_ws_t *ws);
+
+static igraph_error_t igraph_i_maximal_cliques_parallel(
+        const igraph_vector_int_t *order, const igraph_vector_int_t *rank,
+        const igraph_adjlist_t *fulladjlist,
+        igraph_integer_t min_size, igraph_integer_t max_size,
+        igraph_vector_int_list_t *res, igraph_integer_t *no, igraph_vector_t *hist,
+        igraph_clique_handler_t *cliquehandler_fn, void *arg);
+
 #define PRINT_PX do { \
         igraph_integer_t j; \
         printf("PX="); \
@@ -314,6 +340,40 @@ static igraph_error_t igraph_i_maximal_cliques_up(
     return IGRAPH_SUCCESS;
 }
 
+static igraph_error_t igraph_i_maximal_cliques_ws_init(
+        igraph_i_maximal_cliques_ws_t *ws, igraph_integer_t no_of_nodes) {
+
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ws->PX, 20);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ws->R, 20);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ws->H, 100);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ws->pos, no_of_nodes);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ws->nextv, 100);
+    IGRAPH_CHECK(igraph_adjlist_init_empty(&ws->adjlist, no_of_nodes));
+    IGRAPH_FINALLY_CLEAN(5);
+
+    return IGRAPH_SUCCESS;
+}
+
+static void igraph_i_maximal_cliques_ws_destroy(igraph_i_maximal_cliques_ws_t *ws) {
+    igraph_adjlist_destroy(&ws->adjlist);
+    igraph_vector_int_destroy(&ws->nextv);
+    igraph_vector_int_destroy(&ws->pos);
+    igraph_vector_int_destroy(&ws->H);
+    igraph_vector_int_destroy(&ws->R);
+    igraph_vector_int_destroy(&ws->PX);
+}
+
+/* The number of edges from which the public functions search in parallel,
+ * or -1 if they should not. */
+static igraph_integer_t igraph_i_maximal_cliques_parallel_min_edges(void) {
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+    if (omp_get_max_threads() > 1) {
+        return IGRAPH_I_MAXIMAL_CLIQUES_PARALLEL_MIN_EDGES;
+    }
+#endif
+    return -1;
+}
+
 /**
  * \function igraph_maximal_cliques
  * \brief Finds all maximal cliques in a graph.
@@ -331,6 +391,17 @@ static igraph_error_t igraph_i_maximal_cliques_up(
  * Eppstein, Löffler and Strash.
  *
  * </para><para>
+ * When igraph is compiled with OpenMP in thread-safe mode (see
+ * \ref IGRAPH_THREAD_SAFE), more than one thread is available, and the graph
+ * has at least 10000 edges, the searches from different vertices of
+ * the degeneracy order are run in parallel, each thread using its own
+ * buffers. The cliques are returned in the same order as with a single
+ * thread. The same applies to \ref igraph_maximal_cliques_count(),
+ * \ref igraph_maximal_cliques_hist() and \ref igraph_maximal_cliques_callback(),
+ * but not to \ref igraph_maximal_cliques_file() and
+ * \ref igraph_maximal_cliques_subset().
+ *
+ * </para><para>
  * Reference:
  *
  * </para><para>
@@ -365,7 +436,10 @@ static igraph_error_t igraph_i_maximal_cliques_up(
 igraph_error_t igraph_maximal_cliques(
     const igraph_t *graph, igraph_vector_int_list_t *res,
     igraph_integer_t min_size, igraph_integer_t max_size
-);
+) {
+    return igraph_i_maximal_cliques(graph, res, min_size, max_size,
+                                    igraph_i_maximal_cliques_parallel_min_edges());
+}
 
 #define IGRAPH_MC_ORIG
 #include "maximal_cliques_template.h"
@@ -397,7 +471,10 @@ igraph_error_t igraph_maximal_cliques(
 igraph_error_t igraph_maximal_cliques_count(const igraph_t *graph,
                                  igraph_integer_t *res,
                                  igraph_integer_t min_size,
-                                 igraph_integer_t max_size);
+                                 igraph_integer_t max_size) {
+    return igraph_i_maximal_cliques_count(graph, res, min_size, max_size,
+                                          igraph_i_maximal_cliques_parallel_min_edges());
+}
 
 #define IGRAPH_MC_COUNT
 #include "maximal_cliques_template.h"
@@ -487,6 +564,18 @@ igraph_error_t igraph_maximal_cliques_subset(
  * copy of the vector using \ref igraph_vector_int_init_copy() if they want to
  * hold on to it.
  *
+ * </para><para>
+ * When the search runs in parallel, see \ref igraph_maximal_cliques(), the
+ * callback is still only called from the calling thread, and in the same
+ * order as with a single thread, therefore it does not need to be
+ * thread-safe. The cliques are found in batches of vertices, and after the
+ * callback returns \c IGRAPH_STOP, the rest of the current batch is
+ * discarded. All cliques of a batch are kept in memory until they are passed
+ * to the callback. Batches start at 256 vertices per thread and are made
+ * smaller while they yield more than 100000 cliques, down to a single vertex
+ * per thread, so the extra memory use is bounded by the larger of this limit
+ * and the number of cliques found from any one vertex per thread.
+ *
  * \param graph The input graph. Edge directions are ignored.
  * \param cliquehandler_fn Callback function to be called for each clique.
  * See also \ref igraph_clique_handler_t.
@@ -506,7 +595,10 @@ igraph_error_t igraph_maximal_cliques_subset(
 
 igraph_error_t igraph_maximal_cliques_callback(const igraph_t *graph,
                                     igraph_clique_handler_t *cliquehandler_fn, void *arg,
-                                    igraph_integer_t min_size, igraph_integer_t max_size);
+                                    igraph_integer_t min_size, igraph_integer_t max_size) {
+    return igraph_i_maximal_cliques_callback(graph, cliquehandler_fn, arg, min_size, max_size,
+                                             igraph_i_maximal_cliques_parallel_min_edges());
+}
 
 #define IGRAPH_MC_CALLBACK
 #include "maximal_cliques_template.h"
@@ -541,8 +633,251 @@ igraph_error_t igraph_maximal_cliques_callback(const igraph_t *graph,
 igraph_error_t igraph_maximal_cliques_hist(const igraph_t *graph,
                                 igraph_vector_t *hist,
                                 igraph_integer_t min_size,
-                                igraph_integer_t max_size);
+                                igraph_integer_t max_size) {
+    return igraph_i_maximal_cliques_hist(graph, hist, min_size, max_size,
+                                         igraph_i_maximal_cliques_parallel_min_edges());
+}
 
 #define IGRAPH_MC_HIST
 #include "maximal_cliques_template.h"
 #undef IGRAPH_MC_HIST
+
+/* In the parallel search, the vertices of the degeneracy order are processed
+ * in blocks of this many vertices per thread. The cliques found in a block
+ * are kept until the whole block is done, and then reported in order. */
+#define IGRAPH_I_MAXIMAL_CLIQUES_BLOCK_SIZE 256
+
+/* When the cliques are passed to a callback, they would otherwise only be
+ * buffered to be discarded afterwards, so the block is halved while it yields
+ * more than this many cliques, and grown back while it yields less than half
+ * as many. */
+#define IGRAPH_I_MAXIMAL_CLIQUES_MAX_BUFFERED 100000
+
+/* Buffers and results of one thread of the parallel search. */
+typedef struct {
+    igraph_i_maximal_cliques_ws_t ws;
+    igraph_vector_int_list_t cliques;  /* found in the current block */
+    igraph_integer_t count;
+    igraph_vector_t hist;
+} igraph_i_maximal_cliques_thread_t;
+
+typedef struct {
+    igraph_i_maximal_cliques_thread_t *threads;
+    igraph_integer_t no_of_threads;
+    igraph_vector_int_t owner;         /* thread that searched from a vertex */
+    igraph_vector_int_t first;         /* index of its first clique in 'cliques' */
+    igraph_vector_int_t found;         /* number of cliques found from a vertex */
+    igraph_vector_int_t errors;
+} igraph_i_maximal_cliques_par_t;
+
+static void igraph_i_maximal_cliques_par_destroy(igraph_i_maximal_cliques_par_t *par) {
+    for (igraph_integer_t t = 0; t < par->no_of_threads; t++) {
+        igraph_vector_destroy(&par->threads[t].hist);
+        igraph_vector_int_list_destroy(&par->threads[t].cliques);
+        igraph_i_maximal_cliques_ws_destroy(&par->threads[t].ws);
+    }
+    IGRAPH_FREE(par->threads);
+    igraph_vector_int_destroy(&par->errors);
+    igraph_vector_int_destroy(&par->found);
+    igraph_vector_int_destroy(&par->first);
+    igraph_vector_int_destroy(&par->owner);
+}
+
+static igraph_error_t igraph_i_maximal_cliques_par_init(
+        igraph_i_maximal_cliques_par_t *par, igraph_integer_t no_of_nodes) {
+    igraph_integer_t no_of_threads = 1;
+
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+    no_of_threads = omp_get_max_threads();
+#endif
+
+    par->no_of_threads = 0;
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&par->owner, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&par->first, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&par->found, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&par->errors, 0);
+    par->threads = IGRAPH_CALLOC(no_of_threads, igraph_i_maximal_cliques_thread_t);
+    IGRAPH_CHECK_OOM(par->threads, "Insufficient memory for parallel maximal clique search.");
+    IGRAPH_FINALLY_CLEAN(4);
+    IGRAPH_FINALLY(igraph_i_maximal_cliques_par_destroy, par);
+
+    for (igraph_integer_t t = 0; t < no_of_threads; t++) {
+        igraph_i_maximal_cliques_thread_t *thread = &par->threads[t];
+        IGRAPH_CHECK(igraph_i_maximal_cliques_ws_init(&thread->ws, no_of_nodes));
+        IGRAPH_FINALLY(igraph_i_maximal_cliques_ws_destroy, &thread->ws);
+        IGRAPH_CHECK(igraph_vector_int_list_init(&thread->cliques, 0));
+        IGRAPH_FINALLY(igraph_vector_int_list_destroy, &thread->cliques);
+        IGRAPH_CHECK(igraph_vector_init(&thread->hist, 0));
+        IGRAPH_FINALLY_CLEAN(2);
+        par->no_of_threads++;
+    }
+
+    IGRAPH_FINALLY_CLEAN(1);
+    return IGRAPH_SUCCESS;
+}
+
+/* Searches from all vertices of the degeneracy order in parallel. The
+ * vertices are handed out to the threads one by one, so that a thread which
+ * finishes early takes over the remaining vertices of the block. Cliques are
+ * counted into 'no', or their sizes into 'hist', or they are appended to
+ * 'res' or passed to 'cliquehandler_fn'. The latter two only happen on the
+ * calling thread, in the same order as in the serial search. */
+static igraph_error_t igraph_i_maximal_cliques_parallel(
+        const igraph_vector_int_t *order, const igraph_vector_int_t *rank,
+        const igraph_adjlist_t *fulladjlist,
+        igraph_integer_t min_size, igraph_integer_t max_size,
+        igraph_vector_int_list_t *res, igraph_integer_t *no, igraph_vector_t *hist,
+        igraph_clique_handler_t *cliquehandler_fn, void *arg) {
+
+    const igraph_integer_t no_of_nodes = igraph_vector_int_size(order);
+    igraph_i_maximal_cliques_par_t par;
+    igraph_integer_t block_size, max_block_size;
+    igraph_bool_t stop = false;
+
+    IGRAPH_CHECK(igraph_i_maximal_cliques_par_init(&par, no_of_nodes));
+    IGRAPH_FINALLY(igraph_i_maximal_cliques_par_destroy, &par);
+
+    max_block_size = block_size = IGRAPH_I_MAXIMAL_CLIQUES_BLOCK_SIZE * par.no_of_threads;
+    IGRAPH_CHECK(igraph_vector_int_resize(&par.owner, max_block_size));
+    IGRAPH_CHECK(igraph_vector_int_resize(&par.first, max_block_size));
+    IGRAPH_CHECK(igraph_vector_int_resize(&par.found, max_block_size));
+    IGRAPH_CHECK(igraph_vector_int_resize(&par.errors, max_block_size));
+
+    for (igraph_integer_t start = 0, end; start < no_of_nodes && !stop; start = end) {
+        igraph_bool_t failed = false;
+
+        end = start + block_size < no_of_nodes ? start + block_size : no_of_nodes;
+
+        igraph_vector_int_null(&par.found);
+        igraph_vector_int_null(&par.errors);
+
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+#pragma omp parallel for schedule(dynamic, 1) num_threads(par.no_of_threads)
+#endif
+        for (igraph_integer_t i = start; i < end; i++) {
+            /* The error handler and the finally stack are thread-local in
+             * thread-safe builds, otherwise the vertices are processed one
+             * by one. */
+            igraph_error_handler_t *handler;
+            igraph_i_maximal_cliques_thread_t *thread;
+            igraph_integer_t t = 0, v = VECTOR(*order)[i], before;
+            igraph_bool_t skip;
+            igraph_error_t err;
+
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+            t = omp_get_thread_num();
+#pragma omp atomic read
+#endif
+            skip = failed;
+            if (skip) {
+                continue;
+            }
+
+            thread = &par.threads[t];
+            before = igraph_vector_int_list_size(&thread->cliques);
+
+            handler = igraph_set_error_handler(igraph_error_handler_ignore);
+            IGRAPH_FINALLY_ENTER();
+            if (hist) {
+                err = igraph_i_maximal_cliques_vertex_hist(
+                          &thread->ws, v, rank, fulladjlist, &thread->hist, min_size, max_size);
+            } else if (no) {
+                err = igraph_i_maximal_cliques_vertex_count(
+                          &thread->ws, v, rank, fulladjlist, &thread->count, min_size, max_size);
+            } else {
+                err = igraph_i_maximal_cliques_vertex(
+                          &thread->ws, v, rank, fulladjlist, &thread->cliques, min_size, max_size);
+            }
+            if (err != IGRAPH_SUCCESS) {
+                IGRAPH_FINALLY_FREE();
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+#pragma omp atomic write
+#endif
+                failed = true;
+            }
+            IGRAPH_FINALLY_EXIT();
+            igraph_set_error_handler(handler);
+
+            VECTOR(par.errors)[i - start] = err;
+            VECTOR(par.owner)[i - start] = t;
+            VECTOR(par.first)[i - start] = before;
+            VECTOR(par.found)[i - start] = igraph_vector_int_list_size(&thread->cliques) - before;
+        }
+
+        for (igraph_integer_t i = start; i < end; i++) {
+            if (VECTOR(par.errors)[i - start] != IGRAPH_SUCCESS) {
+                IGRAPH_ERROR("Parallel maximal clique search failed.", VECTOR(par.errors)[i - start]);
+            }
+        }
+
+        /* Report the cliques in the serial order by walking through the block */
+        if (res || cliquehandler_fn) {
+            for (igraph_integer_t i = start; i < end && !stop; i++) {
+                igraph_i_maximal_cliques_thread_t *thread = &par.threads[VECTOR(par.owner)[i - start]];
+                for (igraph_integer_t k = 0; k < VECTOR(par.found)[i - start]; k++) {
+                    igraph_vector_int_t *clique = igraph_vector_int_list_get_ptr(
+                            &thread->cliques, VECTOR(par.first)[i - start] + k);
+                    if (res) {
+                        igraph_vector_int_t *item;
+                        IGRAPH_CHECK(igraph_vector_int_list_push_back_new(res, &item));
+                        igraph_vector_int_swap(item, clique);
+                    } else {
+                        igraph_error_t err = cliquehandler_fn(clique, arg);
+                        if (err == IGRAPH_STOP) {
+                            stop = true;
+                            break;
+                        } else if (err != IGRAPH_SUCCESS) {
+                            IGRAPH_ERROR("Cannot list maximal cliques", err);
+                        }
+                    }
+                }
+            }
+            for (igraph_integer_t t = 0; t < par.no_of_threads; t++) {
+                igraph_vector_int_list_clear(&par.threads[t].cliques);
+            }
+        }
+
+        if (cliquehandler_fn) {
+            igraph_integer_t buffered = 0;
+            for (igraph_integer_t i = start; i < end; i++) {
+                buffered += VECTOR(par.found)[i - start];
+            }
+            if (buffered > IGRAPH_I_MAXIMAL_CLIQUES_MAX_BUFFERED) {
+                block_size = block_size / 2 > par.no_of_threads ? block_size / 2 : par.no_of_threads;
+            } else if (buffered < IGRAPH_I_MAXIMAL_CLIQUES_MAX_BUFFERED / 2) {
+                block_size = block_size * 2 < max_block_size ? block_size * 2 : max_block_size;
+            }
+        }
+
+        IGRAPH_PROGRESS("Maximal cliques: ", 100.0 * end / no_of_nodes, NULL);
+        IGRAPH_ALLOW_INTERRUPTION();
+    }
+
+    if (no) {
+        for (igraph_integer_t t = 0; t < par.no_of_threads; t++) {
+            *no += par.threads[t].count;
+        }
+    }
+
+    if (hist) {
+        for (igraph_integer_t t = 0; t < par.no_of_threads; t++) {
+            const igraph_vector_t *thread_hist = &par.threads[t].hist;
+            igraph_integer_t hsize = igraph_vector_size(hist);
+            igraph_integer_t tsize = igraph_vector_size(thread_hist);
+            if (tsize > hsize) {
+                IGRAPH_CHECK(igraph_vector_resize(hist, tsize));
+                for (igraph_integer_t j = hsize; j < tsize; j++) {
+                    VECTOR(*hist)[j] = 0;
+                }
+            }
+            for (igraph_integer_t j = 0; j < tsize; j++) {
+                VECTOR(*hist)[j] += VECTOR(*thread_hist)[j];
+            }
+        }
+    }
+
+    igraph_i_maximal_cliques_par_destroy(&par);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return IGRAPH_SUCCESS;
+}
@@ -0,0 +1,63 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IGRAPH_CLIQUES_MAXIMAL_CLIQUES_H
+#define IGRAPH_CLIQUES_MAXIMAL_CLIQUES_H
+
+#include "igraph_decls.h"
+#include "igraph_cliques.h"
+#include "igraph_datatype.h"
+#include "igraph_vector_list.h"
+
+__BEGIN_DECLS
+
+/* igraph_maximal_cliques(), igraph_maximal_cliques_count(),
+ * igraph_maximal_cliques_hist() and igraph_maximal_cliques_callback() search
+ * from different vertices in parallel on graphs with at least this many
+ * edges, when igraph is compiled with OpenMP in thread-safe mode and more
+ * than one thread is available. Clique enumeration does much more work per
+ * edge than most graph algorithms, hence the low threshold. */
+#define IGRAPH_I_MAXIMAL_CLIQUES_PARALLEL_MIN_EDGES 10000
+
+/* Same as the corresponding public functions, but the parallel variant is
+ * used on graphs with at least 'parallel_min_edges' edges, also when there
+ * is only one thread. A negative value disables the parallel variant. */
+IGRAPH_PRIVATE_EXPORT igraph_error_t igraph_i_maximal_cliques(
+        const igraph_t *graph, igraph_vector_int_list_t *res,
+        igraph_integer_t min_size, igraph_integer_t max_size,
+        igraph_integer_t parallel_min_edges);
+
+IGRAPH_PRIVATE_EXPORT igraph_error_t igraph_i_maximal_cliques_count(
+        const igraph_t *graph, igraph_integer_t *res,
+        igraph_integer_t min_size, igraph_integer_t max_size,
+        igraph_integer_t parallel_min_edges);
+
+IGRAPH_PRIVATE_EXPORT igraph_error_t igraph_i_maximal_cliques_hist(
+        const igraph_t *graph, igraph_vector_t *hist,
+        igraph_integer_t min_size, igraph_integer_t max_size,
+        igraph_integer_t parallel_min_edges);
+
+IGRAPH_PRIVATE_EXPORT igraph_error_t igraph_i_maximal_cliques_callback(
+        const igraph_t *graph,
+        igraph_clique_handler_t *cliquehandler_fn, void *arg,
+        igraph_integer_t min_size, igraph_integer_t max_size,
+        igraph_integer_t parallel_min_edges);
+
+__END_DECLS
+
+#endif
@@ -34,6 +34,11 @@
 #define CLEANUP
 #define FOR_LOOP_OVER_VERTICES for (i=0; i<no_of_nodes; i++)
 #define FOR_LOOP_OVER_VERTICES_PREPARE
+#define PREFIX igraph_i_maximal_cliques
+#define PARALLEL_PARAMS , igraph_integer_t parallel_min_edges
+#define PARALLEL (parallel_min_edges >= 0 && igraph_ecount(graph) >= parallel_min_edges)
+#define PARALLEL_RUN igraph_i_maximal_cliques_parallel( \
+        &order, &rank, &fulladjlist, min_size, max_size, res, NULL, NULL, NULL, NULL)
 #endif
 
 #ifdef IGRAPH_MC_COUNT
@@ -45,6 +50,11 @@
     #define CLEANUP
     #define FOR_LOOP_OVER_VERTICES for (i=0; i<no_of_nodes; i++)
     #define FOR_LOOP_OVER_VERTICES_PREPARE
+    #define PREFIX igraph_i_maximal_cliques
+    #define PARALLEL_PARAMS , igraph_integer_t parallel_min_edges
+    #define PARALLEL (parallel_min_edges >= 0 && igraph_ecount(graph) >= parallel_min_edges)
+    #define PARALLEL_RUN igraph_i_maximal_cliques_parallel( \
+            &order, &rank, &fulladjlist, min_size, max_size, NULL, res, NULL, NULL, NULL)
 #endif
 
 #ifdef IGRAPH_MC_FILE
@@ -56,6 +66,10 @@
     #define CLEANUP
     #define FOR_LOOP_OVER_VERTICES for (i=0; i<no_of_nodes; i++)
     #define FOR_LOOP_OVER_VERTICES_PREPARE
+    #define PREFIX igraph_maximal_cliques
+    #define PARALLEL_PARAMS
+    #define PARALLEL false
+    #define PARALLEL_RUN IGRAPH_SUCCESS
 #endif
 
 #ifdef IGRAPH_MC_FULL
@@ -86,6 +100,10 @@
 #define FOR_LOOP_OVER_VERTICES_PREPARE do { \
         i = subset ? VECTOR(*subset)[ii] : ii; \
     } while (0)
+#define PREFIX igraph_maximal_cliques
+#define PARALLEL_PARAMS
+#define PARALLEL false
+#define PARALLEL_RUN IGRAPH_SUCCESS
 #endif
 
 #ifdef IGRAPH_MC_CALLBACK
@@ -107,6 +125,11 @@
 #define CLEANUP
 #define FOR_LOOP_OVER_VERTICES for (i=0; i<no_of_nodes; i++)
 #define FOR_LOOP_OVER_VERTICES_PREPARE
+#define PREFIX igraph_i_maximal_cliques
+#define PARALLEL_PARAMS , igraph_integer_t parallel_min_edges
+#define PARALLEL (parallel_min_edges >= 0 && igraph_ecount(graph) >= parallel_min_edges)
+#define PARALLEL_RUN igraph_i_maximal_cliques_parallel( \
+        &order, &rank, &fulladjlist, min_size, max_size, NULL, NULL, NULL, cliquehandler_fn, arg)
 #endif
 
 #ifdef IGRAPH_MC_HIST
@@ -135,6 +158,11 @@
 #define CLEANUP
 #define FOR_LOOP_OVER_VERTICES for (i=0; i<no_of_nodes; i++)
 #define FOR_LOOP_OVER_VERTICES_PREPARE
+#define PREFIX igraph_i_maximal_cliques
+#define PARALLEL_PARAMS , igraph_integer_t parallel_min_edges
+#define PARALLEL (parallel_min_edges >= 0 && igraph_ecount(graph) >= parallel_min_edges)
+#define PARALLEL_RUN igraph_i_maximal_cliques_parallel( \
+        &order, &rank, &fulladjlist, min_size, max_size, NULL, NULL, hist, NULL, NULL)
 #endif
 
 static igraph_error_t FUNCTION(igraph_i_maximal_cliques_bk, SUFFIX)(
@@ -197,23 +225,94 @@ static igraph_error_t FUNCTION(igraph_i_maximal_cliques_bk, SUFFIX)(
     return IGRAPH_SUCCESS;
 }
 
-igraph_error_t FUNCTION(igraph_maximal_cliques, SUFFIX)(
+/* Lists the maximal cliques that contain 'v' but none of the vertices before
+ * it in the degeneracy order. The buffers in 'ws' are reused between calls. */
+static igraph_error_t FUNCTION(igraph_i_maximal_cliques_vertex, SUFFIX)(
+    igraph_i_maximal_cliques_ws_t *ws, igraph_integer_t v,
+    const igraph_vector_int_t *rank, const igraph_adjlist_t *fulladjlist,
+    RESTYPE,
+    igraph_integer_t min_size, igraph_integer_t max_size) {
+
+    igraph_integer_t vrank = VECTOR(*rank)[v];
+    igraph_vector_int_t *vneis = igraph_adjlist_get(fulladjlist, v);
+    igraph_integer_t vdeg = igraph_vector_int_size(vneis);
+    igraph_integer_t Pptr = 0, Xptr = vdeg - 1, PS = 0, PE, XS, XE = vdeg - 1;
+    igraph_integer_t j;
+
+    IGRAPH_CHECK(igraph_vector_int_resize(&ws->PX, vdeg));
+    IGRAPH_CHECK(igraph_vector_int_resize(&ws->R, 1));
+    IGRAPH_CHECK(igraph_vector_int_resize(&ws->H, 1));
+    igraph_vector_int_null(&ws->pos); /* TODO: makes it quadratic? */
+    IGRAPH_CHECK(igraph_vector_int_resize(&ws->nextv, 1));
+
+    VECTOR(ws->H)[0] = -1;      /* marks the end of the recursion */
+    VECTOR(ws->nextv)[0] = -1;
+
+    /* ================================================================*/
+    /* P <- G(v[i]) intersect { v[i+1], ..., v[n-1] }
+       X <- G(v[i]) intersect { v[0], ..., v[i-1] } */
+
+    VECTOR(ws->R)[0] = v;
+    for (j = 0; j < vdeg; j++) {
+        igraph_integer_t vx = VECTOR(*vneis)[j];
+        if (VECTOR(*rank)[vx] > vrank) {
+            VECTOR(ws->PX)[Pptr] = vx;
+            VECTOR(ws->pos)[vx] = Pptr + 1;
+            Pptr++;
+        } else if (VECTOR(*rank)[vx] < vrank) {
+            VECTOR(ws->PX)[Xptr] = vx;
+            VECTOR(ws->pos)[vx] = Xptr + 1;
+            Xptr--;
+        }
+    }
+
+    PE = Pptr - 1; XS = Xptr + 1; /* end of P, start of X in PX */
+
+    /* Create an adjacency list that is specific to the
+       v vertex. It only contains 'v' and its neighbors. Moreover, we
+       only deal with the vertices in P and X (and R). */
+    IGRAPH_CHECK(igraph_vector_int_update(igraph_adjlist_get(&ws->adjlist, v), vneis));
+    for (j = 0; j <= vdeg - 1; j++) {
+        igraph_integer_t vv = VECTOR(ws->PX)[j];
+        igraph_vector_int_t *fadj = igraph_adjlist_get(fulladjlist, vv);
+        igraph_vector_int_t *radj = igraph_adjlist_get(&ws->adjlist, vv);
+        igraph_integer_t k, fn = igraph_vector_int_size(fadj);
+        igraph_vector_int_clear(radj);
+        for (k = 0; k < fn; k++) {
+            igraph_integer_t nei = VECTOR(*fadj)[k];
+            igraph_integer_t neipos = VECTOR(ws->pos)[nei] - 1;
+            if (neipos >= PS && neipos <= XE) {
+                IGRAPH_CHECK(igraph_vector_int_push_back(radj, nei));
+            }
+        }
+    }
+
+    /* Reorder the adjacency lists, according to P and X. */
+    IGRAPH_CHECK(igraph_i_maximal_cliques_reorder_adjlists(
+        &ws->PX, PS, PE, XS, XE, &ws->pos, &ws->adjlist
+    ));
+
+    return FUNCTION(igraph_i_maximal_cliques_bk, SUFFIX)(
+               &ws->PX, PS, PE, XS, XE, PS, XE, &ws->R, &ws->pos,
+               &ws->adjlist, RESNAME, &ws->nextv, &ws->H, min_size,
+               max_size);
+}
+
+igraph_error_t FUNCTION(PREFIX, SUFFIX)(
     const igraph_t *graph,
     RESTYPE,
     igraph_integer_t min_size,
-    igraph_integer_t max_size) {
+    igraph_integer_t max_size
+    PARALLEL_PARAMS) {
 
     /* Implementation details. TODO */
 
     const igraph_integer_t no_of_nodes = igraph_vcount(graph);
-    igraph_vector_int_t PX, R, H, pos, nextv;
     igraph_vector_int_t coreness;
     igraph_vector_int_t order;
     igraph_vector_int_t rank; /* TODO: this is not needed */
     igraph_integer_t i, ii, nn;
-    igraph_adjlist_t adjlist, fulladjlist;
-    igraph_real_t pgreset = round(no_of_nodes / 100.0), pg = pgreset, pgc = 0;
-    igraph_error_t err;
+    igraph_adjlist_t fulladjlist;
 
     IGRAPH_UNUSED(nn); /* not used by all implementations */
 
@@ -234,125 +333,54 @@ igraph_error_t FUNCTION(igraph_maximal_cliques, SUFFIX)(
     igraph_vector_int_destroy(&coreness);
     IGRAPH_FINALLY_CLEAN(1);
 
-    IGRAPH_CHECK(igraph_adjlist_init(graph, &adjlist, IGRAPH_ALL, IGRAPH_NO_LOOPS, IGRAPH_NO_MULTIPLE));
-    IGRAPH_FINALLY(igraph_adjlist_destroy, &adjlist);
-
     IGRAPH_CHECK(igraph_adjlist_init(graph, &fulladjlist, IGRAPH_ALL, IGRAPH_NO_LOOPS, IGRAPH_NO_MULTIPLE));
     IGRAPH_FINALLY(igraph_adjlist_destroy, &fulladjlist);
 
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&PX, 20);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&R, 20);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&H, 100);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&pos, no_of_nodes);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&nextv, 100);
-
     PREPARE;
 
-    FOR_LOOP_OVER_VERTICES {
-        igraph_integer_t v;
-        igraph_integer_t vrank;
-        igraph_vector_int_t *vneis;
-        igraph_integer_t vdeg;
-        igraph_integer_t Pptr, Xptr, PS, PE, XS, XE;
-        igraph_integer_t j;
-
-        FOR_LOOP_OVER_VERTICES_PREPARE;
-
-        v = VECTOR(order)[i];
-        vrank = VECTOR(rank)[v];
-        vneis = igraph_adjlist_get(&fulladjlist, v);
-        vdeg = igraph_vector_int_size(vneis);
-        Pptr = 0; Xptr = vdeg - 1; PS = 0; XE = vdeg - 1;
-
-        pg--;
-        if (pg <= 0) {
-            IGRAPH_PROGRESS("Maximal cliques: ", pgc++, NULL);
-            pg = pgreset;
-        }
+    if (PARALLEL) {
+        IGRAPH_CHECK(PARALLEL_RUN);
+    } else {
+        igraph_i_maximal_cliques_ws_t ws;
+        igraph_real_t pgreset = round(no_of_nodes / 100.0), pg = pgreset, pgc = 0;
+        igraph_error_t err;
 
-        IGRAPH_ALLOW_INTERRUPTION();
-
-        IGRAPH_CHECK(igraph_vector_int_resize(&PX, vdeg));
-        IGRAPH_CHECK(igraph_vector_int_resize(&R, 1));
-        IGRAPH_CHECK(igraph_vector_int_resize(&H, 1));
-        igraph_vector_int_null(&pos); /* TODO: makes it quadratic? */
-        IGRAPH_CHECK(igraph_vector_int_resize(&nextv, 1));
-
-        VECTOR(H)[0] = -1;      /* marks the end of the recursion */
-        VECTOR(nextv)[0] = -1;
-
-        /* ================================================================*/
-        /* P <- G(v[i]) intersect { v[i+1], ..., v[n-1] }
-           X <- G(v[i]) intersect { v[0], ..., v[i-1] } */
-
-        VECTOR(R)[0] = v;
-        for (j = 0; j < vdeg; j++) {
-            igraph_integer_t vx = VECTOR(*vneis)[j];
-            if (VECTOR(rank)[vx] > vrank) {
-                VECTOR(PX)[Pptr] = vx;
-                VECTOR(pos)[vx] = Pptr + 1;
-                Pptr++;
-            } else if (VECTOR(rank)[vx] < vrank) {
-                VECTOR(PX)[Xptr] = vx;
-                VECTOR(pos)[vx] = Xptr + 1;
-                Xptr--;
-            }
-        }
+        IGRAPH_CHECK(igraph_i_maximal_cliques_ws_init(&ws, no_of_nodes));
+        IGRAPH_FINALLY(igraph_i_maximal_cliques_ws_destroy, &ws);
 
-        PE = Pptr - 1; XS = Xptr + 1; /* end of P, start of X in PX */
+        FOR_LOOP_OVER_VERTICES {
+            FOR_LOOP_OVER_VERTICES_PREPARE;
 
-        /* Create an adjacency list that is specific to the
-           v vertex. It only contains 'v' and its neighbors. Moreover, we
-           only deal with the vertices in P and X (and R). */
-        IGRAPH_CHECK(igraph_vector_int_update(
-            igraph_adjlist_get(&adjlist, v),
-            igraph_adjlist_get(&fulladjlist, v)
-        ));
-        for (j = 0; j <= vdeg - 1; j++) {
-            igraph_integer_t vv = VECTOR(PX)[j];
-            igraph_vector_int_t *fadj = igraph_adjlist_get(&fulladjlist, vv);
-            igraph_vector_int_t *radj = igraph_adjlist_get(&adjlist, vv);
-            igraph_integer_t k, fn = igraph_vector_int_size(fadj);
-            igraph_vector_int_clear(radj);
-            for (k = 0; k < fn; k++) {
-                igraph_integer_t nei = VECTOR(*fadj)[k];
-                igraph_integer_t neipos = VECTOR(pos)[nei] - 1;
-                if (neipos >= PS && neipos <= XE) {
-                    IGRAPH_CHECK(igraph_vector_int_push_back(radj, nei));
-                }
+            pg--;
+            if (pg <= 0) {
+                IGRAPH_PROGRESS("Maximal cliques: ", pgc++, NULL);
+                pg = pgreset;
             }
-        }
 
-        /* Reorder the adjacency lists, according to P and X. */
-        IGRAPH_CHECK(igraph_i_maximal_cliques_reorder_adjlists(
-            &PX, PS, PE, XS, XE, &pos, &adjlist
-        ));
+            IGRAPH_ALLOW_INTERRUPTION();
 
-        err = FUNCTION(igraph_i_maximal_cliques_bk, SUFFIX)(
-                &PX, PS, PE, XS, XE, PS, XE, &R, &pos,
-                &adjlist, RESNAME, &nextv, &H, min_size,
-                max_size);
-        if (err == IGRAPH_STOP) {
-            break;
-        } else {
-            IGRAPH_CHECK(err);
+            err = FUNCTION(igraph_i_maximal_cliques_vertex, SUFFIX)(
+                    &ws, VECTOR(order)[i], &rank, &fulladjlist, RESNAME,
+                    min_size, max_size);
+            if (err == IGRAPH_STOP) {
+                break;
+            } else {
+                IGRAPH_CHECK(err);
+            }
         }
+
+        igraph_i_maximal_cliques_ws_destroy(&ws);
+        IGRAPH_FINALLY_CLEAN(1);
     }
 
     IGRAPH_PROGRESS("Maximal cliques: ", 100.0, NULL);
 
     CLEANUP;
 
-    igraph_vector_int_destroy(&nextv);
-    igraph_vector_int_destroy(&pos);
-    igraph_vector_int_destroy(&H);
-    igraph_vector_int_destroy(&R);
-    igraph_vector_int_destroy(&PX);
     igraph_adjlist_destroy(&fulladjlist);
-    igraph_adjlist_destroy(&adjlist);
     igraph_vector_int_destroy(&rank);
     igraph_vector_int_destroy(&order);
-    IGRAPH_FINALLY_CLEAN(9);
+    IGRAPH_FINALLY_CLEAN(3);
 
     return IGRAPH_SUCCESS;
 }
@@ -365,3 +393,7 @@ igraph_error_t FUNCTION(igraph_maximal_cliques, SUFFIX)(
 #undef CLEANUP
 #undef FOR_LOOP_OVER_VERTICES
 #undef FOR_LOOP_OVER_VERTICES_PREPARE
+#undef PREFIX
+#undef PARALLEL_PARAMS
+#undef PARALLEL
+#undef PARALLEL_RUN
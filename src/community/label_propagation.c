@@ -26,8 +26,524 @@
 #include "igraph_memory.h"
 #include "igraph_random.h"
 
+#include "community/label_propagation.h"
 #include "core/interruption.h"
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+/* In the parallel variant, rounds with fewer vertices to update than this are
+ * processed by a single thread. After the given number of rounds, all further
+ * rounds are processed by a single thread too: concurrent updates of adjacent
+ * vertices may oscillate, but sequential updates always converge on
+ * undirected graphs. Vertices are handed out to the threads in chunks. */
+#define IGRAPH_I_LPA_PARALLEL_MIN_FRONTIER 1024
+#define IGRAPH_I_LPA_MAX_PARALLEL_ROUNDS 100
+#define IGRAPH_I_LPA_CHUNK_SIZE 256
+#define IGRAPH_I_LPA_STAGING_SIZE 1024
+
+/* Buffers of one thread of the parallel label propagation. The labels of the
+ * neighbors of a vertex are counted in an open addressing hash table whose
+ * size is a power of two and at least twice the degree of the vertex; 'keys'
+ * holds the labels, zero denoting an empty slot. Vertices to update in the
+ * next round are collected in 'staging' and copied to the shared list in
+ * batches. */
+typedef struct {
+    igraph_vector_int_t keys;
+    igraph_vector_t counts;
+    igraph_vector_int_t slots;
+    igraph_vector_int_t dominant;
+    igraph_vector_int_t staging;
+    igraph_integer_t staged;
+    igraph_rng_t rng;
+} igraph_i_lpa_thread_t;
+
+/* Data shared by all threads of the parallel label propagation. */
+typedef struct {
+    igraph_csr_t in;                    /* labels are counted along these */
+    igraph_csr_t out;                   /* vertices affected by a change */
+    igraph_bool_t symmetric;            /* whether 'out' is the same as 'in' */
+    const igraph_vector_t *weights;
+    igraph_integer_t *labels;
+    igraph_vector_bool_t active;
+    igraph_vector_int_t frontier;
+    igraph_vector_int_t next;
+    igraph_integer_t next_size;
+    igraph_integer_t no_of_threads;
+    igraph_i_lpa_thread_t *threads;
+} igraph_i_lpa_data_t;
+
+static void igraph_i_lpa_data_destroy(igraph_i_lpa_data_t *data) {
+    for (igraph_integer_t t = 0; t < data->no_of_threads; t++) {
+        igraph_i_lpa_thread_t *thread = &data->threads[t];
+        igraph_rng_destroy(&thread->rng);
+        igraph_vector_int_destroy(&thread->staging);
+        igraph_vector_int_destroy(&thread->dominant);
+        igraph_vector_int_destroy(&thread->slots);
+        igraph_vector_destroy(&thread->counts);
+        igraph_vector_int_destroy(&thread->keys);
+    }
+    IGRAPH_FREE(data->threads);
+    igraph_vector_int_destroy(&data->next);
+    igraph_vector_int_destroy(&data->frontier);
+    igraph_vector_bool_destroy(&data->active);
+    if (!data->symmetric) {
+        igraph_csr_destroy(&data->out);
+    }
+    igraph_csr_destroy(&data->in);
+}
+
+static igraph_error_t igraph_i_lpa_data_init(
+        igraph_i_lpa_data_t *data, const igraph_t *graph,
+        igraph_neimode_t mode, const igraph_vector_t *weights,
+        igraph_vector_int_t *membership) {
+    const igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t no_of_threads = 1, max_degree = 0, table_size = 1;
+    igraph_error_t err = IGRAPH_SUCCESS;
+
+#ifdef _OPENMP
+    no_of_threads = omp_get_max_threads();
+#endif
+
+    data->symmetric = !igraph_is_directed(graph) || mode == IGRAPH_ALL;
+    data->weights = weights;
+    data->labels = VECTOR(*membership);
+    data->next_size = 0;
+    data->no_of_threads = 0;
+
+    IGRAPH_CHECK(igraph_csr_init(graph, &data->in, IGRAPH_REVERSE_MODE(mode),
+                                 IGRAPH_LOOPS_ONCE, IGRAPH_MULTIPLE, weights != NULL));
+    IGRAPH_FINALLY(igraph_csr_destroy, &data->in);
+    if (!data->symmetric) {
+        IGRAPH_CHECK(igraph_csr_init(graph, &data->out, mode,
+                                     IGRAPH_LOOPS_ONCE, IGRAPH_MULTIPLE, false));
+        IGRAPH_FINALLY(igraph_csr_destroy, &data->out);
+    }
+    IGRAPH_CHECK(igraph_vector_bool_init(&data->active, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_bool_destroy, &data->active);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&data->frontier, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&data->next, no_of_nodes);
+
+    data->threads = IGRAPH_CALLOC(no_of_threads, igraph_i_lpa_thread_t);
+    IGRAPH_CHECK_OOM(data->threads, "Insufficient memory for parallel label propagation.");
+    IGRAPH_FINALLY_CLEAN(data->symmetric ? 4 : 5);
+    IGRAPH_FINALLY(igraph_i_lpa_data_destroy, data);
+
+    for (igraph_integer_t v = 0; v < no_of_nodes; v++) {
+        if (igraph_csr_degree(&data->in, v) > max_degree) {
+            max_degree = igraph_csr_degree(&data->in, v);
+        }
+    }
+    while (table_size < 2 * max_degree) {
+        table_size *= 2;
+    }
+
+    for (igraph_integer_t t = 0; t < no_of_threads; t++) {
+        igraph_i_lpa_thread_t *thread = &data->threads[t];
+        IGRAPH_VECTOR_INT_INIT_FINALLY(&thread->keys, table_size);
+        IGRAPH_VECTOR_INIT_FINALLY(&thread->counts, table_size);
+        IGRAPH_VECTOR_INT_INIT_FINALLY(&thread->slots, max_degree);
+        IGRAPH_VECTOR_INT_INIT_FINALLY(&thread->dominant, max_degree);
+        IGRAPH_VECTOR_INT_INIT_FINALLY(&thread->staging, IGRAPH_I_LPA_STAGING_SIZE);
+        IGRAPH_CHECK(igraph_rng_init(&thread->rng, &igraph_rngtype_pcg32));
+        IGRAPH_FINALLY_CLEAN(5);
+        thread->staged = 0;
+        data->no_of_threads++;
+    }
+
+    /* Errors are only raised after RNG_END(), so that it is always called. */
+    RNG_BEGIN();
+    for (igraph_integer_t t = 0; t < no_of_threads && err == IGRAPH_SUCCESS; t++) {
+        err = igraph_rng_seed(&data->threads[t].rng, RNG_INTEGER(0, IGRAPH_INTEGER_MAX));
+    }
+    RNG_END();
+    IGRAPH_CHECK(err);
+
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return IGRAPH_SUCCESS;
+}
+
+static igraph_integer_t igraph_i_lpa_get_label(const igraph_integer_t *labels, igraph_integer_t v) {
+    igraph_integer_t label;
+#ifdef _OPENMP
+#pragma omp atomic read
+#endif
+    label = labels[v];
+    return label;
+}
+
+static void igraph_i_lpa_set_label(igraph_integer_t *labels, igraph_integer_t v, igraph_integer_t label) {
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+    labels[v] = label;
+}
+
+/* Copies the staged vertices of a thread to the list of vertices to update
+ * in the next round. */
+static void igraph_i_lpa_flush(igraph_i_lpa_data_t *data, igraph_i_lpa_thread_t *thread) {
+    igraph_integer_t pos;
+
+    if (thread->staged == 0) {
+        return;
+    }
+
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+    { pos = data->next_size; data->next_size += thread->staged; }
+
+    memcpy(VECTOR(data->next) + pos, VECTOR(thread->staging), sizeof(igraph_integer_t) * thread->staged);
+    thread->staged = 0;
+}
+
+/* Adds a vertex to the next round, unless it has been added already. */
+static void igraph_i_lpa_activate(igraph_i_lpa_data_t *data, igraph_i_lpa_thread_t *thread,
+                                  igraph_integer_t v) {
+    igraph_bool_t was_active;
+
+#ifdef _OPENMP
+#pragma omp atomic capture
+#endif
+    { was_active = VECTOR(data->active)[v]; VECTOR(data->active)[v] = true; }
+
+    if (!was_active) {
+        VECTOR(thread->staging)[thread->staged++] = v;
+        if (thread->staged == IGRAPH_I_LPA_STAGING_SIZE) {
+            igraph_i_lpa_flush(data, thread);
+        }
+    }
+}
+
+/* Returns the new label of a vertex: its current label if that is one of the
+ * dominant labels among its neighbors, or if it has no labeled neighbors,
+ * otherwise a random one of the dominant labels. */
+static igraph_integer_t igraph_i_lpa_dominant_label(const igraph_i_lpa_data_t *data,
+                                                    igraph_i_lpa_thread_t *thread,
+                                                    igraph_integer_t v) {
+    const igraph_integer_t *neis = igraph_csr_neighbors(&data->in, v);
+    const igraph_integer_t *eids = data->weights ? igraph_csr_edges(&data->in, v) : NULL;
+    const igraph_integer_t degree = igraph_csr_degree(&data->in, v);
+    const igraph_integer_t current = data->labels[v];
+    igraph_integer_t *keys = VECTOR(thread->keys);
+    igraph_real_t *counts = VECTOR(thread->counts);
+    igraph_integer_t *slots = VECTOR(thread->slots);
+    igraph_integer_t no_of_slots = 0, no_of_dominant = 0, result = current;
+    igraph_real_t max_count = 0.0, current_count = -1.0;
+    uint64_t mask = 1;
+
+    while (mask < 2 * (uint64_t) degree) {
+        mask <<= 1;
+    }
+    mask--;
+
+    /* Count the weights corresponding to different labels */
+    for (igraph_integer_t j = 0; j < degree; j++) {
+        igraph_integer_t label = igraph_i_lpa_get_label(data->labels, neis[j]);
+        uint64_t slot;
+
+        if (label == 0) {
+            continue;    /* skip if it has no label yet */
+        }
+
+        slot = (uint64_t) label * UINT64_C(0x9E3779B97F4A7C15);
+        slot = (slot ^ (slot >> 32)) & mask;
+        while (keys[slot] != 0 && keys[slot] != label) {
+            slot = (slot + 1) & mask;
+        }
+        if (keys[slot] == 0) {
+            keys[slot] = label;
+            counts[slot] = 0.0;
+            slots[no_of_slots++] = slot;
+        }
+        counts[slot] += eids ? VECTOR(*data->weights)[eids[j]] : 1.0;
+    }
+
+    if (no_of_slots == 0) {
+        return current;
+    }
+
+    for (igraph_integer_t j = 0; j < no_of_slots; j++) {
+        if (counts[slots[j]] > max_count) {
+            max_count = counts[slots[j]];
+        }
+        if (keys[slots[j]] == current) {
+            current_count = counts[slots[j]];
+        }
+    }
+
+    if (current_count != max_count) {
+        for (igraph_integer_t j = 0; j < no_of_slots; j++) {
+            if (counts[slots[j]] == max_count) {
+                VECTOR(thread->dominant)[no_of_dominant++] = keys[slots[j]];
+            }
+        }
+        result = VECTOR(thread->dominant)[igraph_rng_get_integer(&thread->rng, 0, no_of_dominant - 1)];
+    }
+
+    /* Clear the hash table */
+    for (igraph_integer_t j = 0; j < no_of_slots; j++) {
+        keys[slots[j]] = 0;
+    }
+
+    return result;
+}
+
+/* Asynchronous label propagation, processing the vertices in rounds. In each
+ * round, the vertices of the frontier are updated concurrently, each of them
+ * reading the current labels of its neighbors. When the label of a vertex
+ * changes, the vertices whose neighborhood contains it are added to the
+ * frontier of the next round. Initially, the frontier consists of the
+ * vertices in 'node_order'. The process stops when the frontier becomes
+ * empty, i.e. when the label of each vertex is dominant in its neighborhood.
+ * Labels are shifted by one, as in igraph_i_community_label_propagation().
+ *
+ * Unlike in the serial variant, a vertex keeps its label when that is one of
+ * the dominant labels. This makes it possible to detect convergence without
+ * checking all vertices in a separate iteration. */
+static igraph_error_t igraph_i_label_propagation_parallel(
+        const igraph_t *graph, igraph_vector_int_t *membership,
+        igraph_neimode_t mode, const igraph_vector_t *weights,
+        const igraph_vector_bool_t *fixed, const igraph_vector_int_t *node_order) {
+    igraph_i_lpa_data_t data;
+    igraph_integer_t frontier_size;
+    igraph_integer_t round = 0;
+
+    IGRAPH_CHECK(igraph_i_lpa_data_init(&data, graph, mode, weights, membership));
+    IGRAPH_FINALLY(igraph_i_lpa_data_destroy, &data);
+
+    IGRAPH_CHECK(igraph_vector_int_update(&data.frontier, node_order));
+    frontier_size = igraph_vector_int_size(&data.frontier);
+    for (igraph_integer_t i = 0; i < frontier_size; i++) {
+        VECTOR(data.active)[VECTOR(data.frontier)[i]] = true;
+    }
+
+    while (frontier_size > 0) {
+        const igraph_bool_t parallel = data.no_of_threads > 1 &&
+                                       frontier_size >= IGRAPH_I_LPA_PARALLEL_MIN_FRONTIER &&
+                                       round < IGRAPH_I_LPA_MAX_PARALLEL_ROUNDS;
+        const igraph_csr_t *out = data.symmetric ? &data.in : &data.out;
+
+        IGRAPH_CHECK(igraph_vector_int_shuffle(&data.frontier));
+        data.next_size = 0;
+
+#ifdef _OPENMP
+#pragma omp parallel num_threads(data.no_of_threads) if (parallel)
+#endif
+        {
+            igraph_integer_t t = 0;
+            igraph_i_lpa_thread_t *thread;
+
+#ifdef _OPENMP
+            t = omp_get_thread_num();
+#endif
+            thread = &data.threads[t];
+
+#ifdef _OPENMP
+#pragma omp for schedule(dynamic, IGRAPH_I_LPA_CHUNK_SIZE)
+#endif
+            for (igraph_integer_t i = 0; i < frontier_size; i++) {
+                igraph_integer_t v = VECTOR(data.frontier)[i];
+                igraph_integer_t label;
+
+#ifdef _OPENMP
+#pragma omp atomic write
+#endif
+                VECTOR(data.active)[v] = false;
+
+                label = igraph_i_lpa_dominant_label(&data, thread, v);
+                if (label != data.labels[v]) {
+                    const igraph_integer_t *neis = igraph_csr_neighbors(out, v);
+                    const igraph_integer_t degree = igraph_csr_degree(out, v);
+
+                    igraph_i_lpa_set_label(data.labels, v, label);
+                    for (igraph_integer_t j = 0; j < degree; j++) {
+                        if (!fixed || !VECTOR(*fixed)[neis[j]]) {
+                            igraph_i_lpa_activate(&data, thread, neis[j]);
+                        }
+                    }
+                }
+            }
+
+            igraph_i_lpa_flush(&data, thread);
+        }
+
+        /* The next frontier becomes the current one */
+        IGRAPH_CHECK(igraph_vector_int_resize(&data.frontier, data.next_size));
+        memcpy(VECTOR(data.frontier), VECTOR(data.next), sizeof(igraph_integer_t) * data.next_size);
+        frontier_size = data.next_size;
+        round++;
+
+        IGRAPH_ALLOW_INTERRUPTION();
+    }
+
+    igraph_i_lpa_data_destroy(&data);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return IGRAPH_SUCCESS;
+}
+
+/* The original, serial variant of label propagation, alternating between
+ * iterations that update the labels in a random order and iterations that
+ * check whether the label of each vertex is dominant in its neighborhood.
+ * Labels are shifted by one, as in igraph_i_community_label_propagation(). */
+static igraph_error_t igraph_i_label_propagation_serial(
+        const igraph_t *graph, igraph_vector_int_t *membership,
+        igraph_neimode_t mode, const igraph_vector_t *weights,
+        igraph_vector_int_t *node_order) {
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t no_of_not_fixed_nodes = igraph_vector_int_size(node_order);
+    igraph_integer_t i, j, k;
+    igraph_adjlist_t al;
+    igraph_inclist_t il;
+    igraph_bool_t running, control_iteration;
+    igraph_neimode_t reversed_mode = IGRAPH_REVERSE_MODE(mode);
+    int iter = 0; /* interruption counter */
+
+    igraph_vector_t label_counters; /* real type, stores weight sums */
+    igraph_vector_int_t dominant_labels, nonzero_labels;
+
+    /* Create an adjacency/incidence list representation for efficiency.
+     * For the unweighted case, the adjacency list is enough. For the
+     * weighted case, we need the incidence list */
+    if (weights) {
+        IGRAPH_CHECK(igraph_inclist_init(graph, &il, reversed_mode, IGRAPH_LOOPS_ONCE));
+        IGRAPH_FINALLY(igraph_inclist_destroy, &il);
+    } else {
+        IGRAPH_CHECK(igraph_adjlist_init(graph, &al, reversed_mode, IGRAPH_LOOPS_ONCE, IGRAPH_MULTIPLE));
+        IGRAPH_FINALLY(igraph_adjlist_destroy, &al);
+    }
+
+    /* Create storage space for counting distinct labels and dominant ones */
+    IGRAPH_VECTOR_INIT_FINALLY(&label_counters, no_of_nodes + 1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&dominant_labels, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&nonzero_labels, 0);
+    IGRAPH_CHECK(igraph_vector_int_reserve(&dominant_labels, 2));
+
+    /* There are two alternating types of iterations, one for changing labels and
+    the other one for checking the end condition - every vertex in the graph has
+    a label to which the maximum number of its neighbors belongs. If control_iteration
+    is true, we are just checking the end condition and not relabeling nodes. */
+    control_iteration = true;
+    running = true;
+    while (running) {
+        igraph_integer_t v1, num_neis;
+        igraph_real_t max_count;
+        igraph_vector_int_t *neis;
+        igraph_vector_int_t *ineis;
+        igraph_bool_t was_zero;
+
+        IGRAPH_ALLOW_INTERRUPTION_LIMITED(iter, 1 << 8);
+
+        if (control_iteration) {
+            /* If we are in the control iteration, we expect in the beginning of
+            the iteration that all vertices meet the end condition, so 'running' is false.
+            If some of them does not, 'running' is set to true later in the code. */
+            running = false;
+        } else {
+            /* Shuffle the node ordering vector if we are in the label updating iteration */
+            IGRAPH_CHECK(igraph_vector_int_shuffle(node_order));
+        }
+
+        RNG_BEGIN();
+        /* In the prescribed order, loop over the vertices and reassign labels */
+        for (i = 0; i < no_of_not_fixed_nodes; i++) {
+            v1 = VECTOR(*node_order)[i];
+
+            /* Count the weights corresponding to different labels */
+            igraph_vector_int_clear(&dominant_labels);
+            igraph_vector_int_clear(&nonzero_labels);
+            max_count = 0.0;
+            if (weights) {
+                ineis = igraph_inclist_get(&il, v1);
+                num_neis = igraph_vector_int_size(ineis);
+                for (j = 0; j < num_neis; j++) {
+                    k = VECTOR(*membership)[IGRAPH_OTHER(graph, VECTOR(*ineis)[j], v1)];
+                    if (k == 0) {
+                        continue;    /* skip if it has no label yet */
+                    }
+                    was_zero = (VECTOR(label_counters)[k] == 0);
+                    VECTOR(label_counters)[k] += VECTOR(*weights)[VECTOR(*ineis)[j]];
+                    if (was_zero && VECTOR(label_counters)[k] != 0) {
+                        /* counter just became nonzero */
+                        IGRAPH_CHECK(igraph_vector_int_push_back(&nonzero_labels, k));
+                    }
+                    if (max_count < VECTOR(label_counters)[k]) {
+                        max_count = VECTOR(label_counters)[k];
+                        IGRAPH_CHECK(igraph_vector_int_resize(&dominant_labels, 1));
+                        VECTOR(dominant_labels)[0] = k;
+                    } else if (max_count == VECTOR(label_counters)[k]) {
+                        IGRAPH_CHECK(igraph_vector_int_push_back(&dominant_labels, k));
+                    }
+                }
+            } else {
+                neis = igraph_adjlist_get(&al, v1);
+                num_neis = igraph_vector_int_size(neis);
+                for (j = 0; j < num_neis; j++) {
+                    k = VECTOR(*membership)[VECTOR(*neis)[j]];
+                    if (k == 0) {
+                        continue;    /* skip if it has no label yet */
+                    }
+                    VECTOR(label_counters)[k]++;
+                    if (VECTOR(label_counters)[k] == 1) {
+                        /* counter just became nonzero */
+                        IGRAPH_CHECK(igraph_vector_int_push_back(&nonzero_labels, k));
+                    }
+                    if (max_count < VECTOR(label_counters)[k]) {
+                        max_count = VECTOR(label_counters)[k];
+                        IGRAPH_CHECK(igraph_vector_int_resize(&dominant_labels, 1));
+                        VECTOR(dominant_labels)[0] = k;
+                    } else if (max_count == VECTOR(label_counters)[k]) {
+                        IGRAPH_CHECK(igraph_vector_int_push_back(&dominant_labels, k));
+                    }
+                }
+            }
+
+            if (igraph_vector_int_size(&dominant_labels) > 0) {
+                if (control_iteration) {
+                    /* Check if the _current_ label of the node is also dominant */
+                    if (VECTOR(label_counters)[VECTOR(*membership)[v1]] != max_count) {
+                        /* Nope, we need at least one more iteration */
+                        running = true;
+                    }
+                }
+                else {
+                    /* Select randomly from the dominant labels */
+                    k = RNG_INTEGER(0, igraph_vector_int_size(&dominant_labels) - 1);
+                    VECTOR(*membership)[v1] = VECTOR(dominant_labels)[k];
+                }
+            }
+
+            /* Clear the nonzero elements in label_counters */
+            num_neis = igraph_vector_int_size(&nonzero_labels);
+            for (j = 0; j < num_neis; j++) {
+                VECTOR(label_counters)[VECTOR(nonzero_labels)[j]] = 0;
+            }
+        }
+        RNG_END();
+
+        /* Alternating between control iterations and label updating iterations */
+        control_iteration = !control_iteration;
+    }
+
+    igraph_vector_int_destroy(&nonzero_labels);
+    igraph_vector_int_destroy(&dominant_labels);
+    igraph_vector_destroy(&label_counters);
+    if (weights) {
+        igraph_inclist_destroy(&il);
+    } else {
+        igraph_adjlist_destroy(&al);
+    }
+    IGRAPH_FINALLY_CLEAN(4);
+
+    return IGRAPH_SUCCESS;
+}
+
 /**
  * \ingroup communities
  * \function igraph_community_label_propagation
@@ -54,6 +570,16 @@
  * if you are aware of the consequences.
  *
  * </para><para>
+ * When igraph is compiled with OpenMP and more than one thread is available,
+ * graphs with many edges are processed in parallel. The labels are updated
+ * concurrently in rounds. In the first round all vertices are updated, later
+ * only those which have a neighbor whose label changed in the previous
+ * round. In this variant, a vertex keeps its label when it is one of the
+ * dominant labels among its neighbors. The result depends on the scheduling
+ * of the threads, therefore it is not reproducible even with a fixed random
+ * seed.
+ *
+ * </para><para>
  * References:
  *
  * </para><para>
@@ -117,19 +643,30 @@ igraph_error_t igraph_community_label_propagation(const igraph_t *graph,
                                        const igraph_vector_t *weights,
                                        const igraph_vector_int_t *initial,
                                        const igraph_vector_bool_t *fixed) {
+    igraph_integer_t parallel_min_edges = -1;
+
+#ifdef _OPENMP
+    if (omp_get_max_threads() > 1) {
+        parallel_min_edges = IGRAPH_I_LABEL_PROPAGATION_PARALLEL_MIN_EDGES;
+    }
+#endif
+
+    return igraph_i_community_label_propagation(graph, membership, mode, weights,
+                                                initial, fixed, parallel_min_edges);
+}
+
+igraph_error_t igraph_i_community_label_propagation(
+        const igraph_t *graph, igraph_vector_int_t *membership,
+        igraph_neimode_t mode, const igraph_vector_t *weights,
+        const igraph_vector_int_t *initial, const igraph_vector_bool_t *fixed,
+        igraph_integer_t parallel_min_edges) {
     igraph_integer_t no_of_nodes = igraph_vcount(graph);
     igraph_integer_t no_of_edges = igraph_ecount(graph);
     igraph_integer_t no_of_not_fixed_nodes = no_of_nodes;
     igraph_integer_t i, j, k;
-    igraph_adjlist_t al;
-    igraph_inclist_t il;
-    igraph_bool_t running, control_iteration;
     igraph_bool_t unlabelled_left;
-    igraph_neimode_t reversed_mode;
-    int iter = 0; /* interruption counter */
 
-    igraph_vector_t label_counters; /* real type, stores weight sums */
-    igraph_vector_int_t dominant_labels, nonzero_labels, node_order;
+    igraph_vector_int_t label_map, node_order;
 
     /* We make a copy of 'fixed' as a pointer into 'fixed_copy' after casting
      * away the constness, and promise ourselves that we will make a proper
@@ -215,27 +752,8 @@ igraph_error_t igraph_community_label_propagation(const igraph_t *graph,
         }
     }
 
-    reversed_mode = IGRAPH_REVERSE_MODE(mode);
-
     /* From this point onwards we use 'fixed_copy' instead of 'fixed' */
 
-    /* Create an adjacency/incidence list representation for efficiency.
-     * For the unweighted case, the adjacency list is enough. For the
-     * weighted case, we need the incidence list */
-    if (weights) {
-        IGRAPH_CHECK(igraph_inclist_init(graph, &il, reversed_mode, IGRAPH_LOOPS_ONCE));
-        IGRAPH_FINALLY(igraph_inclist_destroy, &il);
-    } else {
-        IGRAPH_CHECK(igraph_adjlist_init(graph, &al, reversed_mode, IGRAPH_LOOPS_ONCE, IGRAPH_MULTIPLE));
-        IGRAPH_FINALLY(igraph_adjlist_destroy, &al);
-    }
-
-    /* Create storage space for counting distinct labels and dominant ones */
-    IGRAPH_VECTOR_INIT_FINALLY(&label_counters, no_of_nodes + 1);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&dominant_labels, 0);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&nonzero_labels, 0);
-    IGRAPH_CHECK(igraph_vector_int_reserve(&dominant_labels, 2));
-
     /* Initialize node ordering vector with only the not fixed nodes */
     if (fixed_copy) {
         IGRAPH_VECTOR_INT_INIT_FINALLY(&node_order, no_of_not_fixed_nodes);
@@ -250,134 +768,29 @@ igraph_error_t igraph_community_label_propagation(const igraph_t *graph,
         IGRAPH_FINALLY(igraph_vector_int_destroy, &node_order);
     }
 
-    /* There are two alternating types of iterations, one for changing labels and
-    the other one for checking the end condition - every vertex in the graph has
-    a label to which the maximum number of its neighbors belongs. If control_iteration
-    is true, we are just checking the end condition and not relabeling nodes. */
-    control_iteration = true;
-    running = true;
-    while (running) {
-        igraph_integer_t v1, num_neis;
-        igraph_real_t max_count;
-        igraph_vector_int_t *neis;
-        igraph_vector_int_t *ineis;
-        igraph_bool_t was_zero;
-
-        IGRAPH_ALLOW_INTERRUPTION_LIMITED(iter, 1 << 8);
-
-        if (control_iteration) {
-            /* If we are in the control iteration, we expect in the beginning of
-            the iteration that all vertices meet the end condition, so 'running' is false.
-            If some of them does not, 'running' is set to true later in the code. */
-            running = false;
-        } else {
-            /* Shuffle the node ordering vector if we are in the label updating iteration */
-            IGRAPH_CHECK(igraph_vector_int_shuffle(&node_order));
-        }
-
-        RNG_BEGIN();
-        /* In the prescribed order, loop over the vertices and reassign labels */
-        for (i = 0; i < no_of_not_fixed_nodes; i++) {
-            v1 = VECTOR(node_order)[i];
-
-            /* Count the weights corresponding to different labels */
-            igraph_vector_int_clear(&dominant_labels);
-            igraph_vector_int_clear(&nonzero_labels);
-            max_count = 0.0;
-            if (weights) {
-                ineis = igraph_inclist_get(&il, v1);
-                num_neis = igraph_vector_int_size(ineis);
-                for (j = 0; j < num_neis; j++) {
-                    k = VECTOR(*membership)[IGRAPH_OTHER(graph, VECTOR(*ineis)[j], v1)];
-                    if (k == 0) {
-                        continue;    /* skip if it has no label yet */
-                    }
-                    was_zero = (VECTOR(label_counters)[k] == 0);
-                    VECTOR(label_counters)[k] += VECTOR(*weights)[VECTOR(*ineis)[j]];
-                    if (was_zero && VECTOR(label_counters)[k] != 0) {
-                        /* counter just became nonzero */
-                        IGRAPH_CHECK(igraph_vector_int_push_back(&nonzero_labels, k));
-                    }
-                    if (max_count < VECTOR(label_counters)[k]) {
-                        max_count = VECTOR(label_counters)[k];
-                        IGRAPH_CHECK(igraph_vector_int_resize(&dominant_labels, 1));
-                        VECTOR(dominant_labels)[0] = k;
-                    } else if (max_count == VECTOR(label_counters)[k]) {
-                        IGRAPH_CHECK(igraph_vector_int_push_back(&dominant_labels, k));
-                    }
-                }
-            } else {
-                neis = igraph_adjlist_get(&al, v1);
-                num_neis = igraph_vector_int_size(neis);
-                for (j = 0; j < num_neis; j++) {
-                    k = VECTOR(*membership)[VECTOR(*neis)[j]];
-                    if (k == 0) {
-                        continue;    /* skip if it has no label yet */
-                    }
-                    VECTOR(label_counters)[k]++;
-                    if (VECTOR(label_counters)[k] == 1) {
-                        /* counter just became nonzero */
-                        IGRAPH_CHECK(igraph_vector_int_push_back(&nonzero_labels, k));
-                    }
-                    if (max_count < VECTOR(label_counters)[k]) {
-                        max_count = VECTOR(label_counters)[k];
-                        IGRAPH_CHECK(igraph_vector_int_resize(&dominant_labels, 1));
-                        VECTOR(dominant_labels)[0] = k;
-                    } else if (max_count == VECTOR(label_counters)[k]) {
-                        IGRAPH_CHECK(igraph_vector_int_push_back(&dominant_labels, k));
-                    }
-                }
-            }
-
-            if (igraph_vector_int_size(&dominant_labels) > 0) {
-                if (control_iteration) {
-                    /* Check if the _current_ label of the node is also dominant */
-                    if (VECTOR(label_counters)[VECTOR(*membership)[v1]] != max_count) {
-                        /* Nope, we need at least one more iteration */
-                        running = true;
-                    }
-                }
-                else {
-                    /* Select randomly from the dominant labels */
-                    k = RNG_INTEGER(0, igraph_vector_int_size(&dominant_labels) - 1);
-                    VECTOR(*membership)[v1] = VECTOR(dominant_labels)[k];
-                }
-            }
-
-            /* Clear the nonzero elements in label_counters */
-            num_neis = igraph_vector_int_size(&nonzero_labels);
-            for (j = 0; j < num_neis; j++) {
-                VECTOR(label_counters)[VECTOR(nonzero_labels)[j]] = 0;
-            }
-        }
-        RNG_END();
-
-        /* Alternating between control iterations and label updating iterations */
-        control_iteration = !control_iteration;
-    }
-
-    if (weights) {
-        igraph_inclist_destroy(&il);
+    if (parallel_min_edges >= 0 && no_of_edges >= parallel_min_edges) {
+        IGRAPH_CHECK(igraph_i_label_propagation_parallel(graph, membership, mode, weights,
+                                                         fixed_copy, &node_order));
     } else {
-        igraph_adjlist_destroy(&al);
+        IGRAPH_CHECK(igraph_i_label_propagation_serial(graph, membership, mode, weights,
+                                                       &node_order));
     }
-    IGRAPH_FINALLY_CLEAN(1);
 
     /* Shift back the membership vector, permute labels in increasing order */
-    /* We recycle label_counters here :) and use it as an integer vector from now on */
-    igraph_vector_fill(&label_counters, -1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&label_map, no_of_nodes + 1);
+    igraph_vector_int_fill(&label_map, -1);
     j = 0;
     unlabelled_left = false;
     for (i = 0; i < no_of_nodes; i++) {
         k = VECTOR(*membership)[i] - 1;
         if (k >= 0) {
-            if (VECTOR(label_counters)[k] == -1) {
+            if (VECTOR(label_map)[k] == -1) {
                 /* We have seen this label for the first time */
-                VECTOR(label_counters)[k] = j;
+                VECTOR(label_map)[k] = j;
                 k = j;
                 j++;
             } else {
-                k = (igraph_integer_t) VECTOR(label_counters)[k];
+                k = VECTOR(label_map)[k];
             }
         } else {
             /* This is an unlabeled vertex */
@@ -443,11 +856,9 @@ igraph_error_t igraph_community_label_propagation(const igraph_t *graph,
         IGRAPH_FINALLY_CLEAN(2);
     }
 
+    igraph_vector_int_destroy(&label_map);
     igraph_vector_int_destroy(&node_order);
-    igraph_vector_destroy(&label_counters);
-    igraph_vector_int_destroy(&dominant_labels);
-    igraph_vector_int_destroy(&nonzero_labels);
-    IGRAPH_FINALLY_CLEAN(4);
+    IGRAPH_FINALLY_CLEAN(2);
 
     if (fixed != fixed_copy) {
         igraph_vector_bool_destroy(fixed_copy);
@@ -0,0 +1,44 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IGRAPH_COMMUNITY_LABEL_PROPAGATION_H
+#define IGRAPH_COMMUNITY_LABEL_PROPAGATION_H
+
+#include "igraph_decls.h"
+#include "igraph_datatype.h"
+#include "igraph_vector.h"
+
+__BEGIN_DECLS
+
+/* igraph_community_label_propagation() uses the parallel variant of the
+ * algorithm on graphs with at least this many edges, when igraph is compiled
+ * with OpenMP and more than one thread is available. */
+#define IGRAPH_I_LABEL_PROPAGATION_PARALLEL_MIN_EDGES 100000
+
+/* Same as igraph_community_label_propagation(), but the parallel variant is
+ * used on graphs with at least 'parallel_min_edges' edges, also when there
+ * is only one thread. A negative value disables the parallel variant. */
+IGRAPH_PRIVATE_EXPORT igraph_error_t igraph_i_community_label_propagation(
+        const igraph_t *graph, igraph_vector_int_t *membership,
+        igraph_neimode_t mode, const igraph_vector_t *weights,
+        const igraph_vector_int_t *initial, const igraph_vector_bool_t *fixed,
+        igraph_integer_t parallel_min_edges);
+
+__END_DECLS
+
+#endif
@@ -33,9 +33,119 @@
 #include "igraph_random.h"
 #include "igraph_stack.h"
 #include "igraph_vector.h"
+#include "igraph_threading.h"
 #include "igraph_vector_list.h"
 
+#include "community/leiden.h"
 #include "core/interruption.h"
+#include "core/workspace.h"
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Number of nodes whose moves are evaluated together in the parallel local
+ * moving phase, and number of nodes per block of parallel work. The batch
+ * size does not depend on the number of threads, so that the result does
+ * not depend on it either. */
+#define IGRAPH_I_LEIDEN_BATCH_SIZE 4096
+#define IGRAPH_I_LEIDEN_BLOCK_SIZE 64
+
+/* Resources for the parallel variant of the algorithm. Each thread has its
+ * own workspace and random number generator. */
+typedef struct {
+    igraph_integer_t no_of_threads;
+    igraph_integer_t min_edges;
+    igraph_workspace_t *ws;
+    igraph_rng_t *rng;
+    igraph_vector_int_t errors;
+} igraph_i_leiden_parallel_t;
+
+static void igraph_i_leiden_parallel_destroy(igraph_i_leiden_parallel_t *par) {
+    for (igraph_integer_t t = 0; t < par->no_of_threads; t++) {
+        igraph_rng_destroy(&par->rng[t]);
+        igraph_workspace_destroy(&par->ws[t]);
+    }
+    IGRAPH_FREE(par->rng);
+    IGRAPH_FREE(par->ws);
+    igraph_vector_int_destroy(&par->errors);
+}
+
+static igraph_error_t igraph_i_leiden_parallel_init(igraph_i_leiden_parallel_t *par,
+                                                    igraph_integer_t min_edges) {
+    igraph_integer_t no_of_threads = 1;
+
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+    no_of_threads = omp_get_max_threads();
+#endif
+
+    par->no_of_threads = 0;
+    par->min_edges = min_edges;
+    par->ws = NULL;
+    par->rng = NULL;
+    IGRAPH_CHECK(igraph_vector_int_init(&par->errors, 0));
+    IGRAPH_FINALLY(igraph_i_leiden_parallel_destroy, par);
+
+    par->ws = IGRAPH_CALLOC(no_of_threads, igraph_workspace_t);
+    IGRAPH_CHECK_OOM(par->ws, "Insufficient memory for parallel Leiden algorithm.");
+    par->rng = IGRAPH_CALLOC(no_of_threads, igraph_rng_t);
+    IGRAPH_CHECK_OOM(par->rng, "Insufficient memory for parallel Leiden algorithm.");
+
+    for (igraph_integer_t t = 0; t < no_of_threads; t++) {
+        IGRAPH_CHECK(igraph_workspace_init(&par->ws[t]));
+        IGRAPH_FINALLY(igraph_workspace_destroy, &par->ws[t]);
+        IGRAPH_CHECK(igraph_rng_init(&par->rng[t], &igraph_rngtype_pcg32));
+        IGRAPH_FINALLY_CLEAN(1);
+        par->no_of_threads++;
+    }
+
+    IGRAPH_FINALLY_CLEAN(1);
+    return IGRAPH_SUCCESS;
+}
+
+typedef igraph_error_t igraph_i_leiden_block_func_t(void *data, igraph_integer_t thread, igraph_integer_t block);
+
+/* Calls 'func' for each block, in parallel when igraph is compiled with
+ * OpenMP and in thread-safe mode, so that the error handler and the finally
+ * stack are thread-local. 'thread' identifies the workspace and random
+ * number generator that the block may use. Errors in the blocks are
+ * re-raised by the calling thread. */
+static igraph_error_t igraph_i_leiden_parallel_run(igraph_i_leiden_parallel_t *par,
+                                                   igraph_i_leiden_block_func_t *func, void *data,
+                                                   igraph_integer_t no_of_blocks) {
+    IGRAPH_CHECK(igraph_vector_int_resize(&par->errors, no_of_blocks));
+
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+#pragma omp parallel for schedule(dynamic, 1) num_threads(par->no_of_threads) if (no_of_blocks > 1)
+#endif
+    for (igraph_integer_t block = 0; block < no_of_blocks; block++) {
+        /* Errors are recorded and re-raised by the calling thread. */
+        igraph_error_handler_t *handler = igraph_set_error_handler(igraph_error_handler_ignore);
+        igraph_integer_t thread = 0;
+        igraph_error_t err;
+
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+        thread = omp_get_thread_num();
+#endif
+
+        IGRAPH_FINALLY_ENTER();
+        err = func(data, thread, block);
+        if (err != IGRAPH_SUCCESS) {
+            IGRAPH_FINALLY_FREE();
+        }
+        IGRAPH_FINALLY_EXIT();
+        igraph_set_error_handler(handler);
+        VECTOR(par->errors)[block] = err;
+    }
+
+    for (igraph_integer_t block = 0; block < no_of_blocks; block++) {
+        if (VECTOR(par->errors)[block] != IGRAPH_SUCCESS) {
+            IGRAPH_ERROR("Parallel Leiden algorithm failed.", VECTOR(par->errors)[block]);
+        }
+    }
+
+    return IGRAPH_SUCCESS;
+}
 
 /* Move nodes in order to improve the quality of a partition.
  *
@@ -49,7 +159,7 @@
  * the cluster the node was moved to) are pushed to the queue again.
  *
  * The \c membership vector is used as the starting point to move around nodes,
- * and is updated in-place.
+ * and is updated in-place. Temporary buffers are taken from \c ws.
  *
  */
 static igraph_error_t igraph_i_community_leiden_fastmovenodes(
@@ -59,58 +169,64 @@ static igraph_error_t igraph_i_community_leiden_fastmovenodes(
         const igraph_real_t resolution_parameter,
         igraph_integer_t *nb_clusters,
         igraph_vector_int_t *membership,
-        igraph_bool_t *changed) {
+        igraph_bool_t *changed,
+        igraph_workspace_t *ws) {
 
     igraph_dqueue_int_t unstable_nodes;
     igraph_real_t max_diff = 0.0, diff = 0.0;
     const igraph_integer_t n = igraph_vcount(graph);
-    igraph_bitset_t neighbor_cluster_added, node_is_stable;
-    igraph_vector_t cluster_weights, edge_weights_per_cluster;
-    igraph_vector_int_t neighbor_clusters;
-    igraph_vector_int_t node_order;
-    igraph_vector_int_t nb_nodes_per_cluster;
+    igraph_bitset_t *neighbor_cluster_added, *node_is_stable;
+    igraph_vector_t *cluster_weights, *edge_weights_per_cluster;
+    igraph_vector_int_t *neighbor_clusters;
+    igraph_vector_int_t *node_order;
+    igraph_vector_int_t *nb_nodes_per_cluster;
     igraph_stack_int_t empty_clusters;
     igraph_integer_t c, nb_neigh_clusters;
+    igraph_i_workspace_mark_t mark;
     int iter = 0;
 
+    igraph_i_workspace_mark(ws, &mark);
+
     /* Initialize queue of unstable nodes and whether node is stable. Only
      * unstable nodes are in the queue. */
-    IGRAPH_BITSET_INIT_FINALLY(&node_is_stable, n);
+    IGRAPH_CHECK(igraph_i_workspace_bitset(ws, n, &node_is_stable));
 
     IGRAPH_DQUEUE_INT_INIT_FINALLY(&unstable_nodes, n);
 
     /* Shuffle nodes */
-    IGRAPH_CHECK(igraph_vector_int_init_range(&node_order, 0, n));
-    IGRAPH_FINALLY(igraph_vector_int_destroy, &node_order);
-    IGRAPH_CHECK(igraph_vector_int_shuffle(&node_order));
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, n, &node_order));
+    for (igraph_integer_t i = 0; i < n; i++) {
+        VECTOR(*node_order)[i] = i;
+    }
+    IGRAPH_CHECK(igraph_vector_int_shuffle(node_order));
 
     /* Add to the queue */
     for (igraph_integer_t i = 0; i < n; i++) {
-        IGRAPH_CHECK(igraph_dqueue_int_push(&unstable_nodes, VECTOR(node_order)[i]));
+        IGRAPH_CHECK(igraph_dqueue_int_push(&unstable_nodes, VECTOR(*node_order)[i]));
     }
 
     /* Initialize cluster weights and nb nodes */
-    IGRAPH_VECTOR_INIT_FINALLY(&cluster_weights, n);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&nb_nodes_per_cluster, n);
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, n, &cluster_weights));
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, n, &nb_nodes_per_cluster));
     for (igraph_integer_t i = 0; i < n; i++) {
         c = VECTOR(*membership)[i];
-        VECTOR(cluster_weights)[c] += VECTOR(*node_weights)[i];
-        VECTOR(nb_nodes_per_cluster)[c] += 1;
+        VECTOR(*cluster_weights)[c] += VECTOR(*node_weights)[i];
+        VECTOR(*nb_nodes_per_cluster)[c] += 1;
     }
 
     /* Initialize empty clusters */
     IGRAPH_STACK_INT_INIT_FINALLY(&empty_clusters, n);
     for (c = 0; c < n; c++)
-        if (VECTOR(nb_nodes_per_cluster)[c] == 0) {
+        if (VECTOR(*nb_nodes_per_cluster)[c] == 0) {
             IGRAPH_CHECK(igraph_stack_int_push(&empty_clusters, c));
         }
 
     /* Initialize vectors to be used in calculating differences */
-    IGRAPH_VECTOR_INIT_FINALLY(&edge_weights_per_cluster, n);
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, n, &edge_weights_per_cluster));
 
     /* Initialize neighboring cluster */
-    IGRAPH_BITSET_INIT_FINALLY(&neighbor_cluster_added, n);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&neighbor_clusters, n);
+    IGRAPH_CHECK(igraph_i_workspace_bitset(ws, n, &neighbor_cluster_added));
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, n, &neighbor_clusters));
 
     /* Iterate while the queue is not empty */
     while (!igraph_dqueue_int_empty(&unstable_nodes)) {
@@ -120,16 +236,16 @@ static igraph_error_t igraph_i_community_leiden_fastmovenodes(
         igraph_vector_int_t *edges;
 
         /* Remove node from current cluster */
-        VECTOR(cluster_weights)[current_cluster] -= VECTOR(*node_weights)[v];
-        VECTOR(nb_nodes_per_cluster)[current_cluster]--;
-        if (VECTOR(nb_nodes_per_cluster)[current_cluster] == 0) {
+        VECTOR(*cluster_weights)[current_cluster] -= VECTOR(*node_weights)[v];
+        VECTOR(*nb_nodes_per_cluster)[current_cluster]--;
+        if (VECTOR(*nb_nodes_per_cluster)[current_cluster] == 0) {
             IGRAPH_CHECK(igraph_stack_int_push(&empty_clusters, current_cluster));
         }
 
         /* Find out neighboring clusters */
         c = igraph_stack_int_top(&empty_clusters);
-        VECTOR(neighbor_clusters)[0] = c;
-        IGRAPH_BIT_SET(neighbor_cluster_added, c);
+        VECTOR(*neighbor_clusters)[0] = c;
+        IGRAPH_BIT_SET(*neighbor_cluster_added, c);
         nb_neigh_clusters = 1;
 
         /* Determine the edge weight to each neighboring cluster */
@@ -140,20 +256,20 @@ static igraph_error_t igraph_i_community_leiden_fastmovenodes(
             igraph_integer_t u = IGRAPH_OTHER(graph, e, v);
             if (u != v) {
                 c = VECTOR(*membership)[u];
-                if (!IGRAPH_BIT_TEST(neighbor_cluster_added, c)) {
-                    IGRAPH_BIT_SET(neighbor_cluster_added, c);
-                    VECTOR(neighbor_clusters)[nb_neigh_clusters++] = c;
+                if (!IGRAPH_BIT_TEST(*neighbor_cluster_added, c)) {
+                    IGRAPH_BIT_SET(*neighbor_cluster_added, c);
+                    VECTOR(*neighbor_clusters)[nb_neigh_clusters++] = c;
                 }
-                VECTOR(edge_weights_per_cluster)[c] += VECTOR(*edge_weights)[e];
+                VECTOR(*edge_weights_per_cluster)[c] += VECTOR(*edge_weights)[e];
             }
         }
 
         /* Calculate maximum diff */
         best_cluster = current_cluster;
-        max_diff = VECTOR(edge_weights_per_cluster)[current_cluster] - VECTOR(*node_weights)[v] * VECTOR(cluster_weights)[current_cluster] * resolution_parameter;
+        max_diff = VECTOR(*edge_weights_per_cluster)[current_cluster] - VECTOR(*node_weights)[v] * VECTOR(*cluster_weights)[current_cluster] * resolution_parameter;
         for (igraph_integer_t i = 0; i < nb_neigh_clusters; i++) {
-            c = VECTOR(neighbor_clusters)[i];
-            diff = VECTOR(edge_weights_per_cluster)[c] - VECTOR(*node_weights)[v] * VECTOR(cluster_weights)[c] * resolution_parameter;
+            c = VECTOR(*neighbor_clusters)[i];
+            diff = VECTOR(*edge_weights_per_cluster)[c] - VECTOR(*node_weights)[v] * VECTOR(*cluster_weights)[c] * resolution_parameter;
             /* Only consider strictly improving moves.
              * Note that this is important in considering convergence.
              */
@@ -161,19 +277,19 @@ static igraph_error_t igraph_i_community_leiden_fastmovenodes(
                 best_cluster = c;
                 max_diff = diff;
             }
-            VECTOR(edge_weights_per_cluster)[c] = 0.0;
-            IGRAPH_BIT_CLEAR(neighbor_cluster_added, c);
+            VECTOR(*edge_weights_per_cluster)[c] = 0.0;
+            IGRAPH_BIT_CLEAR(*neighbor_cluster_added, c);
         }
 
         /* Move node to best cluster */
-        VECTOR(cluster_weights)[best_cluster] += VECTOR(*node_weights)[v];
-        VECTOR(nb_nodes_per_cluster)[best_cluster]++;
+        VECTOR(*cluster_weights)[best_cluster] += VECTOR(*node_weights)[v];
+        VECTOR(*nb_nodes_per_cluster)[best_cluster]++;
         if (best_cluster == igraph_stack_int_top(&empty_clusters)) {
             igraph_stack_int_pop(&empty_clusters);
         }
 
         /* Mark node as stable */
-        IGRAPH_BIT_SET(node_is_stable, v);
+        IGRAPH_BIT_SET(*node_is_stable, v);
 
         /* Add stable neighbours that are not part of the new cluster to the queue */
         if (best_cluster != current_cluster) {
@@ -183,9 +299,9 @@ static igraph_error_t igraph_i_community_leiden_fastmovenodes(
             for (igraph_integer_t i = 0; i < degree; i++) {
                 igraph_integer_t e = VECTOR(*edges)[i];
                 igraph_integer_t u = IGRAPH_OTHER(graph, e, v);
-                if (IGRAPH_BIT_TEST(node_is_stable, u) && VECTOR(*membership)[u] != best_cluster) {
+                if (IGRAPH_BIT_TEST(*node_is_stable, u) && VECTOR(*membership)[u] != best_cluster) {
                     IGRAPH_CHECK(igraph_dqueue_int_push(&unstable_nodes, u));
-                    IGRAPH_BIT_CLEAR(node_is_stable, u);
+                    IGRAPH_BIT_CLEAR(*node_is_stable, u);
                 }
             }
         }
@@ -195,16 +311,330 @@ static igraph_error_t igraph_i_community_leiden_fastmovenodes(
 
     IGRAPH_CHECK(igraph_reindex_membership(membership, NULL, nb_clusters));
 
-    igraph_vector_int_destroy(&neighbor_clusters);
-    igraph_bitset_destroy(&neighbor_cluster_added);
-    igraph_vector_destroy(&edge_weights_per_cluster);
     igraph_stack_int_destroy(&empty_clusters);
-    igraph_vector_int_destroy(&nb_nodes_per_cluster);
-    igraph_vector_destroy(&cluster_weights);
-    igraph_vector_int_destroy(&node_order);
     igraph_dqueue_int_destroy(&unstable_nodes);
-    igraph_bitset_destroy(&node_is_stable);
-    IGRAPH_FINALLY_CLEAN(9);
+    IGRAPH_FINALLY_CLEAN(2);
+
+    igraph_i_workspace_release(ws, &mark);
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Buffers of one thread for collecting the edge weights from a node, or a
+ * cluster, to the neighboring clusters. */
+typedef struct {
+    igraph_vector_t *edge_weights_per_cluster;
+    igraph_bitset_t *neighbor_cluster_added;
+    igraph_vector_int_t *neighbor_clusters;
+} igraph_i_leiden_buffers_t;
+
+/* Takes the buffers of each thread, for 'size' clusters, from the thread
+ * workspaces. */
+static igraph_error_t igraph_i_leiden_parallel_buffers(igraph_i_leiden_parallel_t *par,
+                                                       igraph_integer_t size,
+                                                       igraph_i_leiden_buffers_t *buffers) {
+    for (igraph_integer_t t = 0; t < par->no_of_threads; t++) {
+        igraph_i_workspace_reset(&par->ws[t]);
+        IGRAPH_CHECK(igraph_i_workspace_vector(&par->ws[t], size, &buffers[t].edge_weights_per_cluster));
+        IGRAPH_CHECK(igraph_i_workspace_bitset(&par->ws[t], size, &buffers[t].neighbor_cluster_added));
+        IGRAPH_CHECK(igraph_i_workspace_vector_int(&par->ws[t], size, &buffers[t].neighbor_clusters));
+    }
+    return IGRAPH_SUCCESS;
+}
+
+/* Data of the parallel local moving phase. For the i-th node of the current
+ * batch, the best cluster is stored in target[i], or -1 if it is an empty
+ * cluster, and the edge weights from the node to its current cluster and to
+ * the best cluster are stored in weight_current[i] and weight_target[i]. */
+typedef struct {
+    const igraph_t *graph;
+    const igraph_inclist_t *edges_per_node;
+    const igraph_vector_t *edge_weights;
+    const igraph_vector_t *node_weights;
+    igraph_real_t resolution_parameter;
+    const igraph_vector_int_t *membership;
+    const igraph_vector_t *cluster_weights;
+    const igraph_vector_int_t *nb_nodes_per_cluster;
+    const igraph_vector_int_t *batch;
+    igraph_vector_int_t *target;
+    igraph_vector_t *weight_current;
+    igraph_vector_t *weight_target;
+    igraph_i_leiden_buffers_t *buffers;
+} igraph_i_leiden_fastmove_t;
+
+/* Finds the best cluster for each node in a block of the current batch. The
+ * partition is not modified, so blocks can be processed concurrently. The
+ * comparisons are the same as in igraph_i_community_leiden_fastmovenodes(). */
+static igraph_error_t igraph_i_community_leiden_best_moves(void *data, igraph_integer_t thread, igraph_integer_t block) {
+    const igraph_i_leiden_fastmove_t *fm = data;
+    const igraph_i_leiden_buffers_t *buf = &fm->buffers[thread];
+    const igraph_integer_t batch_size = igraph_vector_int_size(fm->batch);
+    igraph_integer_t end = (block + 1) * IGRAPH_I_LEIDEN_BLOCK_SIZE;
+
+    if (end > batch_size) {
+        end = batch_size;
+    }
+
+    for (igraph_integer_t i = block * IGRAPH_I_LEIDEN_BLOCK_SIZE; i < end; i++) {
+        igraph_integer_t v = VECTOR(*fm->batch)[i];
+        igraph_integer_t best_cluster, current_cluster = VECTOR(*fm->membership)[v];
+        igraph_real_t node_weight = VECTOR(*fm->node_weights)[v];
+        igraph_real_t max_diff, diff;
+        igraph_vector_int_t *edges = igraph_inclist_get(fm->edges_per_node, v);
+        igraph_integer_t degree = igraph_vector_int_size(edges);
+        igraph_integer_t nb_neigh_clusters = 0;
+
+        /* Determine the edge weight to each neighboring cluster */
+        for (igraph_integer_t j = 0; j < degree; j++) {
+            igraph_integer_t e = VECTOR(*edges)[j];
+            igraph_integer_t u = IGRAPH_OTHER(fm->graph, e, v);
+            if (u != v) {
+                igraph_integer_t c = VECTOR(*fm->membership)[u];
+                if (!IGRAPH_BIT_TEST(*buf->neighbor_cluster_added, c)) {
+                    IGRAPH_BIT_SET(*buf->neighbor_cluster_added, c);
+                    VECTOR(*buf->neighbor_clusters)[nb_neigh_clusters++] = c;
+                }
+                VECTOR(*buf->edge_weights_per_cluster)[c] += VECTOR(*fm->edge_weights)[e];
+            }
+        }
+
+        /* The node is considered to be removed from its current cluster. An
+         * empty cluster is only a candidate if that does not leave the
+         * current cluster empty. */
+        best_cluster = current_cluster;
+        max_diff = VECTOR(*buf->edge_weights_per_cluster)[current_cluster] -
+                   node_weight * (VECTOR(*fm->cluster_weights)[current_cluster] - node_weight) * fm->resolution_parameter;
+        if (VECTOR(*fm->nb_nodes_per_cluster)[current_cluster] > 1 && 0.0 > max_diff) {
+            best_cluster = -1;
+            max_diff = 0.0;
+        }
+        for (igraph_integer_t j = 0; j < nb_neigh_clusters; j++) {
+            igraph_integer_t c = VECTOR(*buf->neighbor_clusters)[j];
+            if (c != current_cluster) {
+                diff = VECTOR(*buf->edge_weights_per_cluster)[c] -
+                       node_weight * VECTOR(*fm->cluster_weights)[c] * fm->resolution_parameter;
+                if (diff > max_diff) {
+                    best_cluster = c;
+                    max_diff = diff;
+                }
+            }
+        }
+
+        VECTOR(*fm->target)[i] = best_cluster;
+        VECTOR(*fm->weight_current)[i] = VECTOR(*buf->edge_weights_per_cluster)[current_cluster];
+        VECTOR(*fm->weight_target)[i] = best_cluster >= 0 ? VECTOR(*buf->edge_weights_per_cluster)[best_cluster] : 0.0;
+
+        for (igraph_integer_t j = 0; j < nb_neigh_clusters; j++) {
+            igraph_integer_t c = VECTOR(*buf->neighbor_clusters)[j];
+            VECTOR(*buf->edge_weights_per_cluster)[c] = 0.0;
+            IGRAPH_BIT_CLEAR(*buf->neighbor_cluster_added, c);
+        }
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Parallel variant of igraph_i_community_leiden_fastmovenodes().
+ *
+ * The nodes are taken from the queue in batches. The best cluster of each
+ * node in a batch is determined concurrently, based on the partition at the
+ * start of the batch. These moves are then considered one by one, in the
+ * order of the batch. If a neighbor of the node was moved earlier in the
+ * batch, the node is put back in the queue to be examined again. Otherwise
+ * only the cluster weights may have changed, and the move is made if it
+ * still strictly improves the quality. A move that no longer does so also
+ * puts the node back in the queue.
+ *
+ * Therefore, as in the serial variant, each move strictly improves the
+ * quality, and a node only becomes stable if it cannot be moved to improve
+ * the quality. The first node of a batch always sees the same partition as
+ * when its best cluster was determined, so each batch either moves a node or
+ * makes one stable. The batches do not depend on the number of threads, and
+ * neither does the result.
+ *
+ * Temporary buffers are taken from \c ws, and the buffers of each thread
+ * from the thread workspaces in \c par.
+ */
+static igraph_error_t igraph_i_community_leiden_fastmovenodes_parallel(
+        const igraph_t *graph,
+        const igraph_inclist_t *edges_per_node,
+        const igraph_vector_t *edge_weights, const igraph_vector_t *node_weights,
+        const igraph_real_t resolution_parameter,
+        igraph_integer_t *nb_clusters,
+        igraph_vector_int_t *membership,
+        igraph_bool_t *changed,
+        igraph_workspace_t *ws,
+        igraph_i_leiden_parallel_t *par) {
+
+    igraph_dqueue_int_t unstable_nodes;
+    const igraph_integer_t n = igraph_vcount(graph);
+    igraph_bitset_t *node_is_stable;
+    igraph_vector_t *cluster_weights, *weight_current, *weight_target;
+    igraph_vector_int_t *node_order, *nb_nodes_per_cluster, *batch, *target, *neighbor_moved;
+    igraph_stack_int_t empty_clusters;
+    igraph_i_leiden_buffers_t *buffers;
+    igraph_i_leiden_fastmove_t data;
+    igraph_integer_t c, batch_no = 0;
+    igraph_i_workspace_mark_t mark;
+
+    igraph_i_workspace_mark(ws, &mark);
+
+    /* Initialize queue of unstable nodes and whether node is stable. Only
+     * unstable nodes are in the queue. */
+    IGRAPH_CHECK(igraph_i_workspace_bitset(ws, n, &node_is_stable));
+
+    IGRAPH_DQUEUE_INT_INIT_FINALLY(&unstable_nodes, n);
+
+    /* Shuffle nodes */
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, n, &node_order));
+    for (igraph_integer_t i = 0; i < n; i++) {
+        VECTOR(*node_order)[i] = i;
+    }
+    IGRAPH_CHECK(igraph_vector_int_shuffle(node_order));
+
+    /* Add to the queue */
+    for (igraph_integer_t i = 0; i < n; i++) {
+        IGRAPH_CHECK(igraph_dqueue_int_push(&unstable_nodes, VECTOR(*node_order)[i]));
+    }
+
+    /* Initialize cluster weights and nb nodes */
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, n, &cluster_weights));
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, n, &nb_nodes_per_cluster));
+    for (igraph_integer_t i = 0; i < n; i++) {
+        c = VECTOR(*membership)[i];
+        VECTOR(*cluster_weights)[c] += VECTOR(*node_weights)[i];
+        VECTOR(*nb_nodes_per_cluster)[c] += 1;
+    }
+
+    /* Initialize empty clusters */
+    IGRAPH_STACK_INT_INIT_FINALLY(&empty_clusters, n);
+    for (c = 0; c < n; c++)
+        if (VECTOR(*nb_nodes_per_cluster)[c] == 0) {
+            IGRAPH_CHECK(igraph_stack_int_push(&empty_clusters, c));
+        }
+
+    /* The number of the last batch in which a neighbor of each node moved */
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, n, &neighbor_moved));
+
+    /* Initialize the batch and the best moves of its nodes */
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, IGRAPH_I_LEIDEN_BATCH_SIZE, &batch));
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, IGRAPH_I_LEIDEN_BATCH_SIZE, &target));
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, IGRAPH_I_LEIDEN_BATCH_SIZE, &weight_current));
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, IGRAPH_I_LEIDEN_BATCH_SIZE, &weight_target));
+
+    buffers = IGRAPH_CALLOC(par->no_of_threads, igraph_i_leiden_buffers_t);
+    IGRAPH_CHECK_OOM(buffers, "Insufficient memory for parallel Leiden algorithm.");
+    IGRAPH_FINALLY(igraph_free, buffers);
+    IGRAPH_CHECK(igraph_i_leiden_parallel_buffers(par, n, buffers));
+
+    data.graph = graph;
+    data.edges_per_node = edges_per_node;
+    data.edge_weights = edge_weights;
+    data.node_weights = node_weights;
+    data.resolution_parameter = resolution_parameter;
+    data.membership = membership;
+    data.cluster_weights = cluster_weights;
+    data.nb_nodes_per_cluster = nb_nodes_per_cluster;
+    data.batch = batch;
+    data.target = target;
+    data.weight_current = weight_current;
+    data.weight_target = weight_target;
+    data.buffers = buffers;
+
+    /* Iterate while the queue is not empty */
+    while (!igraph_dqueue_int_empty(&unstable_nodes)) {
+        igraph_integer_t batch_size = igraph_dqueue_int_size(&unstable_nodes);
+
+        if (batch_size > IGRAPH_I_LEIDEN_BATCH_SIZE) {
+            batch_size = IGRAPH_I_LEIDEN_BATCH_SIZE;
+        }
+        IGRAPH_CHECK(igraph_vector_int_resize(batch, batch_size));
+        for (igraph_integer_t i = 0; i < batch_size; i++) {
+            VECTOR(*batch)[i] = igraph_dqueue_int_pop(&unstable_nodes);
+        }
+        batch_no++;
+
+        /* Find the best moves concurrently */
+        IGRAPH_CHECK(igraph_i_leiden_parallel_run(par, igraph_i_community_leiden_best_moves, &data,
+                     (batch_size + IGRAPH_I_LEIDEN_BLOCK_SIZE - 1) / IGRAPH_I_LEIDEN_BLOCK_SIZE));
+
+        /* Make the moves that are still valid */
+        for (igraph_integer_t i = 0; i < batch_size; i++) {
+            igraph_integer_t v = VECTOR(*batch)[i];
+            igraph_integer_t best_cluster = VECTOR(*target)[i], current_cluster = VECTOR(*membership)[v];
+            igraph_real_t node_weight = VECTOR(*node_weights)[v];
+            igraph_real_t current_diff, best_diff;
+            igraph_vector_int_t *edges;
+            igraph_integer_t degree;
+
+            /* The best cluster may have changed, examine the node again */
+            if (VECTOR(*neighbor_moved)[v] == batch_no) {
+                IGRAPH_CHECK(igraph_dqueue_int_push(&unstable_nodes, v));
+                continue;
+            }
+
+            /* The node cannot be moved to improve the quality */
+            if (best_cluster == current_cluster) {
+                IGRAPH_BIT_SET(*node_is_stable, v);
+                continue;
+            }
+
+            /* Check that the move still strictly improves the quality */
+            current_diff = VECTOR(*weight_current)[i] -
+                           node_weight * (VECTOR(*cluster_weights)[current_cluster] - node_weight) * resolution_parameter;
+            if (best_cluster < 0) {
+                best_diff = VECTOR(*nb_nodes_per_cluster)[current_cluster] > 1 ? 0.0 : current_diff;
+            } else {
+                best_diff = VECTOR(*weight_target)[i] -
+                            node_weight * VECTOR(*cluster_weights)[best_cluster] * resolution_parameter;
+            }
+            if (!(best_diff > current_diff)) {
+                IGRAPH_CHECK(igraph_dqueue_int_push(&unstable_nodes, v));
+                continue;
+            }
+
+            /* Move node to best cluster */
+            if (best_cluster < 0) {
+                best_cluster = igraph_stack_int_pop(&empty_clusters);
+            }
+            VECTOR(*cluster_weights)[current_cluster] -= node_weight;
+            VECTOR(*nb_nodes_per_cluster)[current_cluster]--;
+            if (VECTOR(*nb_nodes_per_cluster)[current_cluster] == 0) {
+                IGRAPH_CHECK(igraph_stack_int_push(&empty_clusters, current_cluster));
+            }
+            VECTOR(*cluster_weights)[best_cluster] += node_weight;
+            VECTOR(*nb_nodes_per_cluster)[best_cluster]++;
+
+            *changed = true;
+            VECTOR(*membership)[v] = best_cluster;
+            IGRAPH_BIT_SET(*node_is_stable, v);
+
+            /* Add stable neighbours that are not part of the new cluster to
+             * the queue, and mark the remaining ones of this batch as stale */
+            edges = igraph_inclist_get(edges_per_node, v);
+            degree = igraph_vector_int_size(edges);
+            for (igraph_integer_t j = 0; j < degree; j++) {
+                igraph_integer_t e = VECTOR(*edges)[j];
+                igraph_integer_t u = IGRAPH_OTHER(graph, e, v);
+                VECTOR(*neighbor_moved)[u] = batch_no;
+                if (IGRAPH_BIT_TEST(*node_is_stable, u) && VECTOR(*membership)[u] != best_cluster) {
+                    IGRAPH_CHECK(igraph_dqueue_int_push(&unstable_nodes, u));
+                    IGRAPH_BIT_CLEAR(*node_is_stable, u);
+                }
+            }
+        }
+
+        IGRAPH_ALLOW_INTERRUPTION();
+    }
+
+    IGRAPH_CHECK(igraph_reindex_membership(membership, NULL, nb_clusters));
+
+    IGRAPH_FREE(buffers);
+    igraph_stack_int_destroy(&empty_clusters);
+    igraph_dqueue_int_destroy(&unstable_nodes);
+    IGRAPH_FINALLY_CLEAN(3);
+
+    igraph_i_workspace_release(ws, &mark);
 
     return IGRAPH_SUCCESS;
 }
@@ -283,6 +713,10 @@ static igraph_error_t igraph_i_community_leiden_clean_refined_membership(
  * refined clusters that have already been processed. See
  * igraph_i_community_leiden_clean_refined_membership for more information about
  * this aspect.
+ *
+ * As this is called once for each cluster, its temporary buffers are taken
+ * from \c ws, so that they are allocated only once. Random numbers are taken
+ * from \c rng, which allows refining different clusters concurrently.
  */
 static igraph_error_t igraph_i_community_leiden_mergenodes(
         const igraph_t *graph,
@@ -294,31 +728,37 @@ static igraph_error_t igraph_i_community_leiden_mergenodes(
         const igraph_real_t resolution_parameter,
         const igraph_real_t beta,
         igraph_integer_t *nb_refined_clusters,
-        igraph_vector_int_t *refined_membership) {
-    igraph_vector_int_t node_order;
-    igraph_bitset_t non_singleton_cluster, neighbor_cluster_added;
+        igraph_vector_int_t *refined_membership,
+        igraph_workspace_t *ws, igraph_rng_t *rng) {
+    igraph_vector_int_t *node_order;
+    igraph_bitset_t *non_singleton_cluster, *neighbor_cluster_added;
     igraph_real_t max_diff, total_cum_trans_diff, diff = 0.0, total_node_weight = 0.0;
     const igraph_integer_t n = igraph_vector_int_size(node_subset);
-    igraph_vector_t cluster_weights, cum_trans_diff, edge_weights_per_cluster, external_edge_weight_per_cluster_in_subset;
-    igraph_vector_int_t neighbor_clusters;
-    igraph_vector_int_t *edges, nb_nodes_per_cluster;
+    igraph_vector_t *cluster_weights, *cum_trans_diff, *edge_weights_per_cluster, *external_edge_weight_per_cluster_in_subset;
+    igraph_vector_int_t *neighbor_clusters;
+    igraph_vector_int_t *edges, *nb_nodes_per_cluster;
     igraph_integer_t degree, nb_neigh_clusters;
+    igraph_i_workspace_mark_t mark;
+
+    /* This is called for each cluster, so the buffers are taken from the
+     * workspace instead of being allocated each time. */
+    igraph_i_workspace_mark(ws, &mark);
 
     /* Initialize cluster weights */
-    IGRAPH_VECTOR_INIT_FINALLY(&cluster_weights, n);
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, n, &cluster_weights));
 
     /* Initialize number of nodes per cluster */
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&nb_nodes_per_cluster, n);
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, n, &nb_nodes_per_cluster));
 
     /* Initialize external edge weight per cluster in subset */
-    IGRAPH_VECTOR_INIT_FINALLY(&external_edge_weight_per_cluster_in_subset, n);
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, n, &external_edge_weight_per_cluster_in_subset));
 
     /* Initialize administration for a singleton partition */
     for (igraph_integer_t i = 0; i < n; i++) {
         igraph_integer_t v = VECTOR(*node_subset)[i];
         VECTOR(*refined_membership)[v] = i;
-        VECTOR(cluster_weights)[i] += VECTOR(*node_weights)[v];
-        VECTOR(nb_nodes_per_cluster)[i] += 1;
+        VECTOR(*cluster_weights)[i] += VECTOR(*node_weights)[v];
+        VECTOR(*nb_nodes_per_cluster)[i] += 1;
         total_node_weight += VECTOR(*node_weights)[v];
 
         /* Find out neighboring clusters */
@@ -328,61 +768,64 @@ static igraph_error_t igraph_i_community_leiden_mergenodes(
             igraph_integer_t e = VECTOR(*edges)[j];
             igraph_integer_t u = IGRAPH_OTHER(graph, e, v);
             if (u != v && VECTOR(*membership)[u] == cluster_subset) {
-                VECTOR(external_edge_weight_per_cluster_in_subset)[i] += VECTOR(*edge_weights)[e];
+                VECTOR(*external_edge_weight_per_cluster_in_subset)[i] += VECTOR(*edge_weights)[e];
             }
         }
     }
 
     /* Shuffle nodes */
-    IGRAPH_CHECK(igraph_vector_int_init_copy(&node_order, node_subset));
-    IGRAPH_FINALLY(igraph_vector_int_destroy, &node_order);
-    IGRAPH_CHECK(igraph_vector_int_shuffle(&node_order));
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, n, &node_order));
+    IGRAPH_CHECK(igraph_vector_int_update(node_order, node_subset));
+    for (igraph_integer_t i = n - 1; i > 0; i--) {
+        igraph_integer_t k = igraph_rng_get_integer(rng, 0, i);
+        igraph_integer_t tmp = VECTOR(*node_order)[i];
+        VECTOR(*node_order)[i] = VECTOR(*node_order)[k];
+        VECTOR(*node_order)[k] = tmp;
+    }
 
     /* Initialize non singleton clusters */
-    IGRAPH_BITSET_INIT_FINALLY(&non_singleton_cluster, n);
+    IGRAPH_CHECK(igraph_i_workspace_bitset(ws, n, &non_singleton_cluster));
 
     /* Initialize vectors to be used in calculating differences */
-    IGRAPH_VECTOR_INIT_FINALLY(&edge_weights_per_cluster, n);
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, n, &edge_weights_per_cluster));
 
     /* Initialize neighboring cluster */
-    IGRAPH_BITSET_INIT_FINALLY(&neighbor_cluster_added, n);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&neighbor_clusters, n);
+    IGRAPH_CHECK(igraph_i_workspace_bitset(ws, n, &neighbor_cluster_added));
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, n, &neighbor_clusters));
 
     /* Initialize cumulative transformed difference */
-    IGRAPH_VECTOR_INIT_FINALLY(&cum_trans_diff, n);
-
-    RNG_BEGIN();
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, n, &cum_trans_diff));
 
     for (igraph_integer_t i = 0; i < n; i++) {
-        igraph_integer_t v = VECTOR(node_order)[i];
+        igraph_integer_t v = VECTOR(*node_order)[i];
         igraph_integer_t chosen_cluster, best_cluster, current_cluster = VECTOR(*refined_membership)[v];
 
-        if (!IGRAPH_BIT_TEST(non_singleton_cluster, current_cluster) &&
-            (VECTOR(external_edge_weight_per_cluster_in_subset)[current_cluster] >=
-             VECTOR(cluster_weights)[current_cluster] * (total_node_weight - VECTOR(cluster_weights)[current_cluster]) * resolution_parameter)) {
+        if (!IGRAPH_BIT_TEST(*non_singleton_cluster, current_cluster) &&
+            (VECTOR(*external_edge_weight_per_cluster_in_subset)[current_cluster] >=
+             VECTOR(*cluster_weights)[current_cluster] * (total_node_weight - VECTOR(*cluster_weights)[current_cluster]) * resolution_parameter)) {
             /* Remove node from current cluster, which is then a singleton by
              * definition. */
-            VECTOR(cluster_weights)[current_cluster] = 0.0;
-            VECTOR(nb_nodes_per_cluster)[current_cluster] = 0;
+            VECTOR(*cluster_weights)[current_cluster] = 0.0;
+            VECTOR(*nb_nodes_per_cluster)[current_cluster] = 0;
 
             /* Find out neighboring clusters */
             edges = igraph_inclist_get(edges_per_node, v);
             degree = igraph_vector_int_size(edges);
 
             /* Also add current cluster to ensure it can be chosen. */
-            VECTOR(neighbor_clusters)[0] = current_cluster;
-            IGRAPH_BIT_SET(neighbor_cluster_added, current_cluster);
+            VECTOR(*neighbor_clusters)[0] = current_cluster;
+            IGRAPH_BIT_SET(*neighbor_cluster_added, current_cluster);
             nb_neigh_clusters = 1;
             for (igraph_integer_t j = 0; j < degree; j++) {
                 igraph_integer_t e = VECTOR(*edges)[j];
                 igraph_integer_t u = IGRAPH_OTHER(graph, e, v);
                 if (u != v && VECTOR(*membership)[u] == cluster_subset) {
                     igraph_integer_t c = VECTOR(*refined_membership)[u];
-                    if (!IGRAPH_BIT_TEST(neighbor_cluster_added, c)) {
-                        IGRAPH_BIT_SET(neighbor_cluster_added, c);
-                        VECTOR(neighbor_clusters)[nb_neigh_clusters++] = c;
+                    if (!IGRAPH_BIT_TEST(*neighbor_cluster_added, c)) {
+                        IGRAPH_BIT_SET(*neighbor_cluster_added, c);
+                        VECTOR(*neighbor_clusters)[nb_neigh_clusters++] = c;
                     }
-                    VECTOR(edge_weights_per_cluster)[c] += VECTOR(*edge_weights)[e];
+                    VECTOR(*edge_weights_per_cluster)[c] += VECTOR(*edge_weights)[e];
                 }
             }
 
@@ -391,9 +834,9 @@ static igraph_error_t igraph_i_community_leiden_mergenodes(
             max_diff = 0.0;
             total_cum_trans_diff = 0.0;
             for (igraph_integer_t j = 0; j < nb_neigh_clusters; j++) {
-                igraph_integer_t c = VECTOR(neighbor_clusters)[j];
-                if (VECTOR(external_edge_weight_per_cluster_in_subset)[c] >= VECTOR(cluster_weights)[c] * (total_node_weight - VECTOR(cluster_weights)[c]) * resolution_parameter) {
-                    diff = VECTOR(edge_weights_per_cluster)[c] - VECTOR(*node_weights)[v] * VECTOR(cluster_weights)[c] * resolution_parameter;
+                igraph_integer_t c = VECTOR(*neighbor_clusters)[j];
+                if (VECTOR(*external_edge_weight_per_cluster_in_subset)[c] >= VECTOR(*cluster_weights)[c] * (total_node_weight - VECTOR(*cluster_weights)[c]) * resolution_parameter) {
+                    diff = VECTOR(*edge_weights_per_cluster)[c] - VECTOR(*node_weights)[v] * VECTOR(*cluster_weights)[c] * resolution_parameter;
 
                     if (diff > max_diff) {
                         best_cluster = c;
@@ -407,35 +850,35 @@ static igraph_error_t igraph_i_community_leiden_mergenodes(
 
                 }
 
-                VECTOR(cum_trans_diff)[j] = total_cum_trans_diff;
-                VECTOR(edge_weights_per_cluster)[c] = 0.0;
-                IGRAPH_BIT_CLEAR(neighbor_cluster_added, c);
+                VECTOR(*cum_trans_diff)[j] = total_cum_trans_diff;
+                VECTOR(*edge_weights_per_cluster)[c] = 0.0;
+                IGRAPH_BIT_CLEAR(*neighbor_cluster_added, c);
             }
 
             /* Determine the neighboring cluster to which the currently selected node
              * will be moved.
              */
             if (total_cum_trans_diff < IGRAPH_INFINITY) {
-                igraph_real_t r = RNG_UNIF(0, total_cum_trans_diff);
+                igraph_real_t r = igraph_rng_get_unif(rng, 0, total_cum_trans_diff);
                 igraph_integer_t chosen_idx;
-                igraph_vector_binsearch_slice(&cum_trans_diff, r, &chosen_idx, 0, nb_neigh_clusters);
-                chosen_cluster = VECTOR(neighbor_clusters)[chosen_idx];
+                igraph_vector_binsearch_slice(cum_trans_diff, r, &chosen_idx, 0, nb_neigh_clusters);
+                chosen_cluster = VECTOR(*neighbor_clusters)[chosen_idx];
             } else {
                 chosen_cluster = best_cluster;
             }
 
             /* Move node to randomly chosen cluster */
-            VECTOR(cluster_weights)[chosen_cluster] += VECTOR(*node_weights)[v];
-            VECTOR(nb_nodes_per_cluster)[chosen_cluster]++;
+            VECTOR(*cluster_weights)[chosen_cluster] += VECTOR(*node_weights)[v];
+            VECTOR(*nb_nodes_per_cluster)[chosen_cluster]++;
 
             for (igraph_integer_t j = 0; j < degree; j++) {
                 igraph_integer_t e = VECTOR(*edges)[j];
                 igraph_integer_t u = IGRAPH_OTHER(graph, e, v);
                 if (VECTOR(*membership)[u] == cluster_subset) {
                     if (VECTOR(*refined_membership)[u] == chosen_cluster) {
-                        VECTOR(external_edge_weight_per_cluster_in_subset)[chosen_cluster] -= VECTOR(*edge_weights)[e];
+                        VECTOR(*external_edge_weight_per_cluster_in_subset)[chosen_cluster] -= VECTOR(*edge_weights)[e];
                     } else {
-                        VECTOR(external_edge_weight_per_cluster_in_subset)[chosen_cluster] += VECTOR(*edge_weights)[e];
+                        VECTOR(*external_edge_weight_per_cluster_in_subset)[chosen_cluster] += VECTOR(*edge_weights)[e];
                     }
                 }
             }
@@ -444,25 +887,14 @@ static igraph_error_t igraph_i_community_leiden_mergenodes(
             if (chosen_cluster != current_cluster) {
                 VECTOR(*refined_membership)[v] = chosen_cluster;
 
-                IGRAPH_BIT_SET(non_singleton_cluster, chosen_cluster);
+                IGRAPH_BIT_SET(*non_singleton_cluster, chosen_cluster);
             }
         } /* end if singleton and may be merged */
     }
 
-    RNG_END();
-
     IGRAPH_CHECK(igraph_i_community_leiden_clean_refined_membership(node_subset, refined_membership, nb_refined_clusters));
 
-    igraph_vector_destroy(&cum_trans_diff);
-    igraph_vector_int_destroy(&neighbor_clusters);
-    igraph_bitset_destroy(&neighbor_cluster_added);
-    igraph_vector_destroy(&edge_weights_per_cluster);
-    igraph_bitset_destroy(&non_singleton_cluster);
-    igraph_vector_int_destroy(&node_order);
-    igraph_vector_destroy(&external_edge_weight_per_cluster_in_subset);
-    igraph_vector_int_destroy(&nb_nodes_per_cluster);
-    igraph_vector_destroy(&cluster_weights);
-    IGRAPH_FINALLY_CLEAN(9);
+    igraph_i_workspace_release(ws, &mark);
 
     return IGRAPH_SUCCESS;
 }
@@ -489,54 +921,133 @@ static igraph_error_t igraph_i_community_get_clusters(const igraph_vector_int_t
     return IGRAPH_SUCCESS;
 }
 
-/* Aggregate the graph based on the \c refined membership while setting the
- * membership of each aggregated node according to the \c membership.
- *
- * Technically speaking we have that
- * aggregated_membership[refined_membership[v]] = membership[v] for each node v.
- *
- * The new aggregated graph is returned in \c aggregated_graph. This graph
- * object should not yet be initialized, `igraph_create` is called on it, and
- * responsibility for destroying the object lies with the calling method
- *
- * The remaining results, aggregated_edge_weights, aggregate_node_weights and
- * aggregated_membership are all expected to be initialized.
+/* Data of the parallel refinement. Each cluster is refined with its own
+ * random seed, and the number of refined clusters within each cluster is
+ * stored in nb_refined_clusters. */
+typedef struct {
+    const igraph_t *graph;
+    const igraph_inclist_t *edges_per_node;
+    const igraph_vector_t *edge_weights;
+    const igraph_vector_t *node_weights;
+    const igraph_vector_int_list_t *clusters;
+    const igraph_vector_int_t *membership;
+    igraph_real_t resolution_parameter;
+    igraph_real_t beta;
+    const igraph_vector_int_t *seeds;
+    igraph_vector_int_t *nb_refined_clusters;
+    igraph_vector_int_t *refined_membership;
+    igraph_i_leiden_parallel_t *par;
+} igraph_i_leiden_refine_t;
+
+static igraph_error_t igraph_i_community_leiden_refine_cluster(void *data, igraph_integer_t thread, igraph_integer_t block) {
+    const igraph_i_leiden_refine_t *rd = data;
+    igraph_rng_t *rng = &rd->par->rng[thread];
+    igraph_integer_t nb_refined_clusters = 0;
+
+    IGRAPH_CHECK(igraph_rng_seed(rng, VECTOR(*rd->seeds)[block]));
+    IGRAPH_CHECK(igraph_i_community_leiden_mergenodes(rd->graph,
+                 rd->edges_per_node,
+                 rd->edge_weights, rd->node_weights,
+                 igraph_vector_int_list_get_ptr(rd->clusters, block), rd->membership, block,
+                 rd->resolution_parameter, rd->beta,
+                 &nb_refined_clusters, rd->refined_membership,
+                 &rd->par->ws[thread], rng));
+    VECTOR(*rd->nb_refined_clusters)[block] = nb_refined_clusters;
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Refine the first \c nb_clusters clusters in \c clusters concurrently.
  *
+ * Merging the nodes of one cluster only reads and writes the refined
+ * membership of the nodes in that cluster, so the clusters are independent.
+ * The random seed of each cluster is drawn from the default random number
+ * generator beforehand, so that the result does not depend on which thread
+ * refines which cluster. The refined clusters are numbered consecutively,
+ * cluster by cluster, as in the serial refinement.
  */
-static igraph_error_t igraph_i_community_leiden_aggregate(
-    const igraph_t *graph, const igraph_inclist_t *edges_per_node, const igraph_vector_t *edge_weights, const igraph_vector_t *node_weights,
-    const igraph_vector_int_t *membership, const igraph_vector_int_t *refined_membership, const igraph_integer_t nb_refined_clusters,
-    igraph_t *aggregated_graph, igraph_vector_t *aggregated_edge_weights, igraph_vector_t *aggregated_node_weights, igraph_vector_int_t *aggregated_membership) {
-    igraph_vector_int_t aggregated_edges;
-    igraph_vector_t edge_weight_to_cluster;
-    igraph_vector_int_list_t refined_clusters;
-    igraph_vector_int_t *incident_edges;
-    igraph_vector_int_t neighbor_clusters;
-    igraph_bitset_t neighbor_cluster_added;
-    igraph_integer_t c, degree, nb_neigh_clusters;
+static igraph_error_t igraph_i_community_leiden_refine_parallel(
+        const igraph_t *graph,
+        const igraph_inclist_t *edges_per_node,
+        const igraph_vector_t *edge_weights, const igraph_vector_t *node_weights,
+        const igraph_vector_int_list_t *clusters,
+        const igraph_integer_t nb_clusters,
+        const igraph_vector_int_t *membership,
+        const igraph_real_t resolution_parameter,
+        const igraph_real_t beta,
+        igraph_integer_t *nb_refined_clusters,
+        igraph_vector_int_t *refined_membership,
+        igraph_i_leiden_parallel_t *par) {
+    const igraph_integer_t n = igraph_vcount(graph);
+    igraph_vector_int_t seeds, nb_refined_per_cluster;
+    igraph_i_leiden_refine_t data;
 
-    /* Get refined clusters */
-    IGRAPH_VECTOR_INT_LIST_INIT_FINALLY(&refined_clusters, nb_refined_clusters);
-    IGRAPH_CHECK(igraph_i_community_get_clusters(refined_membership, &refined_clusters));
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&seeds, nb_clusters);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&nb_refined_per_cluster, nb_clusters);
 
-    /* Initialize new edges */
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&aggregated_edges, 0);
+    RNG_BEGIN();
+    for (igraph_integer_t c = 0; c < nb_clusters; c++) {
+        VECTOR(seeds)[c] = RNG_INTEGER(0, IGRAPH_INTEGER_MAX);
+    }
+    RNG_END();
 
-    /* We clear the aggregated edge weights, we will push each new edge weight */
-    igraph_vector_clear(aggregated_edge_weights);
-    /* Simply resize the aggregated node weights and membership, they can be set directly */
-    IGRAPH_CHECK(igraph_vector_resize(aggregated_node_weights, nb_refined_clusters));
-    IGRAPH_CHECK(igraph_vector_int_resize(aggregated_membership, nb_refined_clusters));
+    data.graph = graph;
+    data.edges_per_node = edges_per_node;
+    data.edge_weights = edge_weights;
+    data.node_weights = node_weights;
+    data.clusters = clusters;
+    data.membership = membership;
+    data.resolution_parameter = resolution_parameter;
+    data.beta = beta;
+    data.seeds = &seeds;
+    data.nb_refined_clusters = &nb_refined_per_cluster;
+    data.refined_membership = refined_membership;
+    data.par = par;
+
+    IGRAPH_CHECK(igraph_i_leiden_parallel_run(par, igraph_i_community_leiden_refine_cluster, &data, nb_clusters));
+
+    /* Number the refined clusters of each cluster after those of the
+     * previous clusters. */
+    *nb_refined_clusters = 0;
+    for (igraph_integer_t c = 0; c < nb_clusters; c++) {
+        igraph_integer_t count = VECTOR(nb_refined_per_cluster)[c];
+        VECTOR(nb_refined_per_cluster)[c] = *nb_refined_clusters;
+        *nb_refined_clusters += count;
+    }
+    for (igraph_integer_t v = 0; v < n; v++) {
+        VECTOR(*refined_membership)[v] += VECTOR(nb_refined_per_cluster)[VECTOR(*membership)[v]];
+    }
 
-    IGRAPH_VECTOR_INIT_FINALLY(&edge_weight_to_cluster, nb_refined_clusters);
+    igraph_vector_int_destroy(&nb_refined_per_cluster);
+    igraph_vector_int_destroy(&seeds);
+    IGRAPH_FINALLY_CLEAN(2);
 
-    /* Initialize neighboring cluster */
-    IGRAPH_BITSET_INIT_FINALLY(&neighbor_cluster_added, nb_refined_clusters);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&neighbor_clusters, nb_refined_clusters);
+    return IGRAPH_SUCCESS;
+}
+
+/* Aggregate the refined clusters from, ..., to - 1.
+ *
+ * For each of these clusters, the edges to clusters with a larger index are
+ * appended to \c aggregated_edges, and their weights to \c
+ * aggregated_edge_weights. The node weight and membership of the aggregated
+ * node are set in \c aggregated_node_weights and \c aggregated_membership,
+ * which must already be sized appropriately. The buffers in \c buf must have
+ * the size of the number of refined clusters, and be cleared.
+ */
+static igraph_error_t igraph_i_community_leiden_aggregate_clusters(
+    const igraph_t *graph, const igraph_inclist_t *edges_per_node, const igraph_vector_t *edge_weights, const igraph_vector_t *node_weights,
+    const igraph_vector_int_t *membership, const igraph_vector_int_t *refined_membership, const igraph_vector_int_list_t *refined_clusters,
+    igraph_integer_t from, igraph_integer_t to, const igraph_i_leiden_buffers_t *buf,
+    igraph_vector_int_t *aggregated_edges, igraph_vector_t *aggregated_edge_weights, igraph_vector_t *aggregated_node_weights, igraph_vector_int_t *aggregated_membership) {
+    igraph_vector_t *edge_weight_to_cluster = buf->edge_weights_per_cluster;
+    igraph_bitset_t *neighbor_cluster_added = buf->neighbor_cluster_added;
+    igraph_vector_int_t *neighbor_clusters = buf->neighbor_clusters;
+    igraph_vector_int_t *incident_edges;
+    igraph_integer_t degree, nb_neigh_clusters;
 
     /* Check per cluster */
-    for (c = 0; c < nb_refined_clusters; c++) {
-        igraph_vector_int_t* refined_cluster = igraph_vector_int_list_get_ptr(&refined_clusters, c);
+    for (igraph_integer_t c = from; c < to; c++) {
+        igraph_vector_int_t* refined_cluster = igraph_vector_int_list_get_ptr(refined_clusters, c);
         igraph_integer_t n_c = igraph_vector_int_size(refined_cluster);
         igraph_integer_t v = -1;
 
@@ -554,11 +1065,11 @@ static igraph_error_t igraph_i_community_leiden_aggregate(
                 igraph_integer_t c2 = VECTOR(*refined_membership)[u];
 
                 if (c2 > c) {
-                    if (!IGRAPH_BIT_TEST(neighbor_cluster_added, c2)) {
-                        IGRAPH_BIT_SET(neighbor_cluster_added, c2);
-                        VECTOR(neighbor_clusters)[nb_neigh_clusters++] = c2;
+                    if (!IGRAPH_BIT_TEST(*neighbor_cluster_added, c2)) {
+                        IGRAPH_BIT_SET(*neighbor_cluster_added, c2);
+                        VECTOR(*neighbor_clusters)[nb_neigh_clusters++] = c2;
                     }
-                    VECTOR(edge_weight_to_cluster)[c2] += VECTOR(*edge_weights)[e];
+                    VECTOR(*edge_weight_to_cluster)[c2] += VECTOR(*edge_weights)[e];
                 }
             }
 
@@ -567,28 +1078,172 @@ static igraph_error_t igraph_i_community_leiden_aggregate(
 
         /* Add actual edges from this cluster to the other clusters */
         for (igraph_integer_t i = 0; i < nb_neigh_clusters; i++) {
-            igraph_integer_t c2 = VECTOR(neighbor_clusters)[i];
+            igraph_integer_t c2 = VECTOR(*neighbor_clusters)[i];
 
             /* Add edge */
-            IGRAPH_CHECK(igraph_vector_int_push_back(&aggregated_edges, c));
-            IGRAPH_CHECK(igraph_vector_int_push_back(&aggregated_edges, c2));
+            IGRAPH_CHECK(igraph_vector_int_push_back(aggregated_edges, c));
+            IGRAPH_CHECK(igraph_vector_int_push_back(aggregated_edges, c2));
 
             /* Add edge weight */
-            IGRAPH_CHECK(igraph_vector_push_back(aggregated_edge_weights, VECTOR(edge_weight_to_cluster)[c2]));
+            IGRAPH_CHECK(igraph_vector_push_back(aggregated_edge_weights, VECTOR(*edge_weight_to_cluster)[c2]));
 
-            VECTOR(edge_weight_to_cluster)[c2] = 0.0;
-            IGRAPH_BIT_CLEAR(neighbor_cluster_added, c2);
+            VECTOR(*edge_weight_to_cluster)[c2] = 0.0;
+            IGRAPH_BIT_CLEAR(*neighbor_cluster_added, c2);
         }
 
         VECTOR(*aggregated_membership)[c] = VECTOR(*membership)[v];
 
     }
 
-    igraph_vector_int_destroy(&neighbor_clusters);
-    igraph_bitset_destroy(&neighbor_cluster_added);
-    igraph_vector_destroy(&edge_weight_to_cluster);
+    return IGRAPH_SUCCESS;
+}
+
+/* Data of the parallel aggregation. The refined clusters are divided into
+ * ranges, and the edges of each range are collected separately. */
+typedef struct {
+    const igraph_t *graph;
+    const igraph_inclist_t *edges_per_node;
+    const igraph_vector_t *edge_weights;
+    const igraph_vector_t *node_weights;
+    const igraph_vector_int_t *membership;
+    const igraph_vector_int_t *refined_membership;
+    const igraph_vector_int_list_t *refined_clusters;
+    igraph_integer_t nb_refined_clusters;
+    igraph_integer_t no_of_blocks;
+    const igraph_i_leiden_buffers_t *buffers;
+    igraph_vector_int_list_t *block_edges;
+    igraph_vector_list_t *block_edge_weights;
+    igraph_vector_t *aggregated_node_weights;
+    igraph_vector_int_t *aggregated_membership;
+} igraph_i_leiden_aggregate_t;
+
+static igraph_error_t igraph_i_community_leiden_aggregate_block(void *data, igraph_integer_t thread, igraph_integer_t block) {
+    const igraph_i_leiden_aggregate_t *ad = data;
+
+    return igraph_i_community_leiden_aggregate_clusters(
+               ad->graph, ad->edges_per_node, ad->edge_weights, ad->node_weights,
+               ad->membership, ad->refined_membership, ad->refined_clusters,
+               ad->nb_refined_clusters * block / ad->no_of_blocks,
+               ad->nb_refined_clusters * (block + 1) / ad->no_of_blocks,
+               &ad->buffers[thread],
+               igraph_vector_int_list_get_ptr(ad->block_edges, block),
+               igraph_vector_list_get_ptr(ad->block_edge_weights, block),
+               ad->aggregated_node_weights, ad->aggregated_membership);
+}
+
+/* Aggregate the graph based on the \c refined membership while setting the
+ * membership of each aggregated node according to the \c membership.
+ *
+ * Technically speaking we have that
+ * aggregated_membership[refined_membership[v]] = membership[v] for each node v.
+ *
+ * The new aggregated graph is returned in \c aggregated_graph. This graph
+ * object should not yet be initialized, `igraph_create` is called on it, and
+ * responsibility for destroying the object lies with the calling method
+ *
+ * The remaining results, aggregated_edge_weights, aggregate_node_weights and
+ * aggregated_membership are all expected to be initialized.
+ *
+ * If \c par is not \c NULL, ranges of refined clusters are aggregated
+ * concurrently. Their edges are concatenated in order, so the result is the
+ * same as that of the serial aggregation.
+ */
+static igraph_error_t igraph_i_community_leiden_aggregate(
+    const igraph_t *graph, const igraph_inclist_t *edges_per_node, const igraph_vector_t *edge_weights, const igraph_vector_t *node_weights,
+    const igraph_vector_int_t *membership, const igraph_vector_int_t *refined_membership, const igraph_integer_t nb_refined_clusters,
+    igraph_t *aggregated_graph, igraph_vector_t *aggregated_edge_weights, igraph_vector_t *aggregated_node_weights, igraph_vector_int_t *aggregated_membership,
+    igraph_i_leiden_parallel_t *par) {
+    igraph_vector_int_t aggregated_edges;
+    igraph_vector_int_list_t refined_clusters;
+
+    /* Get refined clusters */
+    IGRAPH_VECTOR_INT_LIST_INIT_FINALLY(&refined_clusters, nb_refined_clusters);
+    IGRAPH_CHECK(igraph_i_community_get_clusters(refined_membership, &refined_clusters));
+
+    /* Initialize new edges */
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&aggregated_edges, 0);
+
+    /* We clear the aggregated edge weights, we will push each new edge weight */
+    igraph_vector_clear(aggregated_edge_weights);
+    /* Simply resize the aggregated node weights and membership, they can be set directly */
+    IGRAPH_CHECK(igraph_vector_resize(aggregated_node_weights, nb_refined_clusters));
+    IGRAPH_CHECK(igraph_vector_int_resize(aggregated_membership, nb_refined_clusters));
+
+    if (par) {
+        igraph_i_leiden_aggregate_t data;
+        igraph_i_leiden_buffers_t *buffers;
+        igraph_vector_int_list_t block_edges;
+        igraph_vector_list_t block_edge_weights;
+        igraph_integer_t no_of_blocks = 16 * par->no_of_threads;
+
+        if (no_of_blocks > nb_refined_clusters) {
+            no_of_blocks = nb_refined_clusters;
+        }
+
+        buffers = IGRAPH_CALLOC(par->no_of_threads, igraph_i_leiden_buffers_t);
+        IGRAPH_CHECK_OOM(buffers, "Insufficient memory for parallel Leiden algorithm.");
+        IGRAPH_FINALLY(igraph_free, buffers);
+        IGRAPH_CHECK(igraph_i_leiden_parallel_buffers(par, nb_refined_clusters, buffers));
+
+        IGRAPH_VECTOR_INT_LIST_INIT_FINALLY(&block_edges, no_of_blocks);
+        IGRAPH_VECTOR_LIST_INIT_FINALLY(&block_edge_weights, no_of_blocks);
+
+        data.graph = graph;
+        data.edges_per_node = edges_per_node;
+        data.edge_weights = edge_weights;
+        data.node_weights = node_weights;
+        data.membership = membership;
+        data.refined_membership = refined_membership;
+        data.refined_clusters = &refined_clusters;
+        data.nb_refined_clusters = nb_refined_clusters;
+        data.no_of_blocks = no_of_blocks;
+        data.buffers = buffers;
+        data.block_edges = &block_edges;
+        data.block_edge_weights = &block_edge_weights;
+        data.aggregated_node_weights = aggregated_node_weights;
+        data.aggregated_membership = aggregated_membership;
+
+        IGRAPH_CHECK(igraph_i_leiden_parallel_run(par, igraph_i_community_leiden_aggregate_block, &data, no_of_blocks));
+
+        for (igraph_integer_t block = 0; block < no_of_blocks; block++) {
+            IGRAPH_CHECK(igraph_vector_int_append(&aggregated_edges, igraph_vector_int_list_get_ptr(&block_edges, block)));
+            IGRAPH_CHECK(igraph_vector_append(aggregated_edge_weights, igraph_vector_list_get_ptr(&block_edge_weights, block)));
+        }
+
+        igraph_vector_list_destroy(&block_edge_weights);
+        igraph_vector_int_list_destroy(&block_edges);
+        IGRAPH_FREE(buffers);
+        IGRAPH_FINALLY_CLEAN(3);
+    } else {
+        igraph_vector_t edge_weight_to_cluster;
+        igraph_vector_int_t neighbor_clusters;
+        igraph_bitset_t neighbor_cluster_added;
+        igraph_i_leiden_buffers_t buf;
+
+        IGRAPH_VECTOR_INIT_FINALLY(&edge_weight_to_cluster, nb_refined_clusters);
+
+        /* Initialize neighboring cluster */
+        IGRAPH_BITSET_INIT_FINALLY(&neighbor_cluster_added, nb_refined_clusters);
+        IGRAPH_VECTOR_INT_INIT_FINALLY(&neighbor_clusters, nb_refined_clusters);
+
+        buf.edge_weights_per_cluster = &edge_weight_to_cluster;
+        buf.neighbor_cluster_added = &neighbor_cluster_added;
+        buf.neighbor_clusters = &neighbor_clusters;
+
+        IGRAPH_CHECK(igraph_i_community_leiden_aggregate_clusters(
+                         graph, edges_per_node, edge_weights, node_weights,
+                         membership, refined_membership, &refined_clusters,
+                         0, nb_refined_clusters, &buf,
+                         &aggregated_edges, aggregated_edge_weights, aggregated_node_weights, aggregated_membership));
+
+        igraph_vector_int_destroy(&neighbor_clusters);
+        igraph_bitset_destroy(&neighbor_cluster_added);
+        igraph_vector_destroy(&edge_weight_to_cluster);
+        IGRAPH_FINALLY_CLEAN(3);
+    }
+
     igraph_vector_int_list_destroy(&refined_clusters);
-    IGRAPH_FINALLY_CLEAN(4);
+    IGRAPH_FINALLY_CLEAN(1);
 
     igraph_destroy(aggregated_graph);
     IGRAPH_CHECK(igraph_create(aggregated_graph, &aggregated_edges, nb_refined_clusters,
@@ -683,7 +1338,7 @@ static igraph_error_t igraph_i_community_leiden(
         igraph_vector_t *edge_weights, igraph_vector_t *node_weights,
         const igraph_real_t resolution_parameter, const igraph_real_t beta,
         igraph_vector_int_t *membership, igraph_integer_t *nb_clusters, igraph_real_t *quality,
-        igraph_bool_t *changed) {
+        igraph_bool_t *changed, igraph_workspace_t *ws, igraph_i_leiden_parallel_t *par) {
     igraph_integer_t nb_refined_clusters;
     igraph_integer_t i, c, n = igraph_vcount(graph);
     igraph_t aggregated_graph, *i_graph;
@@ -699,6 +1354,7 @@ static igraph_error_t igraph_i_community_leiden(
     igraph_inclist_t edges_per_node;
     igraph_bool_t continue_clustering;
     igraph_integer_t level = 0;
+    igraph_i_leiden_parallel_t *level_par;
 
     /* Initialize temporary weights and membership to be used in aggregation */
     IGRAPH_VECTOR_INIT_FINALLY(&tmp_edge_weights, 0);
@@ -747,18 +1403,31 @@ static igraph_error_t igraph_i_community_leiden(
     *changed = false;
     do {
 
+        /* Use the parallel variant only on large enough levels */
+        level_par = (par && igraph_ecount(i_graph) >= par->min_edges) ? par : NULL;
+
         /* Get incidence list for fast iteration */
         IGRAPH_CHECK(igraph_inclist_init( i_graph, &edges_per_node, IGRAPH_ALL, IGRAPH_LOOPS_TWICE));
         IGRAPH_FINALLY(igraph_inclist_destroy, &edges_per_node);
 
         /* Move around the nodes in order to increase the quality */
-        IGRAPH_CHECK(igraph_i_community_leiden_fastmovenodes(i_graph,
-                     &edges_per_node,
-                     i_edge_weights, i_node_weights,
-                     resolution_parameter,
-                     nb_clusters,
-                     i_membership,
-                     changed));
+        if (level_par) {
+            IGRAPH_CHECK(igraph_i_community_leiden_fastmovenodes_parallel(i_graph,
+                         &edges_per_node,
+                         i_edge_weights, i_node_weights,
+                         resolution_parameter,
+                         nb_clusters,
+                         i_membership,
+                         changed, ws, level_par));
+        } else {
+            IGRAPH_CHECK(igraph_i_community_leiden_fastmovenodes(i_graph,
+                         &edges_per_node,
+                         i_edge_weights, i_node_weights,
+                         resolution_parameter,
+                         nb_clusters,
+                         i_membership,
+                         changed, ws));
+        }
 
         /* We only continue clustering if not all clusters are represented by a
          * single node yet
@@ -782,16 +1451,29 @@ static igraph_error_t igraph_i_community_leiden(
 
             /* Refine each cluster */
             nb_refined_clusters = 0;
-            for (c = 0; c < *nb_clusters; c++) {
-                igraph_vector_int_t* cluster = igraph_vector_int_list_get_ptr(&clusters, c);
-                IGRAPH_CHECK(igraph_i_community_leiden_mergenodes(i_graph,
+            if (level_par) {
+                IGRAPH_CHECK(igraph_i_community_leiden_refine_parallel(i_graph,
                              &edges_per_node,
                              i_edge_weights, i_node_weights,
-                             cluster, i_membership, c,
+                             &clusters, *nb_clusters, i_membership,
                              resolution_parameter, beta,
-                             &nb_refined_clusters, &refined_membership));
+                             &nb_refined_clusters, &refined_membership, level_par));
+            } else {
+                RNG_BEGIN();
+                for (c = 0; c < *nb_clusters; c++) {
+                    igraph_vector_int_t* cluster = igraph_vector_int_list_get_ptr(&clusters, c);
+                    IGRAPH_CHECK(igraph_i_community_leiden_mergenodes(i_graph,
+                                 &edges_per_node,
+                                 i_edge_weights, i_node_weights,
+                                 cluster, i_membership, c,
+                                 resolution_parameter, beta,
+                                 &nb_refined_clusters, &refined_membership, ws, igraph_rng_default()));
+                }
+                RNG_END();
+            }
+            for (c = 0; c < *nb_clusters; c++) {
                 /* Empty cluster */
-                igraph_vector_int_clear(cluster);
+                igraph_vector_int_clear(igraph_vector_int_list_get_ptr(&clusters, c));
             }
 
             /* If refinement didn't aggregate anything, we aggregate on the basis of
@@ -812,7 +1494,8 @@ static igraph_error_t igraph_i_community_leiden(
             IGRAPH_CHECK(igraph_i_community_leiden_aggregate(
                              i_graph, &edges_per_node, i_edge_weights, i_node_weights,
                              i_membership, &refined_membership, nb_refined_clusters,
-                             &aggregated_graph, &tmp_edge_weights, &tmp_node_weights, &tmp_membership));
+                             &aggregated_graph, &tmp_edge_weights, &tmp_node_weights, &tmp_membership,
+                             level_par));
 
             /* On the lowest level, the actual graph and node and edge weights and
              * membership are used. On higher levels, we will use the aggregated graph
@@ -903,6 +1586,17 @@ static igraph_error_t igraph_i_community_leiden(
  * details, please see Traag, Waltman &amp; van Eck (2019).
  *
  * </para><para>
+ * When igraph is compiled with OpenMP in thread-safe mode (see
+ * \ref IGRAPH_THREAD_SAFE) and more than one thread is available, the three
+ * phases run in parallel on large graphs. In the local move
+ * procedure, the best moves of a batch of nodes are determined concurrently,
+ * and then made one by one, provided that they still strictly improve the
+ * quality function. Therefore the guarantees above hold for the parallel
+ * variant as well. With a given random seed, its results do not depend on the
+ * number of threads, but they differ from those of the serial variant, which
+ * is used when the number of OpenMP threads is set to 1.
+ *
+ * </para><para>
  * The objective function being optimized is
  *
  * </para><para>
@@ -971,6 +1665,26 @@ igraph_error_t igraph_community_leiden(const igraph_t *graph,
                             const igraph_real_t resolution_parameter, const igraph_real_t beta, const igraph_bool_t start,
                             const igraph_integer_t n_iterations,
                             igraph_vector_int_t *membership, igraph_integer_t *nb_clusters, igraph_real_t *quality) {
+    igraph_integer_t parallel_min_edges = -1;
+
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+    if (omp_get_max_threads() > 1) {
+        parallel_min_edges = IGRAPH_I_LEIDEN_PARALLEL_MIN_EDGES;
+    }
+#endif
+
+    return igraph_i_community_leiden_parallel(graph, edge_weights, node_weights,
+                                              resolution_parameter, beta, start, n_iterations,
+                                              membership, nb_clusters, quality, parallel_min_edges);
+}
+
+igraph_error_t igraph_i_community_leiden_parallel(
+        const igraph_t *graph,
+        const igraph_vector_t *edge_weights, const igraph_vector_t *node_weights,
+        igraph_real_t resolution_parameter, igraph_real_t beta, igraph_bool_t start,
+        igraph_integer_t n_iterations,
+        igraph_vector_int_t *membership, igraph_integer_t *nb_clusters, igraph_real_t *quality,
+        igraph_integer_t parallel_min_edges) {
     igraph_vector_t *i_edge_weights, *i_node_weights;
     igraph_integer_t i_nb_clusters;
     igraph_integer_t n = igraph_vcount(graph);
@@ -1032,13 +1746,28 @@ igraph_error_t igraph_community_leiden(const igraph_t *graph,
      * each iteration explores different subsets of nodes.
      */
     igraph_bool_t changed = true;
+    igraph_workspace_t ws;
+    igraph_i_leiden_parallel_t par;
+    IGRAPH_CHECK(igraph_workspace_init(&ws));
+    IGRAPH_FINALLY(igraph_workspace_destroy, &ws);
+    if (parallel_min_edges >= 0) {
+        IGRAPH_CHECK(igraph_i_leiden_parallel_init(&par, parallel_min_edges));
+        IGRAPH_FINALLY(igraph_i_leiden_parallel_destroy, &par);
+    }
     for (igraph_integer_t itr = 0;
          n_iterations < 0 ? changed : itr < n_iterations;
          itr++) {
         IGRAPH_CHECK(igraph_i_community_leiden(graph, i_edge_weights, i_node_weights,
                                                resolution_parameter, beta,
-                                               membership, nb_clusters, quality, &changed));
+                                               membership, nb_clusters, quality, &changed, &ws,
+                                               parallel_min_edges >= 0 ? &par : NULL));
     }
+    if (parallel_min_edges >= 0) {
+        igraph_i_leiden_parallel_destroy(&par);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
+    igraph_workspace_destroy(&ws);
+    IGRAPH_FINALLY_CLEAN(1);
 
     if (!edge_weights) {
         igraph_vector_destroy(i_edge_weights);
@@ -1054,3 +1783,531 @@ igraph_error_t igraph_community_leiden(const igraph_t *graph,
 
     return IGRAPH_SUCCESS;
 }
+
+/* State of the incremental update of a partition. The clusters are
+ * identified by integers in the range 0 .. n-1, and 'empty_clusters'
+ * contains exactly the identifiers that are not in use. The members of each
+ * cluster are kept in a doubly linked list, so that the clusters to split can
+ * be traversed without scanning all nodes. */
+typedef struct {
+    const igraph_t *graph;
+    const igraph_vector_t *edge_weights;
+    const igraph_vector_t *node_weights;
+    igraph_real_t resolution_parameter;
+    igraph_vector_int_t *membership;
+    igraph_vector_t cluster_weights;
+    igraph_vector_int_t nb_nodes_per_cluster;
+    igraph_vector_int_t first_member;   /* -1 for empty clusters */
+    igraph_vector_int_t next_member;    /* -1 for the last member */
+    igraph_vector_int_t prev_member;    /* -1 for the first member */
+    igraph_stack_int_t empty_clusters;
+    igraph_dqueue_int_t unstable_nodes;
+    igraph_bitset_t node_is_unstable;
+    igraph_vector_int_t clusters_to_check;
+    igraph_bitset_t cluster_is_checked;
+    igraph_bitset_t node_is_visited;
+    igraph_vector_int_t incident;
+    igraph_vector_t edge_weights_per_cluster;
+    igraph_bitset_t neighbor_cluster_added;
+    igraph_vector_int_t neighbor_clusters;
+} igraph_i_leiden_update_t;
+
+static void igraph_i_leiden_update_destroy(igraph_i_leiden_update_t *state) {
+    igraph_vector_int_destroy(&state->neighbor_clusters);
+    igraph_bitset_destroy(&state->neighbor_cluster_added);
+    igraph_vector_destroy(&state->edge_weights_per_cluster);
+    igraph_vector_int_destroy(&state->incident);
+    igraph_bitset_destroy(&state->node_is_visited);
+    igraph_bitset_destroy(&state->cluster_is_checked);
+    igraph_vector_int_destroy(&state->clusters_to_check);
+    igraph_bitset_destroy(&state->node_is_unstable);
+    igraph_dqueue_int_destroy(&state->unstable_nodes);
+    igraph_stack_int_destroy(&state->empty_clusters);
+    igraph_vector_int_destroy(&state->prev_member);
+    igraph_vector_int_destroy(&state->next_member);
+    igraph_vector_int_destroy(&state->first_member);
+    igraph_vector_int_destroy(&state->nb_nodes_per_cluster);
+    igraph_vector_destroy(&state->cluster_weights);
+}
+
+/* Inserts a node at the front of the member list of a cluster. */
+static void igraph_i_leiden_update_link(igraph_i_leiden_update_t *state,
+                                        igraph_integer_t v, igraph_integer_t c) {
+    igraph_integer_t first = VECTOR(state->first_member)[c];
+    VECTOR(state->prev_member)[v] = -1;
+    VECTOR(state->next_member)[v] = first;
+    if (first >= 0) {
+        VECTOR(state->prev_member)[first] = v;
+    }
+    VECTOR(state->first_member)[c] = v;
+}
+
+/* Removes a node from the member list of cluster c. */
+static void igraph_i_leiden_update_unlink(igraph_i_leiden_update_t *state,
+                                          igraph_integer_t v, igraph_integer_t c) {
+    igraph_integer_t prev = VECTOR(state->prev_member)[v];
+    igraph_integer_t next = VECTOR(state->next_member)[v];
+    if (prev >= 0) {
+        VECTOR(state->next_member)[prev] = next;
+    } else {
+        VECTOR(state->first_member)[c] = next;
+    }
+    if (next >= 0) {
+        VECTOR(state->prev_member)[next] = prev;
+    }
+}
+
+static igraph_error_t igraph_i_leiden_update_init(
+        igraph_i_leiden_update_t *state, const igraph_t *graph,
+        const igraph_vector_t *edge_weights, const igraph_vector_t *node_weights,
+        igraph_real_t resolution_parameter, igraph_vector_int_t *membership) {
+    const igraph_integer_t n = igraph_vcount(graph);
+
+    state->graph = graph;
+    state->edge_weights = edge_weights;
+    state->node_weights = node_weights;
+    state->resolution_parameter = resolution_parameter;
+    state->membership = membership;
+
+    IGRAPH_VECTOR_INIT_FINALLY(&state->cluster_weights, n);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&state->nb_nodes_per_cluster, n);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&state->first_member, n);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&state->next_member, n);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&state->prev_member, n);
+    IGRAPH_STACK_INT_INIT_FINALLY(&state->empty_clusters, n);
+    IGRAPH_DQUEUE_INT_INIT_FINALLY(&state->unstable_nodes, 100);
+    IGRAPH_BITSET_INIT_FINALLY(&state->node_is_unstable, n);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&state->clusters_to_check, 0);
+    IGRAPH_BITSET_INIT_FINALLY(&state->cluster_is_checked, n);
+    IGRAPH_BITSET_INIT_FINALLY(&state->node_is_visited, n);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&state->incident, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&state->edge_weights_per_cluster, n);
+    IGRAPH_BITSET_INIT_FINALLY(&state->neighbor_cluster_added, n);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&state->neighbor_clusters, 0);
+
+    igraph_vector_int_fill(&state->first_member, -1);
+    for (igraph_integer_t i = n - 1; i >= 0; i--) {
+        igraph_integer_t c = VECTOR(*membership)[i];
+        VECTOR(state->cluster_weights)[c] += node_weights ? VECTOR(*node_weights)[i] : 1;
+        VECTOR(state->nb_nodes_per_cluster)[c] += 1;
+        igraph_i_leiden_update_link(state, i, c);
+    }
+    for (igraph_integer_t c = n - 1; c >= 0; c--) {
+        if (VECTOR(state->nb_nodes_per_cluster)[c] == 0) {
+            IGRAPH_CHECK(igraph_stack_int_push(&state->empty_clusters, c));
+        }
+    }
+
+    IGRAPH_FINALLY_CLEAN(15);
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Adds a node to the queue of nodes that need to be examined, unless it is
+ * already there. */
+static igraph_error_t igraph_i_leiden_update_add_node(igraph_i_leiden_update_t *state, igraph_integer_t v) {
+    if (!IGRAPH_BIT_TEST(state->node_is_unstable, v)) {
+        IGRAPH_CHECK(igraph_dqueue_int_push(&state->unstable_nodes, v));
+        IGRAPH_BIT_SET(state->node_is_unstable, v);
+    }
+    return IGRAPH_SUCCESS;
+}
+
+/* Marks a cluster whose connectedness must be checked. */
+static igraph_error_t igraph_i_leiden_update_add_cluster(igraph_i_leiden_update_t *state, igraph_integer_t c) {
+    if (!IGRAPH_BIT_TEST(state->cluster_is_checked, c)) {
+        IGRAPH_CHECK(igraph_vector_int_push_back(&state->clusters_to_check, c));
+        IGRAPH_BIT_SET(state->cluster_is_checked, c);
+    }
+    return IGRAPH_SUCCESS;
+}
+
+/* Splits the marked clusters into their connected components. The first
+ * component found in a cluster keeps its identifier, the others are moved to
+ * empty clusters, and their nodes are added to the queue. Splitting a
+ * disconnected cluster never decreases the quality when the resolution
+ * parameter and the node weights are non-negative. */
+static igraph_error_t igraph_i_leiden_update_split_clusters(igraph_i_leiden_update_t *state) {
+    const igraph_t *graph = state->graph;
+    igraph_vector_int_t *membership = state->membership;
+    igraph_bitset_t *visited = &state->node_is_visited;
+    igraph_integer_t nb_checked = igraph_vector_int_size(&state->clusters_to_check);
+    igraph_integer_t nb_members;
+    igraph_vector_int_t members;
+    igraph_dqueue_int_t to_visit;
+
+    if (nb_checked == 0) {
+        return IGRAPH_SUCCESS;
+    }
+
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&members, 0);
+    IGRAPH_DQUEUE_INT_INIT_FINALLY(&to_visit, 100);
+
+    for (igraph_integer_t i = 0; i < nb_checked; i++) {
+        igraph_integer_t c = VECTOR(state->clusters_to_check)[i];
+        for (igraph_integer_t v = VECTOR(state->first_member)[c]; v >= 0; v = VECTOR(state->next_member)[v]) {
+            IGRAPH_CHECK(igraph_vector_int_push_back(&members, v));
+        }
+    }
+    nb_members = igraph_vector_int_size(&members);
+
+    /* The bit of a cluster stays set until its first component is found. */
+    for (igraph_integer_t i = 0; i < nb_members; i++) {
+        igraph_integer_t v = VECTOR(members)[i];
+        igraph_integer_t c = VECTOR(*membership)[v], new_c = c;
+
+        if (IGRAPH_BIT_TEST(*visited, v)) {
+            continue;
+        }
+
+        if (IGRAPH_BIT_TEST(state->cluster_is_checked, c)) {
+            IGRAPH_BIT_CLEAR(state->cluster_is_checked, c);
+        } else {
+            new_c = igraph_stack_int_pop(&state->empty_clusters);
+        }
+
+        IGRAPH_BIT_SET(*visited, v);
+        IGRAPH_CHECK(igraph_dqueue_int_push(&to_visit, v));
+        while (!igraph_dqueue_int_empty(&to_visit)) {
+            igraph_integer_t u = igraph_dqueue_int_pop(&to_visit);
+            igraph_integer_t degree;
+
+            if (new_c != c) {
+                igraph_real_t node_weight = state->node_weights ? VECTOR(*state->node_weights)[u] : 1;
+                VECTOR(*membership)[u] = new_c;
+                igraph_i_leiden_update_unlink(state, u, c);
+                igraph_i_leiden_update_link(state, u, new_c);
+                VECTOR(state->cluster_weights)[c] -= node_weight;
+                VECTOR(state->cluster_weights)[new_c] += node_weight;
+                VECTOR(state->nb_nodes_per_cluster)[c]--;
+                VECTOR(state->nb_nodes_per_cluster)[new_c]++;
+                IGRAPH_CHECK(igraph_i_leiden_update_add_node(state, u));
+            }
+
+            IGRAPH_CHECK(igraph_incident(graph, &state->incident, u, IGRAPH_ALL));
+            degree = igraph_vector_int_size(&state->incident);
+            for (igraph_integer_t j = 0; j < degree; j++) {
+                igraph_integer_t w = IGRAPH_OTHER(graph, VECTOR(state->incident)[j], u);
+                if (VECTOR(*membership)[w] == c && !IGRAPH_BIT_TEST(*visited, w)) {
+                    IGRAPH_BIT_SET(*visited, w);
+                    IGRAPH_CHECK(igraph_dqueue_int_push(&to_visit, w));
+                }
+            }
+        }
+    }
+
+    /* Clusters that became empty after they were marked are not visited */
+    for (igraph_integer_t i = 0; i < nb_checked; i++) {
+        IGRAPH_BIT_CLEAR(state->cluster_is_checked, VECTOR(state->clusters_to_check)[i]);
+    }
+    igraph_vector_int_clear(&state->clusters_to_check);
+    for (igraph_integer_t i = 0; i < nb_members; i++) {
+        IGRAPH_BIT_CLEAR(*visited, VECTOR(members)[i]);
+    }
+
+    igraph_dqueue_int_destroy(&to_visit);
+    igraph_vector_int_destroy(&members);
+    IGRAPH_FINALLY_CLEAN(2);
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Moves the nodes in the queue as in igraph_i_community_leiden_fastmovenodes(),
+ * and marks the clusters that nodes leave, as these may become disconnected. */
+static igraph_error_t igraph_i_leiden_update_movenodes(igraph_i_leiden_update_t *state) {
+    const igraph_t *graph = state->graph;
+    const igraph_vector_t *edge_weights = state->edge_weights;
+    const igraph_vector_t *node_weights = state->node_weights;
+    igraph_vector_int_t *membership = state->membership;
+    igraph_vector_t *cluster_weights = &state->cluster_weights;
+    igraph_vector_t *edge_weights_per_cluster = &state->edge_weights_per_cluster;
+    int iter = 0;
+
+    while (!igraph_dqueue_int_empty(&state->unstable_nodes)) {
+        igraph_integer_t v = igraph_dqueue_int_pop(&state->unstable_nodes);
+        igraph_integer_t best_cluster, current_cluster = VECTOR(*membership)[v];
+        igraph_integer_t degree, c, nb_neigh_clusters;
+        igraph_real_t node_weight = node_weights ? VECTOR(*node_weights)[v] : 1;
+        igraph_real_t max_diff, diff;
+
+        IGRAPH_BIT_CLEAR(state->node_is_unstable, v);
+
+        /* Remove node from current cluster */
+        VECTOR(*cluster_weights)[current_cluster] -= node_weight;
+        VECTOR(state->nb_nodes_per_cluster)[current_cluster]--;
+        if (VECTOR(state->nb_nodes_per_cluster)[current_cluster] == 0) {
+            IGRAPH_CHECK(igraph_stack_int_push(&state->empty_clusters, current_cluster));
+        }
+
+        /* Find out neighboring clusters */
+        igraph_vector_int_clear(&state->neighbor_clusters);
+        c = igraph_stack_int_top(&state->empty_clusters);
+        IGRAPH_CHECK(igraph_vector_int_push_back(&state->neighbor_clusters, c));
+        IGRAPH_BIT_SET(state->neighbor_cluster_added, c);
+
+        /* Determine the edge weight to each neighboring cluster */
+        IGRAPH_CHECK(igraph_incident(graph, &state->incident, v, IGRAPH_ALL));
+        degree = igraph_vector_int_size(&state->incident);
+        for (igraph_integer_t i = 0; i < degree; i++) {
+            igraph_integer_t e = VECTOR(state->incident)[i];
+            igraph_integer_t u = IGRAPH_OTHER(graph, e, v);
+            if (u != v) {
+                c = VECTOR(*membership)[u];
+                if (!IGRAPH_BIT_TEST(state->neighbor_cluster_added, c)) {
+                    IGRAPH_BIT_SET(state->neighbor_cluster_added, c);
+                    IGRAPH_CHECK(igraph_vector_int_push_back(&state->neighbor_clusters, c));
+                }
+                VECTOR(*edge_weights_per_cluster)[c] += edge_weights ? VECTOR(*edge_weights)[e] : 1;
+            }
+        }
+
+        /* Calculate maximum diff */
+        best_cluster = current_cluster;
+        max_diff = VECTOR(*edge_weights_per_cluster)[current_cluster] -
+                   node_weight * VECTOR(*cluster_weights)[current_cluster] * state->resolution_parameter;
+        nb_neigh_clusters = igraph_vector_int_size(&state->neighbor_clusters);
+        for (igraph_integer_t i = 0; i < nb_neigh_clusters; i++) {
+            c = VECTOR(state->neighbor_clusters)[i];
+            diff = VECTOR(*edge_weights_per_cluster)[c] -
+                   node_weight * VECTOR(*cluster_weights)[c] * state->resolution_parameter;
+            /* Only consider strictly improving moves. */
+            if (diff > max_diff) {
+                best_cluster = c;
+                max_diff = diff;
+            }
+            VECTOR(*edge_weights_per_cluster)[c] = 0.0;
+            IGRAPH_BIT_CLEAR(state->neighbor_cluster_added, c);
+        }
+
+        /* Move node to best cluster */
+        VECTOR(*cluster_weights)[best_cluster] += node_weight;
+        VECTOR(state->nb_nodes_per_cluster)[best_cluster]++;
+        if (best_cluster == igraph_stack_int_top(&state->empty_clusters)) {
+            igraph_stack_int_pop(&state->empty_clusters);
+        }
+
+        /* Add neighbours that are not part of the new cluster to the queue */
+        if (best_cluster != current_cluster) {
+            VECTOR(*membership)[v] = best_cluster;
+            igraph_i_leiden_update_unlink(state, v, current_cluster);
+            igraph_i_leiden_update_link(state, v, best_cluster);
+
+            if (VECTOR(state->nb_nodes_per_cluster)[current_cluster] > 1) {
+                IGRAPH_CHECK(igraph_i_leiden_update_add_cluster(state, current_cluster));
+            }
+
+            for (igraph_integer_t i = 0; i < degree; i++) {
+                igraph_integer_t u = IGRAPH_OTHER(graph, VECTOR(state->incident)[i], v);
+                if (VECTOR(*membership)[u] != best_cluster) {
+                    IGRAPH_CHECK(igraph_i_leiden_update_add_node(state, u));
+                }
+            }
+        }
+
+        IGRAPH_ALLOW_INTERRUPTION_LIMITED(iter, 1 << 14);
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \ingroup communities
+ * \function igraph_community_leiden_update
+ * \brief Updates a community structure after edges were inserted or deleted.
+ *
+ * \experimental
+ *
+ * When only a few edges of a large graph change, most of its community
+ * structure remains a good solution. This function takes a partition that
+ * was found before the change, e.g. by \ref igraph_community_leiden() or
+ * \ref igraph_community_multilevel(), and improves it for the current graph
+ * by moving only the nodes that are affected by the change, instead of
+ * searching for communities from scratch.
+ *
+ * </para><para>
+ * First, clusters that contained both endpoints of a changed edge are split
+ * into their connected components, because deleting edges may have
+ * disconnected them. Then the endpoints of the changed edges, the nodes of
+ * the components split off and the new nodes are moved greedily, as
+ * in the local moving phase of the Leiden algorithm: a node is moved to the
+ * neighboring or empty cluster that improves the quality the most, and when
+ * it is moved, those of its neighbors that are not in its new cluster are
+ * examined as well. Clusters that nodes have left are split into their
+ * connected components again, and this is repeated until no node moves.
+ * Only moves that strictly improve the quality are made. Apart from a few
+ * passes over the vertices to set up the clusters and to renumber them at
+ * the end, the amount of work depends on the number of examined nodes and
+ * on the sizes of the clusters that are split, and not on the size of the
+ * whole graph. Unlike \ref igraph_community_leiden(), this function does
+ * not refine or aggregate the partition, so it does not merge whole
+ * clusters.
+ *
+ * </para><para>
+ * Only the clusters that are split or that nodes leave are guaranteed to be
+ * connected in the result. Other clusters are taken over as they are, so if
+ * the input partition contains disconnected clusters, as
+ * \ref igraph_community_multilevel() may produce, some of these may remain
+ * disconnected. Run \ref igraph_community_leiden() starting from the
+ * partition if connected clusters are required.
+ *
+ * </para><para>
+ * The quality function is the same as in \ref igraph_community_leiden().
+ * To update a partition found by \ref igraph_community_multilevel() with
+ * the resolution parameter \c γ, supply the strengths of the vertices in
+ * the current graph as \p node_weights, and <code>γ/(2m)</code> as
+ * \p resolution_parameter, where \c m is the current total edge weight.
+ *
+ * \param graph The input graph, after the change. It must be undirected.
+ *    Vertices may have been added to the end of its vertex sequence, but
+ *    not removed.
+ * \param edge_weights Numeric vector containing edge weights. If \c NULL,
+ *    every edge has equal weight of 1.
+ * \param node_weights Numeric vector containing node weights. If \c NULL,
+ *    every node has equal weight of 1. They must be non-negative.
+ * \param resolution_parameter The resolution parameter, see
+ *    \ref igraph_community_leiden(). It must be non-negative.
+ * \param changed_edges The endpoints of the inserted and deleted edges, in
+ *    the same format as in \ref igraph_create(): the first two elements are
+ *    the endpoints of the first edge, etc.
+ * \param membership The membership vector of the partition before the
+ *    change. It may be shorter than the number of vertices, in which case the
+ *    remaining vertices are put into new clusters of their own. The updated
+ *    partition is returned here, with clusters numbered from zero.
+ * \param nb_clusters The number of clusters is returned here, if not
+ *    \c NULL.
+ * \param quality The quality of the updated partition is returned here, if
+ *    not \c NULL. Calculating it takes time proportional to the size of
+ *    the graph.
+ * \return Error code:
+ *         \c IGRAPH_EINVAL, invalid parameters or membership vector.
+ *         \c IGRAPH_EINVVID, invalid vertex ID in \p changed_edges.
+ *
+ * Time complexity: O(|V|) for the initialization and the renumbering of the
+ * clusters, plus the sum of the degrees of the examined nodes and of the
+ * nodes of the split clusters. Calculating \p quality adds O(|V| + |E|).
+ *
+ * \sa \ref igraph_community_leiden() to find communities from scratch.
+ */
+igraph_error_t igraph_community_leiden_update(
+        const igraph_t *graph,
+        const igraph_vector_t *edge_weights, const igraph_vector_t *node_weights,
+        igraph_real_t resolution_parameter,
+        const igraph_vector_int_t *changed_edges,
+        igraph_vector_int_t *membership, igraph_integer_t *nb_clusters, igraph_real_t *quality) {
+    const igraph_integer_t n = igraph_vcount(graph);
+    const igraph_integer_t old_n = igraph_vector_int_size(membership);
+    const igraph_integer_t nb_changed = igraph_vector_int_size(changed_edges);
+    igraph_i_leiden_update_t state;
+    igraph_vector_int_t affected;
+    igraph_integer_t i_nb_clusters;
+
+    if (igraph_is_directed(graph)) {
+        IGRAPH_ERROR("Leiden algorithm is only implemented for undirected graphs.", IGRAPH_EINVAL);
+    }
+    if (old_n > n) {
+        IGRAPH_ERROR("Membership vector is longer than the number of vertices.", IGRAPH_EINVAL);
+    }
+    if (old_n > 0 && igraph_vector_int_min(membership) < 0) {
+        IGRAPH_ERROR("Cluster indices must not be negative.", IGRAPH_EINVAL);
+    }
+    if (edge_weights && igraph_vector_size(edge_weights) != igraph_ecount(graph)) {
+        IGRAPH_ERROR("Edge weight vector length must agree with number of edges.", IGRAPH_EINVAL);
+    }
+    if (node_weights) {
+        if (igraph_vector_size(node_weights) != n) {
+            IGRAPH_ERROR("Node weight vector length must agree with number of nodes.", IGRAPH_EINVAL);
+        }
+        if (n > 0 && !(igraph_vector_min(node_weights) >= 0)) {
+            IGRAPH_ERROR("Node weights must not be negative.", IGRAPH_EINVAL);
+        }
+    }
+    if (!(resolution_parameter >= 0)) {
+        IGRAPH_ERROR("The resolution parameter must be non-negative.", IGRAPH_EINVAL);
+    }
+    if (nb_changed % 2 != 0) {
+        IGRAPH_ERROR("Invalid changed edge vector, its length must be even.", IGRAPH_EINVAL);
+    }
+    if (!igraph_vector_int_isininterval(changed_edges, 0, n - 1)) {
+        IGRAPH_ERROR("Invalid vertex ID in changed edge vector.", IGRAPH_EINVVID);
+    }
+
+    if (!nb_clusters) {
+        nb_clusters = &i_nb_clusters;
+    }
+
+    /* New vertices are put into clusters of their own */
+    if (old_n < n) {
+        igraph_integer_t next = old_n > 0 ? igraph_vector_int_max(membership) + 1 : 0;
+        IGRAPH_CHECK(igraph_vector_int_resize(membership, n));
+        for (igraph_integer_t v = old_n; v < n; v++) {
+            VECTOR(*membership)[v] = next++;
+        }
+    }
+    IGRAPH_CHECK(igraph_reindex_membership(membership, NULL, NULL));
+
+    IGRAPH_CHECK(igraph_i_leiden_update_init(&state, graph, edge_weights, node_weights,
+                                             resolution_parameter, membership));
+    IGRAPH_FINALLY(igraph_i_leiden_update_destroy, &state);
+
+    /* Collect the affected nodes, and the clusters that may have become
+     * disconnected. They are examined in a random order. */
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&affected, 0);
+    for (igraph_integer_t i = 0; i < nb_changed; i += 2) {
+        igraph_integer_t from = VECTOR(*changed_edges)[i], to = VECTOR(*changed_edges)[i + 1];
+        if (from != to && VECTOR(*membership)[from] == VECTOR(*membership)[to]) {
+            IGRAPH_CHECK(igraph_i_leiden_update_add_cluster(&state, VECTOR(*membership)[from]));
+        }
+        IGRAPH_CHECK(igraph_vector_int_push_back(&affected, from));
+        IGRAPH_CHECK(igraph_vector_int_push_back(&affected, to));
+    }
+    for (igraph_integer_t v = old_n; v < n; v++) {
+        IGRAPH_CHECK(igraph_vector_int_push_back(&affected, v));
+    }
+    IGRAPH_CHECK(igraph_vector_int_shuffle(&affected));
+    for (igraph_integer_t i = 0; i < igraph_vector_int_size(&affected); i++) {
+        IGRAPH_CHECK(igraph_i_leiden_update_add_node(&state, VECTOR(affected)[i]));
+    }
+    igraph_vector_int_destroy(&affected);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    IGRAPH_CHECK(igraph_i_leiden_update_split_clusters(&state));
+    while (!igraph_dqueue_int_empty(&state.unstable_nodes)) {
+        IGRAPH_CHECK(igraph_i_leiden_update_movenodes(&state));
+        IGRAPH_CHECK(igraph_i_leiden_update_split_clusters(&state));
+    }
+
+    igraph_i_leiden_update_destroy(&state);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    IGRAPH_CHECK(igraph_reindex_membership(membership, NULL, nb_clusters));
+
+    if (quality) {
+        igraph_vector_t i_edge_weights, i_node_weights;
+
+        if (!edge_weights) {
+            IGRAPH_VECTOR_INIT_FINALLY(&i_edge_weights, igraph_ecount(graph));
+            igraph_vector_fill(&i_edge_weights, 1);
+        }
+        if (!node_weights) {
+            IGRAPH_VECTOR_INIT_FINALLY(&i_node_weights, n);
+            igraph_vector_fill(&i_node_weights, 1);
+        }
+
+        IGRAPH_CHECK(igraph_i_community_leiden_quality(graph,
+                                                       edge_weights ? edge_weights : &i_edge_weights,
+                                                       node_weights ? node_weights : &i_node_weights,
+                                                       membership, *nb_clusters, resolution_parameter,
+                                                       quality));
+
+        if (!node_weights) {
+            igraph_vector_destroy(&i_node_weights);
+            IGRAPH_FINALLY_CLEAN(1);
+        }
+        if (!edge_weights) {
+            igraph_vector_destroy(&i_edge_weights);
+            IGRAPH_FINALLY_CLEAN(1);
+        }
+    }
+
+    return IGRAPH_SUCCESS;
+}
@@ -0,0 +1,48 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IGRAPH_COMMUNITY_LEIDEN_H
+#define IGRAPH_COMMUNITY_LEIDEN_H
+
+#include "igraph_decls.h"
+#include "igraph_datatype.h"
+#include "igraph_vector.h"
+
+__BEGIN_DECLS
+
+/* igraph_community_leiden() uses the parallel variant of the algorithm on
+ * each level of the aggregation that has at least this many edges, when
+ * igraph is compiled with OpenMP and more than one thread is available. */
+#define IGRAPH_I_LEIDEN_PARALLEL_MIN_EDGES 100000
+
+/* Same as igraph_community_leiden(), but the parallel variant is used on
+ * every level with at least 'parallel_min_edges' edges, also when there is
+ * only one thread. A negative value disables the parallel variant. For a
+ * given seed, the result of the parallel variant does not depend on the
+ * number of threads, but it differs from the result of the serial one. */
+IGRAPH_PRIVATE_EXPORT igraph_error_t igraph_i_community_leiden_parallel(
+        const igraph_t *graph,
+        const igraph_vector_t *edge_weights, const igraph_vector_t *node_weights,
+        igraph_real_t resolution_parameter, igraph_real_t beta, igraph_bool_t start,
+        igraph_integer_t n_iterations,
+        igraph_vector_int_t *membership, igraph_integer_t *nb_clusters, igraph_real_t *quality,
+        igraph_integer_t parallel_min_edges);
+
+__END_DECLS
+
+#endif
@@ -23,8 +23,6 @@
 
 #include "igraph_community.h"
 
-#include "igraph_constructors.h"
-#include "igraph_conversion.h"
 #include "igraph_interface.h"
 #include "igraph_memory.h"
 #include "igraph_qsort.h"
@@ -45,7 +43,6 @@ typedef struct {
     igraph_real_t weight_sum;              /* Sum of edges weight in the whole graph */
     igraph_i_multilevel_community *item;   /* List of communities */
     igraph_vector_int_t *membership;       /* Community IDs */
-    igraph_vector_t *weights;              /* Graph edge weights */
 } igraph_i_multilevel_community_list;
 
 /* Computes the modularity of a community partitioning */
@@ -64,84 +61,75 @@ static igraph_real_t igraph_i_multilevel_community_modularity(
     return result;
 }
 
+/* Weighted graph in compressed sparse row format, used for the graphs of
+ * communities. The neighbors of vertex v are neis[offsets[v]], ...,
+ * neis[offsets[v+1] - 1], and the edge weights are stored in the same
+ * positions of 'weights'. Each edge appears in the neighbor lists of both
+ * of its endpoints; a self-loop appears once, with twice its weight, so
+ * that the weights in the neighbor list of a vertex sum to its strength. */
 typedef struct {
-    igraph_integer_t from;
-    igraph_integer_t to;
-    igraph_integer_t id;
-} igraph_i_multilevel_link;
-
-static int igraph_i_multilevel_link_cmp(const void *a, const void *b) {
-    igraph_integer_t diff;
-
-    diff = ((igraph_i_multilevel_link*)a)->from - ((igraph_i_multilevel_link*)b)->from;
-
-    if (diff < 0) {
-        return -1;
-    } else if (diff > 0) {
-        return 1;
-    }
-
-    diff = ((igraph_i_multilevel_link*)a)->to - ((igraph_i_multilevel_link*)b)->to;
-
-    if (diff < 0) {
-        return -1;
-    } else if (diff > 0) {
-        return 1;
-    } else {
-        return 0;
-    }
+    igraph_integer_t no_of_nodes;
+    igraph_vector_int_t offsets;
+    igraph_vector_int_t neis;
+    igraph_vector_t weights;
+} igraph_i_multilevel_graph;
+
+static void igraph_i_multilevel_graph_destroy(igraph_i_multilevel_graph *graph) {
+    igraph_vector_destroy(&graph->weights);
+    igraph_vector_int_destroy(&graph->neis);
+    igraph_vector_int_destroy(&graph->offsets);
 }
 
-/* removes multiple edges and returns new edge IDs for each edge in |E|log|E| */
-static igraph_error_t igraph_i_multilevel_simplify_multiple(igraph_t *graph, igraph_vector_int_t *eids) {
-    igraph_integer_t ecount = igraph_ecount(graph);
-    igraph_integer_t l = -1, last_from = -1, last_to = -1;
-    igraph_bool_t directed = igraph_is_directed(graph);
-    igraph_vector_int_t edges;
-    igraph_i_multilevel_link *links;
-
-    /* Make sure there's enough space in eids to store the new edge IDs */
-    IGRAPH_CHECK(igraph_vector_int_resize(eids, ecount));
-
-    links = IGRAPH_CALLOC(ecount, igraph_i_multilevel_link);
-    IGRAPH_CHECK_OOM(links, "Multi-level community structure detection failed.");
-    IGRAPH_FINALLY(igraph_free, links);
-
-    for (igraph_integer_t i = 0; i < ecount; i++) {
-        links[i].from = IGRAPH_FROM(graph, i);
-        links[i].to = IGRAPH_TO(graph, i);
-        links[i].id = i;
+static igraph_error_t igraph_i_multilevel_graph_init(
+        igraph_i_multilevel_graph *graph, const igraph_t *orig, const igraph_vector_t *weights) {
+    igraph_integer_t no_of_nodes = igraph_vcount(orig);
+    igraph_integer_t no_of_edges = igraph_ecount(orig);
+    igraph_integer_t no_of_entries = 0;
+
+    graph->no_of_nodes = no_of_nodes;
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&graph->offsets, no_of_nodes + 1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&graph->neis, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&graph->weights, 0);
+
+    /* Count the entries of each vertex, then place them with a counting sort */
+    for (igraph_integer_t e = 0; e < no_of_edges; e++) {
+        igraph_integer_t from = IGRAPH_FROM(orig, e), to = IGRAPH_TO(orig, e);
+        VECTOR(graph->offsets)[from + 1]++;
+        if (from != to) {
+            VECTOR(graph->offsets)[to + 1]++;
+        }
     }
-
-    igraph_qsort(links, (size_t) ecount, sizeof(igraph_i_multilevel_link),
-                 igraph_i_multilevel_link_cmp);
-
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&edges, 0);
-    for (igraph_integer_t i = 0; i < ecount; i++) {
-        if (links[i].from == last_from && links[i].to == last_to) {
-            VECTOR(*eids)[links[i].id] = l;
-            continue;
+    for (igraph_integer_t v = 0; v < no_of_nodes; v++) {
+        VECTOR(graph->offsets)[v + 1] += VECTOR(graph->offsets)[v];
+    }
+    no_of_entries = VECTOR(graph->offsets)[no_of_nodes];
+    IGRAPH_CHECK(igraph_vector_int_resize(&graph->neis, no_of_entries));
+    IGRAPH_CHECK(igraph_vector_resize(&graph->weights, no_of_entries));
+
+    for (igraph_integer_t e = 0; e < no_of_edges; e++) {
+        igraph_integer_t from = IGRAPH_FROM(orig, e), to = IGRAPH_TO(orig, e);
+        igraph_real_t weight = weights ? VECTOR(*weights)[e] : 1;
+        if (from == to) {
+            igraph_integer_t pos = VECTOR(graph->offsets)[from]++;
+            VECTOR(graph->neis)[pos] = from;
+            VECTOR(graph->weights)[pos] = 2 * weight;
+        } else {
+            igraph_integer_t pos = VECTOR(graph->offsets)[from]++;
+            VECTOR(graph->neis)[pos] = to;
+            VECTOR(graph->weights)[pos] = weight;
+            pos = VECTOR(graph->offsets)[to]++;
+            VECTOR(graph->neis)[pos] = from;
+            VECTOR(graph->weights)[pos] = weight;
         }
-
-        last_from = links[i].from;
-        last_to = links[i].to;
-
-        igraph_vector_int_push_back(&edges, last_from);
-        igraph_vector_int_push_back(&edges, last_to);
-
-        l++;
-
-        VECTOR(*eids)[links[i].id] = l;
     }
 
-    IGRAPH_FREE(links);
-    IGRAPH_FINALLY_CLEAN(1);
-
-    igraph_destroy(graph);
-    IGRAPH_CHECK(igraph_create(graph, &edges, igraph_vcount(graph), directed));
+    /* The offsets were shifted by one vertex while placing the entries */
+    for (igraph_integer_t v = no_of_nodes; v > 0; v--) {
+        VECTOR(graph->offsets)[v] = VECTOR(graph->offsets)[v - 1];
+    }
+    VECTOR(graph->offsets)[0] = 0;
 
-    igraph_vector_int_destroy(&edges);
-    IGRAPH_FINALLY_CLEAN(1);
+    IGRAPH_FINALLY_CLEAN(3);
 
     return IGRAPH_SUCCESS;
 }
@@ -163,8 +151,7 @@ static int igraph_i_multilevel_community_link_cmp(const void *a, const void *b)
  * Given a graph, a community structure and a vertex ID, this method
  * calculates:
  *
- * - edges: the list of edge IDs that are incident on the vertex
- * - weight_all: the total weight of these edges
+ * - weight_all: the total weight of the edges incident on the vertex
  * - weight_inside: the total weight of edges that stay within the same
  *   community where the given vertex is right now, excluding loop edges
  * - weight_loop: the total weight of loop edges
@@ -173,13 +160,14 @@ static int igraph_i_multilevel_community_link_cmp(const void *a, const void *b)
  *   pointing to these communities
  */
 static igraph_error_t igraph_i_multilevel_community_links(
-        const igraph_t *graph,
+        const igraph_i_multilevel_graph *graph,
         const igraph_i_multilevel_community_list *communities,
-        igraph_integer_t vertex, igraph_vector_int_t *edges,
+        igraph_integer_t vertex,
         igraph_real_t *weight_all, igraph_real_t *weight_inside, igraph_real_t *weight_loop,
         igraph_vector_int_t *links_community, igraph_vector_t *links_weight) {
 
     igraph_integer_t n, last = -1, c = -1;
+    igraph_integer_t first = VECTOR(graph->offsets)[vertex];
     igraph_real_t weight = 1;
     igraph_integer_t to, to_community;
     igraph_integer_t community = VECTOR(*(communities->membership))[vertex];
@@ -190,19 +178,14 @@ static igraph_error_t igraph_i_multilevel_community_links(
     igraph_vector_int_clear(links_community);
     igraph_vector_clear(links_weight);
 
-    /* Get the list of incident edges */
-    IGRAPH_CHECK(igraph_incident(graph, edges, vertex, IGRAPH_ALL));
-
-    n = igraph_vector_int_size(edges);
+    n = VECTOR(graph->offsets)[vertex + 1] - first;
     links = IGRAPH_CALLOC(n, igraph_i_multilevel_community_link);
     IGRAPH_CHECK_OOM(links, "Multi-level community structure detection failed.");
     IGRAPH_FINALLY(igraph_free, links);
 
     for (igraph_integer_t i = 0; i < n; i++) {
-        igraph_integer_t eidx = VECTOR(*edges)[i];
-        weight = VECTOR(*communities->weights)[eidx];
-
-        to = IGRAPH_OTHER(graph, eidx, vertex);
+        weight = VECTOR(graph->weights)[first + i];
+        to = VECTOR(graph->neis)[first + i];
 
         *weight_all += weight;
         if (to == vertex) {
@@ -255,17 +238,20 @@ static igraph_real_t igraph_i_multilevel_community_modularity_gain(
            resolution * communities->item[community].weight_all * weight_all / communities->weight_sum;
 }
 
-/* Shrinks communities into single vertices, keeping all the edges.
- * This method is internal because it destroys the graph in-place and
- * creates a new one -- this is fine for the multilevel community
- * detection where a copy of the original graph is used anyway.
+/* Shrinks communities into single vertices. The edges between two
+ * communities are merged into a single edge, whose weight is the sum of
+ * their weights, and the edges within a community into a self-loop. The
+ * vertices are grouped by community with a counting sort, and the weights
+ * to neighboring communities are accumulated in a dense array, so the
+ * new graph is built in linear time.
  * The membership vector will also be rewritten by the underlying
- * igraph_membership_reindex call */
-static igraph_error_t igraph_i_multilevel_shrink(igraph_t *graph, igraph_vector_int_t *membership) {
-    igraph_vector_int_t edges;
-    igraph_integer_t no_of_nodes = igraph_vcount(graph);
-    igraph_integer_t no_of_edges = igraph_ecount(graph);
-    igraph_bool_t directed = igraph_is_directed(graph);
+ * igraph_reindex_membership call */
+static igraph_error_t igraph_i_multilevel_shrink(igraph_i_multilevel_graph *graph, igraph_vector_int_t *membership) {
+    igraph_integer_t no_of_nodes = graph->no_of_nodes;
+    igraph_integer_t no_of_communities;
+    igraph_vector_int_t members, member_offsets, neighbor_communities, last_seen;
+    igraph_vector_int_t offsets, neis;
+    igraph_vector_t weights, weight_to_community;
 
     IGRAPH_ASSERT(igraph_vector_int_size(membership) == no_of_nodes);
 
@@ -273,23 +259,75 @@ static igraph_error_t igraph_i_multilevel_shrink(igraph_t *graph, igraph_vector_
         return IGRAPH_SUCCESS;
     }
 
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&edges, 2*no_of_edges);
-
-    IGRAPH_CHECK(igraph_reindex_membership(membership, NULL, NULL));
+    IGRAPH_CHECK(igraph_reindex_membership(membership, NULL, &no_of_communities));
 
-    /* Create the new edgelist */
-    IGRAPH_CHECK(igraph_get_edgelist(graph, &edges, /* bycol= */ false));
-    for (igraph_integer_t i=0; i < 2*no_of_edges; i++) {
-        VECTOR(edges)[i] = VECTOR(*membership)[ VECTOR(edges)[i] ];
+    /* Sort the vertices by community */
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&member_offsets, no_of_communities + 1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&members, no_of_nodes);
+    for (igraph_integer_t v = 0; v < no_of_nodes; v++) {
+        VECTOR(member_offsets)[VECTOR(*membership)[v]]++;
+    }
+    for (igraph_integer_t c = 1; c <= no_of_communities; c++) {
+        VECTOR(member_offsets)[c] += VECTOR(member_offsets)[c - 1];
     }
+    for (igraph_integer_t v = no_of_nodes - 1; v >= 0; v--) {
+        VECTOR(members)[--VECTOR(member_offsets)[VECTOR(*membership)[v]]] = v;
+    }
+
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&offsets, no_of_communities + 1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&neis, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&weights, 0);
+    IGRAPH_CHECK(igraph_vector_int_reserve(&neis, igraph_vector_int_size(&graph->neis)));
+    IGRAPH_CHECK(igraph_vector_reserve(&weights, igraph_vector_size(&graph->weights)));
+
+    IGRAPH_VECTOR_INIT_FINALLY(&weight_to_community, no_of_communities);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&neighbor_communities, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&last_seen, no_of_communities);
+    igraph_vector_int_fill(&last_seen, -1);
+
+    for (igraph_integer_t c = 0; c < no_of_communities; c++) {
+        igraph_integer_t nb_neighbors;
+
+        igraph_vector_int_clear(&neighbor_communities);
+        for (igraph_integer_t i = VECTOR(member_offsets)[c]; i < VECTOR(member_offsets)[c + 1]; i++) {
+            igraph_integer_t v = VECTOR(members)[i];
+            for (igraph_integer_t j = VECTOR(graph->offsets)[v]; j < VECTOR(graph->offsets)[v + 1]; j++) {
+                igraph_integer_t c2 = VECTOR(*membership)[VECTOR(graph->neis)[j]];
+                if (VECTOR(last_seen)[c2] != c) {
+                    VECTOR(last_seen)[c2] = c;
+                    VECTOR(weight_to_community)[c2] = 0;
+                    IGRAPH_CHECK(igraph_vector_int_push_back(&neighbor_communities, c2));
+                }
+                VECTOR(weight_to_community)[c2] += VECTOR(graph->weights)[j];
+            }
+        }
 
-    /* Create the new graph */
-    igraph_destroy(graph);
-    no_of_nodes = igraph_vector_int_max(membership) + 1;
-    IGRAPH_CHECK(igraph_create(graph, &edges, no_of_nodes, directed));
+        nb_neighbors = igraph_vector_int_size(&neighbor_communities);
+        for (igraph_integer_t i = 0; i < nb_neighbors; i++) {
+            igraph_integer_t c2 = VECTOR(neighbor_communities)[i];
+            IGRAPH_CHECK(igraph_vector_int_push_back(&neis, c2));
+            IGRAPH_CHECK(igraph_vector_push_back(&weights, VECTOR(weight_to_community)[c2]));
+        }
+        VECTOR(offsets)[c + 1] = igraph_vector_int_size(&neis);
+    }
 
-    igraph_vector_int_destroy(&edges);
-    IGRAPH_FINALLY_CLEAN(1);
+    igraph_vector_int_destroy(&last_seen);
+    igraph_vector_int_destroy(&neighbor_communities);
+    igraph_vector_destroy(&weight_to_community);
+    IGRAPH_FINALLY_CLEAN(3);
+
+    /* Replace the graph */
+    igraph_vector_int_swap(&graph->offsets, &offsets);
+    igraph_vector_int_swap(&graph->neis, &neis);
+    igraph_vector_swap(&graph->weights, &weights);
+    graph->no_of_nodes = no_of_communities;
+
+    igraph_vector_destroy(&weights);
+    igraph_vector_int_destroy(&neis);
+    igraph_vector_int_destroy(&offsets);
+    igraph_vector_int_destroy(&members);
+    igraph_vector_int_destroy(&member_offsets);
+    IGRAPH_FINALLY_CLEAN(5);
 
     return IGRAPH_SUCCESS;
 }
@@ -306,10 +344,8 @@ static igraph_error_t igraph_i_multilevel_shrink(igraph_t *graph, igraph_vector_
  *
  * This function was contributed by Tom Gregorovic.
  *
- * \param graph      The input graph. It must be an undirected graph.
- * \param weights    Numeric vector containing edge weights. If \c NULL,
- *                   every edge has equal weight. The weights are expected
- *                   to be non-negative.
+ * \param graph      The input graph, it is replaced by the graph of the
+ *                   communities that were found.
  * \param membership The membership vector, the result is returned here.
  *                   For each vertex it gives the ID of its community.
  * \param modularity The modularity of the partition is returned here.
@@ -322,20 +358,17 @@ static igraph_error_t igraph_i_multilevel_shrink(igraph_t *graph, igraph_vector_
  * Time complexity: in average near linear on sparse graphs.
  */
 static igraph_error_t igraph_i_community_multilevel_step(
-        igraph_t *graph,
-        igraph_vector_t *weights,
+        igraph_i_multilevel_graph *graph,
         igraph_vector_int_t *membership,
         igraph_real_t *modularity,
         const igraph_real_t resolution) {
 
-    igraph_integer_t vcount = igraph_vcount(graph);
-    igraph_integer_t ecount = igraph_ecount(graph);
+    igraph_integer_t vcount = graph->no_of_nodes;
     igraph_real_t q, pass_q;
     /* int pass; // used only for debugging */
     igraph_bool_t changed;
     igraph_vector_int_t links_community;
     igraph_vector_t links_weight;
-    igraph_vector_int_t edges;
     igraph_vector_int_t temp_membership;
     igraph_i_multilevel_community_list communities;
     igraph_vector_int_t node_order;
@@ -347,15 +380,13 @@ static igraph_error_t igraph_i_community_multilevel_step(
     /* Initialize data structures */
     IGRAPH_VECTOR_INT_INIT_FINALLY(&links_community, 0);
     IGRAPH_VECTOR_INIT_FINALLY(&links_weight, 0);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&edges, 0);
     IGRAPH_VECTOR_INT_INIT_FINALLY(&temp_membership, vcount);
     IGRAPH_CHECK(igraph_vector_int_resize(membership, vcount));
 
     /* Initialize list of communities from graph vertices */
     communities.vertices_no = vcount;
     communities.communities_no = vcount;
-    communities.weights = weights;
-    communities.weight_sum = 2.0 * igraph_vector_sum(weights);
+    communities.weight_sum = igraph_vector_sum(&graph->weights);
     communities.membership = membership;
     communities.item = IGRAPH_CALLOC(vcount, igraph_i_multilevel_community);
     IGRAPH_CHECK_OOM(communities.item, "Multi-level community structure detection failed.");
@@ -367,18 +398,13 @@ static igraph_error_t igraph_i_community_multilevel_step(
         communities.item[i].size = 1;
         communities.item[i].weight_inside = 0;
         communities.item[i].weight_all = 0;
-    }
 
-    /* Some more initialization :) */
-    for (igraph_integer_t i = 0; i < ecount; i++) {
-        igraph_integer_t ffrom = IGRAPH_FROM(graph, i), fto = IGRAPH_TO(graph, i);
-        igraph_real_t weight = 1;
-
-        weight = VECTOR(*weights)[i];
-        communities.item[ffrom].weight_all += weight;
-        communities.item[fto].weight_all += weight;
-        if (ffrom == fto) {
-            communities.item[ffrom].weight_inside += 2 * weight;
+        for (igraph_integer_t j = VECTOR(graph->offsets)[i]; j < VECTOR(graph->offsets)[i + 1]; j++) {
+            igraph_real_t weight = VECTOR(graph->weights)[j];
+            communities.item[i].weight_all += weight;
+            if (VECTOR(graph->neis)[j] == i) {
+                communities.item[i].weight_inside += weight;
+            }
         }
     }
 
@@ -419,7 +445,7 @@ static igraph_error_t igraph_i_community_multilevel_step(
             ni = VECTOR(node_order)[i];
 
             igraph_i_multilevel_community_links(graph, &communities,
-                                                ni, &edges,
+                                                ni,
                                                 &weight_all, &weight_inside,
                                                 &weight_loop, &links_community,
                                                 &links_weight);
@@ -500,8 +526,7 @@ static igraph_error_t igraph_i_community_multilevel_step(
 
     IGRAPH_CHECK(igraph_reindex_membership(membership, NULL, NULL));
 
-    /* Shrink the nodes of the graph according to the present community structure
-     * and simplify the resulting graph */
+    /* Shrink the nodes of the graph according to the present community structure */
 
     /* TODO: check if we really need to copy temp_membership */
     IGRAPH_CHECK(igraph_vector_int_update(&temp_membership, membership));
@@ -509,25 +534,11 @@ static igraph_error_t igraph_i_community_multilevel_step(
     igraph_vector_int_destroy(&temp_membership);
     IGRAPH_FINALLY_CLEAN(1);
 
-    /* Update edge weights after shrinking and simplification */
-    /* Here we reuse the edges vector as we don't need the previous contents anymore */
-    /* TODO: can we use igraph_simplify here? */
-    IGRAPH_CHECK(igraph_i_multilevel_simplify_multiple(graph, &edges));
-
-    /* We reuse the links_weight vector to store the old edge weights */
-    IGRAPH_CHECK(igraph_vector_update(&links_weight, weights));
-    igraph_vector_null(weights);
-
-    for (igraph_integer_t i = 0; i < ecount; i++) {
-        VECTOR(*weights)[VECTOR(edges)[i]] += VECTOR(links_weight)[i];
-    }
-
     igraph_free(communities.item);
     igraph_vector_int_destroy(&links_community);
     igraph_vector_destroy(&links_weight);
-    igraph_vector_int_destroy(&edges);
     igraph_vector_int_destroy(&node_order);
-    IGRAPH_FINALLY_CLEAN(5);
+    IGRAPH_FINALLY_CLEAN(4);
 
     return IGRAPH_SUCCESS;
 }
@@ -600,8 +611,7 @@ igraph_error_t igraph_community_multilevel(const igraph_t *graph,
                                            igraph_matrix_int_t *memberships,
                                            igraph_vector_t *modularity) {
 
-    igraph_t g;
-    igraph_vector_t w;
+    igraph_i_multilevel_graph g;
     igraph_vector_int_t m;
     igraph_vector_int_t level_membership;
     igraph_real_t prev_q = -1, q = -1;
@@ -631,17 +641,9 @@ igraph_error_t igraph_community_multilevel(const igraph_t *graph,
         IGRAPH_ERROR("The resolution parameter must be non-negative.", IGRAPH_EINVAL);
     }
 
-    /* Make a copy of the original graph, we will do the merges on the copy */
-    IGRAPH_CHECK(igraph_copy(&g, graph));
-    IGRAPH_FINALLY(igraph_destroy, &g);
-
-    if (weights) {
-        IGRAPH_CHECK(igraph_vector_init_copy(&w, weights));
-        IGRAPH_FINALLY(igraph_vector_destroy, &w);
-    } else {
-        IGRAPH_VECTOR_INIT_FINALLY(&w, igraph_ecount(&g));
-        igraph_vector_fill(&w, 1);
-    }
+    /* Make a weighted copy of the original graph, we will do the merges on the copy */
+    IGRAPH_CHECK(igraph_i_multilevel_graph_init(&g, graph, weights));
+    IGRAPH_FINALLY(igraph_i_multilevel_graph_destroy, &g);
 
     IGRAPH_VECTOR_INT_INIT_FINALLY(&m, vcount);
     IGRAPH_VECTOR_INT_INIT_FINALLY(&level_membership, vcount);
@@ -663,13 +665,13 @@ igraph_error_t igraph_community_multilevel(const igraph_t *graph,
 
     while (true) {
         /* Remember the previous modularity and vertex count, do a single step */
-        igraph_integer_t step_vcount = igraph_vcount(&g);
+        igraph_integer_t step_vcount = g.no_of_nodes;
 
         prev_q = q;
-        IGRAPH_CHECK(igraph_i_community_multilevel_step(&g, &w, &m, &q, resolution));
+        IGRAPH_CHECK(igraph_i_community_multilevel_step(&g, &m, &q, resolution));
 
         /* Were there any merges? If not, we have to stop the process */
-        if (igraph_vcount(&g) == step_vcount || q < prev_q) {
+        if (g.no_of_nodes == step_vcount || q < prev_q) {
             break;
         }
 
@@ -692,7 +694,7 @@ igraph_error_t igraph_community_multilevel(const igraph_t *graph,
             IGRAPH_CHECK(igraph_matrix_int_set_row(memberships, &level_membership, level - 1));
         }
 
-        /* debug("Level: %d Communities: %ld Modularity: %f\n", level, igraph_vcount(&g),
+        /* debug("Level: %d Communities: %ld Modularity: %f\n", level, g.no_of_nodes,
           (double) q); */
 
         /* Increase the level counter */
@@ -727,13 +729,12 @@ igraph_error_t igraph_community_multilevel(const igraph_t *graph,
     }
 
     /* Destroy the copy of the graph */
-    igraph_destroy(&g);
+    igraph_i_multilevel_graph_destroy(&g);
 
     /* Destroy the temporary vectors */
     igraph_vector_int_destroy(&m);
-    igraph_vector_destroy(&w);
     igraph_vector_int_destroy(&level_membership);
-    IGRAPH_FINALLY_CLEAN(4);
+    IGRAPH_FINALLY_CLEAN(3);
 
     return IGRAPH_SUCCESS;
 }
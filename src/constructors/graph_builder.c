@@ -0,0 +1,608 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "igraph_constructors.h"
+
+#include "igraph_attributes.h"
+#include "igraph_conversion.h"
+#include "igraph_interface.h"
+#include "igraph_memory.h"
+
+#include "graph/attributes.h"
+#include "graph/internal.h"
+#include "internal/hacks.h" /* igraph_i_strdup */
+#include "math/safe_intop.h"
+
+#include <string.h> /* memcpy, strcmp */
+
+/* Number of edges stored in a single chunk of the builder. */
+#define IGRAPH_I_GRAPH_BUILDER_CHUNK_SIZE 65536
+
+/**
+ * \section about_graph_builder
+ *
+ * <para>A graph builder collects the vertices and edges of a graph, together
+ * with their attributes, one batch at a time, and creates an \ref igraph_t
+ * object from them at the end. It is meant for loaders that receive the
+ * edges of a large graph in a streaming fashion.</para>
+ *
+ * <para>Edges are stored in fixed-size chunks, so adding edges never copies
+ * the edges that were added earlier, and there is no need to collect all
+ * edges in a single large vector before calling \ref igraph_create(). When
+ * the graph is created with \ref igraph_graph_builder_finalize(), the chunks
+ * are released as soon as their contents are transferred to the graph, and
+ * the edge indices are built directly using counting sort. This keeps the
+ * peak memory usage close to the size of the final graph.</para>
+ */
+
+static void igraph_i_graph_builder_attr_destroy(igraph_vector_ptr_t *attrlist) {
+    igraph_integer_t n = igraph_vector_ptr_size(attrlist);
+    for (igraph_integer_t i = 0; i < n; i++) {
+        igraph_attribute_record_t *rec = VECTOR(*attrlist)[i];
+        if (rec->type == IGRAPH_ATTRIBUTE_NUMERIC) {
+            igraph_vector_destroy((igraph_vector_t *) rec->value);
+        } else if (rec->type == IGRAPH_ATTRIBUTE_STRING) {
+            igraph_strvector_destroy((igraph_strvector_t *) rec->value);
+        } else if (rec->type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+            igraph_vector_bool_destroy((igraph_vector_bool_t *) rec->value);
+        }
+        IGRAPH_FREE(rec->value);
+        IGRAPH_FREE(rec->name);
+        IGRAPH_FREE(rec);
+    }
+    igraph_vector_ptr_clear(attrlist);
+}
+
+static void igraph_i_graph_builder_chunks_destroy(igraph_vector_ptr_t *chunks) {
+    igraph_integer_t n = igraph_vector_ptr_size(chunks);
+    for (igraph_integer_t i = 0; i < n; i++) {
+        IGRAPH_FREE(VECTOR(*chunks)[i]);
+    }
+    igraph_vector_ptr_clear(chunks);
+}
+
+/* Sets the length of all accumulated attribute vectors to 'len'. New
+ * elements are filled with NaN, false and empty strings, just like the C
+ * attribute handler does for vertices and edges that have no value for
+ * an attribute. Shrinking cannot fail. */
+static igraph_error_t igraph_i_graph_builder_attr_resize(
+        igraph_vector_ptr_t *attrlist, igraph_integer_t len) {
+
+    igraph_integer_t n = igraph_vector_ptr_size(attrlist);
+    for (igraph_integer_t i = 0; i < n; i++) {
+        igraph_attribute_record_t *rec = VECTOR(*attrlist)[i];
+        if (rec->type == IGRAPH_ATTRIBUTE_NUMERIC) {
+            igraph_vector_t *v = (igraph_vector_t *) rec->value;
+            igraph_integer_t old = igraph_vector_size(v);
+            IGRAPH_CHECK(igraph_vector_resize(v, len));
+            for (igraph_integer_t j = old; j < len; j++) {
+                VECTOR(*v)[j] = IGRAPH_NAN;
+            }
+        } else if (rec->type == IGRAPH_ATTRIBUTE_STRING) {
+            IGRAPH_CHECK(igraph_strvector_resize((igraph_strvector_t *) rec->value, len));
+        } else if (rec->type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+            igraph_vector_bool_t *v = (igraph_vector_bool_t *) rec->value;
+            igraph_integer_t old = igraph_vector_bool_size(v);
+            IGRAPH_CHECK(igraph_vector_bool_resize(v, len));
+            for (igraph_integer_t j = old; j < len; j++) {
+                VECTOR(*v)[j] = false;
+            }
+        }
+    }
+    return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t igraph_i_graph_builder_attr_new(
+        igraph_vector_ptr_t *attrlist, const igraph_attribute_record_t *orig,
+        igraph_integer_t len) {
+
+    igraph_attribute_record_t *rec;
+
+    IGRAPH_CHECK(igraph_vector_ptr_reserve(attrlist, igraph_vector_ptr_size(attrlist) + 1));
+
+    rec = IGRAPH_CALLOC(1, igraph_attribute_record_t);
+    IGRAPH_CHECK_OOM(rec, "Cannot add attributes to graph builder.");
+    IGRAPH_FINALLY(igraph_free, rec);
+
+    rec->type = orig->type;
+    rec->name = igraph_i_strdup(orig->name);
+    IGRAPH_CHECK_OOM(rec->name, "Cannot add attributes to graph builder.");
+    IGRAPH_FINALLY(igraph_free, (char *) rec->name);
+
+    if (orig->type == IGRAPH_ATTRIBUTE_NUMERIC) {
+        igraph_vector_t *v = IGRAPH_CALLOC(1, igraph_vector_t);
+        IGRAPH_CHECK_OOM(v, "Cannot add attributes to graph builder.");
+        IGRAPH_FINALLY(igraph_free, v);
+        IGRAPH_CHECK(igraph_vector_init(v, len));
+        igraph_vector_fill(v, IGRAPH_NAN);
+        rec->value = v;
+    } else if (orig->type == IGRAPH_ATTRIBUTE_STRING) {
+        igraph_strvector_t *v = IGRAPH_CALLOC(1, igraph_strvector_t);
+        IGRAPH_CHECK_OOM(v, "Cannot add attributes to graph builder.");
+        IGRAPH_FINALLY(igraph_free, v);
+        IGRAPH_CHECK(igraph_strvector_init(v, len));
+        rec->value = v;
+    } else if (orig->type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+        igraph_vector_bool_t *v = IGRAPH_CALLOC(1, igraph_vector_bool_t);
+        IGRAPH_CHECK_OOM(v, "Cannot add attributes to graph builder.");
+        IGRAPH_FINALLY(igraph_free, v);
+        IGRAPH_CHECK(igraph_vector_bool_init(v, len));
+        rec->value = v;
+    } else {
+        IGRAPH_ERROR("Graph builders support only numeric, string and Boolean attributes.",
+                     IGRAPH_EINVAL);
+    }
+
+    igraph_vector_ptr_push_back(attrlist, rec); /* reserved */
+
+    IGRAPH_FINALLY_CLEAN(3);
+    return IGRAPH_SUCCESS;
+}
+
+/* Appends the first 'count' values of each record in 'attr' to the matching
+ * accumulated attribute, creating it if needed, then pads all accumulated
+ * attributes to 'oldlen + count'. */
+static igraph_error_t igraph_i_graph_builder_attr_append_inner(
+        igraph_vector_ptr_t *attrlist, igraph_integer_t oldlen,
+        igraph_integer_t count, const igraph_vector_ptr_t *attr) {
+
+    igraph_integer_t n = attr ? igraph_vector_ptr_size(attr) : 0;
+
+    for (igraph_integer_t i = 0; i < n; i++) {
+        const igraph_attribute_record_t *nrec = VECTOR(*attr)[i];
+        igraph_attribute_record_t *rec = NULL;
+        igraph_integer_t j, m = igraph_vector_ptr_size(attrlist);
+
+        for (j = 0; j < m; j++) {
+            rec = VECTOR(*attrlist)[j];
+            if (!strcmp(rec->name, nrec->name)) {
+                break;
+            }
+        }
+        if (j == m) {
+            IGRAPH_CHECK(igraph_i_graph_builder_attr_new(attrlist, nrec, oldlen));
+            rec = VECTOR(*attrlist)[j];
+        } else if (rec->type != nrec->type) {
+            IGRAPH_ERRORF("Type of attribute '%s' does not match earlier values.",
+                          IGRAPH_EINVAL, nrec->name);
+        }
+
+        if (rec->type == IGRAPH_ATTRIBUTE_NUMERIC) {
+            const igraph_vector_t *src = (const igraph_vector_t *) nrec->value;
+            igraph_vector_t *dst = (igraph_vector_t *) rec->value;
+            if (igraph_vector_size(src) < count) {
+                IGRAPH_ERRORF("Too few values for attribute '%s'.", IGRAPH_EINVAL, nrec->name);
+            }
+            IGRAPH_CHECK(igraph_vector_resize(dst, oldlen + count));
+            for (j = 0; j < count; j++) {
+                VECTOR(*dst)[oldlen + j] = VECTOR(*src)[j];
+            }
+        } else if (rec->type == IGRAPH_ATTRIBUTE_STRING) {
+            const igraph_strvector_t *src = (const igraph_strvector_t *) nrec->value;
+            igraph_strvector_t *dst = (igraph_strvector_t *) rec->value;
+            if (igraph_strvector_size(src) < count) {
+                IGRAPH_ERRORF("Too few values for attribute '%s'.", IGRAPH_EINVAL, nrec->name);
+            }
+            IGRAPH_CHECK(igraph_strvector_reserve(dst, oldlen + count));
+            for (j = 0; j < count; j++) {
+                IGRAPH_CHECK(igraph_strvector_push_back(dst, igraph_strvector_get(src, j)));
+            }
+        } else if (rec->type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+            const igraph_vector_bool_t *src = (const igraph_vector_bool_t *) nrec->value;
+            igraph_vector_bool_t *dst = (igraph_vector_bool_t *) rec->value;
+            if (igraph_vector_bool_size(src) < count) {
+                IGRAPH_ERRORF("Too few values for attribute '%s'.", IGRAPH_EINVAL, nrec->name);
+            }
+            IGRAPH_CHECK(igraph_vector_bool_resize(dst, oldlen + count));
+            for (j = 0; j < count; j++) {
+                VECTOR(*dst)[oldlen + j] = VECTOR(*src)[j];
+            }
+        }
+    }
+
+    IGRAPH_CHECK(igraph_i_graph_builder_attr_resize(attrlist, oldlen + count));
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Like igraph_i_graph_builder_attr_append_inner(), but restores the original
+ * attribute lengths on failure. */
+static igraph_error_t igraph_i_graph_builder_attr_append(
+        igraph_vector_ptr_t *attrlist, igraph_integer_t oldlen,
+        igraph_integer_t count, const igraph_vector_ptr_t *attr) {
+
+    igraph_error_t err;
+
+    if ((attr == NULL || igraph_vector_ptr_size(attr) == 0) &&
+        igraph_vector_ptr_size(attrlist) == 0) {
+        return IGRAPH_SUCCESS;
+    }
+
+    IGRAPH_FINALLY_ENTER();
+    err = igraph_i_graph_builder_attr_append_inner(attrlist, oldlen, count, attr);
+    IGRAPH_FINALLY_EXIT();
+    if (err != IGRAPH_SUCCESS) {
+        igraph_i_graph_builder_attr_resize(attrlist, oldlen); /* shrinks */
+        IGRAPH_ERROR("Cannot add attributes to graph builder.", err);
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_graph_builder_init
+ * \brief Initializes an empty graph builder.
+ *
+ * \experimental
+ *
+ * \param builder Pointer to an uninitialized graph builder.
+ * \param directed Whether the graph to be built is directed.
+ * \return Error code.
+ *
+ * Time complexity: O(1).
+ */
+igraph_error_t igraph_graph_builder_init(igraph_graph_builder_t *builder, igraph_bool_t directed) {
+    builder->directed = directed;
+    builder->vcount = 0;
+    builder->ecount = 0;
+    builder->max_vid = -1;
+    IGRAPH_VECTOR_PTR_INIT_FINALLY(&builder->chunks, 0);
+    IGRAPH_VECTOR_PTR_INIT_FINALLY(&builder->vertex_attr, 0);
+    IGRAPH_CHECK(igraph_vector_ptr_init(&builder->edge_attr, 0));
+    IGRAPH_FINALLY_CLEAN(2);
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_graph_builder_destroy
+ * \brief Destroys a graph builder.
+ *
+ * \experimental
+ *
+ * Releases all memory held by the builder, including the edges and
+ * attributes that have not been turned into a graph.
+ *
+ * \param builder The graph builder to destroy.
+ *
+ * Time complexity: O(|E|/c + a), where c is the number of edges stored
+ * in one chunk and a is the number of string attribute values.
+ */
+void igraph_graph_builder_destroy(igraph_graph_builder_t *builder) {
+    igraph_i_graph_builder_chunks_destroy(&builder->chunks);
+    igraph_vector_ptr_destroy(&builder->chunks);
+    igraph_i_graph_builder_attr_destroy(&builder->vertex_attr);
+    igraph_vector_ptr_destroy(&builder->vertex_attr);
+    igraph_i_graph_builder_attr_destroy(&builder->edge_attr);
+    igraph_vector_ptr_destroy(&builder->edge_attr);
+}
+
+/**
+ * \function igraph_graph_builder_vcount
+ * \brief The number of vertices of the graph being built.
+ *
+ * \experimental
+ *
+ * This is the larger of the number of vertices added explicitly and
+ * one plus the largest vertex ID referenced by an edge.
+ *
+ * \param builder The graph builder.
+ * \return The number of vertices.
+ *
+ * Time complexity: O(1).
+ */
+igraph_integer_t igraph_graph_builder_vcount(const igraph_graph_builder_t *builder) {
+    return builder->vcount > builder->max_vid ? builder->vcount : builder->max_vid + 1;
+}
+
+/**
+ * \function igraph_graph_builder_ecount
+ * \brief The number of edges added to a graph builder.
+ *
+ * \experimental
+ *
+ * \param builder The graph builder.
+ * \return The number of edges.
+ *
+ * Time complexity: O(1).
+ */
+igraph_integer_t igraph_graph_builder_ecount(const igraph_graph_builder_t *builder) {
+    return builder->ecount;
+}
+
+/**
+ * \function igraph_graph_builder_add_vertices
+ * \brief Adds vertices to a graph builder.
+ *
+ * \experimental
+ *
+ * \param builder The graph builder.
+ * \param nv The number of vertices to add.
+ * \param attr The attributes of the new vertices, in the same format as
+ *        for \ref igraph_add_vertices(). Supply a null pointer if the
+ *        new vertices have no attributes. Numeric, string and Boolean
+ *        attributes are supported. Vertices for which no value was given
+ *        get the same default values as with the C attribute handler.
+ * \return Error code.
+ *
+ * Time complexity: O(nv) plus the time needed to copy the attributes.
+ */
+igraph_error_t igraph_graph_builder_add_vertices(igraph_graph_builder_t *builder, igraph_integer_t nv,
+                                                 const igraph_vector_ptr_t *attr) {
+    igraph_integer_t new_vc;
+
+    if (nv < 0) {
+        IGRAPH_ERROR("Cannot add negative number of vertices.", IGRAPH_EINVAL);
+    }
+
+    IGRAPH_SAFE_ADD(builder->vcount, nv, &new_vc);
+    if (new_vc > IGRAPH_VCOUNT_MAX) {
+        IGRAPH_ERRORF("Maximum vertex count (%" IGRAPH_PRId ") exceeded.", IGRAPH_ERANGE,
+                      IGRAPH_VCOUNT_MAX);
+    }
+
+    IGRAPH_CHECK(igraph_i_graph_builder_attr_append(&builder->vertex_attr, builder->vcount, nv, attr));
+    builder->vcount = new_vc;
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Makes sure that there is room for 'count' more edges in the chunks. */
+static igraph_error_t igraph_i_graph_builder_reserve(igraph_graph_builder_t *builder,
+                                                     igraph_integer_t count) {
+    igraph_integer_t needed, have = igraph_vector_ptr_size(&builder->chunks);
+    igraph_integer_t new_ec;
+
+    IGRAPH_SAFE_ADD(builder->ecount, count, &new_ec);
+    if (new_ec > IGRAPH_ECOUNT_MAX) {
+        IGRAPH_ERRORF("Maximum edge count (%" IGRAPH_PRId ") exceeded.", IGRAPH_ERANGE,
+                      IGRAPH_ECOUNT_MAX);
+    }
+
+    needed = (new_ec + IGRAPH_I_GRAPH_BUILDER_CHUNK_SIZE - 1) / IGRAPH_I_GRAPH_BUILDER_CHUNK_SIZE;
+    if (needed > have) {
+        IGRAPH_CHECK(igraph_vector_ptr_reserve(&builder->chunks, needed));
+    }
+    for (; have < needed; have++) {
+        igraph_integer_t *chunk = IGRAPH_CALLOC(2 * IGRAPH_I_GRAPH_BUILDER_CHUNK_SIZE, igraph_integer_t);
+        IGRAPH_CHECK_OOM(chunk, "Cannot add edges to graph builder.");
+        igraph_vector_ptr_push_back(&builder->chunks, chunk); /* reserved */
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_graph_builder_add_edge
+ * \brief Adds a single edge to a graph builder.
+ *
+ * \experimental
+ *
+ * Vertices referenced by the edge do not need to be added first; the
+ * vertex count of the final graph is extended as needed.
+ *
+ * \param builder The graph builder.
+ * \param from The source vertex of the edge.
+ * \param to The target vertex of the edge.
+ * \return Error code:
+ *         \c IGRAPH_EINVVID: invalid vertex ID.
+ *
+ * Time complexity: amortized O(1).
+ */
+igraph_error_t igraph_graph_builder_add_edge(igraph_graph_builder_t *builder,
+                                             igraph_integer_t from, igraph_integer_t to) {
+    igraph_integer_t *chunk, pos;
+
+    if (from < 0 || to < 0 || from >= IGRAPH_VCOUNT_MAX || to >= IGRAPH_VCOUNT_MAX) {
+        IGRAPH_ERROR("Invalid vertex ID when adding edge.", IGRAPH_EINVVID);
+    }
+
+    IGRAPH_CHECK(igraph_i_graph_builder_reserve(builder, 1));
+    IGRAPH_CHECK(igraph_i_graph_builder_attr_append(&builder->edge_attr, builder->ecount, 1, NULL));
+
+    chunk = VECTOR(builder->chunks)[builder->ecount / IGRAPH_I_GRAPH_BUILDER_CHUNK_SIZE];
+    pos = 2 * (builder->ecount % IGRAPH_I_GRAPH_BUILDER_CHUNK_SIZE);
+    chunk[pos] = from;
+    chunk[pos + 1] = to;
+    if (from > builder->max_vid) builder->max_vid = from;
+    if (to > builder->max_vid) builder->max_vid = to;
+    builder->ecount++;
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_graph_builder_add_edges
+ * \brief Adds a batch of edges to a graph builder.
+ *
+ * \experimental
+ *
+ * Vertices referenced by the edges do not need to be added first; the
+ * vertex count of the final graph is extended as needed.
+ *
+ * \param builder The graph builder.
+ * \param edges The edges to add, in the same format as for
+ *        \ref igraph_add_edges().
+ * \param attr The attributes of the new edges, in the same format as
+ *        for \ref igraph_add_edges(). Supply a null pointer if the
+ *        new edges have no attributes. Numeric, string and Boolean
+ *        attributes are supported. Edges for which no value was given
+ *        get the same default values as with the C attribute handler.
+ * \return Error code:
+ *    \c IGRAPH_EINVEVECTOR: invalid (odd) edges vector length,
+ *    \c IGRAPH_EINVVID: invalid vertex ID in edges vector.
+ *
+ * Time complexity: O(|E'|) where |E'| is the number of edges added,
+ * plus the time needed to copy the attributes. Previously added edges
+ * are never copied.
+ */
+igraph_error_t igraph_graph_builder_add_edges(igraph_graph_builder_t *builder, const igraph_vector_int_t *edges,
+                                              const igraph_vector_ptr_t *attr) {
+    igraph_integer_t n = igraph_vector_int_size(edges);
+    igraph_integer_t count = n / 2;
+    igraph_integer_t i, max_vid;
+
+    if (n % 2 != 0) {
+        IGRAPH_ERROR("Invalid (odd) length of edges vector.", IGRAPH_EINVEVECTOR);
+    }
+    if (n == 0) {
+        return IGRAPH_SUCCESS;
+    }
+    if (!igraph_vector_int_isininterval(edges, 0, IGRAPH_VCOUNT_MAX - 1)) {
+        IGRAPH_ERROR("Invalid (negative or too large) vertex ID when adding edges.", IGRAPH_EINVVID);
+    }
+
+    IGRAPH_CHECK(igraph_i_graph_builder_reserve(builder, count));
+    IGRAPH_CHECK(igraph_i_graph_builder_attr_append(&builder->edge_attr, builder->ecount, count, attr));
+
+    /* Nothing can fail from here on. */
+    max_vid = builder->max_vid;
+    for (i = 0; i < n; i += 2) {
+        igraph_integer_t e = builder->ecount + i / 2;
+        igraph_integer_t *chunk = VECTOR(builder->chunks)[e / IGRAPH_I_GRAPH_BUILDER_CHUNK_SIZE];
+        igraph_integer_t pos = 2 * (e % IGRAPH_I_GRAPH_BUILDER_CHUNK_SIZE);
+        igraph_integer_t from = VECTOR(*edges)[i], to = VECTOR(*edges)[i + 1];
+        chunk[pos] = from;
+        chunk[pos + 1] = to;
+        if (from > max_vid) max_vid = from;
+        if (to > max_vid) max_vid = to;
+    }
+    builder->max_vid = max_vid;
+    builder->ecount += count;
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Resets a builder to its empty state, releasing all edges and attributes. */
+static void igraph_i_graph_builder_clear(igraph_graph_builder_t *builder) {
+    igraph_i_graph_builder_chunks_destroy(&builder->chunks);
+    igraph_i_graph_builder_attr_destroy(&builder->vertex_attr);
+    igraph_i_graph_builder_attr_destroy(&builder->edge_attr);
+    builder->vcount = 0;
+    builder->ecount = 0;
+    builder->max_vid = -1;
+}
+
+static igraph_error_t igraph_i_graph_builder_finalize(igraph_graph_builder_t *builder, igraph_t *graph) {
+    igraph_integer_t no_of_nodes = igraph_graph_builder_vcount(builder);
+    igraph_integer_t no_of_edges = builder->ecount;
+    igraph_integer_t no_of_chunks = igraph_vector_ptr_size(&builder->chunks);
+    igraph_bool_t directed = builder->directed;
+    igraph_bool_t has_edge_attr;
+    igraph_vector_int_t from, to, edges;
+    igraph_integer_t c, e;
+
+    IGRAPH_CHECK(igraph_i_graph_builder_attr_resize(&builder->vertex_attr, no_of_nodes));
+
+    IGRAPH_CHECK(igraph_empty(graph, 0, directed));
+    IGRAPH_FINALLY(igraph_destroy, graph);
+    IGRAPH_CHECK(igraph_add_vertices(graph, no_of_nodes,
+                                     igraph_vector_ptr_size(&builder->vertex_attr) > 0 ? &builder->vertex_attr : NULL));
+    igraph_i_graph_builder_attr_destroy(&builder->vertex_attr);
+
+    /* The attribute handler expects the list of the new edges, which is
+     * collected from the chunks together with the edge list of the graph. */
+    has_edge_attr = igraph_vector_ptr_size(&builder->edge_attr) > 0 && graph->attr;
+
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&from, no_of_edges);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&to, no_of_edges);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&edges, has_edge_attr ? 2 * no_of_edges : 0);
+
+    /* Transfer the edges, releasing each chunk as soon as it was copied.
+     * Undirected edges are stored with the larger endpoint in 'from',
+     * just like igraph_add_edges() does. */
+    for (c = 0, e = 0; c < no_of_chunks; c++) {
+        igraph_integer_t *chunk = VECTOR(builder->chunks)[c];
+        igraph_integer_t len = no_of_edges - e < IGRAPH_I_GRAPH_BUILDER_CHUNK_SIZE ?
+                               no_of_edges - e : IGRAPH_I_GRAPH_BUILDER_CHUNK_SIZE;
+        if (has_edge_attr) {
+            memcpy(VECTOR(edges) + 2 * e, chunk, sizeof(chunk[0]) * (size_t) (2 * len));
+        }
+        for (igraph_integer_t pos = 0; pos < 2 * len; pos += 2, e++) {
+            igraph_integer_t u = chunk[pos], v = chunk[pos + 1];
+            if (directed || u > v) {
+                VECTOR(from)[e] = u; VECTOR(to)[e] = v;
+            } else {
+                VECTOR(from)[e] = v; VECTOR(to)[e] = u;
+            }
+        }
+        IGRAPH_FREE(chunk);
+        VECTOR(builder->chunks)[c] = NULL;
+    }
+    igraph_vector_ptr_clear(&builder->chunks);
+
+    IGRAPH_CHECK(igraph_i_set_edges_from_columns(graph, &from, &to));
+
+    if (has_edge_attr) {
+        IGRAPH_CHECK(igraph_i_attribute_add_edges(graph, &edges, &builder->edge_attr));
+    }
+
+    igraph_vector_int_destroy(&edges);
+    igraph_vector_int_destroy(&to);
+    igraph_vector_int_destroy(&from);
+    IGRAPH_FINALLY_CLEAN(3);
+
+    IGRAPH_FINALLY_CLEAN(1); /* graph */
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_graph_builder_finalize
+ * \brief Creates a graph from the contents of a graph builder.
+ *
+ * \experimental
+ *
+ * The edges of the graph appear in the order they were added to the builder,
+ * and the result is identical to what \ref igraph_create() followed by
+ * adding the attributes would produce. The edge indices of the graph are
+ * built with counting sort, and the edge chunks of the builder are freed while
+ * they are transferred into the graph, so the peak memory use is not much
+ * larger than the size of the final graph. The exception is when edge
+ * attributes are passed on to the graph: the attribute handler needs the
+ * list of the new edges, which takes another 2|E| integers, so the peak
+ * memory use is then about one and a half times the size of the graph.
+ *
+ * </para><para>
+ * The builder is empty after this call, even if an error occurs, and
+ * it can be reused to build another graph. It still needs to be destroyed
+ * with \ref igraph_graph_builder_destroy() when it is no longer needed.
+ *
+ * </para><para>
+ * Attributes are passed on to the graph only if an attribute handler is
+ * installed; see \ref igraph_set_attribute_table().
+ *
+ * \param builder The graph builder.
+ * \param graph Pointer to an uninitialized graph object.
+ * \return Error code.
+ *
+ * Time complexity: O(|V|+|E|), plus the time needed to add the attributes.
+ */
+igraph_error_t igraph_graph_builder_finalize(igraph_graph_builder_t *builder, igraph_t *graph) {
+    igraph_error_t err;
+
+    IGRAPH_FINALLY_ENTER();
+    err = igraph_i_graph_builder_finalize(builder, graph);
+    IGRAPH_FINALLY_EXIT();
+
+    igraph_i_graph_builder_clear(builder);
+
+    if (err != IGRAPH_SUCCESS) {
+        IGRAPH_ERROR("Cannot create graph from graph builder.", err);
+    }
+
+    return IGRAPH_SUCCESS;
+}
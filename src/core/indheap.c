@@ -494,6 +494,17 @@ void igraph_d_indheap_destroy(igraph_d_indheap_t* h) {
     }
 }
 
+/**
+ * \ingroup doubleindheap
+ * \brief Removes all elements from the heap, keeping its storage.
+ */
+
+void igraph_d_indheap_clear(igraph_d_indheap_t *h) {
+    IGRAPH_ASSERT(h != 0);
+    IGRAPH_ASSERT(h->stor_begin != 0);
+    h->end = h->stor_begin;
+}
+
 /**
  * \ingroup doubleindheap
  * \brief Decides whether a heap is empty.
@@ -812,6 +823,7 @@ static void igraph_i_2wheap_sink(igraph_2wheap_t *h,
  */
 igraph_error_t igraph_2wheap_init(igraph_2wheap_t *h, igraph_integer_t max_size) {
     h->max_size = max_size;
+    h->no_of_deactivated = 0;
     /* We start with the biggest */
     IGRAPH_VECTOR_INT_INIT_FINALLY(&h->index2, max_size);
     IGRAPH_VECTOR_INIT_FINALLY(&h->data, 0);
@@ -833,11 +845,24 @@ void igraph_2wheap_destroy(igraph_2wheap_t *h) {
 
 /**
  * Clears a two-way heap, i.e. removes all the elements from the heap.
+ *
+ * This takes time proportional to the number of elements in the heap, unless
+ * some elements were deactivated since the heap was last cleared, in which
+ * case the whole reverse index is reset.
  */
 void igraph_2wheap_clear(igraph_2wheap_t *h) {
+    if (h->no_of_deactivated > 0) {
+        igraph_vector_int_null(&h->index2);
+    } else {
+        /* Only the items still in the heap have a non-zero reverse index */
+        igraph_integer_t size = igraph_vector_int_size(&h->index);
+        for (igraph_integer_t i = 0; i < size; i++) {
+            VECTOR(h->index2)[VECTOR(h->index)[i]] = 0;
+        }
+    }
+    h->no_of_deactivated = 0;
     igraph_vector_clear(&h->data);
     igraph_vector_int_clear(&h->index);
-    igraph_vector_int_null(&h->index2);
 }
 
 /**
@@ -964,6 +989,7 @@ igraph_real_t igraph_2wheap_deactivate_max(igraph_2wheap_t *h) {
     igraph_vector_pop_back(&h->data);
     igraph_vector_int_pop_back(&h->index);
     VECTOR(h->index2)[tmpidx] = 1;
+    h->no_of_deactivated++;
     igraph_i_2wheap_sink(h, 0);
 
     return tmp;
@@ -91,6 +91,7 @@ typedef struct s_indheap_d {
 
 IGRAPH_PRIVATE_EXPORT igraph_error_t igraph_d_indheap_init(igraph_d_indheap_t *h, igraph_integer_t size);
 IGRAPH_PRIVATE_EXPORT void igraph_d_indheap_destroy(igraph_d_indheap_t *h);
+IGRAPH_PRIVATE_EXPORT void igraph_d_indheap_clear(igraph_d_indheap_t *h);
 IGRAPH_PRIVATE_EXPORT igraph_bool_t igraph_d_indheap_empty(const igraph_d_indheap_t *h);
 IGRAPH_PRIVATE_EXPORT igraph_error_t igraph_d_indheap_push(igraph_d_indheap_t *h, igraph_real_t elem,
                                                 igraph_integer_t idx, igraph_integer_t idx2);
@@ -131,6 +132,9 @@ typedef struct igraph_2wheap_t {
      * that index[j-2] == i and data[j-2] is the corresponding item in the heap
      */
     igraph_vector_int_t index2;
+
+    /** Number of items deactivated since the heap was last cleared */
+    igraph_integer_t no_of_deactivated;
 } igraph_2wheap_t;
 
 IGRAPH_PRIVATE_EXPORT igraph_error_t igraph_2wheap_init(igraph_2wheap_t *h, igraph_integer_t size);
@@ -24,6 +24,8 @@
 #include "igraph_matrix.h"
 #include "igraph_types.h"
 
+#include "core/memory.h"
+
 #define BASE_IGRAPH_REAL
 #include "igraph_pmt.h"
 #include "matrix.pmt"
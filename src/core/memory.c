@@ -18,6 +18,12 @@
 
 #include "igraph_memory.h"
 
+#include "config.h" /* IGRAPH_THREAD_LOCAL */
+#include "core/memory.h"
+
+#include <stdlib.h>
+#include <string.h>
+
 /**
  * \section about_alloc_funcs About allocation functions
  *
@@ -44,8 +50,274 @@
  * where the behaviour of allocating zero bytes is undefined. igraph allocator
  * functions will always allocate at least one byte.
  * </para>
+ *
+ * <para>
+ * By default, igraph uses the allocator of the C standard library. A
+ * different allocator can be installed with \ref igraph_set_allocator(), e.g.
+ * to use memory arenas, or to account for and limit the memory used by
+ * igraph. When igraph runs out of memory, functions return
+ * \c IGRAPH_ENOMEM, and free all temporary data they allocated.
+ * </para>
+ *
+ * <para>
+ * The memory that igraph allocates can be measured by turning on memory
+ * tracking with \ref igraph_set_memory_tracking(). \ref igraph_memory_stats()
+ * then reports the current and peak memory use, broken down by the type of
+ * data structure that owns the memory. The memory used by a single graph
+ * can be queried with \ref igraph_graph_memory_size() at any time.
+ * </para>
+ */
+
+/* The allocator in use, or NULL for the C standard library. This is shared
+ * by all threads, since memory may be released by a different thread than
+ * the one that allocated it. */
+static const igraph_allocator_t *igraph_i_allocator = NULL;
+
+/* With memory tracking, each block is preceded by a header that records its
+ * size and category. The statistics are shared by all threads, just like the
+ * allocator. The category of new blocks is per thread, see
+ * igraph_i_memory_category_enter(). */
+typedef union {
+    struct {
+        size_t size;
+        igraph_memory_category_t category;
+    } info;
+    /* The remaining members ensure that the memory after the header is
+     * suitably aligned for any type. */
+    long double ld;
+    long long ll;
+    void *ptr;
+} igraph_i_memory_header_t;
+
+static igraph_bool_t igraph_i_memory_tracking = false;
+static igraph_memory_stats_t igraph_i_memory_stats;
+static IGRAPH_THREAD_LOCAL igraph_memory_category_t igraph_i_memory_category = IGRAPH_MEMORY_OTHER;
+
+static void *igraph_i_raw_malloc(size_t size) {
+    if (igraph_i_allocator) {
+        return igraph_i_allocator->malloc_func(size, igraph_i_allocator->data);
+    }
+    return malloc(size);
+}
+
+static void *igraph_i_raw_calloc(size_t count, size_t size) {
+    if (igraph_i_allocator) {
+        return igraph_i_allocator->calloc_func(count, size, igraph_i_allocator->data);
+    }
+    return calloc(count, size);
+}
+
+static void *igraph_i_raw_realloc(void *ptr, size_t size) {
+    if (igraph_i_allocator) {
+        return igraph_i_allocator->realloc_func(ptr, size, igraph_i_allocator->data);
+    }
+    return realloc(ptr, size);
+}
+
+static void igraph_i_raw_free(void *ptr) {
+    if (igraph_i_allocator) {
+        igraph_i_allocator->free_func(ptr, igraph_i_allocator->data);
+    } else {
+        free(ptr);
+    }
+}
+
+/* Updates the statistics of a category: 'removed' bytes are released and
+ * 'added' bytes are allocated, in 'blocks' more blocks than before. */
+static void igraph_i_memory_account(igraph_memory_category_t category,
+                                    size_t removed, size_t added, int blocks) {
+    igraph_memory_stats_t *stats = &igraph_i_memory_stats;
+#ifdef _OPENMP
+#pragma omp critical(igraph_i_memory_stats)
+#endif
+    {
+        stats->current = stats->current - removed + added;
+        stats->current_by_category[category] =
+            stats->current_by_category[category] - removed + added;
+        stats->blocks += blocks;
+        if (stats->current > stats->peak) {
+            stats->peak = stats->current;
+        }
+        if (stats->current_by_category[category] > stats->peak_by_category[category]) {
+            stats->peak_by_category[category] = stats->current_by_category[category];
+        }
+    }
+}
+
+/* Fills in the header of a newly allocated block and returns the memory
+ * that follows it. */
+static void *igraph_i_memory_track(void *block, size_t size) {
+    igraph_i_memory_header_t *header = block;
+    if (!header) {
+        return NULL;
+    }
+    header->info.size = size;
+    header->info.category = igraph_i_memory_category;
+    igraph_i_memory_account(header->info.category, 0, size, 1);
+    return header + 1;
+}
+
+/**
+ * \function igraph_set_memory_tracking
+ * \brief Turns memory tracking on or off.
+ *
+ * \experimental
+ *
+ * While memory tracking is on, igraph records the size of each block of
+ * memory it allocates, and maintains the statistics returned by
+ * \ref igraph_memory_stats(). This takes a small amount of extra memory
+ * for each block, and some extra time for each allocation.
+ *
+ * </para><para>
+ * Memory tracking changes the layout of allocated blocks. Therefore it
+ * must be turned on or off only while no memory allocated by igraph is in
+ * use, typically at the start of the program, similarly to
+ * \ref igraph_set_allocator(). It works together with any allocator set
+ * by that function. Turning memory tracking on resets all statistics.
+ *
+ * </para><para>
+ * The statistics are shared by all threads. They are updated in a critical
+ * section when igraph is compiled with OpenMP support; otherwise they are
+ * only accurate when igraph is used from a single thread.
+ *
+ * \param enabled Whether to turn memory tracking on.
+ * \return Whether memory tracking was on before the call.
+ *
+ * Time complexity: O(1).
  */
 
+igraph_bool_t igraph_set_memory_tracking(igraph_bool_t enabled) {
+    igraph_bool_t previous = igraph_i_memory_tracking;
+    if (enabled && !previous) {
+        memset(&igraph_i_memory_stats, 0, sizeof(igraph_i_memory_stats));
+    }
+    igraph_i_memory_tracking = enabled;
+    return previous;
+}
+
+/**
+ * \function igraph_memory_stats
+ * \brief Queries memory usage statistics.
+ *
+ * \experimental
+ *
+ * Reports the memory allocated by igraph while memory tracking was on, see
+ * \ref igraph_set_memory_tracking(). Memory is assigned to a category
+ * when it is allocated, based on the data structure that allocates it,
+ * and keeps its category when it is resized. Memory allocated by some of
+ * the third-party libraries bundled with igraph, and by code written in
+ * C++, is not included.
+ *
+ * \param stats Pointer to a structure, the statistics are stored here.
+ *    All values are zero if memory tracking was never turned on.
+ *
+ * Time complexity: O(1).
+ */
+
+void igraph_memory_stats(igraph_memory_stats_t *stats) {
+#ifdef _OPENMP
+#pragma omp critical(igraph_i_memory_stats)
+#endif
+    {
+        *stats = igraph_i_memory_stats;
+    }
+}
+
+/**
+ * \function igraph_memory_stats_reset_peak
+ * \brief Resets the peak memory usage to the current memory usage.
+ *
+ * \experimental
+ *
+ * This can be used to measure the peak memory usage of a single step of
+ * a computation, by resetting the peak before the step and querying it
+ * with \ref igraph_memory_stats() afterwards.
+ *
+ * Time complexity: O(1).
+ */
+
+void igraph_memory_stats_reset_peak(void) {
+    igraph_memory_stats_t *stats = &igraph_i_memory_stats;
+#ifdef _OPENMP
+#pragma omp critical(igraph_i_memory_stats)
+#endif
+    {
+        stats->peak = stats->current;
+        for (int i = 0; i < IGRAPH_MEMORY_CATEGORY_COUNT; i++) {
+            stats->peak_by_category[i] = stats->current_by_category[i];
+        }
+    }
+}
+
+void igraph_i_memory_tag(void *ptr, igraph_memory_category_t category) {
+    igraph_i_memory_header_t *header;
+    igraph_memory_category_t old_category;
+
+    if (!igraph_i_memory_tracking || !ptr) {
+        return;
+    }
+
+    header = (igraph_i_memory_header_t *) ptr - 1;
+    old_category = header->info.category;
+    if (old_category == category ||
+        (old_category != IGRAPH_MEMORY_OTHER && old_category != IGRAPH_MEMORY_VECTOR)) {
+        return;
+    }
+
+    header->info.category = category;
+    igraph_i_memory_account(old_category, header->info.size, 0, -1);
+    igraph_i_memory_account(category, 0, header->info.size, 1);
+}
+
+igraph_memory_category_t igraph_i_memory_category_enter(igraph_memory_category_t category) {
+    igraph_memory_category_t previous = igraph_i_memory_category;
+    igraph_i_memory_category = category;
+    return previous;
+}
+
+void igraph_i_memory_category_exit(igraph_memory_category_t previous) {
+    igraph_i_memory_category = previous;
+}
+
+/**
+ * \function igraph_set_allocator
+ * \brief Sets the memory allocator used by igraph.
+ *
+ * \experimental
+ *
+ * Installs a table of allocation functions that igraph uses for all
+ * dynamic memory it manages through \ref IGRAPH_CALLOC, \ref IGRAPH_REALLOC,
+ * \ref IGRAPH_FREE and the functions in this chapter. This includes the
+ * storage of graphs, vectors, matrices and other data types, as well as
+ * temporary data of algorithms. Some third-party libraries bundled with
+ * igraph, and code written in C++, allocate memory on their own.
+ *
+ * </para><para>
+ * Memory must always be released with the allocator that allocated it.
+ * Therefore the allocator should be changed only while no igraph objects
+ * exist, typically at the start of the program, or it must be able to
+ * handle pointers from the previous allocator. The allocator is shared by
+ * all threads, and it must not be changed while other threads are using
+ * igraph. If igraph is used from several threads, the allocator functions
+ * must be thread-safe.
+ *
+ * </para><para>
+ * The table is not copied; it must remain valid while it is in use.
+ *
+ * \param allocator Pointer to the new allocator table, with all functions
+ *    set. \c NULL restores the allocator of the C standard library.
+ * \return Pointer to the previous allocator table, or \c NULL if the C
+ *    standard library was used.
+ *
+ * Time complexity: O(1).
+ */
+
+const igraph_allocator_t *igraph_set_allocator(const igraph_allocator_t *allocator) {
+    const igraph_allocator_t *previous = igraph_i_allocator;
+    igraph_i_allocator = allocator;
+    return previous;
+}
+
 /**
  * \function igraph_free
  * \brief Deallocates memory that was allocated by igraph functions.
@@ -60,7 +332,12 @@
  */
 
 void igraph_free(void *ptr) {
-    IGRAPH_FREE(ptr);
+    if (igraph_i_memory_tracking && ptr) {
+        igraph_i_memory_header_t *header = (igraph_i_memory_header_t *) ptr - 1;
+        igraph_i_memory_account(header->info.category, header->info.size, 0, -1);
+        ptr = header;
+    }
+    igraph_i_raw_free(ptr);
 }
 
 
@@ -80,7 +357,20 @@ void igraph_free(void *ptr) {
  */
 
 void *igraph_calloc(size_t count, size_t size) {
-    return (void *) IGRAPH_CALLOC(count * size, char);
+    if (count == 0 || size == 0) {
+        count = size = 1;
+    } else if (count > SIZE_MAX / size) {
+        return NULL;
+    }
+    if (igraph_i_memory_tracking) {
+        size = count * size;
+        if (size > SIZE_MAX - sizeof(igraph_i_memory_header_t)) {
+            return NULL;
+        }
+        return igraph_i_memory_track(
+            igraph_i_raw_calloc(1, size + sizeof(igraph_i_memory_header_t)), size);
+    }
+    return igraph_i_raw_calloc(count, size);
 }
 
 
@@ -99,7 +389,17 @@ void *igraph_calloc(size_t count, size_t size) {
  */
 
 void *igraph_malloc(size_t size) {
-    return IGRAPH_MALLOC(size);
+    if (size == 0) {
+        size = 1;
+    }
+    if (igraph_i_memory_tracking) {
+        if (size > SIZE_MAX - sizeof(igraph_i_memory_header_t)) {
+            return NULL;
+        }
+        return igraph_i_memory_track(
+            igraph_i_raw_malloc(size + sizeof(igraph_i_memory_header_t)), size);
+    }
+    return igraph_i_raw_malloc(size);
 }
 
 
@@ -119,5 +419,25 @@ void *igraph_malloc(size_t size) {
  */
 
 void *igraph_realloc(void *ptr, size_t size) {
-    return (void *) IGRAPH_REALLOC(ptr, size, char);
+    if (size == 0) {
+        size = 1;
+    }
+    if (igraph_i_memory_tracking && ptr) {
+        igraph_i_memory_header_t *header = (igraph_i_memory_header_t *) ptr - 1;
+        size_t old_size = header->info.size;
+        if (size > SIZE_MAX - sizeof(igraph_i_memory_header_t)) {
+            return NULL;
+        }
+        header = igraph_i_raw_realloc(header, size + sizeof(igraph_i_memory_header_t));
+        if (!header) {
+            return NULL;
+        }
+        /* The block keeps its category. */
+        header->info.size = size;
+        igraph_i_memory_account(header->info.category, old_size, size, 0);
+        return header + 1;
+    } else if (igraph_i_memory_tracking) {
+        return igraph_malloc(size);
+    }
+    return igraph_i_raw_realloc(ptr, size);
 }
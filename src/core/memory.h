@@ -0,0 +1,42 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IGRAPH_CORE_MEMORY_H
+#define IGRAPH_CORE_MEMORY_H
+
+#include "igraph_decls.h"
+#include "igraph_memory.h"
+
+__BEGIN_DECLS
+
+/* New blocks belong to IGRAPH_MEMORY_OTHER, unless the calling thread
+ * selected another category with igraph_i_memory_category_enter().
+ * Containers then claim their storage with igraph_i_memory_tag(); this
+ * moves the block to the given category if it was in IGRAPH_MEMORY_OTHER
+ * or IGRAPH_MEMORY_VECTOR, so that e.g. the data vector of a matrix is
+ * counted as a matrix, while vectors allocated by attribute handlers remain
+ * attributes. Both are no-ops when memory tracking is off. */
+
+void igraph_i_memory_tag(void *ptr, igraph_memory_category_t category);
+
+igraph_memory_category_t igraph_i_memory_category_enter(igraph_memory_category_t category);
+void igraph_i_memory_category_exit(igraph_memory_category_t previous);
+
+__END_DECLS
+
+#endif
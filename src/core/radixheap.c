@@ -0,0 +1,132 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "core/radixheap.h"
+
+#include "igraph_bitset.h"
+
+#include "math/safe_intop.h"
+
+/* The bucket of a key, relative to the last removed key. */
+static igraph_integer_t igraph_i_radixheap_bucket(const igraph_i_radixheap_t *h, igraph_integer_t key) {
+    igraph_uint_t diff = (igraph_uint_t) key ^ (igraph_uint_t) h->last;
+    return diff ? IGRAPH_INTEGER_SIZE - IGRAPH_CLZ(diff) : 0;
+}
+
+static void igraph_i_radixheap_link(igraph_i_radixheap_t *h, igraph_integer_t idx) {
+    igraph_integer_t b = igraph_i_radixheap_bucket(h, h->key[idx]);
+    h->prev[idx] = -1;
+    h->next[idx] = h->head[b];
+    if (h->head[b] >= 0) {
+        h->prev[h->head[b]] = idx;
+    }
+    h->head[b] = idx;
+}
+
+static void igraph_i_radixheap_unlink(igraph_i_radixheap_t *h, igraph_integer_t idx) {
+    if (h->prev[idx] >= 0) {
+        h->next[h->prev[idx]] = h->next[idx];
+    } else {
+        h->head[igraph_i_radixheap_bucket(h, h->key[idx])] = h->next[idx];
+    }
+    if (h->next[idx] >= 0) {
+        h->prev[h->next[idx]] = h->prev[idx];
+    }
+}
+
+/* Sets up an empty heap for the items 0 .. max_size-1. */
+igraph_error_t igraph_i_radixheap_init(igraph_i_radixheap_t *h, igraph_vector_int_t *storage,
+                                       igraph_integer_t max_size) {
+    igraph_integer_t size;
+
+    IGRAPH_SAFE_MULT(max_size, 3, &size);
+    IGRAPH_CHECK(igraph_vector_int_resize(storage, size));
+
+    h->key = VECTOR(*storage);
+    h->next = h->key + max_size;
+    h->prev = h->next + max_size;
+    igraph_i_radixheap_clear(h);
+
+    return IGRAPH_SUCCESS;
+}
+
+void igraph_i_radixheap_clear(igraph_i_radixheap_t *h) {
+    for (igraph_integer_t b = 0; b <= IGRAPH_INTEGER_SIZE; b++) {
+        h->head[b] = -1;
+    }
+    h->last = 0;
+    h->size = 0;
+}
+
+/* Adds an item that is not in the heap. */
+void igraph_i_radixheap_push(igraph_i_radixheap_t *h, igraph_integer_t idx, igraph_integer_t key) {
+    IGRAPH_ASSERT(key >= h->last);
+    h->key[idx] = key;
+    igraph_i_radixheap_link(h, idx);
+    h->size++;
+}
+
+/* Decreases the key of an item in the heap. */
+void igraph_i_radixheap_decrease(igraph_i_radixheap_t *h, igraph_integer_t idx, igraph_integer_t key) {
+    IGRAPH_ASSERT(key >= h->last);
+    igraph_i_radixheap_unlink(h, idx);
+    h->key[idx] = key;
+    igraph_i_radixheap_link(h, idx);
+}
+
+/* Removes an item with the smallest key, and returns it. The key is
+ * stored in 'key'. The heap must not be empty. */
+igraph_integer_t igraph_i_radixheap_pop_min(igraph_i_radixheap_t *h, igraph_integer_t *key) {
+    igraph_integer_t idx;
+
+    if (h->head[0] < 0) {
+        igraph_integer_t b = 1, min;
+
+        while (h->head[b] < 0) {
+            b++;
+        }
+
+        min = h->key[h->head[b]];
+        for (idx = h->next[h->head[b]]; idx >= 0; idx = h->next[idx]) {
+            if (h->key[idx] < min) {
+                min = h->key[idx];
+            }
+        }
+
+        /* All items of bucket b go to lower buckets relative to the new
+         * minimum; the higher buckets stay valid. */
+        idx = h->head[b];
+        h->head[b] = -1;
+        h->last = min;
+        while (idx >= 0) {
+            igraph_integer_t next = h->next[idx];
+            igraph_i_radixheap_link(h, idx);
+            idx = next;
+        }
+    }
+
+    idx = h->head[0];
+    h->head[0] = h->next[idx];
+    if (h->head[0] >= 0) {
+        h->prev[h->head[0]] = -1;
+    }
+    h->size--;
+    *key = h->key[idx];
+
+    return idx;
+}
@@ -0,0 +1,62 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IGRAPH_CORE_RADIXHEAP_H
+#define IGRAPH_CORE_RADIXHEAP_H
+
+#include "igraph_decls.h"
+#include "igraph_types.h"
+#include "igraph_vector.h"
+
+__BEGIN_DECLS
+
+/* Indexed radix heap with non-negative integer keys, for Dijkstra's
+ * algorithm with integer weights. The heap is monotone: keys that are
+ * pushed or decreased must not be smaller than the last key that was
+ * removed. Items whose key differs from this last key in bit i-1 as the
+ * highest bit are kept in bucket i, in a doubly linked list. Removing the
+ * minimum redistributes the lowest non-empty bucket into lower buckets, so
+ * each item is moved at most once per bit of the key range.
+ *
+ * See Ahuja, Mehlhorn, Orlin and Tarjan: Faster algorithms for the shortest
+ * path problem. J. ACM 37(2), 1990, https://doi.org/10.1145/77600.77615
+ *
+ * The heap does not own its storage: it uses a vector of three entries per
+ * item, which is resized by igraph_i_radixheap_init(), so that the storage
+ * can come from a workspace. */
+typedef struct {
+    igraph_integer_t *key;
+    igraph_integer_t *next;
+    igraph_integer_t *prev;
+    igraph_integer_t head[IGRAPH_INTEGER_SIZE + 1];
+    igraph_integer_t last;
+    igraph_integer_t size;
+} igraph_i_radixheap_t;
+
+igraph_error_t igraph_i_radixheap_init(igraph_i_radixheap_t *h, igraph_vector_int_t *storage,
+                                       igraph_integer_t max_size);
+void igraph_i_radixheap_clear(igraph_i_radixheap_t *h);
+void igraph_i_radixheap_push(igraph_i_radixheap_t *h, igraph_integer_t idx, igraph_integer_t key);
+void igraph_i_radixheap_decrease(igraph_i_radixheap_t *h, igraph_integer_t idx, igraph_integer_t key);
+igraph_integer_t igraph_i_radixheap_pop_min(igraph_i_radixheap_t *h, igraph_integer_t *key);
+
+#define igraph_i_radixheap_empty(h) ((h)->size == 0)
+
+__END_DECLS
+
+#endif
@@ -26,7 +26,7 @@
 #include "igraph_memory.h"
 #include "igraph_error.h"
 
-#include "internal/hacks.h" /* strdup */
+#include "internal/hacks.h" /* igraph_i_strdup */
 #include "math/safe_intop.h"
 
 #include <string.h>         /* memcpy & co. */
@@ -166,7 +166,7 @@ igraph_error_t igraph_strvector_set_len(igraph_strvector_t *sv, igraph_integer_t
     IGRAPH_ASSERT(sv->stor_begin != NULL);
 
     if (sv->stor_begin[idx] == NULL) {
-        sv->stor_begin[idx] = strndup(value, len);
+        sv->stor_begin[idx] = igraph_i_strndup(value, len);
         IGRAPH_CHECK_OOM(sv->stor_begin[idx], "Cannot reserve space for new item in string vector.");
     } else {
         char *tmp = IGRAPH_REALLOC(sv->stor_begin[idx], len + 1, char);
@@ -259,7 +259,7 @@ igraph_error_t igraph_strvector_init_copy(igraph_strvector_t *to,
         if (from->stor_begin[i] == NULL || from->stor_begin[i][0] == '\0') {
             continue;
         }
-        to->stor_begin[i] = strdup(from->stor_begin[i]);
+        to->stor_begin[i] = igraph_i_strdup(from->stor_begin[i]);
         if (to->stor_begin[i] == NULL) {
             /* LCOV_EXCL_START */
             for (igraph_integer_t j = 0; j < i; j++) {
@@ -324,7 +324,7 @@ igraph_error_t igraph_strvector_append(igraph_strvector_t *to,
             /* Represent empty strings as NULL. */
             tmp = NULL;
         } else {
-            tmp = strdup(from->stor_begin[i]);
+            tmp = igraph_i_strdup(from->stor_begin[i]);
             if (tmp == NULL) {
                 error = true;
                 break;
@@ -586,7 +586,7 @@ static igraph_error_t igraph_i_strvector_expand_if_full(igraph_strvector_t *sv)
 
 igraph_error_t igraph_strvector_push_back(igraph_strvector_t *sv, const char *value) {
     IGRAPH_CHECK(igraph_i_strvector_expand_if_full(sv));
-    char *tmp = strdup(value);
+    char *tmp = igraph_i_strdup(value);
     IGRAPH_CHECK_OOM(tmp, "Cannot push new string to string vector.");
     *sv->end = tmp;
     sv->end++;
@@ -613,7 +613,7 @@ igraph_error_t igraph_strvector_push_back_len(
         const char *value, igraph_integer_t len) {
 
     IGRAPH_CHECK(igraph_i_strvector_expand_if_full(sv));
-    char *tmp = strndup(value, len);
+    char *tmp = igraph_i_strndup(value, len);
     if (! tmp) {
         IGRAPH_ERROR("Cannot add string to string vector.", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
     }
@@ -25,7 +25,7 @@
 #include "igraph_memory.h"
 
 #include "core/trie.h"
-#include "internal/hacks.h" /* strdup */
+#include "internal/hacks.h" /* igraph_i_strdup */
 
 #include <assert.h>
 #include <string.h>
@@ -206,7 +206,7 @@ static igraph_error_t igraph_i_trie_get_node(
             VECTOR(node->children)[0] = VECTOR(t->children)[i];
             VECTOR(node->values)[0] = VECTOR(t->values)[i];
 
-            str2 = strdup(str);
+            str2 = igraph_i_strdup(str);
             IGRAPH_CHECK_OOM(str2, "Cannot add to trie.");
             IGRAPH_FINALLY(igraph_free, str2);
             str2[diff] = '\0';
@@ -242,7 +242,7 @@ static igraph_error_t igraph_i_trie_get_node(
             VECTOR(node->values)[0] = VECTOR(t->values)[i];
             VECTOR(node->values)[1] = newvalue;
 
-            str2 = strdup(str);
+            str2 = igraph_i_strdup(str);
             IGRAPH_CHECK_OOM(str2, "Cannot add to trie.");
 
             str2[diff] = '\0';
@@ -357,7 +357,7 @@ igraph_error_t igraph_trie_get_len(
         igraph_integer_t length,
         igraph_integer_t *id) {
 
-    char *tmp = strndup(key, length);
+    char *tmp = igraph_i_strndup(key, length);
     IGRAPH_CHECK_OOM(tmp, "Cannot get from trie.");
     IGRAPH_FINALLY(igraph_free, tmp);
     IGRAPH_CHECK(igraph_trie_get(t, tmp, id));
@@ -0,0 +1,249 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "igraph_workspace.h"
+
+#include "igraph_memory.h"
+
+#include "core/workspace.h"
+
+/**
+ * \section about_workspaces
+ *
+ * <para>
+ * Many igraph functions need temporary memory proportional to the size of
+ * the graph, which is allocated and released on each call. When such a
+ * function is called many times, e.g. to answer a stream of queries on the
+ * same graph, these allocations may take a noticeable fraction of the
+ * running time. Functions that accept an \ref igraph_workspace_t object
+ * keep their temporary buffers in it, so that subsequent calls with the same
+ * workspace can reuse them. Passing a null pointer instead of a workspace
+ * makes these functions allocate their temporary memory themselves.
+ * </para>
+ */
+
+/**
+ * \function igraph_workspace_init
+ * \brief Initializes an empty workspace.
+ *
+ * \experimental
+ *
+ * The workspace does not hold any buffers initially; these are allocated
+ * by the functions that use the workspace, as needed.
+ *
+ * \param ws Pointer to an uninitialized workspace object.
+ * \return Error code: \c IGRAPH_ENOMEM if there is not enough memory.
+ *
+ * Time complexity: O(1).
+ */
+
+igraph_error_t igraph_workspace_init(igraph_workspace_t *ws) {
+    IGRAPH_CHECK(igraph_vector_ptr_init(&ws->vectors, 0));
+    IGRAPH_FINALLY(igraph_vector_ptr_destroy, &ws->vectors);
+    IGRAPH_CHECK(igraph_vector_ptr_init(&ws->int_vectors, 0));
+    IGRAPH_FINALLY(igraph_vector_ptr_destroy, &ws->int_vectors);
+    IGRAPH_CHECK(igraph_vector_ptr_init(&ws->bitsets, 0));
+    IGRAPH_FINALLY(igraph_vector_ptr_destroy, &ws->bitsets);
+    IGRAPH_CHECK(igraph_vector_ptr_init(&ws->heaps, 0));
+
+    IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&ws->vectors, igraph_vector_destroy);
+    IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&ws->int_vectors, igraph_vector_int_destroy);
+    IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&ws->bitsets, igraph_bitset_destroy);
+    IGRAPH_VECTOR_PTR_SET_ITEM_DESTRUCTOR(&ws->heaps, igraph_2wheap_destroy);
+
+    ws->vectors_used = 0;
+    ws->int_vectors_used = 0;
+    ws->bitsets_used = 0;
+    ws->heaps_used = 0;
+
+    IGRAPH_FINALLY_CLEAN(3);
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_workspace_destroy
+ * \brief Destroys a workspace and releases all of its buffers.
+ *
+ * \experimental
+ *
+ * \param ws The workspace to destroy.
+ *
+ * Time complexity: O(k), the number of buffers in the workspace.
+ */
+
+void igraph_workspace_destroy(igraph_workspace_t *ws) {
+    igraph_vector_ptr_destroy_all(&ws->heaps);
+    igraph_vector_ptr_destroy_all(&ws->bitsets);
+    igraph_vector_ptr_destroy_all(&ws->int_vectors);
+    igraph_vector_ptr_destroy_all(&ws->vectors);
+}
+
+/**
+ * \function igraph_workspace_clear
+ * \brief Releases the buffers held by a workspace.
+ *
+ * \experimental
+ *
+ * The workspace remains usable after this call, and will allocate new
+ * buffers when needed. This can be used to give back memory after
+ * working with a large graph.
+ *
+ * \param ws The workspace to clear.
+ *
+ * Time complexity: O(k), the number of buffers in the workspace.
+ */
+
+void igraph_workspace_clear(igraph_workspace_t *ws) {
+    igraph_vector_ptr_free_all(&ws->heaps);
+    igraph_vector_ptr_clear(&ws->heaps);
+    igraph_vector_ptr_free_all(&ws->bitsets);
+    igraph_vector_ptr_clear(&ws->bitsets);
+    igraph_vector_ptr_free_all(&ws->int_vectors);
+    igraph_vector_ptr_clear(&ws->int_vectors);
+    igraph_vector_ptr_free_all(&ws->vectors);
+    igraph_vector_ptr_clear(&ws->vectors);
+    igraph_i_workspace_reset(ws);
+}
+
+void igraph_i_workspace_reset(igraph_workspace_t *ws) {
+    ws->vectors_used = 0;
+    ws->int_vectors_used = 0;
+    ws->bitsets_used = 0;
+    ws->heaps_used = 0;
+}
+
+void igraph_i_workspace_mark(const igraph_workspace_t *ws, igraph_i_workspace_mark_t *mark) {
+    mark->vectors = ws->vectors_used;
+    mark->int_vectors = ws->int_vectors_used;
+    mark->bitsets = ws->bitsets_used;
+    mark->heaps = ws->heaps_used;
+}
+
+void igraph_i_workspace_release(igraph_workspace_t *ws, const igraph_i_workspace_mark_t *mark) {
+    ws->vectors_used = mark->vectors;
+    ws->int_vectors_used = mark->int_vectors;
+    ws->bitsets_used = mark->bitsets;
+    ws->heaps_used = mark->heaps;
+}
+
+/* Adds a newly allocated and initialized item to a pool. The item is freed
+ * if it cannot be added. */
+static igraph_error_t igraph_i_workspace_add(
+        igraph_vector_ptr_t *pool, void *item, igraph_finally_func_t *destroy) {
+    igraph_error_t err = igraph_vector_ptr_push_back(pool, item);
+    if (err != IGRAPH_SUCCESS) {
+        destroy(item);
+        IGRAPH_FREE(item);
+        IGRAPH_ERROR("Cannot add buffer to workspace.", err); /* LCOV_EXCL_LINE */
+    }
+    return IGRAPH_SUCCESS;
+}
+
+igraph_error_t igraph_i_workspace_vector(igraph_workspace_t *ws, igraph_integer_t size, igraph_vector_t **vec) {
+    igraph_vector_t *v;
+
+    if (ws->vectors_used < igraph_vector_ptr_size(&ws->vectors)) {
+        v = VECTOR(ws->vectors)[ws->vectors_used];
+        IGRAPH_CHECK(igraph_vector_resize(v, size));
+        igraph_vector_null(v);
+    } else {
+        v = IGRAPH_CALLOC(1, igraph_vector_t);
+        IGRAPH_CHECK_OOM(v, "Cannot allocate workspace buffer.");
+        IGRAPH_FINALLY(igraph_free, v);
+        IGRAPH_CHECK(igraph_vector_init(v, size));
+        IGRAPH_FINALLY_CLEAN(1);
+        IGRAPH_CHECK(igraph_i_workspace_add(&ws->vectors, v, (igraph_finally_func_t *) igraph_vector_destroy));
+    }
+
+    ws->vectors_used++;
+    *vec = v;
+    return IGRAPH_SUCCESS;
+}
+
+igraph_error_t igraph_i_workspace_vector_int(igraph_workspace_t *ws, igraph_integer_t size, igraph_vector_int_t **vec) {
+    igraph_vector_int_t *v;
+
+    if (ws->int_vectors_used < igraph_vector_ptr_size(&ws->int_vectors)) {
+        v = VECTOR(ws->int_vectors)[ws->int_vectors_used];
+        IGRAPH_CHECK(igraph_vector_int_resize(v, size));
+        igraph_vector_int_null(v);
+    } else {
+        v = IGRAPH_CALLOC(1, igraph_vector_int_t);
+        IGRAPH_CHECK_OOM(v, "Cannot allocate workspace buffer.");
+        IGRAPH_FINALLY(igraph_free, v);
+        IGRAPH_CHECK(igraph_vector_int_init(v, size));
+        IGRAPH_FINALLY_CLEAN(1);
+        IGRAPH_CHECK(igraph_i_workspace_add(&ws->int_vectors, v, (igraph_finally_func_t *) igraph_vector_int_destroy));
+    }
+
+    ws->int_vectors_used++;
+    *vec = v;
+    return IGRAPH_SUCCESS;
+}
+
+igraph_error_t igraph_i_workspace_bitset(igraph_workspace_t *ws, igraph_integer_t size, igraph_bitset_t **bitset) {
+    igraph_bitset_t *b;
+
+    if (ws->bitsets_used < igraph_vector_ptr_size(&ws->bitsets)) {
+        b = VECTOR(ws->bitsets)[ws->bitsets_used];
+        IGRAPH_CHECK(igraph_bitset_resize(b, size));
+        igraph_bitset_null(b);
+    } else {
+        b = IGRAPH_CALLOC(1, igraph_bitset_t);
+        IGRAPH_CHECK_OOM(b, "Cannot allocate workspace buffer.");
+        IGRAPH_FINALLY(igraph_free, b);
+        IGRAPH_CHECK(igraph_bitset_init(b, size));
+        IGRAPH_FINALLY_CLEAN(1);
+        IGRAPH_CHECK(igraph_i_workspace_add(&ws->bitsets, b, (igraph_finally_func_t *) igraph_bitset_destroy));
+    }
+
+    ws->bitsets_used++;
+    *bitset = b;
+    return IGRAPH_SUCCESS;
+}
+
+igraph_error_t igraph_i_workspace_2wheap(igraph_workspace_t *ws, igraph_integer_t max_size, igraph_2wheap_t **heap) {
+    igraph_2wheap_t *h;
+
+    if (ws->heaps_used < igraph_vector_ptr_size(&ws->heaps)) {
+        igraph_integer_t old_size;
+
+        h = VECTOR(ws->heaps)[ws->heaps_used];
+        /* The index of a two-way heap always has one entry per possible
+         * item, so it is resized after clearing, and only the new entries
+         * are zeroed; the heap storage itself keeps its capacity. */
+        igraph_2wheap_clear(h);
+        old_size = igraph_vector_int_size(&h->index2);
+        IGRAPH_CHECK(igraph_vector_int_resize(&h->index2, max_size));
+        for (igraph_integer_t i = old_size; i < max_size; i++) {
+            VECTOR(h->index2)[i] = 0;
+        }
+        h->max_size = max_size;
+    } else {
+        h = IGRAPH_CALLOC(1, igraph_2wheap_t);
+        IGRAPH_CHECK_OOM(h, "Cannot allocate workspace buffer.");
+        IGRAPH_FINALLY(igraph_free, h);
+        IGRAPH_CHECK(igraph_2wheap_init(h, max_size));
+        IGRAPH_FINALLY_CLEAN(1);
+        IGRAPH_CHECK(igraph_i_workspace_add(&ws->heaps, h, (igraph_finally_func_t *) igraph_2wheap_destroy));
+    }
+
+    ws->heaps_used++;
+    *heap = h;
+    return IGRAPH_SUCCESS;
+}
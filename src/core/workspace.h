@@ -0,0 +1,60 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IGRAPH_CORE_WORKSPACE_H
+#define IGRAPH_CORE_WORKSPACE_H
+
+#include "igraph_decls.h"
+#include "igraph_bitset.h"
+#include "igraph_vector.h"
+#include "igraph_workspace.h"
+
+#include "core/indheap.h"
+
+__BEGIN_DECLS
+
+/* Buffers are handed out from a workspace in a stack-like manner. A function
+ * that takes a workspace from its caller calls igraph_i_workspace_reset()
+ * first, which makes all buffers available again; this also takes care of
+ * buffers that were not given back because an earlier call failed. Helper
+ * functions that are called repeatedly with the same workspace save the
+ * state with igraph_i_workspace_mark() and give back the buffers they
+ * took with igraph_i_workspace_release(). */
+
+typedef struct {
+    igraph_integer_t vectors;
+    igraph_integer_t int_vectors;
+    igraph_integer_t bitsets;
+    igraph_integer_t heaps;
+} igraph_i_workspace_mark_t;
+
+void igraph_i_workspace_reset(igraph_workspace_t *ws);
+void igraph_i_workspace_mark(const igraph_workspace_t *ws, igraph_i_workspace_mark_t *mark);
+void igraph_i_workspace_release(igraph_workspace_t *ws, const igraph_i_workspace_mark_t *mark);
+
+/* These return a buffer of the given size, filled with zeros. */
+igraph_error_t igraph_i_workspace_vector(igraph_workspace_t *ws, igraph_integer_t size, igraph_vector_t **vec);
+igraph_error_t igraph_i_workspace_vector_int(igraph_workspace_t *ws, igraph_integer_t size, igraph_vector_int_t **vec);
+igraph_error_t igraph_i_workspace_bitset(igraph_workspace_t *ws, igraph_integer_t size, igraph_bitset_t **bitset);
+
+/* This returns an empty two-way heap for the given maximum number of items. */
+igraph_error_t igraph_i_workspace_2wheap(igraph_workspace_t *ws, igraph_integer_t max_size, igraph_2wheap_t **heap);
+
+__END_DECLS
+
+#endif
@@ -27,6 +27,8 @@
 #include "igraph_interface.h"
 
 #include "core/interruption.h"
+#include "core/memory.h"
+#include "graph/internal.h"
 
 #include <stdio.h>
 
@@ -89,6 +91,13 @@ static igraph_error_t igraph_i_remove_loops_from_incidence_vector_in_place(
  * on how exactly the rewiring is done) typically O(|V|+|E|) time for
  * the whole rewiring process.</para>
  *
+ * <para>The <type>igraph_csr_t</type> type stores the same information
+ * as a non-lazy adjacency or incidence list in compressed sparse row form:
+ * all neighbors are kept in a single array, indexed by a vector of
+ * offsets. It cannot be modified, but it is cheaper to create and faster
+ * to traverse, which makes it suitable for algorithms that repeatedly
+ * iterate over the neighbors of all vertices of large graphs.</para>
+ *
  * <para>Lazy adjacency lists are a bit different. When creating a
  * lazy adjacency list, the neighbors of the vertices are not queried,
  * only some memory is allocated for the vectors. When \ref
@@ -174,6 +183,7 @@ igraph_error_t igraph_adjlist_init(const igraph_t *graph, igraph_adjlist_t *al,
     al->length = no_of_nodes;
     al->adjs = IGRAPH_CALLOC(al->length, igraph_vector_int_t);
     IGRAPH_CHECK_OOM(al->adjs, "Insufficient memory for creating adjacency list view.");
+    igraph_i_memory_tag(al->adjs, IGRAPH_MEMORY_ADJLIST);
     IGRAPH_FINALLY(igraph_adjlist_destroy, al);
 
     /* if we already know there are no multi-edges, they don't need to be removed */
@@ -198,6 +208,7 @@ igraph_error_t igraph_adjlist_init(const igraph_t *graph, igraph_adjlist_t *al,
         IGRAPH_ALLOW_INTERRUPTION();
 
         IGRAPH_CHECK(igraph_vector_int_init(&al->adjs[i], VECTOR(degrees)[i]));
+        igraph_i_memory_tag(al->adjs[i].stor_begin, IGRAPH_MEMORY_ADJLIST);
         IGRAPH_CHECK(igraph_neighbors(graph, &al->adjs[i], i, mode));
 
         /* Attention: This function will only set values for has_loops and has_multiple
@@ -252,10 +263,12 @@ igraph_error_t igraph_adjlist_init_empty(igraph_adjlist_t *al, igraph_integer_t
     al->length = no_of_nodes;
     al->adjs = IGRAPH_CALLOC(al->length, igraph_vector_int_t);
     IGRAPH_CHECK_OOM(al->adjs, "Insufficient memory for creating adjlist.");
+    igraph_i_memory_tag(al->adjs, IGRAPH_MEMORY_ADJLIST);
     IGRAPH_FINALLY(igraph_adjlist_destroy, al);
 
     for (igraph_integer_t i = 0; i < al->length; i++) {
         IGRAPH_CHECK(igraph_vector_int_init(&al->adjs[i], 0));
+        igraph_i_memory_tag(al->adjs[i].stor_begin, IGRAPH_MEMORY_ADJLIST);
     }
 
     IGRAPH_FINALLY_CLEAN(1);
@@ -308,6 +321,7 @@ igraph_error_t igraph_adjlist_init_complementer(const igraph_t *graph,
     al->length = igraph_vcount(graph);
     al->adjs = IGRAPH_CALLOC(al->length, igraph_vector_int_t);
     IGRAPH_CHECK_OOM(al->adjs, "Insufficient memory for creating complementer adjlist view.");
+    igraph_i_memory_tag(al->adjs, IGRAPH_MEMORY_ADJLIST);
     IGRAPH_FINALLY(igraph_adjlist_destroy, al);
 
     IGRAPH_BITSET_INIT_FINALLY(&seen, al->length);
@@ -341,6 +355,7 @@ igraph_error_t igraph_adjlist_init_complementer(const igraph_t *graph,
 
         /* Produce "non-neighbor" list in sorted order. */
         IGRAPH_CHECK(igraph_vector_int_init(&al->adjs[i], n));
+        igraph_i_memory_tag(al->adjs[i].stor_begin, IGRAPH_MEMORY_ADJLIST);
         for (igraph_integer_t j = 0, k = 0; k < n; j++) {
             if (!IGRAPH_BIT_TEST(seen, j)) {
                 VECTOR(al->adjs[i])[k++] = j;
@@ -787,12 +802,14 @@ igraph_error_t igraph_inclist_init(const igraph_t *graph,
     if (il->incs == 0) {
         IGRAPH_ERROR("Cannot create incidence list view.", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
     }
+    igraph_i_memory_tag(il->incs, IGRAPH_MEMORY_ADJLIST);
 
     IGRAPH_FINALLY(igraph_inclist_destroy, il);
     for (igraph_integer_t i = 0; i < il->length; i++) {
         IGRAPH_ALLOW_INTERRUPTION();
 
         IGRAPH_CHECK(igraph_vector_int_init(&il->incs[i], VECTOR(degrees)[i]));
+        igraph_i_memory_tag(il->incs[i].stor_begin, IGRAPH_MEMORY_ADJLIST);
         IGRAPH_CHECK(igraph_incident(graph, &il->incs[i], i, mode));
 
         if (loops != IGRAPH_LOOPS_TWICE) {
@@ -831,10 +848,12 @@ igraph_error_t igraph_inclist_init_empty(igraph_inclist_t *il, igraph_integer_t
     if (il->incs == 0) {
         IGRAPH_ERROR("Cannot create incidence list view", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
     }
+    igraph_i_memory_tag(il->incs, IGRAPH_MEMORY_ADJLIST);
 
     IGRAPH_FINALLY(igraph_inclist_destroy, il);
     for (i = 0; i < n; i++) {
         IGRAPH_CHECK(igraph_vector_int_init(&il->incs[i], 0));
+        igraph_i_memory_tag(il->incs[i].stor_begin, IGRAPH_MEMORY_ADJLIST);
     }
 
     IGRAPH_FINALLY_CLEAN(1);
@@ -889,6 +908,153 @@ igraph_integer_t igraph_inclist_size(const igraph_inclist_t *il) {
     return il->length;
 }
 
+/**
+ * \function igraph_csr_init
+ * \brief Constructs a compressed sparse row adjacency structure from a graph.
+ *
+ * \experimental
+ *
+ * Stores the neighbors of all vertices in a single contiguous array,
+ * together with an array of offsets: the neighbors of vertex \c v are
+ * the elements of \c neis with indices from <code>offsets[v]</code> up
+ * to, but not including, <code>offsets[v+1]</code>. Optionally, the IDs of
+ * the corresponding edges are stored in a parallel array. Compared to
+ * \ref igraph_adjlist_init(), this needs three allocations instead of one
+ * per vertex, and traversals read memory sequentially. Like other adjacency
+ * lists, the structure is independent of the graph after creation.
+ *
+ * </para><para>
+ * The neighbors of each vertex are sorted, in the same order as returned
+ * by \ref igraph_neighbors(). Use \ref igraph_csr_neighbors(),
+ * \ref igraph_csr_edges() and \ref igraph_csr_degree() to access them.
+ *
+ * \param graph The input graph.
+ * \param csr Pointer to an uninitialized <type>igraph_csr_t</type> object.
+ * \param mode Constant specifying whether to include only outgoing
+ *   (\c IGRAPH_OUT), only incoming (\c IGRAPH_IN),
+ *   or both (\c IGRAPH_ALL) types of neighbors.
+ *   It is ignored for undirected graphs.
+ * \param loops Specifies how to treat loop edges, see
+ *   \ref igraph_adjlist_init().
+ * \param multiple Specifies how to treat multiple (parallel) edges, see
+ *   \ref igraph_adjlist_init(). It must be \c IGRAPH_MULTIPLE when
+ *   \p edge_ids is true.
+ * \param edge_ids Whether to store the IDs of the edges leading to the
+ *   neighbors as well.
+ * \return Error code.
+ *
+ * Time complexity: O(|V|+|E|), linear in the number of vertices and
+ * edges.
+ */
+igraph_error_t igraph_csr_init(const igraph_t *graph, igraph_csr_t *csr,
+                               igraph_neimode_t mode, igraph_loops_t loops,
+                               igraph_multiple_t multiple, igraph_bool_t edge_ids) {
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t no_of_edges = igraph_ecount(graph);
+    igraph_integer_t max_size, size = 0;
+    igraph_vector_int_t tmp;
+
+    if (mode != IGRAPH_IN && mode != IGRAPH_OUT && mode != IGRAPH_ALL) {
+        IGRAPH_ERROR("Cannot create CSR adjacency structure.", IGRAPH_EINVMODE);
+    }
+
+    if (!igraph_is_directed(graph)) {
+        mode = IGRAPH_ALL;
+    }
+
+    /* Loop edges can appear twice only when both directions are considered. */
+    if (mode != IGRAPH_ALL && loops == IGRAPH_LOOPS_TWICE) {
+        loops = IGRAPH_LOOPS_ONCE;
+    }
+
+    if (edge_ids && multiple != IGRAPH_MULTIPLE) {
+        IGRAPH_ERROR("Edge IDs can only be stored when multi-edges are kept.", IGRAPH_EINVAL);
+    }
+
+    /* Each edge appears at most twice, the arrays are shrunk at the end. */
+    max_size = mode == IGRAPH_ALL ? 2 * no_of_edges : no_of_edges;
+
+    csr->length = no_of_nodes;
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&csr->offsets, no_of_nodes + 1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&csr->neis, max_size);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&csr->eids, edge_ids ? max_size : 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&tmp, 0);
+    igraph_i_memory_tag(csr->offsets.stor_begin, IGRAPH_MEMORY_ADJLIST);
+    igraph_i_memory_tag(csr->neis.stor_begin, IGRAPH_MEMORY_ADJLIST);
+    igraph_i_memory_tag(csr->eids.stor_begin, IGRAPH_MEMORY_ADJLIST);
+
+    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+        igraph_integer_t n;
+
+        IGRAPH_ALLOW_INTERRUPTION();
+
+        VECTOR(csr->offsets)[i] = size;
+
+        if (edge_ids) {
+            IGRAPH_CHECK(igraph_i_incident(graph, &tmp, i, mode, loops));
+            n = igraph_vector_int_size(&tmp);
+            for (igraph_integer_t j = 0; j < n; j++) {
+                igraph_integer_t edge = VECTOR(tmp)[j];
+                VECTOR(csr->eids)[size + j] = edge;
+                VECTOR(csr->neis)[size + j] = IGRAPH_OTHER(graph, edge, i);
+            }
+        } else {
+            IGRAPH_CHECK(igraph_i_neighbors(graph, &tmp, i, mode, loops, multiple));
+            n = igraph_vector_int_size(&tmp);
+            for (igraph_integer_t j = 0; j < n; j++) {
+                VECTOR(csr->neis)[size + j] = VECTOR(tmp)[j];
+            }
+        }
+
+        size += n;
+    }
+    VECTOR(csr->offsets)[no_of_nodes] = size;
+
+    /* These always succeed since we are never growing the vectors. */
+    igraph_vector_int_resize(&csr->neis, size);
+    igraph_vector_int_resize_min(&csr->neis);
+    if (edge_ids) {
+        igraph_vector_int_resize(&csr->eids, size);
+        igraph_vector_int_resize_min(&csr->eids);
+    }
+
+    igraph_vector_int_destroy(&tmp);
+    IGRAPH_FINALLY_CLEAN(4);
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_csr_destroy
+ * \brief Deallocates a compressed sparse row adjacency structure.
+ *
+ * \experimental
+ *
+ * \param csr The structure to destroy.
+ *
+ * Time complexity: operating system dependent.
+ */
+void igraph_csr_destroy(igraph_csr_t *csr) {
+    igraph_vector_int_destroy(&csr->eids);
+    igraph_vector_int_destroy(&csr->neis);
+    igraph_vector_int_destroy(&csr->offsets);
+}
+
+/**
+ * \function igraph_csr_size
+ * \brief Returns the number of vertices in a compressed sparse row structure.
+ *
+ * \experimental
+ *
+ * \param csr The compressed sparse row structure.
+ * \return The number of vertices.
+ *
+ * Time complexity: O(1).
+ */
+igraph_integer_t igraph_csr_size(const igraph_csr_t *csr) {
+    return csr->length;
+}
+
 /* See the prototype above for a description of this function. */
 static igraph_error_t igraph_i_simplify_sorted_int_adjacency_vector_in_place(
     igraph_vector_int_t *v, igraph_integer_t index, igraph_neimode_t mode,
@@ -1124,6 +1290,7 @@ igraph_error_t igraph_lazy_adjlist_init(const igraph_t *graph,
     al->length = igraph_vcount(graph);
     al->adjs = IGRAPH_CALLOC(al->length, igraph_vector_int_t*);
     IGRAPH_CHECK_OOM(al->adjs, "Insufficient memory for creating lazy adjacency list view.");
+    igraph_i_memory_tag(al->adjs, IGRAPH_MEMORY_ADJLIST);
 
     return IGRAPH_SUCCESS;
 }
@@ -1188,6 +1355,8 @@ igraph_vector_int_t *igraph_i_lazy_adjlist_get_real(igraph_lazy_adjlist_t *al, i
             IGRAPH_FREE(al->adjs[no]);
             return NULL;
         }
+        igraph_i_memory_tag(al->adjs[no], IGRAPH_MEMORY_ADJLIST);
+        igraph_i_memory_tag(al->adjs[no]->stor_begin, IGRAPH_MEMORY_ADJLIST);
 
         ret = igraph_neighbors(al->graph, al->adjs[no], no, al->mode);
         if (ret != IGRAPH_SUCCESS) {
@@ -1272,6 +1441,7 @@ igraph_error_t igraph_lazy_inclist_init(const igraph_t *graph,
     if (il->incs == 0) {
         IGRAPH_ERROR("Cannot create lazy incidence list view", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
     }
+    igraph_i_memory_tag(il->incs, IGRAPH_MEMORY_ADJLIST);
 
     return IGRAPH_SUCCESS;
 
@@ -1339,6 +1509,8 @@ igraph_vector_int_t *igraph_i_lazy_inclist_get_real(igraph_lazy_inclist_t *il, i
             IGRAPH_FREE(il->incs[no]);
             return NULL;
         }
+        igraph_i_memory_tag(il->incs[no], IGRAPH_MEMORY_ADJLIST);
+        igraph_i_memory_tag(il->incs[no]->stor_begin, IGRAPH_MEMORY_ADJLIST);
 
         ret = igraph_incident(il->graph, il->incs[no], no, il->mode);
         if (ret != IGRAPH_SUCCESS) {
@@ -24,8 +24,9 @@
 #include "igraph_attributes.h"
 #include "igraph_memory.h"
 
+#include "core/memory.h"
 #include "graph/attributes.h"
-#include "internal/hacks.h" /* strdup */
+#include "internal/hacks.h" /* igraph_i_strdup */
 
 #include <string.h>
 #include <stdarg.h>
@@ -37,7 +38,10 @@ igraph_attribute_table_t *igraph_i_attribute_table = NULL;
 igraph_error_t igraph_i_attribute_init(igraph_t *graph, void *attr) {
     graph->attr = NULL;
     if (igraph_i_attribute_table) {
-        return igraph_i_attribute_table->init(graph, attr);
+        igraph_memory_category_t category = igraph_i_memory_category_enter(IGRAPH_MEMORY_ATTRIBUTES);
+        igraph_error_t err = igraph_i_attribute_table->init(graph, attr);
+        igraph_i_memory_category_exit(category);
+        return err;
     } else {
         return IGRAPH_SUCCESS;
     }
@@ -50,11 +54,22 @@ void igraph_i_attribute_destroy(igraph_t *graph) {
     graph->attr = NULL;
 }
 
+size_t igraph_i_attribute_memory_size(const igraph_t *graph) {
+    if (igraph_i_attribute_table && igraph_i_attribute_table->get_memory_size) {
+        return igraph_i_attribute_table->get_memory_size(graph);
+    } else {
+        return 0;
+    }
+}
+
 igraph_error_t igraph_i_attribute_copy(igraph_t *to, const igraph_t *from, igraph_bool_t ga,
                             igraph_bool_t va, igraph_bool_t ea) {
     to->attr = NULL;
     if (igraph_i_attribute_table) {
-        return igraph_i_attribute_table->copy(to, from, ga, va, ea);
+        igraph_memory_category_t category = igraph_i_memory_category_enter(IGRAPH_MEMORY_ATTRIBUTES);
+        igraph_error_t err = igraph_i_attribute_table->copy(to, from, ga, va, ea);
+        igraph_i_memory_category_exit(category);
+        return err;
     } else {
         return IGRAPH_SUCCESS;
     }
@@ -62,7 +77,10 @@ igraph_error_t igraph_i_attribute_copy(igraph_t *to, const igraph_t *from, igrap
 
 igraph_error_t igraph_i_attribute_add_vertices(igraph_t *graph, igraph_integer_t nv, void *attr) {
     if (igraph_i_attribute_table) {
-        return igraph_i_attribute_table->add_vertices(graph, nv, attr);
+        igraph_memory_category_t category = igraph_i_memory_category_enter(IGRAPH_MEMORY_ATTRIBUTES);
+        igraph_error_t err = igraph_i_attribute_table->add_vertices(graph, nv, attr);
+        igraph_i_memory_category_exit(category);
+        return err;
     } else {
         return IGRAPH_SUCCESS;
     }
@@ -75,7 +93,10 @@ igraph_error_t igraph_i_attribute_permute_vertices(const igraph_t *graph,
      * in-place operations. If they are _not_ the same, it is assumed that the
      * new graph has no vertex attributes yet */
     if (igraph_i_attribute_table) {
-        return igraph_i_attribute_table->permute_vertices(graph, newgraph, idx);
+        igraph_memory_category_t category = igraph_i_memory_category_enter(IGRAPH_MEMORY_ATTRIBUTES);
+        igraph_error_t err = igraph_i_attribute_table->permute_vertices(graph, newgraph, idx);
+        igraph_i_memory_category_exit(category);
+        return err;
     } else {
         return IGRAPH_SUCCESS;
     }
@@ -90,9 +111,10 @@ igraph_error_t igraph_i_attribute_combine_vertices(const igraph_t *graph,
      * can assert the former */
     IGRAPH_ASSERT(graph != newgraph);
     if (igraph_i_attribute_table) {
-        return igraph_i_attribute_table->combine_vertices(graph, newgraph,
-                merges,
-                comb);
+        igraph_memory_category_t category = igraph_i_memory_category_enter(IGRAPH_MEMORY_ATTRIBUTES);
+        igraph_error_t err = igraph_i_attribute_table->combine_vertices(graph, newgraph, merges, comb);
+        igraph_i_memory_category_exit(category);
+        return err;
     } else {
         return IGRAPH_SUCCESS;
     }
@@ -101,7 +123,10 @@ igraph_error_t igraph_i_attribute_combine_vertices(const igraph_t *graph,
 igraph_error_t igraph_i_attribute_add_edges(igraph_t *graph,
                                  const igraph_vector_int_t *edges, void *attr) {
     if (igraph_i_attribute_table) {
-        return igraph_i_attribute_table->add_edges(graph, edges, attr);
+        igraph_memory_category_t category = igraph_i_memory_category_enter(IGRAPH_MEMORY_ATTRIBUTES);
+        igraph_error_t err = igraph_i_attribute_table->add_edges(graph, edges, attr);
+        igraph_i_memory_category_exit(category);
+        return err;
     } else {
         return IGRAPH_SUCCESS;
     }
@@ -114,7 +139,10 @@ igraph_error_t igraph_i_attribute_permute_edges(const igraph_t *graph,
      * in-place operations. If they are _not_ the same, it is assumed that the
      * new graph has no edge attributes yet */
     if (igraph_i_attribute_table) {
-        return igraph_i_attribute_table->permute_edges(graph, newgraph, idx);
+        igraph_memory_category_t category = igraph_i_memory_category_enter(IGRAPH_MEMORY_ATTRIBUTES);
+        igraph_error_t err = igraph_i_attribute_table->permute_edges(graph, newgraph, idx);
+        igraph_i_memory_category_exit(category);
+        return err;
     } else {
         return IGRAPH_SUCCESS;
     }
@@ -129,9 +157,10 @@ igraph_error_t igraph_i_attribute_combine_edges(const igraph_t *graph,
      * can assert the former */
     IGRAPH_ASSERT(graph != newgraph);
     if (igraph_i_attribute_table) {
-        return igraph_i_attribute_table->combine_edges(graph, newgraph,
-                merges,
-                comb);
+        igraph_memory_category_t category = igraph_i_memory_category_enter(IGRAPH_MEMORY_ATTRIBUTES);
+        igraph_error_t err = igraph_i_attribute_table->combine_edges(graph, newgraph, merges, comb);
+        igraph_i_memory_category_exit(category);
+        return err;
     } else {
         return IGRAPH_SUCCESS;
     }
@@ -401,7 +430,7 @@ igraph_error_t igraph_attribute_combination_add(igraph_attribute_combination_t *
         if (! name) {
             rec->name = NULL;
         } else {
-            rec->name = strdup(name);
+            rec->name = igraph_i_strdup(name);
             if (! rec->name) {
                 IGRAPH_ERROR("Cannot create attribute combination data.",
                              IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
@@ -41,6 +41,7 @@ __BEGIN_DECLS
 
 igraph_error_t igraph_i_attribute_init(igraph_t *graph, void *attr);
 void igraph_i_attribute_destroy(igraph_t *graph);
+size_t igraph_i_attribute_memory_size(const igraph_t *graph);
 igraph_error_t igraph_i_attribute_copy(igraph_t *to, const igraph_t *from,
                             igraph_bool_t ga, igraph_bool_t va, igraph_bool_t ea);
 igraph_error_t igraph_i_attribute_add_vertices(igraph_t *graph, igraph_integer_t nv, void *attr);
@@ -26,7 +26,7 @@
 #include "igraph_interface.h"
 #include "igraph_random.h"
 
-#include "internal/hacks.h" /* strdup */
+#include "internal/hacks.h" /* igraph_i_strdup */
 
 #include <string.h>
 
@@ -119,7 +119,7 @@ static igraph_error_t igraph_i_cattributes_copy_attribute_record(igraph_attribut
     }
     IGRAPH_FINALLY(igraph_free, *newrec);
     (*newrec)->type = rec->type;
-    (*newrec)->name = strdup(rec->name);
+    (*newrec)->name = igraph_i_strdup(rec->name);
     if (!(*newrec)->name) {
         IGRAPH_ERROR("Cannot copy attributes", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
     }
@@ -227,6 +227,41 @@ static void igraph_i_cattribute_destroy(igraph_t *graph) {
     IGRAPH_FREE(graph->attr); /* sets to NULL */
 }
 
+static size_t igraph_i_cattribute_memory_size(const igraph_t *graph) {
+    const igraph_i_cattributes_t *attr = graph->attr;
+    const igraph_vector_ptr_t *als[3] = { &attr->gal, &attr->val, &attr->eal };
+    size_t size = sizeof(igraph_i_cattributes_t);
+
+    for (size_t a = 0; a < 3; a++) {
+        const igraph_vector_ptr_t *al = als[a];
+        igraph_integer_t n = igraph_vector_ptr_size(al);
+        size += (al->stor_end - al->stor_begin) * sizeof(void *);
+        for (igraph_integer_t i = 0; i < n; i++) {
+            const igraph_attribute_record_t *rec = VECTOR(*al)[i];
+            size += sizeof(igraph_attribute_record_t) + strlen(rec->name) + 1;
+            if (rec->type == IGRAPH_ATTRIBUTE_NUMERIC) {
+                const igraph_vector_t *num = rec->value;
+                size += sizeof(igraph_vector_t) + igraph_vector_capacity(num) * sizeof(igraph_real_t);
+            } else if (rec->type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+                const igraph_vector_bool_t *log = rec->value;
+                size += sizeof(igraph_vector_bool_t) + igraph_vector_bool_capacity(log) * sizeof(igraph_bool_t);
+            } else if (rec->type == IGRAPH_ATTRIBUTE_STRING) {
+                const igraph_strvector_t *str = rec->value;
+                igraph_integer_t len = igraph_strvector_size(str);
+                size += sizeof(igraph_strvector_t) + igraph_strvector_capacity(str) * sizeof(char *);
+                for (igraph_integer_t j = 0; j < len; j++) {
+                    /* Empty strings are not allocated. */
+                    if (str->stor_begin[j]) {
+                        size += strlen(str->stor_begin[j]) + 1;
+                    }
+                }
+            }
+        }
+    }
+
+    return size;
+}
+
 /* Almost the same as destroy, but we might have null pointers */
 
 static void igraph_i_cattribute_copy_free(igraph_i_cattributes_t *attr) {
@@ -345,7 +380,7 @@ static igraph_error_t igraph_i_cattribute_add_vertices_inner(igraph_t *graph, ig
             }
             IGRAPH_FINALLY(igraph_free, newrec);
             newrec->type = type;
-            newrec->name = strdup(tmp->name);
+            newrec->name = igraph_i_strdup(tmp->name);
             if (!newrec->name) {
                 IGRAPH_ERROR("Cannot add attributes", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
             }
@@ -786,7 +821,7 @@ static igraph_error_t igraph_i_cattribute_permute_vertices(
             IGRAPH_ERROR("Cannot create vertex attributes", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, new_rec);
-        new_rec->name = strdup(oldrec->name);
+        new_rec->name = igraph_i_strdup(oldrec->name);
         if (! new_rec->name) {
             IGRAPH_ERROR("Cannot create vertex attributes", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -1696,7 +1731,7 @@ static igraph_error_t igraph_i_cattribute_combine_vertices(const igraph_t *graph
             IGRAPH_ERROR("Cannot combine vertex attributes", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, newrec);
-        newrec->name = strdup(name);
+        newrec->name = igraph_i_strdup(name);
         if (!newrec->name) {
             IGRAPH_ERROR("Cannot combine vertex attributes", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -1887,7 +1922,7 @@ static igraph_error_t igraph_i_cattribute_add_edges_inner(igraph_t *graph, const
             }
             IGRAPH_FINALLY(igraph_free, newrec);
             newrec->type = type;
-            newrec->name = strdup(tmp->name);
+            newrec->name = igraph_i_strdup(tmp->name);
             if (!newrec->name) {
                 IGRAPH_ERROR("Cannot add attributes", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
             }
@@ -2193,7 +2228,7 @@ static igraph_error_t igraph_i_cattribute_permute_edges(const igraph_t *graph,
             IGRAPH_ERROR("Cannot create edge attributes", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, new_rec);
-        new_rec->name = strdup(oldrec->name);
+        new_rec->name = igraph_i_strdup(oldrec->name);
         if (! new_rec->name) {
             IGRAPH_ERROR("Cannot create edge attributes", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -2299,7 +2334,7 @@ static igraph_error_t igraph_i_cattribute_combine_edges(const igraph_t *graph,
             IGRAPH_ERROR("Cannot combine edge attributes", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, newrec);
-        newrec->name = strdup(name);
+        newrec->name = igraph_i_strdup(name);
         if (! newrec->name) {
             IGRAPH_ERROR("Cannot combine edge attributes", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -2892,7 +2927,8 @@ const igraph_attribute_table_t igraph_cattribute_table = {
     &igraph_i_cattribute_get_bool_vertex_attr,
     &igraph_i_cattribute_get_numeric_edge_attr,
     &igraph_i_cattribute_get_string_edge_attr,
-    &igraph_i_cattribute_get_bool_edge_attr
+    &igraph_i_cattribute_get_bool_edge_attr,
+    &igraph_i_cattribute_memory_size
 };
 
 /* -------------------------------------- */
@@ -3475,7 +3511,7 @@ igraph_error_t igraph_cattribute_GAN_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -3533,7 +3569,7 @@ igraph_error_t igraph_cattribute_GAB_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -3592,7 +3628,7 @@ igraph_error_t igraph_cattribute_GAS_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add graph attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -3654,7 +3690,7 @@ igraph_error_t igraph_cattribute_VAN_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -3717,7 +3753,7 @@ igraph_error_t igraph_cattribute_VAB_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -3781,7 +3817,7 @@ igraph_error_t igraph_cattribute_VAS_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -3843,7 +3879,7 @@ igraph_error_t igraph_cattribute_EAN_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -3906,7 +3942,7 @@ igraph_error_t igraph_cattribute_EAB_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -3970,7 +4006,7 @@ igraph_error_t igraph_cattribute_EAS_set(igraph_t *graph, const char *name,
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
         IGRAPH_FINALLY(igraph_free, rec);
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -4037,7 +4073,7 @@ igraph_error_t igraph_cattribute_VAN_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_NUMERIC;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -4102,7 +4138,7 @@ igraph_error_t igraph_cattribute_VAB_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_BOOLEAN;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -4169,7 +4205,7 @@ igraph_error_t igraph_cattribute_VAS_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_STRING;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -4235,7 +4271,7 @@ igraph_error_t igraph_cattribute_EAN_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_NUMERIC;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -4301,7 +4337,7 @@ igraph_error_t igraph_cattribute_EAB_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_BOOLEAN;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add edge attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
@@ -4368,7 +4404,7 @@ igraph_error_t igraph_cattribute_EAS_setv(igraph_t *graph, const char *name,
         }
         IGRAPH_FINALLY(igraph_free, rec);
         rec->type = IGRAPH_ATTRIBUTE_STRING;
-        rec->name = strdup(name);
+        rec->name = igraph_i_strdup(name);
         if (!rec->name) {
             IGRAPH_ERROR("Cannot add vertex attribute", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
         }
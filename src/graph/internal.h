@@ -37,6 +37,21 @@ IGRAPH_PRIVATE_EXPORT igraph_error_t igraph_i_incident(
 
 igraph_error_t igraph_i_reverse(igraph_t *graph);
 
+igraph_error_t igraph_i_set_edges_from_columns(
+   igraph_t *graph, igraph_vector_int_t *from, igraph_vector_int_t *to);
+
+igraph_bool_t igraph_i_indexed_edges_valid(
+   igraph_integer_t no_of_nodes, igraph_integer_t no_of_edges, igraph_bool_t directed,
+   const igraph_integer_t *from, const igraph_integer_t *to,
+   const igraph_integer_t *oi, const igraph_integer_t *ii,
+   const igraph_integer_t *os, const igraph_integer_t *is);
+
+void igraph_i_set_indexed_edges(
+   igraph_t *graph,
+   igraph_vector_int_t *from, igraph_vector_int_t *to,
+   igraph_vector_int_t *oi, igraph_vector_int_t *ii,
+   igraph_vector_int_t *os, igraph_vector_int_t *is);
+
 __END_DECLS
 
 #endif /* IGRAPH_GRAPH_INTERNAL_H */
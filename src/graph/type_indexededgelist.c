@@ -24,17 +24,51 @@
 #include "igraph_datatype.h"
 #include "igraph_interface.h"
 #include "igraph_memory.h"
+#include "igraph_qsort.h"
 
+#include "core/memory.h"
 #include "graph/attributes.h"
 #include "graph/caching.h"
 #include "graph/internal.h"
 #include "math/safe_intop.h"
 
+#include <string.h> /* memmove */
+
 /* Internal functions */
 
 static igraph_error_t igraph_i_create_start_vectors(
         igraph_vector_int_t *res, igraph_vector_int_t *el,
         igraph_vector_int_t *index, igraph_integer_t nodes);
+static void igraph_i_merge_into_index(
+        igraph_vector_int_t *index, igraph_vector_int_t *start,
+        const igraph_vector_int_t *el, const igraph_vector_int_t *el2,
+        igraph_vector_int_t *batch, igraph_integer_t nodes);
+
+/* Assigns the storage of the edge list and the indices of a graph to the
+ * graph category of the memory usage statistics. */
+static void igraph_i_graph_tag_memory(igraph_t *graph) {
+    igraph_i_memory_tag(graph->from.stor_begin, IGRAPH_MEMORY_GRAPH);
+    igraph_i_memory_tag(graph->to.stor_begin, IGRAPH_MEMORY_GRAPH);
+    igraph_i_memory_tag(graph->oi.stor_begin, IGRAPH_MEMORY_GRAPH);
+    igraph_i_memory_tag(graph->ii.stor_begin, IGRAPH_MEMORY_GRAPH);
+    igraph_i_memory_tag(graph->os.stor_begin, IGRAPH_MEMORY_GRAPH);
+    igraph_i_memory_tag(graph->is.stor_begin, IGRAPH_MEMORY_GRAPH);
+}
+
+/* igraph_add_edges() merges the new edges into the existing indices instead
+ * of rebuilding them when the number of new edges is at most the existing
+ * edge count divided by this factor. Larger batches are cheaper to handle
+ * with the linear-time radix sort in igraph_vector_int_pair_order(). */
+#define IGRAPH_I_INCREMENTAL_ADD_EDGES_FACTOR 8
+
+/* Graph views share their data with the caller, see igraph_create_view(). */
+#define IGRAPH_I_CHECK_NOT_VIEW(graph) \
+    do { \
+        if ((graph)->view) { \
+            IGRAPH_ERROR("Cannot modify a read-only graph view. " \
+                         "Use igraph_copy() to create a modifiable copy.", IGRAPH_EINVAL); \
+        } \
+    } while (0)
 
 /**
  * \section about_basic_interface
@@ -103,16 +137,19 @@ igraph_error_t igraph_empty_attrs(igraph_t *graph, igraph_integer_t n, igraph_bo
 
     graph->n = 0;
     graph->directed = directed;
+    graph->view = false;
     IGRAPH_VECTOR_INT_INIT_FINALLY(&graph->from, 0);
     IGRAPH_VECTOR_INT_INIT_FINALLY(&graph->to, 0);
     IGRAPH_VECTOR_INT_INIT_FINALLY(&graph->oi, 0);
     IGRAPH_VECTOR_INT_INIT_FINALLY(&graph->ii, 0);
     IGRAPH_VECTOR_INT_INIT_FINALLY(&graph->os, 1);
     IGRAPH_VECTOR_INT_INIT_FINALLY(&graph->is, 1);
+    igraph_i_graph_tag_memory(graph);
 
     /* init cache */
     graph->cache = IGRAPH_CALLOC(1, igraph_i_property_cache_t);
     IGRAPH_CHECK_OOM(graph->cache, "Cannot create graph.");
+    igraph_i_memory_tag(graph->cache, IGRAPH_MEMORY_GRAPH);
     IGRAPH_FINALLY(igraph_free, graph->cache);
     IGRAPH_CHECK(igraph_i_property_cache_init(graph->cache));
     IGRAPH_FINALLY(igraph_i_property_cache_destroy, graph->cache);
@@ -154,6 +191,11 @@ void igraph_destroy(igraph_t *graph) {
     igraph_i_property_cache_destroy(graph->cache);
     IGRAPH_FREE(graph->cache);
 
+    /* The vectors of a view point into memory owned by the caller. */
+    if (graph->view) {
+        return;
+    }
+
     igraph_vector_int_destroy(&graph->from);
     igraph_vector_int_destroy(&graph->to);
     igraph_vector_int_destroy(&graph->oi);
@@ -191,6 +233,7 @@ void igraph_destroy(igraph_t *graph) {
 igraph_error_t igraph_copy(igraph_t *to, const igraph_t *from) {
     to->n = from->n;
     to->directed = from->directed;
+    to->view = false;
     IGRAPH_CHECK(igraph_vector_int_init_copy(&to->from, &from->from));
     IGRAPH_FINALLY(igraph_vector_int_destroy, &to->from);
     IGRAPH_CHECK(igraph_vector_int_init_copy(&to->to, &from->to));
@@ -203,9 +246,11 @@ igraph_error_t igraph_copy(igraph_t *to, const igraph_t *from) {
     IGRAPH_FINALLY(igraph_vector_int_destroy, &to->os);
     IGRAPH_CHECK(igraph_vector_int_init_copy(&to->is, &from->is));
     IGRAPH_FINALLY(igraph_vector_int_destroy, &to->is);
+    igraph_i_graph_tag_memory(to);
 
     to->cache = IGRAPH_CALLOC(1, igraph_i_property_cache_t);
     IGRAPH_CHECK_OOM(to->cache, "Cannot copy graph.");
+    igraph_i_memory_tag(to->cache, IGRAPH_MEMORY_GRAPH);
     IGRAPH_FINALLY(igraph_free, to->cache);
     IGRAPH_CHECK(igraph_i_property_cache_copy(to->cache, from->cache));
     IGRAPH_FINALLY(igraph_i_property_cache_destroy, to->cache);
@@ -216,6 +261,102 @@ igraph_error_t igraph_copy(igraph_t *to, const igraph_t *from) {
     return IGRAPH_SUCCESS;
 }
 
+/**
+ * \ingroup interface
+ * \function igraph_create_view
+ * \brief Creates a read-only graph that uses existing arrays as its storage.
+ *
+ * \experimental
+ *
+ * </para><para>
+ * Creates a graph whose edge list and edge indices are the given arrays.
+ * The arrays are not copied, so the graph takes almost no memory of its
+ * own. This makes it possible to share a single large graph between many
+ * processes, e.g. by memory-mapping a file written by
+ * \ref igraph_write_graph_binary(), see \ref igraph_read_graph_binary_view().
+ *
+ * </para><para>
+ * The arrays must hold exactly the data that igraph itself would store for
+ * the graph, see the documentation of \type igraph_t for their meaning.
+ * They must stay valid and must not be changed while the view, or any
+ * iterator or other object referring to it, is in use. The view is
+ * destroyed with \ref igraph_destroy() as usual, which does not free the
+ * arrays.
+ *
+ * </para><para>
+ * The structure of a view cannot be modified: \ref igraph_add_vertices(),
+ * \ref igraph_add_edges(), \ref igraph_delete_vertices(),
+ * \ref igraph_delete_edges() and other functions that change the graph in
+ * place fail with an \c IGRAPH_EINVAL error when called on a view. Use
+ * \ref igraph_copy() to create a modifiable copy. Functions that replace
+ * the graph with a newly created one, such as \ref igraph_simplify(),
+ * release the view and leave an ordinary graph in its place; the arrays
+ * are never written to. Attributes can be added to a view as usual, they
+ * are stored separately from the arrays.
+ *
+ * \param graph Pointer to an uninitialized graph object.
+ * \param n The number of vertices.
+ * \param m The number of edges.
+ * \param directed Whether the graph is directed.
+ * \param from The first column of the edge list, \p m elements.
+ * \param to The second column of the edge list, \p m elements.
+ * \param oi The edge IDs ordered by \p from, \p m elements.
+ * \param ii The edge IDs ordered by \p to, \p m elements.
+ * \param os The start of the edges of each vertex in \p oi, \p n + 1
+ *        elements.
+ * \param is The start of the edges of each vertex in \p ii, \p n + 1
+ *        elements.
+ * \param validate Whether to check that the arrays are consistent. This
+ *        takes linear time and reads all the arrays, but it does not
+ *        allocate memory. Passing inconsistent data when this is \c false
+ *        leads to undefined behaviour.
+ * \return Error code:
+ *         \c IGRAPH_EINVAL if the number of vertices or edges is invalid,
+ *         or validation was requested and the arrays are not consistent.
+ *
+ * Time complexity: O(|V|+|E|) if \p validate is true, O(1) otherwise.
+ */
+igraph_error_t igraph_create_view(
+        igraph_t *graph, igraph_integer_t n, igraph_integer_t m, igraph_bool_t directed,
+        const igraph_integer_t *from, const igraph_integer_t *to,
+        const igraph_integer_t *oi, const igraph_integer_t *ii,
+        const igraph_integer_t *os, const igraph_integer_t *is,
+        igraph_bool_t validate) {
+
+    if (n < 0 || n > IGRAPH_VCOUNT_MAX) {
+        IGRAPH_ERROR("Invalid number of vertices for graph view.", IGRAPH_EINVAL);
+    }
+    if (m < 0 || m > IGRAPH_ECOUNT_MAX) {
+        IGRAPH_ERROR("Invalid number of edges for graph view.", IGRAPH_EINVAL);
+    }
+    if (validate && !igraph_i_indexed_edges_valid(n, m, directed, from, to, oi, ii, os, is)) {
+        IGRAPH_ERROR("Inconsistent data for graph view.", IGRAPH_EINVAL);
+    }
+
+    graph->n = n;
+    graph->directed = directed;
+    graph->view = true;
+    igraph_vector_int_view(&graph->from, from, m);
+    igraph_vector_int_view(&graph->to, to, m);
+    igraph_vector_int_view(&graph->oi, oi, m);
+    igraph_vector_int_view(&graph->ii, ii, m);
+    igraph_vector_int_view(&graph->os, os, n + 1);
+    igraph_vector_int_view(&graph->is, is, n + 1);
+
+    graph->cache = IGRAPH_CALLOC(1, igraph_i_property_cache_t);
+    IGRAPH_CHECK_OOM(graph->cache, "Cannot create graph view.");
+    igraph_i_memory_tag(graph->cache, IGRAPH_MEMORY_GRAPH);
+    IGRAPH_FINALLY(igraph_free, graph->cache);
+    IGRAPH_CHECK(igraph_i_property_cache_init(graph->cache));
+    IGRAPH_FINALLY(igraph_i_property_cache_destroy, graph->cache);
+
+    graph->attr = NULL;
+    IGRAPH_CHECK(igraph_i_attribute_init(graph, NULL));
+
+    IGRAPH_FINALLY_CLEAN(2);
+    return IGRAPH_SUCCESS;
+}
+
 /**
  * \ingroup interface
  * \function igraph_add_edges
@@ -241,7 +382,13 @@ igraph_error_t igraph_copy(igraph_t *to, const igraph_t *from) {
  *
  * </para><para>
  * Time complexity: O(|V|+|E|) where |V| is the number of vertices and
- * |E| is the number of edges in the \em new, extended graph.
+ * |E| is the number of edges in the \em new, extended graph. When only
+ * a few edges are added to a large graph, they are merged into the
+ * existing edge indices instead of re-sorting all edges. This is much
+ * faster in practice, but still linear in the size of the graph: the
+ * entries of the indices after the first affected vertex are moved to make
+ * room for the new edges, the start positions of the vertices after it are
+ * shifted, and the storage of the graph may be reallocated.
  *
  * \example examples/simple/creation.c
  */
@@ -254,6 +401,8 @@ igraph_error_t igraph_add_edges(igraph_t *graph, const igraph_vector_int_t *edge
     igraph_vector_int_t newoi, newii;
     igraph_bool_t directed = igraph_is_directed(graph);
 
+    IGRAPH_I_CHECK_NOT_VIEW(graph);
+
     if (igraph_vector_int_size(edges) % 2 != 0) {
         IGRAPH_ERROR("Invalid (odd) length of edges vector.", IGRAPH_EINVEVECTOR);
     }
@@ -300,7 +449,31 @@ igraph_error_t igraph_add_edges(igraph_t *graph, const igraph_vector_int_t *edge
 
     /* oi & ii */
     IGRAPH_FINALLY_ENTER();
-    {
+    if (no_of_edges > 0 && edges_to_add > 0 &&
+        edges_to_add <= no_of_edges / IGRAPH_I_INCREMENTAL_ADD_EDGES_FACTOR) {
+        /* Small batch: sort only the new edges and merge them into the
+         * existing indices in place. Space for the indices is reserved, and
+         * the attributes are added, before any index is touched, so that
+         * the merge itself cannot fail. */
+        igraph_vector_int_t batch;
+
+        CHECK_ERR(igraph_vector_int_init_range(&batch, no_of_edges, new_no_of_edges));
+        IGRAPH_FINALLY(igraph_vector_int_destroy, &batch);
+        CHECK_ERR(igraph_vector_int_reserve(&graph->oi, new_no_of_edges));
+        CHECK_ERR(igraph_vector_int_reserve(&graph->ii, new_no_of_edges));
+
+        /* Attributes */
+        if (graph->attr) {
+            CHECK_ERR(igraph_i_attribute_add_edges(graph, edges, attr));
+        }
+
+        igraph_i_merge_into_index(&graph->oi, &graph->os, &graph->from, &graph->to, &batch, graph->n);
+        igraph_i_merge_into_index(&graph->ii, &graph->is, &graph->to, &graph->from, &batch, graph->n);
+        igraph_i_graph_tag_memory(graph);
+
+        igraph_vector_int_destroy(&batch);
+        IGRAPH_FINALLY_CLEAN(1);
+    } else {
         CHECK_ERR(igraph_vector_int_init(&newoi, no_of_edges));
         IGRAPH_FINALLY(igraph_vector_int_destroy, &newoi);
         CHECK_ERR(igraph_vector_int_init(&newii, no_of_edges));
@@ -325,6 +498,7 @@ igraph_error_t igraph_add_edges(igraph_t *graph, const igraph_vector_int_t *edge
 
         graph->oi = newoi;
         graph->ii = newii;
+        igraph_i_graph_tag_memory(graph);
     }
     IGRAPH_FINALLY_EXIT();
 
@@ -358,6 +532,168 @@ igraph_error_t igraph_add_edges(igraph_t *graph, const igraph_vector_int_t *edge
     return IGRAPH_SUCCESS;
 }
 
+/* Stable counting sort of the edge IDs in 'in' by their 'key', writing the
+ * result into 'out'. If 'in' is NULL, all edge IDs are sorted, taken in
+ * decreasing order. On return, start[v] is the position in 'out' of the first
+ * edge with key v, and start[nodes] is the number of edges; i.e. 'start' is
+ * the start vector that belongs to the index in 'out'. */
+static void igraph_i_counting_sort_edges(
+        const igraph_vector_int_t *key, const igraph_vector_int_t *in,
+        igraph_vector_int_t *out, igraph_vector_int_t *start,
+        igraph_integer_t nodes) {
+
+    igraph_integer_t no_of_edges = igraph_vector_int_size(key);
+    igraph_integer_t i, v, sum;
+
+    igraph_vector_int_null(start);
+    for (i = 0; i < no_of_edges; i++) {
+        VECTOR(*start)[ VECTOR(*key)[i] ]++;
+    }
+    for (v = 0, sum = 0; v <= nodes; v++) {
+        sum += VECTOR(*start)[v];
+        VECTOR(*start)[v] = sum;
+    }
+
+    /* Filling each bucket from its end while traversing the input backwards
+     * keeps the sort stable, and leaves start[v] at the bucket's beginning. */
+    for (i = no_of_edges - 1; i >= 0; i--) {
+        igraph_integer_t e = in ? VECTOR(*in)[i] : no_of_edges - 1 - i;
+        VECTOR(*out)[ --VECTOR(*start)[ VECTOR(*key)[e] ] ] = e;
+    }
+}
+
+/* Sets the edges of a graph that has no edges yet from the two columns of
+ * its edge list. The contents of 'from' and 'to' are swapped into the graph,
+ * and the caller is left with the original, empty columns of the graph, which
+ * it still needs to destroy. Vertex IDs must be valid, and for undirected
+ * graphs the larger endpoint of each edge must be in 'from'.
+ *
+ * The indices are built with three passes of counting sort in O(|V|+|E|)
+ * time, without temporary storage proportional to the number of edges. The
+ * result is identical to what igraph_add_edges() produces. Attributes are
+ * not touched; the caller needs to call igraph_i_attribute_add_edges() if the
+ * graph has attributes. */
+igraph_error_t igraph_i_set_edges_from_columns(
+        igraph_t *graph, igraph_vector_int_t *from, igraph_vector_int_t *to) {
+
+    igraph_integer_t no_of_edges = igraph_vector_int_size(from);
+    igraph_vector_int_t tmp;
+
+    IGRAPH_ASSERT(igraph_ecount(graph) == 0);
+    IGRAPH_ASSERT(igraph_vector_int_size(to) == no_of_edges);
+
+    if (no_of_edges > IGRAPH_ECOUNT_MAX) {
+        IGRAPH_ERRORF("Maximum edge count (%" IGRAPH_PRId ") exceeded.", IGRAPH_ERANGE,
+                      IGRAPH_ECOUNT_MAX);
+    }
+
+    /* This is the only step that may fail, and it leaves the graph valid. */
+    IGRAPH_CHECK(igraph_vector_int_resize(&graph->oi, no_of_edges));
+    IGRAPH_CHECK(igraph_vector_int_resize(&graph->ii, no_of_edges));
+
+    tmp = graph->from; graph->from = *from; *from = tmp;
+    tmp = graph->to; graph->to = *to; *to = tmp;
+    igraph_i_graph_tag_memory(graph);
+
+    /* 'ii' holds the edges ordered by 'to' (with decreasing edge IDs) while
+     * 'oi' is computed; sorting 'oi' by 'to' then gives the final 'ii'. */
+    igraph_i_counting_sort_edges(&graph->to, NULL, &graph->ii, &graph->is, graph->n);
+    igraph_i_counting_sort_edges(&graph->from, &graph->ii, &graph->oi, &graph->os, graph->n);
+    igraph_i_counting_sort_edges(&graph->to, &graph->oi, &graph->ii, &graph->is, graph->n);
+
+    igraph_i_property_cache_invalidate_conditionally(graph, 0, 0, 0);
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Checks whether the given edge list columns, indices and start vectors form
+ * a valid indexed edge list for a graph with 'no_of_nodes' vertices and
+ * 'no_of_edges' edges, i.e. whether they are exactly what igraph would have
+ * built from 'from' and 'to'. The indices must be ordered by the respective
+ * column first, then by the other column, and parallel edges by decreasing
+ * edge ID. Since this ordering is strict, it also guarantees that the indices
+ * are permutations. 'os' and 'is' have no_of_nodes + 1 elements.
+ * Time complexity: O(|V|+|E|), no memory is allocated. */
+igraph_bool_t igraph_i_indexed_edges_valid(
+        igraph_integer_t no_of_nodes, igraph_integer_t no_of_edges, igraph_bool_t directed,
+        const igraph_integer_t *from, const igraph_integer_t *to,
+        const igraph_integer_t *oi, const igraph_integer_t *ii,
+        const igraph_integer_t *os, const igraph_integer_t *is) {
+
+    const igraph_integer_t *els[2] = { from, to }, *indices[2] = { oi, ii }, *starts[2] = { os, is };
+
+    if (no_of_nodes < 0 || no_of_nodes > IGRAPH_VCOUNT_MAX ||
+        no_of_edges < 0 || no_of_edges > IGRAPH_ECOUNT_MAX) {
+        return false;
+    }
+
+    for (igraph_integer_t e = 0; e < no_of_edges; e++) {
+        if (from[e] < 0 || from[e] >= no_of_nodes || to[e] < 0 || to[e] >= no_of_nodes) {
+            return false;
+        }
+        if (!directed && from[e] < to[e]) {
+            return false;
+        }
+    }
+
+    for (int c = 0; c < 2; c++) {
+        const igraph_integer_t *el = els[c], *el2 = els[1 - c];
+        const igraph_integer_t *index = indices[c], *start = starts[c];
+
+        if (start[0] != 0 || start[no_of_nodes] != no_of_edges) {
+            return false;
+        }
+        for (igraph_integer_t v = 0; v < no_of_nodes; v++) {
+            if (start[v + 1] < start[v]) {
+                return false;
+            }
+            for (igraph_integer_t k = start[v]; k < start[v + 1]; k++) {
+                igraph_integer_t e = index[k];
+                if (e < 0 || e >= no_of_edges || el[e] != v) {
+                    return false;
+                }
+                if (k > start[v]) {
+                    igraph_integer_t prev = index[k - 1];
+                    if (el2[prev] > el2[e] || (el2[prev] == el2[e] && prev <= e)) {
+                        return false;
+                    }
+                }
+            }
+        }
+    }
+
+    return true;
+}
+
+/* Sets the edges of a graph that has no edges yet from a complete indexed
+ * edge list, swapping the given vectors into the graph; see
+ * igraph_i_set_edges_from_columns() for the ownership rules. 'os' and 'is'
+ * must have one more element than the number of vertices. The caller must
+ * ensure that the data is valid, e.g. with igraph_i_indexed_edges_valid(). */
+void igraph_i_set_indexed_edges(
+        igraph_t *graph,
+        igraph_vector_int_t *from, igraph_vector_int_t *to,
+        igraph_vector_int_t *oi, igraph_vector_int_t *ii,
+        igraph_vector_int_t *os, igraph_vector_int_t *is) {
+
+    igraph_vector_int_t tmp;
+
+    IGRAPH_ASSERT(igraph_ecount(graph) == 0);
+    IGRAPH_ASSERT(igraph_vector_int_size(os) == graph->n + 1);
+    IGRAPH_ASSERT(igraph_vector_int_size(is) == graph->n + 1);
+
+#define SWAP(field, v) do { tmp = graph->field; graph->field = *(v); *(v) = tmp; } while (0)
+    SWAP(from, from);
+    SWAP(to, to);
+    SWAP(oi, oi);
+    SWAP(ii, ii);
+    SWAP(os, os);
+    SWAP(is, is);
+#undef SWAP
+
+    igraph_i_property_cache_invalidate_conditionally(graph, 0, 0, 0);
+}
+
 /**
  * \ingroup interface
  * \function igraph_add_vertices
@@ -384,6 +720,8 @@ igraph_error_t igraph_add_vertices(igraph_t *graph, igraph_integer_t nv, void *a
     igraph_integer_t new_vc;
     igraph_integer_t i;
 
+    IGRAPH_I_CHECK_NOT_VIEW(graph);
+
     if (nv < 0) {
         IGRAPH_ERROR("Cannot add negative number of vertices.", IGRAPH_EINVAL);
     }
@@ -500,6 +838,8 @@ igraph_error_t igraph_delete_edges(igraph_t *graph, igraph_es_t edges) {
     igraph_bool_t *mark;
     igraph_integer_t i, j;
 
+    IGRAPH_I_CHECK_NOT_VIEW(graph);
+
     mark = IGRAPH_CALLOC(no_of_edges, igraph_bool_t);
     IGRAPH_CHECK_OOM(mark, "Cannot delete edges.");
     IGRAPH_FINALLY(igraph_free, mark);
@@ -563,6 +903,7 @@ igraph_error_t igraph_delete_edges(igraph_t *graph, igraph_es_t edges) {
     graph->to = newto;
     graph->oi = newoi;
     graph->ii = newii;
+    igraph_i_graph_tag_memory(graph);
     IGRAPH_FINALLY_CLEAN(4);
 
     IGRAPH_FREE(mark);
@@ -649,6 +990,8 @@ igraph_error_t igraph_delete_vertices_idx(
     igraph_integer_t i, j;
     igraph_integer_t remaining_vertices, remaining_edges;
 
+    IGRAPH_I_CHECK_NOT_VIEW(graph);
+
     if (idx) {
         my_vertex_recoding = idx;
         IGRAPH_CHECK(igraph_vector_int_resize(idx, no_of_nodes));
@@ -693,6 +1036,7 @@ igraph_error_t igraph_delete_vertices_idx(
     /* start creating the graph */
     newgraph.n = remaining_vertices;
     newgraph.directed = graph->directed;
+    newgraph.view = false;
 
     /* allocate vectors */
     IGRAPH_VECTOR_INT_INIT_FINALLY(&newgraph.from, remaining_edges);
@@ -726,6 +1070,8 @@ igraph_error_t igraph_delete_vertices_idx(
 
     newgraph.cache = IGRAPH_CALLOC(1, igraph_i_property_cache_t);
     IGRAPH_CHECK_OOM(newgraph.cache, "Cannot delete vertices.");
+    igraph_i_memory_tag(newgraph.cache, IGRAPH_MEMORY_GRAPH);
+    igraph_i_graph_tag_memory(&newgraph);
     IGRAPH_FINALLY(igraph_free, newgraph.cache);
     IGRAPH_CHECK(igraph_i_property_cache_init(newgraph.cache));
     IGRAPH_FINALLY(igraph_i_property_cache_destroy, newgraph.cache);
@@ -839,6 +1185,51 @@ igraph_integer_t igraph_ecount(const igraph_t *graph) {
     return igraph_vector_int_size(&graph->from);
 }
 
+/**
+ * \ingroup interface
+ * \function igraph_graph_memory_size
+ * \brief The amount of memory used by a graph.
+ *
+ * \experimental
+ *
+ * Computes the number of bytes of memory owned by a graph: its edge list
+ * and indices, including unused capacity reserved for future edges, its
+ * property cache, and its attributes. The \type igraph_t structure itself
+ * is not included. The arrays of a graph view created by
+ * \ref igraph_create_view() are owned by the caller, and are not included
+ * either. The memory used by attributes is only included if the attribute
+ * handler reports it, as the C attribute handler does.
+ *
+ * </para><para>
+ * Unlike \ref igraph_memory_stats(), this function does not require memory
+ * tracking to be turned on.
+ *
+ * \param graph The graph.
+ * \return The memory used by the graph, in bytes.
+ *
+ * Time complexity: O(1) without attributes. The C attribute handler needs
+ * O(|V|+|E|) time if there are string attributes, and O(1) otherwise.
+ */
+size_t igraph_graph_memory_size(const igraph_t *graph) {
+    size_t size = sizeof(igraph_i_property_cache_t);
+
+    if (!graph->view) {
+        size += sizeof(igraph_integer_t) * (
+                    igraph_vector_int_capacity(&graph->from) +
+                    igraph_vector_int_capacity(&graph->to) +
+                    igraph_vector_int_capacity(&graph->oi) +
+                    igraph_vector_int_capacity(&graph->ii) +
+                    igraph_vector_int_capacity(&graph->os) +
+                    igraph_vector_int_capacity(&graph->is));
+    }
+
+    if (graph->attr) {
+        size += igraph_i_attribute_memory_size(graph);
+    }
+
+    return size;
+}
+
 /**
  * \ingroup interface
  * \function igraph_neighbors
@@ -1101,6 +1492,103 @@ static igraph_error_t igraph_i_create_start_vectors(
     return IGRAPH_SUCCESS;
 }
 
+typedef struct {
+    const igraph_vector_int_t *el;
+    const igraph_vector_int_t *el2;
+} igraph_i_index_cmp_data_t;
+
+/* Orders edge IDs the same way as igraph_vector_int_pair_order() does:
+ * by el, then by el2, and parallel edges by decreasing edge ID. */
+static int igraph_i_index_cmp(void *data, const void *a, const void *b) {
+    const igraph_i_index_cmp_data_t *d = (const igraph_i_index_cmp_data_t *) data;
+    igraph_integer_t e1 = *(const igraph_integer_t *) a;
+    igraph_integer_t e2 = *(const igraph_integer_t *) b;
+    igraph_integer_t x1 = VECTOR(*d->el)[e1], x2 = VECTOR(*d->el)[e2];
+
+    if (x1 != x2) {
+        return x1 < x2 ? -1 : 1;
+    }
+    x1 = VECTOR(*d->el2)[e1]; x2 = VECTOR(*d->el2)[e2];
+    if (x1 != x2) {
+        return x1 < x2 ? -1 : 1;
+    }
+    return e1 < e2 ? 1 : (e1 > e2 ? -1 : 0);
+}
+
+/* Merges the edges in 'batch' into an index vector 'index' and the
+ * corresponding start vector 'start', both of which must be up to date for
+ * all edges not in 'batch'. 'batch' must contain the largest edge IDs of the
+ * graph, and will be reordered. 'index' must have enough capacity reserved
+ * for the new edges; this function cannot fail.
+ *
+ * The result is identical to what igraph_vector_int_pair_order() and
+ * igraph_i_create_start_vectors() would produce. The batch is sorted in
+ * O(b log b) time for a batch of size b. The index is then merged from the
+ * back: the part that follows the last affected vertex is moved as a single
+ * block, and insertion positions within the block of an affected vertex
+ * are found by binary search, as these blocks are already sorted by 'el2'.
+ * The start vector is updated only for vertices after the first affected one.
+ */
+static void igraph_i_merge_into_index(
+        igraph_vector_int_t *index, igraph_vector_int_t *start,
+        const igraph_vector_int_t *el, const igraph_vector_int_t *el2,
+        igraph_vector_int_t *batch, igraph_integer_t nodes) {
+
+    igraph_i_index_cmp_data_t data = { el, el2 };
+    igraph_integer_t batch_size = igraph_vector_int_size(batch);
+    igraph_integer_t old_size = igraph_vector_int_size(index);
+    igraph_integer_t *idx, *os = VECTOR(*start);
+    igraph_integer_t i, j, k, v, shift;
+
+    igraph_qsort_r(VECTOR(*batch), batch_size, sizeof(VECTOR(*batch)[0]),
+                   &data, igraph_i_index_cmp);
+
+    igraph_vector_int_resize(index, old_size + batch_size); /* reserved */
+    idx = VECTOR(*index);
+
+    /* idx[0..i) is the not yet merged part of the old index,
+     * idx[k..) is the final merged tail. */
+    i = old_size;
+    k = old_size + batch_size;
+    for (j = batch_size - 1; j >= 0; j--) {
+        igraph_integer_t e = VECTOR(*batch)[j];
+        igraph_integer_t u = VECTOR(*el)[e];
+        igraph_integer_t w = VECTOR(*el2)[e];
+        igraph_integer_t lo, hi, n;
+
+        /* Old entries of 'u' that sort after 'e' are those with el2 >= w,
+         * since 'e' has a larger ID than any old edge. Together with all old
+         * entries of later vertices, they form the block idx[lo..i). */
+        lo = os[u];
+        hi = os[u + 1] < i ? os[u + 1] : i;
+        while (lo < hi) {
+            igraph_integer_t mid = lo + (hi - lo) / 2;
+            if (VECTOR(*el2)[idx[mid]] < w) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+        if (lo < i) {
+            n = i - lo;
+            memmove(idx + k - n, idx + lo, sizeof(idx[0]) * (size_t) n);
+            k -= n;
+            i = lo;
+        }
+        idx[--k] = e;
+    }
+
+    /* Each start position is shifted by the number of new edges
+     * belonging to earlier vertices. */
+    j = 0; shift = 0;
+    for (v = VECTOR(*el)[VECTOR(*batch)[0]] + 1; v <= nodes; v++) {
+        while (j < batch_size && VECTOR(*el)[VECTOR(*batch)[j]] < v) {
+            shift++; j++;
+        }
+        os[v] += shift;
+    }
+}
+
 /**
  * \ingroup interface
  * \function igraph_is_directed
@@ -1906,6 +2394,8 @@ igraph_error_t igraph_is_same_graph(const igraph_t *graph1, const igraph_t *grap
  */
 igraph_error_t igraph_i_reverse(igraph_t *graph) {
 
+    IGRAPH_I_CHECK_NOT_VIEW(graph);
+
     /* Nothing to do for undirected graphs. */
     if (! igraph_is_directed(graph)) {
         return IGRAPH_SUCCESS;
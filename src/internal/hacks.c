@@ -23,18 +23,19 @@
 
 #include "internal/hacks.h"
 
+#include "igraph_memory.h"
+
 #include <string.h>
-#include <stdlib.h>
 
-/* These are implementations of common C functions that may be missing from some compilers. */
+/* These are implementations of common C functions, which may be missing from some
+ * compilers, or which need to use igraph's allocator. */
 
 /**
- * Drop-in replacement for strdup.
- * Used only in compilers that do not have strdup or _strdup
+ * Replacement for strdup that uses igraph's allocator.
  */
 char *igraph_i_strdup(const char *s) {
     size_t n = strlen(s) + 1;
-    char *result = malloc(sizeof(char) * n);
+    char *result = IGRAPH_MALLOC(sizeof(char) * n);
     if (result) {
         memcpy(result, s, n);
     }
@@ -42,8 +43,7 @@ char *igraph_i_strdup(const char *s) {
 }
 
 /**
- * Drop-in replacement for strndup.
- * Used only in compilers that do not have strndup or _strndup
+ * Replacement for strndup that uses igraph's allocator.
  */
 char *igraph_i_strndup(const char *s1, size_t n) {
     size_t i;
@@ -53,7 +53,7 @@ char *igraph_i_strndup(const char *s1, size_t n) {
      */
     for (i = 0; s1[i] != '\0' && i < n; i++) {}
     n = i;
-    char *result = malloc(sizeof(char) * (n + 1));
+    char *result = IGRAPH_MALLOC(sizeof(char) * (n + 1));
     if (result) {
         memcpy(result, s1, n);
         result[n] = '\0';
@@ -37,15 +37,11 @@
 
 __BEGIN_DECLS
 
-#ifndef HAVE_STRDUP
-    #define strdup igraph_i_strdup
-    char* igraph_i_strdup(const char *s);
-#endif
-
-#ifndef HAVE_STRNDUP
-    #define strndup igraph_i_strndup
-    char* igraph_i_strndup(const char *s, size_t n);
-#endif
+/* Versions of strdup() and strndup() that allocate with igraph_malloc(),
+ * so that the result can be released with IGRAPH_FREE() even when a custom
+ * allocator is in use. */
+char* igraph_i_strdup(const char *s);
+char* igraph_i_strndup(const char *s, size_t n);
 
 #ifndef HAVE_STRCASECMP
     #ifdef HAVE__STRICMP
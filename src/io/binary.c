@@ -0,0 +1,731 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "igraph_foreign.h"
+
+#include "igraph_attributes.h"
+#include "igraph_conversion.h"
+#include "igraph_interface.h"
+#include "igraph_memory.h"
+
+#include "graph/attributes.h"
+#include "graph/internal.h"
+
+#include <stdint.h>
+#include <string.h>
+
+/* Layout of the binary graph format:
+ *
+ *   header              igraph_i_binary_header_t
+ *   from, to, oi, ii    no_of_edges igraph_integer_t values each
+ *   os, is              no_of_nodes + 1 igraph_integer_t values each
+ *   attributes          no_of_attributes times:
+ *                         igraph_i_binary_attr_header_t
+ *                         the name, null-terminated
+ *                         the values; one igraph_real_t per element for
+ *                         numeric attributes, one byte per element for
+ *                         Boolean attributes, and count + 1 igraph_integer_t
+ *                         offsets followed by the null-terminated strings
+ *                         for string attributes
+ *
+ * Every section is padded with zeros to a multiple of eight bytes, so all
+ * arrays are suitably aligned when the file is memory mapped. All values
+ * are in the native byte order of the machine that wrote the file; the
+ * byte order tag in the header allows detecting a mismatch. */
+
+#define IGRAPH_I_BINARY_VERSION 1
+#define IGRAPH_I_BINARY_BYTE_ORDER 0x01020304
+#define IGRAPH_I_BINARY_DIRECTED 0x1
+
+/* Arrays are read in chunks of at most this many elements, and the vectors
+ * holding them grow as the data arrives. Thus a truncated or corrupted file
+ * cannot make the reader allocate much more memory than its actual size,
+ * whatever the counts in its headers are. */
+#define IGRAPH_I_BINARY_CHUNK_SIZE 65536
+
+static const char igraph_i_binary_magic[8] = { 'I', 'G', 'R', 'A', 'P', 'H', 'B', '\0' };
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byte_order;
+    uint32_t integer_size;
+    uint32_t real_size;
+    uint32_t flags;
+    uint32_t reserved;
+    int64_t no_of_nodes;
+    int64_t no_of_edges;
+    int64_t no_of_attributes;
+} igraph_i_binary_header_t;
+
+typedef struct {
+    uint32_t elemtype;
+    uint32_t type;
+    int64_t name_length;
+} igraph_i_binary_attr_header_t;
+
+static size_t igraph_i_binary_padding(size_t size) {
+    return (8 - size % 8) % 8;
+}
+
+static igraph_error_t igraph_i_binary_write_padding(size_t size, FILE *outstream) {
+    static const char zeros[8] = { 0 };
+    size_t pad = igraph_i_binary_padding(size);
+    if (pad > 0 && fwrite(zeros, 1, pad, outstream) != pad) {
+        IGRAPH_ERROR("Write failed.", IGRAPH_EFILE);
+    }
+    return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t igraph_i_binary_write(const void *data, size_t size, size_t count,
+                                            FILE *outstream) {
+    if (count > 0 && fwrite(data, size, count, outstream) != count) {
+        IGRAPH_ERROR("Write failed.", IGRAPH_EFILE);
+    }
+    return igraph_i_binary_write_padding(size * count, outstream);
+}
+
+static igraph_error_t igraph_i_binary_read_padding(size_t size, FILE *instream) {
+    char pad[8];
+    size_t padsize = igraph_i_binary_padding(size);
+    if (padsize > 0 && fread(pad, 1, padsize, instream) != padsize) {
+        IGRAPH_ERROR("Unexpected end of file or read error in binary graph file.", IGRAPH_PARSEERROR);
+    }
+    return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t igraph_i_binary_read(void *data, size_t size, size_t count,
+                                           FILE *instream) {
+    if (count > 0 && fread(data, size, count, instream) != count) {
+        IGRAPH_ERROR("Unexpected end of file or read error in binary graph file.", IGRAPH_PARSEERROR);
+    }
+    return igraph_i_binary_read_padding(size * count, instream);
+}
+
+/* Reads 'count' integers into 'vec', see IGRAPH_I_BINARY_CHUNK_SIZE. */
+static igraph_error_t igraph_i_binary_read_int_vector(
+        igraph_vector_int_t *vec, igraph_integer_t count, FILE *instream) {
+
+    igraph_vector_int_clear(vec);
+    for (igraph_integer_t done = 0; done < count; ) {
+        igraph_integer_t chunk = count - done, capacity;
+        if (chunk > IGRAPH_I_BINARY_CHUNK_SIZE) {
+            chunk = IGRAPH_I_BINARY_CHUNK_SIZE;
+        }
+        capacity = igraph_vector_int_capacity(vec);
+        if (done + chunk > capacity) {
+            /* Double the capacity, but do not exceed 'count'. */
+            capacity = capacity < count - capacity ? 2 * capacity : count;
+            if (capacity < done + chunk) {
+                capacity = done + chunk;
+            }
+            IGRAPH_CHECK(igraph_vector_int_reserve(vec, capacity));
+        }
+        IGRAPH_CHECK(igraph_vector_int_resize(vec, done + chunk)); /* reserved */
+        if (fread(VECTOR(*vec) + done, sizeof(igraph_integer_t), chunk, instream) != (size_t) chunk) {
+            IGRAPH_ERROR("Unexpected end of file or read error in binary graph file.", IGRAPH_PARSEERROR);
+        }
+        done += chunk;
+    }
+    return igraph_i_binary_read_padding(sizeof(igraph_integer_t) * count, instream);
+}
+
+/* Reads 'count' bytes into 'vec', see IGRAPH_I_BINARY_CHUNK_SIZE. */
+static igraph_error_t igraph_i_binary_read_char_vector(
+        igraph_vector_char_t *vec, igraph_integer_t count, FILE *instream) {
+
+    igraph_vector_char_clear(vec);
+    for (igraph_integer_t done = 0; done < count; ) {
+        igraph_integer_t chunk = count - done, capacity;
+        if (chunk > IGRAPH_I_BINARY_CHUNK_SIZE) {
+            chunk = IGRAPH_I_BINARY_CHUNK_SIZE;
+        }
+        capacity = igraph_vector_char_capacity(vec);
+        if (done + chunk > capacity) {
+            /* Double the capacity, but do not exceed 'count'. */
+            capacity = capacity < count - capacity ? 2 * capacity : count;
+            if (capacity < done + chunk) {
+                capacity = done + chunk;
+            }
+            IGRAPH_CHECK(igraph_vector_char_reserve(vec, capacity));
+        }
+        IGRAPH_CHECK(igraph_vector_char_resize(vec, done + chunk)); /* reserved */
+        if (fread(VECTOR(*vec) + done, 1, chunk, instream) != (size_t) chunk) {
+            IGRAPH_ERROR("Unexpected end of file or read error in binary graph file.", IGRAPH_PARSEERROR);
+        }
+        done += chunk;
+    }
+    return igraph_i_binary_read_padding(count, instream);
+}
+
+static igraph_error_t igraph_i_binary_check_header(const igraph_i_binary_header_t *header) {
+    if (memcmp(header->magic, igraph_i_binary_magic, sizeof(header->magic)) != 0) {
+        IGRAPH_ERROR("Not a binary igraph graph file.", IGRAPH_PARSEERROR);
+    }
+    if (header->byte_order != IGRAPH_I_BINARY_BYTE_ORDER) {
+        IGRAPH_ERROR("Binary graph file was written on a machine with a different byte order.",
+                     IGRAPH_PARSEERROR);
+    }
+    if (header->version != IGRAPH_I_BINARY_VERSION) {
+        IGRAPH_ERRORF("Unsupported binary graph file version: %d.",
+                      IGRAPH_PARSEERROR, (int) header->version);
+    }
+    if (header->integer_size != sizeof(igraph_integer_t) || header->real_size != sizeof(igraph_real_t)) {
+        IGRAPH_ERRORF("Binary graph file was written with %d-byte integers and "
+                      "%d-byte reals, expected %d and %d.", IGRAPH_PARSEERROR,
+                      (int) header->integer_size, (int) header->real_size,
+                      (int) sizeof(igraph_integer_t), (int) sizeof(igraph_real_t));
+    }
+    if (header->no_of_nodes < 0 || header->no_of_nodes > IGRAPH_VCOUNT_MAX ||
+        header->no_of_edges < 0 || header->no_of_edges > IGRAPH_ECOUNT_MAX ||
+        header->no_of_attributes < 0) {
+        IGRAPH_ERROR("Invalid header in binary graph file.", IGRAPH_PARSEERROR);
+    }
+    return IGRAPH_SUCCESS;
+}
+
+static igraph_integer_t igraph_i_binary_attr_count(
+        igraph_integer_t no_of_nodes, igraph_integer_t no_of_edges,
+        igraph_attribute_elemtype_t elemtype) {
+    switch (elemtype) {
+    case IGRAPH_ATTRIBUTE_GRAPH: return 1;
+    case IGRAPH_ATTRIBUTE_VERTEX: return no_of_nodes;
+    case IGRAPH_ATTRIBUTE_EDGE: return no_of_edges;
+    default: IGRAPH_FATAL("Invalid attribute element type.");
+    }
+}
+
+static igraph_bool_t igraph_i_binary_attr_supported(igraph_attribute_type_t type) {
+    return type == IGRAPH_ATTRIBUTE_NUMERIC ||
+           type == IGRAPH_ATTRIBUTE_BOOLEAN ||
+           type == IGRAPH_ATTRIBUTE_STRING;
+}
+
+static igraph_error_t igraph_i_binary_write_attr(
+        const igraph_t *graph, igraph_attribute_elemtype_t elemtype,
+        const char *name, igraph_attribute_type_t type, FILE *outstream) {
+
+    igraph_i_binary_attr_header_t header;
+    igraph_integer_t count = igraph_i_binary_attr_count(
+            igraph_vcount(graph), igraph_ecount(graph), elemtype);
+    igraph_vs_t vs = igraph_vss_all();
+    igraph_es_t es = igraph_ess_all(IGRAPH_EDGEORDER_ID);
+
+    memset(&header, 0, sizeof(header));
+    header.elemtype = elemtype;
+    header.type = type;
+    header.name_length = strlen(name);
+
+    IGRAPH_CHECK(igraph_i_binary_write(&header, sizeof(header), 1, outstream));
+    IGRAPH_CHECK(igraph_i_binary_write(name, 1, header.name_length + 1, outstream));
+
+    if (type == IGRAPH_ATTRIBUTE_NUMERIC) {
+        igraph_vector_t values;
+        IGRAPH_VECTOR_INIT_FINALLY(&values, 0);
+        switch (elemtype) {
+        case IGRAPH_ATTRIBUTE_GRAPH:
+            IGRAPH_CHECK(igraph_i_attribute_get_numeric_graph_attr(graph, name, &values));
+            break;
+        case IGRAPH_ATTRIBUTE_VERTEX:
+            IGRAPH_CHECK(igraph_i_attribute_get_numeric_vertex_attr(graph, name, vs, &values));
+            break;
+        default:
+            IGRAPH_CHECK(igraph_i_attribute_get_numeric_edge_attr(graph, name, es, &values));
+            break;
+        }
+        IGRAPH_CHECK(igraph_i_binary_write(VECTOR(values), sizeof(igraph_real_t), count, outstream));
+        igraph_vector_destroy(&values);
+        IGRAPH_FINALLY_CLEAN(1);
+    } else if (type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+        igraph_vector_bool_t values;
+        IGRAPH_VECTOR_BOOL_INIT_FINALLY(&values, 0);
+        switch (elemtype) {
+        case IGRAPH_ATTRIBUTE_GRAPH:
+            IGRAPH_CHECK(igraph_i_attribute_get_bool_graph_attr(graph, name, &values));
+            break;
+        case IGRAPH_ATTRIBUTE_VERTEX:
+            IGRAPH_CHECK(igraph_i_attribute_get_bool_vertex_attr(graph, name, vs, &values));
+            break;
+        default:
+            IGRAPH_CHECK(igraph_i_attribute_get_bool_edge_attr(graph, name, es, &values));
+            break;
+        }
+        for (igraph_integer_t i = 0; i < count; i++) {
+            unsigned char c = VECTOR(values)[i] ? 1 : 0;
+            if (fwrite(&c, 1, 1, outstream) != 1) {
+                IGRAPH_ERROR("Write failed.", IGRAPH_EFILE);
+            }
+        }
+        IGRAPH_CHECK(igraph_i_binary_write_padding(count, outstream));
+        igraph_vector_bool_destroy(&values);
+        IGRAPH_FINALLY_CLEAN(1);
+    } else {
+        igraph_strvector_t values;
+        igraph_vector_int_t offsets;
+        IGRAPH_STRVECTOR_INIT_FINALLY(&values, 0);
+        switch (elemtype) {
+        case IGRAPH_ATTRIBUTE_GRAPH:
+            IGRAPH_CHECK(igraph_i_attribute_get_string_graph_attr(graph, name, &values));
+            break;
+        case IGRAPH_ATTRIBUTE_VERTEX:
+            IGRAPH_CHECK(igraph_i_attribute_get_string_vertex_attr(graph, name, vs, &values));
+            break;
+        default:
+            IGRAPH_CHECK(igraph_i_attribute_get_string_edge_attr(graph, name, es, &values));
+            break;
+        }
+        IGRAPH_VECTOR_INT_INIT_FINALLY(&offsets, count + 1);
+        for (igraph_integer_t i = 0; i < count; i++) {
+            VECTOR(offsets)[i + 1] = VECTOR(offsets)[i] + strlen(igraph_strvector_get(&values, i)) + 1;
+        }
+        IGRAPH_CHECK(igraph_i_binary_write(VECTOR(offsets), sizeof(igraph_integer_t), count + 1, outstream));
+        for (igraph_integer_t i = 0; i < count; i++) {
+            size_t len = VECTOR(offsets)[i + 1] - VECTOR(offsets)[i];
+            if (fwrite(igraph_strvector_get(&values, i), 1, len, outstream) != len) {
+                IGRAPH_ERROR("Write failed.", IGRAPH_EFILE);
+            }
+        }
+        IGRAPH_CHECK(igraph_i_binary_write_padding(VECTOR(offsets)[count], outstream));
+        igraph_vector_int_destroy(&offsets);
+        igraph_strvector_destroy(&values);
+        IGRAPH_FINALLY_CLEAN(2);
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_write_graph_binary
+ * \brief Writes a graph to a file in igraph's binary format.
+ *
+ * \experimental
+ *
+ * </para><para>
+ * This format stores the internal data structures of an igraph graph
+ * as they are, i.e. the edge list and the edge indices that igraph
+ * builds when a graph is created. A graph saved this way can be loaded
+ * with \ref igraph_read_graph_binary() without sorting the edges or
+ * parsing text, which is much faster than reading any of the text-based
+ * formats for large graphs.
+ *
+ * </para><para>
+ * Numeric, string and Boolean graph, vertex and edge attributes are saved
+ * as well, if an attribute handler is attached. Attributes of other types
+ * are skipped with a warning.
+ *
+ * </para><para>
+ * All sections of the file are aligned to eight bytes, so that the data
+ * can be used directly after memory-mapping the file, see
+ * \ref igraph_read_graph_binary_view(). The format is meant
+ * for caching graphs between runs, not for exchanging data: all numbers
+ * are written in the native byte order and integer size of the machine,
+ * and files written on a machine with a different byte order or with an
+ * igraph version using a different integer size cannot be read.
+ *
+ * </para><para>
+ * The stream must be opened in binary mode.
+ *
+ * \param graph The graph to write.
+ * \param outstream The stream object to write to, it should be
+ *        writable and opened in binary mode.
+ * \return Error code:
+ *         \c IGRAPH_EFILE if there is an error writing the
+ *         file.
+ *
+ * Time complexity: O(|V|+|E|) plus the total size of the attributes.
+ *
+ * \sa \ref igraph_read_graph_binary() to read the file back.
+ */
+igraph_error_t igraph_write_graph_binary(const igraph_t *graph, FILE *outstream) {
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t no_of_edges = igraph_ecount(graph);
+    igraph_i_binary_header_t header;
+    igraph_strvector_t names[3];
+    igraph_vector_int_t types[3];
+    igraph_attribute_elemtype_t elemtypes[3] = {
+        IGRAPH_ATTRIBUTE_GRAPH, IGRAPH_ATTRIBUTE_VERTEX, IGRAPH_ATTRIBUTE_EDGE
+    };
+
+    for (int k = 0; k < 3; k++) {
+        IGRAPH_STRVECTOR_INIT_FINALLY(&names[k], 0);
+        IGRAPH_VECTOR_INT_INIT_FINALLY(&types[k], 0);
+    }
+    IGRAPH_CHECK(igraph_i_attribute_get_info(graph,
+                 &names[0], &types[0], &names[1], &types[1], &names[2], &types[2]));
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, igraph_i_binary_magic, sizeof(header.magic));
+    header.version = IGRAPH_I_BINARY_VERSION;
+    header.byte_order = IGRAPH_I_BINARY_BYTE_ORDER;
+    header.integer_size = sizeof(igraph_integer_t);
+    header.real_size = sizeof(igraph_real_t);
+    header.flags = igraph_is_directed(graph) ? IGRAPH_I_BINARY_DIRECTED : 0;
+    header.no_of_nodes = no_of_nodes;
+    header.no_of_edges = no_of_edges;
+    for (int k = 0; k < 3; k++) {
+        igraph_integer_t n = igraph_vector_int_size(&types[k]);
+        for (igraph_integer_t i = 0; i < n; i++) {
+            if (igraph_i_binary_attr_supported(VECTOR(types[k])[i])) {
+                header.no_of_attributes++;
+            } else {
+                IGRAPH_WARNINGF("Attribute '%s' has an unsupported type and will not be saved.",
+                                igraph_strvector_get(&names[k], i));
+            }
+        }
+    }
+
+    IGRAPH_CHECK(igraph_i_binary_write(&header, sizeof(header), 1, outstream));
+    IGRAPH_CHECK(igraph_i_binary_write(VECTOR(graph->from), sizeof(igraph_integer_t), no_of_edges, outstream));
+    IGRAPH_CHECK(igraph_i_binary_write(VECTOR(graph->to), sizeof(igraph_integer_t), no_of_edges, outstream));
+    IGRAPH_CHECK(igraph_i_binary_write(VECTOR(graph->oi), sizeof(igraph_integer_t), no_of_edges, outstream));
+    IGRAPH_CHECK(igraph_i_binary_write(VECTOR(graph->ii), sizeof(igraph_integer_t), no_of_edges, outstream));
+    IGRAPH_CHECK(igraph_i_binary_write(VECTOR(graph->os), sizeof(igraph_integer_t), no_of_nodes + 1, outstream));
+    IGRAPH_CHECK(igraph_i_binary_write(VECTOR(graph->is), sizeof(igraph_integer_t), no_of_nodes + 1, outstream));
+
+    for (int k = 0; k < 3; k++) {
+        igraph_integer_t n = igraph_vector_int_size(&types[k]);
+        for (igraph_integer_t i = 0; i < n; i++) {
+            igraph_attribute_type_t type = VECTOR(types[k])[i];
+            if (igraph_i_binary_attr_supported(type)) {
+                IGRAPH_CHECK(igraph_i_binary_write_attr(
+                                 graph, elemtypes[k], igraph_strvector_get(&names[k], i),
+                                 type, outstream));
+            }
+        }
+    }
+
+    for (int k = 0; k < 3; k++) {
+        igraph_strvector_destroy(&names[k]);
+        igraph_vector_int_destroy(&types[k]);
+    }
+    IGRAPH_FINALLY_CLEAN(6);
+
+    return IGRAPH_SUCCESS;
+}
+
+static void igraph_i_binary_attr_destroy(igraph_vector_ptr_t *attrlist) {
+    igraph_integer_t n = igraph_vector_ptr_size(attrlist);
+    for (igraph_integer_t i = 0; i < n; i++) {
+        igraph_attribute_record_t *rec = VECTOR(*attrlist)[i];
+        if (rec->value) {
+            if (rec->type == IGRAPH_ATTRIBUTE_NUMERIC) {
+                igraph_vector_destroy((igraph_vector_t *) rec->value);
+            } else if (rec->type == IGRAPH_ATTRIBUTE_STRING) {
+                igraph_strvector_destroy((igraph_strvector_t *) rec->value);
+            } else if (rec->type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+                igraph_vector_bool_destroy((igraph_vector_bool_t *) rec->value);
+            }
+            IGRAPH_FREE(rec->value);
+        }
+        IGRAPH_FREE(rec->name);
+        IGRAPH_FREE(rec);
+    }
+    igraph_vector_ptr_destroy(attrlist);
+}
+
+/* Reads the values of a string attribute into 'values', which must have
+ * 'count' elements. */
+static igraph_error_t igraph_i_binary_read_strings(
+        igraph_strvector_t *values, igraph_integer_t count, FILE *instream) {
+
+    igraph_vector_int_t offsets;
+    igraph_vector_char_t buffer;
+    igraph_integer_t size;
+
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&offsets, 0);
+    IGRAPH_CHECK(igraph_i_binary_read_int_vector(&offsets, count + 1, instream));
+    if (VECTOR(offsets)[0] != 0) {
+        IGRAPH_ERROR("Invalid string attribute in binary graph file.", IGRAPH_PARSEERROR);
+    }
+    for (igraph_integer_t i = 0; i < count; i++) {
+        if (VECTOR(offsets)[i + 1] <= VECTOR(offsets)[i]) {
+            IGRAPH_ERROR("Invalid string attribute in binary graph file.", IGRAPH_PARSEERROR);
+        }
+    }
+    size = VECTOR(offsets)[count];
+
+    IGRAPH_VECTOR_CHAR_INIT_FINALLY(&buffer, 0);
+    IGRAPH_CHECK(igraph_i_binary_read_char_vector(&buffer, size, instream));
+
+    for (igraph_integer_t i = 0; i < count; i++) {
+        const char *str = VECTOR(buffer) + VECTOR(offsets)[i];
+        igraph_integer_t len = VECTOR(offsets)[i + 1] - VECTOR(offsets)[i] - 1;
+        if (str[len] != '\0' || (igraph_integer_t) strlen(str) != len) {
+            IGRAPH_ERROR("Invalid string attribute in binary graph file.", IGRAPH_PARSEERROR);
+        }
+        IGRAPH_CHECK(igraph_strvector_set_len(values, i, str, len));
+    }
+
+    igraph_vector_char_destroy(&buffer);
+    igraph_vector_int_destroy(&offsets);
+    IGRAPH_FINALLY_CLEAN(2);
+
+    return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t igraph_i_binary_read_attr(
+        igraph_vector_ptr_t *attrs[3], igraph_integer_t no_of_nodes,
+        igraph_integer_t no_of_edges, FILE *instream) {
+
+    igraph_i_binary_attr_header_t header;
+    igraph_attribute_record_t *rec;
+    igraph_vector_ptr_t *attrlist;
+    igraph_vector_char_t namebuf;
+    igraph_integer_t count;
+    char *name;
+
+    IGRAPH_CHECK(igraph_i_binary_read(&header, sizeof(header), 1, instream));
+    if (header.elemtype > IGRAPH_ATTRIBUTE_EDGE ||
+        !igraph_i_binary_attr_supported(header.type) ||
+        header.name_length <= 0 || header.name_length >= IGRAPH_INTEGER_MAX) {
+        IGRAPH_ERROR("Invalid attribute in binary graph file.", IGRAPH_PARSEERROR);
+    }
+    attrlist = attrs[header.elemtype];
+    count = igraph_i_binary_attr_count(no_of_nodes, no_of_edges, header.elemtype);
+
+    IGRAPH_VECTOR_CHAR_INIT_FINALLY(&namebuf, 0);
+    IGRAPH_CHECK(igraph_i_binary_read_char_vector(&namebuf, header.name_length + 1, instream));
+    if (VECTOR(namebuf)[header.name_length] != '\0' ||
+        (igraph_integer_t) strlen(VECTOR(namebuf)) != header.name_length) {
+        IGRAPH_ERROR("Invalid attribute name in binary graph file.", IGRAPH_PARSEERROR);
+    }
+
+    IGRAPH_CHECK(igraph_vector_ptr_reserve(attrlist, igraph_vector_ptr_size(attrlist) + 1));
+    rec = IGRAPH_CALLOC(1, igraph_attribute_record_t);
+    IGRAPH_CHECK_OOM(rec, "Cannot read binary graph file.");
+    igraph_vector_ptr_push_back(attrlist, rec); /* reserved */
+    rec->type = header.type;
+
+    /* From here on, 'rec' is owned by the attribute list. */
+    name = IGRAPH_CALLOC(header.name_length + 1, char);
+    IGRAPH_CHECK_OOM(name, "Cannot read binary graph file.");
+    memcpy(name, VECTOR(namebuf), header.name_length + 1);
+    rec->name = name;
+    igraph_vector_char_destroy(&namebuf);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    if (header.type == IGRAPH_ATTRIBUTE_NUMERIC) {
+        igraph_vector_t *values = IGRAPH_CALLOC(1, igraph_vector_t);
+        IGRAPH_CHECK_OOM(values, "Cannot read binary graph file.");
+        IGRAPH_FINALLY(igraph_free, values);
+        IGRAPH_CHECK(igraph_vector_init(values, count));
+        IGRAPH_FINALLY_CLEAN(1);
+        rec->value = values;
+        IGRAPH_CHECK(igraph_i_binary_read(VECTOR(*values), sizeof(igraph_real_t), count, instream));
+    } else if (header.type == IGRAPH_ATTRIBUTE_BOOLEAN) {
+        igraph_vector_bool_t *values = IGRAPH_CALLOC(1, igraph_vector_bool_t);
+        IGRAPH_CHECK_OOM(values, "Cannot read binary graph file.");
+        IGRAPH_FINALLY(igraph_free, values);
+        IGRAPH_CHECK(igraph_vector_bool_init(values, count));
+        IGRAPH_FINALLY_CLEAN(1);
+        rec->value = values;
+        for (igraph_integer_t i = 0; i < count; i++) {
+            int c = fgetc(instream);
+            if (c == EOF) {
+                IGRAPH_ERROR("Unexpected end of file or read error in binary graph file.", IGRAPH_PARSEERROR);
+            }
+            if (c > 1) {
+                IGRAPH_ERROR("Invalid Boolean attribute in binary graph file.", IGRAPH_PARSEERROR);
+            }
+            VECTOR(*values)[i] = c;
+        }
+        IGRAPH_CHECK(igraph_i_binary_read_padding(count, instream));
+    } else {
+        igraph_strvector_t *values = IGRAPH_CALLOC(1, igraph_strvector_t);
+        IGRAPH_CHECK_OOM(values, "Cannot read binary graph file.");
+        IGRAPH_FINALLY(igraph_free, values);
+        IGRAPH_CHECK(igraph_strvector_init(values, count));
+        IGRAPH_FINALLY_CLEAN(1);
+        rec->value = values;
+        IGRAPH_CHECK(igraph_i_binary_read_strings(values, count, instream));
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_read_graph_binary
+ * \brief Reads a graph from a file in igraph's binary format.
+ *
+ * \experimental
+ *
+ * </para><para>
+ * Reads a graph that was written by \ref igraph_write_graph_binary().
+ * The edge list and the edge indices are read into memory as they are,
+ * without sorting, and are checked for consistency in linear time, so
+ * this is much faster than reading the same graph from any of the text
+ * based formats. Graph, vertex and edge attributes are restored if an
+ * attribute handler is attached, and ignored otherwise.
+ *
+ * </para><para>
+ * Files written on a machine with a different byte order, or by an igraph
+ * version using a different integer size, are rejected with an error.
+ * Memory is allocated as the data is read, so truncated or corrupted files
+ * are rejected without allocating much more memory than their size.
+ *
+ * \param graph Pointer to an uninitialized graph object.
+ * \param instream A stream, it should be readable and opened in binary
+ *        mode.
+ * \return Error code:
+ *         \c IGRAPH_PARSEERROR if the file is not a valid binary graph
+ *         file, it is truncated, or it was written on an incompatible
+ *         machine.
+ *
+ * Time complexity: O(|V|+|E|) plus the total size of the attributes.
+ *
+ * \sa \ref igraph_write_graph_binary().
+ */
+igraph_error_t igraph_read_graph_binary(igraph_t *graph, FILE *instream) {
+    igraph_i_binary_header_t header;
+    igraph_integer_t no_of_nodes, no_of_edges;
+    igraph_vector_int_t from, to, oi, ii, os, is;
+    igraph_vector_ptr_t gattr, vattr, eattr;
+    igraph_vector_ptr_t *attrs[3] = { &gattr, &vattr, &eattr };
+
+    IGRAPH_CHECK(igraph_i_binary_read(&header, sizeof(header), 1, instream));
+    IGRAPH_CHECK(igraph_i_binary_check_header(&header));
+    no_of_nodes = header.no_of_nodes;
+    no_of_edges = header.no_of_edges;
+
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&from, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&to, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&oi, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ii, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&os, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&is, 0);
+
+    IGRAPH_CHECK(igraph_i_binary_read_int_vector(&from, no_of_edges, instream));
+    IGRAPH_CHECK(igraph_i_binary_read_int_vector(&to, no_of_edges, instream));
+    IGRAPH_CHECK(igraph_i_binary_read_int_vector(&oi, no_of_edges, instream));
+    IGRAPH_CHECK(igraph_i_binary_read_int_vector(&ii, no_of_edges, instream));
+    IGRAPH_CHECK(igraph_i_binary_read_int_vector(&os, no_of_nodes + 1, instream));
+    IGRAPH_CHECK(igraph_i_binary_read_int_vector(&is, no_of_nodes + 1, instream));
+
+    if (!igraph_i_indexed_edges_valid(no_of_nodes, no_of_edges,
+                                      (header.flags & IGRAPH_I_BINARY_DIRECTED) != 0,
+                                      VECTOR(from), VECTOR(to), VECTOR(oi), VECTOR(ii),
+                                      VECTOR(os), VECTOR(is))) {
+        IGRAPH_ERROR("Inconsistent edge data in binary graph file.", IGRAPH_PARSEERROR);
+    }
+
+    IGRAPH_CHECK(igraph_vector_ptr_init(&gattr, 0));
+    IGRAPH_FINALLY(igraph_i_binary_attr_destroy, &gattr);
+    IGRAPH_CHECK(igraph_vector_ptr_init(&vattr, 0));
+    IGRAPH_FINALLY(igraph_i_binary_attr_destroy, &vattr);
+    IGRAPH_CHECK(igraph_vector_ptr_init(&eattr, 0));
+    IGRAPH_FINALLY(igraph_i_binary_attr_destroy, &eattr);
+
+    for (igraph_integer_t i = 0; i < header.no_of_attributes; i++) {
+        IGRAPH_CHECK(igraph_i_binary_read_attr(attrs, no_of_nodes, no_of_edges, instream));
+    }
+
+    IGRAPH_CHECK(igraph_empty_attrs(graph, 0, (header.flags & IGRAPH_I_BINARY_DIRECTED) != 0,
+                                    igraph_vector_ptr_size(&gattr) > 0 ? &gattr : NULL));
+    IGRAPH_FINALLY(igraph_destroy, graph);
+    IGRAPH_CHECK(igraph_add_vertices(graph, no_of_nodes,
+                                     igraph_vector_ptr_size(&vattr) > 0 ? &vattr : NULL));
+    igraph_i_set_indexed_edges(graph, &from, &to, &oi, &ii, &os, &is);
+
+    if (igraph_vector_ptr_size(&eattr) > 0 && graph->attr) {
+        /* The attribute handler expects the edge list of the new edges. */
+        igraph_vector_int_t edges;
+        IGRAPH_VECTOR_INT_INIT_FINALLY(&edges, 0);
+        IGRAPH_CHECK(igraph_get_edgelist(graph, &edges, false));
+        IGRAPH_CHECK(igraph_i_attribute_add_edges(graph, &edges, &eattr));
+        igraph_vector_int_destroy(&edges);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
+
+    igraph_i_binary_attr_destroy(&eattr);
+    igraph_i_binary_attr_destroy(&vattr);
+    igraph_i_binary_attr_destroy(&gattr);
+    igraph_vector_int_destroy(&is);
+    igraph_vector_int_destroy(&os);
+    igraph_vector_int_destroy(&ii);
+    igraph_vector_int_destroy(&oi);
+    igraph_vector_int_destroy(&to);
+    igraph_vector_int_destroy(&from);
+    IGRAPH_FINALLY_CLEAN(10); /* + graph */
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_read_graph_binary_view
+ * \brief Creates a read-only view of a graph stored in memory in igraph's binary format.
+ *
+ * \experimental
+ *
+ * </para><para>
+ * Creates a graph view, see \ref igraph_create_view(), over the contents
+ * of a file written by \ref igraph_write_graph_binary() that is already in
+ * memory, typically because it was memory-mapped. The edge data is used in
+ * place: no memory proportional to the size of the graph is allocated, and
+ * processes mapping the same file share a single copy of the graph. The
+ * buffer must stay valid and unchanged while the view is in use.
+ *
+ * </para><para>
+ * Attributes stored in the file are not loaded. Use
+ * \ref igraph_read_graph_binary() to read them.
+ *
+ * \param graph Pointer to an uninitialized graph object.
+ * \param data The contents of the file. It must be aligned suitably for
+ *        \type igraph_integer_t, which is always the case for memory-mapped
+ *        files.
+ * \param size The size of \p data in bytes.
+ * \param validate Whether to check that the edge data is consistent, see
+ *        \ref igraph_create_view().
+ * \return Error code:
+ *         \c IGRAPH_PARSEERROR if the data is not a valid binary graph
+ *         file, it is truncated, or it was written on an incompatible
+ *         machine;
+ *         \c IGRAPH_EINVAL if the data is not aligned.
+ *
+ * Time complexity: O(|V|+|E|) if \p validate is true, O(1) otherwise.
+ */
+igraph_error_t igraph_read_graph_binary_view(igraph_t *graph, const void *data, size_t size,
+                                             igraph_bool_t validate) {
+    const char *bytes = data;
+    igraph_i_binary_header_t header;
+    const igraph_integer_t *arrays;
+    igraph_integer_t n, m;
+    size_t avail;
+
+    if ((uintptr_t) data % sizeof(igraph_integer_t) != 0) {
+        IGRAPH_ERROR("Binary graph data is not suitably aligned.", IGRAPH_EINVAL);
+    }
+    if (size < sizeof(header)) {
+        IGRAPH_ERROR("Unexpected end of data in binary graph file.", IGRAPH_PARSEERROR);
+    }
+    memcpy(&header, bytes, sizeof(header));
+    IGRAPH_CHECK(igraph_i_binary_check_header(&header));
+    n = header.no_of_nodes;
+    m = header.no_of_edges;
+
+    avail = (size - sizeof(header)) / sizeof(igraph_integer_t);
+    if ((size_t) m > avail / 4 || (size_t) n + 1 > (avail - 4 * (size_t) m) / 2) {
+        IGRAPH_ERROR("Unexpected end of data in binary graph file.", IGRAPH_PARSEERROR);
+    }
+    arrays = (const igraph_integer_t *) (bytes + sizeof(header));
+
+    IGRAPH_CHECK(igraph_create_view(graph, n, m, (header.flags & IGRAPH_I_BINARY_DIRECTED) != 0,
+                                    arrays, arrays + m, arrays + 2 * m, arrays + 3 * m,
+                                    arrays + 4 * m, arrays + 4 * m + n + 1, validate));
+
+    return IGRAPH_SUCCESS;
+}
@@ -50,7 +50,7 @@
 #include "io/parsers/gml-parser.h"
 #include "io/parsers/gml-lexer.h"
 #include "io/parse_utils.h"
-#include "internal/hacks.h" /* strcasecmp & strndup */
+#include "internal/hacks.h" /* strcasecmp & igraph_i_strndup */
 #include "math/safe_intop.h"
 
 #include <stdio.h>
@@ -114,7 +114,7 @@ static igraph_error_t igraph_i_gml_merge(igraph_gml_tree_t *t1, igraph_gml_tree_
 %token END 0            "end of file" /* friendly name for $end */
 %token ERROR
 
-%destructor { free($$); } string key;
+%destructor { igraph_free($$); } string key;
 %destructor { igraph_gml_tree_destroy($$); } list keyvalue;
 
 %%
@@ -159,7 +159,7 @@ int igraph_gml_yyerror(YYLTYPE* locp, igraph_i_gml_parsedata_t *context,
 }
 
 static igraph_error_t igraph_i_gml_get_keyword(const char *s, size_t len, char **res) {
-  *res = strndup(s, len);
+  *res = igraph_i_strndup(s, len);
   if (! *res) {
     IGRAPH_ERROR("Cannot read GML file.", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
   }
@@ -167,7 +167,7 @@ static igraph_error_t igraph_i_gml_get_keyword(const char *s, size_t len, char *
 }
 
 static igraph_error_t igraph_i_gml_get_string(const char *s, size_t len, char **res) {
-  *res = strndup(s+1, len-2);
+  *res = igraph_i_strndup(s+1, len-2);
   if (! *res) {
     IGRAPH_ERROR("Cannot read GML file.", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
   }
@@ -28,7 +28,7 @@
 
 #include "core/trie.h"
 #include "graph/attributes.h"
-#include "internal/hacks.h" /* strdup, strncasecmp */
+#include "internal/hacks.h" /* igraph_i_strdup, strncasecmp */
 #include "math/safe_intop.h"
 
 #include "io/gml-header.h"
@@ -300,7 +300,7 @@ static igraph_error_t create_or_update_attribute(const char *name,
         IGRAPH_CHECK_OOM(atrec, "Cannot read GML file.");
         IGRAPH_FINALLY(igraph_free, atrec);
 
-        atrec->name = strdup(name);
+        atrec->name = igraph_i_strdup(name);
         IGRAPH_CHECK_OOM(atrec->name, "Cannot read GML file.");
         IGRAPH_FINALLY(igraph_free, (char *) atrec->name);
 
@@ -25,7 +25,7 @@
 #include "core/interruption.h"
 #include "core/trie.h"
 #include "graph/attributes.h"
-#include "internal/hacks.h" /* strcasecmp & strdup */
+#include "internal/hacks.h" /* strcasecmp & igraph_i_strdup */
 #include "io/parse_utils.h"
 
 #include "config.h" /* HAVE_LIBXML */
@@ -664,22 +664,21 @@ static igraph_error_t igraph_i_graphml_add_attribute_key(
             rec->id = fromXmlChar(xmlStr);
             xmlStr = NULL;
         } else if (xmlStrEqual(localname, toXmlChar("attr.name"))) {
-            xmlStr = xmlStrndup(XML_ATTR_VALUE(it));
-            IGRAPH_CHECK_OOM(xmlStr, "Cannot duplicate value of 'attr.name' attribute.");
             if (rec->record.name) {
                 /* may happen if the 'attr.name' attribute is provided multiple times */
-                xmlFree((void *) rec->record.name);
-                rec->record.name = NULL;
+                IGRAPH_FREE(rec->record.name);
             }
-            rec->record.name = fromXmlChar(xmlStr);
-            xmlStr = NULL;
+            /* attribute names are freed with IGRAPH_FREE(), so they must be
+             * allocated by igraph, not by libxml2 */
+            rec->record.name = igraph_i_strndup(fromXmlChar(XML_ATTR_VALUE_START(it)), XML_ATTR_VALUE_LENGTH(it));
+            IGRAPH_CHECK_OOM(rec->record.name, "Cannot duplicate value of 'attr.name' attribute.");
         } else if (xmlStrEqual(localname, toXmlChar("attr.type"))) {
             if (xmlAttrValueEqual(it, "boolean")) {
                 rec->type = I_GRAPHML_BOOLEAN;
                 rec->record.type = IGRAPH_ATTRIBUTE_BOOLEAN;
                 rec->default_value.as_boolean = 0;
             } else if (xmlAttrValueEqual(it, "string")) {
-                char *str = strdup("");
+                char *str = igraph_i_strdup("");
                 IGRAPH_CHECK_OOM(str, "Cannot allocate new empty string.");
                 rec->type = I_GRAPHML_STRING;
                 rec->record.type = IGRAPH_ATTRIBUTE_STRING;
@@ -750,7 +749,7 @@ static igraph_error_t igraph_i_graphml_add_attribute_key(
 
     /* in case of a missing attr.name attribute, use the id as the attribute name */
     if (rec->record.name == NULL) {
-        rec->record.name = strdup(rec->id);
+        rec->record.name = igraph_i_strdup(rec->id);
         IGRAPH_CHECK_OOM(rec->record.name, "Cannot duplicate attribute ID as name.");
     }
 
@@ -1059,7 +1058,7 @@ static igraph_error_t igraph_i_graphml_attribute_default_value_finish(struct igr
     case IGRAPH_ATTRIBUTE_STRING:
         /* Add null terminator */
         IGRAPH_CHECK(igraph_vector_char_push_back(&state->data_char, '\x00'));
-        str = strdup(VECTOR(state->data_char));
+        str = igraph_i_strdup(VECTOR(state->data_char));
         IGRAPH_CHECK_OOM(str, "Cannot allocate memory for string attribute.");
 
         if (graphmlrec->default_value.as_string != 0) {
@@ -1707,7 +1706,7 @@ igraph_error_t igraph_read_graph_graphml(igraph_t *graph, FILE *instream, igraph
      * copy so we can safely destroy the parser state before triggering the
      * error */
     parsing_successful = state.successful;
-    error_message = parsing_successful || state.error_message == NULL ? NULL : strdup(state.error_message);
+    error_message = parsing_successful || state.error_message == NULL ? NULL : igraph_i_strdup(state.error_message);
 
     /* ...and we can also put the error message pointer on the FINALLY stack */
     if (error_message != NULL) {
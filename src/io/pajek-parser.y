@@ -53,7 +53,7 @@
 #include "io/parsers/pajek-parser.h" /* it must come first because of YYSTYPE */
 #include "io/parsers/pajek-lexer.h"
 #include "io/parse_utils.h"
-#include "internal/hacks.h" /* strdup */
+#include "internal/hacks.h" /* igraph_i_strdup */
 
 #include <stdio.h>
 #include <string.h>
@@ -130,7 +130,7 @@ static igraph_error_t deconflict_attrname(char **attrname);
 %type <string>   parstrval;
 %type <dynstr>   parname;
 
-%destructor { free($$); } parname;
+%destructor { igraph_free($$); } parname;
 
 %token NEWLINE       "end of line"
 %token NUM           "number"
@@ -587,7 +587,7 @@ static igraph_error_t add_numeric_attribute(igraph_trie_t *names,
     IGRAPH_FINALLY(igraph_free, na);
     IGRAPH_VECTOR_INIT_FINALLY(na, count);
 
-    rec->name = strdup(attrname);
+    rec->name = igraph_i_strdup(attrname);
     CHECK_OOM_RP(rec->name);
     IGRAPH_FINALLY(igraph_free, (void *) rec->name);
 
@@ -619,7 +619,7 @@ static igraph_error_t add_numeric_attribute(igraph_trie_t *names,
 /* TODO: NA's */
 
 static igraph_error_t make_dynstr(const char *src, size_t len, char **res) {
-  *res = strndup(src, len);
+  *res = igraph_i_strndup(src, len);
   CHECK_OOM_RP(*res);
   return IGRAPH_SUCCESS;
 }
@@ -663,7 +663,7 @@ static igraph_error_t add_string_attribute(igraph_trie_t *names,
     IGRAPH_FINALLY(igraph_free, na);
     IGRAPH_STRVECTOR_INIT_FINALLY(na, count);
 
-    rec->name = strdup(attrname);
+    rec->name = igraph_i_strdup(attrname);
     CHECK_OOM_RP(rec->name);
     IGRAPH_FINALLY(igraph_free, (char *) rec->name);
 
@@ -761,7 +761,7 @@ static igraph_error_t add_bipartite_type(igraph_i_pajek_parsedata_t *context) {
   IGRAPH_FINALLY(igraph_free, na);
   IGRAPH_VECTOR_BOOL_INIT_FINALLY(na, n);
 
-  rec->name = strdup(attrname);
+  rec->name = igraph_i_strdup(attrname);
   CHECK_OOM_RP(rec->name);
   IGRAPH_FINALLY(igraph_free, (char *) rec->name);
 
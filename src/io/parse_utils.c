@@ -5,6 +5,7 @@
 #include "igraph_memory.h"
 
 #include "config.h" /* HAVE_XLOCALE */
+#include "internal/hacks.h" /* igraph_i_strdup */
 
 #include <ctype.h>
 #include <errno.h>
@@ -338,7 +339,7 @@ igraph_error_t igraph_enter_safelocale(igraph_safelocale_t *loc) {
     }
     l->original_locale = uselocale(l->c_locale);
 #else
-    l->original_locale = strdup(setlocale(LC_NUMERIC, NULL));
+    l->original_locale = igraph_i_strdup(setlocale(LC_NUMERIC, NULL));
     IGRAPH_CHECK_OOM(l->original_locale, "Not enough memory.");
 # ifdef HAVE__CONFIGTHREADLOCALE
     /* On Windows, we can enable per-thread locale */
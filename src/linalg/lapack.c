@@ -22,6 +22,7 @@
 */
 
 #include "igraph_lapack.h"
+#include "core/memory.h"
 #include "linalg/lapack_internal.h"
 
 #include <limits.h>
@@ -214,7 +214,14 @@ igraph_error_t igraph_get_shortest_path_astar(const igraph_t *graph,
                 VECTOR(dists)[v] = altdist;
                 parent_eids[v] = edge + 1;
                 IGRAPH_CHECK(heuristic(&heur_res, v, to, extra));
-                igraph_2wheap_modify(&Q, v, -(altdist + heur_res));
+                if (igraph_2wheap_has_elem(&Q, v)) {
+                    igraph_2wheap_modify(&Q, v, -(altdist + heur_res));
+                } else {
+                    /* 'v' was already processed. This can only happen when
+                     * the heuristic is admissible but not consistent, and
+                     * then 'v' needs to be processed again. */
+                    IGRAPH_CHECK(igraph_2wheap_push_with_index(&Q, v, -(altdist + heur_res)));
+                }
             }
         }
     } /* !igraph_2wheap_empty(&Q) */
@@ -273,3 +280,263 @@ igraph_error_t igraph_get_shortest_path_astar(const igraph_t *graph,
 
     return IGRAPH_SUCCESS;
 }
+
+/* Computes the distances from landmark 'l' to all vertices, using the
+ * given mode, and stores them in row 'row' of 'dists'. */
+static igraph_error_t igraph_i_landmark_distances(
+        const igraph_t *graph, const igraph_vector_t *weights, igraph_neimode_t mode,
+        igraph_integer_t l, igraph_integer_t row, igraph_matrix_t *dists,
+        igraph_matrix_t *buffer, igraph_workspace_t *ws) {
+
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+
+    IGRAPH_CHECK(igraph_distances_dijkstra_cutoff_ws(graph, buffer, igraph_vss_1(l), igraph_vss_all(),
+                                                     weights, mode, -1, ws));
+    for (igraph_integer_t v = 0; v < no_of_nodes; v++) {
+        MATRIX(*dists, row, v) = MATRIX(*buffer, 0, v);
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_landmark_index_init
+ * \brief Selects landmarks and precomputes their distances to all vertices.
+ *
+ * \experimental
+ *
+ * Prepares a landmark index for the ALT variant of A* search, i.e. A*
+ * with landmarks and the triangle inequality. The distances between each
+ * landmark \c l and all other vertices are computed once. Afterwards, the
+ * distance between any two vertices \c u and \c t is bounded from below by
+ * <code>d(l, t) - d(l, u)</code> and <code>d(u, l) - d(t, l)</code>. Pass
+ * \ref igraph_landmark_heuristic() as the heuristic and the index as the
+ * \c extra argument of \ref igraph_get_shortest_path_astar() to use these
+ * bounds. The heuristic is admissible, so A* returns exact shortest paths,
+ * while it typically explores only a small part of the graph around the
+ * shortest path. It is consistent between vertices whose distances to and
+ * from every landmark are finite. When some of these distances are
+ * infinite, e.g. for vertices that cannot reach the target, the bound may
+ * also be infinite, and the heuristic is not consistent. A* then may have
+ * to process some vertices more than once, but the result is still
+ * exact.
+ *
+ * </para><para>
+ * Landmarks are selected by farthest-point sampling: the first one is a
+ * vertex of largest degree, and each further landmark is the vertex that
+ * is farthest from all landmarks selected so far, preferring vertices
+ * which cannot be reached from any of them. This places landmarks at the
+ * periphery of the graph, where they give the best bounds, and gives each
+ * component at least one landmark as long as there are enough of them.
+ *
+ * </para><para>
+ * The index is only valid for the graph, weights and mode it was created
+ * with. It needs to be destroyed with \ref igraph_landmark_index_destroy()
+ * when it is not needed any more.
+ *
+ * \param index Pointer to an uninitialized landmark index.
+ * \param graph The input graph, it can be directed or undirected.
+ * \param weights Optional edge weights. Supply \c NULL for unweighted graphs.
+ *        All edge weights must be non-negative. Additionally, no
+ *        edge weight may be NaN. If either case does not hold, an error
+ *        is returned. Edges with positive infinite weights are ignored.
+ * \param mode The \c mode that will be used in the A* searches. It is
+ *        ignored for undirected graphs.
+ * \param no_of_landmarks The number of landmarks to select. If it is larger
+ *        than the number of vertices, all vertices are used. More landmarks
+ *        give tighter bounds at the cost of memory, which is proportional
+ *        to the number of landmarks times the number of vertices. A few
+ *        dozen landmarks are usually sufficient.
+ * \return Error code.
+ *
+ * Time complexity: O(k (|E|log|V|+|V|)), where k is the number of
+ * landmarks, |V| is the number of vertices and |E| is the number of
+ * edges in the graph.
+ *
+ * \sa \ref igraph_get_shortest_path_bidirectional() for point-to-point
+ * searches without preprocessing.
+ */
+
+igraph_error_t igraph_landmark_index_init(igraph_landmark_index_t *index, const igraph_t *graph,
+                                          const igraph_vector_t *weights, igraph_neimode_t mode,
+                                          igraph_integer_t no_of_landmarks) {
+
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_vector_t mindist;
+    igraph_vector_int_t degree;
+    igraph_matrix_t buffer;
+    igraph_workspace_t ws;
+    igraph_integer_t next = -1;
+
+    if (no_of_landmarks < 0) {
+        IGRAPH_ERRORF("Number of landmarks must not be negative, got %" IGRAPH_PRId ".",
+                      IGRAPH_EINVAL, no_of_landmarks);
+    }
+    if (no_of_landmarks > no_of_nodes) {
+        no_of_landmarks = no_of_nodes;
+    }
+
+    if (!igraph_is_directed(graph)) {
+        mode = IGRAPH_ALL;
+    }
+    if (mode != IGRAPH_OUT && mode != IGRAPH_IN && mode != IGRAPH_ALL) {
+        IGRAPH_ERROR("Invalid mode for landmark index.", IGRAPH_EINVMODE);
+    }
+    index->symmetric = (mode == IGRAPH_ALL);
+
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&index->landmarks, no_of_landmarks);
+    IGRAPH_MATRIX_INIT_FINALLY(&index->from_landmarks, no_of_landmarks, no_of_nodes);
+    IGRAPH_MATRIX_INIT_FINALLY(&index->to_landmarks,
+                               index->symmetric ? 0 : no_of_landmarks,
+                               index->symmetric ? 0 : no_of_nodes);
+
+    IGRAPH_VECTOR_INIT_FINALLY(&mindist, no_of_nodes);
+    igraph_vector_fill(&mindist, IGRAPH_INFINITY);
+    IGRAPH_MATRIX_INIT_FINALLY(&buffer, 0, 0);
+    IGRAPH_CHECK(igraph_workspace_init(&ws));
+    IGRAPH_FINALLY(igraph_workspace_destroy, &ws);
+
+    if (no_of_landmarks > 0) {
+        IGRAPH_VECTOR_INT_INIT_FINALLY(&degree, 0);
+        IGRAPH_CHECK(igraph_degree(graph, &degree, igraph_vss_all(), IGRAPH_ALL, IGRAPH_LOOPS));
+        next = igraph_vector_int_which_max(&degree);
+        igraph_vector_int_destroy(&degree);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
+
+    for (igraph_integer_t i = 0; i < no_of_landmarks; i++) {
+        IGRAPH_ALLOW_INTERRUPTION();
+
+        VECTOR(index->landmarks)[i] = next;
+        IGRAPH_CHECK(igraph_i_landmark_distances(graph, weights, mode, next, i,
+                                                 &index->from_landmarks, &buffer, &ws));
+        if (!index->symmetric) {
+            IGRAPH_CHECK(igraph_i_landmark_distances(graph, weights, IGRAPH_REVERSE_MODE(mode), next, i,
+                                                     &index->to_landmarks, &buffer, &ws));
+        }
+
+        /* The next landmark is the vertex farthest from all landmarks so
+         * far. Unreachable vertices count as infinitely far, and landmarks
+         * are marked with a negative distance so that they are not chosen
+         * again, even when zero-weight edges make other vertices coincide
+         * with them. */
+        VECTOR(mindist)[next] = -1;
+        next = -1;
+        for (igraph_integer_t v = 0; v < no_of_nodes; v++) {
+            igraph_real_t d = MATRIX(index->from_landmarks, i, v);
+            if (d < VECTOR(mindist)[v]) {
+                VECTOR(mindist)[v] = d;
+            }
+            if (VECTOR(mindist)[v] >= 0 && (next < 0 || VECTOR(mindist)[v] > VECTOR(mindist)[next])) {
+                next = v;
+            }
+        }
+    }
+
+    igraph_workspace_destroy(&ws);
+    igraph_matrix_destroy(&buffer);
+    igraph_vector_destroy(&mindist);
+    IGRAPH_FINALLY_CLEAN(6);
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_landmark_index_destroy
+ * \brief Frees the memory used by a landmark index.
+ *
+ * \experimental
+ *
+ * \param index The landmark index to destroy.
+ *
+ * Time complexity: operating system dependent.
+ */
+
+void igraph_landmark_index_destroy(igraph_landmark_index_t *index) {
+    igraph_matrix_destroy(&index->to_landmarks);
+    igraph_matrix_destroy(&index->from_landmarks);
+    igraph_vector_int_destroy(&index->landmarks);
+}
+
+/**
+ * \function igraph_landmark_index_landmarks
+ * \brief The landmarks selected by a landmark index.
+ *
+ * \experimental
+ *
+ * \param index The landmark index.
+ * \param landmarks An initialized vector, the IDs of the landmarks
+ *        are stored here, in the order in which they were selected.
+ * \return Error code.
+ *
+ * Time complexity: O(k), the number of landmarks.
+ */
+
+igraph_error_t igraph_landmark_index_landmarks(const igraph_landmark_index_t *index,
+                                               igraph_vector_int_t *landmarks) {
+    IGRAPH_CHECK(igraph_vector_int_update(landmarks, &index->landmarks));
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_landmark_heuristic
+ * \brief A* heuristic based on a landmark index.
+ *
+ * \experimental
+ *
+ * This function has the signature of \ref igraph_astar_heuristic_func_t.
+ * Pass it as the \c heuristic argument of
+ * \ref igraph_get_shortest_path_astar(), together with a pointer to an
+ * \ref igraph_landmark_index_t as the \c extra argument. The index must
+ * have been created for the same graph, weights and mode as used in the
+ * search. The returned estimate is the largest lower bound on the distance
+ * that the triangle inequality gives for any of the landmarks. It is
+ * infinite when a landmark shows that \p to cannot be reached from
+ * \p from.
+ *
+ * \param result The distance estimate will be stored here.
+ * \param from The vertex ID of the candidate vertex.
+ * \param to The vertex ID of the target vertex.
+ * \param extra Pointer to the \ref igraph_landmark_index_t to use.
+ * \return Error code.
+ *
+ * Time complexity: O(k), the number of landmarks.
+ */
+
+igraph_error_t igraph_landmark_heuristic(igraph_real_t *result,
+                                         igraph_integer_t from, igraph_integer_t to,
+                                         void *extra) {
+
+    const igraph_landmark_index_t *index = (const igraph_landmark_index_t *) extra;
+    igraph_integer_t k = igraph_vector_int_size(&index->landmarks);
+    const igraph_matrix_t *F = &index->from_landmarks;
+    const igraph_matrix_t *T = &index->to_landmarks;
+    igraph_real_t bound = 0;
+
+    /* With d(l, .) the distances from landmark l and d(., l) those to it:
+     *   d(l, to) <= d(l, from) + d(from, to), and
+     *   d(from, l) <= d(from, to) + d(to, l).
+     * In the symmetric case both distances are the same. A landmark that
+     * reaches neither vertex gives inf - inf = NaN, which is skipped by
+     * the comparisons. */
+    for (igraph_integer_t l = 0; l < k; l++) {
+        igraph_real_t b1, b2;
+        if (index->symmetric) {
+            b1 = MATRIX(*F, l, to) - MATRIX(*F, l, from);
+            b2 = -b1;
+        } else {
+            b1 = MATRIX(*F, l, to) - MATRIX(*F, l, from);
+            b2 = MATRIX(*T, l, from) - MATRIX(*T, l, to);
+        }
+        if (b1 > bound) {
+            bound = b1;
+        }
+        if (b2 > bound) {
+            bound = b2;
+        }
+    }
+
+    *result = bound;
+
+    return IGRAPH_SUCCESS;
+}
@@ -0,0 +1,254 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "paths/bfs_engine.h"
+
+#include "math/safe_intop.h"
+
+/* Parameters of the heuristic for choosing the direction of a step, from
+ * Beamer, Asanovic and Patterson: Direction-optimizing breadth-first search.
+ * SC '12, https://doi.org/10.1109/SC.2012.50. The search switches to
+ * bottom-up steps when the frontier has more than 1/ALPHA of the edges of
+ * the unreached vertices, and back to top-down steps when the frontier has
+ * fewer than 1/BETA of all vertices. */
+#define IGRAPH_I_BFS_ALPHA 14
+#define IGRAPH_I_BFS_BETA 24
+
+igraph_error_t igraph_i_bfs_init(igraph_i_bfs_t *bfs, const igraph_csr_t *out, const igraph_csr_t *in) {
+    igraph_integer_t no_of_nodes = out->length;
+
+    bfs->out = out;
+    bfs->in = in;
+    bfs->no_of_arcs = VECTOR(out->offsets)[no_of_nodes];
+    bfs->reached = 0;
+
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&bfs->dist, no_of_nodes);
+    igraph_vector_int_fill(&bfs->dist, -1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&bfs->order, no_of_nodes);
+    IGRAPH_CHECK(igraph_bitset_init(&bfs->frontier, in ? no_of_nodes : 0));
+
+    IGRAPH_FINALLY_CLEAN(2);
+    return IGRAPH_SUCCESS;
+}
+
+void igraph_i_bfs_destroy(igraph_i_bfs_t *bfs) {
+    igraph_bitset_destroy(&bfs->frontier);
+    igraph_vector_int_destroy(&bfs->order);
+    igraph_vector_int_destroy(&bfs->dist);
+}
+
+/* Runs a search from 'source', reaching vertices up to distance 'cutoff',
+ * or all reachable vertices if 'cutoff' is negative. If 'targets' is not
+ * NULL, the search stops after the level in which the last of the
+ * 'no_of_targets' vertices in this set has been reached. The source itself
+ * counts as reached.
+ *
+ * Top-down steps visit the vertices in the same order as a queue-based
+ * search would, so when 'in' is NULL, 'order' is exactly the order of a
+ * standard breadth-first search. */
+igraph_error_t igraph_i_bfs_run(igraph_i_bfs_t *bfs, igraph_integer_t source, igraph_integer_t cutoff,
+                                const igraph_bitset_t *targets, igraph_integer_t no_of_targets) {
+    const igraph_csr_t *out = bfs->out, *in = bfs->in;
+    igraph_integer_t no_of_nodes = out->length;
+    igraph_integer_t *dist = VECTOR(bfs->dist), *order = VECTOR(bfs->order);
+    igraph_integer_t lo = 0, hi = 1, level = 0, found = 0;
+    igraph_integer_t frontier_arcs, unexplored_arcs;
+    igraph_bool_t bottom_up = false;
+
+    for (igraph_integer_t k = 0; k < bfs->reached; k++) {
+        dist[order[k]] = -1;
+    }
+
+    dist[source] = 0;
+    order[0] = source;
+    bfs->reached = 1;
+    if (targets && IGRAPH_BIT_TEST(*targets, source)) {
+        found++;
+    }
+
+    frontier_arcs = igraph_csr_degree(out, source);
+    unexplored_arcs = bfs->no_of_arcs - frontier_arcs;
+
+    while (lo < hi && (cutoff < 0 || level < cutoff) && (!targets || found < no_of_targets)) {
+        igraph_integer_t next_arcs = 0;
+        igraph_integer_t reached = bfs->reached;
+
+        if (in) {
+            if (!bottom_up && frontier_arcs > unexplored_arcs / IGRAPH_I_BFS_ALPHA) {
+                bottom_up = true;
+            } else if (bottom_up && hi - lo < no_of_nodes / IGRAPH_I_BFS_BETA) {
+                bottom_up = false;
+            }
+        }
+
+        if (bottom_up) {
+            for (igraph_integer_t k = lo; k < hi; k++) {
+                IGRAPH_BIT_SET(bfs->frontier, order[k]);
+            }
+            for (igraph_integer_t v = 0; v < no_of_nodes; v++) {
+                if (dist[v] >= 0) {
+                    continue;
+                }
+                const igraph_integer_t *neis = igraph_csr_neighbors(in, v);
+                igraph_integer_t n = igraph_csr_degree(in, v);
+                for (igraph_integer_t j = 0; j < n; j++) {
+                    if (IGRAPH_BIT_TEST(bfs->frontier, neis[j])) {
+                        dist[v] = level + 1;
+                        order[reached++] = v;
+                        next_arcs += igraph_csr_degree(out, v);
+                        if (targets && IGRAPH_BIT_TEST(*targets, v)) {
+                            found++;
+                        }
+                        break;
+                    }
+                }
+            }
+            for (igraph_integer_t k = lo; k < hi; k++) {
+                IGRAPH_BIT_CLEAR(bfs->frontier, order[k]);
+            }
+        } else {
+            for (igraph_integer_t k = lo; k < hi; k++) {
+                const igraph_integer_t *neis = igraph_csr_neighbors(out, order[k]);
+                igraph_integer_t n = igraph_csr_degree(out, order[k]);
+                for (igraph_integer_t j = 0; j < n; j++) {
+                    igraph_integer_t v = neis[j];
+                    if (dist[v] >= 0) {
+                        continue;
+                    }
+                    dist[v] = level + 1;
+                    order[reached++] = v;
+                    next_arcs += igraph_csr_degree(out, v);
+                    if (targets && IGRAPH_BIT_TEST(*targets, v)) {
+                        found++;
+                    }
+                }
+            }
+        }
+
+        bfs->reached = reached;
+        lo = hi;
+        hi = reached;
+        level++;
+        frontier_arcs = next_arcs;
+        unexplored_arcs -= next_arcs;
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+igraph_error_t igraph_i_msbfs_init(igraph_i_msbfs_t *ms, const igraph_csr_t *out) {
+    igraph_integer_t no_of_bits;
+
+    IGRAPH_SAFE_MULT(out->length, IGRAPH_INTEGER_SIZE, &no_of_bits);
+
+    ms->out = out;
+    ms->no_of_sources = 0;
+    ms->level = 0;
+    ms->count = 0;
+    ms->frontier_size = 0;
+
+    IGRAPH_BITSET_INIT_FINALLY(&ms->seen, no_of_bits);
+    IGRAPH_BITSET_INIT_FINALLY(&ms->visit, no_of_bits);
+    IGRAPH_BITSET_INIT_FINALLY(&ms->next, no_of_bits);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ms->frontier, out->length);
+    IGRAPH_CHECK(igraph_vector_int_init(&ms->touched, out->length));
+
+    IGRAPH_FINALLY_CLEAN(4);
+    return IGRAPH_SUCCESS;
+}
+
+void igraph_i_msbfs_destroy(igraph_i_msbfs_t *ms) {
+    igraph_vector_int_destroy(&ms->touched);
+    igraph_vector_int_destroy(&ms->frontier);
+    igraph_bitset_destroy(&ms->next);
+    igraph_bitset_destroy(&ms->visit);
+    igraph_bitset_destroy(&ms->seen);
+}
+
+/* Starts a search from each of the given sources, of which there may be at
+ * most IGRAPH_INTEGER_SIZE. A vertex may appear more than once. */
+void igraph_i_msbfs_start(igraph_i_msbfs_t *ms, const igraph_integer_t *sources,
+                          igraph_integer_t no_of_sources) {
+    igraph_integer_t *frontier = VECTOR(ms->frontier);
+
+    IGRAPH_ASSERT(no_of_sources <= IGRAPH_INTEGER_SIZE);
+
+    igraph_bitset_null(&ms->seen);
+    for (igraph_integer_t i = 0; i < ms->frontier_size; i++) {
+        VECTOR(ms->visit)[frontier[i]] = 0;
+    }
+    ms->frontier_size = 0;
+
+    for (igraph_integer_t k = 0; k < no_of_sources; k++) {
+        if (!VECTOR(ms->visit)[sources[k]]) {
+            frontier[ms->frontier_size++] = sources[k];
+        }
+        VECTOR(ms->seen)[sources[k]] |= IGRAPH_BIT_MASK(k);
+        VECTOR(ms->visit)[sources[k]] |= IGRAPH_BIT_MASK(k);
+    }
+
+    ms->no_of_sources = no_of_sources;
+    ms->level = 0;
+    ms->count = no_of_sources;
+}
+
+/* Advances all searches by one step. Returns the set of sources whose search
+ * reached new vertices; zero means that all searches are finished. */
+igraph_uint_t igraph_i_msbfs_step(igraph_i_msbfs_t *ms) {
+    const igraph_csr_t *out = ms->out;
+    igraph_uint_t *seen = VECTOR(ms->seen), *visit = VECTOR(ms->visit), *next = VECTOR(ms->next);
+    igraph_integer_t *frontier = VECTOR(ms->frontier), *touched = VECTOR(ms->touched);
+    igraph_integer_t frontier_size = ms->frontier_size, no_of_touched = 0;
+    igraph_uint_t active = 0;
+    igraph_integer_t count = 0;
+
+    for (igraph_integer_t i = 0; i < frontier_size; i++) {
+        igraph_integer_t v = frontier[i];
+        igraph_uint_t mask = visit[v];
+        const igraph_integer_t *neis = igraph_csr_neighbors(out, v);
+        igraph_integer_t n = igraph_csr_degree(out, v);
+        for (igraph_integer_t j = 0; j < n; j++) {
+            igraph_integer_t w = neis[j];
+            igraph_uint_t add = mask & ~seen[w];
+            if (add) {
+                if (!next[w]) {
+                    touched[no_of_touched++] = w;
+                }
+                next[w] |= add;
+            }
+        }
+        visit[v] = 0;
+    }
+
+    for (igraph_integer_t i = 0; i < no_of_touched; i++) {
+        igraph_integer_t w = touched[i];
+        igraph_uint_t mask = next[w];
+        next[w] = 0;
+        visit[w] = mask;
+        seen[w] |= mask;
+        active |= mask;
+        count += IGRAPH_POPCOUNT(mask);
+        frontier[i] = w;
+    }
+
+    ms->frontier_size = no_of_touched;
+    ms->level++;
+    ms->count = count;
+
+    return active;
+}
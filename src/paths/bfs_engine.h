@@ -0,0 +1,103 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IGRAPH_PATHS_BFS_ENGINE_H
+#define IGRAPH_PATHS_BFS_ENGINE_H
+
+#include "igraph_decls.h"
+#include "igraph_adjlist.h"
+#include "igraph_bitset.h"
+#include "igraph_vector.h"
+
+__BEGIN_DECLS
+
+/* Direction-optimizing breadth-first search for unweighted distances.
+ *
+ * Each level of the search is expanded either top-down, by scanning the
+ * neighbors of the vertices in the frontier, or bottom-up, by scanning the
+ * reverse neighbors of the unreached vertices until one of them is found in
+ * the frontier. Bottom-up steps inspect far fewer edges when the frontier
+ * is large, which is typical for the middle levels of a search in graphs
+ * with a small diameter.
+ *
+ * The object can be reused for searches from several sources; each search
+ * only resets the vertices reached by the previous one. */
+typedef struct {
+    const igraph_csr_t *out;    /* neighbors in the direction of the search */
+    const igraph_csr_t *in;     /* reverse neighbors, NULL to search top-down only */
+    igraph_integer_t no_of_arcs;
+    igraph_vector_int_t dist;   /* distance from the source, -1 if not reached */
+    igraph_vector_int_t order;  /* the reached vertices, level by level */
+    igraph_integer_t reached;   /* the number of reached vertices */
+    igraph_bitset_t frontier;   /* used by bottom-up steps */
+} igraph_i_bfs_t;
+
+igraph_error_t igraph_i_bfs_init(igraph_i_bfs_t *bfs, const igraph_csr_t *out, const igraph_csr_t *in);
+void igraph_i_bfs_destroy(igraph_i_bfs_t *bfs);
+
+igraph_error_t igraph_i_bfs_run(igraph_i_bfs_t *bfs, igraph_integer_t source, igraph_integer_t cutoff,
+                                const igraph_bitset_t *targets, igraph_integer_t no_of_targets);
+
+/* Distance of the farthest reached vertex. */
+#define IGRAPH_I_BFS_DEPTH(bfs) \
+    (VECTOR((bfs)->dist)[VECTOR((bfs)->order)[(bfs)->reached - 1]])
+
+/* Multi-source breadth-first search, running one search from each of up to
+ * IGRAPH_INTEGER_SIZE sources at the same time. Each vertex has one word in
+ * each of the bitsets below, with bit k of the word belonging to the k-th
+ * source. A single scan of the neighbors of a vertex advances all searches
+ * that reached it in the same step, and the searches from nearby sources
+ * share most of these scans.
+ *
+ * See Then et al.: The more the merrier: Efficient multi-source graph
+ * traversal. Proc. VLDB Endow. 8(4), 2014, https://doi.org/10.14778/2735496.2735507
+ *
+ * After igraph_i_msbfs_start(), 'visit' contains the sources themselves.
+ * Each call to igraph_i_msbfs_step() then sets 'visit' to the vertices first
+ * reached at the next distance, 'level', by each search, and 'count' to the
+ * number of such (source, vertex) pairs. The vertices whose word in 'visit'
+ * is not zero are listed in the first 'frontier_size' elements of
+ * 'frontier', so that a step only costs as much as the frontier and its
+ * incident edges. */
+typedef struct {
+    const igraph_csr_t *out;
+    igraph_integer_t no_of_sources;
+    igraph_integer_t level;
+    igraph_integer_t count;
+    igraph_bitset_t seen;
+    igraph_bitset_t visit;
+    igraph_bitset_t next;
+    igraph_vector_int_t frontier;
+    igraph_integer_t frontier_size;
+    igraph_vector_int_t touched;    /* vertices whose word in 'next' is not zero */
+} igraph_i_msbfs_t;
+
+/* The number of sources for which a multi-source search is preferred to
+ * separate searches. */
+#define IGRAPH_I_MSBFS_MIN_SOURCES (IGRAPH_INTEGER_SIZE / 4)
+
+igraph_error_t igraph_i_msbfs_init(igraph_i_msbfs_t *ms, const igraph_csr_t *out);
+void igraph_i_msbfs_destroy(igraph_i_msbfs_t *ms);
+
+void igraph_i_msbfs_start(igraph_i_msbfs_t *ms, const igraph_integer_t *sources,
+                          igraph_integer_t no_of_sources);
+igraph_uint_t igraph_i_msbfs_step(igraph_i_msbfs_t *ms);
+
+__END_DECLS
+
+#endif
@@ -0,0 +1,882 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "igraph_paths.h"
+
+#include "igraph_interface.h"
+#include "igraph_memory.h"
+#include "igraph_qsort.h"
+
+#include "core/indheap.h"
+#include "core/interruption.h"
+
+#include <math.h>
+
+/* Witness searches give up after settling this many vertices. A failed
+ * search only results in an unnecessary shortcut, never in a wrong
+ * distance. Searches that only estimate the number of shortcuts for the
+ * contraction order use a much smaller limit, as they are run far more
+ * often. */
+#define IGRAPH_I_CH_WITNESS_LIMIT 500
+#define IGRAPH_I_CH_SIMULATION_LIMIT 10
+
+/* The hierarchy consists of arcs, which are either edges of the original
+ * graph, oriented in the direction given by 'mode', or shortcuts that
+ * stand for two consecutive arcs. Each arc leads from a lower to a higher
+ * ranked vertex or the other way round; the forward search of a query
+ * uses upward arcs from the source, and the backward search uses downward
+ * arcs, in reverse, from the target. */
+typedef struct {
+    igraph_vector_int_t tail;
+    igraph_vector_int_t head;
+    igraph_vector_t weight;
+    igraph_vector_int_t edge;    /* original edge ID, or -1 for shortcuts */
+    igraph_vector_int_t first;   /* for shortcuts, the arc tail -> middle */
+    igraph_vector_int_t second;  /* for shortcuts, the arc middle -> head */
+
+    /* Upward arcs by tail, and downward arcs by head. */
+    igraph_vector_int_t up_offsets, up_arcs;
+    igraph_vector_int_t down_offsets, down_arcs;
+
+    /* Query state. Distances are infinite and parents are -1, except for
+     * the vertices in 'touched', which are reset by the next query. */
+    igraph_vector_t dist[2];
+    igraph_vector_int_t parent[2];
+    igraph_vector_int_t touched;
+    igraph_d_indheap_t heap;
+} igraph_i_ch_t;
+
+static void igraph_i_ch_destroy(igraph_i_ch_t *ch) {
+    igraph_d_indheap_destroy(&ch->heap);
+    igraph_vector_int_destroy(&ch->touched);
+    igraph_vector_int_destroy(&ch->parent[1]);
+    igraph_vector_int_destroy(&ch->parent[0]);
+    igraph_vector_destroy(&ch->dist[1]);
+    igraph_vector_destroy(&ch->dist[0]);
+    igraph_vector_int_destroy(&ch->down_arcs);
+    igraph_vector_int_destroy(&ch->down_offsets);
+    igraph_vector_int_destroy(&ch->up_arcs);
+    igraph_vector_int_destroy(&ch->up_offsets);
+    igraph_vector_int_destroy(&ch->second);
+    igraph_vector_int_destroy(&ch->first);
+    igraph_vector_int_destroy(&ch->edge);
+    igraph_vector_destroy(&ch->weight);
+    igraph_vector_int_destroy(&ch->head);
+    igraph_vector_int_destroy(&ch->tail);
+}
+
+static igraph_error_t igraph_i_ch_init(igraph_i_ch_t *ch, igraph_integer_t no_of_nodes) {
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->tail, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->head, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&ch->weight, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->edge, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->first, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->second, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->up_offsets, no_of_nodes + 1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->up_arcs, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->down_offsets, no_of_nodes + 1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->down_arcs, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&ch->dist[0], no_of_nodes);
+    igraph_vector_fill(&ch->dist[0], IGRAPH_INFINITY);
+    IGRAPH_VECTOR_INIT_FINALLY(&ch->dist[1], no_of_nodes);
+    igraph_vector_fill(&ch->dist[1], IGRAPH_INFINITY);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->parent[0], no_of_nodes);
+    igraph_vector_int_fill(&ch->parent[0], -1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->parent[1], no_of_nodes);
+    igraph_vector_int_fill(&ch->parent[1], -1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ch->touched, 0);
+    IGRAPH_CHECK(igraph_d_indheap_init(&ch->heap, 0));
+    IGRAPH_FINALLY_CLEAN(15);
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Appends an arc to the hierarchy and to the adjacency lists of the
+ * remaining graph. */
+static igraph_error_t igraph_i_ch_add_arc(
+        igraph_i_ch_t *ch, igraph_vector_int_list_t *out, igraph_vector_int_list_t *in,
+        igraph_integer_t tail, igraph_integer_t head, igraph_real_t weight,
+        igraph_integer_t edge, igraph_integer_t first, igraph_integer_t second) {
+
+    igraph_integer_t arc = igraph_vector_int_size(&ch->tail);
+
+    IGRAPH_CHECK(igraph_vector_int_push_back(&ch->tail, tail));
+    IGRAPH_CHECK(igraph_vector_int_push_back(&ch->head, head));
+    IGRAPH_CHECK(igraph_vector_push_back(&ch->weight, weight));
+    IGRAPH_CHECK(igraph_vector_int_push_back(&ch->edge, edge));
+    IGRAPH_CHECK(igraph_vector_int_push_back(&ch->first, first));
+    IGRAPH_CHECK(igraph_vector_int_push_back(&ch->second, second));
+    IGRAPH_CHECK(igraph_vector_int_push_back(igraph_vector_int_list_get_ptr(out, tail), arc));
+    IGRAPH_CHECK(igraph_vector_int_push_back(igraph_vector_int_list_get_ptr(in, head), arc));
+
+    return IGRAPH_SUCCESS;
+}
+
+typedef struct {
+    const igraph_vector_int_t *tail;
+    const igraph_vector_int_t *head;
+    const igraph_vector_t *weight;
+} igraph_i_ch_arc_cmp_data_t;
+
+static int igraph_i_ch_arc_cmp(void *extra, const void *a, const void *b) {
+    const igraph_i_ch_arc_cmp_data_t *data = (const igraph_i_ch_arc_cmp_data_t *) extra;
+    igraph_integer_t i = *(const igraph_integer_t *) a, j = *(const igraph_integer_t *) b;
+
+    if (VECTOR(*data->tail)[i] != VECTOR(*data->tail)[j]) {
+        return VECTOR(*data->tail)[i] < VECTOR(*data->tail)[j] ? -1 : 1;
+    }
+    if (VECTOR(*data->head)[i] != VECTOR(*data->head)[j]) {
+        return VECTOR(*data->head)[i] < VECTOR(*data->head)[j] ? -1 : 1;
+    }
+    if (VECTOR(*data->weight)[i] != VECTOR(*data->weight)[j]) {
+        return VECTOR(*data->weight)[i] < VECTOR(*data->weight)[j] ? -1 : 1;
+    }
+    return i < j ? -1 : (i > j ? 1 : 0);
+}
+
+/* Adds the edges of the graph as arcs, following 'mode'. Of several arcs
+ * between the same ordered pair of vertices, only the lightest one is kept.
+ * Loops and edges with infinite weight are never part of a shortest path,
+ * and are left out. */
+static igraph_error_t igraph_i_ch_add_edges(
+        igraph_i_ch_t *ch, igraph_vector_int_list_t *out, igraph_vector_int_list_t *in,
+        const igraph_t *graph, const igraph_vector_t *weights, igraph_neimode_t mode) {
+
+    igraph_integer_t no_of_edges = igraph_ecount(graph);
+    igraph_vector_int_t tails, heads, eids, order;
+    igraph_vector_t ws;
+    igraph_i_ch_arc_cmp_data_t data;
+    igraph_integer_t no_of_arcs;
+
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&tails, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&heads, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&eids, 0);
+    IGRAPH_VECTOR_INIT_FINALLY(&ws, 0);
+
+    for (igraph_integer_t e = 0; e < no_of_edges; e++) {
+        igraph_integer_t from = IGRAPH_FROM(graph, e), to = IGRAPH_TO(graph, e);
+        igraph_real_t w = weights ? VECTOR(*weights)[e] : 1;
+
+        if (from == to || w == IGRAPH_INFINITY) {
+            continue;
+        }
+        if (mode & IGRAPH_OUT) {
+            IGRAPH_CHECK(igraph_vector_int_push_back(&tails, from));
+            IGRAPH_CHECK(igraph_vector_int_push_back(&heads, to));
+            IGRAPH_CHECK(igraph_vector_int_push_back(&eids, e));
+            IGRAPH_CHECK(igraph_vector_push_back(&ws, w));
+        }
+        if (mode & IGRAPH_IN) {
+            IGRAPH_CHECK(igraph_vector_int_push_back(&tails, to));
+            IGRAPH_CHECK(igraph_vector_int_push_back(&heads, from));
+            IGRAPH_CHECK(igraph_vector_int_push_back(&eids, e));
+            IGRAPH_CHECK(igraph_vector_push_back(&ws, w));
+        }
+    }
+
+    no_of_arcs = igraph_vector_int_size(&tails);
+    IGRAPH_CHECK(igraph_vector_int_init_range(&order, 0, no_of_arcs));
+    IGRAPH_FINALLY(igraph_vector_int_destroy, &order);
+    data.tail = &tails;
+    data.head = &heads;
+    data.weight = &ws;
+    igraph_qsort_r(VECTOR(order), no_of_arcs, sizeof(igraph_integer_t), &data, igraph_i_ch_arc_cmp);
+
+    for (igraph_integer_t k = 0; k < no_of_arcs; k++) {
+        igraph_integer_t i = VECTOR(order)[k];
+        if (k > 0) {
+            igraph_integer_t prev = VECTOR(order)[k - 1];
+            if (VECTOR(tails)[i] == VECTOR(tails)[prev] && VECTOR(heads)[i] == VECTOR(heads)[prev]) {
+                continue;
+            }
+        }
+        IGRAPH_CHECK(igraph_i_ch_add_arc(ch, out, in, VECTOR(tails)[i], VECTOR(heads)[i], VECTOR(ws)[i],
+                                         VECTOR(eids)[i], -1, -1));
+    }
+
+    igraph_vector_int_destroy(&order);
+    igraph_vector_destroy(&ws);
+    igraph_vector_int_destroy(&eids);
+    igraph_vector_int_destroy(&heads);
+    igraph_vector_int_destroy(&tails);
+    IGRAPH_FINALLY_CLEAN(5);
+
+    return IGRAPH_SUCCESS;
+}
+
+typedef struct {
+    igraph_vector_t dist;
+    igraph_vector_int_t touched;
+    igraph_d_indheap_t heap;
+    igraph_vector_int_t target;  /* target[x] == v if x is a target when contracting v */
+} igraph_i_ch_witness_t;
+
+static void igraph_i_ch_witness_destroy(igraph_i_ch_witness_t *w) {
+    igraph_vector_int_destroy(&w->target);
+    igraph_d_indheap_destroy(&w->heap);
+    igraph_vector_int_destroy(&w->touched);
+    igraph_vector_destroy(&w->dist);
+}
+
+static igraph_error_t igraph_i_ch_witness_init(igraph_i_ch_witness_t *w, igraph_integer_t no_of_nodes) {
+    IGRAPH_VECTOR_INIT_FINALLY(&w->dist, no_of_nodes);
+    igraph_vector_fill(&w->dist, IGRAPH_INFINITY);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&w->touched, 0);
+    IGRAPH_CHECK(igraph_d_indheap_init(&w->heap, 0));
+    IGRAPH_FINALLY(igraph_d_indheap_destroy, &w->heap);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&w->target, no_of_nodes);
+    igraph_vector_int_fill(&w->target, -1);
+    IGRAPH_FINALLY_CLEAN(4);
+    return IGRAPH_SUCCESS;
+}
+
+/* Dijkstra's algorithm from 'source' in the remaining graph without 'avoid',
+ * up to distance 'limit', or until the 'no_of_targets' targets of contracting
+ * 'avoid' or 'max_settled' vertices are settled. Afterwards, w->dist holds upper bounds on the
+ * distances of the vertices from 'source' that do not use 'avoid'. */
+static igraph_error_t igraph_i_ch_witness_search(
+        const igraph_i_ch_t *ch, igraph_vector_int_list_t *out, igraph_i_ch_witness_t *w,
+        igraph_integer_t source, igraph_integer_t avoid, igraph_real_t limit,
+        igraph_integer_t no_of_targets, igraph_integer_t max_settled) {
+
+    igraph_integer_t no_of_touched = igraph_vector_int_size(&w->touched);
+    igraph_integer_t settled = 0;
+
+    for (igraph_integer_t i = 0; i < no_of_touched; i++) {
+        VECTOR(w->dist)[VECTOR(w->touched)[i]] = IGRAPH_INFINITY;
+    }
+    igraph_vector_int_clear(&w->touched);
+    igraph_d_indheap_clear(&w->heap);
+
+    VECTOR(w->dist)[source] = 0;
+    IGRAPH_CHECK(igraph_vector_int_push_back(&w->touched, source));
+    IGRAPH_CHECK(igraph_d_indheap_push(&w->heap, -0.0, source, 0));
+
+    while (!igraph_d_indheap_empty(&w->heap)) {
+        igraph_integer_t u, dummy, nlen;
+        igraph_real_t d = -igraph_d_indheap_max(&w->heap);
+        igraph_vector_int_t *arcs;
+
+        igraph_d_indheap_max_index(&w->heap, &u, &dummy);
+        igraph_d_indheap_delete_max(&w->heap);
+        if (d > VECTOR(w->dist)[u]) {
+            continue; /* outdated heap entry */
+        }
+        if (d > limit || settled >= max_settled) {
+            break;
+        }
+        settled++;
+        if (VECTOR(w->target)[u] == avoid && --no_of_targets == 0) {
+            break;
+        }
+
+        arcs = igraph_vector_int_list_get_ptr(out, u);
+        nlen = igraph_vector_int_size(arcs);
+        for (igraph_integer_t i = 0; i < nlen; i++) {
+            igraph_integer_t arc = VECTOR(*arcs)[i];
+            igraph_integer_t v = VECTOR(ch->head)[arc];
+            igraph_real_t altdist = d + VECTOR(ch->weight)[arc];
+            if (v == avoid || altdist >= VECTOR(w->dist)[v]) {
+                continue;
+            }
+            if (VECTOR(w->dist)[v] == IGRAPH_INFINITY) {
+                IGRAPH_CHECK(igraph_vector_int_push_back(&w->touched, v));
+            }
+            VECTOR(w->dist)[v] = altdist;
+            IGRAPH_CHECK(igraph_d_indheap_push(&w->heap, -altdist, v, 0));
+        }
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Adds a shortcut tail -> head through the arcs 'first' and 'second', or
+ * shortens an existing arc between the same vertices. */
+static igraph_error_t igraph_i_ch_add_shortcut(
+        igraph_i_ch_t *ch, igraph_vector_int_list_t *out, igraph_vector_int_list_t *in,
+        igraph_integer_t tail, igraph_integer_t head, igraph_real_t weight,
+        igraph_integer_t first, igraph_integer_t second) {
+
+    igraph_vector_int_t *arcs = igraph_vector_int_list_get_ptr(out, tail);
+    igraph_integer_t nlen = igraph_vector_int_size(arcs);
+
+    for (igraph_integer_t i = 0; i < nlen; i++) {
+        igraph_integer_t arc = VECTOR(*arcs)[i];
+        if (VECTOR(ch->head)[arc] == head) {
+            if (weight < VECTOR(ch->weight)[arc]) {
+                VECTOR(ch->weight)[arc] = weight;
+                VECTOR(ch->edge)[arc] = -1;
+                VECTOR(ch->first)[arc] = first;
+                VECTOR(ch->second)[arc] = second;
+            }
+            return IGRAPH_SUCCESS;
+        }
+    }
+
+    return igraph_i_ch_add_arc(ch, out, in, tail, head, weight, -1, first, second);
+}
+
+/* Determines the shortcuts needed when contracting 'v': for each pair of
+ * arcs u -> v -> x, a shortcut u -> x is needed unless a witness search
+ * finds an at most as long path that avoids 'v'. With 'simulate', the
+ * shortcuts are only counted, otherwise they are added. */
+static igraph_error_t igraph_i_ch_contract(
+        igraph_i_ch_t *ch, igraph_vector_int_list_t *out, igraph_vector_int_list_t *in,
+        igraph_i_ch_witness_t *w, igraph_integer_t v, igraph_bool_t simulate,
+        igraph_integer_t *shortcuts) {
+
+    igraph_vector_int_t *in_arcs = igraph_vector_int_list_get_ptr(in, v);
+    igraph_vector_int_t *out_arcs = igraph_vector_int_list_get_ptr(out, v);
+    igraph_integer_t no_in = igraph_vector_int_size(in_arcs);
+    igraph_integer_t no_out = igraph_vector_int_size(out_arcs);
+    igraph_real_t max_out = 0;
+    igraph_integer_t no_of_targets = 0;
+
+    *shortcuts = 0;
+
+    if (no_out == 0) {
+        return IGRAPH_SUCCESS;
+    }
+
+    for (igraph_integer_t j = 0; j < no_out; j++) {
+        igraph_integer_t a2 = VECTOR(*out_arcs)[j];
+        if (VECTOR(ch->weight)[a2] > max_out) {
+            max_out = VECTOR(ch->weight)[a2];
+        }
+        VECTOR(w->target)[VECTOR(ch->head)[a2]] = v;
+        no_of_targets++;
+    }
+
+    for (igraph_integer_t i = 0; i < no_in; i++) {
+        igraph_integer_t a1 = VECTOR(*in_arcs)[i];
+        igraph_integer_t u = VECTOR(ch->tail)[a1];
+        igraph_real_t w1 = VECTOR(ch->weight)[a1];
+
+        IGRAPH_CHECK(igraph_i_ch_witness_search(
+                         ch, out, w, u, v, w1 + max_out,
+                         VECTOR(w->target)[u] == v ? no_of_targets - 1 : no_of_targets,
+                         simulate ? IGRAPH_I_CH_SIMULATION_LIMIT : IGRAPH_I_CH_WITNESS_LIMIT));
+
+        for (igraph_integer_t j = 0; j < no_out; j++) {
+            igraph_integer_t a2 = VECTOR(*out_arcs)[j];
+            igraph_integer_t x = VECTOR(ch->head)[a2];
+            igraph_real_t weight = w1 + VECTOR(ch->weight)[a2];
+
+            if (x == u || VECTOR(w->dist)[x] <= weight) {
+                continue;
+            }
+            (*shortcuts)++;
+            if (!simulate) {
+                IGRAPH_CHECK(igraph_i_ch_add_shortcut(ch, out, in, u, x, weight, a1, a2));
+            }
+        }
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/* The contraction order prefers vertices whose contraction adds few arcs
+ * compared to the number it removes (the edge difference). Counting the
+ * already contracted neighbours as well spreads the contractions evenly
+ * over the graph. */
+static igraph_error_t igraph_i_ch_priority(
+        igraph_i_ch_t *ch, igraph_vector_int_list_t *out, igraph_vector_int_list_t *in,
+        igraph_i_ch_witness_t *w, const igraph_vector_int_t *contracted_neighbors,
+        igraph_integer_t v, igraph_real_t *priority) {
+
+    igraph_integer_t shortcuts, removed;
+
+    IGRAPH_CHECK(igraph_i_ch_contract(ch, out, in, w, v, true, &shortcuts));
+    removed = igraph_vector_int_size(igraph_vector_int_list_get_ptr(in, v)) +
+              igraph_vector_int_size(igraph_vector_int_list_get_ptr(out, v));
+    *priority = shortcuts - removed + VECTOR(*contracted_neighbors)[v];
+
+    return IGRAPH_SUCCESS;
+}
+
+static void igraph_i_ch_remove_arc(igraph_vector_int_t *arcs, igraph_integer_t arc) {
+    igraph_integer_t nlen = igraph_vector_int_size(arcs);
+    for (igraph_integer_t i = 0; i < nlen; i++) {
+        if (VECTOR(*arcs)[i] == arc) {
+            VECTOR(*arcs)[i] = VECTOR(*arcs)[nlen - 1];
+            igraph_vector_int_pop_back(arcs);
+            return;
+        }
+    }
+}
+
+/* Sorts the arcs into upward arcs, indexed by tail, and downward arcs,
+ * indexed by head. */
+static igraph_error_t igraph_i_ch_finalize(igraph_i_ch_t *ch, const igraph_vector_int_t *rank) {
+    igraph_integer_t no_of_nodes = igraph_vector_int_size(rank);
+    igraph_integer_t no_of_arcs = igraph_vector_int_size(&ch->tail);
+    igraph_vector_int_t up_pos, down_pos;
+
+    igraph_vector_int_null(&ch->up_offsets);
+    igraph_vector_int_null(&ch->down_offsets);
+    for (igraph_integer_t a = 0; a < no_of_arcs; a++) {
+        igraph_integer_t tail = VECTOR(ch->tail)[a], head = VECTOR(ch->head)[a];
+        if (VECTOR(*rank)[tail] < VECTOR(*rank)[head]) {
+            VECTOR(ch->up_offsets)[tail + 1]++;
+        } else {
+            VECTOR(ch->down_offsets)[head + 1]++;
+        }
+    }
+    for (igraph_integer_t v = 0; v < no_of_nodes; v++) {
+        VECTOR(ch->up_offsets)[v + 1] += VECTOR(ch->up_offsets)[v];
+        VECTOR(ch->down_offsets)[v + 1] += VECTOR(ch->down_offsets)[v];
+    }
+
+    IGRAPH_CHECK(igraph_vector_int_resize(&ch->up_arcs, VECTOR(ch->up_offsets)[no_of_nodes]));
+    IGRAPH_CHECK(igraph_vector_int_resize(&ch->down_arcs, VECTOR(ch->down_offsets)[no_of_nodes]));
+    IGRAPH_CHECK(igraph_vector_int_init_copy(&up_pos, &ch->up_offsets));
+    IGRAPH_FINALLY(igraph_vector_int_destroy, &up_pos);
+    IGRAPH_CHECK(igraph_vector_int_init_copy(&down_pos, &ch->down_offsets));
+    IGRAPH_FINALLY(igraph_vector_int_destroy, &down_pos);
+
+    for (igraph_integer_t a = 0; a < no_of_arcs; a++) {
+        igraph_integer_t tail = VECTOR(ch->tail)[a], head = VECTOR(ch->head)[a];
+        if (VECTOR(*rank)[tail] < VECTOR(*rank)[head]) {
+            VECTOR(ch->up_arcs)[VECTOR(up_pos)[tail]++] = a;
+        } else {
+            VECTOR(ch->down_arcs)[VECTOR(down_pos)[head]++] = a;
+        }
+    }
+
+    igraph_vector_int_destroy(&down_pos);
+    igraph_vector_int_destroy(&up_pos);
+    IGRAPH_FINALLY_CLEAN(2);
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_ch_index_build
+ * \brief Builds a contraction hierarchy for fast shortest path queries.
+ *
+ * \experimental
+ *
+ * A contraction hierarchy orders the vertices by importance, and
+ * contracts them one by one from the least important one: a vertex is
+ * removed from the graph, and shortcut edges are added between its
+ * neighbours wherever the removal would make their distance longer. A
+ * shortest path query then runs a bidirectional Dijkstra search that only
+ * moves towards more important vertices, which explores a tiny part of
+ * the graph. Shortcuts are unpacked to the edges they stand for when the
+ * path itself is requested. See Geisberger, Sanders, Schultes and Delling:
+ * Contraction Hierarchies: Faster and Simpler Hierarchical Routing in Road
+ * Networks, WEA 2008, https://doi.org/10.1007/978-3-540-68552-4_24.
+ *
+ * </para><para>
+ * Query the index with \ref igraph_ch_index_distance() and
+ * \ref igraph_ch_index_get_path(). The results are the same as those of
+ * \ref igraph_distances_dijkstra() and
+ * \ref igraph_get_shortest_path_dijkstra(), up to the choice among
+ * several shortest paths and to rounding errors in the sums of weights.
+ *
+ * </para><para>
+ * Contraction hierarchies work best on road networks and similar graphs
+ * with a low highway dimension. On graphs with many high degree vertices,
+ * such as social networks, the build may add a very large number of
+ * shortcuts and take a long time.
+ *
+ * </para><para>
+ * The index does not refer to the graph or the weight vector after this
+ * call. It needs to be destroyed with \ref igraph_ch_index_destroy() when
+ * it is not needed any more.
+ *
+ * \param index Pointer to an uninitialized contraction hierarchy.
+ * \param graph The input graph, it can be directed or undirected.
+ * \param weights Optional edge weights. Supply \c NULL for unweighted graphs.
+ *        All edge weights must be non-negative. Additionally, no
+ *        edge weight may be NaN. If either case does not hold, an error
+ *        is returned. Edges with positive infinite weights are ignored.
+ * \param mode A constant specifying how edge directions are
+ *        considered in directed graphs. \c IGRAPH_OUT follows edge
+ *        directions, \c IGRAPH_IN follows the opposite directions,
+ *        and \c IGRAPH_ALL ignores edge directions. This argument is
+ *        ignored for undirected graphs.
+ * \return Error code.
+ *
+ * Time complexity: depends on the structure of the graph. It is close to
+ * O(|E| log|V|) for road networks, where |V| is the number of vertices
+ * and |E| is the number of edges.
+ */
+
+igraph_error_t igraph_ch_index_build(igraph_ch_index_t *index, const igraph_t *graph,
+                                     const igraph_vector_t *weights, igraph_neimode_t mode) {
+
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t no_of_edges = igraph_ecount(graph);
+    igraph_i_ch_t *ch;
+    igraph_vector_int_list_t out, in;
+    igraph_i_ch_witness_t witness;
+    igraph_2wheap_t queue;
+    igraph_vector_int_t rank, contracted_neighbors, stamp;
+
+    if (!igraph_is_directed(graph)) {
+        mode = IGRAPH_ALL;
+    }
+    if (mode != IGRAPH_OUT && mode != IGRAPH_IN && mode != IGRAPH_ALL) {
+        IGRAPH_ERROR("Invalid mode for contraction hierarchy.", IGRAPH_EINVMODE);
+    }
+
+    if (weights) {
+        if (igraph_vector_size(weights) != no_of_edges) {
+            IGRAPH_ERRORF("Weight vector length (%" IGRAPH_PRId ") does not match number of edges (%" IGRAPH_PRId ").",
+                          IGRAPH_EINVAL, igraph_vector_size(weights), no_of_edges);
+        }
+        if (no_of_edges > 0) {
+            igraph_real_t min = igraph_vector_min(weights);
+            if (min < 0) {
+                IGRAPH_ERRORF("Weights must not be negative, got %g.", IGRAPH_EINVAL, min);
+            } else if (isnan(min)) {
+                IGRAPH_ERROR("Weights must not contain NaN values.", IGRAPH_EINVAL);
+            }
+        }
+    }
+
+    ch = IGRAPH_CALLOC(1, igraph_i_ch_t);
+    IGRAPH_CHECK_OOM(ch, "Insufficient memory for contraction hierarchy.");
+    IGRAPH_FINALLY(igraph_free, ch);
+    IGRAPH_CHECK(igraph_i_ch_init(ch, no_of_nodes));
+    IGRAPH_FINALLY(igraph_i_ch_destroy, ch);
+
+    IGRAPH_CHECK(igraph_vector_int_list_init(&out, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_int_list_destroy, &out);
+    IGRAPH_CHECK(igraph_vector_int_list_init(&in, no_of_nodes));
+    IGRAPH_FINALLY(igraph_vector_int_list_destroy, &in);
+    IGRAPH_CHECK(igraph_i_ch_witness_init(&witness, no_of_nodes));
+    IGRAPH_FINALLY(igraph_i_ch_witness_destroy, &witness);
+    IGRAPH_CHECK(igraph_2wheap_init(&queue, no_of_nodes));
+    IGRAPH_FINALLY(igraph_2wheap_destroy, &queue);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&rank, no_of_nodes);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&contracted_neighbors, no_of_nodes);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&stamp, no_of_nodes);
+    igraph_vector_int_fill(&stamp, -1);
+
+    IGRAPH_CHECK(igraph_i_ch_add_edges(ch, &out, &in, graph, weights, mode));
+
+    for (igraph_integer_t v = 0; v < no_of_nodes; v++) {
+        igraph_real_t priority;
+        IGRAPH_ALLOW_INTERRUPTION();
+        IGRAPH_CHECK(igraph_i_ch_priority(ch, &out, &in, &witness, &contracted_neighbors, v, &priority));
+        IGRAPH_CHECK(igraph_2wheap_push_with_index(&queue, v, -priority));
+    }
+
+    for (igraph_integer_t order = 0; order < no_of_nodes; ) {
+        igraph_integer_t v, shortcuts;
+        igraph_real_t priority;
+        igraph_vector_int_t *in_arcs, *out_arcs;
+        igraph_integer_t no_in, no_out;
+
+        IGRAPH_ALLOW_INTERRUPTION();
+
+        /* Priorities in the queue may be outdated. The vertex is only
+         * contracted if its current priority is still the smallest. */
+        igraph_2wheap_delete_max_index(&queue, &v);
+        IGRAPH_CHECK(igraph_i_ch_priority(ch, &out, &in, &witness, &contracted_neighbors, v, &priority));
+        if (!igraph_2wheap_empty(&queue) && priority > -igraph_2wheap_max(&queue)) {
+            IGRAPH_CHECK(igraph_2wheap_push_with_index(&queue, v, -priority));
+            continue;
+        }
+
+        IGRAPH_CHECK(igraph_i_ch_contract(ch, &out, &in, &witness, v, false, &shortcuts));
+        VECTOR(rank)[v] = order++;
+
+        /* Remove 'v' from the remaining graph, then update the priorities
+         * of its neighbours. */
+        in_arcs = igraph_vector_int_list_get_ptr(&in, v);
+        out_arcs = igraph_vector_int_list_get_ptr(&out, v);
+        no_in = igraph_vector_int_size(in_arcs);
+        no_out = igraph_vector_int_size(out_arcs);
+        for (igraph_integer_t i = 0; i < no_in; i++) {
+            igraph_integer_t arc = VECTOR(*in_arcs)[i];
+            igraph_i_ch_remove_arc(igraph_vector_int_list_get_ptr(&out, VECTOR(ch->tail)[arc]), arc);
+        }
+        for (igraph_integer_t i = 0; i < no_out; i++) {
+            igraph_integer_t arc = VECTOR(*out_arcs)[i];
+            igraph_i_ch_remove_arc(igraph_vector_int_list_get_ptr(&in, VECTOR(ch->head)[arc]), arc);
+        }
+        for (igraph_integer_t i = 0; i < no_in + no_out; i++) {
+            igraph_integer_t u = i < no_in ?
+                                 VECTOR(ch->tail)[VECTOR(*in_arcs)[i]] :
+                                 VECTOR(ch->head)[VECTOR(*out_arcs)[i - no_in]];
+            if (VECTOR(stamp)[u] == v) {
+                continue;
+            }
+            VECTOR(stamp)[u] = v;
+            VECTOR(contracted_neighbors)[u]++;
+            IGRAPH_CHECK(igraph_i_ch_priority(ch, &out, &in, &witness, &contracted_neighbors, u, &priority));
+            igraph_2wheap_modify(&queue, u, -priority);
+        }
+        igraph_vector_int_clear(in_arcs);
+        igraph_vector_int_clear(out_arcs);
+    }
+
+    IGRAPH_CHECK(igraph_i_ch_finalize(ch, &rank));
+
+    igraph_vector_int_destroy(&stamp);
+    igraph_vector_int_destroy(&contracted_neighbors);
+    igraph_vector_int_destroy(&rank);
+    igraph_2wheap_destroy(&queue);
+    igraph_i_ch_witness_destroy(&witness);
+    igraph_vector_int_list_destroy(&in);
+    igraph_vector_int_list_destroy(&out);
+    IGRAPH_FINALLY_CLEAN(9);
+
+    index->no_of_nodes = no_of_nodes;
+    index->hierarchy = ch;
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_ch_index_destroy
+ * \brief Frees the memory used by a contraction hierarchy.
+ *
+ * \experimental
+ *
+ * \param index The contraction hierarchy to destroy.
+ *
+ * Time complexity: operating system dependent.
+ */
+
+void igraph_ch_index_destroy(igraph_ch_index_t *index) {
+    igraph_i_ch_t *ch = (igraph_i_ch_t *) index->hierarchy;
+    igraph_i_ch_destroy(ch);
+    IGRAPH_FREE(ch);
+    index->hierarchy = NULL;
+}
+
+/* Bidirectional search in the hierarchy. On return, 'best' is the distance
+ * and 'meet' a vertex on a shortest path, or -1 if there is no path. */
+static igraph_error_t igraph_i_ch_query(
+        igraph_ch_index_t *index, igraph_integer_t from, igraph_integer_t to,
+        igraph_real_t *best, igraph_integer_t *meet) {
+
+    igraph_i_ch_t *ch = (igraph_i_ch_t *) index->hierarchy;
+    igraph_integer_t no_of_touched = igraph_vector_int_size(&ch->touched);
+
+    if (from < 0 || from >= index->no_of_nodes) {
+        IGRAPH_ERROR("Starting vertex out of range.", IGRAPH_EINVVID);
+    }
+    if (to < 0 || to >= index->no_of_nodes) {
+        IGRAPH_ERROR("End vertex out of range.", IGRAPH_EINVVID);
+    }
+
+    for (igraph_integer_t i = 0; i < no_of_touched; i++) {
+        igraph_integer_t v = VECTOR(ch->touched)[i];
+        VECTOR(ch->dist[0])[v] = VECTOR(ch->dist[1])[v] = IGRAPH_INFINITY;
+        VECTOR(ch->parent[0])[v] = VECTOR(ch->parent[1])[v] = -1;
+    }
+    igraph_vector_int_clear(&ch->touched);
+    igraph_d_indheap_clear(&ch->heap);
+
+    VECTOR(ch->dist[0])[from] = 0;
+    VECTOR(ch->dist[1])[to] = 0;
+    IGRAPH_CHECK(igraph_vector_int_push_back(&ch->touched, from));
+    IGRAPH_CHECK(igraph_vector_int_push_back(&ch->touched, to));
+    IGRAPH_CHECK(igraph_d_indheap_push(&ch->heap, -0.0, from, 0));
+    IGRAPH_CHECK(igraph_d_indheap_push(&ch->heap, -0.0, to, 1));
+
+    *best = from == to ? 0 : IGRAPH_INFINITY;
+    *meet = from == to ? from : -1;
+
+    /* Both searches share one heap. Once its smallest key reaches the
+     * best distance found so far, neither side can improve it. */
+    while (!igraph_d_indheap_empty(&ch->heap)) {
+        igraph_integer_t u, side, start, end;
+        const igraph_vector_int_t *arcs;
+        igraph_real_t d = -igraph_d_indheap_max(&ch->heap);
+
+        if (d >= *best) {
+            break;
+        }
+        igraph_d_indheap_max_index(&ch->heap, &u, &side);
+        igraph_d_indheap_delete_max(&ch->heap);
+        if (d > VECTOR(ch->dist[side])[u]) {
+            continue; /* outdated heap entry */
+        }
+
+        if (side == 0) {
+            start = VECTOR(ch->up_offsets)[u];
+            end = VECTOR(ch->up_offsets)[u + 1];
+            arcs = &ch->up_arcs;
+        } else {
+            start = VECTOR(ch->down_offsets)[u];
+            end = VECTOR(ch->down_offsets)[u + 1];
+            arcs = &ch->down_arcs;
+        }
+        for (igraph_integer_t i = start; i < end; i++) {
+            igraph_integer_t arc = VECTOR(*arcs)[i];
+            igraph_integer_t v = side == 0 ? VECTOR(ch->head)[arc] : VECTOR(ch->tail)[arc];
+            igraph_real_t altdist = d + VECTOR(ch->weight)[arc];
+
+            if (altdist >= VECTOR(ch->dist[side])[v]) {
+                continue;
+            }
+            if (VECTOR(ch->dist[0])[v] == IGRAPH_INFINITY && VECTOR(ch->dist[1])[v] == IGRAPH_INFINITY) {
+                IGRAPH_CHECK(igraph_vector_int_push_back(&ch->touched, v));
+            }
+            VECTOR(ch->dist[side])[v] = altdist;
+            VECTOR(ch->parent[side])[v] = arc;
+            IGRAPH_CHECK(igraph_d_indheap_push(&ch->heap, -altdist, v, side));
+
+            if (altdist + VECTOR(ch->dist[1 - side])[v] < *best) {
+                *best = altdist + VECTOR(ch->dist[1 - side])[v];
+                *meet = v;
+            }
+        }
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_ch_index_distance
+ * \brief Length of a shortest path, using a contraction hierarchy.
+ *
+ * \experimental
+ *
+ * Since this function updates the query state stored in the index, it
+ * must not be called for the same index from multiple threads at the same
+ * time.
+ *
+ * \param index The contraction hierarchy, created with
+ *        \ref igraph_ch_index_build().
+ * \param res The length of a shortest path from \p from to \p to is stored
+ *        here. It is infinite if \p to cannot be reached from \p from.
+ * \param from The ID of the source vertex.
+ * \param to The ID of the target vertex.
+ * \return Error code.
+ *
+ * Time complexity: depends on the structure of the graph. It is usually
+ * proportional to the size of a small neighbourhood of the two vertices
+ * in the hierarchy, and independent of the size of the graph.
+ */
+
+igraph_error_t igraph_ch_index_distance(igraph_ch_index_t *index, igraph_real_t *res,
+                                        igraph_integer_t from, igraph_integer_t to) {
+    igraph_integer_t meet;
+    IGRAPH_CHECK(igraph_i_ch_query(index, from, to, res, &meet));
+    return IGRAPH_SUCCESS;
+}
+
+/**
+ * \function igraph_ch_index_get_path
+ * \brief A shortest path, using a contraction hierarchy.
+ *
+ * \experimental
+ *
+ * Finds a shortest path in the graph for which the hierarchy was built,
+ * in the same format as \ref igraph_get_shortest_path_dijkstra(). If more
+ * than one shortest path exists, an arbitrary one is returned.
+ *
+ * </para><para>
+ * Since this function updates the query state stored in the index, it
+ * must not be called for the same index from multiple threads at the same
+ * time.
+ *
+ * \param index The contraction hierarchy, created with
+ *        \ref igraph_ch_index_build().
+ * \param vertices Pointer to an initialized vector or a null
+ *        pointer. If not a null pointer, then the vertex IDs along
+ *        the path are stored here, including the source and target
+ *        vertices.
+ * \param edges Pointer to an initialized vector or a null
+ *        pointer. If not a null pointer, then the edge IDs along the
+ *        path are stored here.
+ * \param from The ID of the source vertex.
+ * \param to The ID of the target vertex.
+ * \return Error code.
+ *
+ * Time complexity: the time of the search, see
+ * \ref igraph_ch_index_distance(), plus O(l), the number of edges
+ * on the path.
+ */
+
+igraph_error_t igraph_ch_index_get_path(igraph_ch_index_t *index,
+                                        igraph_vector_int_t *vertices,
+                                        igraph_vector_int_t *edges,
+                                        igraph_integer_t from, igraph_integer_t to) {
+
+    igraph_i_ch_t *ch = (igraph_i_ch_t *) index->hierarchy;
+    igraph_vector_int_t arcs, stack;
+    igraph_real_t best;
+    igraph_integer_t meet, no_of_arcs;
+
+    IGRAPH_CHECK(igraph_i_ch_query(index, from, to, &best, &meet));
+
+    if (vertices) {
+        igraph_vector_int_clear(vertices);
+    }
+    if (edges) {
+        igraph_vector_int_clear(edges);
+    }
+
+    if (meet < 0) {
+        IGRAPH_WARNING("Couldn't reach the target vertex.");
+        return IGRAPH_SUCCESS;
+    }
+
+    if (vertices) {
+        IGRAPH_CHECK(igraph_vector_int_push_back(vertices, from));
+    }
+
+    /* Collect the arcs of the hierarchy along the path. */
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&arcs, 0);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&stack, 0);
+    for (igraph_integer_t v = meet; VECTOR(ch->parent[0])[v] >= 0; ) {
+        igraph_integer_t arc = VECTOR(ch->parent[0])[v];
+        IGRAPH_CHECK(igraph_vector_int_push_back(&arcs, arc));
+        v = VECTOR(ch->tail)[arc];
+    }
+    igraph_vector_int_reverse(&arcs);
+    for (igraph_integer_t v = meet; VECTOR(ch->parent[1])[v] >= 0; ) {
+        igraph_integer_t arc = VECTOR(ch->parent[1])[v];
+        IGRAPH_CHECK(igraph_vector_int_push_back(&arcs, arc));
+        v = VECTOR(ch->head)[arc];
+    }
+
+    /* Unpack the shortcuts, depth first. */
+    no_of_arcs = igraph_vector_int_size(&arcs);
+    for (igraph_integer_t i = 0; i < no_of_arcs; i++) {
+        IGRAPH_CHECK(igraph_vector_int_push_back(&stack, VECTOR(arcs)[i]));
+        while (!igraph_vector_int_empty(&stack)) {
+            igraph_integer_t arc = igraph_vector_int_pop_back(&stack);
+            if (VECTOR(ch->edge)[arc] < 0) {
+                IGRAPH_CHECK(igraph_vector_int_push_back(&stack, VECTOR(ch->second)[arc]));
+                IGRAPH_CHECK(igraph_vector_int_push_back(&stack, VECTOR(ch->first)[arc]));
+                continue;
+            }
+            if (vertices) {
+                IGRAPH_CHECK(igraph_vector_int_push_back(vertices, VECTOR(ch->head)[arc]));
+            }
+            if (edges) {
+                IGRAPH_CHECK(igraph_vector_int_push_back(edges, VECTOR(ch->edge)[arc]));
+            }
+        }
+    }
+
+    igraph_vector_int_destroy(&stack);
+    igraph_vector_int_destroy(&arcs);
+    IGRAPH_FINALLY_CLEAN(2);
+
+    return IGRAPH_SUCCESS;
+}
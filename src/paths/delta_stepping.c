@@ -0,0 +1,518 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include "paths/delta_stepping.h"
+
+#include "igraph_adjlist.h"
+#include "igraph_interface.h"
+#include "igraph_threading.h"
+#include "igraph_vector_list.h"
+
+#include "core/interruption.h"
+
+#include <math.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* The automatic bucket width is never so small that more than this many
+ * buckets would be needed to cover the heaviest edge. */
+#define IGRAPH_I_DELTA_STEPPING_MAX_BUCKETS 4096
+
+/*
+ * Delta-stepping keeps the tentative distances in buckets of width delta.
+ * Buckets are processed in increasing order. Within a bucket, light edges,
+ * i.e. those not heavier than delta, are relaxed repeatedly until the
+ * bucket stays empty; heavy edges, which lead to later buckets, are relaxed
+ * only once, from the vertices that were removed from the bucket. All
+ * vertices of a bucket are processed at the same time, which is where the
+ * parallelism comes from.
+ *
+ * Vertex v is owned by part v % no_of_parts. Only the owner of a vertex
+ * writes its distance and its bucket entries. Relaxing an edge sends a
+ * request (vertex, distance) to the owner of the head, and each part then
+ * applies the requests sent to it, in the order of the sending parts.
+ * Distances are only written while requests are applied, and only read
+ * while requests are generated, so no atomic operations are needed, and the
+ * result does not depend on thread scheduling.
+ *
+ * A vertex is only in the bucket given by 'queued'. When its distance
+ * decreases, it is added to its new bucket, and the old entry is ignored
+ * when that bucket is processed. Since a tentative distance is never more
+ * than the heaviest edge beyond the current bucket, the buckets are stored
+ * in a cyclic array.
+ */
+
+typedef struct {
+    igraph_integer_t no_of_parts;
+    igraph_integer_t no_of_buckets;
+    igraph_integer_t current;       /* the bucket being processed */
+    igraph_real_t delta;
+
+    /* The arcs of vertex v are csr.neis[k] for csr.offsets[v] <= k < end[v],
+     * light ones before light_end[v], heavy ones after. Arcs with infinite
+     * weight are moved after end[v]. */
+    igraph_csr_t csr;
+    igraph_vector_t lengths;
+    igraph_vector_int_t light_end, end;
+
+    igraph_vector_t dist;
+    igraph_vector_int_t queued;     /* current bucket of each vertex, or -1 */
+    igraph_vector_int_t removed;    /* last bucket each vertex was removed from, or -1 */
+
+    /* One list per part, or per part and bucket, or per pair of parts. */
+    igraph_vector_int_list_t buckets;
+    igraph_vector_int_list_t frontier;
+    igraph_vector_int_list_t settled;
+    igraph_vector_int_list_t touched;
+    igraph_vector_int_list_t req_vertex;
+    igraph_vector_list_t req_dist;
+    igraph_vector_int_t errors;
+} igraph_i_delta_stepping_t;
+
+#define BUCKET(ds, part, bucket) \
+    igraph_vector_int_list_get_ptr(&(ds)->buckets, (part) * (ds)->no_of_buckets + (bucket) % (ds)->no_of_buckets)
+
+static void igraph_i_delta_stepping_destroy(igraph_i_delta_stepping_t *ds) {
+    igraph_vector_int_destroy(&ds->errors);
+    igraph_vector_list_destroy(&ds->req_dist);
+    igraph_vector_int_list_destroy(&ds->req_vertex);
+    igraph_vector_int_list_destroy(&ds->touched);
+    igraph_vector_int_list_destroy(&ds->settled);
+    igraph_vector_int_list_destroy(&ds->frontier);
+    igraph_vector_int_list_destroy(&ds->buckets);
+    igraph_vector_int_destroy(&ds->removed);
+    igraph_vector_int_destroy(&ds->queued);
+    igraph_vector_destroy(&ds->dist);
+    igraph_vector_int_destroy(&ds->end);
+    igraph_vector_int_destroy(&ds->light_end);
+    igraph_vector_destroy(&ds->lengths);
+    igraph_csr_destroy(&ds->csr);
+}
+
+static void igraph_i_delta_stepping_swap(igraph_integer_t *neis, igraph_integer_t *eids,
+                                         igraph_real_t *lengths, igraph_integer_t i, igraph_integer_t j) {
+    igraph_integer_t n = neis[i], e = eids[i];
+    igraph_real_t w = lengths[i];
+    neis[i] = neis[j]; eids[i] = eids[j]; lengths[i] = lengths[j];
+    neis[j] = n; eids[j] = e; lengths[j] = w;
+}
+
+/* Sorts the arcs of each vertex into light, heavy and infinite ones, and
+ * chooses the bucket width. */
+static igraph_error_t igraph_i_delta_stepping_arcs(
+        igraph_i_delta_stepping_t *ds, const igraph_t *graph,
+        const igraph_vector_t *weights, igraph_real_t delta) {
+
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t no_of_arcs = igraph_vector_int_size(&ds->csr.neis);
+    igraph_integer_t no_of_finite = 0;
+    igraph_real_t max = 0;
+    igraph_integer_t *neis = VECTOR(ds->csr.neis), *eids = VECTOR(ds->csr.eids);
+    igraph_real_t *lengths = VECTOR(ds->lengths);
+
+    for (igraph_integer_t k = 0; k < no_of_arcs; k++) {
+        igraph_real_t w = VECTOR(*weights)[eids[k]];
+        lengths[k] = w;
+        if (w != IGRAPH_INFINITY) {
+            no_of_finite++;
+            if (w > max) {
+                max = w;
+            }
+        }
+    }
+
+    /* With random weights, a width of about the heaviest weight divided by
+     * the average degree balances the work of repeated light relaxations
+     * against the number of buckets (Meyer and Sanders, 2003). */
+    if (delta <= 0) {
+        delta = no_of_finite > 0 ? max * no_of_nodes / no_of_finite : 0;
+    }
+    if (delta < max / IGRAPH_I_DELTA_STEPPING_MAX_BUCKETS) {
+        delta = max / IGRAPH_I_DELTA_STEPPING_MAX_BUCKETS;
+    }
+    /* Bucket indices of all finite distances must fit exactly. */
+    if (delta < max * (no_of_nodes - 1.0) / 4503599627370496.0 /* 2^52 */) {
+        delta = max * (no_of_nodes - 1.0) / 4503599627370496.0;
+    }
+    if (delta == 0) {
+        delta = 1;
+    }
+    ds->delta = delta;
+    ds->no_of_buckets = (igraph_integer_t) floor(max / delta) + 2;
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(static)
+#endif
+    for (igraph_integer_t v = 0; v < no_of_nodes; v++) {
+        igraph_integer_t lo = VECTOR(ds->csr.offsets)[v];
+        igraph_integer_t mid = lo;
+        igraph_integer_t hi = VECTOR(ds->csr.offsets)[v + 1];
+
+        /* Three-way partition: light arcs end up before 'lo', infinite
+         * ones from 'hi'. */
+        while (mid < hi) {
+            igraph_real_t w = lengths[mid];
+            if (w <= delta) {
+                igraph_i_delta_stepping_swap(neis, eids, lengths, lo++, mid++);
+            } else if (w == IGRAPH_INFINITY) {
+                igraph_i_delta_stepping_swap(neis, eids, lengths, mid, --hi);
+            } else {
+                mid++;
+            }
+        }
+        VECTOR(ds->light_end)[v] = lo;
+        VECTOR(ds->end)[v] = hi;
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+static igraph_error_t igraph_i_delta_stepping_init(
+        igraph_i_delta_stepping_t *ds, const igraph_t *graph,
+        const igraph_vector_t *weights, igraph_neimode_t mode,
+        igraph_real_t delta, igraph_integer_t no_of_parts) {
+
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+
+    ds->no_of_parts = no_of_parts;
+    ds->current = 0;
+
+    IGRAPH_CHECK(igraph_csr_init(graph, &ds->csr, mode, IGRAPH_NO_LOOPS, IGRAPH_MULTIPLE, true));
+    IGRAPH_FINALLY(igraph_csr_destroy, &ds->csr);
+    IGRAPH_VECTOR_INIT_FINALLY(&ds->lengths, igraph_vector_int_size(&ds->csr.neis));
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ds->light_end, no_of_nodes);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ds->end, no_of_nodes);
+    IGRAPH_CHECK(igraph_i_delta_stepping_arcs(ds, graph, weights, delta));
+
+    IGRAPH_VECTOR_INIT_FINALLY(&ds->dist, no_of_nodes);
+    igraph_vector_fill(&ds->dist, IGRAPH_INFINITY);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ds->queued, no_of_nodes);
+    igraph_vector_int_fill(&ds->queued, -1);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ds->removed, no_of_nodes);
+    igraph_vector_int_fill(&ds->removed, -1);
+
+    IGRAPH_CHECK(igraph_vector_int_list_init(&ds->buckets, no_of_parts * ds->no_of_buckets));
+    IGRAPH_FINALLY(igraph_vector_int_list_destroy, &ds->buckets);
+    IGRAPH_CHECK(igraph_vector_int_list_init(&ds->frontier, no_of_parts));
+    IGRAPH_FINALLY(igraph_vector_int_list_destroy, &ds->frontier);
+    IGRAPH_CHECK(igraph_vector_int_list_init(&ds->settled, no_of_parts));
+    IGRAPH_FINALLY(igraph_vector_int_list_destroy, &ds->settled);
+    IGRAPH_CHECK(igraph_vector_int_list_init(&ds->touched, no_of_parts));
+    IGRAPH_FINALLY(igraph_vector_int_list_destroy, &ds->touched);
+    IGRAPH_CHECK(igraph_vector_int_list_init(&ds->req_vertex, no_of_parts * no_of_parts));
+    IGRAPH_FINALLY(igraph_vector_int_list_destroy, &ds->req_vertex);
+    IGRAPH_CHECK(igraph_vector_list_init(&ds->req_dist, no_of_parts * no_of_parts));
+    IGRAPH_FINALLY(igraph_vector_list_destroy, &ds->req_dist);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&ds->errors, no_of_parts);
+
+    IGRAPH_FINALLY_CLEAN(14);
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Sends requests along the light or the heavy arcs of the given vertices,
+ * which are owned by 'part'. */
+static igraph_error_t igraph_i_delta_stepping_relax(
+        igraph_i_delta_stepping_t *ds, igraph_integer_t part,
+        const igraph_vector_int_t *vertices, igraph_bool_t light) {
+
+    igraph_integer_t no_of_parts = ds->no_of_parts;
+    igraph_integer_t n = igraph_vector_int_size(vertices);
+    const igraph_real_t *dist = VECTOR(ds->dist);
+
+    for (igraph_integer_t q = 0; q < no_of_parts; q++) {
+        igraph_vector_int_clear(igraph_vector_int_list_get_ptr(&ds->req_vertex, part * no_of_parts + q));
+        igraph_vector_clear(igraph_vector_list_get_ptr(&ds->req_dist, part * no_of_parts + q));
+    }
+
+    for (igraph_integer_t i = 0; i < n; i++) {
+        igraph_integer_t u = VECTOR(*vertices)[i];
+        igraph_integer_t begin = light ? VECTOR(ds->csr.offsets)[u] : VECTOR(ds->light_end)[u];
+        igraph_integer_t end = light ? VECTOR(ds->light_end)[u] : VECTOR(ds->end)[u];
+        igraph_real_t d = dist[u];
+
+        for (igraph_integer_t k = begin; k < end; k++) {
+            igraph_integer_t v = VECTOR(ds->csr.neis)[k];
+            igraph_real_t altdist = d + VECTOR(ds->lengths)[k];
+            igraph_integer_t q;
+
+            if (altdist >= dist[v]) {
+                continue;
+            }
+            q = part * no_of_parts + v % no_of_parts;
+            IGRAPH_CHECK(igraph_vector_int_push_back(igraph_vector_int_list_get_ptr(&ds->req_vertex, q), v));
+            IGRAPH_CHECK(igraph_vector_push_back(igraph_vector_list_get_ptr(&ds->req_dist, q), altdist));
+        }
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Moves the vertices of the current bucket to the frontier, and relaxes
+ * their light arcs. */
+static igraph_error_t igraph_i_delta_stepping_light(igraph_i_delta_stepping_t *ds, igraph_integer_t part) {
+    igraph_vector_int_t *bucket = BUCKET(ds, part, ds->current);
+    igraph_vector_int_t *frontier = igraph_vector_int_list_get_ptr(&ds->frontier, part);
+    igraph_vector_int_t *settled = igraph_vector_int_list_get_ptr(&ds->settled, part);
+    igraph_integer_t n = igraph_vector_int_size(bucket);
+
+    igraph_vector_int_clear(frontier);
+    for (igraph_integer_t i = 0; i < n; i++) {
+        igraph_integer_t v = VECTOR(*bucket)[i];
+        if (VECTOR(ds->queued)[v] != ds->current) {
+            continue; /* moved to an earlier bucket */
+        }
+        VECTOR(ds->queued)[v] = -1;
+        IGRAPH_CHECK(igraph_vector_int_push_back(frontier, v));
+        if (VECTOR(ds->removed)[v] != ds->current) {
+            VECTOR(ds->removed)[v] = ds->current;
+            IGRAPH_CHECK(igraph_vector_int_push_back(settled, v));
+        }
+    }
+    igraph_vector_int_clear(bucket);
+
+    return igraph_i_delta_stepping_relax(ds, part, frontier, true);
+}
+
+/* Relaxes the heavy arcs of the vertices removed from the current bucket,
+ * once it stays empty. */
+static igraph_error_t igraph_i_delta_stepping_heavy(igraph_i_delta_stepping_t *ds, igraph_integer_t part) {
+    igraph_vector_int_t *settled = igraph_vector_int_list_get_ptr(&ds->settled, part);
+    IGRAPH_CHECK(igraph_i_delta_stepping_relax(ds, part, settled, false));
+    igraph_vector_int_clear(settled);
+    return IGRAPH_SUCCESS;
+}
+
+/* Applies the requests sent to 'part', in the order of the sending parts. */
+static igraph_error_t igraph_i_delta_stepping_apply(igraph_i_delta_stepping_t *ds, igraph_integer_t part) {
+    igraph_integer_t no_of_parts = ds->no_of_parts;
+    igraph_vector_int_t *touched = igraph_vector_int_list_get_ptr(&ds->touched, part);
+    igraph_real_t *dist = VECTOR(ds->dist);
+
+    for (igraph_integer_t q = 0; q < no_of_parts; q++) {
+        const igraph_vector_int_t *req_vertex = igraph_vector_int_list_get_ptr(&ds->req_vertex, q * no_of_parts + part);
+        const igraph_vector_t *req_dist = igraph_vector_list_get_ptr(&ds->req_dist, q * no_of_parts + part);
+        igraph_integer_t n = igraph_vector_int_size(req_vertex);
+
+        for (igraph_integer_t i = 0; i < n; i++) {
+            igraph_integer_t v = VECTOR(*req_vertex)[i];
+            igraph_real_t d = VECTOR(*req_dist)[i];
+            igraph_integer_t bucket;
+
+            if (d >= dist[v]) {
+                continue;
+            }
+            if (dist[v] == IGRAPH_INFINITY) {
+                IGRAPH_CHECK(igraph_vector_int_push_back(touched, v));
+            }
+            dist[v] = d;
+            bucket = (igraph_integer_t) floor(d / ds->delta);
+            if (VECTOR(ds->queued)[v] != bucket) {
+                VECTOR(ds->queued)[v] = bucket;
+                IGRAPH_CHECK(igraph_vector_int_push_back(BUCKET(ds, part, bucket), v));
+            }
+        }
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+typedef igraph_error_t igraph_i_delta_stepping_func_t(igraph_i_delta_stepping_t *ds, igraph_integer_t part);
+
+/* Calls 'func' for each part, in parallel when igraph is compiled with
+ * OpenMP and in thread-safe mode. Errors in the parts are re-raised by the
+ * calling thread. */
+static igraph_error_t igraph_i_delta_stepping_run(igraph_i_delta_stepping_t *ds,
+                                                  igraph_i_delta_stepping_func_t *func) {
+    igraph_integer_t no_of_parts = ds->no_of_parts;
+
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+#pragma omp parallel for schedule(dynamic, 1) if (no_of_parts > 1)
+#endif
+    for (igraph_integer_t part = 0; part < no_of_parts; part++) {
+        /* Errors are recorded and re-raised by the calling thread. The error
+         * handler and the finally stack are thread-local in thread-safe
+         * builds, otherwise the parts are processed one by one. */
+        igraph_error_handler_t *handler = igraph_set_error_handler(igraph_error_handler_ignore);
+        igraph_error_t err;
+
+        IGRAPH_FINALLY_ENTER();
+        err = func(ds, part);
+        if (err != IGRAPH_SUCCESS) {
+            IGRAPH_FINALLY_FREE();
+        }
+        IGRAPH_FINALLY_EXIT();
+        igraph_set_error_handler(handler);
+        VECTOR(ds->errors)[part] = err;
+    }
+
+    for (igraph_integer_t part = 0; part < no_of_parts; part++) {
+        if (VECTOR(ds->errors)[part] != IGRAPH_SUCCESS) {
+            IGRAPH_ERROR("Parallel shortest path calculation failed.", VECTOR(ds->errors)[part]);
+        }
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Finds the first non-empty bucket, starting from the current one. */
+static igraph_bool_t igraph_i_delta_stepping_next(igraph_i_delta_stepping_t *ds) {
+    for (igraph_integer_t b = ds->current; b < ds->current + ds->no_of_buckets; b++) {
+        for (igraph_integer_t part = 0; part < ds->no_of_parts; part++) {
+            if (!igraph_vector_int_empty(BUCKET(ds, part, b))) {
+                ds->current = b;
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+/* Computes the distances from 'source', up to 'cutoff' if it is not negative.
+ * Distances larger than the cutoff may be left finite. */
+static igraph_error_t igraph_i_delta_stepping_search(igraph_i_delta_stepping_t *ds,
+                                                     igraph_integer_t source, igraph_real_t cutoff) {
+    igraph_integer_t no_of_parts = ds->no_of_parts;
+
+    /* Reset the vertices reached by the previous search. */
+    for (igraph_integer_t part = 0; part < no_of_parts; part++) {
+        igraph_vector_int_t *touched = igraph_vector_int_list_get_ptr(&ds->touched, part);
+        igraph_integer_t n = igraph_vector_int_size(touched);
+        for (igraph_integer_t i = 0; i < n; i++) {
+            igraph_integer_t v = VECTOR(*touched)[i];
+            VECTOR(ds->dist)[v] = IGRAPH_INFINITY;
+            VECTOR(ds->queued)[v] = -1;
+            VECTOR(ds->removed)[v] = -1;
+        }
+        igraph_vector_int_clear(touched);
+    }
+    for (igraph_integer_t b = 0; b < no_of_parts * ds->no_of_buckets; b++) {
+        igraph_vector_int_clear(igraph_vector_int_list_get_ptr(&ds->buckets, b));
+    }
+
+    ds->current = 0;
+    VECTOR(ds->dist)[source] = 0;
+    VECTOR(ds->queued)[source] = 0;
+    IGRAPH_CHECK(igraph_vector_int_push_back(igraph_vector_int_list_get_ptr(&ds->touched, source % no_of_parts), source));
+    IGRAPH_CHECK(igraph_vector_int_push_back(BUCKET(ds, source % no_of_parts, 0), source));
+
+    while (igraph_i_delta_stepping_next(ds)) {
+        if (cutoff >= 0 && ds->current * ds->delta > cutoff) {
+            break;
+        }
+
+        for (;;) {
+            igraph_integer_t frontier_size = 0;
+            IGRAPH_CHECK(igraph_i_delta_stepping_run(ds, igraph_i_delta_stepping_light));
+            for (igraph_integer_t part = 0; part < no_of_parts; part++) {
+                frontier_size += igraph_vector_int_size(igraph_vector_int_list_get_ptr(&ds->frontier, part));
+            }
+            if (frontier_size == 0) {
+                break;
+            }
+            IGRAPH_CHECK(igraph_i_delta_stepping_run(ds, igraph_i_delta_stepping_apply));
+        }
+
+        IGRAPH_CHECK(igraph_i_delta_stepping_run(ds, igraph_i_delta_stepping_heavy));
+        IGRAPH_CHECK(igraph_i_delta_stepping_run(ds, igraph_i_delta_stepping_apply));
+
+        IGRAPH_ALLOW_INTERRUPTION();
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+igraph_error_t igraph_i_distances_delta_stepping(
+        const igraph_t *graph, igraph_matrix_t *res,
+        const igraph_vs_t from, const igraph_vs_t to,
+        const igraph_vector_t *weights, igraph_neimode_t mode,
+        igraph_real_t cutoff, igraph_real_t delta, igraph_integer_t no_of_parts) {
+
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_i_delta_stepping_t ds;
+    igraph_vit_t fromvit, tovit;
+    igraph_vector_int_t targets;
+    igraph_integer_t no_of_from, no_of_to;
+    igraph_bool_t all_to;
+
+    if (no_of_parts <= 0) {
+#ifdef _OPENMP
+        no_of_parts = omp_get_max_threads();
+#else
+        no_of_parts = 1;
+#endif
+    }
+    if (no_of_parts > no_of_nodes) {
+        no_of_parts = no_of_nodes > 0 ? no_of_nodes : 1;
+    }
+
+    IGRAPH_CHECK(igraph_vit_create(graph, from, &fromvit));
+    IGRAPH_FINALLY(igraph_vit_destroy, &fromvit);
+    no_of_from = IGRAPH_VIT_SIZE(fromvit);
+
+    /* Column of each target vertex in the result. */
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&targets, 0);
+    all_to = igraph_vs_is_all(&to);
+    if (all_to) {
+        no_of_to = no_of_nodes;
+    } else {
+        IGRAPH_CHECK(igraph_vit_create(graph, to, &tovit));
+        IGRAPH_FINALLY(igraph_vit_destroy, &tovit);
+        no_of_to = IGRAPH_VIT_SIZE(tovit);
+        IGRAPH_CHECK(igraph_vector_int_resize(&targets, no_of_to));
+        IGRAPH_CHECK(igraph_vit_as_vector(&tovit, &targets));
+        igraph_vit_destroy(&tovit);
+        IGRAPH_FINALLY_CLEAN(1);
+
+        {
+            igraph_vector_bool_t seen;
+            IGRAPH_VECTOR_BOOL_INIT_FINALLY(&seen, no_of_nodes);
+            for (igraph_integer_t j = 0; j < no_of_to; j++) {
+                if (VECTOR(seen)[VECTOR(targets)[j]]) {
+                    IGRAPH_ERROR("Target vertex list must not have any duplicates.", IGRAPH_EINVAL);
+                }
+                VECTOR(seen)[VECTOR(targets)[j]] = true;
+            }
+            igraph_vector_bool_destroy(&seen);
+            IGRAPH_FINALLY_CLEAN(1);
+        }
+    }
+
+    IGRAPH_CHECK(igraph_matrix_resize(res, no_of_from, no_of_to));
+
+    IGRAPH_CHECK(igraph_i_delta_stepping_init(&ds, graph, weights, mode, delta, no_of_parts));
+    IGRAPH_FINALLY(igraph_i_delta_stepping_destroy, &ds);
+
+    for (igraph_integer_t i = 0; !IGRAPH_VIT_END(fromvit); IGRAPH_VIT_NEXT(fromvit), i++) {
+        IGRAPH_CHECK(igraph_i_delta_stepping_search(&ds, IGRAPH_VIT_GET(fromvit), cutoff));
+
+        for (igraph_integer_t j = 0; j < no_of_to; j++) {
+            igraph_real_t d = VECTOR(ds.dist)[all_to ? j : VECTOR(targets)[j]];
+            MATRIX(*res, i, j) = cutoff >= 0 && d > cutoff ? IGRAPH_INFINITY : d;
+        }
+    }
+
+    igraph_i_delta_stepping_destroy(&ds);
+    igraph_vector_int_destroy(&targets);
+    igraph_vit_destroy(&fromvit);
+    IGRAPH_FINALLY_CLEAN(3);
+
+    return IGRAPH_SUCCESS;
+}
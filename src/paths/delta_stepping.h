@@ -0,0 +1,54 @@
+/*
+   IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#ifndef IGRAPH_PATHS_DELTA_STEPPING_H
+#define IGRAPH_PATHS_DELTA_STEPPING_H
+
+#include "igraph_decls.h"
+#include "igraph_datatype.h"
+#include "igraph_iterators.h"
+#include "igraph_matrix.h"
+#include "igraph_vector.h"
+
+__BEGIN_DECLS
+
+/* igraph_distances_dijkstra_cutoff() switches to delta-stepping when igraph
+ * is compiled with OpenMP, more than one thread is available, the graph has
+ * at least this many edges, and there are at most this many sources. With
+ * more sources, or on smaller graphs, the sequential search is faster. */
+#define IGRAPH_I_DELTA_STEPPING_MIN_EDGES 1000000
+#define IGRAPH_I_DELTA_STEPPING_MAX_SOURCES 4
+
+/* Weighted distances with the delta-stepping algorithm of Meyer and Sanders.
+ *
+ * Arguments are the same as for igraph_distances_dijkstra_cutoff(), and the
+ * weights must already have been validated. 'delta' is the bucket width;
+ * zero or a negative value chooses it automatically. The vertices are split
+ * among 'no_of_parts' parts, which are processed in parallel; zero or a
+ * negative value uses one part per OpenMP thread. The results are identical
+ * to those of Dijkstra's algorithm, whatever the values of 'delta' and
+ * 'no_of_parts'. */
+IGRAPH_PRIVATE_EXPORT igraph_error_t igraph_i_distances_delta_stepping(
+        const igraph_t *graph, igraph_matrix_t *res,
+        const igraph_vs_t from, const igraph_vs_t to,
+        const igraph_vector_t *weights, igraph_neimode_t mode,
+        igraph_real_t cutoff, igraph_real_t delta, igraph_integer_t no_of_parts);
+
+__END_DECLS
+
+#endif
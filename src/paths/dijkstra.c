@@ -28,13 +28,48 @@
 #include "igraph_memory.h"
 #include "igraph_nongraph.h"
 #include "igraph_stack.h"
+#include "igraph_threading.h"
 #include "igraph_vector_ptr.h"
 
 #include "core/indheap.h"
 #include "core/interruption.h"
+#include "core/radixheap.h"
+#include "core/workspace.h"
+#include "paths/delta_stepping.h"
 
+#include <math.h>
 #include <string.h>   /* memset */
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+/* Whether Dijkstra's algorithm can use a radix heap instead of a binary heap
+ * with the given weights. This requires all finite weights to be integers,
+ * and the length of any path to be exactly representable both as an
+ * igraph_integer_t and as an igraph_real_t. */
+static igraph_bool_t igraph_i_dijkstra_integer_weights(const igraph_vector_t *weights,
+                                                        igraph_integer_t no_of_nodes) {
+    const igraph_real_t limit = IGRAPH_INTEGER_SIZE == 64 ? 9007199254740992.0 /* 2^53 */ : IGRAPH_INTEGER_MAX;
+    igraph_integer_t no_of_edges = igraph_vector_size(weights);
+    igraph_real_t max = 0;
+
+    for (igraph_integer_t i = 0; i < no_of_edges; i++) {
+        igraph_real_t weight = VECTOR(*weights)[i];
+        if (weight == IGRAPH_INFINITY) {
+            continue;
+        }
+        if (weight != floor(weight)) {
+            return false;
+        }
+        if (weight > max) {
+            max = weight;
+        }
+    }
+
+    return max <= limit && max * (no_of_nodes - 1.0) <= limit;
+}
+
 /**
  * \function igraph_distances_dijkstra_cutoff
  * \brief Weighted shortest path lengths between vertices, with cutoff.
@@ -44,6 +79,16 @@
  * This function is similar to \ref igraph_distances_dijkstra(), but
  * paths longer than \p cutoff will not be considered.
  *
+ * </para><para>
+ * When igraph is compiled with OpenMP support and in thread-safe mode (see
+ * \ref IGRAPH_THREAD_SAFE), and distances are requested
+ * from only a few sources in a graph with at least a million edges, the
+ * delta-stepping algorithm of Meyer and Sanders is used instead, which
+ * distributes the work of each search among all threads. The results are
+ * the same as with Dijkstra's algorithm. See U. Meyer and P. Sanders:
+ * Delta-stepping: a parallelizable shortest path algorithm, Journal of
+ * Algorithms 49, 114-152 (2003), https://doi.org/10.1016/S0196-6774(03)00076-2
+ *
  * \param graph The input graph, can be directed.
  * \param res The result, a matrix. A pointer to an initialized matrix
  *    should be passed here. The matrix will be resized as needed.
@@ -87,6 +132,50 @@ igraph_error_t igraph_distances_dijkstra_cutoff(const igraph_t *graph,
                                    const igraph_vector_t *weights,
                                    igraph_neimode_t mode,
                                    igraph_real_t cutoff) {
+    return igraph_distances_dijkstra_cutoff_ws(graph, res, from, to, weights, mode, cutoff, NULL);
+}
+
+/**
+ * \function igraph_distances_dijkstra_cutoff_ws
+ * \brief Weighted shortest path lengths, reusing temporary memory.
+ *
+ * \experimental
+ *
+ * This function is identical to \ref igraph_distances_dijkstra_cutoff(),
+ * but it keeps its temporary data structures, which are proportional to
+ * the number of vertices, in a workspace. When the function is called
+ * many times, e.g. for single-source queries on the same graph, passing
+ * the same workspace to each call avoids reallocating these structures.
+ *
+ * \param graph The input graph, can be directed.
+ * \param res The result, a matrix, see \ref igraph_distances_dijkstra_cutoff().
+ * \param from The source vertices.
+ * \param to The target vertices. It is not allowed to include a
+ *    vertex twice or more.
+ * \param weights The edge weights, see \ref igraph_distances_dijkstra_cutoff().
+ * \param mode For directed graphs; whether to follow paths along edge
+ *    directions (\c IGRAPH_OUT), or the opposite (\c IGRAPH_IN), or
+ *    ignore edge directions completely (\c IGRAPH_ALL). It is ignored
+ *    for undirected graphs.
+ * \param cutoff The maximal length of paths that will be considered.
+ *    Negative cutoffs are treated as infinity.
+ * \param ws An initialized workspace, or a null pointer to allocate
+ *    temporary memory for this call only. See \ref igraph_workspace_init().
+ *    It is not used when the parallel delta-stepping algorithm is chosen,
+ *    see \ref igraph_distances_dijkstra_cutoff(); that algorithm allocates
+ *    its own memory on each call.
+ * \return Error code.
+ *
+ * Time complexity: see \ref igraph_distances_dijkstra_cutoff().
+ */
+igraph_error_t igraph_distances_dijkstra_cutoff_ws(const igraph_t *graph,
+                                   igraph_matrix_t *res,
+                                   const igraph_vs_t from,
+                                   const igraph_vs_t to,
+                                   const igraph_vector_t *weights,
+                                   igraph_neimode_t mode,
+                                   igraph_real_t cutoff,
+                                   igraph_workspace_t *ws) {
 
     /* Implementation details. This is the basic Dijkstra algorithm,
        with a binary heap. The heap is indexed, i.e. it stores not only
@@ -98,17 +187,26 @@ igraph_error_t igraph_distances_dijkstra_cutoff(const igraph_t *graph,
        Tricks:
        - The opposite of the distance is stored in the heap, as it is a
          maximum heap and we need a minimum heap.
+       - With integer weights, a radix heap is used instead. Its
+         operations take amortized constant time, apart from moving each
+         vertex at most once per bit of the distance range. Since its
+         keys only grow, the search can stop at the first vertex beyond
+         the cutoff.
     */
 
     igraph_integer_t no_of_nodes = igraph_vcount(graph);
     igraph_integer_t no_of_edges = igraph_ecount(graph);
-    igraph_2wheap_t Q;
+    igraph_2wheap_t *Q;
     igraph_vit_t fromvit, tovit;
     igraph_integer_t no_of_from, no_of_to;
     igraph_lazy_inclist_t inclist;
     igraph_integer_t i, j;
     igraph_bool_t all_to;
-    igraph_vector_int_t indexv;
+    igraph_vector_int_t *indexv;
+    igraph_workspace_t local_ws;
+    igraph_bool_t integer_weights;
+    igraph_i_radixheap_t RQ;
+    igraph_vector_int_t *RQ_storage, *state;
 
     if (!weights) {
         return igraph_distances_cutoff(graph, res, from, to, mode, cutoff);
@@ -129,12 +227,41 @@ igraph_error_t igraph_distances_dijkstra_cutoff(const igraph_t *graph,
         }
     }
 
+#if defined(_OPENMP) && IGRAPH_THREAD_SAFE
+    /* A single search cannot use more than one thread. On large graphs,
+     * delta-stepping spreads each search over all threads instead. The
+     * threads need their own error handler and finally stack, which are
+     * only thread-local in thread-safe builds. */
+    if (no_of_edges >= IGRAPH_I_DELTA_STEPPING_MIN_EDGES && omp_get_max_threads() > 1) {
+        igraph_integer_t no_of_sources;
+        IGRAPH_CHECK(igraph_vs_size(graph, &from, &no_of_sources));
+        if (no_of_sources <= IGRAPH_I_DELTA_STEPPING_MAX_SOURCES) {
+            return igraph_i_distances_delta_stepping(graph, res, from, to, weights, mode, cutoff, 0, 0);
+        }
+    }
+#endif
+
+    if (ws) {
+        igraph_i_workspace_reset(ws);
+    } else {
+        IGRAPH_CHECK(igraph_workspace_init(&local_ws));
+        IGRAPH_FINALLY(igraph_workspace_destroy, &local_ws);
+        ws = &local_ws;
+    }
+
     IGRAPH_CHECK(igraph_vit_create(graph, from, &fromvit));
     IGRAPH_FINALLY(igraph_vit_destroy, &fromvit);
     no_of_from = IGRAPH_VIT_SIZE(fromvit);
 
-    IGRAPH_CHECK(igraph_2wheap_init(&Q, no_of_nodes));
-    IGRAPH_FINALLY(igraph_2wheap_destroy, &Q);
+    integer_weights = igraph_i_dijkstra_integer_weights(weights, no_of_nodes);
+    if (integer_weights) {
+        IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, 0, &RQ_storage));
+        IGRAPH_CHECK(igraph_i_radixheap_init(&RQ, RQ_storage, no_of_nodes));
+        /* 0: not reached yet, 1: in the heap, 2: finished */
+        IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, no_of_nodes, &state));
+    } else {
+        IGRAPH_CHECK(igraph_i_workspace_2wheap(ws, no_of_nodes, &Q));
+    }
     IGRAPH_CHECK(igraph_lazy_inclist_init(graph, &inclist, mode, IGRAPH_LOOPS));
     IGRAPH_FINALLY(igraph_lazy_inclist_destroy, &inclist);
 
@@ -142,7 +269,7 @@ igraph_error_t igraph_distances_dijkstra_cutoff(const igraph_t *graph,
     if (all_to) {
         no_of_to = no_of_nodes;
     } else {
-        IGRAPH_VECTOR_INT_INIT_FINALLY(&indexv, no_of_nodes);
+        IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, no_of_nodes, &indexv));
         IGRAPH_CHECK(igraph_vit_create(graph, to, &tovit));
         IGRAPH_FINALLY(igraph_vit_destroy, &tovit);
         no_of_to = IGRAPH_VIT_SIZE(tovit);
@@ -155,11 +282,11 @@ igraph_error_t igraph_distances_dijkstra_cutoff(const igraph_t *graph,
          * is constructed by the loop below */
         for (i = 0; !IGRAPH_VIT_END(tovit); IGRAPH_VIT_NEXT(tovit)) {
             igraph_integer_t v = IGRAPH_VIT_GET(tovit);
-            if (VECTOR(indexv)[v]) {
+            if (VECTOR(*indexv)[v]) {
                 IGRAPH_ERROR("Target vertex list must not have any duplicates.",
                              IGRAPH_EINVAL);
             }
-            VECTOR(indexv)[v] = ++i;
+            VECTOR(*indexv)[v] = ++i;
         }
     }
 
@@ -173,17 +300,78 @@ igraph_error_t igraph_distances_dijkstra_cutoff(const igraph_t *graph,
         igraph_integer_t reached = 0;
         igraph_integer_t source = IGRAPH_VIT_GET(fromvit);
 
-        igraph_2wheap_clear(&Q);
+        if (integer_weights) {
+            igraph_integer_t *st = VECTOR(*state);
+
+            if (i > 0) {
+                igraph_vector_int_null(state);
+            }
+            igraph_i_radixheap_clear(&RQ);
+            igraph_i_radixheap_push(&RQ, source, 0);
+            st[source] = 1;
+
+            while (!igraph_i_radixheap_empty(&RQ)) {
+                igraph_integer_t mindist;
+                igraph_integer_t minnei = igraph_i_radixheap_pop_min(&RQ, &mindist);
+                igraph_vector_int_t *neis;
+                igraph_integer_t nlen;
+
+                /* All remaining vertices are farther. */
+                if (cutoff >= 0 && mindist > cutoff) {
+                    break;
+                }
+
+                st[minnei] = 2;
+
+                if (all_to) {
+                    MATRIX(*res, i, minnei) = mindist;
+                } else {
+                    if (VECTOR(*indexv)[minnei]) {
+                        MATRIX(*res, i, VECTOR(*indexv)[minnei] - 1) = mindist;
+                        reached++;
+                        if (reached == no_of_to) {
+                            break;
+                        }
+                    }
+                }
+
+                neis = igraph_lazy_inclist_get(&inclist, minnei);
+                IGRAPH_CHECK_OOM(neis, "Failed to query incident edges.");
+                nlen = igraph_vector_int_size(neis);
+                for (j = 0; j < nlen; j++) {
+                    igraph_integer_t edge = VECTOR(*neis)[j];
+                    igraph_real_t weight = VECTOR(*weights)[edge];
+
+                    if (weight == IGRAPH_INFINITY) {
+                        continue;
+                    }
+
+                    igraph_integer_t tto = IGRAPH_OTHER(graph, edge, minnei);
+                    igraph_integer_t altdist = mindist + (igraph_integer_t) weight;
+
+                    if (st[tto] == 0) {
+                        igraph_i_radixheap_push(&RQ, tto, altdist);
+                        st[tto] = 1;
+                    } else if (st[tto] == 1 && altdist < RQ.key[tto]) {
+                        igraph_i_radixheap_decrease(&RQ, tto, altdist);
+                    }
+                }
+            }
+
+            continue;
+        }
+
+        igraph_2wheap_clear(Q);
 
         /* Many systems distinguish between +0.0 and -0.0.
          * Since we store negative distances in the heap,
          * we must insert -0.0 in order to get +0.0 as the
          * final distance result. */
-        igraph_2wheap_push_with_index(&Q, source, -0.0);
+        igraph_2wheap_push_with_index(Q, source, -0.0);
 
-        while (!igraph_2wheap_empty(&Q)) {
-            igraph_integer_t minnei = igraph_2wheap_max_index(&Q);
-            igraph_real_t mindist = -igraph_2wheap_deactivate_max(&Q);
+        while (!igraph_2wheap_empty(Q)) {
+            igraph_integer_t minnei = igraph_2wheap_max_index(Q);
+            igraph_real_t mindist = -igraph_2wheap_deactivate_max(Q);
             igraph_vector_int_t *neis;
             igraph_integer_t nlen;
 
@@ -194,11 +382,11 @@ igraph_error_t igraph_distances_dijkstra_cutoff(const igraph_t *graph,
             if (all_to) {
                 MATRIX(*res, i, minnei) = mindist;
             } else {
-                if (VECTOR(indexv)[minnei]) {
-                    MATRIX(*res, i, VECTOR(indexv)[minnei] - 1) = mindist;
+                if (VECTOR(*indexv)[minnei]) {
+                    MATRIX(*res, i, VECTOR(*indexv)[minnei] - 1) = mindist;
                     reached++;
                     if (reached == no_of_to) {
-                        igraph_2wheap_clear(&Q);
+                        igraph_2wheap_clear(Q);
                         break;
                     }
                 }
@@ -220,32 +408,35 @@ igraph_error_t igraph_distances_dijkstra_cutoff(const igraph_t *graph,
                 igraph_integer_t tto = IGRAPH_OTHER(graph, edge, minnei);
                 igraph_real_t altdist = mindist + weight;
 
-                if (! igraph_2wheap_has_elem(&Q, tto)) {
+                if (! igraph_2wheap_has_elem(Q, tto)) {
                     /* This is the first non-infinite distance */
-                    IGRAPH_CHECK(igraph_2wheap_push_with_index(&Q, tto, -altdist));
-                } else if (igraph_2wheap_has_active(&Q, tto)) {
-                    igraph_real_t curdist = -igraph_2wheap_get(&Q, tto);
+                    IGRAPH_CHECK(igraph_2wheap_push_with_index(Q, tto, -altdist));
+                } else if (igraph_2wheap_has_active(Q, tto)) {
+                    igraph_real_t curdist = -igraph_2wheap_get(Q, tto);
                     if (altdist < curdist) {
                         /* This is a shorter path */
-                        igraph_2wheap_modify(&Q, tto, -altdist);
+                        igraph_2wheap_modify(Q, tto, -altdist);
                     }
                 }
             }
 
-        } /* !igraph_2wheap_empty(&Q) */
+        } /* !igraph_2wheap_empty(Q) */
 
     } /* !IGRAPH_VIT_END(fromvit) */
 
     if (!all_to) {
         igraph_vit_destroy(&tovit);
-        igraph_vector_int_destroy(&indexv);
-        IGRAPH_FINALLY_CLEAN(2);
+        IGRAPH_FINALLY_CLEAN(1);
     }
 
     igraph_lazy_inclist_destroy(&inclist);
-    igraph_2wheap_destroy(&Q);
     igraph_vit_destroy(&fromvit);
-    IGRAPH_FINALLY_CLEAN(3);
+    IGRAPH_FINALLY_CLEAN(2);
+
+    if (ws == &local_ws) {
+        igraph_workspace_destroy(&local_ws);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
 
     return IGRAPH_SUCCESS;
 }
@@ -259,7 +450,9 @@ igraph_error_t igraph_distances_dijkstra_cutoff(const igraph_t *graph,
  * other vertices. This function allows specifying a set of source
  * and target vertices. The algorithm is run independently for each
  * source and the results are retained only for the specified targets.
- * This implementation uses a binary heap for efficiency.
+ * This implementation uses a binary heap for efficiency. On large
+ * graphs, searches from a few sources are parallelized, see
+ * \ref igraph_distances_dijkstra_cutoff().
  *
  * \param graph The input graph, can be directed.
  * \param res The result, a matrix. A pointer to an initialized matrix
@@ -421,6 +614,8 @@ igraph_error_t igraph_get_shortest_paths_dijkstra(const igraph_t *graph,
        - `parent_eids' assigns the inbound edge IDs of all vertices in the
          shortest path tree to the vertices. In this implementation, the
          edge ID + 1 is stored, zero means unreachable vertices.
+       - With finite integer weights, a radix heap is used instead of the
+         binary heap, see igraph_distances_dijkstra_cutoff_ws().
     */
 
     igraph_integer_t no_of_nodes = igraph_vcount(graph);
@@ -432,6 +627,9 @@ igraph_error_t igraph_get_shortest_paths_dijkstra(const igraph_t *graph,
     igraph_integer_t *parent_eids;
     igraph_bool_t *is_target;
     igraph_integer_t i, to_reach;
+    igraph_bool_t integer_weights;
+    igraph_i_radixheap_t RQ;
+    igraph_vector_int_t RQ_storage;
 
     if (!weights) {
         return igraph_get_shortest_paths(graph, vertices, edges, from, to, mode,
@@ -465,8 +663,17 @@ igraph_error_t igraph_get_shortest_paths_dijkstra(const igraph_t *graph,
         IGRAPH_CHECK(igraph_vector_int_list_resize(edges, IGRAPH_VIT_SIZE(vit)));
     }
 
-    IGRAPH_CHECK(igraph_2wheap_init(&Q, no_of_nodes));
+    /* Edges with infinite weight are followed here, so the radix heap is
+     * only used when all weights are finite. */
+    integer_weights = igraph_i_dijkstra_integer_weights(weights, no_of_nodes) &&
+                      (no_of_edges == 0 || igraph_vector_max(weights) < IGRAPH_INFINITY);
+
+    IGRAPH_CHECK(igraph_2wheap_init(&Q, integer_weights ? 0 : no_of_nodes));
     IGRAPH_FINALLY(igraph_2wheap_destroy, &Q);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&RQ_storage, 0);
+    if (integer_weights) {
+        IGRAPH_CHECK(igraph_i_radixheap_init(&RQ, &RQ_storage, no_of_nodes));
+    }
     IGRAPH_CHECK(igraph_lazy_inclist_init(graph, &inclist, mode, IGRAPH_LOOPS));
     IGRAPH_FINALLY(igraph_lazy_inclist_destroy, &inclist);
 
@@ -493,13 +700,26 @@ igraph_error_t igraph_get_shortest_paths_dijkstra(const igraph_t *graph,
 
     VECTOR(dists)[from] = 0.0;  /* zero distance */
     parent_eids[from] = 0;
-    igraph_2wheap_push_with_index(&Q, from, 0);
+    if (integer_weights) {
+        igraph_i_radixheap_push(&RQ, from, 0);
+    } else {
+        igraph_2wheap_push_with_index(&Q, from, 0);
+    }
 
-    while (!igraph_2wheap_empty(&Q) && to_reach > 0) {
-        igraph_integer_t nlen, minnei = igraph_2wheap_max_index(&Q);
-        igraph_real_t mindist = -igraph_2wheap_delete_max(&Q);
+    while (!(integer_weights ? igraph_i_radixheap_empty(&RQ) : igraph_2wheap_empty(&Q)) && to_reach > 0) {
+        igraph_integer_t nlen, minnei;
+        igraph_real_t mindist;
         igraph_vector_int_t *neis;
 
+        if (integer_weights) {
+            igraph_integer_t key;
+            minnei = igraph_i_radixheap_pop_min(&RQ, &key);
+            mindist = key;
+        } else {
+            minnei = igraph_2wheap_max_index(&Q);
+            mindist = -igraph_2wheap_delete_max(&Q);
+        }
+
         IGRAPH_ALLOW_INTERRUPTION();
 
         if (is_target[minnei]) {
@@ -520,12 +740,20 @@ igraph_error_t igraph_get_shortest_paths_dijkstra(const igraph_t *graph,
                 /* This is the first finite distance */
                 VECTOR(dists)[tto] = altdist;
                 parent_eids[tto] = edge + 1;
-                IGRAPH_CHECK(igraph_2wheap_push_with_index(&Q, tto, -altdist));
+                if (integer_weights) {
+                    igraph_i_radixheap_push(&RQ, tto, altdist);
+                } else {
+                    IGRAPH_CHECK(igraph_2wheap_push_with_index(&Q, tto, -altdist));
+                }
             } else if (altdist < curdist) {
                 /* This is a shorter path */
                 VECTOR(dists)[tto] = altdist;
                 parent_eids[tto] = edge + 1;
-                igraph_2wheap_modify(&Q, tto, -altdist);
+                if (integer_weights) {
+                    igraph_i_radixheap_decrease(&RQ, tto, altdist);
+                } else {
+                    igraph_2wheap_modify(&Q, tto, -altdist);
+                }
             }
         }
     } /* !igraph_2wheap_empty(&Q) */
@@ -614,12 +842,13 @@ igraph_error_t igraph_get_shortest_paths_dijkstra(const igraph_t *graph,
     }
 
     igraph_lazy_inclist_destroy(&inclist);
+    igraph_vector_int_destroy(&RQ_storage);
     igraph_2wheap_destroy(&Q);
     igraph_vector_destroy(&dists);
     IGRAPH_FREE(is_target);
     IGRAPH_FREE(parent_eids);
     igraph_vit_destroy(&vit);
-    IGRAPH_FINALLY_CLEAN(6);
+    IGRAPH_FINALLY_CLEAN(7);
 
     return IGRAPH_SUCCESS;
 }
@@ -709,6 +938,247 @@ igraph_error_t igraph_get_shortest_path_dijkstra(const igraph_t *graph,
     return IGRAPH_SUCCESS;
 }
 
+/**
+ * \function igraph_get_shortest_path_bidirectional
+ * \brief Weighted shortest path from one vertex to another one (bidirectional Dijkstra).
+ *
+ * \experimental
+ *
+ * Finds a weighted shortest path from a single source vertex to
+ * a single target, running Dijkstra's algorithm from both ends at the
+ * same time: forward from \p from, and backward from \p to along
+ * reversed edges. The search stops as soon as the two searches have met
+ * and no shorter path can exist. Since each search only needs to cover
+ * about half of the distance, this usually visits far fewer vertices than
+ * \ref igraph_get_shortest_path_dijkstra(). If more than one shortest path
+ * exists, an arbitrary one is returned.
+ *
+ * \param graph The input graph, it can be directed or undirected.
+ * \param vertices Pointer to an initialized vector or a null
+ *        pointer. If not a null pointer, then the vertex IDs along
+ *        the path are stored here, including the source and target
+ *        vertices.
+ * \param edges Pointer to an initialized vector or a null
+ *        pointer. If not a null pointer, then the edge IDs along the
+ *        path are stored here.
+ * \param from The ID of the source vertex.
+ * \param to The ID of the target vertex.
+ * \param weights Optional edge weights. Supply \c NULL for unweighted graphs.
+ *        All edge weights must be non-negative. Additionally, no
+ *        edge weight may be NaN. If either case does not hold, an error
+ *        is returned. Edges with positive infinite weights are ignored.
+ * \param mode A constant specifying how edge directions are
+ *        considered in directed graphs. \c IGRAPH_OUT follows edge
+ *        directions, \c IGRAPH_IN follows the opposite directions,
+ *        and \c IGRAPH_ALL ignores edge directions. This argument is
+ *        ignored for undirected graphs.
+ * \return Error code.
+ *
+ * Time complexity: O(|E|log|V|+|V|) in the worst case, |V| is the number
+ * of vertices, |E| is the number of edges in the graph.
+ *
+ * \sa \ref igraph_get_shortest_path_dijkstra() for a one-sided search,
+ * \ref igraph_get_shortest_path_astar() together with
+ * \ref igraph_landmark_heuristic() for a search guided by precomputed
+ * landmark distances.
+ */
+
+igraph_error_t igraph_get_shortest_path_bidirectional(const igraph_t *graph,
+                                      igraph_vector_int_t *vertices,
+                                      igraph_vector_int_t *edges,
+                                      igraph_integer_t from,
+                                      igraph_integer_t to,
+                                      const igraph_vector_t *weights,
+                                      igraph_neimode_t mode) {
+
+    /* Side 0 is the forward search from 'from', side 1 is the backward
+     * search from 'to'. Whenever a side improves the distance of a vertex
+     * that the other side has already reached, the two partial paths form
+     * a candidate path; 'best' is the length of the shortest candidate and
+     * 'meet' is where its two parts join. Once the smallest tentative
+     * distances of the two sides add up to at least 'best', no shorter
+     * path can be found. */
+
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+    igraph_integer_t no_of_edges = igraph_ecount(graph);
+    igraph_2wheap_t Q[2];
+    igraph_lazy_inclist_t inclist[2];
+    igraph_vector_t dists[2];
+    igraph_vector_int_t parent_eids[2];
+    igraph_real_t best = IGRAPH_INFINITY;
+    igraph_integer_t meet = -1;
+
+    if (from < 0 || from >= no_of_nodes) {
+        IGRAPH_ERROR("Starting vertex out of range.", IGRAPH_EINVVID);
+    }
+
+    if (to < 0 || to >= no_of_nodes) {
+        IGRAPH_ERROR("End vertex out of range.", IGRAPH_EINVVID);
+    }
+
+    if (weights) { /* If there are no weights, they are treated as 1. */
+        if (igraph_vector_size(weights) != no_of_edges) {
+            IGRAPH_ERRORF("Weight vector length (%" IGRAPH_PRId ") does not match number of edges (%" IGRAPH_PRId ").",
+                          IGRAPH_EINVAL, igraph_vector_size(weights), no_of_edges);
+        }
+        if (no_of_edges > 0) {
+            igraph_real_t min = igraph_vector_min(weights);
+            if (min < 0) {
+                IGRAPH_ERRORF("Weights must not be negative, got %g.", IGRAPH_EINVAL, min);
+            } else if (isnan(min)) {
+                IGRAPH_ERROR("Weights must not contain NaN values.", IGRAPH_EINVAL);
+            }
+        }
+    }
+
+    IGRAPH_CHECK(igraph_2wheap_init(&Q[0], no_of_nodes));
+    IGRAPH_FINALLY(igraph_2wheap_destroy, &Q[0]);
+    IGRAPH_CHECK(igraph_2wheap_init(&Q[1], no_of_nodes));
+    IGRAPH_FINALLY(igraph_2wheap_destroy, &Q[1]);
+    IGRAPH_CHECK(igraph_lazy_inclist_init(graph, &inclist[0], mode, IGRAPH_LOOPS));
+    IGRAPH_FINALLY(igraph_lazy_inclist_destroy, &inclist[0]);
+    IGRAPH_CHECK(igraph_lazy_inclist_init(graph, &inclist[1], IGRAPH_REVERSE_MODE(mode), IGRAPH_LOOPS));
+    IGRAPH_FINALLY(igraph_lazy_inclist_destroy, &inclist[1]);
+
+    /* dists[side][v] is the length of the shortest path found so far
+     * between the starting point of the side and 'v'. */
+    IGRAPH_VECTOR_INIT_FINALLY(&dists[0], no_of_nodes);
+    igraph_vector_fill(&dists[0], IGRAPH_INFINITY);
+    IGRAPH_VECTOR_INIT_FINALLY(&dists[1], no_of_nodes);
+    igraph_vector_fill(&dists[1], IGRAPH_INFINITY);
+
+    /* parent_eids[side][v] is 1 + the ID of the edge through which the
+     * side reached 'v'. A value of 0 marks the starting point of the side
+     * and unreached vertices. */
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&parent_eids[0], no_of_nodes);
+    IGRAPH_VECTOR_INT_INIT_FINALLY(&parent_eids[1], no_of_nodes);
+
+    VECTOR(dists[0])[from] = 0.0;
+    VECTOR(dists[1])[to] = 0.0;
+    IGRAPH_CHECK(igraph_2wheap_push_with_index(&Q[0], from, -0.0));
+    IGRAPH_CHECK(igraph_2wheap_push_with_index(&Q[1], to, -0.0));
+    if (from == to) {
+        best = 0.0;
+        meet = from;
+    }
+
+    while (!igraph_2wheap_empty(&Q[0]) && !igraph_2wheap_empty(&Q[1])) {
+        igraph_integer_t side, u, nlen;
+        igraph_vector_int_t *neis;
+
+        IGRAPH_ALLOW_INTERRUPTION();
+
+        if (- igraph_2wheap_max(&Q[0]) - igraph_2wheap_max(&Q[1]) >= best) {
+            break;
+        }
+
+        /* Advance the side with the smaller frontier. */
+        side = igraph_2wheap_size(&Q[0]) <= igraph_2wheap_size(&Q[1]) ? 0 : 1;
+        igraph_2wheap_delete_max_index(&Q[side], &u);
+
+        neis = igraph_lazy_inclist_get(&inclist[side], u);
+        IGRAPH_CHECK_OOM(neis, "Failed to query incident edges.");
+        nlen = igraph_vector_int_size(neis);
+        for (igraph_integer_t i = 0; i < nlen; i++) {
+            igraph_integer_t edge = VECTOR(*neis)[i];
+            igraph_integer_t v = IGRAPH_OTHER(graph, edge, u);
+            igraph_real_t altdist, curdist;
+
+            if (weights) {
+                igraph_real_t weight = VECTOR(*weights)[edge];
+                if (weight == IGRAPH_INFINITY) {
+                    continue;
+                }
+                altdist = VECTOR(dists[side])[u] + weight;
+            } else {
+                altdist = VECTOR(dists[side])[u] + 1;
+            }
+
+            curdist = VECTOR(dists[side])[v];
+            if (altdist < curdist) {
+                VECTOR(dists[side])[v] = altdist;
+                VECTOR(parent_eids[side])[v] = edge + 1;
+                if (curdist == IGRAPH_INFINITY) {
+                    IGRAPH_CHECK(igraph_2wheap_push_with_index(&Q[side], v, -altdist));
+                } else {
+                    igraph_2wheap_modify(&Q[side], v, -altdist);
+                }
+
+                if (altdist + VECTOR(dists[1 - side])[v] < best) {
+                    best = altdist + VECTOR(dists[1 - side])[v];
+                    meet = v;
+                }
+            }
+        }
+    }
+
+    if (meet < 0) {
+        IGRAPH_WARNING("Couldn't reach the target vertex.");
+    }
+
+    if (vertices) {
+        igraph_vector_int_clear(vertices);
+    }
+    if (edges) {
+        igraph_vector_int_clear(edges);
+    }
+
+    /* The forward part of the path leads from 'from' to 'meet', the
+     * backward part from 'meet' to 'to'. */
+    if (meet >= 0 && (vertices || edges)) {
+        igraph_integer_t size_f = 0, size_b = 0, act, edge, k;
+
+        for (act = meet; VECTOR(parent_eids[0])[act]; size_f++) {
+            act = IGRAPH_OTHER(graph, VECTOR(parent_eids[0])[act] - 1, act);
+        }
+        for (act = meet; VECTOR(parent_eids[1])[act]; size_b++) {
+            act = IGRAPH_OTHER(graph, VECTOR(parent_eids[1])[act] - 1, act);
+        }
+
+        if (vertices) {
+            IGRAPH_CHECK(igraph_vector_int_resize(vertices, size_f + size_b + 1));
+            VECTOR(*vertices)[size_f] = meet;
+        }
+        if (edges) {
+            IGRAPH_CHECK(igraph_vector_int_resize(edges, size_f + size_b));
+        }
+
+        for (act = meet, k = size_f; VECTOR(parent_eids[0])[act]; ) {
+            edge = VECTOR(parent_eids[0])[act] - 1;
+            act = IGRAPH_OTHER(graph, edge, act);
+            k--;
+            if (vertices) {
+                VECTOR(*vertices)[k] = act;
+            }
+            if (edges) {
+                VECTOR(*edges)[k] = edge;
+            }
+        }
+        for (act = meet, k = size_f; VECTOR(parent_eids[1])[act]; k++) {
+            edge = VECTOR(parent_eids[1])[act] - 1;
+            act = IGRAPH_OTHER(graph, edge, act);
+            if (vertices) {
+                VECTOR(*vertices)[k + 1] = act;
+            }
+            if (edges) {
+                VECTOR(*edges)[k] = edge;
+            }
+        }
+    }
+
+    igraph_vector_int_destroy(&parent_eids[1]);
+    igraph_vector_int_destroy(&parent_eids[0]);
+    igraph_vector_destroy(&dists[1]);
+    igraph_vector_destroy(&dists[0]);
+    igraph_lazy_inclist_destroy(&inclist[1]);
+    igraph_lazy_inclist_destroy(&inclist[0]);
+    igraph_2wheap_destroy(&Q[1]);
+    igraph_2wheap_destroy(&Q[0]);
+    IGRAPH_FINALLY_CLEAN(8);
+
+    return IGRAPH_SUCCESS;
+}
+
 /**
  * \ingroup structural
  * \function igraph_get_all_shortest_paths_dijkstra
@@ -31,6 +31,7 @@
 
 #include "core/interruption.h"
 #include "core/indheap.h"
+#include "paths/bfs_engine.h"
 
 /* When vid_ecc is not NULL, only one vertex ID should be passed in vids.
  * vid_ecc will then return the id of the vertex farthest from the one in
@@ -226,6 +227,86 @@ static igraph_error_t igraph_i_eccentricity_dijkstra(
     return IGRAPH_SUCCESS;
 }
 
+/* Eccentricities from separate direction-optimizing searches. */
+static igraph_error_t igraph_i_eccentricity_single(const igraph_t *graph,
+                                                   const igraph_csr_t *csr,
+                                                   igraph_vector_t *res,
+                                                   igraph_vit_t *vit,
+                                                   igraph_neimode_t mode) {
+    igraph_csr_t rcsr;
+    igraph_i_bfs_t bfs;
+    igraph_integer_t i;
+    igraph_bool_t directed = igraph_is_directed(graph) && mode != IGRAPH_ALL;
+
+    /* Bottom-up steps of the search need the reverse neighbors. */
+    if (directed) {
+        IGRAPH_CHECK(igraph_csr_init(graph, &rcsr, IGRAPH_REVERSE_MODE(mode),
+                                     IGRAPH_NO_LOOPS, IGRAPH_NO_MULTIPLE, false));
+        IGRAPH_FINALLY(igraph_csr_destroy, &rcsr);
+    }
+
+    IGRAPH_CHECK(igraph_i_bfs_init(&bfs, csr, directed ? &rcsr : csr));
+    IGRAPH_FINALLY(igraph_i_bfs_destroy, &bfs);
+
+    for (i = 0, IGRAPH_VIT_RESET(*vit); !IGRAPH_VIT_END(*vit); IGRAPH_VIT_NEXT(*vit), i++) {
+        IGRAPH_ALLOW_INTERRUPTION();
+        IGRAPH_CHECK(igraph_i_bfs_run(&bfs, IGRAPH_VIT_GET(*vit), -1, NULL, 0));
+        VECTOR(*res)[i] = IGRAPH_I_BFS_DEPTH(&bfs);
+    }
+
+    igraph_i_bfs_destroy(&bfs);
+    IGRAPH_FINALLY_CLEAN(1);
+    if (directed) {
+        igraph_csr_destroy(&rcsr);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Eccentricities from multi-source searches from batches of vertices.
+ * The eccentricity of a source is the last step in which its search
+ * reached a new vertex. */
+static igraph_error_t igraph_i_eccentricity_multi(const igraph_csr_t *csr,
+                                                  igraph_vector_t *res,
+                                                  igraph_vit_t *vit) {
+    igraph_integer_t no_of_sources = IGRAPH_VIT_SIZE(*vit);
+    igraph_i_msbfs_t ms;
+    igraph_integer_t sources[IGRAPH_INTEGER_SIZE];
+    igraph_uint_t active;
+
+    IGRAPH_CHECK(igraph_i_msbfs_init(&ms, csr));
+    IGRAPH_FINALLY(igraph_i_msbfs_destroy, &ms);
+
+    igraph_vector_null(res);
+
+    IGRAPH_VIT_RESET(*vit);
+    for (igraph_integer_t first = 0; first < no_of_sources; first += IGRAPH_INTEGER_SIZE) {
+        igraph_integer_t batch = 0;
+
+        IGRAPH_ALLOW_INTERRUPTION();
+
+        for (; batch < IGRAPH_INTEGER_SIZE && !IGRAPH_VIT_END(*vit); batch++, IGRAPH_VIT_NEXT(*vit)) {
+            sources[batch] = IGRAPH_VIT_GET(*vit);
+        }
+
+        igraph_i_msbfs_start(&ms, sources, batch);
+        while ((active = igraph_i_msbfs_step(&ms))) {
+            IGRAPH_ALLOW_INTERRUPTION();
+            while (active) {
+                igraph_integer_t k = IGRAPH_CTZ(active);
+                active &= active - 1;
+                VECTOR(*res)[first + k] = ms.level;
+            }
+        }
+    }
+
+    igraph_i_msbfs_destroy(&ms);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return IGRAPH_SUCCESS;
+}
+
 /**
  * \function igraph_eccentricity
  * \brief Eccentricity of some vertices.
@@ -262,16 +343,27 @@ igraph_error_t igraph_eccentricity(const igraph_t *graph,
                         igraph_vector_t *res,
                         igraph_vs_t vids,
                         igraph_neimode_t mode) {
-    igraph_lazy_adjlist_t adjlist;
+    igraph_csr_t csr;
+    igraph_vit_t vit;
 
-    IGRAPH_CHECK(igraph_lazy_adjlist_init(graph, &adjlist, mode,
-                                          IGRAPH_NO_LOOPS, IGRAPH_NO_MULTIPLE));
-    IGRAPH_FINALLY(igraph_lazy_adjlist_destroy, &adjlist);
+    IGRAPH_CHECK(igraph_csr_init(graph, &csr, mode, IGRAPH_NO_LOOPS, IGRAPH_NO_MULTIPLE, false));
+    IGRAPH_FINALLY(igraph_csr_destroy, &csr);
+
+    IGRAPH_CHECK(igraph_vit_create(graph, vids, &vit));
+    IGRAPH_FINALLY(igraph_vit_destroy, &vit);
+
+    IGRAPH_CHECK(igraph_vector_resize(res, IGRAPH_VIT_SIZE(vit)));
+
+    if (IGRAPH_VIT_SIZE(vit) >= IGRAPH_I_MSBFS_MIN_SOURCES) {
+        IGRAPH_CHECK(igraph_i_eccentricity_multi(&csr, res, &vit));
+    } else {
+        IGRAPH_CHECK(igraph_i_eccentricity_single(graph, &csr, res, &vit, mode));
+    }
+
+    igraph_vit_destroy(&vit);
+    igraph_csr_destroy(&csr);
+    IGRAPH_FINALLY_CLEAN(2);
 
-    IGRAPH_CHECK(igraph_i_eccentricity(graph, res, vids, &adjlist,
-                                       /*vid_ecc*/ NULL, /*unconn*/ true));
-    igraph_lazy_adjlist_destroy(&adjlist);
-    IGRAPH_FINALLY_CLEAN(1);
     return IGRAPH_SUCCESS;
 }
 
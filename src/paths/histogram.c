@@ -19,11 +19,11 @@
 #include "igraph_paths.h"
 
 #include "igraph_adjlist.h"
-#include "igraph_dqueue.h"
 #include "igraph_interface.h"
 #include "igraph_progress.h"
 
 #include "core/interruption.h"
+#include "paths/bfs_engine.h"
 
 /**
  * \function igraph_path_length_hist
@@ -55,11 +55,9 @@ igraph_error_t igraph_path_length_hist(const igraph_t *graph, igraph_vector_t *r
                             igraph_real_t *unconnected, igraph_bool_t directed) {
 
     const igraph_integer_t no_of_nodes = igraph_vcount(graph);
-    igraph_vector_int_t already_added;
-    igraph_integer_t nodes_reached;
-    igraph_dqueue_int_t q = IGRAPH_DQUEUE_NULL;
-    igraph_vector_int_t *neis;
-    igraph_adjlist_t allneis;
+    igraph_csr_t csr;
+    igraph_i_msbfs_t ms;
+    igraph_integer_t sources[IGRAPH_INTEGER_SIZE];
     igraph_real_t unconn = 0;
     igraph_integer_t ressize;
 
@@ -67,54 +65,44 @@ igraph_error_t igraph_path_length_hist(const igraph_t *graph, igraph_vector_t *r
         directed = false;
     }
 
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&already_added, no_of_nodes);
-    IGRAPH_DQUEUE_INT_INIT_FINALLY(&q, 100);
+    IGRAPH_CHECK(igraph_csr_init(graph, &csr,
+                                 directed ? IGRAPH_OUT : IGRAPH_ALL,
+                                 IGRAPH_LOOPS, IGRAPH_MULTIPLE, false));
+    IGRAPH_FINALLY(igraph_csr_destroy, &csr);
 
-    IGRAPH_CHECK(igraph_adjlist_init(graph, &allneis,
-                                     directed ? IGRAPH_OUT : IGRAPH_ALL,
-                                     IGRAPH_LOOPS, IGRAPH_MULTIPLE));
-    IGRAPH_FINALLY(igraph_adjlist_destroy, &allneis);
+    IGRAPH_CHECK(igraph_i_msbfs_init(&ms, &csr));
+    IGRAPH_FINALLY(igraph_i_msbfs_destroy, &ms);
 
     igraph_vector_clear(res);
     ressize = 0;
 
-    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
-        nodes_reached = 1;      /* itself */
-        IGRAPH_CHECK(igraph_dqueue_int_push(&q, i));
-        IGRAPH_CHECK(igraph_dqueue_int_push(&q, 0));
-        VECTOR(already_added)[i] = i + 1;
+    /* Only the number of vertex pairs at each distance is needed, so the
+     * searches from a batch of sources are run together. */
+    for (igraph_integer_t i = 0; i < no_of_nodes; i += IGRAPH_INTEGER_SIZE) {
+        igraph_integer_t batch = no_of_nodes - i < IGRAPH_INTEGER_SIZE ? no_of_nodes - i : IGRAPH_INTEGER_SIZE;
+        igraph_integer_t pairs_reached = batch;      /* the sources themselves */
+        for (igraph_integer_t k = 0; k < batch; k++) {
+            sources[k] = i + k;
+        }
 
         IGRAPH_PROGRESS("Path length histogram: ", 100.0 * i / no_of_nodes, NULL);
 
         IGRAPH_ALLOW_INTERRUPTION();
 
-        while (!igraph_dqueue_int_empty(&q)) {
-            igraph_integer_t actnode = igraph_dqueue_int_pop(&q);
-            igraph_integer_t actdist = igraph_dqueue_int_pop(&q);
-
-            neis = igraph_adjlist_get(&allneis, actnode);
-            const igraph_integer_t n = igraph_vector_int_size(neis);
-            for (igraph_integer_t j = 0; j < n; j++) {
-                igraph_integer_t neighbor = VECTOR(*neis)[j];
-                if (VECTOR(already_added)[neighbor] == i + 1) {
-                    continue;
-                }
-                VECTOR(already_added)[neighbor] = i + 1;
-                nodes_reached++;
-                if (actdist + 1 > ressize) {
-                    IGRAPH_CHECK(igraph_vector_resize(res, actdist + 1));
-                    for (; ressize < actdist + 1; ressize++) {
-                        VECTOR(*res)[ressize] = 0;
-                    }
+        igraph_i_msbfs_start(&ms, sources, batch);
+        while (igraph_i_msbfs_step(&ms)) {
+            IGRAPH_ALLOW_INTERRUPTION();
+            if (ms.level > ressize) {
+                IGRAPH_CHECK(igraph_vector_resize(res, ms.level));
+                for (; ressize < ms.level; ressize++) {
+                    VECTOR(*res)[ressize] = 0;
                 }
-                VECTOR(*res)[actdist] += 1;
-
-                IGRAPH_CHECK(igraph_dqueue_int_push(&q, neighbor));
-                IGRAPH_CHECK(igraph_dqueue_int_push(&q, actdist + 1));
             }
-        } /* while !igraph_dqueue_int_empty */
+            VECTOR(*res)[ms.level - 1] += ms.count;
+            pairs_reached += ms.count;
+        }
 
-        unconn += (no_of_nodes - nodes_reached);
+        unconn += (batch * no_of_nodes - pairs_reached);
 
     } /* for i<no_of_nodes */
 
@@ -128,10 +116,9 @@ igraph_error_t igraph_path_length_hist(const igraph_t *graph, igraph_vector_t *r
         unconn /= 2;
     }
 
-    igraph_vector_int_destroy(&already_added);
-    igraph_dqueue_int_destroy(&q);
-    igraph_adjlist_destroy(&allneis);
-    IGRAPH_FINALLY_CLEAN(3);
+    igraph_i_msbfs_destroy(&ms);
+    igraph_csr_destroy(&csr);
+    IGRAPH_FINALLY_CLEAN(2);
 
     if (unconnected) {
         *unconnected = unconn;
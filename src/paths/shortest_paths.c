@@ -28,6 +28,7 @@
 
 #include "core/indheap.h"
 #include "core/interruption.h"
+#include "paths/bfs_engine.h"
 
 #include <string.h>
 
@@ -52,59 +53,45 @@ static igraph_error_t igraph_i_average_path_length_unweighted(
      * returning -0.0 where 0.0 would be expected. */
     const igraph_real_t no_of_pairs = no_of_nodes > 0 ? no_of_nodes * (no_of_nodes - 1.0) : 0.0;
 
-    igraph_integer_t n;
-    igraph_integer_t *already_added;
-
     igraph_real_t no_of_conn_pairs = 0.0; /* no. of ordered pairs between which there is a path */
 
-    igraph_dqueue_int_t q = IGRAPH_DQUEUE_NULL;
-    igraph_vector_int_t *neis;
-    igraph_adjlist_t allneis;
+    igraph_csr_t csr;
+    igraph_i_msbfs_t ms;
+    igraph_integer_t sources[IGRAPH_INTEGER_SIZE];
 
     *res = 0;
-    already_added = IGRAPH_CALLOC(no_of_nodes, igraph_integer_t);
-    IGRAPH_CHECK_OOM(already_added, "Insufficient memory for average path length.");
-    IGRAPH_FINALLY(igraph_free, already_added);
-
-    IGRAPH_DQUEUE_INT_INIT_FINALLY(&q, 100);
 
-    IGRAPH_CHECK(igraph_adjlist_init(
-        graph, &allneis,
+    IGRAPH_CHECK(igraph_csr_init(
+        graph, &csr,
         directed ? IGRAPH_OUT : IGRAPH_ALL,
-        IGRAPH_LOOPS, IGRAPH_MULTIPLE
+        IGRAPH_LOOPS, IGRAPH_MULTIPLE, false
     ));
-    IGRAPH_FINALLY(igraph_adjlist_destroy, &allneis);
+    IGRAPH_FINALLY(igraph_csr_destroy, &csr);
 
-    for (igraph_integer_t source = 0; source < no_of_nodes; source++) {
-        IGRAPH_CHECK(igraph_dqueue_int_push(&q, source));
-        IGRAPH_CHECK(igraph_dqueue_int_push(&q, 0));
-        already_added[source] = source + 1;
+    IGRAPH_CHECK(igraph_i_msbfs_init(&ms, &csr));
+    IGRAPH_FINALLY(igraph_i_msbfs_destroy, &ms);
 
-        IGRAPH_ALLOW_INTERRUPTION();
+    /* Only the number of vertex pairs at each distance is needed, so the
+     * searches from a batch of sources are run together. */
+    for (igraph_integer_t first = 0; first < no_of_nodes; first += IGRAPH_INTEGER_SIZE) {
+        igraph_integer_t batch = no_of_nodes - first < IGRAPH_INTEGER_SIZE ? no_of_nodes - first : IGRAPH_INTEGER_SIZE;
+        for (igraph_integer_t k = 0; k < batch; k++) {
+            sources[k] = first + k;
+        }
 
-        while (!igraph_dqueue_int_empty(&q)) {
-            igraph_integer_t actnode = igraph_dqueue_int_pop(&q);
-            igraph_integer_t actdist = igraph_dqueue_int_pop(&q);
+        IGRAPH_ALLOW_INTERRUPTION();
 
-            neis = igraph_adjlist_get(&allneis, actnode);
-            n = igraph_vector_int_size(neis);
-            for (igraph_integer_t j = 0; j < n; j++) {
-                igraph_integer_t neighbor = VECTOR(*neis)[j];
-                if (already_added[neighbor] == source + 1) {
-                    continue;
-                }
-                already_added[neighbor] = source + 1;
-                if (invert) {
-                    *res += 1.0/(actdist + 1.0);
-                } else {
-                    *res += actdist + 1.0;
-                }
-                no_of_conn_pairs += 1;
-                IGRAPH_CHECK(igraph_dqueue_int_push(&q, neighbor));
-                IGRAPH_CHECK(igraph_dqueue_int_push(&q, actdist + 1));
+        igraph_i_msbfs_start(&ms, sources, batch);
+        while (igraph_i_msbfs_step(&ms)) {
+            IGRAPH_ALLOW_INTERRUPTION();
+            if (invert) {
+                *res += ms.count / (igraph_real_t) ms.level;
+            } else {
+                *res += ms.count * (igraph_real_t) ms.level;
             }
-        } /* while !igraph_dqueue_int_empty */
-    } /* for source < no_of_nodes */
+            no_of_conn_pairs += ms.count;
+        }
+    } /* for first < no_of_nodes */
 
 
     if (no_of_pairs == 0) {
@@ -133,10 +120,9 @@ static igraph_error_t igraph_i_average_path_length_unweighted(
         *unconnected_pairs = no_of_pairs - no_of_conn_pairs;
 
     /* clean */
-    IGRAPH_FREE(already_added);
-    igraph_dqueue_int_destroy(&q);
-    igraph_adjlist_destroy(&allneis);
-    IGRAPH_FINALLY_CLEAN(3);
+    igraph_i_msbfs_destroy(&ms);
+    igraph_csr_destroy(&csr);
+    IGRAPH_FINALLY_CLEAN(2);
 
     return IGRAPH_SUCCESS;
 }
@@ -953,18 +939,15 @@ igraph_error_t igraph_diameter(const igraph_t *graph, igraph_real_t *res,
                     igraph_bool_t directed, igraph_bool_t unconn) {
 
     const igraph_integer_t no_of_nodes = igraph_vcount(graph);
-    igraph_integer_t n;
-    igraph_integer_t *already_added;
-    igraph_integer_t nodes_reached;
     /* from/to are initialized to 0 because in a singleton graph, or in an edgeless graph
      * with unconn = true, the diameter path will be considered to consist of vertex 0 only. */
     igraph_integer_t ifrom = 0, ito = 0;
     igraph_real_t ires = 0;
 
-    igraph_dqueue_int_t q = IGRAPH_DQUEUE_NULL;
-    igraph_vector_int_t *neis;
     igraph_neimode_t dirmode;
-    igraph_adjlist_t allneis;
+    igraph_csr_t csr, rcsr;
+    igraph_i_bfs_t bfs;
+    igraph_bool_t reverse;
 
     /* See https://github.com/igraph/igraph/issues/1538#issuecomment-724071857
      * for why we return NaN for the null graph. */
@@ -992,50 +975,33 @@ igraph_error_t igraph_diameter(const igraph_t *graph, igraph_real_t *res,
     } else {
         dirmode = IGRAPH_ALL;
     }
-    already_added = IGRAPH_CALLOC(no_of_nodes, igraph_integer_t);
-    IGRAPH_CHECK_OOM(already_added, "Insufficient memory for diameter calculation.");
-    IGRAPH_FINALLY(igraph_free, already_added);
+    reverse = directed && igraph_is_directed(graph);
 
-    IGRAPH_DQUEUE_INT_INIT_FINALLY(&q, 100);
+    IGRAPH_CHECK(igraph_csr_init(graph, &csr, dirmode, IGRAPH_LOOPS, IGRAPH_MULTIPLE, false));
+    IGRAPH_FINALLY(igraph_csr_destroy, &csr);
 
-    IGRAPH_CHECK(igraph_adjlist_init(graph, &allneis, dirmode, IGRAPH_LOOPS, IGRAPH_MULTIPLE));
-    IGRAPH_FINALLY(igraph_adjlist_destroy, &allneis);
+    /* Bottom-up steps of the search need the reverse neighbors. */
+    if (reverse) {
+        IGRAPH_CHECK(igraph_csr_init(graph, &rcsr, IGRAPH_IN, IGRAPH_LOOPS, IGRAPH_MULTIPLE, false));
+        IGRAPH_FINALLY(igraph_csr_destroy, &rcsr);
+    }
 
-    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
-        nodes_reached = 1;
-        IGRAPH_CHECK(igraph_dqueue_int_push(&q, i));
-        IGRAPH_CHECK(igraph_dqueue_int_push(&q, 0));
-        already_added[i] = i + 1;
+    IGRAPH_CHECK(igraph_i_bfs_init(&bfs, &csr, reverse ? &rcsr : &csr));
+    IGRAPH_FINALLY(igraph_i_bfs_destroy, &bfs);
 
+    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
         IGRAPH_PROGRESS("Diameter: ", 100.0 * i / no_of_nodes, NULL);
 
         IGRAPH_ALLOW_INTERRUPTION();
 
-        while (!igraph_dqueue_int_empty(&q)) {
-            igraph_integer_t actnode = igraph_dqueue_int_pop(&q);
-            igraph_integer_t actdist = igraph_dqueue_int_pop(&q);
-            if (actdist > ires) {
-                ires = actdist;
-                ifrom = i;
-                ito = actnode;
-            }
-
-            neis = igraph_adjlist_get(&allneis, actnode);
-            n = igraph_vector_int_size(neis);
-            for (igraph_integer_t j = 0; j < n; j++) {
-                igraph_integer_t neighbor = VECTOR(*neis)[j];
-                if (already_added[neighbor] == i + 1) {
-                    continue;
-                }
-                already_added[neighbor] = i + 1;
-                nodes_reached++;
-                IGRAPH_CHECK(igraph_dqueue_int_push(&q, neighbor));
-                IGRAPH_CHECK(igraph_dqueue_int_push(&q, actdist + 1));
-            }
-        } /* while !igraph_dqueue_int_empty */
+        IGRAPH_CHECK(igraph_i_bfs_run(&bfs, i, -1, NULL, 0));
+        if (IGRAPH_I_BFS_DEPTH(&bfs) > ires) {
+            ires = IGRAPH_I_BFS_DEPTH(&bfs);
+            ifrom = i;
+        }
 
         /* not connected, return IGRAPH_INFINITY */
-        if (nodes_reached != no_of_nodes && !unconn) {
+        if (bfs.reached != no_of_nodes && !unconn) {
             ires = IGRAPH_INFINITY;
             ifrom = -1;
             ito = -1;
@@ -1043,6 +1009,21 @@ igraph_error_t igraph_diameter(const igraph_t *graph, igraph_real_t *res,
         }
     } /* for i<no_of_nodes */
 
+    /* The endpoint of the path is the first vertex at the largest distance
+     * in the order of a standard breadth-first search. The order within the
+     * levels is only guaranteed for top-down steps, so repeat the search from
+     * the starting point without bottom-up steps. */
+    if (isfinite(ires) && ires > 0 && (to || vertex_path || edge_path)) {
+        bfs.in = NULL;
+        IGRAPH_CHECK(igraph_i_bfs_run(&bfs, ifrom, -1, NULL, 0));
+        for (igraph_integer_t k = 0; k < bfs.reached; k++) {
+            ito = VECTOR(bfs.order)[k];
+            if (VECTOR(bfs.dist)[ito] == ires) {
+                break;
+            }
+        }
+    }
+
     IGRAPH_PROGRESS("Diameter: ", 100.0, NULL);
 
     /* return the requested info */
@@ -1070,10 +1051,14 @@ igraph_error_t igraph_diameter(const igraph_t *graph, igraph_real_t *res,
     }
 
     /* clean */
-    IGRAPH_FREE(already_added);
-    igraph_dqueue_int_destroy(&q);
-    igraph_adjlist_destroy(&allneis);
-    IGRAPH_FINALLY_CLEAN(3);
+    igraph_i_bfs_destroy(&bfs);
+    IGRAPH_FINALLY_CLEAN(1);
+    if (reverse) {
+        igraph_csr_destroy(&rcsr);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
+    igraph_csr_destroy(&csr);
+    IGRAPH_FINALLY_CLEAN(1);
 
     return IGRAPH_SUCCESS;
 }
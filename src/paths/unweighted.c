@@ -25,7 +25,116 @@
 #include "igraph_interface.h"
 #include "igraph_memory.h"
 
+#include <math.h>
+
 #include "core/interruption.h"
+#include "paths/bfs_engine.h"
+
+/* Fills the rows of 'res' with separate direction-optimizing searches from
+ * each source. 'indexv' maps vertices to 1 + their column in 'res', or is
+ * NULL when all vertices are targets; 'targets' is the same set as a bitset,
+ * and allows a search to stop when it has reached all targets. */
+static igraph_error_t igraph_i_distances_single(
+        const igraph_t *graph, const igraph_csr_t *csr, igraph_neimode_t mode,
+        igraph_matrix_t *res, igraph_vit_t *fromvit,
+        const igraph_vector_int_t *indexv, const igraph_bitset_t *targets,
+        igraph_integer_t no_of_to, igraph_integer_t cutoff) {
+
+    igraph_csr_t rcsr;
+    igraph_i_bfs_t bfs;
+    igraph_bool_t directed = igraph_is_directed(graph) && mode != IGRAPH_ALL;
+    igraph_integer_t i, j;
+
+    /* Bottom-up steps of the search need the reverse neighbors. */
+    if (directed) {
+        IGRAPH_CHECK(igraph_csr_init(graph, &rcsr, IGRAPH_REVERSE_MODE(mode),
+                                     IGRAPH_LOOPS, IGRAPH_MULTIPLE, false));
+        IGRAPH_FINALLY(igraph_csr_destroy, &rcsr);
+    }
+
+    IGRAPH_CHECK(igraph_i_bfs_init(&bfs, csr, directed ? &rcsr : csr));
+    IGRAPH_FINALLY(igraph_i_bfs_destroy, &bfs);
+
+    for (IGRAPH_VIT_RESET(*fromvit), i = 0;
+         !IGRAPH_VIT_END(*fromvit);
+         IGRAPH_VIT_NEXT(*fromvit), i++) {
+
+        IGRAPH_ALLOW_INTERRUPTION();
+
+        IGRAPH_CHECK(igraph_i_bfs_run(&bfs, IGRAPH_VIT_GET(*fromvit), cutoff,
+                                      targets, no_of_to));
+
+        for (j = 0; j < bfs.reached; j++) {
+            igraph_integer_t act = VECTOR(bfs.order)[j];
+            if (!indexv) {
+                MATRIX(*res, i, act) = VECTOR(bfs.dist)[act];
+            } else if (VECTOR(*indexv)[act]) {
+                MATRIX(*res, i, VECTOR(*indexv)[act] - 1) = VECTOR(bfs.dist)[act];
+            }
+        }
+    }
+
+    igraph_i_bfs_destroy(&bfs);
+    IGRAPH_FINALLY_CLEAN(1);
+    if (directed) {
+        igraph_csr_destroy(&rcsr);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
+
+    return IGRAPH_SUCCESS;
+}
+
+/* Fills the rows of 'res' with multi-source searches from batches of
+ * sources, see igraph_i_distances_single() for the parameters. */
+static igraph_error_t igraph_i_distances_multi(
+        const igraph_csr_t *csr, igraph_matrix_t *res, igraph_vit_t *fromvit,
+        const igraph_vector_int_t *indexv, igraph_integer_t cutoff) {
+
+    igraph_integer_t no_of_from = IGRAPH_VIT_SIZE(*fromvit);
+    igraph_i_msbfs_t ms;
+    igraph_integer_t sources[IGRAPH_INTEGER_SIZE];
+
+    IGRAPH_CHECK(igraph_i_msbfs_init(&ms, csr));
+    IGRAPH_FINALLY(igraph_i_msbfs_destroy, &ms);
+
+    IGRAPH_VIT_RESET(*fromvit);
+    for (igraph_integer_t first = 0; first < no_of_from; first += IGRAPH_INTEGER_SIZE) {
+        igraph_integer_t batch = 0;
+
+        IGRAPH_ALLOW_INTERRUPTION();
+
+        for (; batch < IGRAPH_INTEGER_SIZE && !IGRAPH_VIT_END(*fromvit); batch++, IGRAPH_VIT_NEXT(*fromvit)) {
+            sources[batch] = IGRAPH_VIT_GET(*fromvit);
+        }
+
+        igraph_i_msbfs_start(&ms, sources, batch);
+        do {
+            IGRAPH_ALLOW_INTERRUPTION();
+            for (igraph_integer_t i = 0; i < ms.frontier_size; i++) {
+                igraph_integer_t v = VECTOR(ms.frontier)[i];
+                igraph_uint_t mask = VECTOR(ms.visit)[v];
+                igraph_integer_t col;
+                if (!indexv) {
+                    col = v;
+                } else if (VECTOR(*indexv)[v]) {
+                    col = VECTOR(*indexv)[v] - 1;
+                } else {
+                    continue;
+                }
+                while (mask) {
+                    igraph_integer_t k = IGRAPH_CTZ(mask);
+                    mask &= mask - 1;
+                    MATRIX(*res, first + k, col) = ms.level;
+                }
+            }
+        } while ((cutoff < 0 || ms.level < cutoff) && igraph_i_msbfs_step(&ms));
+    }
+
+    igraph_i_msbfs_destroy(&ms);
+    IGRAPH_FINALLY_CLEAN(1);
+
+    return IGRAPH_SUCCESS;
+}
 
 /**
  * \ingroup structural
@@ -89,13 +198,12 @@ igraph_error_t igraph_distances_cutoff(const igraph_t *graph, igraph_matrix_t *r
 
     igraph_integer_t no_of_nodes = igraph_vcount(graph);
     igraph_integer_t no_of_from, no_of_to;
-    igraph_integer_t *already_counted;
-    igraph_adjlist_t adjlist;
-    igraph_dqueue_int_t q = IGRAPH_DQUEUE_NULL;
-    igraph_vector_int_t *neis;
+    igraph_integer_t int_cutoff;
+    igraph_csr_t csr;
+    igraph_bitset_t targets;
     igraph_bool_t all_to;
 
-    igraph_integer_t i, j;
+    igraph_integer_t i;
     igraph_vit_t fromvit, tovit;
     igraph_vector_int_t indexv;
 
@@ -104,24 +212,27 @@ igraph_error_t igraph_distances_cutoff(const igraph_t *graph, igraph_matrix_t *r
         IGRAPH_ERROR("Invalid mode argument.", IGRAPH_EINVMODE);
     }
 
+    /* Distances are integers, so fractional cutoffs can be rounded down.
+     * No path is longer than the number of vertices. */
+    if (cutoff >= 0 && cutoff < no_of_nodes) {
+        int_cutoff = floor(cutoff);
+    } else {
+        int_cutoff = -1;
+    }
+
     IGRAPH_CHECK(igraph_vit_create(graph, from, &fromvit));
     IGRAPH_FINALLY(igraph_vit_destroy, &fromvit);
     no_of_from = IGRAPH_VIT_SIZE(fromvit);
 
-    IGRAPH_CHECK(igraph_adjlist_init(graph, &adjlist, mode, IGRAPH_LOOPS, IGRAPH_MULTIPLE));
-    IGRAPH_FINALLY(igraph_adjlist_destroy, &adjlist);
-
-    already_counted = IGRAPH_CALLOC(no_of_nodes, igraph_integer_t);
-    IGRAPH_CHECK_OOM(already_counted, "Insufficient memory for graph distance calculation.");
-    IGRAPH_FINALLY(igraph_free, already_counted);
-
-    IGRAPH_DQUEUE_INT_INIT_FINALLY(&q, 100);
+    IGRAPH_CHECK(igraph_csr_init(graph, &csr, mode, IGRAPH_LOOPS, IGRAPH_MULTIPLE, false));
+    IGRAPH_FINALLY(igraph_csr_destroy, &csr);
 
     all_to = igraph_vs_is_all(&to);
     if (all_to) {
         no_of_to = no_of_nodes;
     } else {
         IGRAPH_VECTOR_INT_INIT_FINALLY(&indexv, no_of_nodes);
+        IGRAPH_BITSET_INIT_FINALLY(&targets, no_of_nodes);
         IGRAPH_CHECK(igraph_vit_create(graph, to, &tovit));
         IGRAPH_FINALLY(igraph_vit_destroy, &tovit);
         no_of_to = IGRAPH_VIT_SIZE(tovit);
@@ -132,69 +243,35 @@ igraph_error_t igraph_distances_cutoff(const igraph_t *graph, igraph_matrix_t *r
                              IGRAPH_EINVAL);
             }
             VECTOR(indexv)[v] = ++i;
+            IGRAPH_BIT_SET(targets, v);
         }
     }
 
     IGRAPH_CHECK(igraph_matrix_resize(res, no_of_from, no_of_to));
     igraph_matrix_fill(res, IGRAPH_INFINITY);
 
-    for (IGRAPH_VIT_RESET(fromvit), i = 0;
-         !IGRAPH_VIT_END(fromvit);
-         IGRAPH_VIT_NEXT(fromvit), i++) {
-        igraph_integer_t reached = 0;
-        IGRAPH_CHECK(igraph_dqueue_int_push(&q, IGRAPH_VIT_GET(fromvit)));
-        IGRAPH_CHECK(igraph_dqueue_int_push(&q, 0));
-        already_counted[ IGRAPH_VIT_GET(fromvit) ] = i + 1;
-
-        IGRAPH_ALLOW_INTERRUPTION();
-
-        while (!igraph_dqueue_int_empty(&q)) {
-            igraph_integer_t act = igraph_dqueue_int_pop(&q);
-            igraph_integer_t actdist = igraph_dqueue_int_pop(&q);
-
-            if (cutoff >= 0 && actdist > cutoff) {
-                continue;
-            }
-
-            if (all_to) {
-                MATRIX(*res, i, act) = actdist;
-            } else {
-                if (VECTOR(indexv)[act]) {
-                    MATRIX(*res, i, VECTOR(indexv)[act] - 1) = actdist;
-                    reached++;
-                    if (reached == no_of_to) {
-                        igraph_dqueue_int_clear(&q);
-                        break;
-                    }
-                }
-            }
-
-            neis = igraph_adjlist_get(&adjlist, act);
-            igraph_integer_t nei_count = igraph_vector_int_size(neis);
-            for (j = 0; j < nei_count; j++) {
-                igraph_integer_t neighbor = VECTOR(*neis)[j];
-                if (already_counted[neighbor] == i + 1) {
-                    continue;
-                }
-                already_counted[neighbor] = i + 1;
-                IGRAPH_CHECK(igraph_dqueue_int_push(&q, neighbor));
-                IGRAPH_CHECK(igraph_dqueue_int_push(&q, actdist + 1));
-            }
-        }
+    /* Multi-source searches cannot stop early when only a few targets are
+     * given, so they are used only with many sources and targets. */
+    if (no_of_from >= IGRAPH_I_MSBFS_MIN_SOURCES && no_of_to >= IGRAPH_I_MSBFS_MIN_SOURCES) {
+        IGRAPH_CHECK(igraph_i_distances_multi(&csr, res, &fromvit,
+                                              all_to ? NULL : &indexv, int_cutoff));
+    } else {
+        IGRAPH_CHECK(igraph_i_distances_single(graph, &csr, mode, res, &fromvit,
+                                               all_to ? NULL : &indexv, all_to ? NULL : &targets,
+                                               no_of_to, int_cutoff));
     }
 
     /* Clean */
     if (!all_to) {
         igraph_vit_destroy(&tovit);
+        igraph_bitset_destroy(&targets);
         igraph_vector_int_destroy(&indexv);
-        IGRAPH_FINALLY_CLEAN(2);
+        IGRAPH_FINALLY_CLEAN(3);
     }
 
-    IGRAPH_FREE(already_counted);
-    igraph_dqueue_int_destroy(&q);
     igraph_vit_destroy(&fromvit);
-    igraph_adjlist_destroy(&adjlist);
-    IGRAPH_FINALLY_CLEAN(4);
+    igraph_csr_destroy(&csr);
+    IGRAPH_FINALLY_CLEAN(2);
 
     return IGRAPH_SUCCESS;
 }
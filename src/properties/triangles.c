@@ -31,6 +31,7 @@
 #include "igraph_structural.h"
 
 #include "core/interruption.h"
+#include "core/workspace.h"
 #include "properties/properties_internal.h"
 
 /**
@@ -116,7 +117,8 @@ igraph_error_t igraph_transitivity_avglocal_undirected(const igraph_t *graph,
 static igraph_error_t transitivity_local_undirected1(const igraph_t *graph,
         igraph_vector_t *res,
         const igraph_vs_t vids,
-        igraph_transitivity_mode_t mode) {
+        igraph_transitivity_mode_t mode,
+        igraph_workspace_t *ws) {
 
 #define TRANSIT
 #include "properties/triangles_template1.h"
@@ -128,7 +130,8 @@ static igraph_error_t transitivity_local_undirected1(const igraph_t *graph,
 static igraph_error_t transitivity_local_undirected2(const igraph_t *graph,
         igraph_vector_t *res,
         const igraph_vs_t vids,
-        igraph_transitivity_mode_t mode) {
+        igraph_transitivity_mode_t mode,
+        igraph_workspace_t *ws) {
 
     igraph_integer_t no_of_nodes = igraph_vcount(graph);
     igraph_vit_t vit;
@@ -136,10 +139,19 @@ static igraph_error_t transitivity_local_undirected2(const igraph_t *graph,
     igraph_integer_t maxdegree = 0;
     igraph_integer_t i, j, k, nn;
     igraph_lazy_adjlist_t adjlist;
-    igraph_vector_int_t degree;
-    igraph_vector_t indexv, avids, rank, triangles;
-    igraph_vector_int_t order;
+    igraph_vector_int_t *degree;
+    igraph_vector_t *indexv, *avids, *rank, *triangles;
+    igraph_vector_int_t *order, *neis_vec;
     igraph_integer_t *neis;
+    igraph_workspace_t local_ws;
+
+    if (ws) {
+        igraph_i_workspace_reset(ws);
+    } else {
+        IGRAPH_CHECK(igraph_workspace_init(&local_ws));
+        IGRAPH_FINALLY(igraph_workspace_destroy, &local_ws);
+        ws = &local_ws;
+    }
 
     IGRAPH_CHECK(igraph_vit_create(graph, vids, &vit));
     IGRAPH_FINALLY(igraph_vit_destroy, &vit);
@@ -148,17 +160,17 @@ static igraph_error_t transitivity_local_undirected2(const igraph_t *graph,
     IGRAPH_CHECK(igraph_lazy_adjlist_init(graph, &adjlist, IGRAPH_ALL, IGRAPH_NO_LOOPS, IGRAPH_NO_MULTIPLE));
     IGRAPH_FINALLY(igraph_lazy_adjlist_destroy, &adjlist);
 
-    IGRAPH_VECTOR_INIT_FINALLY(&indexv, no_of_nodes);
-    IGRAPH_VECTOR_INIT_FINALLY(&avids, 0);
-    IGRAPH_CHECK(igraph_vector_reserve(&avids, nodes_to_calc));
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, no_of_nodes, &indexv));
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, 0, &avids));
+    IGRAPH_CHECK(igraph_vector_reserve(avids, nodes_to_calc));
     k = 0;
     for (i = 0; i < nodes_to_calc; IGRAPH_VIT_NEXT(vit), i++) {
         igraph_integer_t v = IGRAPH_VIT_GET(vit);
         igraph_vector_int_t *neis2;
         igraph_integer_t neilen;
-        if (VECTOR(indexv)[v] == 0) {
-            VECTOR(indexv)[v] = k + 1; k++;
-            IGRAPH_CHECK(igraph_vector_push_back(&avids, v));
+        if (VECTOR(*indexv)[v] == 0) {
+            VECTOR(*indexv)[v] = k + 1; k++;
+            IGRAPH_CHECK(igraph_vector_push_back(avids, v));
         }
 
         neis2 = igraph_lazy_adjlist_get(&adjlist, v);
@@ -167,49 +179,44 @@ static igraph_error_t transitivity_local_undirected2(const igraph_t *graph,
         neilen = igraph_vector_int_size(neis2);
         for (j = 0; j < neilen; j++) {
             igraph_integer_t nei = VECTOR(*neis2)[j];
-            if (VECTOR(indexv)[nei] == 0) {
-                VECTOR(indexv)[nei] = k + 1; k++;
-                IGRAPH_CHECK(igraph_vector_push_back(&avids, nei));
+            if (VECTOR(*indexv)[nei] == 0) {
+                VECTOR(*indexv)[nei] = k + 1; k++;
+                IGRAPH_CHECK(igraph_vector_push_back(avids, nei));
             }
         }
     }
 
     /* Degree, ordering, ranking */
-    affected_nodes = igraph_vector_size(&avids);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&order, 0);
-    IGRAPH_VECTOR_INT_INIT_FINALLY(&degree, affected_nodes);
+    affected_nodes = igraph_vector_size(avids);
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, 0, &order));
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, affected_nodes, &degree));
     for (i = 0; i < affected_nodes; i++) {
-        igraph_integer_t v = VECTOR(avids)[i];
+        igraph_integer_t v = VECTOR(*avids)[i];
         igraph_vector_int_t *neis2;
         igraph_integer_t deg;
         neis2 = igraph_lazy_adjlist_get(&adjlist, v);
         IGRAPH_CHECK_OOM(neis2, "Failed to query neighbors.");
-        VECTOR(degree)[i] = deg = igraph_vector_int_size(neis2);
+        VECTOR(*degree)[i] = deg = igraph_vector_int_size(neis2);
         if (deg > maxdegree) {
             maxdegree = deg;
         }
     }
-    IGRAPH_CHECK(igraph_vector_int_order1(&degree, &order, maxdegree + 1));
-    igraph_vector_int_destroy(&degree);
-    IGRAPH_FINALLY_CLEAN(1);
-    IGRAPH_VECTOR_INIT_FINALLY(&rank, affected_nodes);
+    IGRAPH_CHECK(igraph_vector_int_order1(degree, order, maxdegree + 1));
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, affected_nodes, &rank));
     for (i = 0; i < affected_nodes; i++) {
-        VECTOR(rank)[ VECTOR(order)[i] ] = affected_nodes - i - 1;
+        VECTOR(*rank)[ VECTOR(*order)[i] ] = affected_nodes - i - 1;
     }
 
-    neis = IGRAPH_CALLOC(no_of_nodes, igraph_integer_t);
-    if (neis == 0) {
-        IGRAPH_ERROR("Insufficient memory for local transitivity calculation.", IGRAPH_ENOMEM); /* LCOV_EXCL_LINE */
-    }
-    IGRAPH_FINALLY(igraph_free, neis);
+    IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, no_of_nodes, &neis_vec));
+    neis = VECTOR(*neis_vec);
 
-    IGRAPH_VECTOR_INIT_FINALLY(&triangles, affected_nodes);
+    IGRAPH_CHECK(igraph_i_workspace_vector(ws, affected_nodes, &triangles));
     for (nn = affected_nodes - 1; nn >= 0; nn--) {
-        igraph_integer_t node = VECTOR(avids) [ VECTOR(order)[nn] ];
+        igraph_integer_t node = VECTOR(*avids) [ VECTOR(*order)[nn] ];
         igraph_vector_int_t *neis1, *neis2;
         igraph_integer_t neilen1, neilen2;
-        igraph_integer_t nodeindex = VECTOR(indexv)[node];
-        igraph_integer_t noderank = VECTOR(rank) [nodeindex - 1];
+        igraph_integer_t nodeindex = VECTOR(*indexv)[node];
+        igraph_integer_t noderank = VECTOR(*rank) [nodeindex - 1];
 
         IGRAPH_ALLOW_INTERRUPTION();
 
@@ -223,8 +230,15 @@ static igraph_error_t transitivity_local_undirected2(const igraph_t *graph,
         }
         for (i = 0; i < neilen1; i++) {
             igraph_integer_t nei = VECTOR(*neis1)[i];
-            igraph_integer_t neiindex = VECTOR(indexv)[nei];
-            igraph_integer_t neirank = VECTOR(rank)[neiindex - 1];
+            igraph_integer_t neiindex = VECTOR(*indexv)[nei];
+            igraph_integer_t neirank;
+
+            /* Triangles with a vertex that is neither a requested vertex nor
+             * the neighbor of one are not needed. */
+            if (neiindex == 0) {
+                continue;
+            }
+            neirank = VECTOR(*rank)[neiindex - 1];
 
             /*       fprintf(stderr, "  nei %li (indexv %li, rank %li)\n", nei, */
             /*        neiindex, neirank); */
@@ -234,17 +248,21 @@ static igraph_error_t transitivity_local_undirected2(const igraph_t *graph,
                 neilen2 = igraph_vector_int_size(neis2);
                 for (j = 0; j < neilen2; j++) {
                     igraph_integer_t nei2 = VECTOR(*neis2)[j];
-                    igraph_integer_t nei2index = VECTOR(indexv)[nei2];
-                    igraph_integer_t nei2rank = VECTOR(rank)[nei2index - 1];
+                    igraph_integer_t nei2index = VECTOR(*indexv)[nei2];
+                    igraph_integer_t nei2rank;
+                    if (nei2index == 0) {
+                        continue;
+                    }
+                    nei2rank = VECTOR(*rank)[nei2index - 1];
                     /*    fprintf(stderr, "    triple %li %li %li\n", node, nei, nei2); */
                     if (nei2rank < neirank) {
                         continue;
                     }
                     if (neis[nei2] == node + 1) {
                         /*      fprintf(stderr, "    triangle\n"); */
-                        VECTOR(triangles) [ nei2index - 1 ] += 1;
-                        VECTOR(triangles) [ neiindex - 1 ] += 1;
-                        VECTOR(triangles) [ nodeindex - 1 ] += 1;
+                        VECTOR(*triangles) [ nei2index - 1 ] += 1;
+                        VECTOR(*triangles) [ neiindex - 1 ] += 1;
+                        VECTOR(*triangles) [ nodeindex - 1 ] += 1;
                     }
                 }
             }
@@ -257,7 +275,7 @@ static igraph_error_t transitivity_local_undirected2(const igraph_t *graph,
     IGRAPH_VIT_RESET(vit);
     for (i = 0; i < nodes_to_calc; i++, IGRAPH_VIT_NEXT(vit)) {
         igraph_integer_t node = IGRAPH_VIT_GET(vit);
-        igraph_integer_t idx = VECTOR(indexv)[node] - 1;
+        igraph_integer_t idx = VECTOR(*indexv)[node] - 1;
         igraph_vector_int_t *neis2 = igraph_lazy_adjlist_get(&adjlist, node);
         igraph_integer_t deg;
 
@@ -267,20 +285,19 @@ static igraph_error_t transitivity_local_undirected2(const igraph_t *graph,
         if (mode == IGRAPH_TRANSITIVITY_ZERO && deg < 2) {
             VECTOR(*res)[i] = 0.0;
         } else {
-            VECTOR(*res)[i] = VECTOR(triangles)[idx] / deg / (deg - 1) * 2.0;
+            VECTOR(*res)[i] = VECTOR(*triangles)[idx] / deg / (deg - 1) * 2.0;
         }
-        /*     fprintf(stderr, "%f %f\n", VECTOR(triangles)[idx], triples); */
+        /*     fprintf(stderr, "%f %f\n", VECTOR(*triangles)[idx], triples); */
     }
 
-    igraph_vector_destroy(&triangles);
-    igraph_free(neis);
-    igraph_vector_destroy(&rank);
-    igraph_vector_int_destroy(&order);
-    igraph_vector_destroy(&avids);
-    igraph_vector_destroy(&indexv);
     igraph_lazy_adjlist_destroy(&adjlist);
     igraph_vit_destroy(&vit);
-    IGRAPH_FINALLY_CLEAN(8);
+    IGRAPH_FINALLY_CLEAN(2);
+
+    if (ws == &local_ws) {
+        igraph_workspace_destroy(&local_ws);
+        IGRAPH_FINALLY_CLEAN(1);
+    }
 
     return IGRAPH_SUCCESS;
 }
@@ -376,6 +393,41 @@ igraph_error_t igraph_transitivity_local_undirected(const igraph_t *graph,
         igraph_vector_t *res,
         const igraph_vs_t vids,
         igraph_transitivity_mode_t mode) {
+    return igraph_transitivity_local_undirected_ws(graph, res, vids, mode, NULL);
+}
+
+/**
+ * \function igraph_transitivity_local_undirected_ws
+ * \brief The local transitivity of some vertices, reusing temporary memory.
+ *
+ * \experimental
+ *
+ * This function is identical to \ref igraph_transitivity_local_undirected(),
+ * but it keeps its temporary data structures, which are proportional to
+ * the number of vertices, in a workspace. This is useful when the local
+ * transitivity of a few vertices at a time is queried many times in the same
+ * graph. When \p vids contains all vertices, the workspace is not used.
+ *
+ * \param graph The input graph. Edge directions and multiplicities are ignored.
+ * \param res Pointer to an initialized vector, the result will be
+ *   stored here. It will be resized as needed.
+ * \param vids Vertex set, the vertices for which the local
+ *   transitivity will be calculated.
+ * \param mode Defines how to treat vertices with degree less than two.
+ *    \c IGRAPH_TRANSITIVITY_NAN returns \c NaN for these vertices,
+ *    \c IGRAPH_TRANSITIVITY_ZERO returns zero.
+ * \param ws An initialized workspace, or a null pointer to allocate
+ *    temporary memory for this call only. See \ref igraph_workspace_init().
+ * \return Error code.
+ *
+ * Time complexity: see \ref igraph_transitivity_local_undirected().
+ */
+
+igraph_error_t igraph_transitivity_local_undirected_ws(const igraph_t *graph,
+        igraph_vector_t *res,
+        const igraph_vs_t vids,
+        igraph_transitivity_mode_t mode,
+        igraph_workspace_t *ws) {
 
     if (igraph_vs_is_all(&vids)) {
         return transitivity_local_undirected4(graph, res, mode);
@@ -388,9 +440,9 @@ igraph_error_t igraph_transitivity_local_undirected(const igraph_t *graph,
         igraph_vit_destroy(&vit);
         IGRAPH_FINALLY_CLEAN(1);
         if (size < 100) {
-            return transitivity_local_undirected1(graph, res, vids, mode);
+            return transitivity_local_undirected1(graph, res, vids, mode, ws);
         } else {
-            return transitivity_local_undirected2(graph, res, vids, mode);
+            return transitivity_local_undirected2(graph, res, vids, mode, ws);
         }
     }
 }
@@ -398,6 +450,7 @@ igraph_error_t igraph_transitivity_local_undirected(const igraph_t *graph,
 static igraph_error_t adjacent_triangles1(const igraph_t *graph,
                                       igraph_vector_t *res,
                                       const igraph_vs_t vids) {
+    igraph_workspace_t *ws = NULL;
 # include "properties/triangles_template1.h"
     return IGRAPH_SUCCESS;
 }
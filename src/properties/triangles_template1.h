@@ -30,7 +30,9 @@ igraph_real_t triangles;
 igraph_integer_t i, j, k;
 igraph_integer_t neilen1, neilen2;
 igraph_integer_t *neis;
+igraph_vector_int_t *neis_vec;
 igraph_lazy_adjlist_t adjlist;
+igraph_workspace_t local_ws;
 
 IGRAPH_CHECK(igraph_vit_create(graph, vids, &vit));
 IGRAPH_FINALLY(igraph_vit_destroy, &vit);
@@ -43,9 +45,17 @@ if (nodes_to_calc == 0) {
     return IGRAPH_SUCCESS;
 }
 
-neis = IGRAPH_CALLOC(no_of_nodes, igraph_integer_t);
-IGRAPH_CHECK_OOM(neis, "Insufficient memory to count triangles.");
-IGRAPH_FINALLY(igraph_free, neis);
+/* 'ws' is provided by the including function, and may be NULL. */
+if (ws) {
+    igraph_i_workspace_reset(ws);
+} else {
+    IGRAPH_CHECK(igraph_workspace_init(&local_ws));
+    IGRAPH_FINALLY(igraph_workspace_destroy, &local_ws);
+    ws = &local_ws;
+}
+
+IGRAPH_CHECK(igraph_i_workspace_vector_int(ws, no_of_nodes, &neis_vec));
+neis = VECTOR(*neis_vec);
 
 IGRAPH_CHECK(igraph_vector_resize(res, nodes_to_calc));
 
@@ -90,6 +100,10 @@ for (i = 0; !IGRAPH_VIT_END(vit); IGRAPH_VIT_NEXT(vit), i++) {
 }
 
 igraph_lazy_adjlist_destroy(&adjlist);
-IGRAPH_FREE(neis);
+IGRAPH_FINALLY_CLEAN(1);
+if (ws == &local_ws) {
+    igraph_workspace_destroy(&local_ws);
+    IGRAPH_FINALLY_CLEAN(1);
+}
 igraph_vit_destroy(&vit);
-IGRAPH_FINALLY_CLEAN(3);
+IGRAPH_FINALLY_CLEAN(1);
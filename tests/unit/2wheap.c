@@ -164,6 +164,29 @@ int main(void) {
 
     igraph_2wheap_destroy(&Q);
 
+    /* Clearing, with and without deactivated elements */
+
+    igraph_2wheap_init(&Q, 10);
+    for (i = 0; i < 10; i += 2) {
+        igraph_2wheap_push_with_index(&Q, i, i);
+    }
+    igraph_2wheap_delete_max(&Q);
+    igraph_2wheap_clear(&Q);
+    for (i = 0; i < 10; i++) {
+        IGRAPH_ASSERT(!igraph_2wheap_has_elem(&Q, i));
+    }
+    for (i = 0; i < 10; i += 3) {
+        igraph_2wheap_push_with_index(&Q, i, i);
+    }
+    igraph_2wheap_deactivate_max(&Q);
+    IGRAPH_ASSERT(igraph_2wheap_has_elem(&Q, 9) && !igraph_2wheap_has_active(&Q, 9));
+    igraph_2wheap_clear(&Q);
+    IGRAPH_ASSERT(igraph_2wheap_empty(&Q));
+    for (i = 0; i < 10; i++) {
+        IGRAPH_ASSERT(!igraph_2wheap_has_elem(&Q, i));
+    }
+    igraph_2wheap_destroy(&Q);
+
     VERIFY_FINALLY_STACK();
 
     RNG_END();
@@ -0,0 +1,109 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Adding edges in small batches merges them into the existing indices.
+ * The result must be identical to building the graph in one step. */
+
+static void check_same_indices(const igraph_t *g1, const igraph_t *g2) {
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->from, &g2->from));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->to, &g2->to));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->oi, &g2->oi));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->ii, &g2->ii));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->os, &g2->os));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->is, &g2->is));
+}
+
+static void test_batches(igraph_bool_t directed, igraph_integer_t no_of_nodes,
+                         igraph_integer_t no_of_edges, igraph_integer_t batch_size) {
+    igraph_t g, ref;
+    igraph_vector_int_t edges, batch;
+    igraph_integer_t i;
+
+    /* Random multigraph with self-loops, concentrated on a few vertices
+     * so that there are many parallel edges. */
+    igraph_vector_int_init(&edges, 2 * no_of_edges);
+    for (i = 0; i < 2 * no_of_edges; i++) {
+        VECTOR(edges)[i] = RNG_INTEGER(0, i % 3 == 0 ? 3 : no_of_nodes - 1);
+    }
+
+    igraph_create(&ref, &edges, no_of_nodes, directed);
+
+    /* Start with a large enough graph so that later batches are merged. */
+    igraph_vector_int_init(&batch, 0);
+    igraph_vector_int_update(&batch, &edges);
+    igraph_vector_int_resize(&batch, no_of_edges);
+    igraph_create(&g, &batch, no_of_nodes, directed);
+
+    for (i = no_of_edges / 2; i < no_of_edges; i += batch_size) {
+        igraph_integer_t end = i + batch_size < no_of_edges ? i + batch_size : no_of_edges;
+        igraph_vector_int_resize(&batch, 2 * (end - i));
+        for (igraph_integer_t j = 2 * i; j < 2 * end; j++) {
+            VECTOR(batch)[j - 2 * i] = VECTOR(edges)[j];
+        }
+        igraph_add_edges(&g, &batch, NULL);
+    }
+
+    check_same_indices(&g, &ref);
+
+    igraph_destroy(&g);
+    igraph_destroy(&ref);
+    igraph_vector_int_destroy(&batch);
+    igraph_vector_int_destroy(&edges);
+}
+
+int main(void) {
+    igraph_t g, ref;
+    igraph_vector_int_t edges;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    test_batches(IGRAPH_DIRECTED, 50, 1000, 1);
+    test_batches(IGRAPH_DIRECTED, 50, 1000, 7);
+    test_batches(IGRAPH_UNDIRECTED, 50, 1000, 1);
+    test_batches(IGRAPH_UNDIRECTED, 50, 1000, 13);
+    test_batches(IGRAPH_DIRECTED, 1000, 2000, 10);
+    test_batches(IGRAPH_UNDIRECTED, 1000, 2000, 10);
+
+    /* Edges incident on the first and the last vertex, and edges added
+     * after isolated vertices. */
+    igraph_small(&g, 6, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,3, 3,4, 1,2, 0,1, 4,1, 2,2, 3,1, 1,4, 2,4, 0,4, 1,3, 3,2, 2,1, 1,1, 0,0,
+                 -1);
+    igraph_vector_int_init_int(&edges, 4, 5, 5, 0, 1);
+    igraph_add_edges(&g, &edges, NULL);
+    igraph_small(&ref, 6, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,3, 3,4, 1,2, 0,1, 4,1, 2,2, 3,1, 1,4, 2,4, 0,4, 1,3, 3,2, 2,1, 1,1, 0,0,
+                 5,5, 0,1,
+                 -1);
+    check_same_indices(&g, &ref);
+    igraph_destroy(&ref);
+
+    /* Batch validation still happens before the graph is touched. */
+    VECTOR(edges)[3] = 6;
+    CHECK_ERROR(igraph_add_edges(&g, &edges, NULL), IGRAPH_EINVVID);
+    IGRAPH_ASSERT(igraph_ecount(&g) == 19);
+
+    igraph_vector_int_destroy(&edges);
+    igraph_destroy(&g);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,123 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Checks that the estimates are within the returned error bound. The RNG
+ * is seeded, so the test is deterministic even though the guarantee is
+ * only probabilistic. */
+static void check_bound(const igraph_t *graph, igraph_bool_t directed, const igraph_vector_t *weights,
+                        igraph_real_t epsilon, igraph_real_t delta) {
+    igraph_vector_t exact, approx;
+    igraph_real_t bound, pairs;
+    igraph_integer_t n = igraph_vcount(graph), samples;
+
+    igraph_vector_init(&exact, 0);
+    igraph_vector_init(&approx, 0);
+
+    igraph_betweenness(graph, &exact, igraph_vss_all(), directed, weights);
+    igraph_betweenness_approx(graph, &approx, igraph_vss_all(), directed, weights,
+                              epsilon, delta, &bound, &samples);
+
+    pairs = (igraph_real_t) n * (n - 1);
+    if (!directed || !igraph_is_directed(graph)) {
+        pairs /= 2;
+    }
+
+    IGRAPH_ASSERT(samples > 0 && samples < n);
+    IGRAPH_ASSERT(bound > 0 && bound <= epsilon * pairs);
+    for (igraph_integer_t i = 0; i < n; i++) {
+        IGRAPH_ASSERT(fabs(VECTOR(exact)[i] - VECTOR(approx)[i]) <= bound);
+    }
+
+    igraph_vector_destroy(&approx);
+    igraph_vector_destroy(&exact);
+}
+
+int main(void) {
+    igraph_t g;
+    igraph_vector_t res, weights;
+    igraph_real_t bound;
+    igraph_integer_t samples;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    igraph_vector_init(&res, 0);
+
+    printf("Small graph, exact result is computed:\n");
+    igraph_star(&g, 6, IGRAPH_STAR_UNDIRECTED, 0);
+    igraph_betweenness_approx(&g, &res, igraph_vss_all(), IGRAPH_UNDIRECTED, NULL,
+                              0.1, 0.1, &bound, &samples);
+    print_vector(&res);
+    printf("bound: %g, samples: %" IGRAPH_PRId "\n", bound, samples);
+    igraph_destroy(&g);
+
+    printf("\nNo paths of length two, exact result is computed:\n");
+    igraph_full(&g, 500, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    igraph_betweenness_approx(&g, &res, igraph_vss_range(0, 3), IGRAPH_UNDIRECTED, NULL,
+                              0.01, 0.1, &bound, &samples);
+    print_vector(&res);
+    printf("bound: %g, samples: %" IGRAPH_PRId "\n", bound, samples);
+    igraph_destroy(&g);
+
+    printf("\nNull graph:\n");
+    igraph_empty(&g, 0, IGRAPH_DIRECTED);
+    igraph_betweenness_approx(&g, &res, igraph_vss_all(), IGRAPH_DIRECTED, NULL,
+                              0.1, 0.1, NULL, NULL);
+    print_vector(&res);
+    igraph_destroy(&g);
+
+    /* Sampling is used from here. */
+    {
+        igraph_vector_int_t dims;
+        igraph_vector_int_init_int(&dims, 2, 50, 50);
+        igraph_square_lattice(&g, &dims, 1, IGRAPH_UNDIRECTED, false, NULL);
+        igraph_vector_int_destroy(&dims);
+    }
+    check_bound(&g, IGRAPH_UNDIRECTED, NULL, 0.1, 0.1);
+    igraph_betweenness_approx(&g, &res, igraph_vss_all(), IGRAPH_UNDIRECTED, NULL,
+                              0.1, 0.1, &bound, &samples);
+    printf("\nLattice: samples: %" IGRAPH_PRId "\n", samples);
+    igraph_destroy(&g);
+
+    igraph_erdos_renyi_game_gnm(&g, 2000, 4000, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    check_bound(&g, IGRAPH_DIRECTED, NULL, 0.1, 0.1);
+    check_bound(&g, IGRAPH_UNDIRECTED, NULL, 0.1, 0.1);
+    igraph_vector_init(&weights, igraph_ecount(&g));
+    for (igraph_integer_t i = 0; i < igraph_ecount(&g); i++) {
+        VECTOR(weights)[i] = RNG_INTEGER(1, 3);
+    }
+    check_bound(&g, IGRAPH_DIRECTED, &weights, 0.1, 0.1);
+
+    printf("\nErrors:\n");
+    CHECK_ERROR(igraph_betweenness_approx(&g, &res, igraph_vss_all(), IGRAPH_DIRECTED, NULL,
+                                          0, 0.1, NULL, NULL), IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_betweenness_approx(&g, &res, igraph_vss_all(), IGRAPH_DIRECTED, NULL,
+                                          0.1, 1, NULL, NULL), IGRAPH_EINVAL);
+    VECTOR(weights)[0] = -1;
+    CHECK_ERROR(igraph_betweenness_approx(&g, &res, igraph_vss_all(), IGRAPH_DIRECTED, &weights,
+                                          0.1, 0.1, NULL, NULL), IGRAPH_EINVAL);
+
+    igraph_vector_destroy(&weights);
+    igraph_destroy(&g);
+    igraph_vector_destroy(&res);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
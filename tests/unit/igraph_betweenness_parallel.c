@@ -0,0 +1,130 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* This test is run with several OpenMP threads when igraph is compiled with
+ * OpenMP support. The results are compared to those of the subset functions,
+ * which are computed serially, over all sources and targets. */
+
+static void check_vertex(const igraph_t *graph, igraph_bool_t directed, const igraph_vector_t *weights) {
+    igraph_vector_t res, ref;
+
+    igraph_vector_init(&res, 0);
+    igraph_vector_init(&ref, 0);
+
+    igraph_betweenness(graph, &res, igraph_vss_all(), directed, weights);
+    igraph_betweenness_subset(graph, &ref, igraph_vss_all(), directed,
+                              igraph_vss_all(), igraph_vss_all(), weights);
+    IGRAPH_ASSERT(igraph_vector_all_almost_e(&res, &ref, 1e-10));
+
+    /* Same results for a vertex subset. */
+    igraph_betweenness(graph, &res, igraph_vss_range(3, 17), directed, weights);
+    IGRAPH_ASSERT(igraph_vector_size(&res) == 14);
+    for (igraph_integer_t i = 0; i < 14; i++) {
+        IGRAPH_ASSERT(igraph_almost_equals(VECTOR(res)[i], VECTOR(ref)[i + 3], 1e-10));
+    }
+
+    igraph_vector_destroy(&ref);
+    igraph_vector_destroy(&res);
+}
+
+static void check_edge(const igraph_t *graph, igraph_bool_t directed, const igraph_vector_t *weights) {
+    igraph_vector_t res, ref;
+
+    igraph_vector_init(&res, 0);
+    igraph_vector_init(&ref, 0);
+
+    igraph_edge_betweenness(graph, &res, directed, weights);
+    igraph_edge_betweenness_subset(graph, &ref, igraph_ess_all(IGRAPH_EDGEORDER_ID), directed,
+                                   igraph_vss_all(), igraph_vss_all(), weights);
+    IGRAPH_ASSERT(igraph_vector_all_almost_e(&res, &ref, 1e-10));
+
+    igraph_vector_destroy(&ref);
+    igraph_vector_destroy(&res);
+}
+
+static void check_graph(const igraph_t *graph) {
+    igraph_vector_t weights;
+    igraph_integer_t no_of_edges = igraph_ecount(graph);
+
+    igraph_vector_init(&weights, no_of_edges);
+    for (igraph_integer_t i = 0; i < no_of_edges; i++) {
+        VECTOR(weights)[i] = RNG_INTEGER(1, 5);
+    }
+
+    check_vertex(graph, true, NULL);
+    check_vertex(graph, false, NULL);
+    check_vertex(graph, true, &weights);
+    check_edge(graph, true, NULL);
+    check_edge(graph, false, NULL);
+    check_edge(graph, true, &weights);
+
+    igraph_vector_destroy(&weights);
+}
+
+int main(void) {
+    igraph_t g;
+    igraph_vector_t res;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    igraph_vector_init(&res, 0);
+
+    printf("Star, vertex betweenness:\n");
+    igraph_star(&g, 7, IGRAPH_STAR_UNDIRECTED, 0);
+    igraph_betweenness(&g, &res, igraph_vss_all(), IGRAPH_UNDIRECTED, NULL);
+    print_vector(&res);
+    igraph_destroy(&g);
+
+    printf("\nPath, edge betweenness with cutoff 2:\n");
+    igraph_ring(&g, 6, IGRAPH_UNDIRECTED, false, false);
+    igraph_edge_betweenness_cutoff(&g, &res, IGRAPH_UNDIRECTED, NULL, 2);
+    print_vector(&res);
+    igraph_destroy(&g);
+
+    printf("\nSingle vertex:\n");
+    igraph_empty(&g, 1, IGRAPH_DIRECTED);
+    igraph_betweenness(&g, &res, igraph_vss_all(), IGRAPH_DIRECTED, NULL);
+    print_vector(&res);
+    igraph_edge_betweenness(&g, &res, IGRAPH_DIRECTED, NULL);
+    print_vector(&res);
+    igraph_destroy(&g);
+
+    igraph_vector_destroy(&res);
+
+    igraph_erdos_renyi_game_gnm(&g, 200, 600, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    check_graph(&g);
+    igraph_destroy(&g);
+
+    igraph_erdos_renyi_game_gnm(&g, 150, 300, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    check_graph(&g);
+    igraph_destroy(&g);
+
+    /* Fewer vertices than threads. */
+    igraph_small(&g, 2, IGRAPH_DIRECTED, 0,1, -1);
+    igraph_vector_init(&res, 0);
+    igraph_betweenness(&g, &res, igraph_vss_all(), IGRAPH_DIRECTED, NULL);
+    IGRAPH_ASSERT(VECTOR(res)[0] == 0 && VECTOR(res)[1] == 0);
+    igraph_vector_destroy(&res);
+    igraph_destroy(&g);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,177 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Queries on the contraction hierarchy must give the same distances as
+ * Dijkstra's algorithm, and the unpacked paths must be valid walks of
+ * that length in the original graph. */
+static void check_ch(const igraph_t *graph, const igraph_vector_t *weights,
+                     igraph_neimode_t mode) {
+    igraph_integer_t n = igraph_vcount(graph);
+    igraph_ch_index_t index;
+    igraph_matrix_t dist;
+    igraph_vector_int_t vertices, edges;
+
+    igraph_matrix_init(&dist, 0, 0);
+    igraph_vector_int_init(&vertices, 0);
+    igraph_vector_int_init(&edges, 0);
+
+    igraph_distances_dijkstra(graph, &dist, igraph_vss_all(), igraph_vss_all(), weights, mode);
+    igraph_ch_index_build(&index, graph, weights, mode);
+
+    for (igraph_integer_t from = 0; from < n; from++) {
+        for (igraph_integer_t to = 0; to < n; to++) {
+            igraph_real_t d, length = 0;
+            igraph_integer_t path_len;
+
+            igraph_ch_index_distance(&index, &d, from, to);
+            IGRAPH_ASSERT(igraph_cmp_epsilon(d, MATRIX(dist, from, to), 1e-12) == 0);
+
+            igraph_ch_index_get_path(&index, &vertices, &edges, from, to);
+            if (MATRIX(dist, from, to) == IGRAPH_INFINITY) {
+                IGRAPH_ASSERT(igraph_vector_int_size(&vertices) == 0);
+                IGRAPH_ASSERT(igraph_vector_int_size(&edges) == 0);
+                continue;
+            }
+
+            path_len = igraph_vector_int_size(&edges);
+            IGRAPH_ASSERT(igraph_vector_int_size(&vertices) == path_len + 1);
+            IGRAPH_ASSERT(VECTOR(vertices)[0] == from);
+            IGRAPH_ASSERT(VECTOR(vertices)[path_len] == to);
+            for (igraph_integer_t i = 0; i < path_len; i++) {
+                igraph_integer_t e = VECTOR(edges)[i];
+                igraph_integer_t u = VECTOR(vertices)[i], v = VECTOR(vertices)[i + 1];
+                if (mode == IGRAPH_OUT || !igraph_is_directed(graph)) {
+                    IGRAPH_ASSERT((IGRAPH_FROM(graph, e) == u && IGRAPH_TO(graph, e) == v) ||
+                                  (!igraph_is_directed(graph) &&
+                                   IGRAPH_FROM(graph, e) == v && IGRAPH_TO(graph, e) == u));
+                } else if (mode == IGRAPH_IN) {
+                    IGRAPH_ASSERT(IGRAPH_FROM(graph, e) == v && IGRAPH_TO(graph, e) == u);
+                } else {
+                    IGRAPH_ASSERT(IGRAPH_OTHER(graph, e, u) == v);
+                }
+                length += weights ? VECTOR(*weights)[e] : 1;
+            }
+            IGRAPH_ASSERT(igraph_cmp_epsilon(length, MATRIX(dist, from, to), 1e-12) == 0);
+        }
+    }
+
+    igraph_ch_index_destroy(&index);
+    igraph_vector_int_destroy(&edges);
+    igraph_vector_int_destroy(&vertices);
+    igraph_matrix_destroy(&dist);
+}
+
+int main(void) {
+    igraph_t graph;
+    igraph_vector_t weights;
+    igraph_vector_int_t vertices, edges, dims;
+    igraph_ch_index_t index;
+    igraph_real_t d;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_set_warning_handler(igraph_warning_handler_ignore);
+
+    igraph_vector_int_init(&vertices, 0);
+    igraph_vector_int_init(&edges, 0);
+
+    printf("Path through a shortcut:\n");
+    igraph_small(&graph, 6, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,3, 3,4, 0,4, 4,5, 2,2, 1,2,
+                 -1);
+    igraph_vector_init_int(&weights, 8, 1, 1, 1, 1, 5, 1, 0, 3);
+    igraph_ch_index_build(&index, &graph, &weights, IGRAPH_OUT);
+    igraph_ch_index_distance(&index, &d, 0, 5);
+    printf("Distance 0 -> 5: %g\n", d);
+    igraph_ch_index_get_path(&index, &vertices, &edges, 0, 5);
+    print_vector_int(&vertices);
+    print_vector_int(&edges);
+    igraph_ch_index_distance(&index, &d, 5, 0);
+    printf("Distance 5 -> 0: %g\n", d);
+    igraph_ch_index_get_path(&index, &vertices, &edges, 3, 3);
+    print_vector_int(&vertices);
+    print_vector_int(&edges);
+    igraph_ch_index_destroy(&index);
+
+    printf("Reversed:\n");
+    igraph_ch_index_build(&index, &graph, &weights, IGRAPH_IN);
+    igraph_ch_index_get_path(&index, &vertices, &edges, 5, 0);
+    print_vector_int(&vertices);
+    print_vector_int(&edges);
+    igraph_ch_index_destroy(&index);
+
+    printf("Errors:\n");
+    CHECK_ERROR(igraph_ch_index_build(&index, &graph, &weights, (igraph_neimode_t) 42), IGRAPH_EINVMODE);
+    VECTOR(weights)[2] = -1;
+    CHECK_ERROR(igraph_ch_index_build(&index, &graph, &weights, IGRAPH_OUT), IGRAPH_EINVAL);
+    VECTOR(weights)[2] = IGRAPH_NAN;
+    CHECK_ERROR(igraph_ch_index_build(&index, &graph, &weights, IGRAPH_OUT), IGRAPH_EINVAL);
+    igraph_vector_resize(&weights, 3);
+    CHECK_ERROR(igraph_ch_index_build(&index, &graph, &weights, IGRAPH_OUT), IGRAPH_EINVAL);
+    igraph_ch_index_build(&index, &graph, NULL, IGRAPH_OUT);
+    CHECK_ERROR(igraph_ch_index_distance(&index, &d, 6, 0), IGRAPH_EINVVID);
+    CHECK_ERROR(igraph_ch_index_get_path(&index, &vertices, &edges, 0, -1), IGRAPH_EINVVID);
+    igraph_ch_index_destroy(&index);
+    igraph_vector_destroy(&weights);
+    igraph_destroy(&graph);
+
+    printf("Graph without vertices:\n");
+    igraph_empty(&graph, 0, IGRAPH_UNDIRECTED);
+    igraph_ch_index_build(&index, &graph, NULL, IGRAPH_ALL);
+    igraph_ch_index_destroy(&index);
+    igraph_destroy(&graph);
+
+    printf("Weighted lattice:\n");
+    igraph_vector_int_init_int(&dims, 2, 12, 12);
+    igraph_square_lattice(&graph, &dims, 1, IGRAPH_UNDIRECTED, false, NULL);
+    igraph_vector_init(&weights, igraph_ecount(&graph));
+    for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+        VECTOR(weights)[i] = RNG_UNIF(1, 2);
+    }
+    check_ch(&graph, &weights, IGRAPH_ALL);
+    igraph_vector_destroy(&weights);
+    igraph_vector_int_destroy(&dims);
+    igraph_destroy(&graph);
+
+    printf("Random graphs:\n");
+    for (int directed = 0; directed <= 1; directed++) {
+        igraph_erdos_renyi_game_gnm(&graph, 60, 150, directed, IGRAPH_LOOPS);
+        igraph_add_edge(&graph, IGRAPH_FROM(&graph, 1), IGRAPH_TO(&graph, 1));
+        igraph_vector_init(&weights, igraph_ecount(&graph));
+        for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+            VECTOR(weights)[i] = RNG_INTEGER(0, 4) == 0 ? 0 : RNG_UNIF(0, 10);
+        }
+        VECTOR(weights)[0] = IGRAPH_INFINITY;
+
+        check_ch(&graph, &weights, IGRAPH_OUT);
+        check_ch(&graph, &weights, IGRAPH_IN);
+        check_ch(&graph, &weights, IGRAPH_ALL);
+        check_ch(&graph, NULL, IGRAPH_OUT);
+
+        igraph_vector_destroy(&weights);
+        igraph_destroy(&graph);
+    }
+
+    igraph_vector_int_destroy(&edges);
+    igraph_vector_int_destroy(&vertices);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "community/label_propagation.h"
+#include "test_utilities.h"
+
+/* The parallel variant is only used automatically on large graphs, so it is
+ * forced here. This test is run with several OpenMP threads when igraph is
+ * compiled with OpenMP support, so the results are not reproducible, and
+ * only their properties are checked: labels are numbered in the order of
+ * their first appearance, and the label of each vertex that is not fixed is
+ * dominant among its neighbors. */
+static void check(const igraph_t *graph, const igraph_vector_int_t *membership,
+                  igraph_neimode_t mode, const igraph_vector_t *weights,
+                  const igraph_vector_bool_t *fixed) {
+    igraph_integer_t n = igraph_vcount(graph);
+    igraph_integer_t next_label = 0;
+    igraph_vector_t counts;
+    igraph_vector_int_t incident;
+
+    IGRAPH_ASSERT(igraph_vector_int_size(membership) == n);
+    for (igraph_integer_t v = 0; v < n; v++) {
+        IGRAPH_ASSERT(0 <= VECTOR(*membership)[v] && VECTOR(*membership)[v] <= next_label);
+        if (VECTOR(*membership)[v] == next_label) {
+            next_label++;
+        }
+    }
+
+    igraph_vector_init(&counts, n);
+    igraph_vector_int_init(&incident, 0);
+    for (igraph_integer_t v = 0; v < n; v++) {
+        igraph_real_t max_count = 0;
+
+        if (fixed && VECTOR(*fixed)[v]) {
+            continue;
+        }
+
+        /* Labels propagate against the direction given by 'mode' */
+        igraph_incident(graph, &incident, v, IGRAPH_REVERSE_MODE(mode));
+        igraph_vector_null(&counts);
+        for (igraph_integer_t i = 0; i < igraph_vector_int_size(&incident); i++) {
+            igraph_integer_t e = VECTOR(incident)[i];
+            igraph_integer_t u = IGRAPH_OTHER(graph, e, v);
+            VECTOR(counts)[VECTOR(*membership)[u]] += weights ? VECTOR(*weights)[e] : 1;
+        }
+        for (igraph_integer_t c = 0; c < next_label; c++) {
+            if (VECTOR(counts)[c] > max_count) {
+                max_count = VECTOR(counts)[c];
+            }
+        }
+        IGRAPH_ASSERT(VECTOR(counts)[VECTOR(*membership)[v]] == max_count);
+    }
+    igraph_vector_int_destroy(&incident);
+    igraph_vector_destroy(&counts);
+}
+
+static void planted_partition(igraph_t *graph, igraph_integer_t blocks, igraph_integer_t size,
+                              igraph_real_t p_in, igraph_real_t p_out, igraph_bool_t directed) {
+    igraph_matrix_t pref;
+    igraph_vector_int_t block_sizes;
+
+    igraph_matrix_init(&pref, blocks, blocks);
+    igraph_matrix_fill(&pref, p_out);
+    for (igraph_integer_t b = 0; b < blocks; b++) {
+        MATRIX(pref, b, b) = p_in;
+    }
+    igraph_vector_int_init(&block_sizes, blocks);
+    igraph_vector_int_fill(&block_sizes, size);
+    igraph_sbm_game(graph, blocks * size, &pref, &block_sizes, directed, false);
+    igraph_vector_int_destroy(&block_sizes);
+    igraph_matrix_destroy(&pref);
+}
+
+int main(void) {
+    igraph_t graph;
+    igraph_vector_int_t membership, initial;
+    igraph_vector_bool_t fixed;
+    igraph_vector_t weights;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_vector_int_init(&membership, 0);
+
+    printf("Small graph:\n");
+    igraph_small(&graph, 7, IGRAPH_UNDIRECTED,
+                 0,1, 1,2, 2,0, 3,4, 4,5, 5,3,
+                 -1);
+    igraph_i_community_label_propagation(&graph, &membership, IGRAPH_ALL, NULL, NULL, NULL, 0);
+    print_vector_int(&membership);
+    igraph_destroy(&graph);
+
+    printf("Planted partition:\n");
+    planted_partition(&graph, 10, 500, 0.05, 0.0005, false);
+    igraph_i_community_label_propagation(&graph, &membership, IGRAPH_ALL, NULL, NULL, NULL, 0);
+    check(&graph, &membership, IGRAPH_ALL, NULL, NULL);
+
+    printf("Weighted:\n");
+    igraph_vector_init(&weights, igraph_ecount(&graph));
+    for (igraph_integer_t e = 0; e < igraph_ecount(&graph); e++) {
+        VECTOR(weights)[e] = RNG_UNIF(0, 2);
+    }
+    igraph_i_community_label_propagation(&graph, &membership, IGRAPH_ALL, &weights, NULL, NULL, 0);
+    check(&graph, &membership, IGRAPH_ALL, &weights, NULL);
+    igraph_vector_destroy(&weights);
+
+    printf("Fixed labels:\n");
+    igraph_vector_int_init(&initial, igraph_vcount(&graph));
+    igraph_vector_int_fill(&initial, -1);
+    igraph_vector_bool_init(&fixed, igraph_vcount(&graph));
+    for (igraph_integer_t b = 0; b < 10; b++) {
+        VECTOR(initial)[b * 500] = b % 5;
+        VECTOR(fixed)[b * 500] = true;
+    }
+    igraph_i_community_label_propagation(&graph, &membership, IGRAPH_ALL, NULL, &initial, &fixed, 0);
+    check(&graph, &membership, IGRAPH_ALL, NULL, &fixed);
+    for (igraph_integer_t b = 0; b < 10; b++) {
+        for (igraph_integer_t c = 0; c < 10; c++) {
+            IGRAPH_ASSERT((VECTOR(membership)[b * 500] == VECTOR(membership)[c * 500]) == (b % 5 == c % 5));
+        }
+    }
+    igraph_vector_bool_destroy(&fixed);
+    igraph_vector_int_destroy(&initial);
+    igraph_destroy(&graph);
+
+    printf("Directed:\n");
+    planted_partition(&graph, 10, 500, 0.05, 0.0005, true);
+    igraph_i_community_label_propagation(&graph, &membership, IGRAPH_OUT, NULL, NULL, NULL, 0);
+    check(&graph, &membership, IGRAPH_OUT, NULL, NULL);
+    igraph_i_community_label_propagation(&graph, &membership, IGRAPH_ALL, NULL, NULL, NULL, 0);
+    check(&graph, &membership, IGRAPH_ALL, NULL, NULL);
+    igraph_destroy(&graph);
+
+    printf("Unlabeled component:\n");
+    igraph_small(&graph, 6, IGRAPH_UNDIRECTED,
+                 0,1, 1,2, 3,4, 4,5,
+                 -1);
+    igraph_vector_int_init_int(&initial, 6, 3, -1, -1, -1, -1, -1);
+    igraph_i_community_label_propagation(&graph, &membership, IGRAPH_ALL, NULL, &initial, NULL, 0);
+    print_vector_int(&membership);
+    igraph_vector_int_destroy(&initial);
+    igraph_destroy(&graph);
+
+    igraph_vector_int_destroy(&membership);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
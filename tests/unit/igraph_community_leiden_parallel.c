@@ -0,0 +1,197 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "community/leiden.h"
+#include "test_utilities.h"
+
+/* The parallel variant is only used automatically on large graphs, so it is
+ * forced here. This test is run with several OpenMP threads when igraph is
+ * compiled with OpenMP support. The result must keep the guarantees of the
+ * Leiden algorithm: after an iteration without changes, no node can be moved
+ * to improve the quality, and all clusters are connected. */
+
+/* Checks that the quality is correct, that no node can be moved to another
+ * cluster, or to an empty one, to improve the quality, and that clusters are
+ * connected. */
+static void check_partition(const igraph_t *graph, const igraph_vector_t *edge_weights,
+                            const igraph_vector_t *node_weights, igraph_real_t resolution,
+                            const igraph_vector_int_t *membership, igraph_integer_t nb_clusters,
+                            igraph_real_t quality) {
+    igraph_integer_t n = igraph_vcount(graph), m = igraph_ecount(graph);
+    igraph_vector_t cluster_weights, weight_to_cluster;
+    igraph_real_t expected = 0.0, total_edge_weight = 0.0;
+
+    igraph_vector_init(&cluster_weights, nb_clusters);
+    igraph_vector_init(&weight_to_cluster, nb_clusters);
+
+    for (igraph_integer_t v = 0; v < n; v++) {
+        IGRAPH_ASSERT(0 <= VECTOR(*membership)[v] && VECTOR(*membership)[v] < nb_clusters);
+        VECTOR(cluster_weights)[VECTOR(*membership)[v]] += node_weights ? VECTOR(*node_weights)[v] : 1;
+    }
+
+    for (igraph_integer_t e = 0; e < m; e++) {
+        igraph_real_t w = edge_weights ? VECTOR(*edge_weights)[e] : 1;
+        total_edge_weight += w;
+        if (VECTOR(*membership)[IGRAPH_FROM(graph, e)] == VECTOR(*membership)[IGRAPH_TO(graph, e)]) {
+            expected += 2 * w;
+        }
+    }
+    for (igraph_integer_t c = 0; c < nb_clusters; c++) {
+        expected -= resolution * VECTOR(cluster_weights)[c] * VECTOR(cluster_weights)[c];
+    }
+    expected /= 2 * total_edge_weight;
+    IGRAPH_ASSERT(igraph_cmp_epsilon(quality, expected, 1e-10) == 0);
+
+    for (igraph_integer_t v = 0; v < n; v++) {
+        igraph_integer_t current = VECTOR(*membership)[v];
+        igraph_real_t node_weight = node_weights ? VECTOR(*node_weights)[v] : 1;
+        igraph_real_t current_diff;
+        igraph_vector_int_t incident;
+
+        igraph_vector_null(&weight_to_cluster);
+        igraph_vector_int_init(&incident, 0);
+        igraph_incident(graph, &incident, v, IGRAPH_ALL);
+        for (igraph_integer_t i = 0; i < igraph_vector_int_size(&incident); i++) {
+            igraph_integer_t e = VECTOR(incident)[i];
+            igraph_integer_t u = IGRAPH_OTHER(graph, e, v);
+            if (u != v) {
+                VECTOR(weight_to_cluster)[VECTOR(*membership)[u]] += edge_weights ? VECTOR(*edge_weights)[e] : 1;
+            }
+        }
+
+        current_diff = VECTOR(weight_to_cluster)[current] -
+                       node_weight * (VECTOR(cluster_weights)[current] - node_weight) * resolution;
+        IGRAPH_ASSERT(current_diff >= -1e-10);
+        for (igraph_integer_t c = 0; c < nb_clusters; c++) {
+            if (c != current) {
+                IGRAPH_ASSERT(VECTOR(weight_to_cluster)[c] - node_weight * VECTOR(cluster_weights)[c] * resolution
+                              <= current_diff + 1e-10);
+            }
+        }
+        igraph_vector_int_destroy(&incident);
+    }
+
+    for (igraph_integer_t c = 0; c < nb_clusters; c++) {
+        igraph_vector_int_t vids;
+        igraph_t subgraph;
+        igraph_bool_t connected;
+
+        igraph_vector_int_init(&vids, 0);
+        for (igraph_integer_t v = 0; v < n; v++) {
+            if (VECTOR(*membership)[v] == c) {
+                igraph_vector_int_push_back(&vids, v);
+            }
+        }
+        IGRAPH_ASSERT(igraph_vector_int_size(&vids) > 0);
+        igraph_induced_subgraph(graph, &subgraph, igraph_vss_vector(&vids), IGRAPH_SUBGRAPH_AUTO);
+        igraph_is_connected(&subgraph, &connected, IGRAPH_WEAK);
+        IGRAPH_ASSERT(connected);
+        igraph_destroy(&subgraph);
+        igraph_vector_int_destroy(&vids);
+    }
+
+    igraph_vector_destroy(&weight_to_cluster);
+    igraph_vector_destroy(&cluster_weights);
+}
+
+static void run(const igraph_t *graph, const igraph_vector_t *edge_weights,
+                const igraph_vector_t *node_weights, igraph_real_t resolution) {
+    igraph_vector_int_t membership, membership2;
+    igraph_integer_t nb_clusters;
+    igraph_real_t quality;
+
+    igraph_vector_int_init(&membership, 0);
+    igraph_vector_int_init(&membership2, 0);
+
+    igraph_rng_seed(igraph_rng_default(), 137);
+    igraph_i_community_leiden_parallel(graph, edge_weights, node_weights, resolution, 0.01,
+                                       false, -1, &membership, &nb_clusters, &quality, 0);
+    check_partition(graph, edge_weights, node_weights, resolution, &membership, nb_clusters, quality);
+
+    /* The result only depends on the seed. */
+    igraph_rng_seed(igraph_rng_default(), 137);
+    igraph_i_community_leiden_parallel(graph, edge_weights, node_weights, resolution, 0.01,
+                                       false, -1, &membership2, NULL, NULL, 0);
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&membership, &membership2));
+
+    igraph_vector_int_destroy(&membership2);
+    igraph_vector_int_destroy(&membership);
+}
+
+int main(void) {
+    igraph_t graph, clique;
+    igraph_vector_t edge_weights, node_weights;
+    igraph_vector_int_t membership;
+    igraph_integer_t nb_clusters;
+    igraph_real_t quality;
+
+    igraph_vector_int_init(&membership, 0);
+
+    printf("Graph without edges:\n");
+    igraph_empty(&graph, 4, IGRAPH_UNDIRECTED);
+    igraph_i_community_leiden_parallel(&graph, NULL, NULL, 1, 0.01, false, -1,
+                                       &membership, &nb_clusters, NULL, 0);
+    print_vector_int(&membership);
+    igraph_destroy(&graph);
+
+    printf("Two cliques:\n");
+    igraph_full(&clique, 5, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    igraph_disjoint_union(&graph, &clique, &clique);
+    igraph_destroy(&clique);
+    igraph_add_edge(&graph, 0, 5);
+    igraph_i_community_leiden_parallel(&graph, NULL, NULL, 0.5, 0.01, false, -1,
+                                       &membership, &nb_clusters, &quality, 0);
+    print_vector_int(&membership);
+    check_partition(&graph, NULL, NULL, 0.5, &membership, nb_clusters, quality);
+    igraph_destroy(&graph);
+
+    printf("Modularity on Zachary karate club:\n");
+    igraph_famous(&graph, "Zachary");
+    igraph_vector_init(&node_weights, 0);
+    igraph_strength(&graph, &node_weights, igraph_vss_all(), IGRAPH_ALL, true, NULL);
+    run(&graph, NULL, &node_weights, 1.0 / (2 * igraph_ecount(&graph)));
+    igraph_vector_destroy(&node_weights);
+    igraph_destroy(&graph);
+
+    printf("CPM on weighted random graphs:\n");
+    igraph_rng_seed(igraph_rng_default(), 42);
+    for (int i = 0; i < 3; i++) {
+        igraph_erdos_renyi_game_gnm(&graph, 2000, 10000, IGRAPH_UNDIRECTED, IGRAPH_LOOPS);
+        igraph_vector_init(&edge_weights, igraph_ecount(&graph));
+        for (igraph_integer_t e = 0; e < igraph_ecount(&graph); e++) {
+            VECTOR(edge_weights)[e] = RNG_UNIF(0.5, 2);
+        }
+        run(&graph, &edge_weights, NULL, 0.05);
+        igraph_vector_destroy(&edge_weights);
+        igraph_destroy(&graph);
+    }
+
+    printf("Modularity on a random geometric graph:\n");
+    igraph_grg_game(&graph, 3000, 0.03, false, NULL, NULL);
+    igraph_vector_init(&node_weights, 0);
+    igraph_strength(&graph, &node_weights, igraph_vss_all(), IGRAPH_ALL, true, NULL);
+    run(&graph, NULL, &node_weights, 1.0 / (2 * igraph_ecount(&graph)));
+    igraph_vector_destroy(&node_weights);
+    igraph_destroy(&graph);
+
+    igraph_vector_int_destroy(&membership);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,212 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Computes the quality of a partition as defined for the Leiden algorithm. */
+static igraph_real_t quality_of(const igraph_t *graph, const igraph_vector_t *node_weights,
+                                igraph_real_t resolution, const igraph_vector_int_t *membership) {
+    igraph_integer_t n = igraph_vcount(graph), m = igraph_ecount(graph);
+    igraph_vector_t cluster_weights;
+    igraph_real_t result = 0.0;
+
+    igraph_vector_init(&cluster_weights, n);
+    for (igraph_integer_t v = 0; v < n; v++) {
+        VECTOR(cluster_weights)[VECTOR(*membership)[v]] += node_weights ? VECTOR(*node_weights)[v] : 1;
+    }
+    for (igraph_integer_t e = 0; e < m; e++) {
+        if (VECTOR(*membership)[IGRAPH_FROM(graph, e)] == VECTOR(*membership)[IGRAPH_TO(graph, e)]) {
+            result += 2;
+        }
+    }
+    for (igraph_integer_t c = 0; c < n; c++) {
+        result -= resolution * VECTOR(cluster_weights)[c] * VECTOR(cluster_weights)[c];
+    }
+    igraph_vector_destroy(&cluster_weights);
+
+    return result / (2 * m);
+}
+
+/* Checks that the clusters are numbered from zero and connected. */
+static void check_clusters(const igraph_t *graph, const igraph_vector_int_t *membership,
+                           igraph_integer_t nb_clusters) {
+    igraph_integer_t n = igraph_vcount(graph);
+
+    IGRAPH_ASSERT(igraph_vector_int_size(membership) == n);
+    for (igraph_integer_t c = 0; c < nb_clusters; c++) {
+        igraph_vector_int_t vids;
+        igraph_t subgraph;
+        igraph_bool_t connected;
+
+        igraph_vector_int_init(&vids, 0);
+        for (igraph_integer_t v = 0; v < n; v++) {
+            IGRAPH_ASSERT(0 <= VECTOR(*membership)[v] && VECTOR(*membership)[v] < nb_clusters);
+            if (VECTOR(*membership)[v] == c) {
+                igraph_vector_int_push_back(&vids, v);
+            }
+        }
+        IGRAPH_ASSERT(igraph_vector_int_size(&vids) > 0);
+        igraph_induced_subgraph(graph, &subgraph, igraph_vss_vector(&vids), IGRAPH_SUBGRAPH_AUTO);
+        igraph_is_connected(&subgraph, &connected, IGRAPH_WEAK);
+        IGRAPH_ASSERT(connected);
+        igraph_destroy(&subgraph);
+        igraph_vector_int_destroy(&vids);
+    }
+}
+
+/* Deletes the edges between the given pairs of vertices. */
+static void delete_pairs(igraph_t *graph, const igraph_vector_int_t *pairs) {
+    igraph_vector_int_t eids;
+    igraph_vector_int_init(&eids, 0);
+    igraph_get_eids(graph, &eids, pairs, false, true);
+    igraph_delete_edges(graph, igraph_ess_vector(&eids));
+    igraph_vector_int_destroy(&eids);
+}
+
+int main(void) {
+    igraph_t graph, clique;
+    igraph_vector_int_t membership, changed;
+    igraph_vector_t node_weights;
+    igraph_integer_t nb_clusters;
+    igraph_real_t quality;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_vector_int_init(&membership, 0);
+
+    /* Two cliques, connected by a single edge */
+    igraph_full(&clique, 5, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    igraph_disjoint_union(&graph, &clique, &clique);
+    igraph_destroy(&clique);
+    igraph_add_edge(&graph, 0, 5);
+    igraph_community_leiden(&graph, NULL, NULL, 0.5, 0.01, false, -1, &membership, &nb_clusters, NULL);
+    printf("Initial partition:\n");
+    print_vector_int(&membership);
+
+    printf("Splitting the first clique:\n");
+    igraph_vector_int_init_int(&changed, 12, 0, 2, 0, 3, 0, 4, 1, 2, 1, 3, 1, 4);
+    delete_pairs(&graph, &changed);
+    igraph_community_leiden_update(&graph, NULL, NULL, 0.5, &changed, &membership, &nb_clusters, &quality);
+    print_vector_int(&membership);
+    check_clusters(&graph, &membership, nb_clusters);
+    IGRAPH_ASSERT(igraph_cmp_epsilon(quality, quality_of(&graph, NULL, 0.5, &membership), 1e-12) == 0);
+    igraph_vector_int_destroy(&changed);
+
+    printf("Adding vertices connected to the second clique:\n");
+    igraph_add_vertices(&graph, 2, NULL);
+    igraph_vector_int_init_int(&changed, 10, 10, 5, 10, 6, 10, 7, 11, 8, 11, 9);
+    igraph_add_edges(&graph, &changed, NULL);
+    igraph_community_leiden_update(&graph, NULL, NULL, 0.5, &changed, &membership, &nb_clusters, &quality);
+    print_vector_int(&membership);
+    check_clusters(&graph, &membership, nb_clusters);
+    igraph_vector_int_destroy(&changed);
+
+    printf("No changes:\n");
+    igraph_vector_int_init(&changed, 0);
+    igraph_community_leiden_update(&graph, NULL, NULL, 0.5, &changed, &membership, &nb_clusters, NULL);
+    print_vector_int(&membership);
+
+    printf("Errors:\n");
+    igraph_vector_int_push_back(&changed, 0);
+    CHECK_ERROR(igraph_community_leiden_update(&graph, NULL, NULL, 0.5, &changed, &membership, NULL, NULL), IGRAPH_EINVAL);
+    igraph_vector_int_push_back(&changed, 12);
+    CHECK_ERROR(igraph_community_leiden_update(&graph, NULL, NULL, 0.5, &changed, &membership, NULL, NULL), IGRAPH_EINVVID);
+    igraph_vector_int_clear(&changed);
+    CHECK_ERROR(igraph_community_leiden_update(&graph, NULL, NULL, -1, &changed, &membership, NULL, NULL), IGRAPH_EINVAL);
+    igraph_vector_int_push_back(&membership, 0);
+    CHECK_ERROR(igraph_community_leiden_update(&graph, NULL, NULL, 0.5, &changed, &membership, NULL, NULL), IGRAPH_EINVAL);
+    igraph_vector_int_destroy(&changed);
+    igraph_destroy(&graph);
+
+    printf("Modularity on random graphs with planted partitions:\n");
+    for (int i = 0; i < 5; i++) {
+        igraph_matrix_t pref;
+        igraph_vector_int_t block_sizes;
+        igraph_real_t old_quality;
+
+        igraph_matrix_init(&pref, 10, 10);
+        igraph_matrix_fill(&pref, 0.01);
+        for (igraph_integer_t b = 0; b < 10; b++) {
+            MATRIX(pref, b, b) = 0.3;
+        }
+        igraph_vector_int_init(&block_sizes, 10);
+        igraph_vector_int_fill(&block_sizes, 50);
+        igraph_sbm_game(&graph, 500, &pref, &block_sizes, IGRAPH_UNDIRECTED, false);
+        igraph_matrix_destroy(&pref);
+        igraph_vector_int_destroy(&block_sizes);
+
+        igraph_vector_init(&node_weights, 0);
+        igraph_strength(&graph, &node_weights, igraph_vss_all(), IGRAPH_ALL, true, NULL);
+        igraph_community_leiden(&graph, NULL, &node_weights, 1.0 / (2 * igraph_ecount(&graph)), 0.01,
+                                false, -1, &membership, NULL, NULL);
+
+        /* Delete some edges, then insert some new ones */
+        igraph_vector_int_init(&changed, 0);
+        for (int j = 0; j < 100; j++) {
+            igraph_integer_t e = RNG_INTEGER(0, igraph_ecount(&graph) - 1);
+            igraph_integer_t from = IGRAPH_FROM(&graph, e), to = IGRAPH_TO(&graph, e);
+            igraph_bool_t seen = false;
+            for (igraph_integer_t k = 0; k < igraph_vector_int_size(&changed); k += 2) {
+                if (VECTOR(changed)[k] == from && VECTOR(changed)[k + 1] == to) {
+                    seen = true;
+                }
+            }
+            if (!seen) {
+                igraph_vector_int_push_back(&changed, from);
+                igraph_vector_int_push_back(&changed, to);
+            }
+        }
+        delete_pairs(&graph, &changed);
+        for (int j = 0; j < 100; j++) {
+            igraph_integer_t from = RNG_INTEGER(0, 499), to = RNG_INTEGER(0, 499);
+            if (from != to) {
+                igraph_add_edge(&graph, from, to);
+                igraph_vector_int_push_back(&changed, from);
+                igraph_vector_int_push_back(&changed, to);
+            }
+        }
+
+        igraph_strength(&graph, &node_weights, igraph_vss_all(), IGRAPH_ALL, true, NULL);
+        old_quality = quality_of(&graph, &node_weights, 1.0 / (2 * igraph_ecount(&graph)), &membership);
+
+        igraph_community_leiden_update(&graph, NULL, &node_weights, 1.0 / (2 * igraph_ecount(&graph)),
+                                       &changed, &membership, &nb_clusters, &quality);
+        check_clusters(&graph, &membership, nb_clusters);
+        IGRAPH_ASSERT(igraph_cmp_epsilon(quality,
+                                         quality_of(&graph, &node_weights, 1.0 / (2 * igraph_ecount(&graph)), &membership),
+                                         1e-12) == 0);
+        IGRAPH_ASSERT(quality >= old_quality - 1e-12);
+
+        /* The result is the same as modularity */
+        {
+            igraph_real_t modularity;
+            igraph_modularity(&graph, &membership, NULL, 1, false, &modularity);
+            IGRAPH_ASSERT(igraph_cmp_epsilon(quality, modularity, 1e-12) == 0);
+        }
+
+        igraph_vector_int_destroy(&changed);
+        igraph_vector_destroy(&node_weights);
+        igraph_destroy(&graph);
+    }
+    printf("OK\n");
+
+    igraph_vector_int_destroy(&membership);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,155 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+static igraph_error_t view_of(igraph_t *view, const igraph_t *graph, igraph_bool_t validate) {
+    return igraph_create_view(view, igraph_vcount(graph), igraph_ecount(graph),
+                              igraph_is_directed(graph),
+                              VECTOR(graph->from), VECTOR(graph->to),
+                              VECTOR(graph->oi), VECTOR(graph->ii),
+                              VECTOR(graph->os), VECTOR(graph->is), validate);
+}
+
+static void check_same_graph(const igraph_t *g1, const igraph_t *g2) {
+    igraph_bool_t same;
+    igraph_vector_int_t d1, d2;
+
+    igraph_is_same_graph(g1, g2, &same);
+    IGRAPH_ASSERT(same);
+
+    igraph_vector_int_init(&d1, 0);
+    igraph_vector_int_init(&d2, 0);
+    igraph_degree(g1, &d1, igraph_vss_all(), IGRAPH_IN, IGRAPH_LOOPS);
+    igraph_degree(g2, &d2, igraph_vss_all(), IGRAPH_IN, IGRAPH_LOOPS);
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&d1, &d2));
+    igraph_vector_int_destroy(&d2);
+    igraph_vector_int_destroy(&d1);
+}
+
+int main(void) {
+    igraph_t g, view, copy;
+    igraph_vector_int_t edges, bad;
+    igraph_bool_t has_multi;
+    FILE *file;
+    char *buffer;
+    long size;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    igraph_small(&g, 6, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,0, 1,2, 3,3, 2,1,
+                 -1);
+
+    printf("View:\n");
+    IGRAPH_ASSERT(view_of(&view, &g, true) == IGRAPH_SUCCESS);
+    IGRAPH_ASSERT(view.view);
+    print_graph(&view);
+    check_same_graph(&g, &view);
+    igraph_has_multiple(&view, &has_multi);
+    IGRAPH_ASSERT(has_multi);
+
+    /* Structural changes are refused, the underlying data is unchanged. */
+    igraph_vector_int_init_int(&edges, 2, 0, 5);
+    CHECK_ERROR(igraph_add_edges(&view, &edges, NULL), IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_add_vertices(&view, 1, NULL), IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_delete_edges(&view, igraph_ess_1(0)), IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_delete_vertices(&view, igraph_vss_1(0)), IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_reverse_edges(&view, igraph_ess_all(IGRAPH_EDGEORDER_ID)), IGRAPH_EINVAL);
+    check_same_graph(&g, &view);
+
+    /* A copy of a view is an ordinary graph. */
+    igraph_copy(&copy, &view);
+    IGRAPH_ASSERT(!copy.view);
+    igraph_add_edges(&copy, &edges, NULL);
+    IGRAPH_ASSERT(igraph_ecount(&copy) == igraph_ecount(&g) + 1);
+    igraph_destroy(&copy);
+
+    /* Replacing the graph releases the view. */
+    igraph_simplify(&view, true, true, NULL);
+    IGRAPH_ASSERT(!view.view);
+    IGRAPH_ASSERT(igraph_ecount(&view) == 4);
+    igraph_destroy(&view);
+    IGRAPH_ASSERT(igraph_ecount(&g) == 6);
+
+    /* Attributes are stored separately. */
+    igraph_set_attribute_table(&igraph_cattribute_table);
+    view_of(&view, &g, false);
+    SETVAS(&view, "name", 0, "first");
+    IGRAPH_ASSERT(!strcmp(VAS(&view, "name", 0), "first"));
+    igraph_destroy(&view);
+    igraph_set_attribute_table(NULL);
+
+    /* Destroying the view leaves the original graph intact. */
+    check_same_graph(&g, &g);
+    igraph_destroy(&g);
+
+    printf("\nNull graph:\n");
+    IGRAPH_ASSERT(igraph_create_view(&view, 0, 0, false, NULL, NULL, NULL, NULL,
+                                     (igraph_integer_t[]) { 0 }, (igraph_integer_t[]) { 0 },
+                                     true) == IGRAPH_SUCCESS);
+    print_graph(&view);
+    igraph_destroy(&view);
+
+    /* Validation. */
+    igraph_erdos_renyi_game_gnm(&g, 100, 500, IGRAPH_UNDIRECTED, IGRAPH_LOOPS);
+    igraph_vector_int_init_copy(&bad, &g.oi);
+    igraph_vector_int_swap_elements(&bad, 0, 1);
+    CHECK_ERROR(igraph_create_view(&view, 100, 500, false, VECTOR(g.from), VECTOR(g.to),
+                                   VECTOR(bad), VECTOR(g.ii), VECTOR(g.os), VECTOR(g.is), true),
+                IGRAPH_EINVAL);
+    /* Undirected edges must be stored in canonical order. */
+    CHECK_ERROR(igraph_create_view(&view, 100, 500, false, VECTOR(g.to), VECTOR(g.from),
+                                   VECTOR(g.ii), VECTOR(g.oi), VECTOR(g.is), VECTOR(g.os), true),
+                IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_create_view(&view, 99, 500, false, VECTOR(g.from), VECTOR(g.to),
+                                   VECTOR(g.oi), VECTOR(g.ii), VECTOR(g.os), VECTOR(g.is), true),
+                IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_create_view(&view, -1, 500, false, VECTOR(g.from), VECTOR(g.to),
+                                   VECTOR(g.oi), VECTOR(g.ii), VECTOR(g.os), VECTOR(g.is), false),
+                IGRAPH_EINVAL);
+    igraph_vector_int_destroy(&bad);
+
+    /* View of a binary file in memory. */
+    file = tmpfile();
+    IGRAPH_ASSERT(file != NULL);
+    igraph_write_graph_binary(&g, file);
+    size = ftell(file);
+    buffer = malloc(size + sizeof(igraph_integer_t));
+    rewind(file);
+    IGRAPH_ASSERT(fread(buffer, 1, size, file) == (size_t) size);
+    fclose(file);
+
+    IGRAPH_ASSERT(igraph_read_graph_binary_view(&view, buffer, size, true) == IGRAPH_SUCCESS);
+    IGRAPH_ASSERT(view.view);
+    check_same_graph(&g, &view);
+    igraph_destroy(&view);
+
+    CHECK_ERROR(igraph_read_graph_binary_view(&view, buffer, size - 8, true), IGRAPH_PARSEERROR);
+    CHECK_ERROR(igraph_read_graph_binary_view(&view, buffer, 16, true), IGRAPH_PARSEERROR);
+    memmove(buffer + 1, buffer, size);
+    CHECK_ERROR(igraph_read_graph_binary_view(&view, buffer + 1, size, true), IGRAPH_EINVAL);
+    free(buffer);
+
+    igraph_vector_int_destroy(&edges);
+    igraph_destroy(&g);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,146 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+static void print_csr(const igraph_csr_t *csr, igraph_bool_t edge_ids) {
+    for (igraph_integer_t i = 0; i < igraph_csr_size(csr); i++) {
+        const igraph_integer_t *neis = igraph_csr_neighbors(csr, i);
+        printf("%" IGRAPH_PRId ":", i);
+        for (igraph_integer_t j = 0; j < igraph_csr_degree(csr, i); j++) {
+            printf(" %" IGRAPH_PRId, neis[j]);
+            if (edge_ids) {
+                printf("/%" IGRAPH_PRId, igraph_csr_edges(csr, i)[j]);
+            }
+        }
+        printf("\n");
+    }
+}
+
+/* The neighbors must be the same as in an adjacency list, and the edge IDs
+ * the same as in an incidence list. */
+static void check_csr(const igraph_t *graph, igraph_neimode_t mode,
+                      igraph_loops_t loops, igraph_multiple_t multiple) {
+    igraph_csr_t csr;
+    igraph_adjlist_t al;
+    igraph_inclist_t il;
+    igraph_integer_t no_of_nodes = igraph_vcount(graph);
+
+    igraph_csr_init(graph, &csr, mode, loops, multiple, false);
+    igraph_adjlist_init(graph, &al, mode, loops, multiple);
+    IGRAPH_ASSERT(igraph_csr_size(&csr) == no_of_nodes);
+    for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+        const igraph_vector_int_t *neis = igraph_adjlist_get(&al, i);
+        IGRAPH_ASSERT(igraph_csr_degree(&csr, i) == igraph_vector_int_size(neis));
+        for (igraph_integer_t j = 0; j < igraph_vector_int_size(neis); j++) {
+            IGRAPH_ASSERT(igraph_csr_neighbors(&csr, i)[j] == VECTOR(*neis)[j]);
+        }
+    }
+    igraph_adjlist_destroy(&al);
+    igraph_csr_destroy(&csr);
+
+    if (multiple == IGRAPH_MULTIPLE) {
+        igraph_csr_init(graph, &csr, mode, loops, multiple, true);
+        igraph_inclist_init(graph, &il, mode, loops);
+        for (igraph_integer_t i = 0; i < no_of_nodes; i++) {
+            const igraph_vector_int_t *incs = igraph_inclist_get(&il, i);
+            IGRAPH_ASSERT(igraph_csr_degree(&csr, i) == igraph_vector_int_size(incs));
+            for (igraph_integer_t j = 0; j < igraph_vector_int_size(incs); j++) {
+                igraph_integer_t edge = VECTOR(*incs)[j];
+                IGRAPH_ASSERT(igraph_csr_edges(&csr, i)[j] == edge);
+                IGRAPH_ASSERT(igraph_csr_neighbors(&csr, i)[j] == IGRAPH_OTHER(graph, edge, i));
+            }
+        }
+        igraph_inclist_destroy(&il);
+        igraph_csr_destroy(&csr);
+    }
+}
+
+static void random_multigraph(igraph_t *graph, igraph_bool_t directed) {
+    igraph_vector_int_t edges;
+
+    igraph_vector_int_init(&edges, 400);
+    for (igraph_integer_t i = 0; i < 400; i++) {
+        VECTOR(edges)[i] = RNG_INTEGER(0, 29);
+    }
+    igraph_create(graph, &edges, 30, directed);
+    igraph_vector_int_destroy(&edges);
+}
+
+static void check_all(const igraph_t *graph) {
+    const igraph_neimode_t modes[] = { IGRAPH_OUT, IGRAPH_IN, IGRAPH_ALL };
+    const igraph_loops_t loops[] = { IGRAPH_NO_LOOPS, IGRAPH_LOOPS_ONCE, IGRAPH_LOOPS_TWICE };
+    const igraph_multiple_t multiple[] = { IGRAPH_NO_MULTIPLE, IGRAPH_MULTIPLE };
+
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            for (int k = 0; k < 2; k++) {
+                check_csr(graph, modes[i], loops[j], multiple[k]);
+            }
+        }
+    }
+}
+
+int main(void) {
+    igraph_t g;
+    igraph_csr_t csr;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    igraph_small(&g, 5, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,2, 2,0, 0,1, 3,1, 1,3, 2,2,
+                 -1);
+
+    printf("Directed, out-neighbors with edge IDs:\n");
+    igraph_csr_init(&g, &csr, IGRAPH_OUT, IGRAPH_LOOPS, IGRAPH_MULTIPLE, true);
+    print_csr(&csr, true);
+    igraph_csr_destroy(&csr);
+
+    printf("\nDirected, all neighbors, simplified:\n");
+    igraph_csr_init(&g, &csr, IGRAPH_ALL, IGRAPH_NO_LOOPS, IGRAPH_NO_MULTIPLE, false);
+    print_csr(&csr, false);
+    igraph_csr_destroy(&csr);
+
+    check_all(&g);
+
+    printf("\nErrors:\n");
+    CHECK_ERROR(igraph_csr_init(&g, &csr, IGRAPH_ALL, IGRAPH_LOOPS, IGRAPH_NO_MULTIPLE, true), IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_csr_init(&g, &csr, (igraph_neimode_t) 42, IGRAPH_LOOPS, IGRAPH_MULTIPLE, false), IGRAPH_EINVMODE);
+    igraph_destroy(&g);
+
+    printf("\nNull graph:\n");
+    igraph_empty(&g, 0, IGRAPH_UNDIRECTED);
+    igraph_csr_init(&g, &csr, IGRAPH_ALL, IGRAPH_LOOPS, IGRAPH_MULTIPLE, true);
+    IGRAPH_ASSERT(igraph_csr_size(&csr) == 0);
+    print_csr(&csr, true);
+    igraph_csr_destroy(&csr);
+    igraph_destroy(&g);
+
+    /* Random multigraphs with loops. */
+    random_multigraph(&g, IGRAPH_DIRECTED);
+    check_all(&g);
+    igraph_destroy(&g);
+
+    random_multigraph(&g, IGRAPH_UNDIRECTED);
+    check_all(&g);
+    igraph_destroy(&g);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,199 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Compares breadth-first search distances with the results of Dijkstra's
+ * algorithm using unit weights. Searches from all vertices run in batches
+ * of multi-source searches, while searches from a few vertices are run
+ * separately, and these mix top-down and bottom-up steps on graphs with a
+ * small diameter. */
+static void check_distances(const igraph_t *graph, igraph_neimode_t mode, igraph_real_t cutoff) {
+    igraph_matrix_t bfs, ref;
+    igraph_vector_t ones, ecc;
+    igraph_vector_int_t targets;
+    igraph_integer_t n = igraph_vcount(graph);
+
+    igraph_matrix_init(&bfs, 0, 0);
+    igraph_matrix_init(&ref, 0, 0);
+    igraph_vector_init(&ones, igraph_ecount(graph));
+    igraph_vector_fill(&ones, 1);
+    igraph_vector_init(&ecc, 0);
+    igraph_vector_int_init(&targets, 0);
+
+    igraph_distances_cutoff(graph, &bfs, igraph_vss_all(), igraph_vss_all(), mode, cutoff);
+    igraph_distances_dijkstra_cutoff(graph, &ref, igraph_vss_all(), igraph_vss_all(), &ones, mode, cutoff);
+    IGRAPH_ASSERT(igraph_matrix_all_e(&bfs, &ref));
+
+    /* Few sources. */
+    igraph_distances_cutoff(graph, &bfs, igraph_vss_range(n - 3, n), igraph_vss_all(), mode, cutoff);
+    for (igraph_integer_t i = 0; i < 3; i++) {
+        for (igraph_integer_t j = 0; j < n; j++) {
+            IGRAPH_ASSERT(MATRIX(bfs, i, j) == MATRIX(ref, n - 3 + i, j));
+        }
+    }
+
+    /* Only some targets, so that the search may stop early. */
+    for (igraph_integer_t i = 0; i < n; i += 7) {
+        igraph_vector_int_push_back(&targets, i);
+    }
+    igraph_distances_cutoff(graph, &bfs, igraph_vss_all(), igraph_vss_vector(&targets), mode, cutoff);
+    for (igraph_integer_t i = 0; i < n; i++) {
+        for (igraph_integer_t j = 0; j < igraph_vector_int_size(&targets); j++) {
+            IGRAPH_ASSERT(MATRIX(bfs, i, j) == MATRIX(ref, i, VECTOR(targets)[j]));
+        }
+    }
+
+    igraph_distances_cutoff(graph, &bfs, igraph_vss_range(0, 2), igraph_vss_vector(&targets), mode, cutoff);
+    for (igraph_integer_t i = 0; i < 2; i++) {
+        for (igraph_integer_t j = 0; j < igraph_vector_int_size(&targets); j++) {
+            IGRAPH_ASSERT(MATRIX(bfs, i, j) == MATRIX(ref, i, VECTOR(targets)[j]));
+        }
+    }
+
+    if (cutoff < 0) {
+        igraph_vector_t ecc_few;
+        igraph_vector_init(&ecc_few, 0);
+        igraph_eccentricity(graph, &ecc, igraph_vss_all(), mode);
+        igraph_eccentricity(graph, &ecc_few, igraph_vss_range(0, 3), mode);
+        for (igraph_integer_t i = 0; i < n; i++) {
+            igraph_real_t max = 0;
+            for (igraph_integer_t j = 0; j < n; j++) {
+                if (isfinite(MATRIX(ref, i, j)) && MATRIX(ref, i, j) > max) {
+                    max = MATRIX(ref, i, j);
+                }
+            }
+            IGRAPH_ASSERT(VECTOR(ecc)[i] == max);
+            IGRAPH_ASSERT(i >= 3 || VECTOR(ecc_few)[i] == max);
+        }
+        igraph_vector_destroy(&ecc_few);
+    }
+
+    igraph_vector_int_destroy(&targets);
+    igraph_vector_destroy(&ecc);
+    igraph_vector_destroy(&ones);
+    igraph_matrix_destroy(&ref);
+    igraph_matrix_destroy(&bfs);
+}
+
+/* Compares the path length statistics with sums over the distance matrix. */
+static void check_path_lengths(const igraph_t *graph, igraph_bool_t directed) {
+    igraph_matrix_t dist;
+    igraph_vector_t hist;
+    igraph_real_t avg, eff, unconn, sum = 0, inv_sum = 0, pairs = 0;
+    igraph_integer_t n = igraph_vcount(graph);
+
+    igraph_matrix_init(&dist, 0, 0);
+    igraph_vector_init(&hist, 0);
+
+    igraph_distances(graph, &dist, igraph_vss_all(), igraph_vss_all(),
+                     directed ? IGRAPH_OUT : IGRAPH_ALL);
+    igraph_average_path_length(graph, &avg, &unconn, directed, true);
+    igraph_global_efficiency(graph, &eff, NULL, directed);
+    igraph_path_length_hist(graph, &hist, NULL, directed);
+
+    for (igraph_integer_t i = 0; i < n; i++) {
+        for (igraph_integer_t j = 0; j < n; j++) {
+            igraph_real_t d = MATRIX(dist, i, j);
+            if (i != j && isfinite(d)) {
+                sum += d;
+                inv_sum += 1 / d;
+                pairs++;
+                VECTOR(hist)[(igraph_integer_t) d - 1] -= directed ? 1 : 0.5;
+            }
+        }
+    }
+
+    printf("average path length %.6f, unconnected pairs %g\n", avg, unconn);
+    IGRAPH_ASSERT(igraph_cmp_epsilon(avg, sum / pairs, 1e-12) == 0);
+    IGRAPH_ASSERT(unconn == n * (n - 1.0) - pairs);
+    IGRAPH_ASSERT(igraph_cmp_epsilon(eff, inv_sum / (n * (n - 1.0)), 1e-12) == 0);
+    IGRAPH_ASSERT(igraph_vector_min(&hist) == 0 && igraph_vector_max(&hist) == 0);
+
+    igraph_vector_destroy(&hist);
+    igraph_matrix_destroy(&dist);
+}
+
+static void check_diameter(const igraph_t *graph, igraph_bool_t directed) {
+    igraph_real_t diam, ref;
+    igraph_integer_t from, to, ref_from, ref_to;
+    igraph_vector_int_t path;
+
+    igraph_vector_int_init(&path, 0);
+
+    igraph_diameter(graph, &diam, &from, &to, &path, NULL, directed, true);
+    igraph_diameter_dijkstra(graph, NULL, &ref, &ref_from, &ref_to, NULL, NULL, directed, true);
+    printf("diameter %g from %" IGRAPH_PRId " to %" IGRAPH_PRId "\n", diam, from, to);
+    IGRAPH_ASSERT(diam == ref);
+    IGRAPH_ASSERT(igraph_vector_int_size(&path) == diam + 1);
+    IGRAPH_ASSERT(VECTOR(path)[0] == from);
+    IGRAPH_ASSERT(igraph_vector_int_tail(&path) == to);
+
+    igraph_vector_int_destroy(&path);
+}
+
+int main(void) {
+    igraph_t graph;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    printf("Sparse undirected graph:\n");
+    igraph_erdos_renyi_game_gnm(&graph, 500, 1500, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    check_distances(&graph, IGRAPH_ALL, -1);
+    check_distances(&graph, IGRAPH_ALL, 3);
+    check_distances(&graph, IGRAPH_ALL, 2.5);
+    check_diameter(&graph, IGRAPH_UNDIRECTED);
+    check_path_lengths(&graph, IGRAPH_UNDIRECTED);
+    igraph_destroy(&graph);
+
+    printf("Dense directed graph with loops:\n");
+    igraph_erdos_renyi_game_gnm(&graph, 300, 6000, IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    check_distances(&graph, IGRAPH_OUT, -1);
+    check_distances(&graph, IGRAPH_IN, -1);
+    check_distances(&graph, IGRAPH_ALL, -1);
+    check_distances(&graph, IGRAPH_OUT, 1);
+    check_diameter(&graph, IGRAPH_DIRECTED);
+    check_diameter(&graph, IGRAPH_UNDIRECTED);
+    igraph_destroy(&graph);
+
+    printf("Directed preferential attachment graph:\n");
+    igraph_barabasi_game(&graph, 1000, 1, 3, NULL, true, 1, IGRAPH_DIRECTED,
+                         IGRAPH_BARABASI_PSUMTREE, NULL);
+    check_distances(&graph, IGRAPH_OUT, -1);
+    check_distances(&graph, IGRAPH_IN, -1);
+    check_distances(&graph, IGRAPH_ALL, -1);
+    check_distances(&graph, IGRAPH_IN, 4);
+    check_diameter(&graph, IGRAPH_DIRECTED);
+    check_diameter(&graph, IGRAPH_UNDIRECTED);
+    check_path_lengths(&graph, IGRAPH_DIRECTED);
+    igraph_destroy(&graph);
+
+    printf("Disconnected graph:\n");
+    igraph_erdos_renyi_game_gnm(&graph, 400, 300, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    check_distances(&graph, IGRAPH_OUT, -1);
+    check_distances(&graph, IGRAPH_ALL, -1);
+    check_distances(&graph, IGRAPH_ALL, 5);
+    check_diameter(&graph, IGRAPH_DIRECTED);
+    check_path_lengths(&graph, IGRAPH_DIRECTED);
+    check_path_lengths(&graph, IGRAPH_UNDIRECTED);
+    igraph_destroy(&graph);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "paths/delta_stepping.h"
+#include "test_utilities.h"
+
+/* Delta-stepping is only used automatically on large graphs, so it is
+ * called directly here. This test is run with several OpenMP threads when
+ * igraph is compiled with OpenMP support. Results must be exactly the same
+ * as those of Dijkstra's algorithm, for any bucket width and any number of
+ * parts. */
+
+static void check(const igraph_t *graph, igraph_vs_t from, igraph_vs_t to,
+                  const igraph_vector_t *weights, igraph_neimode_t mode, igraph_real_t cutoff) {
+    const igraph_real_t deltas[] = { 0, 0.01, 1, 3, 1000 };
+    const igraph_integer_t parts[] = { 0, 1, 3, 8 };
+    igraph_matrix_t res, ref;
+
+    igraph_matrix_init(&res, 0, 0);
+    igraph_matrix_init(&ref, 0, 0);
+
+    igraph_distances_dijkstra_cutoff(graph, &ref, from, to, weights, mode, cutoff);
+    for (size_t i = 0; i < sizeof(deltas) / sizeof(deltas[0]); i++) {
+        for (size_t j = 0; j < sizeof(parts) / sizeof(parts[0]); j++) {
+            igraph_i_distances_delta_stepping(graph, &res, from, to, weights, mode, cutoff,
+                                              deltas[i], parts[j]);
+            IGRAPH_ASSERT(igraph_matrix_all_e(&res, &ref));
+        }
+    }
+
+    igraph_matrix_destroy(&ref);
+    igraph_matrix_destroy(&res);
+}
+
+int main(void) {
+    igraph_t graph;
+    igraph_vector_t weights;
+    igraph_vector_int_t dims;
+    igraph_matrix_t res;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_matrix_init(&res, 0, 0);
+
+    printf("Small graph:\n");
+    igraph_small(&graph, 6, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,3, 0,3, 3,4, 4,4, 5,0,
+                 -1);
+    igraph_vector_init_int(&weights, 7, 2, 2, 0, 5, 1, 1, 1);
+    VECTOR(weights)[4] = 0.5;
+    igraph_i_distances_delta_stepping(&graph, &res, igraph_vss_all(), igraph_vss_all(),
+                                      &weights, IGRAPH_OUT, -1, 0, 2);
+    print_matrix(&res);
+    igraph_i_distances_delta_stepping(&graph, &res, igraph_vss_1(0), igraph_vss_1(4),
+                                      &weights, IGRAPH_ALL, -1, 1, 2);
+    print_matrix(&res);
+
+    printf("Cutoff:\n");
+    igraph_i_distances_delta_stepping(&graph, &res, igraph_vss_1(0), igraph_vss_all(),
+                                      &weights, IGRAPH_OUT, 4, 1, 3);
+    print_matrix(&res);
+
+    printf("Duplicate targets:\n");
+    {
+        igraph_vector_int_t dup;
+        igraph_vector_int_init_int(&dup, 2, 1, 1);
+        CHECK_ERROR(igraph_i_distances_delta_stepping(&graph, &res, igraph_vss_1(0), igraph_vss_vector(&dup),
+                                                      &weights, IGRAPH_OUT, -1, 0, 0), IGRAPH_EINVAL);
+        igraph_vector_int_destroy(&dup);
+    }
+    igraph_vector_destroy(&weights);
+    igraph_destroy(&graph);
+
+    printf("Graph without edges:\n");
+    igraph_empty(&graph, 3, IGRAPH_UNDIRECTED);
+    igraph_vector_init(&weights, 0);
+    igraph_i_distances_delta_stepping(&graph, &res, igraph_vss_1(1), igraph_vss_all(),
+                                      &weights, IGRAPH_ALL, -1, 0, 0);
+    print_matrix(&res);
+    igraph_vector_destroy(&weights);
+    igraph_destroy(&graph);
+
+    printf("Weighted lattice:\n");
+    igraph_vector_int_init_int(&dims, 2, 30, 30);
+    igraph_square_lattice(&graph, &dims, 1, IGRAPH_UNDIRECTED, false, NULL);
+    igraph_vector_init(&weights, igraph_ecount(&graph));
+    for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+        VECTOR(weights)[i] = RNG_UNIF(0, 5);
+    }
+    check(&graph, igraph_vss_1(0), igraph_vss_all(), &weights, IGRAPH_ALL, -1);
+    check(&graph, igraph_vss_range(10, 13), igraph_vss_range(100, 200), &weights, IGRAPH_ALL, 20);
+    igraph_vector_destroy(&weights);
+    igraph_vector_int_destroy(&dims);
+    igraph_destroy(&graph);
+
+    printf("Random graphs:\n");
+    for (int directed = 0; directed <= 1; directed++) {
+        igraph_erdos_renyi_game_gnm(&graph, 300, 1500, directed, IGRAPH_LOOPS);
+        igraph_vector_init(&weights, igraph_ecount(&graph));
+        for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+            switch (RNG_INTEGER(0, 9)) {
+            case 0: VECTOR(weights)[i] = 0; break;
+            case 1: VECTOR(weights)[i] = IGRAPH_INFINITY; break;
+            case 2: VECTOR(weights)[i] = RNG_INTEGER(1, 100); break;
+            default: VECTOR(weights)[i] = RNG_UNIF(0, 10);
+            }
+        }
+
+        check(&graph, igraph_vss_range(0, 4), igraph_vss_all(), &weights, IGRAPH_OUT, -1);
+        check(&graph, igraph_vss_range(0, 4), igraph_vss_all(), &weights, IGRAPH_IN, -1);
+        check(&graph, igraph_vss_1(7), igraph_vss_all(), &weights, IGRAPH_ALL, 15);
+
+        igraph_vector_destroy(&weights);
+        igraph_destroy(&graph);
+    }
+
+    igraph_matrix_destroy(&res);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,143 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Dijkstra's algorithm uses a radix heap for integer weights. Compare its
+ * results with the Bellman-Ford algorithm, and check that the returned
+ * paths have the right length. */
+static void check(const igraph_t *graph, const igraph_vector_t *weights,
+                  igraph_neimode_t mode, igraph_real_t cutoff) {
+    igraph_matrix_t dist, ref;
+    igraph_vector_int_list_t paths;
+    igraph_vector_int_t targets;
+    igraph_integer_t n = igraph_vcount(graph);
+    igraph_integer_t no_of_from = n < 10 ? n : 10;
+
+    igraph_matrix_init(&dist, 0, 0);
+    igraph_matrix_init(&ref, 0, 0);
+    igraph_vector_int_list_init(&paths, 0);
+    igraph_vector_int_init(&targets, 0);
+
+    igraph_distances_bellman_ford(graph, &ref, igraph_vss_all(), igraph_vss_all(), weights, mode);
+    for (igraph_integer_t i = 0; i < n; i++) {
+        for (igraph_integer_t j = 0; j < n; j++) {
+            if (cutoff >= 0 && MATRIX(ref, i, j) > cutoff) {
+                MATRIX(ref, i, j) = IGRAPH_INFINITY;
+            }
+        }
+    }
+
+    igraph_distances_dijkstra_cutoff(graph, &dist, igraph_vss_all(), igraph_vss_all(), weights, mode, cutoff);
+    IGRAPH_ASSERT(igraph_matrix_all_e(&dist, &ref));
+
+    for (igraph_integer_t i = 0; i < n; i += 5) {
+        igraph_vector_int_push_back(&targets, i);
+    }
+    igraph_distances_dijkstra_cutoff(graph, &dist, igraph_vss_range(0, no_of_from), igraph_vss_vector(&targets),
+                                     weights, mode, cutoff);
+    for (igraph_integer_t i = 0; i < no_of_from; i++) {
+        for (igraph_integer_t j = 0; j < igraph_vector_int_size(&targets); j++) {
+            IGRAPH_ASSERT(MATRIX(dist, i, j) == MATRIX(ref, i, VECTOR(targets)[j]));
+        }
+    }
+
+    if (cutoff < 0) {
+        igraph_get_shortest_paths_dijkstra(graph, NULL, &paths, 0, igraph_vss_all(), weights, mode, NULL, NULL);
+        for (igraph_integer_t j = 0; j < n; j++) {
+            const igraph_vector_int_t *path = igraph_vector_int_list_get_ptr(&paths, j);
+            igraph_real_t length = 0;
+            for (igraph_integer_t k = 0; k < igraph_vector_int_size(path); k++) {
+                length += VECTOR(*weights)[VECTOR(*path)[k]];
+            }
+            /* Edges with infinite weight may appear in paths to vertices
+             * that are otherwise unreachable. */
+            if (isfinite(MATRIX(ref, 0, j))) {
+                IGRAPH_ASSERT(length == MATRIX(ref, 0, j));
+            }
+        }
+    }
+
+    igraph_vector_int_destroy(&targets);
+    igraph_vector_int_list_destroy(&paths);
+    igraph_matrix_destroy(&ref);
+    igraph_matrix_destroy(&dist);
+}
+
+static void random_weights(igraph_vector_t *weights, igraph_integer_t size, igraph_integer_t max) {
+    igraph_vector_resize(weights, size);
+    for (igraph_integer_t i = 0; i < size; i++) {
+        VECTOR(*weights)[i] = RNG_INTEGER(0, max);
+    }
+}
+
+int main(void) {
+    igraph_t graph;
+    igraph_vector_t weights;
+    igraph_matrix_t dist;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_set_warning_handler(igraph_warning_handler_ignore);
+    igraph_matrix_init(&dist, 0, 0);
+
+    printf("Small graph:\n");
+    igraph_small(&graph, 5, IGRAPH_DIRECTED,
+                 0,1, 1,2, 0,2, 2,3, 3,4, 0,4,
+                 -1);
+    igraph_vector_init_int(&weights, 6, 2, 3, 6, 0, 1, 10);
+    igraph_distances_dijkstra(&graph, &dist, igraph_vss_all(), igraph_vss_all(), &weights, IGRAPH_OUT);
+    print_matrix(&dist);
+    check(&graph, &weights, IGRAPH_OUT, -1);
+    check(&graph, &weights, IGRAPH_ALL, 3);
+    igraph_destroy(&graph);
+
+    printf("Random directed graph with small weights:\n");
+    igraph_erdos_renyi_game_gnm(&graph, 200, 1000, IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    random_weights(&weights, igraph_ecount(&graph), 3);
+    check(&graph, &weights, IGRAPH_OUT, -1);
+    check(&graph, &weights, IGRAPH_IN, -1);
+    check(&graph, &weights, IGRAPH_OUT, 4);
+
+    printf("Random directed graph with large weights:\n");
+    random_weights(&weights, igraph_ecount(&graph), 1000000000);
+    check(&graph, &weights, IGRAPH_OUT, -1);
+    check(&graph, &weights, IGRAPH_ALL, 2e9);
+
+    printf("Infinite weights:\n");
+    for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i += 3) {
+        VECTOR(weights)[i] = IGRAPH_INFINITY;
+    }
+    check(&graph, &weights, IGRAPH_OUT, -1);
+    igraph_destroy(&graph);
+
+    printf("Undirected graph with weights too large for exact path lengths:\n");
+    igraph_erdos_renyi_game_gnm(&graph, 100, 300, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    random_weights(&weights, igraph_ecount(&graph), 10);
+    for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+        VECTOR(weights)[i] *= 1e15;
+    }
+    check(&graph, &weights, IGRAPH_ALL, -1);
+    igraph_destroy(&graph);
+
+    igraph_matrix_destroy(&dist);
+    igraph_vector_destroy(&weights);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
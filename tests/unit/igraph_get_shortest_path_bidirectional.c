@@ -0,0 +1,153 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Checks that the path is a valid walk from 'from' to 'to' in the given mode,
+ * and returns its length. */
+static igraph_real_t path_length(const igraph_t *graph, const igraph_vector_int_t *vertices,
+                                 const igraph_vector_int_t *edges, const igraph_vector_t *weights,
+                                 igraph_integer_t from, igraph_integer_t to, igraph_neimode_t mode) {
+    igraph_integer_t len = igraph_vector_int_size(edges);
+    igraph_real_t length = 0;
+
+    IGRAPH_ASSERT(igraph_vector_int_size(vertices) == len + 1);
+    IGRAPH_ASSERT(VECTOR(*vertices)[0] == from);
+    IGRAPH_ASSERT(VECTOR(*vertices)[len] == to);
+    for (igraph_integer_t i = 0; i < len; i++) {
+        igraph_integer_t e = VECTOR(*edges)[i];
+        igraph_integer_t u = VECTOR(*vertices)[i], v = VECTOR(*vertices)[i + 1];
+        if (!igraph_is_directed(graph) || mode == IGRAPH_ALL) {
+            IGRAPH_ASSERT((IGRAPH_FROM(graph, e) == u && IGRAPH_TO(graph, e) == v) ||
+                          (IGRAPH_FROM(graph, e) == v && IGRAPH_TO(graph, e) == u));
+        } else if (mode == IGRAPH_OUT) {
+            IGRAPH_ASSERT(IGRAPH_FROM(graph, e) == u && IGRAPH_TO(graph, e) == v);
+        } else {
+            IGRAPH_ASSERT(IGRAPH_FROM(graph, e) == v && IGRAPH_TO(graph, e) == u);
+        }
+        length += weights ? VECTOR(*weights)[e] : 1;
+    }
+
+    return length;
+}
+
+static void check_all_pairs(const igraph_t *graph, const igraph_vector_t *weights, igraph_neimode_t mode) {
+    igraph_integer_t n = igraph_vcount(graph);
+    igraph_matrix_t dist;
+    igraph_vector_int_t vertices, edges;
+
+    igraph_matrix_init(&dist, 0, 0);
+    igraph_vector_int_init(&vertices, 0);
+    igraph_vector_int_init(&edges, 0);
+
+    igraph_distances_dijkstra(graph, &dist, igraph_vss_all(), igraph_vss_all(), weights, mode);
+
+    for (igraph_integer_t from = 0; from < n; from++) {
+        for (igraph_integer_t to = 0; to < n; to++) {
+            igraph_get_shortest_path_bidirectional(graph, &vertices, &edges, from, to, weights, mode);
+            if (MATRIX(dist, from, to) == IGRAPH_INFINITY) {
+                IGRAPH_ASSERT(igraph_vector_int_size(&vertices) == 0);
+                IGRAPH_ASSERT(igraph_vector_int_size(&edges) == 0);
+            } else {
+                igraph_real_t length = path_length(graph, &vertices, &edges, weights, from, to, mode);
+                IGRAPH_ASSERT(igraph_cmp_epsilon(length, MATRIX(dist, from, to), 1e-12) == 0);
+            }
+        }
+    }
+
+    igraph_vector_int_destroy(&edges);
+    igraph_vector_int_destroy(&vertices);
+    igraph_matrix_destroy(&dist);
+}
+
+int main(void) {
+    igraph_t graph;
+    igraph_vector_t weights;
+    igraph_vector_int_t vertices, edges;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_set_warning_handler(igraph_warning_handler_ignore);
+
+    igraph_vector_int_init(&vertices, 0);
+    igraph_vector_int_init(&edges, 0);
+
+    printf("Small weighted graph:\n");
+    igraph_small(&graph, 6, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,5, 0,3, 3,4, 4,5, 1,4,
+                 -1);
+    igraph_vector_init_int(&weights, 7, 1, 1, 5, 2, 2, 1, 3);
+    igraph_get_shortest_path_bidirectional(&graph, &vertices, &edges, 0, 5, &weights, IGRAPH_OUT);
+    print_vector_int(&vertices);
+    print_vector_int(&edges);
+    igraph_get_shortest_path_bidirectional(&graph, &vertices, &edges, 5, 0, &weights, IGRAPH_IN);
+    print_vector_int(&vertices);
+    print_vector_int(&edges);
+
+    printf("Same source and target:\n");
+    igraph_get_shortest_path_bidirectional(&graph, &vertices, &edges, 2, 2, &weights, IGRAPH_OUT);
+    print_vector_int(&vertices);
+    print_vector_int(&edges);
+
+    printf("Unreachable target:\n");
+    igraph_get_shortest_path_bidirectional(&graph, &vertices, &edges, 5, 0, &weights, IGRAPH_OUT);
+    print_vector_int(&vertices);
+    print_vector_int(&edges);
+
+    printf("Errors:\n");
+    CHECK_ERROR(igraph_get_shortest_path_bidirectional(&graph, &vertices, &edges, 6, 0, &weights, IGRAPH_OUT),
+                IGRAPH_EINVVID);
+    CHECK_ERROR(igraph_get_shortest_path_bidirectional(&graph, &vertices, &edges, 0, -1, &weights, IGRAPH_OUT),
+                IGRAPH_EINVVID);
+    VECTOR(weights)[2] = -1;
+    CHECK_ERROR(igraph_get_shortest_path_bidirectional(&graph, &vertices, &edges, 0, 5, &weights, IGRAPH_OUT),
+                IGRAPH_EINVAL);
+    VECTOR(weights)[2] = IGRAPH_NAN;
+    CHECK_ERROR(igraph_get_shortest_path_bidirectional(&graph, &vertices, &edges, 0, 5, &weights, IGRAPH_OUT),
+                IGRAPH_EINVAL);
+    igraph_vector_resize(&weights, 3);
+    CHECK_ERROR(igraph_get_shortest_path_bidirectional(&graph, &vertices, &edges, 0, 5, &weights, IGRAPH_OUT),
+                IGRAPH_EINVAL);
+    igraph_vector_destroy(&weights);
+    igraph_destroy(&graph);
+
+    /* Random graphs are sparse enough to have unreachable pairs. */
+    printf("Random graphs:\n");
+    for (int directed = 0; directed <= 1; directed++) {
+        igraph_erdos_renyi_game_gnm(&graph, 60, 90, directed, IGRAPH_LOOPS);
+        igraph_vector_init(&weights, igraph_ecount(&graph));
+        for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+            VECTOR(weights)[i] = RNG_INTEGER(0, 4) == 0 ? 0 : RNG_UNIF(0, 10);
+        }
+        VECTOR(weights)[0] = IGRAPH_INFINITY;
+
+        check_all_pairs(&graph, &weights, IGRAPH_OUT);
+        check_all_pairs(&graph, &weights, IGRAPH_IN);
+        check_all_pairs(&graph, &weights, IGRAPH_ALL);
+        check_all_pairs(&graph, NULL, IGRAPH_OUT);
+
+        igraph_vector_destroy(&weights);
+        igraph_destroy(&graph);
+    }
+
+    igraph_vector_int_destroy(&edges);
+    igraph_vector_int_destroy(&vertices);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,181 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* The graph created by the builder must be identical to the one created
+ * by igraph_create(), including the internal edge indices. */
+static void check_same_as_create(const igraph_t *graph, const igraph_vector_int_t *edges,
+                                 igraph_integer_t n, igraph_bool_t directed) {
+    igraph_t ref;
+
+    igraph_create(&ref, edges, n, directed);
+
+    IGRAPH_ASSERT(igraph_vcount(graph) == igraph_vcount(&ref));
+    IGRAPH_ASSERT(igraph_is_directed(graph) == igraph_is_directed(&ref));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&graph->from, &ref.from));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&graph->to, &ref.to));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&graph->oi, &ref.oi));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&graph->ii, &ref.ii));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&graph->os, &ref.os));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&graph->is, &ref.is));
+
+    igraph_destroy(&ref);
+}
+
+static void test_random(igraph_bool_t directed, igraph_integer_t n, igraph_integer_t m) {
+    igraph_graph_builder_t builder;
+    igraph_vector_int_t edges, batch;
+    igraph_t g;
+    igraph_integer_t i;
+
+    igraph_vector_int_init(&edges, 2 * m);
+    for (i = 0; i < 2 * m; i++) {
+        VECTOR(edges)[i] = RNG_INTEGER(0, n - 1);
+    }
+
+    /* Mix single edges and batches of varying sizes. */
+    igraph_graph_builder_init(&builder, directed);
+    igraph_vector_int_init(&batch, 0);
+    for (i = 0; i < m; ) {
+        igraph_integer_t size = RNG_INTEGER(0, 1000);
+        if (size == 0) {
+            igraph_graph_builder_add_edge(&builder, VECTOR(edges)[2 * i], VECTOR(edges)[2 * i + 1]);
+            i++;
+            continue;
+        }
+        if (i + size > m) {
+            size = m - i;
+        }
+        igraph_vector_int_resize(&batch, 2 * size);
+        for (igraph_integer_t j = 0; j < 2 * size; j++) {
+            VECTOR(batch)[j] = VECTOR(edges)[2 * i + j];
+        }
+        igraph_graph_builder_add_edges(&builder, &batch, NULL);
+        i += size;
+    }
+    IGRAPH_ASSERT(igraph_graph_builder_ecount(&builder) == m);
+
+    igraph_graph_builder_finalize(&builder, &g);
+    IGRAPH_ASSERT(igraph_graph_builder_ecount(&builder) == 0);
+    check_same_as_create(&g, &edges, n, directed);
+
+    igraph_destroy(&g);
+    igraph_vector_int_destroy(&batch);
+    igraph_vector_int_destroy(&edges);
+    igraph_graph_builder_destroy(&builder);
+}
+
+int main(void) {
+    igraph_graph_builder_t builder;
+    igraph_vector_int_t edges;
+    igraph_vector_t weights;
+    igraph_strvector_t names;
+    igraph_attribute_record_t wrec = { "weight", IGRAPH_ATTRIBUTE_NUMERIC, &weights };
+    igraph_attribute_record_t nrec = { "name", IGRAPH_ATTRIBUTE_STRING, &names };
+    igraph_vector_ptr_t eattr, vattr;
+    igraph_t g;
+
+    igraph_rng_seed(igraph_rng_default(), 137);
+
+    printf("Empty builder:\n");
+    igraph_graph_builder_init(&builder, IGRAPH_DIRECTED);
+    igraph_graph_builder_finalize(&builder, &g);
+    print_graph(&g);
+    igraph_destroy(&g);
+
+    printf("\nVertex count grows with the referenced vertex IDs:\n");
+    igraph_graph_builder_add_vertices(&builder, 3, NULL);
+    igraph_graph_builder_add_edge(&builder, 0, 1);
+    igraph_vector_int_init_int(&edges, 6, 2, 2, 4, 1, 0, 1);
+    igraph_graph_builder_add_edges(&builder, &edges, NULL);
+    IGRAPH_ASSERT(igraph_graph_builder_vcount(&builder) == 5);
+    IGRAPH_ASSERT(igraph_graph_builder_ecount(&builder) == 4);
+    igraph_graph_builder_finalize(&builder, &g);
+    print_graph(&g);
+    igraph_destroy(&g);
+    igraph_graph_builder_destroy(&builder);
+
+    printf("\nAttributes:\n");
+    igraph_set_attribute_table(&igraph_cattribute_table);
+    igraph_vector_ptr_init(&vattr, 1);
+    igraph_vector_ptr_init(&eattr, 1);
+    VECTOR(vattr)[0] = &nrec;
+    VECTOR(eattr)[0] = &wrec;
+    igraph_vector_init_int(&weights, 3, 5, 6, 7);
+    igraph_strvector_init(&names, 0);
+    igraph_strvector_push_back(&names, "a");
+    igraph_strvector_push_back(&names, "b");
+
+    igraph_graph_builder_init(&builder, IGRAPH_UNDIRECTED);
+    igraph_graph_builder_add_vertices(&builder, 1, NULL);
+    igraph_graph_builder_add_vertices(&builder, 2, &vattr);
+    igraph_graph_builder_add_edge(&builder, 0, 1);
+    igraph_graph_builder_add_edges(&builder, &edges, &eattr);
+    igraph_graph_builder_add_edge(&builder, 2, 0);
+    igraph_graph_builder_finalize(&builder, &g);
+    print_graph(&g);
+    print_attributes(&g);
+    igraph_destroy(&g);
+
+    printf("\nErrors:\n");
+    CHECK_ERROR(igraph_graph_builder_add_vertices(&builder, -1, NULL), IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_graph_builder_add_edge(&builder, 0, -1), IGRAPH_EINVVID);
+    igraph_vector_int_resize(&edges, 3);
+    CHECK_ERROR(igraph_graph_builder_add_edges(&builder, &edges, NULL), IGRAPH_EINVEVECTOR);
+    igraph_vector_int_resize(&edges, 2);
+    VECTOR(edges)[0] = -2;
+    CHECK_ERROR(igraph_graph_builder_add_edges(&builder, &edges, NULL), IGRAPH_EINVVID);
+
+    /* Too few values, and mismatching types; the builder must stay unchanged. */
+    VECTOR(edges)[0] = 1;
+    VECTOR(edges)[1] = 0;
+    igraph_graph_builder_add_edges(&builder, &edges, &eattr);
+    igraph_vector_int_resize(&edges, 8);
+    igraph_vector_int_fill(&edges, 0);
+    CHECK_ERROR(igraph_graph_builder_add_edges(&builder, &edges, &eattr), IGRAPH_EINVAL);
+    igraph_graph_builder_add_vertices(&builder, 1, &vattr);
+    VECTOR(vattr)[0] = &wrec;
+    wrec.name = "name";
+    CHECK_ERROR(igraph_graph_builder_add_vertices(&builder, 1, &vattr), IGRAPH_EINVAL);
+    IGRAPH_ASSERT(igraph_graph_builder_ecount(&builder) == 1);
+    IGRAPH_ASSERT(igraph_graph_builder_vcount(&builder) == 2);
+    igraph_graph_builder_finalize(&builder, &g);
+    print_graph(&g);
+    print_attributes(&g);
+    igraph_destroy(&g);
+    igraph_graph_builder_destroy(&builder);
+
+    igraph_set_attribute_table(NULL);
+
+    igraph_strvector_destroy(&names);
+    igraph_vector_destroy(&weights);
+    igraph_vector_ptr_destroy(&vattr);
+    igraph_vector_ptr_destroy(&eattr);
+    igraph_vector_int_destroy(&edges);
+
+    /* Graphs spanning several chunks. */
+    test_random(IGRAPH_DIRECTED, 1000, 150000);
+    test_random(IGRAPH_UNDIRECTED, 1000, 150000);
+    test_random(IGRAPH_DIRECTED, 3, 1000);
+    test_random(IGRAPH_UNDIRECTED, 200000, 70000);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,144 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* A* with the landmark heuristic must find paths of the same length as
+ * Dijkstra's algorithm, and the heuristic must never overestimate. */
+static void check_landmarks(const igraph_t *graph, const igraph_vector_t *weights,
+                            igraph_neimode_t mode, igraph_integer_t no_of_landmarks) {
+    igraph_integer_t n = igraph_vcount(graph);
+    igraph_landmark_index_t index;
+    igraph_matrix_t dist;
+    igraph_vector_int_t vertices, edges;
+
+    igraph_matrix_init(&dist, 0, 0);
+    igraph_vector_int_init(&vertices, 0);
+    igraph_vector_int_init(&edges, 0);
+
+    igraph_distances_dijkstra(graph, &dist, igraph_vss_all(), igraph_vss_all(), weights, mode);
+    igraph_landmark_index_init(&index, graph, weights, mode, no_of_landmarks);
+
+    for (igraph_integer_t from = 0; from < n; from++) {
+        for (igraph_integer_t to = 0; to < n; to++) {
+            igraph_real_t h, length = 0;
+
+            igraph_landmark_heuristic(&h, from, to, &index);
+            IGRAPH_ASSERT(h >= 0);
+            IGRAPH_ASSERT(h <= MATRIX(dist, from, to) * (1 + 1e-12));
+
+            igraph_get_shortest_path_astar(graph, &vertices, &edges, from, to, weights, mode,
+                                           igraph_landmark_heuristic, &index);
+            if (MATRIX(dist, from, to) == IGRAPH_INFINITY) {
+                IGRAPH_ASSERT(igraph_vector_int_size(&vertices) == 0);
+                continue;
+            }
+            IGRAPH_ASSERT(VECTOR(vertices)[0] == from);
+            IGRAPH_ASSERT(igraph_vector_int_tail(&vertices) == to);
+            for (igraph_integer_t i = 0; i < igraph_vector_int_size(&edges); i++) {
+                length += weights ? VECTOR(*weights)[VECTOR(edges)[i]] : 1;
+            }
+            IGRAPH_ASSERT(igraph_cmp_epsilon(length, MATRIX(dist, from, to), 1e-12) == 0);
+        }
+    }
+
+    igraph_landmark_index_destroy(&index);
+    igraph_vector_int_destroy(&edges);
+    igraph_vector_int_destroy(&vertices);
+    igraph_matrix_destroy(&dist);
+}
+
+int main(void) {
+    igraph_t graph;
+    igraph_vector_t weights;
+    igraph_vector_int_t landmarks;
+    igraph_landmark_index_t index;
+    igraph_real_t h;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+    igraph_set_warning_handler(igraph_warning_handler_ignore);
+
+    igraph_vector_int_init(&landmarks, 0);
+
+    printf("Landmarks on a path, starting from the largest degree:\n");
+    igraph_small(&graph, 7, IGRAPH_UNDIRECTED,
+                 0,1, 1,2, 2,3, 3,4, 4,5, 5,6, 3,0,
+                 -1);
+    igraph_landmark_index_init(&index, &graph, NULL, IGRAPH_ALL, 3);
+    igraph_landmark_index_landmarks(&index, &landmarks);
+    print_vector_int(&landmarks);
+    igraph_landmark_heuristic(&h, 6, 0, &index);
+    printf("Estimate for 6 -> 0: %g\n", h);
+    igraph_landmark_index_destroy(&index);
+
+    printf("More landmarks than vertices:\n");
+    igraph_landmark_index_init(&index, &graph, NULL, IGRAPH_ALL, 100);
+    igraph_landmark_index_landmarks(&index, &landmarks);
+    print_vector_int(&landmarks);
+    igraph_landmark_index_destroy(&index);
+
+    printf("Every component gets a landmark:\n");
+    igraph_add_vertices(&graph, 3, NULL);
+    igraph_add_edge(&graph, 7, 8);
+    igraph_landmark_index_init(&index, &graph, NULL, IGRAPH_ALL, 4);
+    igraph_landmark_index_landmarks(&index, &landmarks);
+    print_vector_int(&landmarks);
+    igraph_landmark_heuristic(&h, 0, 8, &index);
+    printf("Estimate for 0 -> 8: %g\n", h);
+    igraph_landmark_index_destroy(&index);
+
+    printf("Errors:\n");
+    CHECK_ERROR(igraph_landmark_index_init(&index, &graph, NULL, IGRAPH_ALL, -1), IGRAPH_EINVAL);
+    igraph_vector_init(&weights, 2);
+    CHECK_ERROR(igraph_landmark_index_init(&index, &graph, &weights, IGRAPH_ALL, 2), IGRAPH_EINVAL);
+    igraph_vector_destroy(&weights);
+    igraph_destroy(&graph);
+
+    printf("Graph without vertices:\n");
+    igraph_empty(&graph, 0, IGRAPH_DIRECTED);
+    igraph_landmark_index_init(&index, &graph, NULL, IGRAPH_OUT, 5);
+    igraph_landmark_index_landmarks(&index, &landmarks);
+    print_vector_int(&landmarks);
+    igraph_landmark_index_destroy(&index);
+    igraph_destroy(&graph);
+
+    printf("Random graphs:\n");
+    for (int directed = 0; directed <= 1; directed++) {
+        igraph_erdos_renyi_game_gnm(&graph, 60, 120, directed, IGRAPH_LOOPS);
+        igraph_vector_init(&weights, igraph_ecount(&graph));
+        for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+            VECTOR(weights)[i] = RNG_INTEGER(0, 4) == 0 ? 0 : RNG_UNIF(0, 10);
+        }
+        VECTOR(weights)[0] = IGRAPH_INFINITY;
+
+        check_landmarks(&graph, &weights, IGRAPH_OUT, 4);
+        check_landmarks(&graph, &weights, IGRAPH_IN, 4);
+        check_landmarks(&graph, &weights, IGRAPH_ALL, 4);
+        check_landmarks(&graph, NULL, IGRAPH_OUT, 8);
+        check_landmarks(&graph, &weights, IGRAPH_OUT, 0);
+
+        igraph_vector_destroy(&weights);
+        igraph_destroy(&graph);
+    }
+
+    igraph_vector_int_destroy(&landmarks);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
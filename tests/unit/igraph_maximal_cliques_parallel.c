@@ -0,0 +1,142 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "cliques/maximal_cliques.h"
+#include "test_utilities.h"
+
+/* The parallel search is only used automatically on large graphs, so it is
+ * forced here. This test is run with several OpenMP threads when igraph is
+ * compiled with OpenMP support. The results must be the same as those of the
+ * serial search, including the order of the cliques. */
+
+typedef struct {
+    const igraph_vector_int_list_t *expected;
+    igraph_integer_t next;
+    igraph_integer_t stop_after;
+} handler_data_t;
+
+static igraph_error_t handler(const igraph_vector_int_t *clique, void *arg) {
+    handler_data_t *data = (handler_data_t *) arg;
+
+    IGRAPH_ASSERT(data->next < igraph_vector_int_list_size(data->expected));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(
+                      clique, igraph_vector_int_list_get_ptr(data->expected, data->next)));
+    data->next++;
+
+    return data->next == data->stop_after ? IGRAPH_STOP : IGRAPH_SUCCESS;
+}
+
+static igraph_error_t handler_error(const igraph_vector_int_t *clique, void *arg) {
+    IGRAPH_UNUSED(clique);
+    IGRAPH_UNUSED(arg);
+    return IGRAPH_EINVAL;
+}
+
+static void compare(const igraph_t *graph, igraph_integer_t min_size, igraph_integer_t max_size) {
+    igraph_vector_int_list_t serial, parallel;
+    igraph_vector_t serial_hist, parallel_hist;
+    igraph_integer_t serial_count, parallel_count;
+    handler_data_t data;
+
+    igraph_vector_int_list_init(&serial, 0);
+    igraph_vector_int_list_init(&parallel, 0);
+    igraph_i_maximal_cliques(graph, &serial, min_size, max_size, -1);
+    igraph_i_maximal_cliques(graph, &parallel, min_size, max_size, 0);
+    IGRAPH_ASSERT(igraph_vector_int_list_size(&serial) == igraph_vector_int_list_size(&parallel));
+    for (igraph_integer_t i = 0; i < igraph_vector_int_list_size(&serial); i++) {
+        IGRAPH_ASSERT(igraph_vector_int_all_e(igraph_vector_int_list_get_ptr(&serial, i),
+                                              igraph_vector_int_list_get_ptr(&parallel, i)));
+    }
+
+    igraph_i_maximal_cliques_count(graph, &serial_count, min_size, max_size, -1);
+    igraph_i_maximal_cliques_count(graph, &parallel_count, min_size, max_size, 0);
+    IGRAPH_ASSERT(serial_count == igraph_vector_int_list_size(&serial));
+    IGRAPH_ASSERT(parallel_count == serial_count);
+
+    igraph_vector_init(&serial_hist, 0);
+    igraph_vector_init(&parallel_hist, 0);
+    igraph_i_maximal_cliques_hist(graph, &serial_hist, min_size, max_size, -1);
+    igraph_i_maximal_cliques_hist(graph, &parallel_hist, min_size, max_size, 0);
+    IGRAPH_ASSERT(igraph_vector_all_e(&serial_hist, &parallel_hist));
+    igraph_vector_destroy(&parallel_hist);
+    igraph_vector_destroy(&serial_hist);
+
+    data.expected = &serial;
+    data.next = 0;
+    data.stop_after = -1;
+    IGRAPH_ASSERT(igraph_i_maximal_cliques_callback(graph, &handler, &data, min_size, max_size, 0) == IGRAPH_SUCCESS);
+    IGRAPH_ASSERT(data.next == serial_count);
+
+    /* Stopping the search */
+    if (serial_count > 1) {
+        data.next = 0;
+        data.stop_after = serial_count / 2;
+        IGRAPH_ASSERT(igraph_i_maximal_cliques_callback(graph, &handler, &data, min_size, max_size, 0) == IGRAPH_SUCCESS);
+        IGRAPH_ASSERT(data.next == serial_count / 2);
+    }
+
+    igraph_vector_int_list_destroy(&parallel);
+    igraph_vector_int_list_destroy(&serial);
+}
+
+int main(void) {
+    igraph_t graph;
+    igraph_vector_int_list_t cliques;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    printf("Small graph:\n");
+    igraph_small(&graph, 7, IGRAPH_UNDIRECTED,
+                 0,1, 0,2, 1,2, 1,3, 2,3, 3,4, 4,5,
+                 -1);
+    igraph_vector_int_list_init(&cliques, 0);
+    igraph_i_maximal_cliques(&graph, &cliques, 0, 0, 0);
+    print_vector_int_list(&cliques);
+    compare(&graph, 0, 0);
+
+    printf("Errors from the callback:\n");
+    CHECK_ERROR(igraph_i_maximal_cliques_callback(&graph, &handler_error, NULL, 0, 0, 0), IGRAPH_EINVAL);
+    igraph_destroy(&graph);
+
+    printf("Null graph:\n");
+    igraph_empty(&graph, 0, IGRAPH_UNDIRECTED);
+    igraph_i_maximal_cliques(&graph, &cliques, 0, 0, 0);
+    print_vector_int_list(&cliques);
+    compare(&graph, 0, 0);
+    igraph_destroy(&graph);
+    igraph_vector_int_list_destroy(&cliques);
+
+    /* Enough vertices for several blocks of the parallel search */
+    printf("Random graphs:\n");
+    igraph_erdos_renyi_game_gnm(&graph, 5000, 40000, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    compare(&graph, 0, 0);
+    compare(&graph, 3, 0);
+    compare(&graph, 2, 3);
+    igraph_destroy(&graph);
+
+    igraph_erdos_renyi_game_gnp(&graph, 300, 0.3, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    compare(&graph, 0, 0);
+    compare(&graph, 6, 7);
+    igraph_destroy(&graph);
+
+    printf("OK\n");
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
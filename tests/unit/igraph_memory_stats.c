@@ -0,0 +1,141 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+static size_t current(igraph_memory_category_t category) {
+    igraph_memory_stats_t stats;
+    igraph_memory_stats(&stats);
+    return stats.current_by_category[category];
+}
+
+static size_t total(void) {
+    igraph_memory_stats_t stats;
+    igraph_memory_stats(&stats);
+    return stats.current;
+}
+
+int main(void) {
+    igraph_memory_stats_t stats;
+    igraph_t graph, copy, view;
+    igraph_vector_t vec;
+    igraph_matrix_t mat;
+    igraph_adjlist_t adjlist;
+    igraph_sparsemat_t spmat;
+    size_t before;
+
+    /* Memory tracking must be turned on before igraph allocates memory. */
+    igraph_memory_stats(&stats);
+    IGRAPH_ASSERT(stats.current == 0 && stats.peak == 0 && stats.blocks == 0);
+    IGRAPH_ASSERT(! igraph_set_memory_tracking(true));
+
+    igraph_set_attribute_table(&igraph_cattribute_table);
+
+    printf("Graph and attributes.\n");
+    igraph_ring(&graph, 100, IGRAPH_UNDIRECTED, false, true);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_GRAPH) > 0);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_ATTRIBUTES) > 0);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_GRAPH) + current(IGRAPH_MEMORY_ATTRIBUTES) == total());
+    IGRAPH_ASSERT(igraph_graph_memory_size(&graph) == total());
+
+    /* Attributes set directly are included in the size of the graph. */
+    SETGAS(&graph, "name", "ring");
+    SETVAN(&graph, "weight", 3, 2.5);
+    SETEAS(&graph, "color", 7, "red");
+    SETEAB(&graph, "marked", 7, true);
+    IGRAPH_ASSERT(igraph_graph_memory_size(&graph) == total());
+
+    /* Growing the graph keeps its memory in the graph category. */
+    before = current(IGRAPH_MEMORY_GRAPH);
+    igraph_add_edge(&graph, 0, 50);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_GRAPH) > before);
+    IGRAPH_ASSERT(igraph_graph_memory_size(&graph) == total());
+
+    /* Attributes of copies are allocated by the attribute handler. */
+    before = total();
+    igraph_copy(&copy, &graph);
+    IGRAPH_ASSERT(total() - before == igraph_graph_memory_size(&copy));
+    igraph_delete_vertices(&copy, igraph_vss_1(0));
+    IGRAPH_ASSERT(total() - before == igraph_graph_memory_size(&copy));
+    igraph_destroy(&copy);
+    IGRAPH_ASSERT(total() == before);
+
+    printf("Graph views.\n");
+    igraph_create_view(&view, igraph_vcount(&graph), igraph_ecount(&graph), false,
+                       VECTOR(graph.from), VECTOR(graph.to), VECTOR(graph.oi),
+                       VECTOR(graph.ii), VECTOR(graph.os), VECTOR(graph.is), true);
+    IGRAPH_ASSERT(igraph_graph_memory_size(&view) < igraph_graph_memory_size(&graph));
+    IGRAPH_ASSERT(total() - before == igraph_graph_memory_size(&view));
+    igraph_destroy(&view);
+
+    printf("Vectors and matrices.\n");
+    before = current(IGRAPH_MEMORY_VECTOR);
+    igraph_vector_init(&vec, 50);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_VECTOR) - before == 50 * sizeof(igraph_real_t));
+    igraph_vector_reserve(&vec, 80);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_VECTOR) - before == 80 * sizeof(igraph_real_t));
+
+    igraph_matrix_init(&mat, 10, 20);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_MATRIX) == 200 * sizeof(igraph_real_t));
+    igraph_matrix_resize(&mat, 20, 20);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_MATRIX) == 400 * sizeof(igraph_real_t));
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_VECTOR) - before == 80 * sizeof(igraph_real_t));
+    igraph_matrix_destroy(&mat);
+    igraph_vector_destroy(&vec);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_MATRIX) == 0);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_VECTOR) == before);
+
+    printf("Adjacency lists.\n");
+    igraph_adjlist_init(&graph, &adjlist, IGRAPH_ALL, IGRAPH_LOOPS, IGRAPH_MULTIPLE);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_ADJLIST) >= 2 * igraph_ecount(&graph) * sizeof(igraph_integer_t));
+    igraph_adjlist_destroy(&adjlist);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_ADJLIST) == 0);
+
+    printf("Sparse matrices.\n");
+    igraph_sparsemat_init(&spmat, 10, 10, 20);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_SPARSEMAT) > 0);
+    igraph_sparsemat_destroy(&spmat);
+    IGRAPH_ASSERT(current(IGRAPH_MEMORY_SPARSEMAT) == 0);
+
+    printf("Peak memory use.\n");
+    before = total();
+    igraph_memory_stats_reset_peak();
+    igraph_memory_stats(&stats);
+    IGRAPH_ASSERT(stats.peak == before);
+    igraph_vector_init(&vec, 100000);
+    igraph_vector_destroy(&vec);
+    igraph_memory_stats(&stats);
+    IGRAPH_ASSERT(stats.current == before);
+    IGRAPH_ASSERT(stats.peak >= before + 100000 * sizeof(igraph_real_t));
+    IGRAPH_ASSERT(stats.peak_by_category[IGRAPH_MEMORY_VECTOR] >= 100000 * sizeof(igraph_real_t));
+
+    /* All memory is released after the graph is destroyed. */
+    igraph_destroy(&graph);
+    igraph_memory_stats(&stats);
+    IGRAPH_ASSERT(stats.current == 0);
+    IGRAPH_ASSERT(stats.blocks == 0);
+    for (int i = 0; i < IGRAPH_MEMORY_CATEGORY_COUNT; i++) {
+        IGRAPH_ASSERT(stats.current_by_category[i] == 0);
+    }
+
+    IGRAPH_ASSERT(igraph_set_memory_tracking(false));
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,152 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Compares each column of the batch result with PRPACK. */
+static void compare(const igraph_t *graph, igraph_bool_t directed,
+                    const igraph_matrix_t *reset, const igraph_vector_t *weights) {
+    igraph_matrix_t res;
+    igraph_vector_t column, expected;
+    igraph_integer_t n = igraph_vcount(graph);
+    igraph_arpack_options_t options;
+
+    igraph_matrix_init(&res, 0, 0);
+    igraph_vector_init(&column, n);
+    igraph_vector_init(&expected, 0);
+    igraph_arpack_options_init(&options);
+
+    igraph_personalized_pagerank_batch(graph, &res, directed, 0.85, reset, weights, &options);
+    IGRAPH_ASSERT(options.nconv == 1 && options.noiter > 0);
+    IGRAPH_ASSERT(igraph_matrix_nrow(&res) == n);
+    IGRAPH_ASSERT(igraph_matrix_ncol(&res) == igraph_matrix_ncol(reset));
+
+    for (igraph_integer_t c = 0; c < igraph_matrix_ncol(reset); c++) {
+        igraph_matrix_get_col(reset, &column, c);
+        igraph_personalized_pagerank(graph, IGRAPH_PAGERANK_ALGO_PRPACK, &expected, NULL,
+                                     igraph_vss_all(), directed, 0.85, &column, weights, NULL);
+        for (igraph_integer_t i = 0; i < n; i++) {
+            IGRAPH_ASSERT(fabs(MATRIX(res, i, c) - VECTOR(expected)[i]) < 1e-9);
+        }
+    }
+
+    igraph_vector_destroy(&expected);
+    igraph_vector_destroy(&column);
+    igraph_matrix_destroy(&res);
+}
+
+int main(void) {
+    igraph_t graph;
+    igraph_matrix_t reset, res;
+    igraph_vector_t weights;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    igraph_matrix_init(&res, 0, 0);
+
+    printf("Small directed graph with a dangling vertex:\n");
+    igraph_small(&graph, 5, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,0, 3,2, 0,2, 2,4,
+                 -1);
+    /* A single vertex, two vertices, and the uniform distribution. */
+    matrix_init_real_row_major(&reset, 5, 3,
+                               (igraph_real_t[]) { 1, 0, 1,
+                                                   0, 0, 1,
+                                                   0, 0, 1,
+                                                   0, 2, 1,
+                                                   0, 2, 1 });
+    igraph_personalized_pagerank_batch(&graph, &res, IGRAPH_DIRECTED, 0.85, &reset, NULL, NULL);
+    print_matrix(&res);
+    compare(&graph, IGRAPH_DIRECTED, &reset, NULL);
+    compare(&graph, IGRAPH_UNDIRECTED, &reset, NULL);
+
+    printf("Weighted, with zero weights:\n");
+    igraph_vector_init_int(&weights, 6, 1, 2, 0, 3, 1, 0);
+    compare(&graph, IGRAPH_DIRECTED, &reset, &weights);
+    compare(&graph, IGRAPH_UNDIRECTED, &reset, &weights);
+
+    printf("Errors:\n");
+    MATRIX(reset, 2, 2) = -1;
+    CHECK_ERROR(igraph_personalized_pagerank_batch(&graph, &res, IGRAPH_DIRECTED, 0.85, &reset, NULL, NULL),
+                IGRAPH_EINVAL);
+    igraph_matrix_null(&reset);
+    CHECK_ERROR(igraph_personalized_pagerank_batch(&graph, &res, IGRAPH_DIRECTED, 0.85, &reset, NULL, NULL),
+                IGRAPH_EINVAL);
+    igraph_matrix_resize(&reset, 4, 3);
+    CHECK_ERROR(igraph_personalized_pagerank_batch(&graph, &res, IGRAPH_DIRECTED, 0.85, &reset, NULL, NULL),
+                IGRAPH_EINVAL);
+    igraph_matrix_resize(&reset, 5, 3);
+    igraph_matrix_fill(&reset, 1);
+    CHECK_ERROR(igraph_personalized_pagerank_batch(&graph, &res, IGRAPH_DIRECTED, 1.5, &reset, NULL, NULL),
+                IGRAPH_EINVAL);
+    igraph_vector_resize(&weights, 2);
+    CHECK_ERROR(igraph_personalized_pagerank_batch(&graph, &res, IGRAPH_DIRECTED, 0.85, &reset, &weights, NULL),
+                IGRAPH_EINVAL);
+    igraph_vector_destroy(&weights);
+
+    printf("No reset distributions:\n");
+    igraph_matrix_resize(&reset, 5, 0);
+    igraph_personalized_pagerank_batch(&graph, &res, IGRAPH_DIRECTED, 0.85, &reset, NULL, NULL);
+    printf("%" IGRAPH_PRId " x %" IGRAPH_PRId "\n", igraph_matrix_nrow(&res), igraph_matrix_ncol(&res));
+    igraph_destroy(&graph);
+
+    printf("Graph without vertices:\n");
+    igraph_empty(&graph, 0, IGRAPH_DIRECTED);
+    igraph_matrix_resize(&reset, 0, 2);
+    igraph_personalized_pagerank_batch(&graph, &res, IGRAPH_DIRECTED, 0.85, &reset, NULL, NULL);
+    printf("%" IGRAPH_PRId " x %" IGRAPH_PRId "\n", igraph_matrix_nrow(&res), igraph_matrix_ncol(&res));
+    igraph_destroy(&graph);
+
+    /* Enough distributions to be processed in several chunks. */
+    printf("Many reset distributions.\n");
+    igraph_erdos_renyi_game_gnm(&graph, 200, 800, IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    igraph_matrix_resize(&reset, igraph_vcount(&graph), 70);
+    igraph_matrix_null(&reset);
+    for (igraph_integer_t c = 0; c < 70; c++) {
+        MATRIX(reset, c, c) = 1;
+        MATRIX(reset, RNG_INTEGER(0, igraph_vcount(&graph) - 1), c) += 1;
+    }
+    compare(&graph, IGRAPH_DIRECTED, &reset, NULL);
+    igraph_destroy(&graph);
+
+    /* Large enough to be processed in several blocks. */
+    printf("Random graph.\n");
+    igraph_erdos_renyi_game_gnm(&graph, 20000, 80000, IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    igraph_matrix_resize(&reset, igraph_vcount(&graph), 8);
+    igraph_matrix_null(&reset);
+    for (igraph_integer_t c = 0; c < 8; c++) {
+        for (igraph_integer_t j = 0; j <= c; j++) {
+            MATRIX(reset, RNG_INTEGER(0, igraph_vcount(&graph) - 1), c) += 1;
+        }
+    }
+    compare(&graph, IGRAPH_DIRECTED, &reset, NULL);
+    igraph_vector_init(&weights, igraph_ecount(&graph));
+    for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+        VECTOR(weights)[i] = RNG_UNIF(0, 5);
+    }
+    compare(&graph, IGRAPH_UNDIRECTED, &reset, &weights);
+    igraph_vector_destroy(&weights);
+    igraph_destroy(&graph);
+
+    igraph_matrix_destroy(&reset);
+    igraph_matrix_destroy(&res);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,122 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Solving with the plan must give the same result as a single call. */
+static void compare(const igraph_t *graph, igraph_pagerank_plan_t *plan, igraph_bool_t directed,
+                    igraph_real_t damping, const igraph_vector_t *reset, const igraph_vector_t *weights) {
+    igraph_vector_t planned, expected;
+
+    igraph_vector_init(&planned, 0);
+    igraph_vector_init(&expected, 0);
+
+    igraph_personalized_pagerank(graph, IGRAPH_PAGERANK_ALGO_PRPACK, &expected, NULL,
+                                 igraph_vss_all(), directed, damping, reset, weights, NULL);
+    igraph_pagerank_plan_solve(plan, &planned, damping, reset);
+
+    IGRAPH_ASSERT(igraph_vector_size(&planned) == igraph_vcount(graph));
+    for (igraph_integer_t i = 0; i < igraph_vcount(graph); i++) {
+        IGRAPH_ASSERT(fabs(VECTOR(planned)[i] - VECTOR(expected)[i]) < 1e-12);
+    }
+
+    igraph_vector_destroy(&expected);
+    igraph_vector_destroy(&planned);
+}
+
+/* A sweep over damping factors and reset vectors with the same plan. */
+static void sweep(const igraph_t *graph, igraph_bool_t directed, const igraph_vector_t *weights) {
+    igraph_pagerank_plan_t plan;
+    igraph_vector_t reset;
+    igraph_integer_t n = igraph_vcount(graph);
+
+    igraph_vector_init(&reset, n);
+    igraph_pagerank_plan_init(&plan, graph, directed, weights);
+
+    for (igraph_real_t damping = 0; damping < 1; damping += 0.15) {
+        compare(graph, &plan, directed, damping, NULL, weights);
+    }
+    for (igraph_integer_t i = 0; i < 5; i++) {
+        VECTOR(reset)[RNG_INTEGER(0, n - 1)] += 1;
+        compare(graph, &plan, directed, 0.85, &reset, weights);
+    }
+
+    igraph_pagerank_plan_destroy(&plan);
+    igraph_vector_destroy(&reset);
+}
+
+int main(void) {
+    igraph_t graph;
+    igraph_pagerank_plan_t plan;
+    igraph_vector_t res, reset, weights;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    igraph_vector_init(&res, 0);
+
+    printf("Small directed graph:\n");
+    igraph_small(&graph, 5, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,0, 3,2, 0,2, 2,4,
+                 -1);
+    igraph_pagerank_plan_init(&plan, &graph, IGRAPH_DIRECTED, NULL);
+    igraph_pagerank_plan_solve(&plan, &res, 0.85, NULL);
+    print_vector(&res);
+    igraph_pagerank_plan_solve(&plan, &res, 0.5, NULL);
+    print_vector(&res);
+
+    printf("Errors:\n");
+    igraph_vector_init_int(&reset, 4, 1, 0, 0, 0);
+    CHECK_ERROR(igraph_pagerank_plan_solve(&plan, &res, 0.85, &reset), IGRAPH_EINVAL);
+    igraph_vector_resize(&reset, 5);
+    igraph_vector_null(&reset);
+    CHECK_ERROR(igraph_pagerank_plan_solve(&plan, &res, 0.85, &reset), IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_pagerank_plan_solve(&plan, &res, 1.5, NULL), IGRAPH_EINVAL);
+    igraph_vector_destroy(&reset);
+    igraph_pagerank_plan_destroy(&plan);
+
+    igraph_vector_init_int(&weights, 3, 1, 2, 3);
+    CHECK_ERROR(igraph_pagerank_plan_init(&plan, &graph, IGRAPH_DIRECTED, &weights), IGRAPH_EINVAL);
+    igraph_vector_destroy(&weights);
+
+    printf("Small graphs, sweeps:\n");
+    igraph_vector_init_int(&weights, 6, 1, 2, 0, 3, 1, 0);
+    sweep(&graph, IGRAPH_DIRECTED, NULL);
+    sweep(&graph, IGRAPH_UNDIRECTED, NULL);
+    sweep(&graph, IGRAPH_DIRECTED, &weights);
+    igraph_vector_destroy(&weights);
+    igraph_destroy(&graph);
+
+    /* Large enough for PRPACK to use its preprocessed SCC graph. */
+    printf("Random graphs, sweeps:\n");
+    igraph_erdos_renyi_game_gnm(&graph, 1000, 2000, IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    sweep(&graph, IGRAPH_DIRECTED, NULL);
+    sweep(&graph, IGRAPH_UNDIRECTED, NULL);
+    igraph_vector_init(&weights, igraph_ecount(&graph));
+    for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+        VECTOR(weights)[i] = RNG_UNIF(0, 5);
+    }
+    sweep(&graph, IGRAPH_DIRECTED, &weights);
+    igraph_vector_destroy(&weights);
+    igraph_destroy(&graph);
+
+    igraph_vector_destroy(&res);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
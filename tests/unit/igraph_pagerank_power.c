@@ -0,0 +1,146 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Compares the power iteration with PRPACK. */
+static void compare(const igraph_t *graph, igraph_bool_t directed, igraph_real_t damping,
+                    const igraph_vector_t *reset, const igraph_vector_t *weights) {
+    igraph_vector_t power, prpack;
+    igraph_arpack_options_t options;
+    igraph_real_t value;
+
+    igraph_vector_init(&power, 0);
+    igraph_vector_init(&prpack, 0);
+    igraph_arpack_options_init(&options);
+
+    igraph_personalized_pagerank(graph, IGRAPH_PAGERANK_ALGO_PRPACK, &prpack, NULL,
+                                 igraph_vss_all(), directed, damping, reset, weights, NULL);
+    igraph_personalized_pagerank(graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &power, &value,
+                                 igraph_vss_all(), directed, damping, reset, weights, &options);
+
+    IGRAPH_ASSERT(value == 1.0);
+    IGRAPH_ASSERT(options.nconv == 1 && options.info == 0);
+    IGRAPH_ASSERT(options.noiter > 0 && options.noiter == options.numop);
+    IGRAPH_ASSERT(igraph_vector_size(&power) == igraph_vcount(graph));
+    for (igraph_integer_t i = 0; i < igraph_vcount(graph); i++) {
+        IGRAPH_ASSERT(fabs(VECTOR(power)[i] - VECTOR(prpack)[i]) < 1e-9);
+    }
+
+    igraph_vector_destroy(&prpack);
+    igraph_vector_destroy(&power);
+}
+
+int main(void) {
+    igraph_t graph;
+    igraph_vector_t res, reset, weights;
+    igraph_arpack_options_t options;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    igraph_vector_init(&res, 0);
+    igraph_arpack_options_init(&options);
+
+    printf("Small directed graph with a dangling vertex:\n");
+    igraph_small(&graph, 5, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,0, 3,2, 0,2, 2,4,
+                 -1);
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &res, NULL,
+                    igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, NULL);
+    print_vector(&res);
+    compare(&graph, IGRAPH_DIRECTED, 0.85, NULL, NULL);
+    compare(&graph, IGRAPH_UNDIRECTED, 0.85, NULL, NULL);
+    compare(&graph, IGRAPH_DIRECTED, 0.5, NULL, NULL);
+
+    printf("Subset of vertices:\n");
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &res, NULL,
+                    igraph_vss_range(1, 3), IGRAPH_DIRECTED, 0.85, NULL, NULL);
+    print_vector(&res);
+
+    printf("Personalized:\n");
+    igraph_vector_init_int(&reset, 5, 0, 0, 1, 3, 0);
+    igraph_personalized_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &res, NULL,
+                                 igraph_vss_all(), IGRAPH_DIRECTED, 0.85, &reset, NULL, NULL);
+    print_vector(&res);
+    compare(&graph, IGRAPH_DIRECTED, 0.85, &reset, NULL);
+
+    printf("Weighted, with zero weights:\n");
+    igraph_vector_init_int(&weights, 6, 1, 2, 0, 3, 1, 0);
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &res, NULL,
+                    igraph_vss_all(), IGRAPH_DIRECTED, 0.85, &weights, NULL);
+    print_vector(&res);
+    compare(&graph, IGRAPH_DIRECTED, 0.85, NULL, &weights);
+    compare(&graph, IGRAPH_UNDIRECTED, 0.85, &reset, &weights);
+
+    printf("Errors:\n");
+    VECTOR(weights)[0] = -1;
+    CHECK_ERROR(igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &res, NULL,
+                                igraph_vss_all(), IGRAPH_DIRECTED, 0.85, &weights, NULL),
+                IGRAPH_EINVAL);
+    igraph_vector_resize(&weights, 3);
+    CHECK_ERROR(igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &res, NULL,
+                                igraph_vss_all(), IGRAPH_DIRECTED, 0.85, &weights, NULL),
+                IGRAPH_EINVAL);
+    igraph_vector_resize(&reset, 3);
+    CHECK_ERROR(igraph_personalized_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &res, NULL,
+                                             igraph_vss_all(), IGRAPH_DIRECTED, 0.85, &reset, NULL, NULL),
+                IGRAPH_EINVAL);
+    igraph_vector_destroy(&weights);
+    igraph_vector_destroy(&reset);
+
+    printf("Iteration limit:\n");
+    options.mxiter = 3;
+    igraph_set_warning_handler(igraph_warning_handler_ignore);
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &res, NULL,
+                    igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, &options);
+    igraph_set_warning_handler(igraph_warning_handler_print);
+    printf("iterations: %d, converged: %d, info: %d\n", options.noiter, options.nconv, options.info);
+    IGRAPH_ASSERT(fabs(igraph_vector_sum(&res) - 1) < 1e-12);
+    igraph_destroy(&graph);
+
+    printf("Graphs without edges:\n");
+    igraph_empty(&graph, 0, IGRAPH_DIRECTED);
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &res, NULL,
+                    igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, NULL);
+    print_vector(&res);
+    igraph_destroy(&graph);
+    igraph_empty(&graph, 4, IGRAPH_DIRECTED);
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &res, NULL,
+                    igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, NULL);
+    print_vector(&res);
+    igraph_destroy(&graph);
+
+    /* Large enough to be processed in several blocks. */
+    printf("Random graphs.\n");
+    igraph_erdos_renyi_game_gnm(&graph, 20000, 100000, IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    compare(&graph, IGRAPH_DIRECTED, 0.85, NULL, NULL);
+    compare(&graph, IGRAPH_UNDIRECTED, 0.85, NULL, NULL);
+    igraph_vector_init(&weights, igraph_ecount(&graph));
+    for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+        VECTOR(weights)[i] = RNG_UNIF(0, 5);
+    }
+    compare(&graph, IGRAPH_DIRECTED, 0.85, NULL, &weights);
+    igraph_vector_destroy(&weights);
+    igraph_destroy(&graph);
+
+    igraph_vector_destroy(&res);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
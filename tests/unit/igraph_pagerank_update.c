@@ -0,0 +1,186 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Updates the given scores for the current graph, and compares them with
+ * the scores calculated from scratch. */
+static void check_update(const igraph_t *graph, igraph_vector_t *scores, igraph_bool_t directed,
+                         const igraph_vector_t *reset, const igraph_vector_t *weights) {
+    igraph_vector_t expected;
+
+    igraph_vector_init(&expected, 0);
+    igraph_personalized_pagerank(graph, IGRAPH_PAGERANK_ALGO_PRPACK, &expected, NULL,
+                                 igraph_vss_all(), directed, 0.85, reset, weights, NULL);
+
+    igraph_personalized_pagerank_update(graph, scores, directed, 0.85, reset, weights, 1e-14);
+
+    IGRAPH_ASSERT(igraph_vector_size(scores) == igraph_vcount(graph));
+    IGRAPH_ASSERT(fabs(igraph_vector_sum(scores) - 1) < 1e-12);
+    for (igraph_integer_t i = 0; i < igraph_vcount(graph); i++) {
+        IGRAPH_ASSERT(fabs(VECTOR(*scores)[i] - VECTOR(expected)[i]) < 1e-9);
+    }
+
+    igraph_vector_destroy(&expected);
+}
+
+/* Inserts and deletes some random edges. */
+static void modify(igraph_t *graph, igraph_integer_t count) {
+    igraph_integer_t n = igraph_vcount(graph);
+    igraph_vector_int_t edges;
+
+    igraph_vector_int_init(&edges, 0);
+    for (igraph_integer_t i = 0; i < count; i++) {
+        igraph_vector_int_push_back(&edges, RNG_INTEGER(0, n - 1));
+        igraph_vector_int_push_back(&edges, RNG_INTEGER(0, n - 1));
+    }
+    igraph_add_edges(graph, &edges, NULL);
+
+    igraph_vector_int_clear(&edges);
+    for (igraph_integer_t i = 0; i < count; i++) {
+        igraph_vector_int_push_back(&edges, RNG_INTEGER(0, igraph_ecount(graph) / count - 1) * count + i);
+    }
+    igraph_delete_edges(graph, igraph_ess_vector(&edges));
+
+    igraph_vector_int_destroy(&edges);
+}
+
+int main(void) {
+    igraph_t graph;
+    igraph_vector_t scores, cold, reset, weights;
+    igraph_arpack_options_t options;
+    igraph_integer_t cold_iterations;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    igraph_vector_init(&scores, 0);
+    igraph_vector_init(&cold, 0);
+
+    printf("Small graph, a vertex becomes dangling:\n");
+    igraph_small(&graph, 5, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,0, 3,2, 0,2, 2,4,
+                 -1);
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_PRPACK, &scores, NULL,
+                    igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, NULL);
+    igraph_delete_edges(&graph, igraph_ess_1(3));
+    check_update(&graph, &scores, IGRAPH_DIRECTED, NULL, NULL);
+    print_vector(&scores);
+
+    printf("Unchanged graph:\n");
+    igraph_vector_update(&cold, &scores);
+    igraph_personalized_pagerank_update(&graph, &scores, IGRAPH_DIRECTED, 0.85, NULL, NULL, 1e-10);
+    for (igraph_integer_t i = 0; i < igraph_vcount(&graph); i++) {
+        IGRAPH_ASSERT(fabs(VECTOR(scores)[i] - VECTOR(cold)[i]) < 1e-9);
+    }
+    print_vector(&scores);
+
+    printf("Errors:\n");
+    CHECK_ERROR(igraph_personalized_pagerank_update(&graph, &scores, IGRAPH_DIRECTED, 1.0, NULL, NULL, 1e-10),
+                IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_personalized_pagerank_update(&graph, &scores, IGRAPH_DIRECTED, 0.85, NULL, NULL, 0),
+                IGRAPH_EINVAL);
+    VECTOR(scores)[0] = -1;
+    CHECK_ERROR(igraph_personalized_pagerank_update(&graph, &scores, IGRAPH_DIRECTED, 0.85, NULL, NULL, 1e-10),
+                IGRAPH_EINVAL);
+    igraph_vector_resize(&scores, 3);
+    CHECK_ERROR(igraph_personalized_pagerank_update(&graph, &scores, IGRAPH_DIRECTED, 0.85, NULL, NULL, 1e-10),
+                IGRAPH_EINVAL);
+    igraph_destroy(&graph);
+
+    printf("Graph without vertices:\n");
+    igraph_empty(&graph, 0, IGRAPH_DIRECTED);
+    igraph_vector_clear(&scores);
+    igraph_personalized_pagerank_update(&graph, &scores, IGRAPH_DIRECTED, 0.85, NULL, NULL, 1e-10);
+    print_vector(&scores);
+    igraph_destroy(&graph);
+
+    printf("Random directed graph:\n");
+    igraph_erdos_renyi_game_gnm(&graph, 2000, 8000, IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_PRPACK, &scores, NULL,
+                    igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, NULL);
+    for (int round = 0; round < 3; round++) {
+        modify(&graph, 10);
+        check_update(&graph, &scores, IGRAPH_DIRECTED, NULL, NULL);
+    }
+
+    /* Power iteration started from the previous scores needs fewer
+     * iterations than one started from scratch. */
+    printf("Warm start of power iteration:\n");
+    igraph_arpack_options_init(&options);
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &cold, NULL,
+                    igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, &options);
+    cold_iterations = options.noiter;
+    modify(&graph, 10);
+    options.start = 1;
+    igraph_vector_update(&scores, &cold);
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &scores, NULL,
+                    igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, &options);
+    IGRAPH_ASSERT(options.nconv == 1);
+    IGRAPH_ASSERT(options.noiter < cold_iterations);
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_PRPACK, &cold, NULL,
+                    igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, NULL);
+    for (igraph_integer_t i = 0; i < igraph_vcount(&graph); i++) {
+        IGRAPH_ASSERT(fabs(VECTOR(scores)[i] - VECTOR(cold)[i]) < 1e-9);
+    }
+
+    igraph_vector_resize(&scores, 5);
+    CHECK_ERROR(igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, &scores, NULL,
+                                igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, &options),
+                IGRAPH_EINVAL);
+    CHECK_ERROR(igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_POWER_PARALLEL, NULL, NULL,
+                                igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, &options),
+                IGRAPH_EINVAL);
+
+    /* The ARPACK implementation must not leave a warm start behind. */
+    igraph_arpack_options_init(&options);
+    igraph_pagerank(&graph, IGRAPH_PAGERANK_ALGO_ARPACK, &cold, NULL,
+                    igraph_vss_all(), IGRAPH_DIRECTED, 0.85, NULL, &options);
+    IGRAPH_ASSERT(options.start == 0);
+    igraph_destroy(&graph);
+
+    printf("Personalized, weighted, undirected:\n");
+    igraph_erdos_renyi_game_gnm(&graph, 1000, 3000, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    igraph_vector_init(&reset, igraph_vcount(&graph));
+    for (igraph_integer_t i = 0; i < 20; i++) {
+        VECTOR(reset)[RNG_INTEGER(0, igraph_vcount(&graph) - 1)] += 1;
+    }
+    igraph_vector_init(&weights, igraph_ecount(&graph));
+    for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+        VECTOR(weights)[i] = RNG_UNIF(0, 3);
+    }
+    igraph_personalized_pagerank(&graph, IGRAPH_PAGERANK_ALGO_PRPACK, &scores, NULL,
+                                 igraph_vss_all(), IGRAPH_UNDIRECTED, 0.85, &reset, &weights, NULL);
+    igraph_add_edge(&graph, 0, 1);
+    igraph_add_edge(&graph, 2, 3);
+    igraph_vector_push_back(&weights, 2.5);
+    igraph_vector_push_back(&weights, 0.5);
+    VECTOR(weights)[10] = 0;
+    VECTOR(weights)[11] *= 2;
+    check_update(&graph, &scores, IGRAPH_UNDIRECTED, &reset, &weights);
+
+    igraph_vector_destroy(&weights);
+    igraph_vector_destroy(&reset);
+    igraph_destroy(&graph);
+
+    igraph_vector_destroy(&cold);
+    igraph_vector_destroy(&scores);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "test_utilities.h"
+
+/* An accounting allocator: every block is preceded by a header that records
+ * its size, so that the number of live blocks and bytes can be tracked, and
+ * allocations beyond a budget can be refused. */
+
+typedef union {
+    size_t size;
+    long double align1;
+    void *align2;
+} header_t;
+
+typedef struct {
+    igraph_integer_t live_blocks;
+    size_t live_bytes;
+    size_t budget;
+    igraph_integer_t total_calls;
+} stats_t;
+
+static void *acc_malloc(size_t size, void *data) {
+    stats_t *stats = data;
+    header_t *h;
+    stats->total_calls++;
+    if (stats->live_bytes + size > stats->budget) {
+        return NULL;
+    }
+    h = malloc(sizeof(header_t) + size);
+    if (!h) {
+        return NULL;
+    }
+    h->size = size;
+    stats->live_blocks++;
+    stats->live_bytes += size;
+    return h + 1;
+}
+
+static void *acc_calloc(size_t count, size_t size, void *data) {
+    void *p = acc_malloc(count * size, data);
+    if (p) {
+        memset(p, 0, count * size);
+    }
+    return p;
+}
+
+static void acc_free(void *ptr, void *data) {
+    stats_t *stats = data;
+    header_t *h;
+    if (!ptr) {
+        return;
+    }
+    h = (header_t *) ptr - 1;
+    stats->live_blocks--;
+    stats->live_bytes -= h->size;
+    free(h);
+}
+
+static void *acc_realloc(void *ptr, size_t size, void *data) {
+    stats_t *stats = data;
+    header_t *h;
+    if (!ptr) {
+        return acc_malloc(size, data);
+    }
+    stats->total_calls++;
+    h = (header_t *) ptr - 1;
+    if (stats->live_bytes - h->size + size > stats->budget) {
+        return NULL;
+    }
+    stats->live_bytes -= h->size;
+    h = realloc(h, sizeof(header_t) + size);
+    if (!h) {
+        stats->live_bytes += ((header_t *) ptr - 1)->size;
+        return NULL;
+    }
+    h->size = size;
+    stats->live_bytes += size;
+    return h + 1;
+}
+
+int main(void) {
+    stats_t stats = { 0, 0, (size_t) -1, 0 };
+    igraph_allocator_t allocator = {
+        acc_malloc, acc_calloc, acc_realloc, acc_free, &stats
+    };
+    igraph_t graph;
+    igraph_vector_int_t membership;
+    igraph_strvector_t names;
+    igraph_integer_t no;
+
+    IGRAPH_ASSERT(igraph_set_allocator(&allocator) == NULL);
+
+    /* Attribute handling duplicates strings; these must also come from the
+     * custom allocator. */
+    igraph_set_attribute_table(&igraph_cattribute_table);
+
+    printf("Graph with string attributes:\n");
+    igraph_small(&graph, 4, IGRAPH_UNDIRECTED, 0, 1, 1, 2, -1);
+    SETGAS(&graph, "name", "small graph");
+    SETVAS(&graph, "label", 0, "zero");
+    SETVAS(&graph, "label", 3, "three");
+    IGRAPH_ASSERT(stats.live_blocks > 0);
+
+    igraph_vector_int_init(&membership, 0);
+    igraph_connected_components(&graph, &membership, NULL, &no, IGRAPH_WEAK);
+    printf("%s: %" IGRAPH_PRId " components, labels '%s' and '%s'\n",
+           GAS(&graph, "name"), no, VAS(&graph, "label", 0), VAS(&graph, "label", 3));
+    print_vector_int(&membership);
+    igraph_vector_int_destroy(&membership);
+    igraph_destroy(&graph);
+
+    printf("\nString vector:\n");
+    igraph_strvector_init(&names, 0);
+    igraph_strvector_push_back(&names, "foo");
+    igraph_strvector_push_back(&names, "bar");
+    igraph_strvector_set(&names, 0, "foobar");
+    for (igraph_integer_t i = 0; i < igraph_strvector_size(&names); i++) {
+        printf("%s\n", igraph_strvector_get(&names, i));
+    }
+    igraph_strvector_destroy(&names);
+
+    igraph_set_attribute_table(NULL);
+
+    printf("\nAll memory released: %s\n", stats.live_blocks == 0 && stats.live_bytes == 0 ? "yes" : "no");
+    IGRAPH_ASSERT(stats.total_calls > 0);
+
+    /* Running out of memory must be reported as an error, and temporary
+     * data must still be released. */
+    stats.budget = 10000;
+    CHECK_ERROR(igraph_ring(&graph, 10000, IGRAPH_UNDIRECTED, false, true), IGRAPH_ENOMEM);
+    IGRAPH_ASSERT(stats.live_blocks == 0);
+
+    igraph_ring(&graph, 10, IGRAPH_UNDIRECTED, false, true);
+    printf("Ring within budget: %" IGRAPH_PRId " edges\n", igraph_ecount(&graph));
+    igraph_destroy(&graph);
+    IGRAPH_ASSERT(stats.live_blocks == 0);
+
+    IGRAPH_ASSERT(igraph_set_allocator(NULL) == &allocator);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
@@ -0,0 +1,150 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+/* Single-source queries with a shared workspace must give the same result
+ * as a single call for all sources. */
+static void check_dijkstra(const igraph_t *graph, const igraph_vector_t *weights,
+                           igraph_real_t cutoff, igraph_workspace_t *ws) {
+    igraph_matrix_t all, one;
+    igraph_integer_t n = igraph_vcount(graph);
+
+    igraph_matrix_init(&all, 0, 0);
+    igraph_matrix_init(&one, 0, 0);
+
+    igraph_distances_dijkstra_cutoff(graph, &all, igraph_vss_all(), igraph_vss_all(),
+                                     weights, IGRAPH_OUT, cutoff);
+
+    for (igraph_integer_t i = 0; i < n; i++) {
+        igraph_distances_dijkstra_cutoff_ws(graph, &one, igraph_vss_1(i), igraph_vss_all(),
+                                            weights, IGRAPH_OUT, cutoff, ws);
+        IGRAPH_ASSERT(igraph_matrix_nrow(&one) == 1);
+        for (igraph_integer_t j = 0; j < n; j++) {
+            IGRAPH_ASSERT(MATRIX(one, 0, j) == MATRIX(all, i, j));
+        }
+
+        /* Target subsets use an additional buffer from the workspace. */
+        igraph_distances_dijkstra_cutoff_ws(graph, &one, igraph_vss_1(i), igraph_vss_range(0, n / 2),
+                                            weights, IGRAPH_OUT, cutoff, ws);
+        for (igraph_integer_t j = 0; j < n / 2; j++) {
+            IGRAPH_ASSERT(MATRIX(one, 0, j) == MATRIX(all, i, j));
+        }
+    }
+
+    igraph_matrix_destroy(&one);
+    igraph_matrix_destroy(&all);
+}
+
+static void check_transitivity(const igraph_t *graph, igraph_integer_t count, igraph_workspace_t *ws) {
+    igraph_vector_t all, some;
+    igraph_vector_int_t vids;
+
+    igraph_vector_init(&all, 0);
+    igraph_vector_init(&some, 0);
+    igraph_vector_int_init(&vids, 0);
+
+    igraph_transitivity_local_undirected(graph, &all, igraph_vss_all(), IGRAPH_TRANSITIVITY_ZERO);
+
+    for (igraph_integer_t start = 0; start + count <= igraph_vcount(graph); start += count) {
+        igraph_vector_int_range(&vids, start, start + count);
+        igraph_transitivity_local_undirected_ws(graph, &some, igraph_vss_vector(&vids),
+                                                IGRAPH_TRANSITIVITY_ZERO, ws);
+        for (igraph_integer_t i = 0; i < count; i++) {
+            IGRAPH_ASSERT(igraph_cmp_epsilon(VECTOR(some)[i], VECTOR(all)[start + i], 1e-12) == 0);
+        }
+    }
+
+    igraph_vector_int_destroy(&vids);
+    igraph_vector_destroy(&some);
+    igraph_vector_destroy(&all);
+}
+
+int main(void) {
+    igraph_t graph, small;
+    igraph_vector_t weights;
+    igraph_matrix_t res;
+    igraph_workspace_t ws;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    igraph_workspace_init(&ws);
+
+    igraph_erdos_renyi_game_gnm(&graph, 300, 1200, IGRAPH_DIRECTED, IGRAPH_NO_LOOPS);
+    igraph_vector_init(&weights, igraph_ecount(&graph));
+    for (igraph_integer_t i = 0; i < igraph_ecount(&graph); i++) {
+        VECTOR(weights)[i] = RNG_INTEGER(1, 10);
+    }
+
+    printf("Dijkstra with a reused workspace.\n");
+    check_dijkstra(&graph, &weights, -1, &ws);
+    check_dijkstra(&graph, &weights, 15, &ws);
+
+    /* The same workspace works with a smaller graph, and afterwards with the
+     * larger one again. */
+    igraph_small(&small, 4, IGRAPH_DIRECTED, 0, 1, 1, 2, 2, 3, 0, 3, -1);
+    {
+        igraph_vector_t small_weights;
+        igraph_vector_init_int(&small_weights, 4, 1, 1, 1, 5);
+        check_dijkstra(&small, &small_weights, -1, &ws);
+
+        igraph_matrix_init(&res, 0, 0);
+        igraph_distances_dijkstra_cutoff_ws(&small, &res, igraph_vss_1(0), igraph_vss_all(),
+                                            &small_weights, IGRAPH_OUT, -1, &ws);
+        print_matrix(&res);
+
+        /* Errors leave the workspace in a usable state. */
+        VECTOR(small_weights)[0] = -1;
+        CHECK_ERROR(igraph_distances_dijkstra_cutoff_ws(&small, &res, igraph_vss_1(0), igraph_vss_all(),
+                                                        &small_weights, IGRAPH_OUT, -1, &ws),
+                    IGRAPH_EINVAL);
+        VECTOR(small_weights)[0] = 1;
+        CHECK_ERROR(igraph_distances_dijkstra_cutoff_ws(&small, &res, igraph_vss_1(0), igraph_vss_1(4),
+                                                        &small_weights, IGRAPH_OUT, -1, &ws),
+                    IGRAPH_EINVVID);
+        igraph_matrix_destroy(&res);
+        igraph_vector_destroy(&small_weights);
+    }
+    check_dijkstra(&graph, &weights, -1, &ws);
+
+    printf("Dijkstra without a workspace.\n");
+    check_dijkstra(&graph, &weights, 10, NULL);
+
+    igraph_vector_destroy(&weights);
+    igraph_destroy(&graph);
+
+    printf("Local transitivity with a reused workspace.\n");
+    igraph_erdos_renyi_game_gnm(&graph, 1000, 6000, IGRAPH_UNDIRECTED, IGRAPH_NO_LOOPS);
+    check_transitivity(&graph, 5, &ws);
+    check_transitivity(&graph, 200, &ws);
+    check_transitivity(&small, 2, &ws);
+    check_transitivity(&graph, 5, NULL);
+    check_transitivity(&graph, 200, NULL);
+
+    printf("Clearing the workspace.\n");
+    igraph_workspace_clear(&ws);
+    check_transitivity(&graph, 10, &ws);
+
+    igraph_destroy(&small);
+    igraph_destroy(&graph);
+    igraph_workspace_destroy(&ws);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}
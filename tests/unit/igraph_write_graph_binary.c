@@ -0,0 +1,198 @@
+/* IGraph library.
+   Copyright (C) 2025  The igraph development team <igraph@igraph.org>
+
+   This program is free software; you can redistribute it and/or modify
+   it under the terms of the GNU General Public License as published by
+   the Free Software Foundation; either version 2 of the License, or
+   (at your option) any later version.
+
+   This program is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+   GNU General Public License for more details.
+
+   You should have received a copy of the GNU General Public License
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.
+*/
+
+#include <igraph.h>
+#include "test_utilities.h"
+
+#include <stdint.h>
+#include <string.h>
+
+static void check_same_indices(const igraph_t *g1, const igraph_t *g2) {
+    IGRAPH_ASSERT(igraph_vcount(g1) == igraph_vcount(g2));
+    IGRAPH_ASSERT(igraph_is_directed(g1) == igraph_is_directed(g2));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->from, &g2->from));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->to, &g2->to));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->oi, &g2->oi));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->ii, &g2->ii));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->os, &g2->os));
+    IGRAPH_ASSERT(igraph_vector_int_all_e(&g1->is, &g2->is));
+}
+
+static void roundtrip(const igraph_t *graph, igraph_t *result) {
+    FILE *file = tmpfile();
+    IGRAPH_ASSERT(file != NULL);
+    igraph_write_graph_binary(graph, file);
+    rewind(file);
+    igraph_read_graph_binary(result, file);
+    IGRAPH_ASSERT(fgetc(file) == EOF);
+    fclose(file);
+    check_same_indices(graph, result);
+}
+
+/* Writes 'graph', overwrites 'size' bytes at 'offset', and tries to read it back. */
+static igraph_error_t read_corrupted(const igraph_t *graph, long offset,
+                                     const void *data, size_t size) {
+    igraph_t result;
+    igraph_error_t err;
+    FILE *file = tmpfile();
+    IGRAPH_ASSERT(file != NULL);
+    igraph_write_graph_binary(graph, file);
+    fseek(file, offset, SEEK_SET);
+    fwrite(data, 1, size, file);
+    rewind(file);
+    err = igraph_read_graph_binary(&result, file);
+    if (err == IGRAPH_SUCCESS) {
+        igraph_destroy(&result);
+    }
+    fclose(file);
+    return err;
+}
+
+/* Writes only the header of 'graph', with the count at 'offset' replaced by
+ * 'count', and tries to read it back. The reader must fail without first
+ * allocating memory for all the elements claimed by the header. */
+static igraph_error_t read_header_only(const igraph_t *graph, long offset, int64_t count) {
+    igraph_t result;
+    igraph_error_t err;
+    char header[56];
+    FILE *file = tmpfile(), *truncated = tmpfile();
+    IGRAPH_ASSERT(file != NULL && truncated != NULL);
+    igraph_write_graph_binary(graph, file);
+    rewind(file);
+    IGRAPH_ASSERT(fread(header, 1, sizeof(header), file) == sizeof(header));
+    memcpy(header + offset, &count, sizeof(count));
+    fwrite(header, 1, sizeof(header), truncated);
+    rewind(truncated);
+    err = igraph_read_graph_binary(&result, truncated);
+    if (err == IGRAPH_SUCCESS) {
+        igraph_destroy(&result);
+    }
+    fclose(truncated);
+    fclose(file);
+    return err;
+}
+
+int main(void) {
+    igraph_t g, g2;
+    FILE *file;
+
+    igraph_rng_seed(igraph_rng_default(), 42);
+
+    printf("Null graph:\n");
+    igraph_empty(&g, 0, IGRAPH_UNDIRECTED);
+    roundtrip(&g, &g2);
+    print_graph(&g2);
+    igraph_destroy(&g2);
+    igraph_destroy(&g);
+
+    printf("\nMultigraph with self-loops and isolated vertices:\n");
+    igraph_small(&g, 7, IGRAPH_DIRECTED,
+                 0,1, 1,2, 2,0, 1,2, 3,3, 2,1, 0,1, 4,0,
+                 -1);
+    roundtrip(&g, &g2);
+    print_graph(&g2);
+    igraph_destroy(&g2);
+    igraph_destroy(&g);
+
+    printf("\nAttributes:\n");
+    igraph_set_attribute_table(&igraph_cattribute_table);
+    igraph_ring(&g, 4, IGRAPH_UNDIRECTED, false, true);
+    SETGAN(&g, "answer", 42);
+    SETGAS(&g, "title", "ring");
+    SETGAB(&g, "small", true);
+    SETVAS(&g, "name", 0, "zero");
+    SETVAS(&g, "name", 2, "two");
+    SETVAN(&g, "size", 1, 1.5);
+    SETVAB(&g, "marked", 3, true);
+    SETEAN(&g, "weight", 0, 0.25);
+    SETEAN(&g, "weight", 3, -7);
+    SETEAS(&g, "label", 1, "an edge");
+    roundtrip(&g, &g2);
+    print_graph(&g2);
+    print_attributes(&g2);
+    igraph_destroy(&g2);
+
+    /* Attributes are ignored when there is no attribute handler. */
+    igraph_set_attribute_table(NULL);
+    roundtrip(&g, &g2);
+    IGRAPH_ASSERT(g2.attr == NULL);
+    igraph_destroy(&g2);
+    igraph_set_attribute_table(&igraph_cattribute_table);
+    igraph_destroy(&g);
+    igraph_set_attribute_table(NULL);
+
+    /* Large random graphs. */
+    igraph_erdos_renyi_game_gnm(&g, 1000, 20000, IGRAPH_DIRECTED, IGRAPH_LOOPS);
+    roundtrip(&g, &g2);
+    igraph_destroy(&g2);
+    igraph_destroy(&g);
+    igraph_erdos_renyi_game_gnm(&g, 1000, 20000, IGRAPH_UNDIRECTED, IGRAPH_LOOPS);
+    roundtrip(&g, &g2);
+    igraph_destroy(&g2);
+
+    printf("\nErrors:\n");
+
+    file = tmpfile();
+    IGRAPH_ASSERT(file != NULL);
+    CHECK_ERROR(igraph_read_graph_binary(&g2, file), IGRAPH_PARSEERROR);
+    fputs("Not a graph at all, but long enough to contain a header.", file);
+    rewind(file);
+    CHECK_ERROR(igraph_read_graph_binary(&g2, file), IGRAPH_PARSEERROR);
+    fclose(file);
+
+    {
+        /* Byte order tag, and the first entry of 'oi'. */
+        const unsigned char swapped[4] = { 1, 2, 3, 4 };
+        const igraph_integer_t bad_edge = igraph_ecount(&g), zero = 0;
+        const long oi_offset = 56 + 2 * bad_edge * (long) sizeof(igraph_integer_t);
+        CHECK_ERROR(read_corrupted(&g, 12, swapped, sizeof(swapped)), IGRAPH_PARSEERROR);
+        CHECK_ERROR(read_corrupted(&g, oi_offset, &bad_edge, sizeof(bad_edge)), IGRAPH_PARSEERROR);
+        /* Moving an edge to vertex 0 breaks the order of the indices. */
+        CHECK_ERROR(read_corrupted(&g, 56, &zero, sizeof(zero)), IGRAPH_PARSEERROR);
+    }
+
+    /* Truncated file. */
+    file = tmpfile();
+    IGRAPH_ASSERT(file != NULL);
+    igraph_write_graph_binary(&g, file);
+    fflush(file);
+    {
+        long size = ftell(file);
+        char *buffer = malloc(size);
+        FILE *truncated = tmpfile();
+        rewind(file);
+        IGRAPH_ASSERT(fread(buffer, 1, size, file) == (size_t) size);
+        fwrite(buffer, 1, size - 8, truncated);
+        rewind(truncated);
+        CHECK_ERROR(igraph_read_graph_binary(&g2, truncated), IGRAPH_PARSEERROR);
+        fclose(truncated);
+        free(buffer);
+    }
+    fclose(file);
+
+    /* Header claiming a huge graph, with no data after it. The counts are
+     * small enough that their size in bytes does not overflow, but too large
+     * for the memory to be allocated up front. */
+    CHECK_ERROR(read_header_only(&g, 40, (int64_t) 1 << 59), IGRAPH_PARSEERROR);
+    CHECK_ERROR(read_header_only(&g, 48, (int64_t) 1 << 59), IGRAPH_PARSEERROR);
+
+    igraph_destroy(&g);
+
+    VERIFY_FINALLY_STACK();
+
+    return 0;
+}